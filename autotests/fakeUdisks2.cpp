@@ -0,0 +1,290 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "fakeUdisks2.h"
+
+#include <QDBusError>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusVariant>
+#include <QThread>
+
+static const QString s_connectionName = QStringLiteral("fake-udisks2");
+
+FakeUdisks2::FakeUdisks2()
+    : m_bus(QStringLiteral("fake-udisks2-unconnected"))
+{
+    qDBusRegisterMetaType<QVariantMap>();
+    qDBusRegisterMetaType<VariantMapMap>();
+    qDBusRegisterMetaType<DBUSManagerStruct>();
+    qDBusRegisterMetaType<QByteArrayList>();
+}
+
+FakeUdisks2::~FakeUdisks2()
+{
+    if (!m_thread) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            m_bus.unregisterObject(QStringLiteral(UD2_DBUS_PATH));
+            m_bus.unregisterService(QStringLiteral(UD2_DBUS_SERVICE));
+            // hand the object back so it can be destroyed in the test thread
+            moveToThread(m_thread->thread());
+        },
+        Qt::BlockingQueuedConnection);
+
+    m_thread->quit();
+    m_thread->wait();
+    delete m_thread;
+}
+
+bool FakeUdisks2::start()
+{
+    m_thread = new QThread;
+    m_thread->start();
+    moveToThread(m_thread);
+
+    /* The connection has to be created and the object registered from the
+     * worker thread: QtDBus dispatches incoming calls in the thread of the
+     * registered object, and the whole point is keeping that off the test
+     * thread so blocking round trips from there cannot starve the service. */
+    bool ok = false;
+    QMetaObject::invokeMethod(
+        this,
+        [this, &ok]() {
+            m_bus = QDBusConnection::connectToBus(QDBusConnection::SystemBus, s_connectionName);
+            ok = m_bus.isConnected() //
+                && m_bus.registerService(QStringLiteral(UD2_DBUS_SERVICE)) //
+                && m_bus.registerVirtualObject(QStringLiteral(UD2_DBUS_PATH), this, QDBusConnection::SubPath);
+        },
+        Qt::BlockingQueuedConnection);
+
+    return ok;
+}
+
+void FakeUdisks2::populate(int drives, int partitionsPerDrive)
+{
+    QMutexLocker locker(&m_lock);
+    m_objects.clear();
+
+    VariantMapMap managerInterfaces;
+    managerInterfaces.insert(QStringLiteral("org.freedesktop.UDisks2.Manager"), {{QStringLiteral("Version"), QStringLiteral("2.0-mock")}});
+    m_objects.insert(QDBusObjectPath(QStringLiteral(UD2_DBUS_PATH_MANAGER)), managerInterfaces);
+
+    for (int drive = 0; drive < drives; ++drive) {
+        const QString drivePath = QStringLiteral(UD2_DBUS_PATH_DRIVES "/MOCK_DRIVE_%1").arg(drive);
+        m_objects.insert(QDBusObjectPath(drivePath), driveObject(drive));
+
+        const QString diskName = QStringLiteral("mock%1").arg(drive);
+        const QString tablePath = QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES "/%1").arg(diskName);
+
+        VariantMapMap table;
+        QVariantMap block;
+        block.insert(QStringLiteral("Device"), QByteArray("/dev/") + diskName.toLatin1());
+        block.insert(QStringLiteral("PreferredDevice"), QByteArray("/dev/") + diskName.toLatin1());
+        block.insert(QStringLiteral("Drive"), QVariant::fromValue(QDBusObjectPath(drivePath)));
+        block.insert(QStringLiteral("Size"), 1000204886016ULL);
+        block.insert(QStringLiteral("ReadOnly"), false);
+        block.insert(QStringLiteral("HintIgnore"), false);
+        block.insert(QStringLiteral("HintSystem"), false);
+        block.insert(QStringLiteral("IdUsage"), QString());
+        block.insert(QStringLiteral("IdType"), QString());
+        block.insert(QStringLiteral("IdLabel"), QString());
+        block.insert(QStringLiteral("IdUUID"), QString());
+        table.insert(QStringLiteral(UD2_DBUS_INTERFACE_BLOCK), block);
+        table.insert(QStringLiteral(UD2_DBUS_INTERFACE_PARTITIONTABLE), {{QStringLiteral("Type"), QStringLiteral("gpt")}});
+        m_objects.insert(QDBusObjectPath(tablePath), table);
+
+        for (int partition = 1; partition <= partitionsPerDrive; ++partition) {
+            const QString name = QStringLiteral("%1p%2").arg(diskName).arg(partition);
+            const QString path = QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES "/%1").arg(name);
+            m_objects.insert(QDBusObjectPath(path), partitionObject(name, drivePath, tablePath, partition));
+        }
+    }
+}
+
+int FakeUdisks2::deviceObjectCount(int drives, int partitionsPerDrive)
+{
+    // drive + partition table + partitions, per drive
+    return drives * (2 + partitionsPerDrive);
+}
+
+VariantMapMap FakeUdisks2::driveObject(int index)
+{
+    QVariantMap drive;
+    drive.insert(QStringLiteral("Vendor"), QStringLiteral("Mock"));
+    drive.insert(QStringLiteral("Model"), QStringLiteral("Disk %1").arg(index));
+    drive.insert(QStringLiteral("Serial"), QStringLiteral("MOCK%1").arg(index, 6, 10, QLatin1Char('0')));
+    drive.insert(QStringLiteral("Size"), 1000204886016ULL);
+    drive.insert(QStringLiteral("ConnectionBus"), QStringLiteral("scsi"));
+    drive.insert(QStringLiteral("Removable"), false);
+    drive.insert(QStringLiteral("MediaRemovable"), false);
+    drive.insert(QStringLiteral("MediaAvailable"), true);
+    drive.insert(QStringLiteral("MediaCompatibility"), QStringList());
+    drive.insert(QStringLiteral("Optical"), false);
+
+    VariantMapMap interfaces;
+    interfaces.insert(QStringLiteral(UD2_DBUS_INTERFACE_DRIVE), drive);
+    return interfaces;
+}
+
+VariantMapMap FakeUdisks2::partitionObject(const QString &deviceName, const QString &drivePath, const QString &tablePath, int number, qulonglong size)
+{
+    QVariantMap block;
+    block.insert(QStringLiteral("Device"), QByteArray("/dev/") + deviceName.toLatin1());
+    block.insert(QStringLiteral("PreferredDevice"), QByteArray("/dev/") + deviceName.toLatin1());
+    block.insert(QStringLiteral("Drive"), QVariant::fromValue(QDBusObjectPath(drivePath)));
+    block.insert(QStringLiteral("Size"), size);
+    block.insert(QStringLiteral("ReadOnly"), false);
+    block.insert(QStringLiteral("HintIgnore"), false);
+    block.insert(QStringLiteral("HintSystem"), false);
+    block.insert(QStringLiteral("IdUsage"), QStringLiteral("filesystem"));
+    block.insert(QStringLiteral("IdType"), QStringLiteral("ext4"));
+    block.insert(QStringLiteral("IdLabel"), QStringLiteral("DATA_%1").arg(number));
+    block.insert(QStringLiteral("IdUUID"), QStringLiteral("00000000-0000-0000-0000-%1").arg(number, 12, 10, QLatin1Char('0')));
+
+    QVariantMap partition;
+    partition.insert(QStringLiteral("Number"), static_cast<uint>(number));
+    partition.insert(QStringLiteral("Offset"), (number - 1) * size);
+    partition.insert(QStringLiteral("Size"), size);
+    partition.insert(QStringLiteral("Table"), QVariant::fromValue(QDBusObjectPath(tablePath)));
+
+    QVariantMap filesystem;
+    filesystem.insert(QStringLiteral("MountPoints"), QVariant::fromValue(QByteArrayList()));
+
+    VariantMapMap interfaces;
+    interfaces.insert(QStringLiteral(UD2_DBUS_INTERFACE_BLOCK), block);
+    interfaces.insert(QStringLiteral(UD2_DBUS_INTERFACE_PARTITION), partition);
+    interfaces.insert(QStringLiteral(UD2_DBUS_INTERFACE_FILESYSTEM), filesystem);
+    return interfaces;
+}
+
+void FakeUdisks2::addObject(const QString &path, const VariantMapMap &interfaces)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        m_objects.insert(QDBusObjectPath(path), interfaces);
+    }
+
+    QDBusMessage signal = QDBusMessage::createSignal(QStringLiteral(UD2_DBUS_PATH), //
+                                                     QStringLiteral(DBUS_INTERFACE_MANAGER),
+                                                     QStringLiteral("InterfacesAdded"));
+    signal << QVariant::fromValue(QDBusObjectPath(path)) << QVariant::fromValue(interfaces);
+    m_bus.send(signal);
+}
+
+void FakeUdisks2::removeObject(const QString &path)
+{
+    QStringList interfaces;
+    {
+        QMutexLocker locker(&m_lock);
+        interfaces = m_objects.take(QDBusObjectPath(path)).keys();
+    }
+    if (interfaces.isEmpty()) {
+        return;
+    }
+
+    QDBusMessage signal = QDBusMessage::createSignal(QStringLiteral(UD2_DBUS_PATH), //
+                                                     QStringLiteral(DBUS_INTERFACE_MANAGER),
+                                                     QStringLiteral("InterfacesRemoved"));
+    signal << QVariant::fromValue(QDBusObjectPath(path)) << interfaces;
+    m_bus.send(signal);
+}
+
+void FakeUdisks2::changeProperty(const QString &path, const QString &iface, const QString &key, const QVariant &value)
+{
+    {
+        QMutexLocker locker(&m_lock);
+        auto it = m_objects.find(QDBusObjectPath(path));
+        if (it == m_objects.end()) {
+            return;
+        }
+        (*it)[iface].insert(key, value);
+    }
+
+    QDBusMessage signal = QDBusMessage::createSignal(path, QStringLiteral(DBUS_INTERFACE_PROPS), QStringLiteral("PropertiesChanged"));
+    signal << iface << QVariantMap{{key, value}} << QStringList();
+    m_bus.send(signal);
+}
+
+void FakeUdisks2::setLatency(int msecs)
+{
+    m_latencyMsecs.storeRelaxed(msecs);
+}
+
+int FakeUdisks2::managedObjectsCalls() const
+{
+    return m_managedObjectsCalls.loadRelaxed();
+}
+
+int FakeUdisks2::getAllCalls() const
+{
+    return m_getAllCalls.loadRelaxed();
+}
+
+QString FakeUdisks2::introspect(const QString &path) const
+{
+    QMutexLocker locker(&m_lock);
+
+    const QString prefix = path.endsWith(QLatin1Char('/')) ? path : path + QLatin1Char('/');
+    QStringList children;
+    for (auto it = m_objects.cbegin(), end = m_objects.cend(); it != end; ++it) {
+        const QString objectPath = it.key().path();
+        if (!objectPath.startsWith(prefix)) {
+            continue;
+        }
+        const QString child = objectPath.mid(prefix.size()).section(QLatin1Char('/'), 0, 0);
+        if (!children.contains(child)) {
+            children.append(child);
+        }
+    }
+
+    QString xml;
+    for (const QString &child : std::as_const(children)) {
+        xml += QStringLiteral("  <node name=\"%1\"/>\n").arg(child);
+    }
+    return xml;
+}
+
+bool FakeUdisks2::handleMessage(const QDBusMessage &message, const QDBusConnection &connection)
+{
+    const int latency = m_latencyMsecs.loadRelaxed();
+    if (latency > 0) {
+        QThread::msleep(latency);
+    }
+
+    QMutexLocker locker(&m_lock);
+
+    if (message.interface() == QLatin1String(DBUS_INTERFACE_MANAGER) && message.member() == QLatin1String("GetManagedObjects")) {
+        m_managedObjectsCalls.fetchAndAddRelaxed(1);
+        connection.send(message.createReply({QVariant::fromValue(m_objects)}));
+        return true;
+    }
+
+    if (message.interface() == QLatin1String(DBUS_INTERFACE_PROPS)) {
+        const VariantMapMap interfaces = m_objects.value(QDBusObjectPath(message.path()));
+
+        if (message.member() == QLatin1String("GetAll")) {
+            m_getAllCalls.fetchAndAddRelaxed(1);
+            connection.send(message.createReply({interfaces.value(message.arguments().value(0).toString())}));
+            return true;
+        }
+
+        if (message.member() == QLatin1String("Get")) {
+            const QVariant value = interfaces.value(message.arguments().value(0).toString()).value(message.arguments().value(1).toString());
+            connection.send(message.createReply({QVariant::fromValue(QDBusVariant(value))}));
+            return true;
+        }
+    }
+
+    connection.send(message.createErrorReply(QDBusError::UnknownMethod, QStringLiteral("No such method: ") + message.member()));
+    return true;
+}
+
+#include "moc_fakeUdisks2.cpp"
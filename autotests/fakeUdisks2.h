@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_FAKE_UDISKS2_H
+#define SOLID_FAKE_UDISKS2_H
+
+#include <QAtomicInt>
+#include <QDBusConnection>
+#include <QDBusVirtualObject>
+#include <QMutex>
+
+#include "udisks2.h"
+
+class QThread;
+
+/*
+ * In-process stand-in for udisksd. Implements org.freedesktop.DBus.ObjectManager
+ * at /org/freedesktop/UDisks2 plus the Properties and Introspectable interfaces
+ * for every object below it, backed by a plain DBUSManagerStruct that tests
+ * populate with as many drives and partitions as they like.
+ *
+ * The service lives on its own connection in a worker thread, so test code may
+ * issue blocking calls from the main thread without deadlocking on its own
+ * reply. Mutators are thread-safe and emit the matching InterfacesAdded /
+ * InterfacesRemoved / PropertiesChanged bus signals, and a configurable
+ * latency can be injected into every handled call to model a slow daemon.
+ */
+class FakeUdisks2 : public QDBusVirtualObject
+{
+    Q_OBJECT
+public:
+    FakeUdisks2();
+    ~FakeUdisks2() override;
+
+    // connects to the (test) system bus, claims org.freedesktop.UDisks2
+    bool start();
+
+    // replaces the object tree: per drive one Drive object, one partition
+    // table block device and partitionsPerDrive filesystem partitions
+    void populate(int drives, int partitionsPerDrive);
+    static int deviceObjectCount(int drives, int partitionsPerDrive);
+
+    void addObject(const QString &path, const VariantMapMap &interfaces);
+    void removeObject(const QString &path);
+    void changeProperty(const QString &path, const QString &iface, const QString &key, const QVariant &value);
+
+    static VariantMapMap driveObject(int index);
+    static VariantMapMap
+    partitionObject(const QString &deviceName, const QString &drivePath, const QString &tablePath, int number, qulonglong size = 512ULL * 1024 * 1024);
+
+    // per-call latency in milliseconds, applied before every reply
+    void setLatency(int msecs);
+
+    int managedObjectsCalls() const;
+    int getAllCalls() const;
+
+    QString introspect(const QString &path) const override;
+    bool handleMessage(const QDBusMessage &message, const QDBusConnection &connection) override;
+
+private:
+    QThread *m_thread = nullptr;
+    QDBusConnection m_bus;
+    mutable QMutex m_lock;
+    DBUSManagerStruct m_objects;
+    QAtomicInt m_latencyMsecs;
+    QAtomicInt m_managedObjectsCalls;
+    QAtomicInt m_getAllCalls;
+};
+
+#endif // SOLID_FAKE_UDISKS2_H
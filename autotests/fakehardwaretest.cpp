@@ -6,6 +6,8 @@
 #include "fakehardwaretest.h"
 
 // Qt includes
+#include <QSignalSpy>
+#include <QTemporaryFile>
 #include <QTest>
 
 // Solid includes
@@ -59,4 +61,51 @@ void FakeHardwareTest::testFakeBackend()
     delete fakeManager;
 }
 
+void FakeHardwareTest::testBatchInjection()
+{
+    Solid::Backends::Fake::FakeManager manager(nullptr, QStringLiteral(TEST_DATA));
+    const int baseline = manager.allDevices().size();
+
+    // batch plug from a template
+    QSignalSpy addedSpy(&manager, &Solid::Ifaces::DeviceManager::deviceAdded);
+    const QStringList clones = manager.plugTemplate(QStringLiteral("/org/kde/solid/fakehw/acpi_CPU0"), 5);
+    QCOMPARE(clones.size(), 5);
+    QCOMPARE(addedSpy.count(), 5);
+    QCOMPARE(manager.allDevices().size(), baseline + 5);
+    auto *clone = static_cast<Solid::Backends::Fake::FakeDevice *>(manager.createDevice(clones.first()));
+    QVERIFY(clone);
+    QCOMPARE(clone->product(), QStringLiteral("Solid Processor #0"));
+    delete clone;
+
+    QVERIFY(manager.plugTemplate(QStringLiteral("/does/not/exist"), 3).isEmpty());
+
+    // atomic batch unplug: the device list is final when the signals fire
+    QSignalSpy removedSpy(&manager, &Solid::Ifaces::DeviceManager::deviceRemoved);
+    int sizeDuringSignal = -1;
+    connect(&manager, &Solid::Ifaces::DeviceManager::deviceRemoved, &manager, [&manager, &sizeDuringSignal]() {
+        if (sizeDuringSignal < 0) {
+            sizeDuringSignal = manager.allDevices().size();
+        }
+    });
+    manager.unplugSet(clones);
+    QCOMPARE(removedSpy.count(), 5);
+    QCOMPARE(sizeDuringSignal, baseline);
+    QCOMPARE(manager.allDevices().size(), baseline);
+
+    // timed script replay
+    QTemporaryFile script;
+    QVERIFY(script.open());
+    script.write("# event storm script\n");
+    script.write("0 unplug /org/kde/solid/fakehw/acpi_CPU1\n");
+    script.write("10 plug /org/kde/solid/fakehw/acpi_CPU1\n");
+    script.close();
+
+    QCOMPARE(manager.replayEventScript(script.fileName()), 2);
+    QTRY_COMPARE(removedSpy.count(), 6);
+    QTRY_COMPARE(addedSpy.count(), 6);
+    QCOMPARE(manager.allDevices().size(), baseline);
+
+    QCOMPARE(manager.replayEventScript(QStringLiteral("/does/not/exist")), -1);
+}
+
 #include "moc_fakehardwaretest.cpp"
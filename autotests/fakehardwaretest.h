@@ -13,6 +13,7 @@ class FakeHardwareTest : public QObject
     Q_OBJECT
 private Q_SLOTS:
     void testFakeBackend();
+    void testBatchInjection();
 };
 
 #endif
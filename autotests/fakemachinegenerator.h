@@ -0,0 +1,121 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef FAKEMACHINEGENERATOR_H
+#define FAKEMACHINEGENERATOR_H
+
+#include <QFile>
+#include <QString>
+#include <QTextStream>
+
+/*
+ * Generates synthetic fakehw machine descriptions of arbitrary size, in
+ * the same XML dialect as fakecomputer.xml. The shipped machine has a
+ * handful of devices; the scaling problems we need to reproduce start at
+ * thousands (storage heads with 10k block devices), so the tests write
+ * their own machine with a configurable device count and interface mix.
+ *
+ * Device naming follows the shipped file (acpi_CPU<n>, acpi_BAT<n>,
+ * storage_serial_<n>, volume_part<p>_size_<n>) so predicates written
+ * against fakecomputer.xml keep matching.
+ */
+namespace FakeMachineGenerator
+{
+struct Options {
+    int processors = 8;
+    int batteries = 2;
+    int drives = 16;
+    int partitionsPerDrive = 4;
+};
+
+inline int deviceCount(const Options &options)
+{
+    return 1 /*computer*/ + options.processors + options.batteries + options.drives * (1 + options.partitionsPerDrive);
+}
+
+inline bool writeMachine(const QString &path, const Options &options = Options())
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QTextStream out(&file);
+    const QString prefix = QStringLiteral("/org/kde/solid/fakehw");
+
+    out << "<machine>\n";
+    out << "    <device udi=\"" << prefix << "/computer\">\n"
+        << "        <property key=\"name\">Computer</property>\n"
+        << "        <property key=\"vendor\">Solid</property>\n"
+        << "    </device>\n";
+
+    for (int i = 0; i < options.processors; ++i) {
+        out << "    <device udi=\"" << prefix << "/acpi_CPU" << i << "\">\n"
+            << "        <property key=\"name\">Solid Processor #" << i << "</property>\n"
+            << "        <property key=\"vendor\">Acme Corporation</property>\n"
+            << "        <property key=\"interfaces\">Processor</property>\n"
+            << "        <property key=\"parent\">" << prefix << "/computer</property>\n"
+            << "        <property key=\"number\">" << i << "</property>\n"
+            << "        <property key=\"maxSpeed\">3200</property>\n"
+            << "        <property key=\"canChangeFrequency\">true</property>\n"
+            << "    </device>\n";
+    }
+
+    for (int i = 0; i < options.batteries; ++i) {
+        out << "    <device udi=\"" << prefix << "/acpi_BAT" << i << "\">\n"
+            << "        <property key=\"name\">Battery Bay #" << i << "</property>\n"
+            << "        <property key=\"interfaces\">Battery</property>\n"
+            << "        <property key=\"parent\">" << prefix << "/computer</property>\n"
+            << "        <property key=\"isPresent\">true</property>\n"
+            << "        <property key=\"batteryType\">primary</property>\n"
+            << "        <property key=\"isRechargeable\">true</property>\n"
+            << "        <property key=\"isPowerSupply\">true</property>\n"
+            << "        <property key=\"chargeState\">discharging</property>\n"
+            << "    </device>\n";
+    }
+
+    for (int drive = 0; drive < options.drives; ++drive) {
+        const QString driveUdi = QStringLiteral("%1/storage_serial_%2").arg(prefix).arg(drive);
+
+        out << "    <device udi=\"" << driveUdi << "\">\n"
+            << "        <property key=\"name\">Solid Disk #" << drive << "</property>\n"
+            << "        <property key=\"vendor\">Acme Corporation</property>\n"
+            << "        <property key=\"interfaces\">StorageDrive,Block</property>\n"
+            << "        <property key=\"parent\">" << prefix << "/computer</property>\n"
+            << "        <property key=\"major\">8</property>\n"
+            << "        <property key=\"minor\">" << drive * 16 << "</property>\n"
+            << "        <property key=\"device\">/dev/fake" << drive << "</property>\n"
+            << "        <property key=\"bus\">scsi</property>\n"
+            << "        <property key=\"driveType\">disk</property>\n"
+            << "        <property key=\"isRemovable\">false</property>\n"
+            << "        <property key=\"isHotpluggable\">false</property>\n"
+            << "    </device>\n";
+
+        for (int part = 1; part <= options.partitionsPerDrive; ++part) {
+            out << "    <device udi=\"" << driveUdi << "_part" << part << "\">\n"
+                << "        <property key=\"name\">Volume " << drive << "." << part << "</property>\n"
+                << "        <property key=\"interfaces\">Block,StorageVolume,StorageAccess</property>\n"
+                << "        <property key=\"parent\">" << driveUdi << "</property>\n"
+                << "        <property key=\"major\">8</property>\n"
+                << "        <property key=\"minor\">" << drive * 16 + part << "</property>\n"
+                << "        <property key=\"device\">/dev/fake" << drive << "p" << part << "</property>\n"
+                << "        <property key=\"isIgnored\">false</property>\n"
+                << "        <property key=\"isMounted\">false</property>\n"
+                << "        <property key=\"usage\">filesystem</property>\n"
+                << "        <property key=\"fsType\">ext4</property>\n"
+                << "        <property key=\"label\">vol-" << drive << "-" << part << "</property>\n"
+                << "        <property key=\"size\">1073741824</property>\n"
+                << "    </device>\n";
+        }
+    }
+
+    out << "</machine>\n";
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
+}
+
+#endif
@@ -0,0 +1,117 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include <QTemporaryFile>
+#include <QTest>
+
+#include <solid/device.h>
+#include <solid/predicate.h>
+
+#ifdef BENCHMARK_FSTAB
+#include "fstabhandling.h"
+#endif
+
+#ifndef FAKE_COMPUTER_XML
+#error "FAKE_COMPUTER_XML not set. An XML file describing a computer is required for this test"
+#endif
+
+/* Microbenchmarks for the query hot paths, running against the fakehw
+ * machine so the numbers don't depend on the host's hardware. These don't
+ * assert timings; regressions show up as changes in the QBENCHMARK output
+ * tracked across runs. */
+class SolidBenchmarkTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testPredicateParsing();
+    void testPredicateMatching();
+    void testListFromQuery();
+    void testAllDevices();
+#ifdef BENCHMARK_FSTAB
+    void testFstabParsing();
+#endif
+
+private:
+    QTemporaryFile m_syntheticFstab;
+};
+
+QTEST_MAIN(SolidBenchmarkTest)
+
+static const char s_predicate[] = "[ [ StorageVolume.ignored == false AND StorageVolume.usage == 'FileSystem' ] OR IS Processor ]";
+
+void SolidBenchmarkTest::initTestCase()
+{
+    qputenv("SOLID_FAKEHW", FAKE_COMPUTER_XML);
+
+    /* a large fstab of the kind lab deployments have; libmount picks the
+     * path up from LIBMOUNT_FSTAB, so the parser benchmark runs against
+     * this file instead of the host's /etc/fstab */
+    QVERIFY(m_syntheticFstab.open());
+    for (int i = 0; i < 3000; ++i) {
+        m_syntheticFstab.write(QStringLiteral("server%1:/export/share%1 /mnt/share%1 nfs defaults,ro,noauto,vers=4.2 0 0\n").arg(i).toUtf8());
+    }
+    m_syntheticFstab.flush();
+    qputenv("LIBMOUNT_FSTAB", QFile::encodeName(m_syntheticFstab.fileName()));
+}
+
+void SolidBenchmarkTest::testPredicateParsing()
+{
+    const QString predicate = QString::fromLatin1(s_predicate);
+    QBENCHMARK {
+        const Solid::Predicate parsed = Solid::Predicate::fromString(predicate);
+        QVERIFY(parsed.isValid());
+    }
+}
+
+void SolidBenchmarkTest::testPredicateMatching()
+{
+    const Solid::Predicate predicate = Solid::Predicate::fromString(QString::fromLatin1(s_predicate));
+    QVERIFY(predicate.isValid());
+    const QList<Solid::Device> devices = Solid::Device::allDevices();
+    QVERIFY(!devices.isEmpty());
+
+    QBENCHMARK {
+        int matches = 0;
+        for (const Solid::Device &device : devices) {
+            if (predicate.matches(device)) {
+                ++matches;
+            }
+        }
+        QVERIFY(matches > 0);
+    }
+}
+
+void SolidBenchmarkTest::testListFromQuery()
+{
+    const QString predicate = QString::fromLatin1(s_predicate);
+    QBENCHMARK {
+        const QList<Solid::Device> devices = Solid::Device::listFromQuery(predicate);
+        QVERIFY(!devices.isEmpty());
+    }
+}
+
+void SolidBenchmarkTest::testAllDevices()
+{
+    QBENCHMARK {
+        const QList<Solid::Device> devices = Solid::Device::allDevices();
+        QVERIFY(!devices.isEmpty());
+    }
+}
+
+#ifdef BENCHMARK_FSTAB
+void SolidBenchmarkTest::testFstabParsing()
+{
+    QBENCHMARK {
+        // flushing forces the next lookup to re-parse the whole table
+        Solid::Backends::Fstab::FstabHandling::flushFstabCache();
+        const QStringList devices = Solid::Backends::Fstab::FstabHandling::deviceList();
+        Q_UNUSED(devices)
+    }
+}
+#endif
+
+#include "solidbenchmarktest.moc"
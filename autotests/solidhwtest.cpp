@@ -10,10 +10,12 @@
 #include "solid/devices/managerbase_p.h"
 #include <solid/device.h>
 #include <solid/devicenotifier.h>
+#include <solid/devicequerycursor.h>
 #include <solid/genericinterface.h>
 #include <solid/predicate.h>
 #include <solid/processor.h>
 #include <solid/storageaccess.h>
+#include <solid/storagesetupjob.h>
 #include <solid/storagevolume.h>
 
 #include <fakedevice.h>
@@ -41,12 +43,20 @@ private Q_SLOTS:
     void testDeviceInterfaces();
     void testInvalidPredicate();
     void testPredicate();
+    void testPredicateOrderedComparisons();
+    void testPredicateOrderingStability();
+    void testPredicateBinaryRoundTrip();
     void testQueryStorageVolumeOrProcessor();
     void testQueryStorageVolumeOrStorageAccess();
     void testQueryWithParentUdi();
+    void testListFromQueries();
+    void testCountAndAnyFromQuery();
+    void testListFromQueryDeadline();
+    void testQueryCursor();
     void testListFromTypeProcessor();
     void testListFromTypeInvalid();
     void testSetupTeardown();
+    void testSetupAll();
     void testStorageAccessFromPath();
     void testStorageAccessFromPath_data();
 
@@ -387,6 +397,105 @@ void SolidHwTest::testPredicate()
     QCOMPARE(list.at(0).udi(), QStringLiteral("/org/kde/solid/fakehw/storage_model_solid_writer"));
 }
 
+void SolidHwTest::testPredicateOrderedComparisons()
+{
+    Solid::Device cpu(QStringLiteral("/org/kde/solid/fakehw/acpi_CPU0"));
+
+    QVERIFY(Solid::Predicate::fromString(QStringLiteral("Processor.maxSpeed > 3199")).matches(cpu));
+    QVERIFY(!Solid::Predicate::fromString(QStringLiteral("Processor.maxSpeed > 3200")).matches(cpu));
+    QVERIFY(Solid::Predicate::fromString(QStringLiteral("Processor.maxSpeed >= 3200")).matches(cpu));
+    QVERIFY(Solid::Predicate::fromString(QStringLiteral("Processor.maxSpeed < 3201")).matches(cpu));
+    QVERIFY(!Solid::Predicate::fromString(QStringLiteral("Processor.maxSpeed < 3200")).matches(cpu));
+    QVERIFY(Solid::Predicate::fromString(QStringLiteral("Processor.maxSpeed <= 3200")).matches(cpu));
+
+    // mixed numeric types are ordered without truncation
+    QVERIFY(Solid::Predicate::fromString(QStringLiteral("Processor.maxSpeed > 3199.5")).matches(cpu));
+    QVERIFY(!Solid::Predicate::fromString(QStringLiteral("Processor.maxSpeed > 3200.5")).matches(cpu));
+
+    // unordered pairs (string property against a number) never match
+    Solid::Device volume(QStringLiteral("/org/kde/solid/fakehw/volume_part1_size_993284096"));
+    QVERIFY(!Solid::Predicate::fromString(QStringLiteral("StorageVolume.fsType > 3")).matches(volume));
+
+    // the programmatic constructor takes the same operators
+    Solid::Predicate programmatic(Solid::DeviceInterface::Processor, QStringLiteral("maxSpeed"), 1000, Solid::Predicate::GreaterThanOrEqual);
+    QVERIFY(programmatic.matches(cpu));
+
+    // canonical form round-trips through the parser
+    const QString canonical = QStringLiteral("Processor.maxSpeed >= 3200");
+    QCOMPARE(Solid::Predicate::fromString(canonical).toString(), canonical);
+
+    // ordered terms work in queries too
+    const auto list = Solid::Device::listFromQuery(QStringLiteral("[StorageVolume.size > 1023 AND StorageVolume.size < 1025]"));
+    QCOMPARE(list.size(), 1);
+    QCOMPARE(list.at(0).udi(), QStringLiteral("/org/kde/solid/fakehw/volume_part2_size_1024"));
+}
+
+void SolidHwTest::testPredicateOrderingStability()
+{
+    /* Conjunction and disjunction operands get reordered by measured
+     * selectivity once enough evaluations accumulated; push the same
+     * predicates well past the warmup threshold and make sure the verdicts
+     * don't change with the evaluation order. */
+    Solid::Predicate conjunction = Solid::Predicate::fromString(QStringLiteral("[Processor.canChangeFrequency==true AND Processor.number==1]"));
+    Solid::Predicate disjunction = Solid::Predicate::fromString(QStringLiteral("[Processor.number==1 OR IS StorageVolume]"));
+
+    const QList<Solid::Device> devices = Solid::Device::allDevices();
+
+    QList<bool> andVerdicts;
+    QList<bool> orVerdicts;
+    for (const Solid::Device &device : devices) {
+        andVerdicts << conjunction.matches(device);
+        orVerdicts << disjunction.matches(device);
+    }
+
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < devices.size(); ++i) {
+            QCOMPARE(conjunction.matches(devices.at(i)), andVerdicts.at(i));
+            QCOMPARE(disjunction.matches(devices.at(i)), orVerdicts.at(i));
+        }
+    }
+}
+
+void SolidHwTest::testPredicateBinaryRoundTrip()
+{
+    const QStringList sources{QStringLiteral("IS StorageVolume"),
+                              QStringLiteral("Processor.maxSpeed == 3200"),
+                              QStringLiteral("StorageVolume.usage == 'Other'"),
+                              QStringLiteral("Processor.number & 1"),
+                              QStringLiteral("Processor.maxSpeed >= 3200"),
+                              QStringLiteral("[[Processor.maxSpeed == 3201 AND Processor.canChangeFrequency == false] OR StorageVolume.usage == 'Other']")};
+
+    const QList<Solid::Device> devices = Solid::Device::allDevices();
+
+    for (const QString &source : sources) {
+        const Solid::Predicate original = Solid::Predicate::fromString(source);
+        QVERIFY(original.isValid());
+
+        const QByteArray wire = original.toBinary();
+        QVERIFY(!wire.isEmpty());
+
+        const Solid::Predicate decoded = Solid::Predicate::fromBinary(wire);
+        QVERIFY(decoded.isValid());
+        QCOMPARE(decoded.toString(), original.toString());
+        for (const Solid::Device &device : devices) {
+            QCOMPARE(decoded.matches(device), original.matches(device));
+        }
+    }
+
+    // invalid predicates have no binary form
+    QVERIFY(Solid::Predicate().toBinary().isEmpty());
+
+    // corrupt input must decode to the invalid predicate, never crash
+    QVERIFY(!Solid::Predicate::fromBinary(QByteArray()).isValid());
+    QVERIFY(!Solid::Predicate::fromBinary(QByteArrayLiteral("garbage")).isValid());
+    QByteArray truncated = Solid::Predicate::fromString(sources.last()).toBinary();
+    truncated.chop(truncated.size() / 2);
+    QVERIFY(!Solid::Predicate::fromBinary(truncated).isValid());
+    QByteArray trailing = Solid::Predicate::fromString(sources.first()).toBinary();
+    trailing.append('\0');
+    QVERIFY(!Solid::Predicate::fromBinary(trailing).isValid());
+}
+
 void SolidHwTest::testQueryStorageVolumeOrProcessor()
 {
     auto list = Solid::Device::listFromQuery(QStringLiteral("[Processor.number==1 OR IS StorageVolume]"));
@@ -453,6 +562,99 @@ void SolidHwTest::testQueryWithParentUdi()
     QCOMPARE(fakeManager->devicesFromQuery(parentUdi, ifaceType).at(1), QStringLiteral("/org/kde/solid/fakehw/acpi_CPU1"));
 }
 
+void SolidHwTest::testListFromQueries()
+{
+    const QStringList queries{QStringLiteral("IS Processor"),
+                              QStringLiteral("[Processor.number==1 OR IS StorageVolume]"),
+                              QStringLiteral("blup"),
+                              QStringLiteral("StorageVolume.ignored == false")};
+
+    const auto results = Solid::Device::listFromQueries(queries);
+    QCOMPARE(results.size(), queries.size());
+
+    // the batch must agree with the per-query API, list for list
+    for (qsizetype i = 0; i < queries.size(); ++i) {
+        QCOMPARE(to_string_list(results.at(i)), to_string_list(Solid::Device::listFromQuery(queries.at(i))));
+    }
+
+    QCOMPARE(results.at(0).size(), 2);
+    QCOMPARE(results.at(1).size(), 13);
+    // the unparsable entry yields an empty list, like listFromQuery
+    QVERIFY(results.at(2).isEmpty());
+}
+
+void SolidHwTest::testCountAndAnyFromQuery()
+{
+    // bare interface checks take the backend count fast path
+    QCOMPARE(Solid::Device::countFromQuery(QStringLiteral("IS Processor")), qsizetype(2));
+    QCOMPARE(Solid::Device::countFromQuery(QStringLiteral("IS Processor"), QStringLiteral("/org/kde/solid/fakehw/computer")), qsizetype(2));
+    // property constraints fall back to predicate evaluation
+    QCOMPARE(Solid::Device::countFromQuery(QStringLiteral("[Processor.number==1 OR IS StorageVolume]")), qsizetype(13));
+    QCOMPARE(Solid::Device::countFromQuery(QStringLiteral("blup")), qsizetype(0));
+
+    QVERIFY(Solid::Device::anyFromQuery(QStringLiteral("IS Processor")));
+    QVERIFY(Solid::Device::anyFromQuery(QStringLiteral("Processor.number==1")));
+    QVERIFY(!Solid::Device::anyFromQuery(QStringLiteral("Processor.number==42")));
+    QVERIFY(!Solid::Device::anyFromQuery(QStringLiteral("blup")));
+}
+
+void SolidHwTest::testListFromQueryDeadline()
+{
+    // poison the out-parameter so we notice if it isn't written
+    auto *continuation = reinterpret_cast<Solid::DeviceQueryJob *>(this);
+    const auto p = Solid::Predicate::fromString(QStringLiteral("IS StorageVolume"));
+
+    const auto list = Solid::Device::listFromQuery(p, QString(), 30000, &continuation);
+
+    // fakehw answers well within the deadline: complete result, no continuation
+    QVERIFY(!continuation);
+    QCOMPARE(to_string_list(list), to_string_list(Solid::Device::listFromQuery(p)));
+}
+
+void SolidHwTest::testQueryCursor()
+{
+    const auto predicate = Solid::Predicate::fromString(QStringLiteral("[Processor.number==1 OR IS StorageVolume]"));
+    const QStringList full = to_string_list(Solid::Device::listFromQuery(predicate));
+    QCOMPARE(full.size(), 13);
+
+    // paging through the cursor yields exactly the listFromQuery result,
+    // in the same order
+    Solid::DeviceQueryCursor cursor(predicate);
+    QVERIFY(cursor.hasMore());
+
+    QStringList paged;
+    int pages = 0;
+    while (cursor.hasMore()) {
+        const auto page = cursor.fetchMore(5);
+        QVERIFY(page.size() <= 5);
+        paged += to_string_list(page);
+        ++pages;
+    }
+    QCOMPARE(paged, full);
+    QCOMPARE(pages, 3);
+    QVERIFY(!cursor.hasMore());
+    QVERIFY(cursor.fetchMore().isEmpty());
+
+    // copies share the position
+    Solid::DeviceQueryCursor original(predicate);
+    Solid::DeviceQueryCursor copy(original);
+    QCOMPARE(copy.fetchMore(4).size(), 4);
+    QCOMPARE(to_string_list(original.fetchMore(100)), full.mid(4));
+
+    // an invalid predicate walks all devices, like allDevices()
+    Solid::DeviceQueryCursor all((Solid::Predicate()));
+    QStringList everything;
+    while (all.hasMore()) {
+        everything += to_string_list(all.fetchMore());
+    }
+    QCOMPARE(everything, to_string_list(Solid::Device::allDevices()));
+
+    // a default-constructed cursor is exhausted from the start
+    Solid::DeviceQueryCursor empty;
+    QVERIFY(!empty.hasMore());
+    QVERIFY(empty.fetchMore().isEmpty());
+}
+
 void SolidHwTest::testListFromTypeProcessor()
 {
     const auto ifaceType = Solid::DeviceInterface::Processor;
@@ -492,6 +694,39 @@ void SolidHwTest::testSetupTeardown()
     QCOMPARE(args.at(0).toBool(), true);
 }
 
+void SolidHwTest::testSetupAll()
+{
+    Solid::Device volume(QStringLiteral("/org/kde/solid/fakehw/volume_part1_size_993284096"));
+    auto *access = volume.as<Solid::StorageAccess>();
+    QVERIFY(access);
+    if (access->isAccessible()) {
+        QVERIFY(access->teardown());
+    }
+
+    // one volume to mount, one device that is no volume at all
+    const QList<Solid::Device> devices{volume, Solid::Device(QStringLiteral("/org/kde/solid/fakehw/acpi_CPU0"))};
+
+    Solid::StorageSetupJob *job = Solid::StorageAccess::setupAll(devices);
+    QSignalSpy deviceSpy(job, &Solid::StorageSetupJob::deviceFinished);
+    QSignalSpy finishedSpy(job, &Solid::StorageSetupJob::finished);
+
+    QVERIFY(finishedSpy.wait(5000));
+    QVERIFY(job->isFinished());
+    QCOMPARE(deviceSpy.count(), 2);
+    QCOMPARE(job->results().size(), 2);
+    QCOMPARE(job->errorCount(), 1);
+
+    for (const Solid::StorageSetupJob::Result &result : job->results()) {
+        if (result.udi == volume.udi()) {
+            QCOMPARE(result.error, Solid::NoError);
+        } else {
+            QVERIFY(result.error != Solid::NoError);
+        }
+    }
+
+    QVERIFY(access->isAccessible());
+}
+
 void SolidHwTest::testStorageAccessFromPath()
 {
     QFETCH(QString, path);
@@ -0,0 +1,175 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QThread>
+
+#include "solid/devices/managerbase_p.h"
+#include <solid/device.h>
+#include <solid/devicenotifier.h>
+#include <solid/genericinterface.h>
+#include <solid/storagevolume.h>
+
+#include <fakemanager.h>
+
+#include "fakemachinegenerator.h"
+
+#include <atomic>
+
+/* Scaling harness for the multithreaded frontend, running against a
+ * generated machine of 10k+ devices instead of the handful in
+ * fakecomputer.xml: N reader threads hammer queries and property reads
+ * while the main thread keeps injecting fakehw hotplug events, and the
+ * throughput per thread count is reported. The numbers quantify what the
+ * per-thread frontend state costs; the only pass/fail criterion is that
+ * every configuration makes progress without deadlocking or crashing. */
+class SolidScalingTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testLargeMachine();
+    void testScalingThroughput();
+
+private:
+    QTemporaryDir tempDir;
+    FakeMachineGenerator::Options machineOptions;
+    Solid::Backends::Fake::FakeManager *fakeManager;
+};
+
+QTEST_MAIN(SolidScalingTest)
+
+class ReaderThread : public QThread
+{
+    Q_OBJECT
+public:
+    ReaderThread(std::atomic<bool> *stop, QAtomicInteger<qint64> *operations)
+        : m_stop(stop)
+        , m_operations(operations)
+    {
+    }
+
+protected:
+    void run() override
+    {
+        while (!m_stop->load(std::memory_order_relaxed)) {
+            const QList<Solid::Device> processors = Solid::Device::listFromQuery(QStringLiteral("IS Processor"));
+            const QList<Solid::Device> all = Solid::Device::allDevices();
+            for (const Solid::Device &device : all) {
+                if (const Solid::GenericInterface *iface = device.as<Solid::GenericInterface>()) {
+                    const QVariant name = iface->property(QStringLiteral("name"));
+                    Q_UNUSED(name)
+                }
+            }
+            Q_UNUSED(processors)
+            m_operations->fetchAndAddRelaxed(1);
+        }
+    }
+
+private:
+    std::atomic<bool> *m_stop;
+    QAtomicInteger<qint64> *m_operations;
+};
+
+void SolidScalingTest::initTestCase()
+{
+    machineOptions.processors = 32;
+    machineOptions.batteries = 2;
+    machineOptions.drives = 160;
+    machineOptions.partitionsPerDrive = 64;
+
+    QVERIFY(tempDir.isValid());
+    const QString machinePath = tempDir.filePath(QStringLiteral("machine.xml"));
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(FakeMachineGenerator::writeMachine(machinePath, machineOptions));
+    qInfo("generated machine with %d devices in %lldms", FakeMachineGenerator::deviceCount(machineOptions), static_cast<long long>(timer.elapsed()));
+
+    qputenv("SOLID_FAKEHW", machinePath.toLocal8Bit());
+
+    timer.restart();
+    Solid::ManagerBasePrivate *manager = dynamic_cast<Solid::ManagerBasePrivate *>(Solid::DeviceNotifier::instance());
+    fakeManager = qobject_cast<Solid::Backends::Fake::FakeManager *>(manager->managerBackends().first());
+    QVERIFY(fakeManager);
+    qInfo("backend loaded in %lldms", static_cast<long long>(timer.elapsed()));
+}
+
+void SolidScalingTest::testLargeMachine()
+{
+    QElapsedTimer timer;
+    timer.start();
+    const QList<Solid::Device> all = Solid::Device::allDevices();
+    const qint64 enumerateMsecs = timer.elapsed();
+
+    QCOMPARE(all.size(), FakeMachineGenerator::deviceCount(machineOptions));
+
+    timer.restart();
+    const QList<Solid::Device> volumes = Solid::Device::listFromQuery(QStringLiteral("StorageVolume.ignored == false"));
+    const qint64 queryMsecs = timer.elapsed();
+
+    QCOMPARE(volumes.size(), machineOptions.drives * machineOptions.partitionsPerDrive);
+    qInfo("devices=%lld enumerate_ms=%lld volume_query_ms=%lld",
+          static_cast<long long>(all.size()),
+          static_cast<long long>(enumerateMsecs),
+          static_cast<long long>(queryMsecs));
+}
+
+void SolidScalingTest::testScalingThroughput()
+{
+    const QString cpuUdi = QStringLiteral("/org/kde/solid/fakehw/acpi_CPU0");
+    const int measureMsecs = 500;
+
+    for (int threadCount : {1, 2, 4, 8}) {
+        std::atomic<bool> stop(false);
+        QAtomicInteger<qint64> operations(0);
+
+        QList<ReaderThread *> readers;
+        readers.reserve(threadCount);
+        for (int i = 0; i < threadCount; ++i) {
+            readers << new ReaderThread(&stop, &operations);
+        }
+        for (ReaderThread *reader : std::as_const(readers)) {
+            reader->start();
+        }
+
+        // the main thread is the writer: it owns the backend, so hotplug
+        // injection has to happen here
+        QElapsedTimer timer;
+        timer.start();
+        int plugCycles = 0;
+        while (timer.elapsed() < measureMsecs) {
+            fakeManager->unplug(cpuUdi);
+            fakeManager->plug(cpuUdi);
+            ++plugCycles;
+            QCoreApplication::processEvents();
+            QThread::usleep(500);
+        }
+
+        stop.store(true);
+        for (ReaderThread *reader : std::as_const(readers)) {
+            QVERIFY(reader->wait(30000));
+            delete reader;
+        }
+
+        const qint64 total = operations.loadRelaxed();
+        const double seconds = timer.nsecsElapsed() / 1000000000.0;
+        qInfo("threads=%d operations=%lld ops_per_sec=%.0f ops_per_sec_per_thread=%.0f hotplug_cycles=%d",
+              threadCount,
+              static_cast<long long>(total),
+              total / seconds,
+              total / seconds / threadCount,
+              plugCycles);
+
+        // progress, not speed, is the assertion
+        QVERIFY(total > 0);
+        QVERIFY(plugCycles > 0);
+    }
+}
+
+#include "solidscalingtest.moc"
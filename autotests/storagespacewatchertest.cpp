@@ -0,0 +1,63 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "solid/devices/frontend/storagespacewatcher_p.h"
+
+using Solid::StorageAccess;
+using Solid::StorageSpaceWatcher;
+
+class StorageSpaceWatcherTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testRootFilesystem();
+    void testNonMountPoint();
+    void testCachedAnswer();
+};
+
+void StorageSpaceWatcherTest::testRootFilesystem()
+{
+    const StorageAccess::SpaceInfo info = StorageSpaceWatcher::instance()->spaceInfo(QStringLiteral("/"));
+
+    QVERIFY(info.isValid());
+    QVERIFY(info.totalSize > 0);
+    QVERIFY(info.freeSize >= 0);
+    QVERIFY(info.freeSize <= info.totalSize);
+    // available excludes the reserved blocks free still counts
+    QVERIFY(info.availableSize >= 0);
+    QVERIFY(info.availableSize <= info.freeSize);
+}
+
+void StorageSpaceWatcherTest::testNonMountPoint()
+{
+    // a directory that is not a mount point must not be answered with its
+    // parent filesystem's figures
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const StorageAccess::SpaceInfo info = StorageSpaceWatcher::instance()->spaceInfo(dir.path());
+    QVERIFY(!info.isValid());
+    QCOMPARE(info.totalSize, -1);
+}
+
+void StorageSpaceWatcherTest::testCachedAnswer()
+{
+    // within the TTL the second query is a pure cache hit and must return
+    // identical figures even if the filesystem moved on meanwhile
+    const StorageAccess::SpaceInfo first = StorageSpaceWatcher::instance()->spaceInfo(QStringLiteral("/"));
+    const StorageAccess::SpaceInfo second = StorageSpaceWatcher::instance()->spaceInfo(QStringLiteral("/"));
+
+    QCOMPARE(second.totalSize, first.totalSize);
+    QCOMPARE(second.freeSize, first.freeSize);
+    QCOMPARE(second.availableSize, first.availableSize);
+}
+
+QTEST_GUILESS_MAIN(StorageSpaceWatcherTest)
+
+#include "storagespacewatchertest.moc"
@@ -0,0 +1,176 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTest>
+
+#include "fakeUdisks2.h"
+#include "qtest_dbus.h"
+
+#include "udisksdevice.h"
+#include "udisksmanager.h"
+
+using namespace Solid::Backends::UDisks2;
+
+/* Exercises the UDisks2 backend against an in-process mock udisksd on a
+ * private bus, so the performance paths — single-call enumeration,
+ * payload-seeded property caches, hotplug signal handling — run in CI
+ * without a system bus or real hardware. The mock's call counters make
+ * round-trip regressions hard assertions instead of timing guesses. */
+class UDisks2BackendTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanupTestCase();
+
+    void testEnumeration();
+    void testSeededPropertyCache();
+    void testHotplugStorm();
+    void testInjectedLatency();
+
+private:
+    FakeUdisks2 *m_mock = nullptr;
+};
+
+QTEST_GUILESS_MAIN_SYSTEM_DBUS(UDisks2BackendTest)
+
+static const int kDrives = 6;
+static const int kPartitionsPerDrive = 4;
+
+static int countDeviceUdis(const QStringList &udis)
+{
+    int count = 0;
+    for (const QString &udi : udis) {
+        if (udi.startsWith(QLatin1String(UD2_DBUS_PATH_BLOCKDEVICES "/")) || udi.startsWith(QLatin1String(UD2_DBUS_PATH_DRIVES "/"))) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void UDisks2BackendTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+
+    m_mock = new FakeUdisks2;
+    m_mock->populate(kDrives, kPartitionsPerDrive);
+    QVERIFY(m_mock->start());
+}
+
+void UDisks2BackendTest::init()
+{
+    // every test wants the cold enumeration path, not last run's snapshot
+    QFile::remove(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/solid-udisks2-topology.cache"));
+}
+
+void UDisks2BackendTest::cleanupTestCase()
+{
+    delete m_mock;
+}
+
+void UDisks2BackendTest::testEnumeration()
+{
+    const int callsBefore = m_mock->managedObjectsCalls();
+
+    Manager manager(nullptr);
+    QElapsedTimer timer;
+    timer.start();
+    const QStringList all = manager.allDevices();
+    const qint64 enumerateMsecs = timer.elapsed();
+
+    QCOMPARE(countDeviceUdis(all), FakeUdisks2::deviceObjectCount(kDrives, kPartitionsPerDrive));
+
+    // the whole tree must come from a single GetManagedObjects round trip
+    QCOMPARE(m_mock->managedObjectsCalls(), callsBefore + 1);
+
+    qInfo("devices=%d enumerate_ms=%lld", countDeviceUdis(all), static_cast<long long>(enumerateMsecs));
+}
+
+void UDisks2BackendTest::testSeededPropertyCache()
+{
+    Manager manager(nullptr);
+    manager.allDevices();
+
+    const int getAllBefore = m_mock->getAllCalls();
+
+    Device *device = qobject_cast<Device *>(manager.createDevice(QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES "/mock0p1")));
+    QVERIFY(device);
+    QCOMPARE(device->prop(QStringLiteral("IdType")).toString(), QStringLiteral("ext4"));
+    QCOMPARE(device->prop(QStringLiteral("IdLabel")).toString(), QStringLiteral("DATA_1"));
+    QCOMPARE(device->prop(QStringLiteral("Size")).toULongLong(), 512ULL * 1024 * 1024);
+    delete device;
+
+    // properties were seeded from the enumeration payload; reading them
+    // must not trigger any GetAll round trip
+    QCOMPARE(m_mock->getAllCalls(), getAllBefore);
+}
+
+void UDisks2BackendTest::testHotplugStorm()
+{
+    Manager manager(nullptr);
+    manager.allDevices();
+
+    const int kStorm = 100;
+    const QString drivePath = QStringLiteral(UD2_DBUS_PATH_DRIVES "/MOCK_DRIVE_0");
+    const QString tablePath = QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES "/mock0");
+
+    QSignalSpy added(&manager, &Manager::deviceAdded);
+    const int getAllBefore = m_mock->getAllCalls();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < kStorm; ++i) {
+        const QString name = QStringLiteral("storm%1").arg(i);
+        m_mock->addObject(QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES "/%1").arg(name),
+                          FakeUdisks2::partitionObject(name, drivePath, tablePath, kPartitionsPerDrive + 1 + i));
+    }
+    QTRY_COMPARE(added.count(), kStorm);
+    const qint64 stormMsecs = timer.elapsed();
+
+    // InterfacesAdded payloads carry the full property maps, the backends
+    // must be seeded from them instead of fetching per device
+    QCOMPARE(m_mock->getAllCalls(), getAllBefore);
+
+    QSignalSpy removed(&manager, &Manager::deviceRemoved);
+    for (int i = 0; i < kStorm; ++i) {
+        m_mock->removeObject(QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES "/storm%1").arg(i));
+    }
+    QTRY_COMPARE(removed.count(), kStorm);
+
+    qInfo("storm: %d adds in %lldms", kStorm, static_cast<long long>(stormMsecs));
+}
+
+void UDisks2BackendTest::testInjectedLatency()
+{
+    const int callsBefore = m_mock->managedObjectsCalls();
+    m_mock->setLatency(30);
+
+    Manager manager(nullptr);
+    QElapsedTimer timer;
+    timer.start();
+    const QStringList all = manager.allDevices();
+    const qint64 enumerateMsecs = timer.elapsed();
+
+    m_mock->setLatency(0);
+
+    QCOMPARE(countDeviceUdis(all), FakeUdisks2::deviceObjectCount(kDrives, kPartitionsPerDrive));
+    QCOMPARE(m_mock->managedObjectsCalls(), callsBefore + 1);
+
+    /* One round trip means the daemon latency is paid once, however many
+     * devices there are; a per-object call pattern would show up here as
+     * a multiple of the injected delay. */
+    QVERIFY(enumerateMsecs >= 30);
+    QVERIFY(enumerateMsecs < 30 * FakeUdisks2::deviceObjectCount(kDrives, kPartitionsPerDrive));
+
+    qInfo("latency=30ms enumerate_ms=%lld", static_cast<long long>(enumerateMsecs));
+}
+
+#include "udisks2backendtest.moc"
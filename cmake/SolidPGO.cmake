@@ -0,0 +1,61 @@
+# SPDX-FileCopyrightText: 2026 Solid contributors
+#
+# SPDX-License-Identifier: BSD-3-Clause
+
+# Optional profile-guided optimization for libKF6Solid.
+#
+# The hot paths of the library — predicate evaluation, property dispatch,
+# device enumeration — are branchy enough that profile feedback measurably
+# helps. The pipeline is a two-pass build driven by SOLID_PGO_MODE:
+#
+#   1. configure with -DSOLID_PGO_MODE=generate, build, then run the
+#      solid-pgo-training executable (built only in this mode) to collect
+#      profiles into SOLID_PGO_DATA_DIR;
+#   2. with Clang, merge the raw profiles first:
+#      llvm-profdata merge -output=<dir>/solid.profdata <dir>/*.profraw
+#   3. reconfigure with -DSOLID_PGO_MODE=use and rebuild.
+#
+# See docs/pgo.md for the full walk-through.
+
+set(SOLID_PGO_MODE "OFF" CACHE STRING "Profile-guided optimization mode for libKF6Solid (OFF, generate or use)")
+set_property(CACHE SOLID_PGO_MODE PROPERTY STRINGS OFF generate use)
+
+set(SOLID_PGO_DATA_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Directory the PGO profiles are written to and read from")
+
+# Applies the mode selected above to the given target. A no-op when
+# SOLID_PGO_MODE is OFF or the compiler is neither GCC nor Clang.
+function(solid_apply_pgo target)
+    if(NOT SOLID_PGO_MODE OR SOLID_PGO_MODE STREQUAL "OFF")
+        return()
+    endif()
+
+    if(NOT SOLID_PGO_MODE STREQUAL "generate" AND NOT SOLID_PGO_MODE STREQUAL "use")
+        message(FATAL_ERROR "SOLID_PGO_MODE must be OFF, generate or use (got '${SOLID_PGO_MODE}')")
+    endif()
+
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        if(SOLID_PGO_MODE STREQUAL "generate")
+            set(flags "-fprofile-generate=${SOLID_PGO_DATA_DIR}")
+        else()
+            # -fprofile-correction tolerates the slightly inconsistent
+            # counters threaded training runs produce
+            set(flags "-fprofile-use=${SOLID_PGO_DATA_DIR}" "-fprofile-correction")
+        endif()
+    elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        if(SOLID_PGO_MODE STREQUAL "generate")
+            set(flags "-fprofile-instr-generate=${SOLID_PGO_DATA_DIR}/solid-%p.profraw")
+        else()
+            set(flags "-fprofile-instr-use=${SOLID_PGO_DATA_DIR}/solid.profdata")
+        endif()
+    else()
+        message(WARNING "SOLID_PGO_MODE=${SOLID_PGO_MODE} is only supported with GCC and Clang; ignoring")
+        return()
+    endif()
+
+    if(SOLID_PGO_MODE STREQUAL "generate")
+        file(MAKE_DIRECTORY "${SOLID_PGO_DATA_DIR}")
+    endif()
+
+    target_compile_options(${target} PRIVATE ${flags})
+    target_link_options(${target} PRIVATE ${flags})
+endfunction()
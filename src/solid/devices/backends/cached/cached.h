@@ -0,0 +1,14 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_CACHED_H
+#define SOLID_BACKENDS_CACHED_H
+
+/* Devices from the snapshot keep their native UDI appended to this prefix,
+ * so the static dispatch tables route them here without ambiguity. */
+#define CACHED_UDI_PREFIX "/org/kde/solid/cached"
+
+#endif
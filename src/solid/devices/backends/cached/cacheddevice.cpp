@@ -0,0 +1,118 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "cacheddevice.h"
+
+#include "cached.h"
+#include "cachedinterfaces.h"
+
+using namespace Solid::Backends::Cached;
+
+CachedDevice::CachedDevice(const Shared::SnapshotDevice &snapshot, const QString &parentUdi)
+    : m_snapshot(snapshot)
+    , m_parentUdi(parentUdi)
+{
+}
+
+CachedDevice::~CachedDevice()
+{
+}
+
+QString CachedDevice::udi() const
+{
+    return QStringLiteral(CACHED_UDI_PREFIX) + m_snapshot.udi;
+}
+
+QString CachedDevice::parentUdi() const
+{
+    return m_parentUdi;
+}
+
+QString CachedDevice::vendor() const
+{
+    return m_snapshot.vendor;
+}
+
+QString CachedDevice::product() const
+{
+    return m_snapshot.product;
+}
+
+QString CachedDevice::icon() const
+{
+    return m_snapshot.icon;
+}
+
+QStringList CachedDevice::emblems() const
+{
+    return m_snapshot.emblems;
+}
+
+QString CachedDevice::description() const
+{
+    return m_snapshot.description;
+}
+
+bool CachedDevice::queryDeviceInterface(const Solid::DeviceInterface::Type &type) const
+{
+    if (!m_snapshot.interfaceTypes.contains(int(type))) {
+        return false;
+    }
+
+    /* The snapshot records every interface the live device had, but only
+     * the read-only ones can be served from captured data; StorageAccess
+     * and the like stay with the operational backends. */
+    switch (type) {
+    case Solid::DeviceInterface::GenericInterface:
+    case Solid::DeviceInterface::Processor:
+    case Solid::DeviceInterface::Block:
+    case Solid::DeviceInterface::StorageDrive:
+    case Solid::DeviceInterface::StorageVolume:
+    case Solid::DeviceInterface::Camera:
+    case Solid::DeviceInterface::PortableMediaPlayer:
+        return true;
+    default:
+        return false;
+    }
+}
+
+QObject *CachedDevice::createDeviceInterface(const Solid::DeviceInterface::Type &type)
+{
+    if (!queryDeviceInterface(type)) {
+        return nullptr;
+    }
+
+    switch (type) {
+    case Solid::DeviceInterface::GenericInterface:
+        return new GenericInterface(this);
+    case Solid::DeviceInterface::Processor:
+        return new Processor(this);
+    case Solid::DeviceInterface::Block:
+        return new Block(this);
+    case Solid::DeviceInterface::StorageDrive:
+        return new StorageDrive(this);
+    case Solid::DeviceInterface::StorageVolume:
+        return new StorageVolume(this);
+    case Solid::DeviceInterface::Camera:
+        return new Camera(this);
+    case Solid::DeviceInterface::PortableMediaPlayer:
+        return new PortableMediaPlayer(this);
+    default:
+        return nullptr;
+    }
+}
+
+QVariant CachedDevice::property(const QString &key) const
+{
+    return m_snapshot.properties.value(key);
+}
+
+QVariantMap CachedDevice::genericProperties() const
+{
+    return m_snapshot.properties.value(QStringLiteral("genericProperties")).toMap();
+}
+
+#include "moc_cacheddevice.cpp"
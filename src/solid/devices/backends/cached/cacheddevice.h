@@ -0,0 +1,56 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_CACHED_CACHEDDEVICE_H
+#define SOLID_BACKENDS_CACHED_CACHEDDEVICE_H
+
+#include <solid/devices/backends/shared/devicesnapshot.h>
+#include <solid/devices/ifaces/device.h>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Cached
+{
+/**
+ * A device materialized from the daemon's snapshot. Every answer comes
+ * from the captured record; nothing here ever touches udev or the bus.
+ */
+class CachedDevice : public Solid::Ifaces::Device
+{
+    Q_OBJECT
+
+public:
+    CachedDevice(const Shared::SnapshotDevice &snapshot, const QString &parentUdi);
+    ~CachedDevice() override;
+
+    QString udi() const override;
+    QString parentUdi() const override;
+
+    QString vendor() const override;
+    QString product() const override;
+    QString icon() const override;
+    QStringList emblems() const override;
+    QString description() const override;
+
+    bool queryDeviceInterface(const Solid::DeviceInterface::Type &type) const override;
+    QObject *createDeviceInterface(const Solid::DeviceInterface::Type &type) override;
+
+    /** Typed property lookup for the interface wrappers. */
+    QVariant property(const QString &key) const;
+    QVariantMap genericProperties() const;
+
+private:
+    Shared::SnapshotDevice m_snapshot;
+    QString m_parentUdi;
+};
+
+}
+}
+}
+
+#endif // SOLID_BACKENDS_CACHED_CACHEDDEVICE_H
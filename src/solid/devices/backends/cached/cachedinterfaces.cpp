@@ -0,0 +1,253 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "cachedinterfaces.h"
+
+#include "cached.h"
+#include "cacheddevice.h"
+
+using namespace Solid::Backends::Cached;
+
+GenericInterface::GenericInterface(CachedDevice *device)
+    : QObject(device)
+    , m_device(device)
+{
+}
+
+GenericInterface::~GenericInterface()
+{
+}
+
+QVariant GenericInterface::property(const QString &key) const
+{
+    return m_device->genericProperties().value(key);
+}
+
+QMap<QString, QVariant> GenericInterface::allProperties() const
+{
+    return m_device->genericProperties();
+}
+
+bool GenericInterface::propertyExists(const QString &key) const
+{
+    return m_device->genericProperties().contains(key);
+}
+
+Processor::Processor(CachedDevice *device)
+    : QObject(device)
+    , m_device(device)
+{
+}
+
+Processor::~Processor()
+{
+}
+
+int Processor::number() const
+{
+    return m_device->property(QStringLiteral("processor.number")).toInt();
+}
+
+int Processor::maxSpeed() const
+{
+    return m_device->property(QStringLiteral("processor.maxSpeed")).toInt();
+}
+
+bool Processor::canChangeFrequency() const
+{
+    return m_device->property(QStringLiteral("processor.canChangeFrequency")).toBool();
+}
+
+Solid::Processor::InstructionSets Processor::instructionSets() const
+{
+    return Solid::Processor::InstructionSets(m_device->property(QStringLiteral("processor.instructionSets")).toInt());
+}
+
+int Processor::packageId() const
+{
+    return m_device->property(QStringLiteral("processor.packageId")).toInt();
+}
+
+int Processor::coreId() const
+{
+    return m_device->property(QStringLiteral("processor.coreId")).toInt();
+}
+
+QList<int> Processor::threadSiblings() const
+{
+    return m_device->property(QStringLiteral("processor.threadSiblings")).value<QList<int>>();
+}
+
+Block::Block(CachedDevice *device)
+    : QObject(device)
+    , m_device(device)
+{
+}
+
+Block::~Block()
+{
+}
+
+int Block::deviceMajor() const
+{
+    return m_device->property(QStringLiteral("block.major")).toInt();
+}
+
+int Block::deviceMinor() const
+{
+    return m_device->property(QStringLiteral("block.minor")).toInt();
+}
+
+QString Block::device() const
+{
+    return m_device->property(QStringLiteral("block.device")).toString();
+}
+
+StorageDrive::StorageDrive(CachedDevice *device)
+    : Block(device)
+{
+}
+
+StorageDrive::~StorageDrive()
+{
+}
+
+Solid::StorageDrive::Bus StorageDrive::bus() const
+{
+    return Solid::StorageDrive::Bus(m_device->property(QStringLiteral("storagedrive.bus")).toInt());
+}
+
+Solid::StorageDrive::DriveType StorageDrive::driveType() const
+{
+    return Solid::StorageDrive::DriveType(m_device->property(QStringLiteral("storagedrive.driveType")).toInt());
+}
+
+bool StorageDrive::isRemovable() const
+{
+    return m_device->property(QStringLiteral("storagedrive.removable")).toBool();
+}
+
+bool StorageDrive::isHotpluggable() const
+{
+    return m_device->property(QStringLiteral("storagedrive.hotpluggable")).toBool();
+}
+
+qulonglong StorageDrive::size() const
+{
+    return m_device->property(QStringLiteral("storagedrive.size")).toULongLong();
+}
+
+QDateTime StorageDrive::timeDetected() const
+{
+    return m_device->property(QStringLiteral("storagedrive.timeDetected")).toDateTime();
+}
+
+QDateTime StorageDrive::timeMediaDetected() const
+{
+    return m_device->property(QStringLiteral("storagedrive.timeMediaDetected")).toDateTime();
+}
+
+StorageVolume::StorageVolume(CachedDevice *device)
+    : Block(device)
+{
+}
+
+StorageVolume::~StorageVolume()
+{
+}
+
+bool StorageVolume::isIgnored() const
+{
+    return m_device->property(QStringLiteral("storagevolume.ignored")).toBool();
+}
+
+Solid::StorageVolume::UsageType StorageVolume::usage() const
+{
+    return Solid::StorageVolume::UsageType(m_device->property(QStringLiteral("storagevolume.usage")).toInt());
+}
+
+QString StorageVolume::fsType() const
+{
+    return m_device->property(QStringLiteral("storagevolume.fsType")).toString();
+}
+
+QString StorageVolume::label() const
+{
+    return m_device->property(QStringLiteral("storagevolume.label")).toString();
+}
+
+QString StorageVolume::uuid() const
+{
+    return m_device->property(QStringLiteral("storagevolume.uuid")).toString();
+}
+
+qulonglong StorageVolume::size() const
+{
+    return m_device->property(QStringLiteral("storagevolume.size")).toULongLong();
+}
+
+QString StorageVolume::encryptedContainerUdi() const
+{
+    const QString native = m_device->property(QStringLiteral("storagevolume.encryptedContainerUdi")).toString();
+    // the container lives in the snapshot too, so point at its cached copy
+    return native.isEmpty() ? native : QStringLiteral(CACHED_UDI_PREFIX) + native;
+}
+
+Camera::Camera(CachedDevice *device)
+    : QObject(device)
+    , m_device(device)
+{
+}
+
+Camera::~Camera()
+{
+}
+
+QStringList Camera::supportedProtocols() const
+{
+    return m_device->property(QStringLiteral("camera.supportedProtocols")).toStringList();
+}
+
+QStringList Camera::supportedDrivers(QString protocol) const
+{
+    Q_UNUSED(protocol);
+    return m_device->property(QStringLiteral("camera.supportedDrivers")).toStringList();
+}
+
+QVariant Camera::driverHandle(const QString &driver) const
+{
+    Q_UNUSED(driver);
+    return m_device->property(QStringLiteral("camera.driverHandle"));
+}
+
+PortableMediaPlayer::PortableMediaPlayer(CachedDevice *device)
+    : QObject(device)
+    , m_device(device)
+{
+}
+
+PortableMediaPlayer::~PortableMediaPlayer()
+{
+}
+
+QStringList PortableMediaPlayer::supportedProtocols() const
+{
+    return m_device->property(QStringLiteral("portablemediaplayer.supportedProtocols")).toStringList();
+}
+
+QStringList PortableMediaPlayer::supportedDrivers(QString protocol) const
+{
+    Q_UNUSED(protocol);
+    return m_device->property(QStringLiteral("portablemediaplayer.supportedDrivers")).toStringList();
+}
+
+QVariant PortableMediaPlayer::driverHandle(const QString &driver) const
+{
+    Q_UNUSED(driver);
+    return m_device->property(QStringLiteral("portablemediaplayer.driverHandle"));
+}
+
+#include "moc_cachedinterfaces.cpp"
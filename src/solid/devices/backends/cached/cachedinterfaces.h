@@ -0,0 +1,165 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_CACHED_CACHEDINTERFACES_H
+#define SOLID_BACKENDS_CACHED_CACHEDINTERFACES_H
+
+#include <solid/devices/ifaces/block.h>
+#include <solid/devices/ifaces/camera.h>
+#include <solid/devices/ifaces/genericinterface.h>
+#include <solid/devices/ifaces/portablemediaplayer.h>
+#include <solid/devices/ifaces/processor.h>
+#include <solid/devices/ifaces/storagedrive.h>
+#include <solid/devices/ifaces/storagevolume.h>
+
+#include <QObject>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Cached
+{
+class CachedDevice;
+
+/* Each interface is a lookup table over the device's snapshot record;
+ * they are small enough to share one translation unit. */
+
+class GenericInterface : public QObject, virtual public Solid::Ifaces::GenericInterface
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::GenericInterface)
+
+public:
+    explicit GenericInterface(CachedDevice *device);
+    ~GenericInterface() override;
+
+    QVariant property(const QString &key) const override;
+    QMap<QString, QVariant> allProperties() const override;
+    bool propertyExists(const QString &key) const override;
+
+Q_SIGNALS:
+    // a snapshot never mutates; refreshes arrive as remove/add pairs
+    void propertyChanged(const QMap<QString, int> &changes) override;
+    void conditionRaised(const QString &condition, const QString &reason) override;
+
+protected:
+    CachedDevice *m_device;
+};
+
+class Processor : public QObject, virtual public Solid::Ifaces::Processor
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::Processor)
+
+public:
+    explicit Processor(CachedDevice *device);
+    ~Processor() override;
+
+    int number() const override;
+    int maxSpeed() const override;
+    bool canChangeFrequency() const override;
+    Solid::Processor::InstructionSets instructionSets() const override;
+    int packageId() const override;
+    int coreId() const override;
+    QList<int> threadSiblings() const override;
+
+protected:
+    CachedDevice *m_device;
+};
+
+class Block : public QObject, virtual public Solid::Ifaces::Block
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::Block)
+
+public:
+    explicit Block(CachedDevice *device);
+    ~Block() override;
+
+    int deviceMajor() const override;
+    int deviceMinor() const override;
+    QString device() const override;
+
+protected:
+    CachedDevice *m_device;
+};
+
+class StorageDrive : public Block, virtual public Solid::Ifaces::StorageDrive
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::StorageDrive)
+
+public:
+    explicit StorageDrive(CachedDevice *device);
+    ~StorageDrive() override;
+
+    Solid::StorageDrive::Bus bus() const override;
+    Solid::StorageDrive::DriveType driveType() const override;
+    bool isRemovable() const override;
+    bool isHotpluggable() const override;
+    qulonglong size() const override;
+    QDateTime timeDetected() const override;
+    QDateTime timeMediaDetected() const override;
+};
+
+class StorageVolume : public Block, virtual public Solid::Ifaces::StorageVolume
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::StorageVolume)
+
+public:
+    explicit StorageVolume(CachedDevice *device);
+    ~StorageVolume() override;
+
+    bool isIgnored() const override;
+    Solid::StorageVolume::UsageType usage() const override;
+    QString fsType() const override;
+    QString label() const override;
+    QString uuid() const override;
+    qulonglong size() const override;
+    QString encryptedContainerUdi() const override;
+};
+
+class Camera : public QObject, virtual public Solid::Ifaces::Camera
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::Camera)
+
+public:
+    explicit Camera(CachedDevice *device);
+    ~Camera() override;
+
+    QStringList supportedProtocols() const override;
+    QStringList supportedDrivers(QString protocol = QString()) const override;
+    QVariant driverHandle(const QString &driver) const override;
+
+protected:
+    CachedDevice *m_device;
+};
+
+class PortableMediaPlayer : public QObject, virtual public Solid::Ifaces::PortableMediaPlayer
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::PortableMediaPlayer)
+
+public:
+    explicit PortableMediaPlayer(CachedDevice *device);
+    ~PortableMediaPlayer() override;
+
+    QStringList supportedProtocols() const override;
+    QStringList supportedDrivers(QString protocol = QString()) const override;
+    QVariant driverHandle(const QString &driver) const override;
+
+protected:
+    CachedDevice *m_device;
+};
+
+}
+}
+}
+
+#endif // SOLID_BACKENDS_CACHED_CACHEDINTERFACES_H
@@ -0,0 +1,184 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "cachedmanager.h"
+#include "../shared/rootdevice.h"
+#include "cached.h"
+#include "cacheddevice.h"
+
+#include <QSet>
+#include <QTimer>
+
+using namespace Solid::Backends::Cached;
+using namespace Solid::Backends::Shared;
+
+static const int kReconnectMsecs = 5000;
+
+CachedManager::CachedManager(QObject *parent)
+    : Solid::Ifaces::DeviceManager(parent)
+{
+    m_supportedInterfaces << Solid::DeviceInterface::GenericInterface //
+                          << Solid::DeviceInterface::Processor //
+                          << Solid::DeviceInterface::Block //
+                          << Solid::DeviceInterface::StorageDrive //
+                          << Solid::DeviceInterface::StorageVolume //
+                          << Solid::DeviceInterface::Camera //
+                          << Solid::DeviceInterface::PortableMediaPlayer;
+
+    loadSnapshot(false /*emitChanges*/);
+
+    connect(&m_socket, &QLocalSocket::readyRead, this, &CachedManager::onNotification);
+    connect(&m_socket, &QLocalSocket::disconnected, this, &CachedManager::onDisconnected);
+    m_socket.connectToServer(DeviceSnapshot::serverName(), QIODevice::ReadOnly);
+}
+
+CachedManager::~CachedManager()
+{
+    disconnect(&m_socket, nullptr, this, nullptr);
+}
+
+QString CachedManager::udiPrefix() const
+{
+    return QStringLiteral(CACHED_UDI_PREFIX);
+}
+
+QSet<Solid::DeviceInterface::Type> CachedManager::supportedInterfaces() const
+{
+    return m_supportedInterfaces;
+}
+
+QStringList CachedManager::allDevices()
+{
+    QStringList result;
+    result.reserve(m_deviceList.size() + 1);
+
+    result << udiPrefix();
+    result += m_deviceList;
+
+    return result;
+}
+
+QStringList CachedManager::devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
+{
+    if (type != Solid::DeviceInterface::Unknown && !m_supportedInterfaces.contains(type)) {
+        return QStringList();
+    }
+
+    QStringList result;
+    for (const QString &udi : std::as_const(m_deviceList)) {
+        const Shared::SnapshotDevice &snapshot = m_devices[udi];
+        if (type != Solid::DeviceInterface::Unknown && !snapshot.interfaceTypes.contains(int(type))) {
+            continue;
+        }
+        if (!parentUdi.isEmpty() && cachedParentUdi(snapshot) != parentUdi) {
+            continue;
+        }
+        result << udi;
+    }
+
+    return result;
+}
+
+QObject *CachedManager::createDevice(const QString &udi)
+{
+    if (udi == udiPrefix()) {
+        RootDevice *root = new RootDevice(udi);
+
+        root->setProduct(tr("Device Cache"));
+        root->setDescription(tr("Devices enumerated by the session device cache"));
+        root->setIcon(QStringLiteral("computer"));
+
+        return root;
+    }
+
+    const auto it = m_devices.constFind(udi);
+    if (it == m_devices.constEnd()) {
+        return nullptr;
+    }
+
+    return new CachedDevice(it.value(), cachedParentUdi(it.value()));
+}
+
+void CachedManager::onNotification()
+{
+    // the payload is just "<generation>\n"; the snapshot itself is the data
+    m_socket.readAll();
+    loadSnapshot(true /*emitChanges*/);
+}
+
+void CachedManager::onDisconnected()
+{
+    /* The daemon went away; its last snapshot stays valid and keeps being
+     * served. Retry in the background in case it was only restarted. */
+    QTimer::singleShot(kReconnectMsecs, this, [this]() {
+        if (m_socket.state() == QLocalSocket::UnconnectedState) {
+            m_socket.connectToServer(DeviceSnapshot::serverName(), QIODevice::ReadOnly);
+        }
+    });
+}
+
+bool CachedManager::loadSnapshot(bool emitChanges)
+{
+    const QByteArray payload = DeviceSnapshot::fetch();
+    if (payload.isEmpty()) {
+        return false;
+    }
+
+    QList<Shared::SnapshotDevice> devices;
+    quint64 generation = 0;
+    if (!DeviceSnapshot::deserialize(payload, &devices, &generation)) {
+        return false;
+    }
+
+    if (generation == m_generation && !m_devices.isEmpty()) {
+        return true; // already on this snapshot
+    }
+
+    QHash<QString, Shared::SnapshotDevice> newDevices;
+    QStringList newList;
+    newDevices.reserve(devices.size());
+    newList.reserve(devices.size());
+    for (const Shared::SnapshotDevice &device : std::as_const(devices)) {
+        const QString udi = udiPrefix() + device.udi;
+        newDevices.insert(udi, device);
+        newList << udi;
+    }
+
+    const QStringList oldList = m_deviceList;
+    const auto oldDevices = m_devices;
+
+    m_devices = newDevices;
+    m_deviceList = newList;
+    m_generation = generation;
+
+    if (emitChanges) {
+        for (const QString &udi : oldList) {
+            if (!newDevices.contains(udi)) {
+                Q_EMIT deviceRemoved(udi);
+            }
+        }
+        for (const QString &udi : std::as_const(newList)) {
+            if (!oldDevices.contains(udi)) {
+                Q_EMIT deviceAdded(udi);
+            }
+        }
+    }
+
+    return true;
+}
+
+QString CachedManager::cachedParentUdi(const Shared::SnapshotDevice &snapshot) const
+{
+    if (snapshot.parentUdi.isEmpty()) {
+        return udiPrefix();
+    }
+
+    const QString parent = udiPrefix() + snapshot.parentUdi;
+    // parents outside the snapshot collapse onto the root device
+    return m_devices.contains(parent) ? parent : udiPrefix();
+}
+
+#include "moc_cachedmanager.cpp"
@@ -0,0 +1,68 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_CACHED_CACHEDMANAGER_H
+#define SOLID_BACKENDS_CACHED_CACHEDMANAGER_H
+
+#include <QHash>
+#include <QLocalSocket>
+#include <QSet>
+#include <QStringList>
+#include <solid/deviceinterface.h>
+#include <solid/devices/backends/shared/devicesnapshot.h>
+#include <solid/devices/ifaces/devicemanager.h>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Cached
+{
+/**
+ * Serves device listings from the shared-memory snapshot published by
+ * solid-cache-daemon6, so client processes skip their own udev and
+ * UDisks2 enumeration entirely. Change notifications arrive over the
+ * daemon's local socket and are translated into remove/add pairs by
+ * diffing snapshot generations.
+ *
+ * Enabled with SOLID_DEVICE_CACHE=1; operations that have to reach the
+ * real services (mounting, batteries, optical media) stay with their
+ * regular backends.
+ */
+class CachedManager : public Solid::Ifaces::DeviceManager
+{
+    Q_OBJECT
+
+public:
+    explicit CachedManager(QObject *parent);
+    ~CachedManager() override;
+
+    QString udiPrefix() const override;
+    QSet<Solid::DeviceInterface::Type> supportedInterfaces() const override;
+    QStringList allDevices() override;
+    QStringList devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type) override;
+    QObject *createDevice(const QString &udi) override;
+
+private Q_SLOTS:
+    void onNotification();
+    void onDisconnected();
+
+private:
+    bool loadSnapshot(bool emitChanges);
+    QString cachedParentUdi(const Shared::SnapshotDevice &snapshot) const;
+
+    QSet<Solid::DeviceInterface::Type> m_supportedInterfaces;
+    QHash<QString, Shared::SnapshotDevice> m_devices; // keyed by cached UDI
+    QStringList m_deviceList; // snapshot order, for stable enumeration
+    quint64 m_generation = 0;
+    QLocalSocket m_socket;
+};
+
+}
+}
+}
+
+#endif // SOLID_BACKENDS_CACHED_CACHEDMANAGER_H
@@ -8,12 +8,17 @@
 #include "fakedevice.h"
 
 // Qt includes
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDebug>
-#include <QDomDocument>
-#include <QDomElement>
-#include <QDomNode>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QString>
+#include <QTimer>
+#include <QXmlStreamReader>
 #ifdef HAVE_DBUS
 #include <QDBusConnection>
 #endif
@@ -27,6 +32,8 @@ public:
     QMap<QString, QMap<QString, QVariant>> hiddenDevices;
     QString xmlFile;
     QSet<Solid::DeviceInterface::Type> supportedInterfaces;
+    // running number behind the UDIs plugTemplate() hands out
+    quint64 cloneSerial = 0;
 };
 
 FakeManager::FakeManager(QObject *parent, const QString &xmlFile)
@@ -175,67 +182,275 @@ void FakeManager::unplug(const QString &udi)
     }
 }
 
+QStringList FakeManager::plugTemplate(const QString &templateUdi, int count)
+{
+    QMap<QString, QVariant> properties;
+    if (const FakeDevice *model = d->loadedDevices.value(templateUdi)) {
+        properties = model->allProperties();
+    } else if (d->hiddenDevices.contains(templateUdi)) {
+        properties = d->hiddenDevices.value(templateUdi);
+    } else {
+        qWarning() << Q_FUNC_INFO << "unknown template device" << templateUdi;
+        return QStringList();
+    }
+
+    QStringList plugged;
+    plugged.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        QString udi;
+        do {
+            udi = templateUdi + QStringLiteral("_clone%1").arg(++d->cloneSerial);
+        } while (d->loadedDevices.contains(udi) || d->hiddenDevices.contains(udi));
+
+        d->loadedDevices.insert(udi, new FakeDevice(udi, properties));
+        plugged.append(udi);
+        Q_EMIT deviceAdded(udi);
+    }
+
+    return plugged;
+}
+
+void FakeManager::unplugSet(const QStringList &udis)
+{
+    /* clear out the whole batch before the first signal fires, so an
+     * enumeration triggered from a removal handler never sees a device
+     * whose removal is still queued behind it */
+    QList<FakeDevice *> removedDevices;
+    QStringList removedUdis;
+    removedDevices.reserve(udis.size());
+    removedUdis.reserve(udis.size());
+
+    for (const QString &udi : udis) {
+        if (FakeDevice *dev = d->loadedDevices.take(udi)) {
+            d->hiddenDevices[udi] = dev->allProperties();
+            removedDevices.append(dev);
+            removedUdis.append(udi);
+        }
+    }
+
+    for (const QString &udi : std::as_const(removedUdis)) {
+        Q_EMIT deviceRemoved(udi);
+    }
+    qDeleteAll(removedDevices);
+}
+
+int FakeManager::replayEventScript(const QString &scriptFile)
+{
+    QFile file(scriptFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qWarning() << Q_FUNC_INFO << "Error while opening " << scriptFile;
+        return -1;
+    }
+
+    int scheduled = 0;
+    int lineNumber = 0;
+
+    while (!file.atEnd()) {
+        const QString line = QString::fromUtf8(file.readLine()).trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#'))) {
+            continue;
+        }
+
+        const QStringList fields = line.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+        bool offsetOk = false;
+        const int msecs = fields.size() == 3 ? fields.at(0).toInt(&offsetOk) : 0;
+        const QString action = fields.size() == 3 ? fields.at(1) : QString();
+        const bool isPlug = action == QLatin1String("plug");
+        if (!offsetOk || msecs < 0 || (!isPlug && action != QLatin1String("unplug"))) {
+            qWarning() << Q_FUNC_INFO << "malformed line" << lineNumber << "in" << scriptFile << ":" << line;
+            return -1;
+        }
+
+        const QString udi = fields.at(2);
+        QTimer::singleShot(msecs, this, [this, isPlug, udi]() {
+            if (isPlug) {
+                plug(udi);
+            } else {
+                unplug(udi);
+            }
+        });
+        ++scheduled;
+    }
+
+    return scheduled;
+}
+
 void FakeManager::parseMachineFile()
 {
+    if (loadMachineSnapshot()) {
+        return;
+    }
+
     QFile machineFile(d->xmlFile);
     if (!machineFile.open(QIODevice::ReadOnly)) {
         qWarning() << Q_FUNC_INFO << "Error while opening " << d->xmlFile;
         return;
     }
 
-    QDomDocument fakeDocument;
-    if (!fakeDocument.setContent(&machineFile)) {
-        qWarning() << Q_FUNC_INFO << "Error while creating the QDomDocument.";
-        machineFile.close();
+    qDebug() << Q_FUNC_INFO << "Parsing fake computer XML: " << d->xmlFile;
+
+    /* Streamed parse instead of a QDomDocument: machines generated for
+     * scaling tests hold tens of thousands of devices, and building the
+     * full DOM for those costs more than everything else at startup. */
+    QXmlStreamReader reader(&machineFile);
+
+    if (!reader.readNextStartElement()) { // the <machine> root
+        qWarning() << Q_FUNC_INFO << "Error while parsing " << d->xmlFile << ":" << reader.errorString();
         return;
     }
-    machineFile.close();
 
-    qDebug() << Q_FUNC_INFO << "Parsing fake computer XML: " << d->xmlFile;
-    QDomElement mainElement = fakeDocument.documentElement();
-    QDomNode node = mainElement.firstChild();
-    while (!node.isNull()) {
-        QDomElement tempElement = node.toElement();
-        if (!tempElement.isNull() && tempElement.tagName() == QLatin1String("device")) {
-            FakeDevice *tempDevice = parseDeviceElement(tempElement);
-            if (tempDevice) {
-                Q_ASSERT(!d->loadedDevices.contains(tempDevice->udi()));
-                d->loadedDevices.insert(tempDevice->udi(), tempDevice);
-                Q_EMIT deviceAdded(tempDevice->udi());
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("device")) {
+            reader.skipCurrentElement();
+            continue;
+        }
+
+        const QString udi = reader.attributes().value(QLatin1String("udi")).toString();
+        QMap<QString, QVariant> propertyMap;
+
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("property")) {
+                const QString propertyKey = reader.attributes().value(QLatin1String("key")).toString();
+                propertyMap.insert(propertyKey, QVariant(reader.readElementText()));
+            } else {
+                reader.skipCurrentElement();
             }
         }
 
-        node = node.nextSibling();
+        if (!propertyMap.isEmpty()) {
+            Q_ASSERT(!d->loadedDevices.contains(udi));
+            d->loadedDevices.insert(udi, new FakeDevice(udi, propertyMap));
+            Q_EMIT deviceAdded(udi);
+        }
+    }
+
+    if (reader.hasError()) {
+        qWarning() << Q_FUNC_INFO << "Error while parsing " << d->xmlFile << ":" << reader.errorString();
+    }
+
+    writeMachineSnapshot();
+}
+
+/* Binary snapshot of a parsed machine file. Test processes re-parse the
+ * same XML thousands of times a day; the snapshot replaces the whole DOM
+ * build with one streamed read of ready-made property maps. It is keyed
+ * by the absolute source path and validated against the source's mtime
+ * and size, so editing the XML transparently falls back to a re-parse. */
+
+static const quint32 kMachineSnapshotMagic = 0x53464857; // "SFHW"
+static const quint32 kMachineSnapshotVersion = 1;
+
+QString FakeManager::machineSnapshotPath() const
+{
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (cacheDir.isEmpty()) {
+        return QString();
     }
+
+    const QString sourcePath = QFileInfo(d->xmlFile).absoluteFilePath();
+    const QByteArray key = QCryptographicHash::hash(sourcePath.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return cacheDir + QLatin1String("/solid-fakehw/") + QString::fromLatin1(key) + QLatin1String(".bin");
 }
 
-FakeDevice *FakeManager::parseDeviceElement(const QDomElement &deviceElement)
+bool FakeManager::loadMachineSnapshot()
 {
-    FakeDevice *device = nullptr;
-    QMap<QString, QVariant> propertyMap;
-    QString udi = deviceElement.attribute(QStringLiteral("udi"));
+    const QString snapshotPath = machineSnapshotPath();
+    if (snapshotPath.isEmpty()) {
+        return false;
+    }
+
+    const QFileInfo source(d->xmlFile);
+    if (!source.exists()) {
+        return false;
+    }
+
+    QFile snapshotFile(snapshotPath);
+    if (!snapshotFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
 
-    QDomNode propertyNode = deviceElement.firstChild();
-    while (!propertyNode.isNull()) {
-        QDomElement propertyElement = propertyNode.toElement();
-        if (!propertyElement.isNull() && propertyElement.tagName() == QLatin1String("property")) {
-            QString propertyKey;
-            QVariant propertyValue;
+    // map instead of read: the property maps are deserialized straight out
+    // of the page cache without an intermediate buffer
+    QByteArray payload;
+    if (const uchar *mapped = snapshotFile.map(0, snapshotFile.size())) {
+        payload = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), snapshotFile.size());
+    } else {
+        payload = snapshotFile.readAll();
+    }
 
-            propertyKey = propertyElement.attribute(QStringLiteral("key"));
-            propertyValue = QVariant(propertyElement.text());
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_6_5);
 
-            propertyMap.insert(propertyKey, propertyValue);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 sourceMTime = 0;
+    qint64 sourceSize = 0;
+    quint32 count = 0;
+    stream >> magic >> version >> sourceMTime >> sourceSize >> count;
+
+    if (magic != kMachineSnapshotMagic || version != kMachineSnapshotVersion) {
+        return false;
+    }
+    if (sourceMTime != source.lastModified().toMSecsSinceEpoch() || sourceSize != source.size()) {
+        return false; // the XML changed since the snapshot was taken
+    }
+
+    QMap<QString, FakeDevice *> devices;
+    for (quint32 i = 0; i < count; ++i) {
+        QString udi;
+        QMap<QString, QVariant> propertyMap;
+        stream >> udi >> propertyMap;
+        if (stream.status() != QDataStream::Ok || udi.isEmpty()) {
+            qDeleteAll(devices);
+            return false;
         }
+        devices.insert(udi, new FakeDevice(udi, propertyMap));
+    }
 
-        propertyNode = propertyNode.nextSibling();
+    for (auto it = devices.cbegin(); it != devices.cend(); ++it) {
+        Q_ASSERT(!d->loadedDevices.contains(it.key()));
+        d->loadedDevices.insert(it.key(), it.value());
+        Q_EMIT deviceAdded(it.key());
     }
 
-    if (!propertyMap.isEmpty()) {
-        device = new FakeDevice(udi, propertyMap);
+    return true;
+}
+
+void FakeManager::writeMachineSnapshot()
+{
+    const QString snapshotPath = machineSnapshotPath();
+    if (snapshotPath.isEmpty() || d->loadedDevices.isEmpty()) {
+        return;
+    }
+
+    const QFileInfo source(d->xmlFile);
+    if (!QDir().mkpath(QFileInfo(snapshotPath).absolutePath())) {
+        return;
+    }
+
+    // QSaveFile commits atomically, so parallel test runs racing on the
+    // same machine file can never observe a half-written snapshot
+    QSaveFile snapshotFile(snapshotPath);
+    if (!snapshotFile.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream stream(&snapshotFile);
+    stream.setVersion(QDataStream::Qt_6_5);
+
+    stream << kMachineSnapshotMagic //
+           << kMachineSnapshotVersion //
+           << qint64(source.lastModified().toMSecsSinceEpoch()) //
+           << qint64(source.size()) //
+           << quint32(d->loadedDevices.size());
+
+    for (auto it = d->loadedDevices.cbegin(); it != d->loadedDevices.cend(); ++it) {
+        stream << it.key() << it.value()->allProperties();
     }
 
-    return device;
+    snapshotFile.commit();
 }
 
 #include "moc_fakemanager.cpp"
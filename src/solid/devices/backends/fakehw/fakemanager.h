@@ -9,8 +9,6 @@
 
 #include <solid/devices/ifaces/devicemanager.h>
 
-class QDomElement;
-
 using namespace Solid::Ifaces;
 
 namespace Solid
@@ -51,19 +49,55 @@ public Q_SLOTS:
     void plug(const QString &udi);
     void unplug(const QString &udi);
 
+    /**
+     * Plug @p count copies of the device known as @p templateUdi (loaded
+     * or currently unplugged). Each clone gets a fresh UDI derived from
+     * the template's; the new UDIs are returned in plug order.
+     *
+     * Exists so storm tests can inject hundreds of devices in one D-Bus
+     * round trip instead of scripting plug() per device.
+     */
+    QStringList plugTemplate(const QString &templateUdi, int count);
+
+    /**
+     * Unplug all of @p udis as one batch: every device leaves the visible
+     * set before the first deviceRemoved() is emitted, so handlers running
+     * during the signals already observe the post-batch device list.
+     */
+    void unplugSet(const QStringList &udis);
+
+    /**
+     * Replay a timed event script. Each non-empty, non-comment line reads
+     *
+     *   <offset-ms> plug|unplug <udi>
+     *
+     * and schedules the action that many milliseconds after the call
+     * returns. Returns the number of scheduled events, or -1 if the file
+     * could not be read or contains a malformed line.
+     */
+    int replayEventScript(const QString &scriptFile);
+
 private Q_SLOTS:
     /**
      * @internal
      * Parse the XML file that represent the fake machine.
      */
     void parseMachineFile();
+
+private:
     /**
      * @internal
-     * Parse a device node and the return the device.
+     * Load the devices from the binary snapshot of the machine file,
+     * if an up-to-date one exists.
      */
-    FakeDevice *parseDeviceElement(const QDomElement &element);
+    bool loadMachineSnapshot();
+    /**
+     * @internal
+     * Write the binary snapshot after a successful XML parse.
+     */
+    void writeMachineSnapshot();
+    QString machineSnapshotPath() const;
 
-private:
     QStringList findDeviceStringMatch(const QString &key, const QString &value);
     QStringList findDeviceByDeviceInterface(Solid::DeviceInterface::Type type);
 
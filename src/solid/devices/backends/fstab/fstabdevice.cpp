@@ -7,17 +7,20 @@
 #include "fstabdevice.h"
 #include "fstab_debug.h"
 #include "fstabhandling.h"
+#include "fstabmanager.h"
 #include "fstabnetworkshare.h"
 #include "fstabservice.h"
 #include <QCoreApplication>
 #include <QDir>
+#include <QMetaMethod>
 #include <QUrl>
 
 using namespace Solid::Backends::Fstab;
 
-FstabDevice::FstabDevice(QString uid)
+FstabDevice::FstabDevice(QString uid, FstabManager *manager)
     : Solid::Ifaces::Device()
     , m_uid(uid)
+    , m_manager(manager)
 {
     m_device = m_uid.mid(parentUdi().length() + 1);
 
@@ -92,6 +95,49 @@ FstabDevice::FstabDevice(QString uid)
 
 FstabDevice::~FstabDevice()
 {
+    /* the queued update never runs once we're gone; give the interest
+     * back explicitly so the watcher can disarm */
+    if (m_watcherInterest && m_manager) {
+        m_manager->removeDeviceInterest();
+    }
+}
+
+void FstabDevice::connectNotify(const QMetaMethod &signal)
+{
+    if (signal == QMetaMethod::fromSignal(&FstabDevice::mtabChanged)) {
+        scheduleWatcherInterestUpdate();
+    }
+}
+
+void FstabDevice::disconnectNotify(const QMetaMethod &signal)
+{
+    /* an invalid method here means "disconnected from everything" */
+    if (!signal.isValid() || signal == QMetaMethod::fromSignal(&FstabDevice::mtabChanged)) {
+        scheduleWatcherInterestUpdate();
+    }
+}
+
+void FstabDevice::scheduleWatcherInterestUpdate()
+{
+    /* The notify hooks run on the connecting thread with internal
+     * signal/slot locks held, so hop to our own thread before talking
+     * to the manager. */
+    QMetaObject::invokeMethod(this, &FstabDevice::updateWatcherInterest, Qt::QueuedConnection);
+}
+
+void FstabDevice::updateWatcherInterest()
+{
+    const bool interested = isSignalConnected(QMetaMethod::fromSignal(&FstabDevice::mtabChanged));
+    if (interested == m_watcherInterest || !m_manager) {
+        return;
+    }
+
+    m_watcherInterest = interested;
+    if (interested) {
+        m_manager->addDeviceInterest();
+    } else {
+        m_manager->removeDeviceInterest();
+    }
 }
 
 QString FstabDevice::udi() const
@@ -176,10 +222,10 @@ QString FstabDevice::device() const
     return m_device;
 }
 
-void FstabDevice::onMtabChanged(const QString &device)
+void FstabDevice::onMtabChanged(const QString &device, const QString &filePath, bool isAccessible)
 {
     if (m_device == device) {
-        Q_EMIT mtabChanged(device);
+        Q_EMIT mtabChanged(device, filePath, isAccessible);
     }
 }
 
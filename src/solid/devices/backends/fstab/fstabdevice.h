@@ -18,12 +18,14 @@ namespace Backends
 {
 namespace Fstab
 {
+class FstabManager;
+
 class FstabDevice : public Solid::Ifaces::Device
 {
     Q_OBJECT
 
 public:
-    FstabDevice(QString uid);
+    explicit FstabDevice(QString uid, FstabManager *manager = nullptr);
 
     ~FstabDevice() override;
 
@@ -52,12 +54,27 @@ public:
     QString device() const;
 
 Q_SIGNALS:
-    void mtabChanged(const QString &device);
+    void mtabChanged(const QString &device, const QString &filePath, bool isAccessible);
 
 public Q_SLOTS:
-    void onMtabChanged(const QString &device);
+    void onMtabChanged(const QString &device, const QString &filePath, bool isAccessible);
+
+protected:
+    /**
+     * Track whether anybody listens to mtabChanged(); the manager keeps
+     * the fstab watcher armed while at least one device has a receiver,
+     * so held storage accesses see mount transitions even when no global
+     * change listener exists.
+     */
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
+
+private Q_SLOTS:
+    void updateWatcherInterest();
 
 private:
+    void scheduleWatcherInterestUpdate();
+
     QString m_uid;
     QString m_device;
     QString m_product;
@@ -66,6 +83,9 @@ private:
     QString m_description;
     QString m_iconName;
     QPointer<FstabStorageAccess> m_storageAccess;
+    /* the manager outliving us is not guaranteed during teardown */
+    QPointer<FstabManager> m_manager;
+    bool m_watcherInterest = false;
     enum class StorageType : uint8_t {
         Other = 0,
         NetworkShare,
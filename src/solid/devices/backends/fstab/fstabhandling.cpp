@@ -6,43 +6,44 @@
 */
 
 #include "fstabhandling.h"
+#include "../shared/mounttable.h"
 #include "fstab_debug.h"
 
+#include <QCoreApplication>
 #include <QFile>
+#include <QMutex>
 #include <QObject>
 #include <QProcess>
 #include <QRegularExpression>
+#include <QReadLocker>
+#include <QSet>
 #include <QStandardPaths>
 #include <QTextStream>
-#include <QThreadStorage>
+#include <QWriteLocker>
 
 #include <solid/devices/soliddefs_p.h>
+#include <solid/devices/solidstatistics_p.h>
+#include <solid/devices/solidtrace_p.h>
 
 #include <solid/config-solid.h>
 #include <stdlib.h>
 
+#include <utility>
+
 #if HAVE_LIBMOUNT
 #include <libmount/libmount.h>
 #endif
 
-// This is the *BSD branch
-#if HAVE_SYS_MOUNT_H
-#if HAVE_SYS_TYPES_H
-#include <sys/types.h>
-#endif
-#if HAVE_SYS_PARAM_H
-#include <sys/param.h>
-#endif
-#include <sys/mount.h>
-#endif
-
 #define FSTAB "/etc/fstab"
 
-// There are currently two APIs implemented:
-// libmount for linux
-// getmntinfo + struct statfs&flags (BSD 4.4 and friends)
+// fstab itself is parsed here (libmount on linux, plain text elsewhere);
+// the mounted filesystems come from the Shared::MountTable snapshot, which
+// the UDisks2 backend consumes too
 
-Q_GLOBAL_STATIC(QThreadStorage<Solid::Backends::Fstab::FstabHandling>, globalFstabCache)
+/* One cache for the whole process; with the previous per-thread storage
+ * every worker of a threaded client re-parsed fstab and the mount table
+ * for itself. */
+Q_GLOBAL_STATIC(Solid::Backends::Fstab::FstabHandling, globalFstabCache)
 
 Solid::Backends::Fstab::FstabHandling::FstabHandling()
     : m_fstabCacheValid(false)
@@ -95,15 +96,10 @@ QString _k_deviceNameForMountpoint(const QString &source, const QString &fstype,
     return source + QLatin1Char(':') + _mountpoint;
 }
 
-void Solid::Backends::Fstab::FstabHandling::_k_updateFstabMountPointsCache()
+void Solid::Backends::Fstab::FstabHandling::_k_parseFstab(QStringMultiHash &mountsCache,
+                                                          QHash<QString, QByteArray> &optionsCache,
+                                                          QHash<QString, QString> &fstypeCache)
 {
-    if (globalFstabCache->localData().m_fstabCacheValid) {
-        return;
-    }
-
-    globalFstabCache->localData().m_fstabCache.clear();
-    globalFstabCache->localData().m_fstabOptionsCache.clear();
-
 #if HAVE_LIBMOUNT
 
     struct libmnt_table *table = mnt_new_table();
@@ -119,22 +115,30 @@ void Solid::Backends::Fstab::FstabHandling::_k_updateFstabMountPointsCache()
     struct libmnt_iter *itr = mnt_new_iter(MNT_ITER_FORWARD);
     struct libmnt_fs *fs;
 
+    /* lab fstabs repeat the same option string across hundreds of shares;
+     * keep one allocation per distinct string (parsing waits until
+     * options() actually asks for a device) */
+    QHash<QByteArray, QByteArray> interned;
+
     while (mnt_table_next_fs(table, itr, &fs) == 0) {
         const QString fstype = QFile::decodeName(mnt_fs_get_fstype(fs));
         const QString fsname = QFile::decodeName(mnt_fs_get_srcpath(fs));
         if (_k_isFstabNetworkFileSystem(fstype, fsname) || _k_isFstabSupportedLocalFileSystem(fstype)) {
             const QString mountpoint = QFile::decodeName(mnt_fs_get_target(fs));
             const QString device = _k_deviceNameForMountpoint(fsname, fstype, mountpoint);
-            const QStringList options = QFile::decodeName(mnt_fs_strdup_options(fs)).split(QLatin1Char(','));
 
-            globalFstabCache->localData().m_fstabCache.insert(device, mountpoint);
-            globalFstabCache->localData().m_fstabFstypeCache.insert(device, fstype);
-            for (const auto &optionLine : options) {
-                const auto split = optionLine.split(QLatin1Char('='));
-                const auto optionName = split[0];
-                const auto optionValue = split.size() > 1 ? split[1] : QString{};
+            mountsCache.insert(device, mountpoint);
+            fstypeCache.insert(device, fstype);
 
-                globalFstabCache->localData().m_fstabOptionsCache[device].insert(optionName, optionValue);
+            char *optionString = mnt_fs_strdup_options(fs);
+            if (optionString) {
+                const QByteArray raw(optionString);
+                auto option = interned.constFind(raw);
+                if (option == interned.constEnd()) {
+                    option = interned.insert(raw, raw);
+                }
+                optionsCache.insert(device, option.value());
+                free(optionString);
             }
         }
     }
@@ -145,6 +149,9 @@ void Solid::Backends::Fstab::FstabHandling::_k_updateFstabMountPointsCache()
 
 #else
 
+    Q_UNUSED(optionsCache)
+    Q_UNUSED(fstypeCache)
+
     QFile fstab(QStringLiteral(FSTAB));
     if (!fstab.open(QIODevice::ReadOnly)) {
         return;
@@ -178,13 +185,75 @@ void Solid::Backends::Fstab::FstabHandling::_k_updateFstabMountPointsCache()
                 }
             }
 
-            globalFstabCache->localData().m_fstabCache.insert(device, mountpoint);
+            mountsCache.insert(device, mountpoint);
         }
     }
 
     fstab.close();
 #endif
-    globalFstabCache->localData().m_fstabCacheValid = true;
+}
+
+void Solid::Backends::Fstab::FstabHandling::accountTables()
+{
+    auto &cache = *globalFstabCache;
+
+    const auto mountHashBytes = [](const QStringMultiHash &hash) {
+        qint64 bytes = 0;
+        for (auto it = hash.cbegin(), end = hash.cend(); it != end; ++it) {
+            bytes += Solid::Stats::stringBytes(it.key()) + Solid::Stats::stringBytes(it.value()) + qint64(4 * sizeof(void *));
+        }
+        return bytes;
+    };
+
+    qint64 bytes = mountHashBytes(cache.m_fstabCache) + mountHashBytes(cache.m_mtabCache);
+    for (auto it = cache.m_fstabFstypeCache.cbegin(), end = cache.m_fstabFstypeCache.cend(); it != end; ++it) {
+        bytes += Solid::Stats::stringBytes(it.key()) + Solid::Stats::stringBytes(it.value()) + qint64(4 * sizeof(void *));
+    }
+    for (const auto &options : {std::cref(cache.m_fstabOptionsCache), std::cref(cache.m_mtabOptionsCache)}) {
+        for (auto it = options.get().cbegin(), end = options.get().cend(); it != end; ++it) {
+            bytes += Solid::Stats::stringBytes(it.key()) + qint64(sizeof(QByteArray) + it.value().size() + 4 * sizeof(void *));
+        }
+    }
+    for (auto it = cache.m_parsedOptionsCache.cbegin(), end = cache.m_parsedOptionsCache.cend(); it != end; ++it) {
+        bytes += qint64(sizeof(QByteArray) + it.key().size() + sizeof(MountOptions) + 4 * sizeof(void *));
+    }
+
+    Solid::Stats::add(Solid::Stats::counters().fstabCacheBytes, bytes - cache.m_accountedBytes);
+    cache.m_accountedBytes = bytes;
+}
+
+void Solid::Backends::Fstab::FstabHandling::_k_updateFstabMountPointsCache()
+{
+    {
+        QReadLocker locker(&globalFstabCache->m_lock);
+        if (globalFstabCache->m_fstabCacheValid) {
+            return;
+        }
+    }
+
+    /* parse outside the lock so readers of the previous snapshot are not
+     * held up behind libmount */
+    QStringMultiHash mounts;
+    QHash<QString, QByteArray> options;
+    QHash<QString, QString> fstypes;
+    const Solid::Trace::Timer traceTimer;
+    _k_parseFstab(mounts, options, fstypes);
+    SOLID_TRACE1(fstab_parse_fstab, traceTimer.nsecs());
+    Solid::Stats::add(Solid::Stats::counters().fstabCacheRefills);
+
+    QWriteLocker locker(&globalFstabCache->m_lock);
+    if (globalFstabCache->m_fstabCacheValid) {
+        // another thread published a fresh table while we were parsing
+        return;
+    }
+
+    globalFstabCache->m_fstabCache = mounts;
+    globalFstabCache->m_fstabOptionsCache = options;
+    for (auto it = fstypes.cbegin(), end = fstypes.cend(); it != end; ++it) {
+        globalFstabCache->m_fstabFstypeCache.insert(it.key(), it.value());
+    }
+    globalFstabCache->m_fstabCacheValid = true;
+    accountTables();
 }
 
 QStringList Solid::Backends::Fstab::FstabHandling::deviceList()
@@ -192,15 +261,20 @@ QStringList Solid::Backends::Fstab::FstabHandling::deviceList()
     _k_updateFstabMountPointsCache();
     _k_updateMtabMountPointsCache();
 
-    QStringList devices = globalFstabCache->localData().m_mtabCache.keys();
+    QReadLocker locker(&globalFstabCache->m_lock);
+
+    QStringList devices = globalFstabCache->m_mtabCache.keys();
+    /* membership checks through a set; scanning the result list per fstab
+     * entry went quadratic on fstabs with hundreds of shares */
+    QSet<QString> known(devices.cbegin(), devices.cend());
 
     // Ensure that regardless an fstab device ends with a slash
     // it will match its eventual mounted device regardless whether or not its path
     // ends with a slash
-    for (auto it = globalFstabCache->localData().m_fstabCache.constBegin(), end = globalFstabCache->localData().m_fstabCache.constEnd(); it != end; ++it) {
-        auto device = it.key();
+    for (auto it = globalFstabCache->m_fstabCache.constBegin(), end = globalFstabCache->m_fstabCache.constEnd(); it != end; ++it) {
+        const auto &device = it.key();
         // the device is already known
-        if (devices.contains(device)) {
+        if (known.contains(device)) {
             continue;
         }
 
@@ -211,8 +285,9 @@ QStringList Solid::Backends::Fstab::FstabHandling::deviceList()
         } else {
             deviceName.append(QLatin1Char('/'));
         }
-        if (!devices.contains(deviceName)) {
+        if (!known.contains(deviceName)) {
             devices.append(device);
+            known.insert(device);
         }
     }
     return devices;
@@ -223,20 +298,64 @@ QStringList Solid::Backends::Fstab::FstabHandling::mountPoints(const QString &de
     _k_updateFstabMountPointsCache();
     _k_updateMtabMountPointsCache();
 
-    QStringList mountpoints = globalFstabCache->localData().m_fstabCache.values(device);
-    mountpoints += globalFstabCache->localData().m_mtabCache.values(device);
+    QReadLocker locker(&globalFstabCache->m_lock);
+    QStringList mountpoints = globalFstabCache->m_fstabCache.values(device);
+    mountpoints += globalFstabCache->m_mtabCache.values(device);
     mountpoints.removeDuplicates();
     return mountpoints;
 }
 
+QHash<QString, Solid::Backends::Fstab::FstabHandling::Accessibility> Solid::Backends::Fstab::FstabHandling::accessibility(const QStringList &devices)
+{
+    _k_updateFstabMountPointsCache();
+    _k_updateMtabMountPointsCache();
+
+    QReadLocker locker(&globalFstabCache->m_lock);
+
+    QHash<QString, Accessibility> result;
+    result.reserve(devices.size());
+    for (const QString &device : devices) {
+        Accessibility access;
+        const auto current = globalFstabCache->m_mtabCache.constFind(device);
+        if (current != globalFstabCache->m_mtabCache.constEnd()) {
+            access.filePath = current.value();
+            access.isAccessible = true;
+        } else {
+            const auto configured = globalFstabCache->m_fstabCache.constFind(device);
+            if (configured != globalFstabCache->m_fstabCache.constEnd()) {
+                access.filePath = configured.value();
+            }
+        }
+        result.insert(device, access);
+    }
+    return result;
+}
+
+Solid::Backends::Fstab::MountOptions Solid::Backends::Fstab::FstabHandling::_k_parsedOptions(const QByteArray &raw)
+{
+    if (raw.isEmpty()) {
+        return MountOptions();
+    }
+
+    auto &memo = globalFstabCache->m_parsedOptionsCache;
+    auto it = memo.constFind(raw);
+    if (it == memo.constEnd()) {
+        it = memo.insert(raw, MountOptions::fromOptionString(raw));
+    }
+    return it.value();
+}
+
 QHash<QString, QString> Solid::Backends::Fstab::FstabHandling::options(const QString &device)
 {
     _k_updateFstabMountPointsCache();
     _k_updateMtabMountPointsCache();
 
-    auto options = globalFstabCache->localData().m_mtabOptionsCache.value(device);
+    /* exclusive lock: the first access to an option string parses it into
+     * the memo table; everything after that is a plain hash hit */
+    QWriteLocker locker(&globalFstabCache->m_lock);
+    auto options = _k_parsedOptions(globalFstabCache->m_mtabOptionsCache.value(device)).toHash();
 
-    const auto optionsFstab = globalFstabCache->localData().m_fstabOptionsCache.value(device);
+    const auto optionsFstab = _k_parsedOptions(globalFstabCache->m_fstabOptionsCache.value(device)).toHash();
     for (const auto &it : optionsFstab.asKeyValueRange()) {
         if (!options.contains(it.first)) {
             options.insert(it.first, it.second);
@@ -250,7 +369,62 @@ QString Solid::Backends::Fstab::FstabHandling::fstype(const QString &device)
 {
     _k_updateFstabMountPointsCache();
 
-    return globalFstabCache->localData().m_fstabFstypeCache.value(device);
+    QReadLocker locker(&globalFstabCache->m_lock);
+    return globalFstabCache->m_fstabFstypeCache.value(device);
+}
+
+namespace
+{
+/* Commands waiting for a pool slot, started from the finished handler of
+ * running processes. Batch mounts at login used to start serially because
+ * every call blocked in waitForStarted(). */
+struct PendingCommand {
+    QProcess *process;
+    QString exec;
+    QStringList args;
+};
+
+const int c_maxConcurrentCommands = 4;
+
+/* setup()/teardown() arrive on whatever thread owns the frontend device,
+ * so the queue and the in-flight counter sit behind a mutex; the
+ * processes themselves get main-thread affinity and are started there,
+ * QProcess not being thread-safe. */
+struct CommandPool {
+    QMutex mutex;
+    int running = 0;
+    QList<PendingCommand> pending;
+};
+
+Q_GLOBAL_STATIC(CommandPool, s_commandPool)
+
+void _k_startQueuedCommands()
+{
+    QList<PendingCommand> ready;
+    {
+        QMutexLocker locker(&s_commandPool->mutex);
+        while (s_commandPool->running < c_maxConcurrentCommands && !s_commandPool->pending.isEmpty()) {
+            ready.append(s_commandPool->pending.takeFirst());
+            ++s_commandPool->running;
+        }
+    }
+
+    for (const PendingCommand &command : std::as_const(ready)) {
+        // hop to the thread the process lives on before starting it
+        QMetaObject::invokeMethod(command.process, [process = command.process, exec = command.exec, args = command.args]() {
+            process->start(exec, args);
+        });
+    }
+}
+
+void _k_releaseCommandSlot()
+{
+    {
+        QMutexLocker locker(&s_commandPool->mutex);
+        --s_commandPool->running;
+    }
+    _k_startQueuedCommands();
+}
 }
 
 bool Solid::Backends::Fstab::FstabHandling::callSystemCommand(const QString &commandName,
@@ -266,7 +440,20 @@ bool Solid::Backends::Fstab::FstabHandling::callSystemCommand(const QString &com
         return false;
     }
 
+    // the environment doesn't change under us, sanitize it once
+    static const QStringList sanitizedEnvironment = []() {
+        static const QRegularExpression re(QStringLiteral("^PATH=.*"), QRegularExpression::CaseInsensitiveOption);
+        QStringList env = QProcess::systemEnvironment();
+        env.replaceInStrings(re, QLatin1String("PATH=") + joinedPaths);
+        return env;
+    }();
+
     QProcess *process = new QProcess();
+    process->setEnvironment(sanitizedEnvironment);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+    // spawn the helper without duplicating the parent's address space
+    process->setUnixProcessParameters(QProcess::UnixProcessFlag::UseVFork);
+#endif
 
     QObject::connect(process,
                      static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
@@ -275,109 +462,188 @@ bool Solid::Backends::Fstab::FstabHandling::callSystemCommand(const QString &com
                          Q_UNUSED(exitCode);
                          Q_UNUSED(exitStatus);
                          callback(process);
+                     });
+    QObject::connect(process,
+                     static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+                     process,
+                     [process](int, QProcess::ExitStatus) {
                          process->deleteLater();
+                         _k_releaseCommandSlot();
                      });
+    QObject::connect(process, &QProcess::errorOccurred, process, [process, exec](QProcess::ProcessError error) {
+        // finished() is never emitted for this one, release the slot here
+        if (error == QProcess::FailedToStart) {
+            qCWarning(FSTAB_LOG) << "Failed to start" << exec << ":" << process->errorString();
+            process->deleteLater();
+            _k_releaseCommandSlot();
+        }
+    });
+
+    /* QProcess must be started and reaped on the thread it lives on; give
+     * it main-thread affinity before it is queued, as callers come from
+     * arbitrary frontend threads. */
+    const QCoreApplication *app = QCoreApplication::instance();
+    if (app && process->thread() != app->thread()) {
+        process->moveToThread(app->thread());
+    }
 
-    static const QRegularExpression re(QStringLiteral("^PATH=.*"), QRegularExpression::CaseInsensitiveOption);
-    QStringList env = QProcess::systemEnvironment();
-    env.replaceInStrings(re, QLatin1String("PATH=") + joinedPaths);
-    process->setEnvironment(env);
-    process->start(exec, args);
-
-    if (process->waitForStarted()) {
-        return true;
+    {
+        QMutexLocker locker(&s_commandPool->mutex);
+        s_commandPool->pending.append({process, exec, args});
     }
+    _k_startQueuedCommands();
 
-    delete process;
-    return false;
+    return true;
 }
 
-void Solid::Backends::Fstab::FstabHandling::_k_updateMtabMountPointsCache()
+void Solid::Backends::Fstab::FstabHandling::_k_parseMtab(QStringMultiHash &mountsCache,
+                                                         QHash<QString, QByteArray> &optionsCache,
+                                                         QHash<QString, QString> &fstypeCache)
 {
-    if (globalFstabCache->localData().m_mtabCacheValid) {
-        return;
+    const auto table = Solid::Backends::Shared::MountTable::current();
+
+    // one allocation per distinct option string, shared between devices;
+    // parsing is deferred until options() asks for a device
+    QHash<QByteArray, QByteArray> interned;
+
+    for (const auto &entry : *table) {
+        if (_k_isFstabNetworkFileSystem(entry.fstype, QString()) || _k_isFstabSupportedLocalFileSystem(entry.fstype)) {
+            const QString device = _k_deviceNameForMountpoint(entry.source, entry.fstype, entry.target);
+            mountsCache.insert(device, entry.target);
+            fstypeCache.insert(device, entry.fstype);
+
+            if (!entry.options.isEmpty()) {
+                auto option = interned.constFind(entry.options);
+                if (option == interned.constEnd()) {
+                    option = interned.insert(entry.options, entry.options);
+                }
+                optionsCache.insert(device, option.value());
+            }
+        }
     }
+}
 
-    globalFstabCache->localData().m_mtabCache.clear();
-    globalFstabCache->localData().m_mtabOptionsCache.clear();
-
-#if HAVE_GETMNTINFO
-
-#if GETMNTINFO_USES_STATVFS
-    struct statvfs *mounted;
-#else
-    struct statfs *mounted;
-#endif
-
-    int num_fs = getmntinfo(&mounted, MNT_NOWAIT);
-
-    for (int i = 0; i < num_fs; i++) {
-        QString type = QFile::decodeName(mounted[i].f_fstypename);
-        if (_k_isFstabNetworkFileSystem(type, QString()) || _k_isFstabSupportedLocalFileSystem(type)) {
-            const QString fsname = QFile::decodeName(mounted[i].f_mntfromname);
-            const QString mountpoint = QFile::decodeName(mounted[i].f_mntonname);
-            const QString device = _k_deviceNameForMountpoint(fsname, type, mountpoint);
-            globalFstabCache->localData().m_mtabCache.insert(device, mountpoint);
-            globalFstabCache->localData().m_fstabFstypeCache.insert(device, type);
+void Solid::Backends::Fstab::FstabHandling::_k_updateMtabMountPointsCache()
+{
+    {
+        QReadLocker locker(&globalFstabCache->m_lock);
+        if (globalFstabCache->m_mtabCacheValid) {
+            return;
         }
     }
 
-#elif HAVE_LIBMOUNT
-
-    struct libmnt_table *table = mnt_new_table();
-    if (!table) {
-        return;
-    }
+    QStringMultiHash mounts;
+    QHash<QString, QByteArray> options;
+    QHash<QString, QString> fstypes;
+    const Solid::Trace::Timer traceTimer;
+    _k_parseMtab(mounts, options, fstypes);
+    SOLID_TRACE1(fstab_parse_mtab, traceTimer.nsecs());
+    Solid::Stats::add(Solid::Stats::counters().fstabCacheRefills);
 
-    if (mnt_table_parse_mtab(table, NULL) != 0) {
-        mnt_free_table(table);
+    QWriteLocker locker(&globalFstabCache->m_lock);
+    if (globalFstabCache->m_mtabCacheValid) {
         return;
     }
 
-    struct libmnt_iter *itr = mnt_new_iter(MNT_ITER_FORWARD);
-    struct libmnt_fs *fs;
-
-    while (mnt_table_next_fs(table, itr, &fs) == 0) {
-        const QString fstype = QFile::decodeName(mnt_fs_get_fstype(fs));
-        if (_k_isFstabNetworkFileSystem(fstype, QString{}) || _k_isFstabSupportedLocalFileSystem(fstype)) {
-            const QString mountpoint = QFile::decodeName(mnt_fs_get_target(fs));
-            const QString fsname = QFile::decodeName(mnt_fs_get_srcpath(fs));
-            const QString device = _k_deviceNameForMountpoint(fsname, fstype, mountpoint);
-            const QStringList options = QFile::decodeName(mnt_fs_strdup_options(fs)).split(QLatin1Char(','));
-
-            globalFstabCache->localData().m_mtabCache.insert(device, mountpoint);
-            globalFstabCache->localData().m_fstabFstypeCache.insert(device, fstype);
-            for (const auto &optionLine : options) {
-                const auto split = optionLine.split(QLatin1Char('='));
-                const auto optionName = split[0];
-                const auto optionValue = split.size() > 1 ? split[1] : QString{};
-
-                globalFstabCache->localData().m_mtabOptionsCache[device].insert(optionName, optionValue);
-            }
-        }
+    globalFstabCache->m_mtabCache = mounts;
+    globalFstabCache->m_mtabOptionsCache = options;
+    for (auto it = fstypes.cbegin(), end = fstypes.cend(); it != end; ++it) {
+        globalFstabCache->m_fstabFstypeCache.insert(it.key(), it.value());
     }
-
-    mnt_free_iter(itr);
-
-    mnt_free_table(table);
-
-#endif
-
-    globalFstabCache->localData().m_mtabCacheValid = true;
+    globalFstabCache->m_mtabCacheValid = true;
+    accountTables();
 }
 
 QStringList Solid::Backends::Fstab::FstabHandling::currentMountPoints(const QString &device)
 {
     _k_updateMtabMountPointsCache();
-    return globalFstabCache->localData().m_mtabCache.values(device);
+
+    QReadLocker locker(&globalFstabCache->m_lock);
+    return globalFstabCache->m_mtabCache.values(device);
 }
 
 void Solid::Backends::Fstab::FstabHandling::flushMtabCache()
 {
-    globalFstabCache->localData().m_mtabCacheValid = false;
+    Solid::Backends::Shared::MountTable::invalidate();
+    QWriteLocker locker(&globalFstabCache->m_lock);
+    globalFstabCache->m_mtabCacheValid = false;
 }
 
 void Solid::Backends::Fstab::FstabHandling::flushFstabCache()
 {
-    globalFstabCache->localData().m_fstabCacheValid = false;
+    QWriteLocker locker(&globalFstabCache->m_lock);
+    globalFstabCache->m_fstabCacheValid = false;
+}
+
+/* Devices whose entries differ between the old and the new table: present
+ * on one side only, mounted elsewhere, or mounted with other options. */
+static QStringList _k_changedDevices(const QMultiHash<QString, QString> &oldMounts,
+                                     const QMultiHash<QString, QString> &newMounts,
+                                     const QHash<QString, QByteArray> &oldOptions,
+                                     const QHash<QString, QByteArray> &newOptions)
+{
+    QSet<QString> devices(oldMounts.keyBegin(), oldMounts.keyEnd());
+    for (auto it = newMounts.keyBegin(); it != newMounts.keyEnd(); ++it) {
+        devices.insert(*it);
+    }
+
+    QStringList changed;
+    for (const QString &device : devices) {
+        if (oldMounts.values(device) != newMounts.values(device) //
+            || oldOptions.value(device) != newOptions.value(device)) {
+            changed.append(device);
+        }
+    }
+    return changed;
+}
+
+QStringList Solid::Backends::Fstab::FstabHandling::refreshMtabCache()
+{
+    // a mount event just fired: the shared snapshot is stale too
+    Solid::Backends::Shared::MountTable::invalidate();
+
+    QStringMultiHash mounts;
+    QHash<QString, QByteArray> options;
+    QHash<QString, QString> fstypes;
+    const Solid::Trace::Timer traceTimer;
+    _k_parseMtab(mounts, options, fstypes);
+    SOLID_TRACE1(fstab_parse_mtab, traceTimer.nsecs());
+    Solid::Stats::add(Solid::Stats::counters().fstabCacheRefills);
+
+    QWriteLocker locker(&globalFstabCache->m_lock);
+    auto &cache = *globalFstabCache;
+    const QStringList changed = _k_changedDevices(cache.m_mtabCache, mounts, cache.m_mtabOptionsCache, options);
+
+    cache.m_mtabCache = mounts;
+    cache.m_mtabOptionsCache = options;
+    for (auto it = fstypes.cbegin(), end = fstypes.cend(); it != end; ++it) {
+        cache.m_fstabFstypeCache.insert(it.key(), it.value());
+    }
+    cache.m_mtabCacheValid = true;
+    accountTables();
+
+    return changed;
+}
+
+QStringList Solid::Backends::Fstab::FstabHandling::refreshFstabCache()
+{
+    QStringMultiHash mounts;
+    QHash<QString, QByteArray> options;
+    QHash<QString, QString> fstypes;
+    _k_parseFstab(mounts, options, fstypes);
+    Solid::Stats::add(Solid::Stats::counters().fstabCacheRefills);
+
+    QWriteLocker locker(&globalFstabCache->m_lock);
+    auto &cache = *globalFstabCache;
+    const QStringList changed = _k_changedDevices(cache.m_fstabCache, mounts, cache.m_fstabOptionsCache, options);
+
+    cache.m_fstabCache = mounts;
+    cache.m_fstabOptionsCache = options;
+    for (auto it = fstypes.cbegin(), end = fstypes.cend(); it != end; ++it) {
+        cache.m_fstabFstypeCache.insert(it.key(), it.value());
+    }
+    cache.m_fstabCacheValid = true;
+    accountTables();
+
+    return changed;
 }
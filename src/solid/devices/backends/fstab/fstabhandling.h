@@ -8,7 +8,10 @@
 #ifndef SOLID_BACKENDS_FSTAB_FSTABHANDLING_H
 #define SOLID_BACKENDS_FSTAB_FSTABHANDLING_H
 
+#include "fstabmountoptions.h"
+
 #include <QMultiHash>
+#include <QReadWriteLock>
 #include <QString>
 
 #include <functional>
@@ -30,25 +33,75 @@ public:
     static QStringList deviceList();
     static QStringList currentMountPoints(const QString &device);
     static QStringList mountPoints(const QString &device);
+
+    /** Mounted state and preferred mount point, as resolved by accessibility(). */
+    struct Accessibility {
+        QString filePath;
+        bool isAccessible = false;
+    };
+
+    /**
+     * Resolves the mounted state and mount point of all given devices in a
+     * single pass over the cached mount tables, taking the cache lock once
+     * instead of once per device. The mount point falls back to the fstab
+     * entry when the device is not currently mounted.
+     */
+    static QHash<QString, Accessibility> accessibility(const QStringList &devices);
     static QHash<QString, QString> options(const QString &device);
     static QString fstype(const QString &device);
     static bool callSystemCommand(const QString &commandName, const QStringList &args, const QObject *recvr, std::function<void(QProcess *)> callback);
     static void flushMtabCache();
     static void flushFstabCache();
 
+    /**
+     * Re-parses the mount table and replaces the cache in place, instead of
+     * invalidating it wholesale. Returns the devices whose mount points or
+     * options differ from the previous table, so the manager can notify
+     * only the devices that actually changed.
+     */
+    static QStringList refreshMtabCache();
+
+    /** Same as refreshMtabCache(), for the fstab side of the cache. */
+    static QStringList refreshFstabCache();
+
 private:
     static void _k_updateMtabMountPointsCache();
     static void _k_updateFstabMountPointsCache();
 
     typedef QMultiHash<QString, QString> QStringMultiHash;
 
+    static void _k_parseFstab(QStringMultiHash &mountsCache, QHash<QString, QByteArray> &optionsCache, QHash<QString, QString> &fstypeCache);
+    static void _k_parseMtab(QStringMultiHash &mountsCache, QHash<QString, QByteArray> &optionsCache, QHash<QString, QString> &fstypeCache);
+
+    /** Parsed form of @p raw, memoized; the caller must hold m_lock for
+        writing on the first access to a given string. */
+    static MountOptions _k_parsedOptions(const QByteArray &raw);
+
+    /** Publishes a size estimate of the tables to the statistics counters;
+        the caller must hold m_lock for writing. */
+    static void accountTables();
+
+    /* One cache for the whole process (it used to be per-thread, which made
+     * every worker thread pay the full libmount parse): readers take the
+     * lock shared, refreshes parse into local maps without the lock and
+     * only hold it exclusively for the swap. */
+    QReadWriteLock m_lock;
+
     QStringMultiHash m_mtabCache;
     QStringMultiHash m_fstabCache;
-    QHash<QString, QHash<QString, QString>> m_fstabOptionsCache;
-    QHash<QString, QHash<QString, QString>> m_mtabOptionsCache;
+    /* Cache builds only record the raw option string of each device
+     * (devices sharing a string share one allocation); options() is asked
+     * for a handful of devices at most, so parsing happens on first access
+     * per distinct string, memoized in m_parsedOptionsCache. The memo
+     * survives refreshes since the same strings recur table after table. */
+    QHash<QString, QByteArray> m_fstabOptionsCache;
+    QHash<QString, QByteArray> m_mtabOptionsCache;
+    QHash<QByteArray, MountOptions> m_parsedOptionsCache;
     QHash<QString, QString> m_fstabFstypeCache;
     bool m_fstabCacheValid;
     bool m_mtabCacheValid;
+    /* bytes last reported to the memory accounting counter */
+    qint64 m_accountedBytes = 0;
 };
 
 }
@@ -0,0 +1,130 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "fstabhealthmonitor.h"
+#include "fstab_debug.h"
+
+#include <QFile>
+#include <QPointer>
+#include <QThreadPool>
+
+#include <sys/stat.h>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Fstab
+{
+Q_GLOBAL_STATIC(FstabHealthMonitor, globalHealthMonitor)
+
+/* how often mounted shares are probed, and how long a probe may take
+ * before its share is considered dead */
+static const int c_probeIntervalMsecs = 30000;
+static const int c_probeTimeoutMsecs = 5000;
+
+FstabHealthMonitor::FstabHealthMonitor()
+    : m_probePool(new QThreadPool)
+{
+    m_probePool->setMaxThreadCount(2);
+    m_probeTimer.setInterval(c_probeIntervalMsecs);
+    m_probeTimer.setTimerType(Qt::VeryCoarseTimer);
+    connect(&m_probeTimer, &QTimer::timeout, this, &FstabHealthMonitor::probeAll);
+}
+
+FstabHealthMonitor::~FstabHealthMonitor()
+{
+    /* Deleting the pool would wait for running probes, and a probe stuck
+     * on a dead server would then hang application exit. Like the watcher
+     * does with its QFileSystemWatcher, leak it on purpose. */
+}
+
+FstabHealthMonitor *FstabHealthMonitor::instance()
+{
+    return globalHealthMonitor;
+}
+
+void FstabHealthMonitor::watch(const QString &device, const QString &filePath)
+{
+    auto &share = m_shares[device];
+    share.filePath = filePath;
+    probe(device);
+    if (!m_probeTimer.isActive()) {
+        m_probeTimer.start();
+    }
+}
+
+void FstabHealthMonitor::unwatch(const QString &device)
+{
+    m_shares.remove(device);
+    if (m_shares.isEmpty()) {
+        m_probeTimer.stop();
+    }
+}
+
+bool FstabHealthMonitor::isHealthy(const QString &device) const
+{
+    const auto share = m_shares.constFind(device);
+    return share == m_shares.constEnd() || share->healthy;
+}
+
+void FstabHealthMonitor::probeAll()
+{
+    for (auto it = m_shares.begin(), end = m_shares.end(); it != end; ++it) {
+        /* a probe still in flight means the share hangs; it was already
+         * flagged by the timeout, and probing resumes once the stuck
+         * stat() finally returns */
+        if (!it->probePending) {
+            probe(it.key());
+        }
+    }
+}
+
+void FstabHealthMonitor::probe(const QString &device)
+{
+    auto &share = m_shares[device];
+    share.probePending = true;
+
+    /* flag the share dead when the probe doesn't answer in time, but keep
+     * it pending so no further probes pile up behind the stuck one */
+    QTimer::singleShot(c_probeTimeoutMsecs, this, [this, device]() {
+        const auto share = m_shares.find(device);
+        if (share != m_shares.end() && share->probePending && share->healthy) {
+            qCDebug(FSTAB_LOG) << "probe of" << device << "timed out";
+            share->healthy = false;
+            Q_EMIT healthChanged(device, false);
+        }
+    });
+
+    const QByteArray path = QFile::encodeName(share.filePath);
+    QPointer<FstabHealthMonitor> guard(this);
+    m_probePool->start([guard, device, path]() {
+        struct stat st;
+        const bool healthy = ::stat(path.constData(), &st) == 0;
+        if (guard) {
+            QMetaObject::invokeMethod(guard.data(), "onProbeResult", Qt::QueuedConnection, Q_ARG(QString, device), Q_ARG(bool, healthy));
+        }
+    });
+}
+
+void FstabHealthMonitor::onProbeResult(const QString &device, bool healthy)
+{
+    const auto share = m_shares.find(device);
+    if (share == m_shares.end()) {
+        return;
+    }
+    share->probePending = false;
+    if (share->healthy != healthy) {
+        share->healthy = healthy;
+        Q_EMIT healthChanged(device, healthy);
+    }
+}
+
+}
+}
+} // namespace Solid:Backends::Fstab
+
+#include "moc_fstabhealthmonitor.cpp"
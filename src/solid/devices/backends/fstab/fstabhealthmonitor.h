@@ -0,0 +1,69 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_FSTAB_HEALTHMONITOR_H
+#define SOLID_BACKENDS_FSTAB_HEALTHMONITOR_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+class QThreadPool;
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Fstab
+{
+/**
+ * Watches the reachability of mounted network shares.
+ *
+ * Shares are probed off-thread on a coarse interval; a probe that doesn't
+ * answer within the timeout marks its share unhealthy without ever blocking
+ * the caller. FstabStorageAccess serves reachability queries from the cached
+ * state and forwards the change signal.
+ */
+class FstabHealthMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    FstabHealthMonitor();
+    ~FstabHealthMonitor() override;
+
+    static FstabHealthMonitor *instance();
+
+    void watch(const QString &device, const QString &filePath);
+    void unwatch(const QString &device);
+    bool isHealthy(const QString &device) const;
+
+Q_SIGNALS:
+    void healthChanged(const QString &device, bool healthy);
+
+private Q_SLOTS:
+    void probeAll();
+    void onProbeResult(const QString &device, bool healthy);
+
+private:
+    void probe(const QString &device);
+
+    struct Share {
+        QString filePath;
+        bool healthy = true;
+        bool probePending = false;
+    };
+
+    QHash<QString, Share> m_shares;
+    /* dedicated pool: a stat() on a dead server can hang for minutes and
+     * must not occupy threads the application counts on */
+    QThreadPool *m_probePool;
+    QTimer m_probeTimer;
+};
+}
+}
+}
+#endif // SOLID_BACKENDS_FSTAB_HEALTHMONITOR_H
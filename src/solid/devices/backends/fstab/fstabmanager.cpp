@@ -18,12 +18,72 @@ using namespace Solid::Backends::Shared;
 FstabManager::FstabManager(QObject *parent)
     : Solid::Ifaces::DeviceManager(parent)
     , m_deviceList(FstabHandling::deviceList())
+    , m_deviceSet(m_deviceList.begin(), m_deviceList.end())
 {
     m_supportedInterfaces << Solid::DeviceInterface::StorageAccess;
     m_supportedInterfaces << Solid::DeviceInterface::NetworkShare;
 
-    connect(FstabWatcher::instance(), &FstabWatcher::fstabChanged, this, &FstabManager::onFstabChanged);
-    connect(FstabWatcher::instance(), &FstabWatcher::mtabChanged, this, &FstabManager::onMtabChanged);
+    /* The file watchers are only hooked up once the frontend enables
+     * monitoring or a device reports a listener; a process that never
+     * listens for changes doesn't need the inotify watches on /etc/fstab
+     * and the mount table. */
+}
+
+void FstabManager::setMonitoringEnabled(bool enabled)
+{
+    if (m_monitoringEnabled == enabled) {
+        return;
+    }
+    m_monitoringEnabled = enabled;
+    _k_updateWatcherState();
+}
+
+void FstabManager::addDeviceInterest()
+{
+    ++m_interestedDevices;
+    _k_updateWatcherState();
+}
+
+void FstabManager::removeDeviceInterest()
+{
+    --m_interestedDevices;
+    _k_updateWatcherState();
+}
+
+void FstabManager::_k_updateWatcherState()
+{
+    /* the global monitoring flag and the per-device receivers both keep
+     * the watcher alive; either alone is enough */
+    const bool wanted = m_monitoringEnabled || m_interestedDevices > 0;
+    if (m_watcherArmed == wanted) {
+        return;
+    }
+    m_watcherArmed = wanted;
+
+    if (wanted) {
+        connect(FstabWatcher::instance(), &FstabWatcher::fstabChanged, this, &FstabManager::onFstabChanged);
+        connect(FstabWatcher::instance(), &FstabWatcher::mtabChanged, this, &FstabManager::onMtabChanged);
+
+        /* edits made while nobody watched were never delivered; re-read
+         * both tables now, reporting the differences the usual way */
+        onFstabChanged();
+        onMtabChanged();
+    } else {
+        disconnect(FstabWatcher::instance(), nullptr, this, nullptr);
+    }
+}
+
+void FstabManager::refreshIfUnmonitored()
+{
+    if (m_watcherArmed) {
+        return;
+    }
+
+    /* without the watchers the caches never see table edits; go through
+     * the regular change slots so enumerations stay correct and attached
+     * devices still learn about their mount state */
+    onFstabChanged();
+    onMtabChanged();
 }
 
 QString FstabManager::udiPrefix() const
@@ -38,6 +98,8 @@ QSet<Solid::DeviceInterface::Type> FstabManager::supportedInterfaces() const
 
 QStringList FstabManager::allDevices()
 {
+    refreshIfUnmonitored();
+
     QStringList result;
 
     result << udiPrefix();
@@ -50,6 +112,8 @@ QStringList FstabManager::allDevices()
 
 QStringList FstabManager::devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
 {
+    refreshIfUnmonitored();
+
     if ((parentUdi == udiPrefix()) || parentUdi.isEmpty()) {
         QStringList result;
         if (type == Solid::DeviceInterface::StorageAccess) {
@@ -86,11 +150,15 @@ QObject *FstabManager::createDevice(const QString &udi)
     } else {
         // global device manager makes sure udi starts with udi prefix + '/'
         QString internalName = udi.mid(udiPrefix().length() + 1, -1);
-        if (!m_deviceList.contains(internalName)) {
-            return nullptr;
+        if (!m_deviceSet.contains(internalName)) {
+            // it may have appeared since the stale, unmonitored list was built
+            refreshIfUnmonitored();
+            if (!m_deviceSet.contains(internalName)) {
+                return nullptr;
+            }
         }
 
-        FstabDevice *device = new FstabDevice(udi);
+        FstabDevice *device = new FstabDevice(udi, this);
         connect(this, &FstabManager::mtabChanged, device, &FstabDevice::onMtabChanged);
         return device;
     }
@@ -98,28 +166,64 @@ QObject *FstabManager::createDevice(const QString &udi)
 
 void FstabManager::onFstabChanged()
 {
-    FstabHandling::flushFstabCache();
+    const QStringList changed = FstabHandling::refreshFstabCache();
     _k_updateDeviceList();
+
+    /* entries that were edited in place (mount point or options) rather
+     * than added or removed */
+    _k_notifyChangedDevices(changed);
+}
+
+void FstabManager::_k_notifyChangedDevices(const QStringList &changed)
+{
+    QStringList present;
+    for (const QString &device : changed) {
+        if (m_deviceSet.contains(device)) {
+            present.append(device);
+        }
+    }
+
+    /* resolve the mount state of all changed devices in one pass and ship
+     * it with the signal, so the storage access objects don't go back to
+     * the caches one by one */
+    const auto access = FstabHandling::accessibility(present);
+    for (const QString &device : present) {
+        const auto &deviceAccess = access[device];
+        Q_EMIT mtabChanged(device, deviceAccess.filePath, deviceAccess.isAccessible);
+
+        // and tell the frontend its memoized answers about this device
+        // (mounted or not, where) just went stale
+        Q_EMIT deviceChanged(udiPrefix() + QStringLiteral("/") + device);
+    }
 }
 
 void FstabManager::_k_updateDeviceList()
 {
-    const QStringList deviceList = FstabHandling::deviceList();
-    const QSet<QString> newlist(deviceList.begin(), deviceList.end());
-    const QSet<QString> oldlist(m_deviceList.begin(), m_deviceList.end());
+    QStringList deviceList = FstabHandling::deviceList();
+    QSet<QString> newSet(deviceList.begin(), deviceList.end());
 
-    m_deviceList = deviceList;
+    /* the previous snapshot's hash set is kept around, so each change
+     * event costs one pass over each table instead of rehashing both */
+    const QSet<QString> oldSet = std::move(m_deviceSet);
 
-    qCDebug(FSTAB_LOG) << oldlist << "->" << newlist;
+    m_deviceList = std::move(deviceList);
+    m_deviceSet = std::move(newSet);
 
-    for (const QString &device : newlist) {
-        if (!oldlist.contains(device)) {
+    if (m_deviceSet == oldSet) {
+        // most mount events leave the device set itself untouched
+        return;
+    }
+
+    qCDebug(FSTAB_LOG) << oldSet << "->" << m_deviceSet;
+
+    for (const QString &device : std::as_const(m_deviceSet)) {
+        if (!oldSet.contains(device)) {
             Q_EMIT deviceAdded(udiPrefix() + QStringLiteral("/") + device);
         }
     }
 
-    for (const QString &device : oldlist) {
-        if (!newlist.contains(device)) {
+    for (const QString &device : oldSet) {
+        if (!m_deviceSet.contains(device)) {
             Q_EMIT deviceRemoved(udiPrefix() + QStringLiteral("/") + device);
         }
     }
@@ -127,14 +231,16 @@ void FstabManager::_k_updateDeviceList()
 
 void FstabManager::onMtabChanged()
 {
-    FstabHandling::flushMtabCache();
+    /* Diff the re-parsed mount table against the cached one rather than
+     * invalidating wholesale: autofs-heavy hosts churn mounts constantly,
+     * and waking the storage access of every device on each event made
+     * them all re-query their mount state. */
+    const QStringList changed = FstabHandling::refreshMtabCache();
 
     _k_updateDeviceList(); // devicelist is union of mtab and fstab
 
-    for (const QString &device : std::as_const(m_deviceList)) {
-        // notify storageaccess objects via device ...
-        Q_EMIT mtabChanged(device);
-    }
+    // notify storageaccess objects via device ...
+    _k_notifyChangedDevices(changed);
 }
 
 FstabManager::~FstabManager()
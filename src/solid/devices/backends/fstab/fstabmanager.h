@@ -33,9 +33,22 @@ public:
     QStringList allDevices() override;
     QStringList devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type) override;
     QObject *createDevice(const QString &udi) override;
+    void setMonitoringEnabled(bool enabled) override;
+
+    /**
+     * Per-device interest in mount transitions, reported by FstabDevice
+     * as receivers of its mtabChanged() signal come and go. The watcher
+     * stays armed while any device has one, independent of the global
+     * monitoring flag, so a held storage access keeps seeing
+     * accessibility changes.
+     */
+    void addDeviceInterest();
+    void removeDeviceInterest();
 
 Q_SIGNALS:
-    void mtabChanged(const QString &device);
+    /* carries the resolved mount state so every listening device doesn't
+     * have to query the mount caches again */
+    void mtabChanged(const QString &device, const QString &filePath, bool isAccessible);
 
 private Q_SLOTS:
     void onFstabChanged();
@@ -44,7 +57,19 @@ private Q_SLOTS:
 private:
     QSet<Solid::DeviceInterface::Type> m_supportedInterfaces;
     QStringList m_deviceList;
+    /* hash view of m_deviceList; membership checks and the change diff
+     * stay constant-time per entry on large tables */
+    QSet<QString> m_deviceSet;
+    /* the file watchers only run while the frontend wants events or a
+     * device has listeners; while they don't, every enumeration re-reads
+     * the tables instead */
+    bool m_monitoringEnabled = false;
+    bool m_watcherArmed = false;
+    int m_interestedDevices = 0;
+    void _k_updateWatcherState();
+    void refreshIfUnmonitored();
     void _k_updateDeviceList();
+    void _k_notifyChangedDevices(const QStringList &changed);
 };
 
 }
@@ -0,0 +1,114 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "fstabmountoptions.h"
+
+#include "../shared/fastscan.h"
+
+#include <QFile>
+
+using namespace Solid::Backends::Fstab;
+
+/* Flags seen on virtually every mount table entry. The position in this
+ * table is the bit position in m_flags, so entries must not be reordered,
+ * and there is room for at most 32 of them. */
+static const QLatin1String s_commonFlags[] = {
+    QLatin1String("rw"),         QLatin1String("ro"),         QLatin1String("relatime"), QLatin1String("noatime"),    QLatin1String("nodiratime"),
+    QLatin1String("nosuid"),     QLatin1String("nodev"),      QLatin1String("noexec"),   QLatin1String("suid"),       QLatin1String("dev"),
+    QLatin1String("exec"),       QLatin1String("auto"),       QLatin1String("noauto"),   QLatin1String("user"),       QLatin1String("nouser"),
+    QLatin1String("sync"),       QLatin1String("async"),      QLatin1String("defaults"), QLatin1String("_netdev"),    QLatin1String("nofail"),
+    QLatin1String("lazytime"),   QLatin1String("strictatime"), QLatin1String("dirsync"), QLatin1String("atime"),      QLatin1String("diratime"),
+    QLatin1String("acl"),        QLatin1String("user_xattr"), QLatin1String("silent"),   QLatin1String("mand"),       QLatin1String("nomand"),
+};
+
+int MountOptions::commonFlagIndex(const QString &name)
+{
+    for (size_t i = 0; i < std::size(s_commonFlags); ++i) {
+        if (name == s_commonFlags[i]) {
+            return int(i);
+        }
+    }
+    return -1;
+}
+
+void MountOptions::insert(const QString &name, const QString &value)
+{
+    if (value.isEmpty()) {
+        const int flag = commonFlagIndex(name);
+        if (flag >= 0) {
+            m_flags |= 1u << flag;
+            return;
+        }
+    }
+
+    for (auto &option : m_other) {
+        if (option.first == name) {
+            option.second = value;
+            return;
+        }
+    }
+    m_other.append({name, value});
+}
+
+bool MountOptions::contains(const QString &name) const
+{
+    const int flag = commonFlagIndex(name);
+    if (flag >= 0 && (m_flags & (1u << flag))) {
+        return true;
+    }
+
+    for (const auto &option : m_other) {
+        if (option.first == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString MountOptions::value(const QString &name) const
+{
+    for (const auto &option : m_other) {
+        if (option.first == name) {
+            return option.second;
+        }
+    }
+    return QString();
+}
+
+QHash<QString, QString> MountOptions::toHash() const
+{
+    QHash<QString, QString> result;
+    result.reserve(qPopulationCount(m_flags) + m_other.size());
+    for (size_t i = 0; i < std::size(s_commonFlags); ++i) {
+        if (m_flags & (1u << i)) {
+            result.insert(s_commonFlags[i], QString());
+        }
+    }
+    for (const auto &option : m_other) {
+        result.insert(option.first, option.second);
+    }
+    return result;
+}
+
+bool MountOptions::operator==(const MountOptions &other) const
+{
+    return m_flags == other.m_flags && m_other == other.m_other;
+}
+
+bool MountOptions::operator!=(const MountOptions &other) const
+{
+    return !(*this == other);
+}
+
+MountOptions MountOptions::fromOptionString(QByteArrayView options)
+{
+    MountOptions result;
+    Shared::FastScan::forEachToken(options, ',', [&result](QByteArrayView option) {
+        const auto [name, value] = Shared::FastScan::keyValue(option, '=');
+        result.insert(QFile::decodeName(name.toByteArray()), QFile::decodeName(value.toByteArray()));
+    });
+    return result;
+}
@@ -0,0 +1,60 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_FSTAB_MOUNTOPTIONS_H
+#define SOLID_BACKENDS_FSTAB_MOUNTOPTIONS_H
+
+#include <QByteArrayView>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include <utility>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Fstab
+{
+/**
+ * Parsed mount options of one mount table entry.
+ *
+ * Most entries only carry common boolean flags (rw, nosuid, noatime, ...),
+ * which are stored as bits in a single word; only uncommon or valued options
+ * get per-entry storage. With hundreds of fstab entries this keeps the option
+ * caches from degenerating into megabytes of tiny hash tables.
+ */
+class MountOptions
+{
+public:
+    MountOptions() = default;
+
+    bool contains(const QString &name) const;
+    QString value(const QString &name) const;
+    void insert(const QString &name, const QString &value = QString());
+
+    /** Flattened view, for the FstabHandling::options() API. */
+    QHash<QString, QString> toHash() const;
+
+    bool operator==(const MountOptions &other) const;
+    bool operator!=(const MountOptions &other) const;
+
+    /** Parses a comma-separated option string as found in the mount table. */
+    static MountOptions fromOptionString(QByteArrayView options);
+
+private:
+    static int commonFlagIndex(const QString &name);
+
+    quint32 m_flags = 0;
+    QList<std::pair<QString, QString>> m_other;
+};
+
+}
+}
+}
+
+#endif // SOLID_BACKENDS_FSTAB_MOUNTOPTIONS_H
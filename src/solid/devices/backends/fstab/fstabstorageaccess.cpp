@@ -5,6 +5,7 @@
 */
 
 #include "fstabstorageaccess.h"
+#include "fstabhealthmonitor.h"
 #include "fstabwatcher.h"
 #include <QStringList>
 #include <solid/devices/backends/fstab/fstabdevice.h>
@@ -23,15 +24,10 @@ FstabStorageAccess::FstabStorageAccess(Solid::Backends::Fstab::FstabDevice *devi
     : QObject(device)
     , m_fstabDevice(device)
 {
-    QStringList currentMountPoints = FstabHandling::currentMountPoints(device->device());
-    if (currentMountPoints.isEmpty()) {
-        QStringList mountPoints = FstabHandling::mountPoints(device->device());
-        m_filePath = mountPoints.isEmpty() ? QString() : mountPoints.first();
-        m_isAccessible = false;
-    } else {
-        m_filePath = currentMountPoints.first();
-        m_isAccessible = true;
-    }
+    const auto access = FstabHandling::accessibility({device->device()}).value(device->device());
+    m_filePath = access.filePath;
+    m_isAccessible = access.isAccessible;
+    m_isReachable = true;
 
     const bool inUserPath =
         m_filePath.startsWith(QLatin1String("/media/")) || m_filePath.startsWith(QLatin1String("/run/media/")) || m_filePath.startsWith(QDir::homePath());
@@ -43,12 +39,22 @@ FstabStorageAccess::FstabStorageAccess(Solid::Backends::Fstab::FstabDevice *devi
         // ignore overlay fs not pointing to / or seemingly mounted by user
         (fsIsOverlay && m_filePath != QLatin1String("/") && !inUserPath);
 
+    if (device->queryDeviceInterface(Solid::DeviceInterface::NetworkShare)) {
+        connect(FstabHealthMonitor::instance(), &FstabHealthMonitor::healthChanged, this, &FstabStorageAccess::onHealthChanged);
+        if (m_isAccessible) {
+            FstabHealthMonitor::instance()->watch(device->device(), m_filePath);
+        }
+    }
+
     connect(device, &FstabDevice::mtabChanged, this, &FstabStorageAccess::onMtabChanged);
     QTimer::singleShot(0, this, SLOT(connectDBusSignals()));
 }
 
 FstabStorageAccess::~FstabStorageAccess()
 {
+    if (m_fstabDevice->queryDeviceInterface(Solid::DeviceInterface::NetworkShare)) {
+        FstabHealthMonitor::instance()->unwatch(m_fstabDevice->device());
+    }
 }
 
 void FstabStorageAccess::connectDBusSignals()
@@ -83,6 +89,11 @@ bool FstabStorageAccess::isEncrypted() const
     return m_fstabDevice->isEncrypted();
 }
 
+bool FstabStorageAccess::isReachable() const
+{
+    return m_isReachable;
+}
+
 bool FstabStorageAccess::setup()
 {
     if (filePath().isEmpty()) {
@@ -143,24 +154,34 @@ void FstabStorageAccess::slotTeardownDone(int error, const QString &errorString)
     Q_EMIT teardownDone(static_cast<Solid::ErrorType>(error), errorString, m_fstabDevice->udi());
 }
 
-void FstabStorageAccess::onMtabChanged(const QString &device)
+void FstabStorageAccess::onMtabChanged(const QString &device, const QString &filePath, bool isAccessible)
 {
-    QStringList currentMountPoints = FstabHandling::currentMountPoints(device);
-    if (currentMountPoints.isEmpty()) {
-        // device umounted
-        m_filePath = FstabHandling::mountPoints(device).first();
-        if (m_isAccessible) {
-            m_isAccessible = false;
-            Q_EMIT accessibilityChanged(false, QStringLiteral(FSTAB_UDI_PREFIX "/%1").arg(device));
-        }
-    } else {
-        // device added
-        m_filePath = currentMountPoints.first();
-        if (!m_isAccessible) {
-            m_isAccessible = true;
-            Q_EMIT accessibilityChanged(true, QStringLiteral(FSTAB_UDI_PREFIX "/%1").arg(device));
+    // the manager already resolved the mount state for us
+    m_filePath = filePath;
+    if (m_isAccessible != isAccessible) {
+        m_isAccessible = isAccessible;
+        Q_EMIT accessibilityChanged(isAccessible, QStringLiteral(FSTAB_UDI_PREFIX "/%1").arg(device));
+
+        if (m_fstabDevice->queryDeviceInterface(Solid::DeviceInterface::NetworkShare)) {
+            if (isAccessible) {
+                FstabHealthMonitor::instance()->watch(device, m_filePath);
+            } else {
+                FstabHealthMonitor::instance()->unwatch(device);
+                onHealthChanged(device, true);
+            }
         }
     }
 }
 
+void FstabStorageAccess::onHealthChanged(const QString &device, bool healthy)
+{
+    if (device != m_fstabDevice->device()) {
+        return;
+    }
+    if (m_isReachable != healthy) {
+        m_isReachable = healthy;
+        Q_EMIT reachabilityChanged(healthy, m_fstabDevice->udi());
+    }
+}
+
 #include "moc_fstabstorageaccess.cpp"
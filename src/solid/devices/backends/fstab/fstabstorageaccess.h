@@ -36,6 +36,8 @@ public:
 
     bool isEncrypted() const override;
 
+    bool isReachable() const override;
+
     bool setup() override;
 
     bool teardown() override;
@@ -58,8 +60,11 @@ Q_SIGNALS:
 
     void repairDone(Solid::ErrorType error, QVariant resultData, const QString &udi) override;
 
+    void reachabilityChanged(bool reachable, const QString &udi) override;
+
 private Q_SLOTS:
-    void onMtabChanged(const QString &device);
+    void onMtabChanged(const QString &device, const QString &filePath, bool isAccessible);
+    void onHealthChanged(const QString &device, bool healthy);
     void connectDBusSignals();
 
     void slotSetupRequested();
@@ -72,6 +77,7 @@ private:
     QString m_filePath;
     bool m_isAccessible;
     bool m_isIgnored;
+    bool m_isReachable;
 };
 
 }
@@ -27,52 +27,103 @@ static const QString s_fstabPath = QStringLiteral("/etc");
 
 FstabWatcher::FstabWatcher()
 {
+    bool monitoring = false;
 #ifdef Q_OS_LINUX
-    auto mountMonitor = mnt_new_monitor();
+    monitoring = setupMountMonitor();
+    if (!monitoring && setupMountinfoWatcher()) {
+        /* the mount table is covered by a single fd; fstab edits still
+         * need the file watcher */
+        setupFstabFileWatcher();
+        monitoring = true;
+    }
+#endif
+    if (!monitoring) {
+        /* no kernel-notification monitoring (non-Linux, or mnt_monitor
+         * unavailable e.g. in a restricted container): watch the files */
+        setupFileWatcher();
+    }
 
-    if (!mountMonitor) {
+    if (qApp) {
+        connect(qApp, &QCoreApplication::aboutToQuit, this, &FstabWatcher::onQuit);
+    }
+}
+
+#ifdef Q_OS_LINUX
+bool FstabWatcher::setupMountMonitor()
+{
+    m_mountMonitor = mnt_new_monitor();
+    if (!m_mountMonitor) {
         qCritical(FSTAB_LOG) << "could not start mount monitor";
-        return;
+        return false;
     }
-    m_mountMonitor = mountMonitor;
 
-    auto r = mnt_monitor_enable_kernel(m_mountMonitor, true);
-    if (r < 0) {
-        mnt_unref_monitor(m_mountMonitor);
+    if (mnt_monitor_enable_kernel(m_mountMonitor, true) < 0) {
         qCritical(FSTAB_LOG) << "Failed to enable watching of kernel mount events:" << strerror(errno);
+        mnt_unref_monitor(m_mountMonitor);
+        m_mountMonitor = nullptr;
+        return false;
     }
 
-    r = mnt_monitor_enable_userspace(m_mountMonitor, true, NULL);
-    if (r < 0) {
-        mnt_unref_monitor(m_mountMonitor);
+    if (mnt_monitor_enable_userspace(m_mountMonitor, true, NULL) < 0) {
         qCritical(FSTAB_LOG) << "Failed to enable watching of userspace mount events:" << strerror(errno);
+        mnt_unref_monitor(m_mountMonitor);
+        m_mountMonitor = nullptr;
+        return false;
     }
 
-    auto fd = mnt_monitor_get_fd(m_mountMonitor);
+    const int fd = mnt_monitor_get_fd(m_mountMonitor);
     if (fd < 0) {
-        mnt_unref_monitor(m_mountMonitor);
         qCritical(FSTAB_LOG) << "Failed to acquire watch file descriptor" << strerror(errno);
-        return;
+        mnt_unref_monitor(m_mountMonitor);
+        m_mountMonitor = nullptr;
+        return false;
     }
 
     m_socketNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
     connect(m_socketNotifier, &QSocketNotifier::activated, this, &FstabWatcher::onMountChanged);
+    return true;
+}
 
-    if (qApp) {
-        connect(qApp, &QCoreApplication::aboutToQuit, this, &FstabWatcher::onQuit);
+bool FstabWatcher::setupMountinfoWatcher()
+{
+    m_mountInfoFile = new QFile(QStringLiteral("/proc/self/mountinfo"), this);
+    if (!m_mountInfoFile->open(QIODevice::ReadOnly)) {
+        delete m_mountInfoFile;
+        m_mountInfoFile = nullptr;
+        return false;
     }
-#else
-    m_isRoutineInstalled = false;
-    m_fileSystemWatcher = new QFileSystemWatcher(this);
 
+    /* the kernel raises POLLPRI on mountinfo whenever the mount table of
+     * our namespace changes; QSocketNotifier::Exception delivers exactly
+     * that, so this wakes up only on real mount events */
+    m_socketNotifier = new QSocketNotifier(m_mountInfoFile->handle(), QSocketNotifier::Exception, this);
+    connect(m_socketNotifier, &QSocketNotifier::activated, this, &FstabWatcher::mtabChanged);
+    return true;
+}
+#endif
+
+void FstabWatcher::setupFileWatcher()
+{
     m_mtabFile = new QFile(s_mtabFile, this);
     if (m_mtabFile && m_mtabFile->symLinkTarget().startsWith(QLatin1String("/proc/")) && m_mtabFile->open(QIODevice::ReadOnly)) {
         m_socketNotifier = new QSocketNotifier(m_mtabFile->handle(), QSocketNotifier::Exception, this);
         connect(m_socketNotifier, &QSocketNotifier::activated, this, &FstabWatcher::mtabChanged);
     } else {
+        if (!m_fileSystemWatcher) {
+            m_fileSystemWatcher = new QFileSystemWatcher(this);
+        }
         m_fileSystemWatcher->addPath(s_mtabFile);
     }
 
+    setupFstabFileWatcher();
+}
+
+void FstabWatcher::setupFstabFileWatcher()
+{
+    if (!m_fileSystemWatcher) {
+        m_fileSystemWatcher = new QFileSystemWatcher(this);
+    }
+
     m_fileSystemWatcher->addPath(s_fstabPath);
     connect(m_fileSystemWatcher, &QFileSystemWatcher::directoryChanged, this, [this](const QString &) {
         if (!m_isFstabWatched) {
@@ -86,28 +137,30 @@ FstabWatcher::FstabWatcher()
 
     m_isFstabWatched = m_fileSystemWatcher->addPath(s_fstabFile);
     connect(m_fileSystemWatcher, &QFileSystemWatcher::fileChanged, this, &FstabWatcher::onFileChanged);
-#endif
 }
 
 FstabWatcher::~FstabWatcher()
 {
 #ifdef Q_OS_LINUX
-    mnt_unref_monitor(m_mountMonitor);
-#else
+    if (m_mountMonitor) {
+        mnt_unref_monitor(m_mountMonitor);
+    }
+#endif
     // The QFileSystemWatcher doesn't work correctly in a singleton
     // The solution so far was to destroy the QFileSystemWatcher when the application quits
     // But we have some crash with this solution.
     // For the moment to workaround the problem, we detach the QFileSystemWatcher from the parent
     // effectively leaking it on purpose.
-    m_fileSystemWatcher->setParent(nullptr);
-#endif
+    if (m_fileSystemWatcher) {
+        m_fileSystemWatcher->setParent(nullptr);
+    }
 }
 
 void FstabWatcher::onQuit()
 {
-#ifndef Q_OS_LINUX
-    m_fileSystemWatcher->setParent(nullptr);
-#endif
+    if (m_fileSystemWatcher) {
+        m_fileSystemWatcher->setParent(nullptr);
+    }
 }
 
 FstabWatcher *FstabWatcher::instance()
@@ -147,7 +200,8 @@ void FstabWatcher::onMountChanged()
         Q_EMIT fstabChanged();
     }
 }
-#else
+#endif
+
 void FstabWatcher::onFileChanged(const QString &path)
 {
     if (path == s_mtabFile) {
@@ -164,7 +218,6 @@ void FstabWatcher::onFileChanged(const QString &path)
         }
     }
 }
-#endif
 }
 }
 } // namespace Solid:Backends::Fstab
@@ -38,22 +38,33 @@ Q_SIGNALS:
 private Q_SLOTS:
 #ifdef Q_OS_LINUX
     void onMountChanged();
-#else
-    void onFileChanged(const QString &path);
 #endif
+    void onFileChanged(const QString &path);
 
     void onQuit();
 
 private:
-    QSocketNotifier *m_socketNotifier;
 #ifdef Q_OS_LINUX
-    libmnt_monitor *m_mountMonitor;
-#else
-    bool m_isRoutineInstalled;
-    QFileSystemWatcher *m_fileSystemWatcher;
-    QFile *m_mtabFile;
-    bool m_isFstabWatched;
+    /* kernel-notification based monitoring, preferred when available */
+    bool setupMountMonitor();
+    /* poll(POLLPRI) on /proc/self/mountinfo, covers the mount table only */
+    bool setupMountinfoWatcher();
+#endif
+    /* per-file watching, the fallback mechanism */
+    void setupFileWatcher();
+    /* the /etc/fstab half of the file watcher, also used alongside the
+     * mountinfo watcher since mountinfo says nothing about fstab edits */
+    void setupFstabFileWatcher();
+
+    QSocketNotifier *m_socketNotifier = nullptr;
+#ifdef Q_OS_LINUX
+    libmnt_monitor *m_mountMonitor = nullptr;
+    QFile *m_mountInfoFile = nullptr;
 #endif
+    bool m_isRoutineInstalled = false;
+    QFileSystemWatcher *m_fileSystemWatcher = nullptr;
+    QFile *m_mtabFile = nullptr;
+    bool m_isFstabWatched = false;
 };
 }
 }
@@ -8,7 +8,8 @@
 #include "imobiledevice.h"
 
 #include <QCoreApplication>
-#include <QScopeGuard>
+#include <QHash>
+#include <QMutex>
 
 #include "imobile_debug.h"
 
@@ -20,40 +21,105 @@
 
 using namespace Solid::Backends::IMobile;
 
-IMobileDevice::IMobileDevice(const QString &udi)
-    : Solid::Ifaces::Device()
-    , m_udi(udi)
+namespace
 {
-    const QString deviceId = udi.mid(udiPrefix().length() + 1);
+/* Each lockdownd handshake involves pairing round trips with the device,
+ * so the session is kept open per device and reused by every
+ * IMobileDevice instantiation until the manager invalidates it. */
+struct LockdownSession {
+    idevice_t device = nullptr;
+    lockdownd_client_t client = nullptr;
+};
+
+struct CachedProperties {
+    QString name;
+    QString deviceClass;
+};
+
+struct FetchResult {
+    CachedProperties properties;
+    bool complete = true;
+};
+} // namespace
+
+typedef QHash<QString, LockdownSession> SessionPool;
+typedef QHash<QString, CachedProperties> PropertyCache;
+Q_GLOBAL_STATIC(SessionPool, s_sessions)
+Q_GLOBAL_STATIC(PropertyCache, s_properties)
+/* guards the two hashes above; the actual handshakes and queries run
+ * outside the lock so devices can be initialized concurrently */
+Q_GLOBAL_STATIC(QMutex, s_cacheMutex)
+
+static void closeSession(const QString &deviceId)
+{
+    LockdownSession session;
+    {
+        QMutexLocker locker(s_cacheMutex);
+        session = s_sessions->take(deviceId);
+    }
+    if (session.client) {
+        lockdownd_client_free(session.client);
+    }
+    if (session.device) {
+        idevice_free(session.device);
+    }
+}
+
+static lockdownd_client_t pooledLockdownClient(const QString &deviceId)
+{
+    {
+        QMutexLocker locker(s_cacheMutex);
+        const auto it = s_sessions->constFind(deviceId);
+        if (it != s_sessions->constEnd()) {
+            return it->client;
+        }
+    }
 
     idevice_t device;
     auto ret = idevice_new(&device, deviceId.toUtf8().constData());
     if (ret != IDEVICE_E_SUCCESS) {
         qCWarning(IMOBILE) << "Failed to create device instance for" << deviceId << ret;
-        return;
+        return nullptr;
     }
 
-    auto deviceCleanup = qScopeGuard([device] {
-        idevice_free(device);
-    });
-
     lockdownd_client_t lockdowndClient = nullptr;
     auto lockdownRet = lockdownd_client_new(device, &lockdowndClient, "kde_solid_imobile");
     if (lockdownRet != LOCKDOWN_E_SUCCESS || !lockdowndClient) {
         qCWarning(IMOBILE) << "Failed to create lockdownd client for" << deviceId;
-        return;
+        idevice_free(device);
+        return nullptr;
     }
 
-    auto lockdowndClientCleanup = qScopeGuard([lockdowndClient] {
+    QMutexLocker locker(s_cacheMutex);
+    const auto existing = s_sessions->constFind(deviceId);
+    if (existing != s_sessions->constEnd()) {
+        // somebody else won the race while we were shaking hands
+        locker.unlock();
         lockdownd_client_free(lockdowndClient);
-    });
+        idevice_free(device);
+        return existing->client;
+    }
+    s_sessions->insert(deviceId, {device, lockdowndClient});
+    return lockdowndClient;
+}
+
+static FetchResult fetchProperties(const QString &deviceId)
+{
+    FetchResult result;
+
+    lockdownd_client_t lockdowndClient = pooledLockdownClient(deviceId);
+    if (!lockdowndClient) {
+        result.complete = false;
+        return result;
+    }
 
     char *name = nullptr;
-    lockdownRet = lockdownd_get_device_name(lockdowndClient, &name);
+    auto lockdownRet = lockdownd_get_device_name(lockdowndClient, &name);
     if (lockdownRet != LOCKDOWN_E_SUCCESS) {
         qCWarning(IMOBILE) << "Failed to get device name for" << deviceId << lockdownRet;
+        result.complete = false;
     } else if (name) {
-        m_name = QString::fromUtf8(name);
+        result.properties.name = QString::fromUtf8(name);
         free(name);
     }
 
@@ -61,14 +127,65 @@ IMobileDevice::IMobileDevice(const QString &udi)
     lockdownRet = lockdownd_get_value(lockdowndClient, nullptr /*global domain*/, "DeviceClass", &deviceClassEntry);
     if (lockdownRet != LOCKDOWN_E_SUCCESS) {
         qCWarning(IMOBILE) << "Failed to get device class for" << deviceId << lockdownRet;
+        result.complete = false;
     } else {
         char *deviceClass = nullptr;
         plist_get_string_val(deviceClassEntry, &deviceClass);
         if (deviceClass) {
-            m_deviceClass = QString::fromUtf8(deviceClass);
+            result.properties.deviceClass = QString::fromUtf8(deviceClass);
             free(deviceClass);
         }
     }
+
+    if (result.complete) {
+        QMutexLocker locker(s_cacheMutex);
+        s_properties->insert(deviceId, result.properties);
+    } else {
+        // the session may be unusable (device locked or mid-pairing);
+        // drop it so the next attempt starts with a fresh handshake
+        closeSession(deviceId);
+    }
+
+    return result;
+}
+
+void IMobileDevice::invalidateDeviceCache(const QString &deviceId)
+{
+    closeSession(deviceId);
+    QMutexLocker locker(s_cacheMutex);
+    s_properties->remove(deviceId);
+}
+
+void IMobileDevice::warmUpCache(const QString &deviceId)
+{
+    {
+        QMutexLocker locker(s_cacheMutex);
+        if (s_properties->contains(deviceId)) {
+            return;
+        }
+    }
+    fetchProperties(deviceId);
+}
+
+IMobileDevice::IMobileDevice(const QString &udi)
+    : Solid::Ifaces::Device()
+    , m_udi(udi)
+{
+    const QString deviceId = udi.mid(udiPrefix().length() + 1);
+
+    {
+        QMutexLocker locker(s_cacheMutex);
+        const auto cached = s_properties->constFind(deviceId);
+        if (cached != s_properties->constEnd()) {
+            m_name = cached->name;
+            m_deviceClass = cached->deviceClass;
+            return;
+        }
+    }
+
+    const FetchResult result = fetchProperties(deviceId);
+    m_name = result.properties.name;
+    m_deviceClass = result.properties.deviceClass;
 }
 
 IMobileDevice::~IMobileDevice()
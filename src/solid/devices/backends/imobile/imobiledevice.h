@@ -25,6 +25,21 @@ public:
     explicit IMobileDevice(const QString &udi);
     ~IMobileDevice() override;
 
+    /**
+     * Drops the pooled lockdownd session and the cached properties for
+     * @p deviceId so the next instantiation performs a fresh handshake.
+     * Called by the manager on unplug and pairing events.
+     */
+    static void invalidateDeviceCache(const QString &deviceId);
+
+    /**
+     * Performs the lockdownd handshake and fills the property cache for
+     * @p deviceId if it isn't populated yet. Safe to call from worker
+     * threads; the manager uses it to initialize arriving devices
+     * concurrently before announcing them.
+     */
+    static void warmUpCache(const QString &deviceId);
+
     QString udi() const override;
     QString parentUdi() const override;
 
@@ -10,6 +10,11 @@
 
 #include <QFile>
 #include <QFileSystemWatcher>
+#include <QPointer>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <memory>
 
 #include "imobile_debug.h"
 
@@ -25,6 +30,9 @@ namespace
 {
 constexpr auto VAR_RUN = "/var/run/"_L1;
 constexpr auto MUXD_SOCKET = "/var/run/usbmuxd"_L1;
+// syncing docks announce their devices in quick succession; arrivals within
+// this window are initialized concurrently and flushed as one batch
+constexpr int ARRIVAL_COALESCE_MSECS = 100;
 } // namespace
 
 Manager::Manager(QObject *parent)
@@ -150,20 +158,28 @@ QString Manager::udiPrefix() const
 
 void Manager::onDeviceEvent(const idevice_event_t *event)
 {
-    const QString udi = Solid::Backends::IMobile::udiPrefix() + QLatin1Char('/') + QString::fromLatin1(event->udid);
+    const QString deviceId = QString::fromLatin1(event->udid);
+    const QString udi = Solid::Backends::IMobile::udiPrefix() + QLatin1Char('/') + deviceId;
 
     switch (event->event) {
     case IDEVICE_DEVICE_ADD:
         // Post it to the right thread.
-        QMetaObject::invokeMethod(this, [this, udi] {
-            if (!m_deviceUdis.contains(udi)) {
-                m_deviceUdis.append(udi);
-                Q_EMIT deviceAdded(udi);
+        QMetaObject::invokeMethod(this, [this, udi, deviceId] {
+            // make sure a re-plugged device isn't served stale properties
+            IMobileDevice::invalidateDeviceCache(deviceId);
+            if (m_deviceUdis.contains(udi) || m_pendingArrivals.contains(udi)) {
+                return;
+            }
+            m_pendingArrivals.append(udi);
+            if (m_pendingArrivals.size() == 1) {
+                QTimer::singleShot(ARRIVAL_COALESCE_MSECS, this, &Manager::processPendingArrivals);
             }
         });
         return;
     case IDEVICE_DEVICE_REMOVE:
-        QMetaObject::invokeMethod(this, [this, udi] {
+        QMetaObject::invokeMethod(this, [this, udi, deviceId] {
+            IMobileDevice::invalidateDeviceCache(deviceId);
+            m_pendingArrivals.removeOne(udi); // may be gone before it was ever announced
             if (m_deviceUdis.removeOne(udi)) {
                 Q_EMIT deviceRemoved(udi);
             }
@@ -171,6 +187,10 @@ void Manager::onDeviceEvent(const idevice_event_t *event)
         return;
 #if IMOBILEDEVICE_API >= QT_VERSION_CHECK(1, 3, 0)
     case IDEVICE_DEVICE_PAIRED:
+        // pairing unlocks queries that failed before, retry with a fresh session
+        QMetaObject::invokeMethod(this, [deviceId] {
+            IMobileDevice::invalidateDeviceCache(deviceId);
+        });
         return;
 #endif
     }
@@ -178,4 +198,47 @@ void Manager::onDeviceEvent(const idevice_event_t *event)
     qCDebug(IMOBILE) << "Unhandled device event" << event->event << "for" << event->udid;
 }
 
+void Manager::processPendingArrivals()
+{
+    const QStringList batch = std::exchange(m_pendingArrivals, {});
+    if (batch.isEmpty()) {
+        return;
+    }
+
+    // warm every device's cache on the global pool so the batch is ready
+    // after the slowest handshake, not the sum of all of them
+    QPointer<Manager> guard(this);
+    auto remaining = std::make_shared<QAtomicInt>(batch.size());
+    for (const QString &udi : batch) {
+        const QString deviceId = udi.mid(Solid::Backends::IMobile::udiPrefix().length() + 1);
+        QThreadPool::globalInstance()->start([guard, remaining, batch, deviceId] {
+            IMobileDevice::warmUpCache(deviceId);
+            if (!remaining->deref() && guard) {
+                QMetaObject::invokeMethod(
+                    guard.data(),
+                    [guard, batch] {
+                        if (guard) {
+                            guard->flushArrivals(batch);
+                        }
+                    },
+                    Qt::QueuedConnection);
+            }
+        });
+    }
+}
+
+void Manager::flushArrivals(const QStringList &batch)
+{
+    QStringList added;
+    for (const QString &udi : batch) {
+        if (!m_deviceUdis.contains(udi)) {
+            m_deviceUdis.append(udi);
+            added.append(udi);
+        }
+    }
+    for (const QString &udi : std::as_const(added)) {
+        Q_EMIT deviceAdded(udi);
+    }
+}
+
 #include "moc_imobilemanager.cpp"
@@ -39,8 +39,14 @@ public:
 
 private:
     void spinUp();
+    void processPendingArrivals();
+    void flushArrivals(const QStringList &batch);
+
     bool m_spunUp = false;
     QStringList m_deviceUdis;
+    // arrivals collected during the coalescing window, announced in one batch
+    // once every device finished its concurrent initialization
+    QStringList m_pendingArrivals;
     std::unique_ptr<QFileSystemWatcher> m_watcher;
 };
 
@@ -5,6 +5,8 @@
     SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
 */
 
+#include "cfproperties_p.h"
+
 #include <qdatetime.h>
 #include <qdebug.h>
 #include <qstring.h>
@@ -140,27 +142,83 @@ static QVariant q_toVariant(const CFTypeRef &obj)
     return QVariant();
 }
 
-QMap<QString, QVariant> q_toVariantMap(const CFMutableDictionaryRef &dict)
-{
-    Q_ASSERT(dict);
+using namespace Solid::Backends::IOKit;
 
-    QMap<QString, QVariant> result;
+CFProperties::CFProperties(CFDictionaryRef dict)
+    : m_dict(dict)
+{
+}
 
-    const int count = CFDictionaryGetCount(dict);
-    QVarLengthArray<void *> keys(count);
-    QVarLengthArray<void *> values(count);
+CFProperties::~CFProperties()
+{
+    if (m_dict) {
+        CFRelease(m_dict);
+    }
+}
 
-    CFDictionaryGetKeysAndValues(dict, const_cast<const void **>(keys.data()), const_cast<const void **>(values.data()));
+bool CFProperties::isValid() const
+{
+    return m_dict != nullptr;
+}
 
-    for (int i = 0; i < count; ++i) {
-        const QString key = q_toString((CFStringRef)keys[i]);
-        const QVariant value = q_toVariant((CFTypeRef)values[i]);
-        result[key] = value;
+bool CFProperties::contains(const QString &key) const
+{
+    if (m_converted.contains(key)) {
+        return true;
     }
+    if (!m_dict) {
+        return false;
+    }
+    const CFStringRef keyRef = key.toCFString();
+    const bool present = CFDictionaryContainsKey(m_dict, keyRef);
+    CFRelease(keyRef);
+    return present;
+}
 
+QVariant CFProperties::value(const QString &key) const
+{
+    const auto converted = m_converted.constFind(key);
+    if (converted != m_converted.constEnd()) {
+        return *converted;
+    }
+    if (!m_dict) {
+        return QVariant();
+    }
+    const CFStringRef keyRef = key.toCFString();
+    const void *cfValue = nullptr;
+    const bool present = CFDictionaryGetValueIfPresent(m_dict, keyRef, &cfValue);
+    CFRelease(keyRef);
+    if (!present) {
+        return QVariant();
+    }
+    const QVariant result = q_toVariant(static_cast<CFTypeRef>(cfValue));
+    m_converted.insert(key, result);
     return result;
 }
 
+QMap<QString, QVariant> CFProperties::toMap() const
+{
+    if (m_dict) {
+        const int count = CFDictionaryGetCount(m_dict);
+        QVarLengthArray<const void *> keys(count);
+        QVarLengthArray<const void *> values(count);
+        CFDictionaryGetKeysAndValues(m_dict, keys.data(), values.data());
+
+        for (int i = 0; i < count; ++i) {
+            const QString key = q_toString((CFStringRef)keys[i]);
+            if (!m_converted.contains(key)) {
+                m_converted.insert(key, q_toVariant((CFTypeRef)values[i]));
+            }
+        }
+    }
+    return m_converted;
+}
+
+void CFProperties::insert(const QString &key, const QVariant &value)
+{
+    m_converted.insert(key, value);
+}
+
 bool q_sysctlbyname(const char *name, QString &result)
 {
     char *property = nullptr;
@@ -0,0 +1,69 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_IOKIT_CFPROPERTIES_P_H
+#define SOLID_BACKENDS_IOKIT_CFPROPERTIES_P_H
+
+#include <QMap>
+#include <QString>
+#include <QVariant>
+
+#include <CoreFoundation/CoreFoundation.h>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace IOKit
+{
+/**
+ * Lazy view on a CF property dictionary.
+ *
+ * The dictionary is kept retained and individual values are only converted
+ * to QVariant on first access, memoized for later reads. Most callers look
+ * at a handful of keys, so converting the whole tree up front wasted a lot
+ * of allocations on devices with large property tables (USB descriptors,
+ * display data). Implemented in cfhelper.cpp next to the conversion
+ * routines it relies on.
+ */
+class CFProperties
+{
+public:
+    CFProperties() = default;
+    /**
+     * Wraps the given dictionary; ownership of the passed
+     * reference is taken over (no extra retain).
+     */
+    explicit CFProperties(CFDictionaryRef dict);
+    ~CFProperties();
+
+    CFProperties(const CFProperties &) = delete;
+    CFProperties &operator=(const CFProperties &) = delete;
+
+    bool isValid() const;
+    bool contains(const QString &key) const;
+    QVariant value(const QString &key) const;
+    /**
+     * Converts any keys that have not been read yet and returns the
+     * complete map; only allProperties() should need this.
+     */
+    QMap<QString, QVariant> toMap() const;
+
+    /**
+     * Seeds a value that is not part of the underlying dictionary
+     * (the synthesized className entry).
+     */
+    void insert(const QString &key, const QVariant &value);
+
+private:
+    CFDictionaryRef m_dict = nullptr;
+    mutable QMap<QString, QVariant> m_converted;
+};
+}
+}
+}
+
+#endif // SOLID_BACKENDS_IOKIT_CFPROPERTIES_P_H
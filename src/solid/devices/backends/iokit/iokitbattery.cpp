@@ -8,17 +8,90 @@
 #include "iokitbattery.h"
 #include "iokitdevice.h"
 
-// TODO - emit the signals
+#include <QDebug>
+#include <QList>
+
+#include <IOKit/ps/IOPowerSources.h>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace IOKit
+{
+/* Subscribes to the power source notifications so the batteries get
+ * pushed fresh data instead of clients having to poll. One run loop
+ * source serves every Battery instance in the process. */
+class BatteryMonitor
+{
+public:
+    BatteryMonitor()
+    {
+        m_source = IOPSNotificationCreateRunLoopSource(&BatteryMonitor::powerSourcesChanged, this);
+        if (m_source) {
+            CFRunLoopAddSource(CFRunLoopGetCurrent(), m_source, kCFRunLoopDefaultMode);
+        } else {
+            qWarning() << Q_FUNC_INFO << "unable to create power source notification source";
+        }
+    }
+
+    ~BatteryMonitor()
+    {
+        if (m_source) {
+            CFRunLoopRemoveSource(CFRunLoopGetCurrent(), m_source, kCFRunLoopDefaultMode);
+            CFRelease(m_source);
+        }
+    }
+
+    void add(Battery *battery)
+    {
+        m_batteries.append(battery);
+    }
+
+    void remove(Battery *battery)
+    {
+        m_batteries.removeOne(battery);
+    }
+
+private:
+    static void powerSourcesChanged(void *context);
+
+    CFRunLoopSourceRef m_source = nullptr;
+    QList<Battery *> m_batteries;
+};
+
+Q_GLOBAL_STATIC(BatteryMonitor, s_batteryMonitor)
+
+void BatteryMonitor::powerSourcesChanged(void *context)
+{
+    // the power source data changed behind the property snapshots
+    flushPropertyCache();
+
+    BatteryMonitor *monitor = static_cast<BatteryMonitor *>(context);
+    const QList<Battery *> batteries = monitor->m_batteries;
+    for (Battery *battery : batteries) {
+        battery->onPowerSourcesChanged();
+    }
+}
+
+}
+}
+}
 
 using namespace Solid::Backends::IOKit;
 
 Battery::Battery(IOKitDevice *device)
     : DeviceInterface(device)
 {
+    updateCachedState(false);
+    s_batteryMonitor->add(this);
 }
 
 Battery::~Battery()
 {
+    if (!s_batteryMonitor.isDestroyed()) {
+        s_batteryMonitor->remove(this);
+    }
 }
 
 // properties: QMap(("AdapterInfo", QVariant(int, 0))
@@ -69,30 +142,22 @@ Battery::~Battery()
 
 qlonglong Battery::timeToEmpty() const
 {
-    if (chargeState() != Solid::Battery::Charging) {
-        int t = m_device->property(QStringLiteral("AvgTimeToEmpty")).toInt();
-        return t == 65535 ? -1 : t * 60;
-    }
-    return -1;
+    return m_timeToEmpty;
 }
 
 qlonglong Battery::timeToFull() const
 {
-    if (chargeState() == Solid::Battery::Charging) {
-        int t = m_device->property(QStringLiteral("AvgTimeToFull")).toInt();
-        return t == 65535 ? -1 : t * 60;
-    }
-    return -1;
+    return m_timeToFull;
 }
 
 double Battery::voltage() const
 {
-    return m_device->property(QStringLiteral("Voltage")).toInt() / 1000.0;
+    return m_voltage;
 }
 
 double Battery::temperature() const
 {
-    return m_device->property(QStringLiteral("Temperature")).toInt() / 100.0;
+    return m_temperature;
 }
 
 QString Battery::serial() const
@@ -102,7 +167,7 @@ QString Battery::serial() const
 
 bool Battery::isPresent() const
 {
-    return m_device->property(QStringLiteral("ExternalConnected")).toBool();
+    return m_present;
 }
 
 Solid::Battery::BatteryType Battery::type() const
@@ -114,21 +179,12 @@ Solid::Battery::BatteryType Battery::type() const
 
 int Battery::chargePercent() const
 {
-    // always calculate since FullyCharged remains true down to 92% or so.
-    int maxCapacity = m_device->property(QStringLiteral("MaxCapacity")).toInt();
-    if (maxCapacity == 0) {
-        return 0; // prevent divide by 0
-    }
-    return int(m_device->property(QStringLiteral("CurrentCapacity")).toInt() * 100.0 / maxCapacity + 0.5);
+    return m_chargePercent;
 }
 
 int Battery::capacity() const
 {
-    if (m_device->iOKitPropertyExists(QStringLiteral("PermanentFailureStatus")) //
-        && m_device->property(QStringLiteral("PermanentFailureStatus")).toInt()) {
-        return 0;
-    }
-    return 100;
+    return m_capacity;
 }
 
 bool Battery::isRechargeable() const
@@ -138,22 +194,107 @@ bool Battery::isRechargeable() const
 
 bool Battery::isPowerSupply() const
 {
-    /* clang-format off */
-    return m_device->iOKitPropertyExists(QStringLiteral("BatteryInstalled"))
-           ? m_device->property(QStringLiteral("BatteryInstalled")).toBool()
-           : true;
-    /* clang-format on */
+    return m_powerSupply;
 }
 
 Solid::Battery::ChargeState Battery::chargeState() const
 {
+    return m_chargeState;
+}
+
+void Battery::onPowerSourcesChanged()
+{
+    m_device->refreshProperties();
+    updateCachedState(true);
+}
+
+void Battery::updateCachedState(bool emitSignals)
+{
+    const QString udi = m_device->udi();
+
+    const bool present = m_device->property(QStringLiteral("ExternalConnected")).toBool();
+
+    /* clang-format off */
+    const bool powerSupply = m_device->iOKitPropertyExists(QStringLiteral("BatteryInstalled"))
+                             ? m_device->property(QStringLiteral("BatteryInstalled")).toBool()
+                             : true;
+    /* clang-format on */
+
+    // always calculate since FullyCharged remains true down to 92% or so.
+    const int maxCapacity = m_device->property(QStringLiteral("MaxCapacity")).toInt();
+    // the zero check prevents a divide by 0
+    const int chargePercent = maxCapacity == 0 //
+        ? 0
+        : int(m_device->property(QStringLiteral("CurrentCapacity")).toInt() * 100.0 / maxCapacity + 0.5);
+
+    /* clang-format off */
+    const int capacity = (m_device->iOKitPropertyExists(QStringLiteral("PermanentFailureStatus"))
+                          && m_device->property(QStringLiteral("PermanentFailureStatus")).toInt())
+                         ? 0
+                         : 100;
+    /* clang-format on */
+
+    Solid::Battery::ChargeState chargeState = Solid::Battery::Discharging;
     if (m_device->property(QStringLiteral("IsCharging")).toBool()) {
-        return Solid::Battery::Charging;
+        chargeState = Solid::Battery::Charging;
+    } else if (m_device->property(QStringLiteral("FullyCharged")).toBool()) {
+        chargeState = Solid::Battery::FullyCharged;
     }
-    if (m_device->property(QStringLiteral("FullyCharged")).toBool()) {
-        return Solid::Battery::FullyCharged;
+
+    qlonglong timeToEmpty = -1;
+    if (chargeState != Solid::Battery::Charging) {
+        const int t = m_device->property(QStringLiteral("AvgTimeToEmpty")).toInt();
+        timeToEmpty = t == 65535 ? -1 : t * 60;
+    }
+
+    qlonglong timeToFull = -1;
+    if (chargeState == Solid::Battery::Charging) {
+        const int t = m_device->property(QStringLiteral("AvgTimeToFull")).toInt();
+        timeToFull = t == 65535 ? -1 : t * 60;
     }
-    return Solid::Battery::Discharging;
+
+    const double voltage = m_device->property(QStringLiteral("Voltage")).toInt() / 1000.0;
+    const double temperature = m_device->property(QStringLiteral("Temperature")).toInt() / 100.0;
+
+    if (emitSignals) {
+        if (present != m_present) {
+            Q_EMIT presentStateChanged(present, udi);
+        }
+        if (powerSupply != m_powerSupply) {
+            Q_EMIT powerSupplyStateChanged(powerSupply, udi);
+        }
+        if (chargePercent != m_chargePercent) {
+            Q_EMIT chargePercentChanged(chargePercent, udi);
+        }
+        if (capacity != m_capacity) {
+            Q_EMIT capacityChanged(capacity, udi);
+        }
+        if (chargeState != m_chargeState) {
+            Q_EMIT chargeStateChanged(chargeState, udi);
+        }
+        if (timeToEmpty != m_timeToEmpty) {
+            Q_EMIT timeToEmptyChanged(timeToEmpty, udi);
+        }
+        if (timeToFull != m_timeToFull) {
+            Q_EMIT timeToFullChanged(timeToFull, udi);
+        }
+        if (voltage != m_voltage) {
+            Q_EMIT voltageChanged(voltage, udi);
+        }
+        if (temperature != m_temperature) {
+            Q_EMIT temperatureChanged(temperature, udi);
+        }
+    }
+
+    m_present = present;
+    m_powerSupply = powerSupply;
+    m_chargePercent = chargePercent;
+    m_capacity = capacity;
+    m_chargeState = chargeState;
+    m_timeToEmpty = timeToEmpty;
+    m_timeToFull = timeToFull;
+    m_voltage = voltage;
+    m_temperature = temperature;
 }
 
 #include "moc_iokitbattery.cpp"
@@ -70,6 +70,24 @@ Q_SIGNALS:
     void temperatureChanged(double temperature, const QString &udi) override;
     void voltageChanged(double voltage, const QString &udi) override;
     void remainingTimeChanged(qlonglong time, const QString &udi) override;
+
+private:
+    friend class BatteryMonitor;
+
+    // refreshes the device properties, updates the cached state and
+    // emits the change signals; driven by the IOPS notifications
+    void onPowerSourcesChanged();
+    void updateCachedState(bool emitSignals);
+
+    bool m_present;
+    bool m_powerSupply;
+    int m_chargePercent;
+    int m_capacity;
+    Solid::Battery::ChargeState m_chargeState;
+    qlonglong m_timeToEmpty;
+    qlonglong m_timeToFull;
+    double m_voltage;
+    double m_temperature;
 };
 }
 }
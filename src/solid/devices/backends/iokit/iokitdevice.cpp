@@ -6,6 +6,7 @@
 */
 
 #include "iokitdevice.h"
+#include "cfproperties_p.h"
 #include "iokitbattery.h"
 #include "iokitgenericinterface.h"
 #include "iokitopticaldisc.h"
@@ -15,8 +16,11 @@
 #include "iokitstorageaccess.h"
 #include "iokitvolume.h"
 
+#include <QDeadlineTimer>
 #include <QDebug>
+#include <QHash>
 #include <QSet>
+#include <QSharedPointer>
 #include <QUrl>
 
 #include <sys/sysctl.h>
@@ -28,7 +32,6 @@
 #include <CoreFoundation/CoreFoundation.h>
 
 // from cfhelper.cpp
-extern QMap<QString, QVariant> q_toVariantMap(const CFMutableDictionaryRef &dict);
 extern bool q_sysctlbyname(const char *name, QString &result);
 
 typedef QSet<Solid::DeviceInterface::Type> DeviceInterfaceTypes;
@@ -40,7 +43,7 @@ namespace Backends
 namespace IOKit
 {
 // returns a solid type from an entry and its properties
-static DeviceInterfaceTypes typesFromEntry(const io_registry_entry_t &entry, const QMap<QString, QVariant> &properties, Solid::DeviceInterface::Type &mainType)
+static DeviceInterfaceTypes typesFromEntry(const io_registry_entry_t &entry, const CFProperties &properties, Solid::DeviceInterface::Type &mainType)
 {
     DeviceInterfaceTypes types;
     mainType = Solid::DeviceInterface::Unknown;
@@ -81,22 +84,60 @@ static DeviceInterfaceTypes typesFromEntry(const io_registry_entry_t &entry, con
     return types;
 }
 
-// gets all properties from an entry into a QMap
-static QMap<QString, QVariant> getProperties(const io_registry_entry_t &entry)
+typedef QSharedPointer<CFProperties> CFPropertiesPtr;
+
+/* Property snapshots shared between IOKitDevice instances, keyed by registry
+ * entry ID. Fetching and converting the properties dominated enumeration
+ * time because every device construction redid it, including for the parent
+ * chain; the CFProperties wrapper additionally defers the per-value
+ * conversion until a key is actually read. The manager flushes this cache on
+ * registry change notifications; the short expiry additionally keeps mutable
+ * properties (battery levels, mount state) from going stale, since those
+ * change without any publish or terminate event. */
+struct CachedProperties {
+    CFPropertiesPtr properties;
+    QDeadlineTimer expiry;
+};
+typedef QHash<quint64, CachedProperties> PropertyCache;
+Q_GLOBAL_STATIC(PropertyCache, s_propertyCache)
+
+static const int c_propertySnapshotMsecs = 1000;
+
+void flushPropertyCache()
+{
+    s_propertyCache->clear();
+}
+
+// wraps the property dictionary of an entry for lazy conversion
+static CFPropertiesPtr getProperties(const io_registry_entry_t &entry)
 {
+    quint64 entryID = 0;
+    if (IORegistryEntryGetRegistryEntryID(entry, &entryID) != KERN_SUCCESS) {
+        entryID = 0;
+    }
+    if (entryID) {
+        const auto cached = s_propertyCache->constFind(entryID);
+        if (cached != s_propertyCache->constEnd() && !cached->expiry.hasExpired()) {
+            return cached->properties;
+        }
+    }
+
     CFMutableDictionaryRef propertyDict = 0;
 
     if (IORegistryEntryCreateCFProperties(entry, &propertyDict, kCFAllocatorDefault, kNilOptions) != KERN_SUCCESS) {
-        return QMap<QString, QVariant>();
+        return CFPropertiesPtr::create();
     }
 
-    QMap<QString, QVariant> result = q_toVariantMap(propertyDict);
-
-    CFRelease(propertyDict);
+    // CFProperties takes over our reference on the dictionary
+    CFPropertiesPtr result = CFPropertiesPtr::create(propertyDict);
 
     io_name_t className;
     IOObjectGetClass(entry, className);
-    result["className"] = QString::fromUtf8(className);
+    result->insert(QStringLiteral("className"), QString::fromUtf8(className));
+
+    if (entryID) {
+        s_propertyCache->insert(entryID, {result, QDeadlineTimer(c_propertySnapshotMsecs)});
+    }
 
     return result;
 }
@@ -132,7 +173,8 @@ class IOKitDevicePrivate
 {
 public:
     inline IOKitDevicePrivate()
-        : type({Solid::DeviceInterface::Unknown})
+        : properties(CFPropertiesPtr::create())
+        , type({Solid::DeviceInterface::Unknown})
         , parentDevice(nullptr)
     {
     }
@@ -149,7 +191,7 @@ public:
 
     QString udi;
     QString parentUdi;
-    QMap<QString, QVariant> properties;
+    CFPropertiesPtr properties;
     DeviceInterfaceTypes type;
     Solid::DeviceInterface::Type mainType;
     IOKitDevice *parentDevice;
@@ -164,9 +206,9 @@ void IOKitDevicePrivate::init(const QString &udiString, const io_registry_entry_
     properties = getProperties(entry);
 
     parentUdi = getParentDeviceUdi(entry);
-    type = typesFromEntry(entry, properties, mainType);
+    type = typesFromEntry(entry, *properties, mainType);
     if (udi.contains(QStringLiteral("IOBD")) || udi.contains(QStringLiteral("BD PX"))) {
-        qWarning() << "Solid: BlueRay entry" << entry << "mainType=" << mainType << "typeList:" << type << "with properties" << properties;
+        qWarning() << "Solid: BlueRay entry" << entry << "mainType=" << mainType << "typeList:" << type << "with properties" << properties->toMap();
     }
     if (mainType != Solid::DeviceInterface::Unknown) { }
 
@@ -415,22 +457,38 @@ QStringList IOKitDevice::emblems() const
     return QStringList(); // TODO
 }
 
+void IOKitDevice::refreshProperties()
+{
+    if (d->udi.isEmpty()) {
+        return;
+    }
+
+    CFStringRef path = d->udi.toCFString();
+    io_registry_entry_t entry = IORegistryEntryCopyFromPath(kIOMasterPortDefault, path);
+    CFRelease(path);
+
+    if (entry != MACH_PORT_NULL) {
+        d->properties = getProperties(entry);
+        IOObjectRelease(entry);
+    }
+}
+
 QVariant IOKitDevice::property(const QString &key) const
 {
-    if (!d->properties.contains(key)) {
+    if (!d->properties->contains(key)) {
         return QObject::property(key.toUtf8());
     }
-    return d->properties.value(key);
+    return d->properties->value(key);
 }
 
 QMap<QString, QVariant> IOKitDevice::allProperties() const
 {
-    return d->properties;
+    return d->properties->toMap();
 }
 
 bool IOKitDevice::iOKitPropertyExists(const QString &key) const
 {
-    return d->properties.contains(key);
+    return d->properties->contains(key);
 }
 
 bool IOKitDevice::queryDeviceInterface(const Solid::DeviceInterface::Type &type) const
@@ -19,6 +19,10 @@ namespace IOKit
 class IOKitDevicePrivate;
 class IOKitManager;
 
+/* Drops the property snapshots shared between IOKitDevice instances.
+ * Called by the manager when IOKit reports registry changes. */
+void flushPropertyCache();
+
 class IOKitDevice : public Solid::Ifaces::Device
 {
     Q_OBJECT
@@ -39,6 +43,10 @@ public:
 
     virtual QVariant property(const QString &key) const;
 
+    /* re-reads the property snapshot from the registry; used by
+     * interfaces that receive change notifications (Battery). */
+    void refreshProperties();
+
     virtual QMap<QString, QVariant> allProperties() const;
 
     virtual bool iOKitPropertyExists(const QString &key) const;
@@ -6,9 +6,15 @@
 
 #include "iokitmanager.h"
 #include "iokitdevice.h"
+#include "iokitopticaldrive.h"
 
 #include <qdebug.h>
 
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <QThread>
+
+#include <IOKit/IOKitKeys.h>
 #include <IOKit/IOKitLib.h>
 #include <IOKit/network/IOEthernetInterface.h>
 #include <IOKit/usb/IOUSBLib.h>
@@ -21,22 +27,149 @@ namespace Backends
 {
 namespace IOKit
 {
-class IOKitManagerPrivate
+/* Services the IONotificationPort on a dedicated CFRunLoop so registry
+ * callbacks never contend with whatever the application's main loop is
+ * doing. A burst of arrivals (docking, hub enumeration) is collapsed into
+ * one queued registryChanged() delivery to the manager's thread. */
+class IOKitNotificationThread : public QThread
 {
+    Q_OBJECT
 public:
-    inline IOKitManagerPrivate()
-        : port(nullptr)
-        , source(nullptr)
+    explicit IOKitNotificationThread(QObject *parent = nullptr)
+        : QThread(parent)
+    {
+    }
+
+    ~IOKitNotificationThread() override
+    {
+        if (isRunning()) {
+            m_stopRequested.storeRelease(1);
+            CFRunLoopStop(m_runLoop);
+            wait();
+        }
+    }
+
+    /* blocks until run() finished arming; returns whether it succeeded */
+    bool waitUntilArmed()
+    {
+        m_armedSemaphore.acquire();
+        return m_armed;
+    }
+
+    /* the manager calls this before flushing its caches; the next registry
+     * event after that point queues a fresh delivery */
+    void acknowledgeFlush()
     {
+        m_flushPending.storeRelease(0);
+    }
+
+Q_SIGNALS:
+    void registryChanged();
+
+protected:
+    void run() override;
+
+private:
+    static void serviceChanged(void *refcon, io_iterator_t it);
+
+    IONotificationPortRef m_port = nullptr;
+    io_iterator_t m_publishedIter = 0;
+    io_iterator_t m_terminatedIter = 0;
+    CFRunLoopRef m_runLoop = nullptr;
+    QSemaphore m_armedSemaphore;
+    QAtomicInt m_flushPending;
+    QAtomicInt m_stopRequested;
+    bool m_armed = false;
+};
+
+void IOKitNotificationThread::serviceChanged(void *refcon, io_iterator_t it)
+{
+    // the iterator must be drained for the notification to re-arm
+    io_object_t obj;
+    while ((obj = IOIteratorNext(it))) {
+        IOObjectRelease(obj);
+    }
+
+    /* coalesce: only the first event of a burst crosses the thread
+     * boundary, the rest ride on the pending flush */
+    IOKitNotificationThread *thread = static_cast<IOKitNotificationThread *>(refcon);
+    if (thread->m_flushPending.testAndSetAcquire(0, 1)) {
+        Q_EMIT thread->registryChanged();
+    }
+}
+
+void IOKitNotificationThread::run()
+{
+    m_runLoop = CFRunLoopGetCurrent();
+
+    m_port = IONotificationPortCreate(kIOMasterPortDefault);
+    CFRunLoopSourceRef source = m_port ? IONotificationPortGetRunLoopSource(m_port) : nullptr;
+    if (!source) {
+        qWarning() << Q_FUNC_INFO << "Unable to create notification port";
+        m_armedSemaphore.release();
+        return;
     }
+    CFRunLoopAddSource(m_runLoop, source, kCFRunLoopDefaultMode);
+
+    /* watch the whole service plane so the snapshot caches can be flushed
+     * when the registry changes */
+    kern_return_t ret = IOServiceAddMatchingNotification(m_port,
+                                                         kIOPublishNotification,
+                                                         IOServiceMatching(kIOServiceClass),
+                                                         &IOKitNotificationThread::serviceChanged,
+                                                         this,
+                                                         &m_publishedIter);
+    if (ret == KERN_SUCCESS) {
+        ret = IOServiceAddMatchingNotification(m_port,
+                                               kIOTerminatedNotification,
+                                               IOServiceMatching(kIOServiceClass),
+                                               &IOKitNotificationThread::serviceChanged,
+                                               this,
+                                               &m_terminatedIter);
+    }
+
+    m_armed = (ret == KERN_SUCCESS);
+    if (m_armed) {
+        // drain the initial matches to arm the notifications
+        serviceChanged(this, m_publishedIter);
+        serviceChanged(this, m_terminatedIter);
+    } else {
+        qWarning() << Q_FUNC_INFO << "unable to register for registry change notifications";
+    }
+    m_armedSemaphore.release();
+
+    /* re-check the stop flag whenever the loop is kicked out, so a stop
+     * request racing the loop entry doesn't leave the thread spinning */
+    while (m_armed && !m_stopRequested.loadAcquire()) {
+        CFRunLoopRunInMode(kCFRunLoopDefaultMode, 1.0e9, true);
+    }
+
+    if (m_publishedIter) {
+        IOObjectRelease(m_publishedIter);
+    }
+    if (m_terminatedIter) {
+        IOObjectRelease(m_terminatedIter);
+    }
+    CFRunLoopRemoveSource(m_runLoop, source, kCFRunLoopDefaultMode);
+    IONotificationPortDestroy(m_port);
+}
+
+class IOKitManagerPrivate
+{
+public:
+    IOKitManagerPrivate() = default;
 
-    IONotificationPortRef port;
-    CFRunLoopSourceRef source;
+    IOKitNotificationThread *notificationThread = nullptr;
+    bool notificationsArmed = false;
 
     static const char *typeToName(Solid::DeviceInterface::Type type);
     static QStringList devicesFromRegistry(io_iterator_t it);
 
     QSet<Solid::DeviceInterface::Type> supportedInterfaces;
+
+    /* traversal results per matched class, valid until IOKit reports a
+     * registry change; only used when the notifications could be armed */
+    QHash<QByteArray, QStringList> queryCache;
 };
 
 // gets all registry paths from an iterator
@@ -96,19 +229,20 @@ IOKitManager::IOKitManager(QObject *parent)
     : Solid::Ifaces::DeviceManager(parent)
     , d(new IOKitManagerPrivate)
 {
-    d->port = IONotificationPortCreate(kIOMasterPortDefault);
-    if (!d->port) {
-        qWarning() << Q_FUNC_INFO << "Unable to create notification port";
-        return;
-    }
+    d->notificationThread = new IOKitNotificationThread(this);
 
-    d->source = IONotificationPortGetRunLoopSource(d->port);
-    if (!d->source) {
-        qWarning() << Q_FUNC_INFO << "Unable to create notification source";
-        return;
-    }
+    /* queued across the thread boundary; connected before start() so the
+     * initial drain can't slip a delivery past us */
+    connect(d->notificationThread, &IOKitNotificationThread::registryChanged, this, [this]() {
+        d->notificationThread->acknowledgeFlush();
+        d->queryCache.clear();
+        flushPropertyCache();
+        flushOpticalDriveCapabilityCache();
+    });
+
+    d->notificationThread->start();
+    d->notificationsArmed = d->notificationThread->waitUntilArmed();
 
-    CFRunLoopAddSource(CFRunLoopGetCurrent(), d->source, kCFRunLoopDefaultMode);
     // clang-format off
     d->supportedInterfaces << Solid::DeviceInterface::GenericInterface
                            << Solid::DeviceInterface::Processor
@@ -126,12 +260,9 @@ IOKitManager::IOKitManager(QObject *parent)
 
 IOKitManager::~IOKitManager()
 {
-    if (d->source) {
-        CFRunLoopRemoveSource(CFRunLoopGetCurrent(), d->source, kCFRunLoopDefaultMode);
-    }
-    if (d->port) {
-        IONotificationPortDestroy(d->port);
-    }
+    // stops and joins the run loop; port teardown happens on its thread
+    delete d->notificationThread;
+    d->notificationThread = nullptr;
 
     delete d;
 }
@@ -148,6 +279,14 @@ QSet<Solid::DeviceInterface::Type> IOKitManager::supportedInterfaces() const
 
 QStringList IOKitManager::allDevices()
 {
+    static const QByteArray allDevicesKey = QByteArrayLiteral("<all>");
+    if (d->notificationsArmed) {
+        const auto cached = d->queryCache.constFind(allDevicesKey);
+        if (cached != d->queryCache.constEnd()) {
+            return *cached;
+        }
+    }
+
     // use an IORegistry Iterator to iterate over all devices in the service plane
 
     io_iterator_t it;
@@ -157,7 +296,11 @@ QStringList IOKitManager::allDevices()
         return QStringList();
     }
 
-    return IOKitManagerPrivate::devicesFromRegistry(it);
+    const QStringList result = IOKitManagerPrivate::devicesFromRegistry(it);
+    if (d->notificationsArmed) {
+        d->queryCache.insert(allDevicesKey, result);
+    }
+    return result;
 }
 
 QStringList IOKitManager::devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
@@ -173,18 +316,27 @@ QStringList IOKitManager::devicesFromQuery(const QString &parentUdi, Solid::Devi
             return QStringList();
         }
 
-        CFMutableDictionaryRef matchingDict = IOServiceMatching(deviceClassName);
+        const QByteArray cacheKey(deviceClassName);
+        const auto cached = d->notificationsArmed ? d->queryCache.constFind(cacheKey) : d->queryCache.constEnd();
+        if (cached != d->queryCache.constEnd()) {
+            result = *cached;
+        } else {
+            CFMutableDictionaryRef matchingDict = IOServiceMatching(deviceClassName);
 
-        if (!matchingDict) {
-            return QStringList();
-        }
+            if (!matchingDict) {
+                return QStringList();
+            }
 
-        io_iterator_t it = 0;
+            io_iterator_t it = 0;
 
-        // note - IOServiceGetMatchingServices dereferences the dict
-        kern_return_t ret = IOServiceGetMatchingServices(kIOMasterPortDefault, matchingDict, &it);
+            // note - IOServiceGetMatchingServices dereferences the dict
+            kern_return_t ret = IOServiceGetMatchingServices(kIOMasterPortDefault, matchingDict, &it);
 
-        result = IOKitManagerPrivate::devicesFromRegistry(it);
+            result = IOKitManagerPrivate::devicesFromRegistry(it);
+            if (d->notificationsArmed) {
+                d->queryCache.insert(cacheKey, result);
+            }
+        }
     }
 
     // if the parentUdi is an empty string, return all matches
@@ -224,4 +376,5 @@ QObject *IOKitManager::createDevice(const QString &udi)
 }
 } // namespaces
 
+#include "iokitmanager.moc"
 #include "moc_iokitmanager.cpp"
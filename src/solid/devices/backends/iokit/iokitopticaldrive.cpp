@@ -7,6 +7,7 @@
 #include "iokitopticaldrive.h"
 
 #include <QDebug>
+#include <QHash>
 #include <QProcess>
 
 #ifdef EJECT_USING_DISKARBITRATION
@@ -22,11 +23,25 @@
 
 using namespace Solid::Backends::IOKit;
 
+/* Capability sets probed per drive, keyed by the registry path of the entry
+ * carrying the "Device Characteristics" property (the drive, not the media).
+ * Burning UIs query supportedMedia() repeatedly; the capabilities only
+ * depend on the hardware, so the probe result is kept until the manager
+ * sees the registry change. */
+typedef QHash<QString, Solid::OpticalDrive::MediumTypes> CapabilityCache;
+Q_GLOBAL_STATIC(CapabilityCache, s_capabilityCache)
+
+void Solid::Backends::IOKit::flushOpticalDriveCapabilityCache()
+{
+    s_capabilityCache->clear();
+}
+
 class IOKitOpticalDrive::Private
 {
 public:
-    Private(const IOKitDevice *device, const QVariantMap &devCharMap)
+    Private(const IOKitDevice *device, const QString &driveUdi, const QVariantMap &devCharMap)
         : m_device(device)
+        , m_driveUdi(driveUdi)
         , m_deviceCharacteristics(devCharMap)
     {
     }
@@ -40,6 +55,7 @@ public:
     }
 
     const IOKitDevice *m_device;
+    const QString m_driveUdi;
     const QVariantMap m_deviceCharacteristics;
 
     static const QMap<Solid::OpticalDrive::MediumType, uint32_t> cdTypeMap;
@@ -184,13 +200,15 @@ IOKitOpticalDrive::IOKitOpticalDrive(IOKitDevice *device)
     // to be non-guaranteed we'll need to do a true walk.
     IOKitDevice ioDVDServices(IOKitDevice(device->parentUdi()).parentUdi());
     QVariantMap devCharMap;
+    QString driveUdi;
     if (!ioDVDServices.iOKitPropertyExists(QStringLiteral("Device Characteristics"))) {
         qWarning() << Q_FUNC_INFO << "Grandparent of" << m_device->udi() << "doesn't have the \"Device Characteristics\" but is" << ioDVDServices.udi();
     } else {
         const QVariant devCharVar = ioDVDServices.property(QStringLiteral("Device Characteristics"));
         devCharMap = devCharVar.toMap();
+        driveUdi = ioDVDServices.udi();
     }
-    d = new Private(device, devCharMap);
+    d = new Private(device, driveUdi, devCharMap);
 }
 
 IOKitOpticalDrive::~IOKitOpticalDrive()
@@ -271,6 +289,13 @@ IOKitOpticalDrive::~IOKitOpticalDrive()
 
 Solid::OpticalDrive::MediumTypes IOKitOpticalDrive::supportedMedia() const
 {
+    if (!d->m_driveUdi.isEmpty()) {
+        const auto cached = s_capabilityCache->constFind(d->m_driveUdi);
+        if (cached != s_capabilityCache->constEnd()) {
+            return *cached;
+        }
+    }
+
     Solid::OpticalDrive::MediumTypes supported;
 
     uint32_t cdFeatures = d->property(QStringLiteral("CD Features")).toInt();
@@ -299,6 +324,10 @@ Solid::OpticalDrive::MediumTypes IOKitOpticalDrive::supportedMedia() const
         }
     }
 
+    if (!d->m_driveUdi.isEmpty()) {
+        s_capabilityCache->insert(d->m_driveUdi, supported);
+    }
+
     return supported;
 }
 
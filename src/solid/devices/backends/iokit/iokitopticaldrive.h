@@ -16,6 +16,10 @@ namespace Backends
 {
 namespace IOKit
 {
+/* Drops the probed drive capability sets. Called by the manager on
+ * registry change notifications, which cover media changes. */
+void flushOpticalDriveCapabilityCache();
+
 class IOKitOpticalDrive : public IOKitStorage, virtual public Solid::Ifaces::OpticalDrive
 {
     Q_OBJECT
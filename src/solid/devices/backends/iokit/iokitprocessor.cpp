@@ -64,9 +64,8 @@ bool Processor::canChangeFrequency() const
 Solid::Processor::InstructionSets Processor::instructionSets() const
 {
     // use sysctlbyname() and "machdep.cpu.features" + "machdep.cpu.extfeatures"
-    static Solid::Processor::InstructionSets cpuextensions = Solid::Backends::Shared::cpuFeatures();
-
-    return cpuextensions;
+    // cpuFeatures() caches the detected mask process-wide
+    return Solid::Backends::Shared::cpuFeatures();
 }
 
 QString Processor::vendor()
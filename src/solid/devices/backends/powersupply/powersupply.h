@@ -0,0 +1,13 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef POWERSUPPLY_H
+#define POWERSUPPLY_H
+
+#define PS_UDI_PREFIX "/org/kde/solid/powersupply"
+#define PS_SYSFS_PATH "/sys/class/power_supply"
+
+#endif // POWERSUPPLY_H
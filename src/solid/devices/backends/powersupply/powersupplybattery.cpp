@@ -0,0 +1,327 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "powersupplybattery.h"
+#include "powersupplydevice.h"
+#include "powersupplymonitor.h"
+
+#include <QDateTime>
+
+using namespace Solid::Backends::PowerSupply;
+
+// kernel change uevents arrive every minute or two; this spans roughly a day
+static const int c_historyCapacity = 720;
+
+Battery::Battery(PowerSupplyDevice *device)
+    : QObject(device)
+    , m_device(device)
+{
+    connect(PowerSupplyMonitor::instance(), &PowerSupplyMonitor::deviceChanged, this, &Battery::onDeviceChanged);
+
+    m_refreshTimer.setTimerType(Qt::VeryCoarseTimer);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &Battery::onRefreshTimeout);
+
+    updateCache();
+    recordHistorySample();
+}
+
+Battery::~Battery()
+{
+}
+
+bool Battery::isPresent() const
+{
+    const QByteArray present = m_device->powerSupplyProperty("PRESENT");
+    // most battery entries don't export PRESENT at all; existing means present
+    return present.isEmpty() || present == "1";
+}
+
+Solid::Battery::BatteryType Battery::type() const
+{
+    /* the kernel types everything that stores charge as "Battery"; scope
+     * separates the machine's own supply from peripheral ones */
+    if (m_device->powerSupplyProperty("SCOPE") == "Device") {
+        return Solid::Battery::UnknownBattery;
+    }
+    return Solid::Battery::PrimaryBattery;
+}
+
+int Battery::chargePercent() const
+{
+    return m_device->powerSupplyProperty("CAPACITY").toInt();
+}
+
+int Battery::capacity() const
+{
+    double full = m_device->powerSupplyProperty("ENERGY_FULL").toDouble();
+    double design = m_device->powerSupplyProperty("ENERGY_FULL_DESIGN").toDouble();
+    if (full <= 0 || design <= 0) {
+        full = m_device->powerSupplyProperty("CHARGE_FULL").toDouble();
+        design = m_device->powerSupplyProperty("CHARGE_FULL_DESIGN").toDouble();
+    }
+    if (full <= 0 || design <= 0) {
+        return 100;
+    }
+    return qRound(full / design * 100.0);
+}
+
+bool Battery::isRechargeable() const
+{
+    // a design capacity only makes sense for something meant to be refilled
+    return !m_device->powerSupplyProperty("ENERGY_FULL_DESIGN").isEmpty() //
+        || !m_device->powerSupplyProperty("CHARGE_FULL_DESIGN").isEmpty();
+}
+
+bool Battery::isPowerSupply() const
+{
+    return m_device->powerSupplyProperty("SCOPE") != "Device";
+}
+
+Solid::Battery::ChargeState Battery::chargeState() const
+{
+    const QByteArray status = m_device->powerSupplyProperty("STATUS");
+    if (status == "Charging") {
+        return Solid::Battery::Charging;
+    }
+    if (status == "Discharging") {
+        return Solid::Battery::Discharging;
+    }
+    if (status == "Full") {
+        return Solid::Battery::FullyCharged;
+    }
+    return Solid::Battery::NoCharge;
+}
+
+qlonglong Battery::timeToEmpty() const
+{
+    return m_device->powerSupplyProperty("TIME_TO_EMPTY_NOW").toLongLong();
+}
+
+qlonglong Battery::timeToFull() const
+{
+    return m_device->powerSupplyProperty("TIME_TO_FULL_NOW").toLongLong();
+}
+
+Solid::Battery::Technology Battery::technology() const
+{
+    const QByteArray tech = m_device->powerSupplyProperty("TECHNOLOGY");
+    if (tech == "Li-ion") {
+        return Solid::Battery::LithiumIon;
+    }
+    if (tech == "Li-poly") {
+        return Solid::Battery::LithiumPolymer;
+    }
+    if (tech == "LiFe") {
+        return Solid::Battery::LithiumIronPhosphate;
+    }
+    if (tech == "NiCd") {
+        return Solid::Battery::NickelCadmium;
+    }
+    if (tech == "NiMH") {
+        return Solid::Battery::NickelMetalHydride;
+    }
+    return Solid::Battery::UnknownTechnology;
+}
+
+double Battery::energy() const
+{
+    // ENERGY_* values are in µWh, CHARGE_* in µAh
+    const QByteArray energyNow = m_device->powerSupplyProperty("ENERGY_NOW");
+    if (!energyNow.isEmpty()) {
+        return energyNow.toDouble() / 1e6;
+    }
+    return m_device->powerSupplyProperty("CHARGE_NOW").toDouble() * voltage() / 1e6;
+}
+
+double Battery::energyFull() const
+{
+    const QByteArray energyFull = m_device->powerSupplyProperty("ENERGY_FULL");
+    if (!energyFull.isEmpty()) {
+        return energyFull.toDouble() / 1e6;
+    }
+    return m_device->powerSupplyProperty("CHARGE_FULL").toDouble() * voltage() / 1e6;
+}
+
+double Battery::energyFullDesign() const
+{
+    const QByteArray design = m_device->powerSupplyProperty("ENERGY_FULL_DESIGN");
+    if (!design.isEmpty()) {
+        return design.toDouble() / 1e6;
+    }
+    return m_device->powerSupplyProperty("CHARGE_FULL_DESIGN").toDouble() * voltage() / 1e6;
+}
+
+double Battery::energyRate() const
+{
+    // POWER_NOW is in µW, CURRENT_NOW in µA
+    const QByteArray powerNow = m_device->powerSupplyProperty("POWER_NOW");
+    if (!powerNow.isEmpty()) {
+        return powerNow.toDouble() / 1e6;
+    }
+    return m_device->powerSupplyProperty("CURRENT_NOW").toDouble() * voltage() / 1e6;
+}
+
+double Battery::voltage() const
+{
+    // µV
+    return m_device->powerSupplyProperty("VOLTAGE_NOW").toDouble() / 1e6;
+}
+
+double Battery::temperature() const
+{
+    // tenths of a degree Celsius
+    return m_device->powerSupplyProperty("TEMP").toDouble() / 10.0;
+}
+
+QString Battery::serial() const
+{
+    return QString::fromUtf8(m_device->powerSupplyProperty("SERIAL_NUMBER"));
+}
+
+qlonglong Battery::remainingTime() const
+{
+    if (chargeState() == Solid::Battery::Charging) {
+        return timeToFull();
+    } else if (chargeState() == Solid::Battery::Discharging) {
+        return timeToEmpty();
+    }
+
+    return -1;
+}
+
+QList<Solid::Battery::ChargeSample> Battery::chargeHistory(qlonglong maxAgeSeconds) const
+{
+    if (maxAgeSeconds <= 0) {
+        return m_history;
+    }
+
+    const qint64 cutoff = QDateTime::currentMSecsSinceEpoch() - maxAgeSeconds * 1000;
+    qsizetype first = 0;
+    while (first < m_history.size() && m_history.at(first).timestamp < cutoff) {
+        ++first;
+    }
+    return m_history.mid(first);
+}
+
+void Battery::recordHistorySample()
+{
+    m_history.append({QDateTime::currentMSecsSinceEpoch(), m_chargePercent, m_energyRate});
+    if (m_history.size() > c_historyCapacity) {
+        m_history.removeFirst();
+    }
+}
+
+void Battery::setRefreshInterval(int msecs)
+{
+    if (msecs <= 0) {
+        m_refreshTimer.stop();
+        return;
+    }
+
+    /* some supply drivers update attributes like POWER_NOW without sending
+     * a change uevent, so a periodic re-read is the only way to see those
+     * move; clamp so over-eager clients cannot turn it into busy polling */
+    m_refreshTimer.start(qMax(msecs, 1000));
+}
+
+void Battery::onRefreshTimeout()
+{
+    if (m_device) {
+        onDeviceChanged(m_device->name());
+    }
+}
+
+void Battery::onDeviceChanged(const QString &name)
+{
+    if (!m_device || name != m_device->name()) {
+        return;
+    }
+
+    m_device->refresh();
+
+    const bool old_isPresent = m_isPresent;
+    const int old_chargePercent = m_chargePercent;
+    const int old_capacity = m_capacity;
+    const bool old_isPowerSupply = m_isPowerSupply;
+    const Solid::Battery::ChargeState old_chargeState = m_chargeState;
+    const qlonglong old_timeToEmpty = m_timeToEmpty;
+    const qlonglong old_timeToFull = m_timeToFull;
+    const double old_energy = m_energy;
+    const double old_energyFull = m_energyFull;
+    const double old_energyFullDesign = m_energyFullDesign;
+    const double old_energyRate = m_energyRate;
+    const double old_voltage = m_voltage;
+    const double old_temperature = m_temperature;
+    updateCache();
+
+    if (old_chargePercent != m_chargePercent || old_energyRate != m_energyRate) {
+        recordHistorySample();
+    }
+
+    const QString udi = m_device->udi();
+
+    if (old_isPresent != m_isPresent) {
+        Q_EMIT presentStateChanged(m_isPresent, udi);
+    }
+    if (old_chargePercent != m_chargePercent) {
+        Q_EMIT chargePercentChanged(m_chargePercent, udi);
+    }
+    if (old_capacity != m_capacity) {
+        Q_EMIT capacityChanged(m_capacity, udi);
+    }
+    if (old_isPowerSupply != m_isPowerSupply) {
+        Q_EMIT powerSupplyStateChanged(m_isPowerSupply, udi);
+    }
+    if (old_chargeState != m_chargeState) {
+        Q_EMIT chargeStateChanged(m_chargeState, udi);
+    }
+    if (old_timeToEmpty != m_timeToEmpty) {
+        Q_EMIT timeToEmptyChanged(m_timeToEmpty, udi);
+    }
+    if (old_timeToFull != m_timeToFull) {
+        Q_EMIT timeToFullChanged(m_timeToFull, udi);
+    }
+    if (old_energy != m_energy) {
+        Q_EMIT energyChanged(m_energy, udi);
+    }
+    if (old_energyFull != m_energyFull) {
+        Q_EMIT energyFullChanged(m_energyFull, udi);
+    }
+    if (old_energyFullDesign != m_energyFullDesign) {
+        Q_EMIT energyFullDesignChanged(m_energyFullDesign, udi);
+    }
+    if (old_energyRate != m_energyRate) {
+        Q_EMIT energyRateChanged(m_energyRate, udi);
+    }
+    if (old_voltage != m_voltage) {
+        Q_EMIT voltageChanged(m_voltage, udi);
+    }
+    if (old_temperature != m_temperature) {
+        Q_EMIT temperatureChanged(m_temperature, udi);
+    }
+    if (old_timeToFull != m_timeToFull || old_timeToEmpty != m_timeToEmpty) {
+        Q_EMIT remainingTimeChanged(remainingTime(), udi);
+    }
+}
+
+void Battery::updateCache()
+{
+    m_isPresent = isPresent();
+    m_chargePercent = chargePercent();
+    m_capacity = capacity();
+    m_isPowerSupply = isPowerSupply();
+    m_chargeState = chargeState();
+    m_timeToEmpty = timeToEmpty();
+    m_timeToFull = timeToFull();
+    m_energy = energy();
+    m_energyFull = energyFull();
+    m_energyFullDesign = energyFullDesign();
+    m_energyRate = energyRate();
+    m_voltage = voltage();
+    m_temperature = temperature();
+}
+
+#include "moc_powersupplybattery.cpp"
@@ -0,0 +1,106 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef POWERSUPPLYBATTERY_H
+#define POWERSUPPLYBATTERY_H
+
+#include <solid/devices/ifaces/battery.h>
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace PowerSupply
+{
+class PowerSupplyDevice;
+
+class Battery : public QObject, virtual public Solid::Ifaces::Battery
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::Battery)
+
+public:
+    explicit Battery(PowerSupplyDevice *device);
+    ~Battery() override;
+
+    bool isPresent() const override;
+    Solid::Battery::BatteryType type() const override;
+    int chargePercent() const override;
+    int capacity() const override;
+    bool isRechargeable() const override;
+    bool isPowerSupply() const override;
+    Solid::Battery::ChargeState chargeState() const override;
+    qlonglong timeToEmpty() const override;
+    qlonglong timeToFull() const override;
+    Solid::Battery::Technology technology() const override;
+    double energy() const override;
+    double energyFull() const override;
+    double energyFullDesign() const override;
+    double energyRate() const override;
+    double voltage() const override;
+    double temperature() const override;
+    QString serial() const override;
+    qlonglong remainingTime() const override;
+
+    QList<Solid::Battery::ChargeSample> chargeHistory(qlonglong maxAgeSeconds) const override;
+
+    void setRefreshInterval(int msecs) override;
+
+Q_SIGNALS:
+    void presentStateChanged(bool newState, const QString &udi) override;
+    void chargePercentChanged(int value, const QString &udi = QString()) override;
+    void capacityChanged(int value, const QString &udi) override;
+    void powerSupplyStateChanged(bool newState, const QString &udi) override;
+    void chargeStateChanged(int newState, const QString &udi = QString()) override;
+    void timeToEmptyChanged(qlonglong time, const QString &udi) override;
+    void timeToFullChanged(qlonglong time, const QString &udi) override;
+    void energyChanged(double energy, const QString &udi) override;
+    void energyFullChanged(double energyFull, const QString &udi) override;
+    void energyFullDesignChanged(double energyFullDesign, const QString &udi) override;
+    void energyRateChanged(double energyRate, const QString &udi) override;
+    void voltageChanged(double voltage, const QString &udi) override;
+    void temperatureChanged(double temperature, const QString &udi) override;
+    void remainingTimeChanged(qlonglong time, const QString &udi) override;
+
+private Q_SLOTS:
+    void onDeviceChanged(const QString &name);
+    void onRefreshTimeout();
+
+private:
+    void updateCache();
+    void recordHistorySample();
+
+    QPointer<PowerSupplyDevice> m_device;
+
+    // bounded charge history in sample order, oldest dropped first
+    QList<Solid::Battery::ChargeSample> m_history;
+    // optional periodic re-read, see setRefreshInterval()
+    QTimer m_refreshTimer;
+
+    bool m_isPresent;
+    int m_chargePercent;
+    int m_capacity;
+    bool m_isPowerSupply;
+    Solid::Battery::ChargeState m_chargeState;
+    qlonglong m_timeToEmpty;
+    qlonglong m_timeToFull;
+    double m_energy;
+    double m_energyFull;
+    double m_energyFullDesign;
+    double m_energyRate;
+    double m_voltage;
+    double m_temperature;
+};
+
+}
+}
+}
+
+#endif // POWERSUPPLYBATTERY_H
@@ -0,0 +1,116 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "powersupplydevice.h"
+#include "powersupply.h"
+#include "powersupplybattery.h"
+
+#include "../shared/fastscan.h"
+#include "../shared/sysfsreader.h"
+
+using namespace Solid::Backends::PowerSupply;
+using namespace Solid::Backends;
+
+PowerSupplyDevice::PowerSupplyDevice(const QString &udi)
+    : m_udi(udi)
+    , m_name(udi.section(QLatin1Char('/'), -1))
+{
+    refresh();
+}
+
+PowerSupplyDevice::~PowerSupplyDevice()
+{
+}
+
+bool PowerSupplyDevice::refresh()
+{
+    m_props.clear();
+
+    /* the uevent file carries every attribute the kernel exports for the
+     * supply; one read replaces a stat+open+read per attribute */
+    const Shared::SysfsReader sysfs(QLatin1String(PS_SYSFS_PATH "/") + m_name);
+    const QByteArray uevent = sysfs.read("uevent");
+    Shared::FastScan::forEachToken(QByteArrayView(uevent), '\n', [this](QByteArrayView line) {
+        const auto [key, value] = Shared::FastScan::keyValue(line, '=');
+        if (key.size() != line.size()) {
+            m_props.insert(key.toByteArray(), value.toByteArray());
+        }
+    });
+
+    return !m_props.isEmpty();
+}
+
+QString PowerSupplyDevice::name() const
+{
+    return m_name;
+}
+
+QByteArray PowerSupplyDevice::powerSupplyProperty(const char *name) const
+{
+    return m_props.value(QByteArray("POWER_SUPPLY_") + name);
+}
+
+QString PowerSupplyDevice::udi() const
+{
+    return m_udi;
+}
+
+QString PowerSupplyDevice::parentUdi() const
+{
+    return QStringLiteral(PS_UDI_PREFIX);
+}
+
+QString PowerSupplyDevice::vendor() const
+{
+    return QString::fromUtf8(powerSupplyProperty("MANUFACTURER"));
+}
+
+QString PowerSupplyDevice::product() const
+{
+    const QString model = QString::fromUtf8(powerSupplyProperty("MODEL_NAME"));
+    if (!model.isEmpty()) {
+        return model;
+    }
+    return m_name;
+}
+
+QString PowerSupplyDevice::icon() const
+{
+    if (queryDeviceInterface(Solid::DeviceInterface::Battery)) {
+        return QStringLiteral("battery");
+    }
+    return QString();
+}
+
+QStringList PowerSupplyDevice::emblems() const
+{
+    return QStringList();
+}
+
+QString PowerSupplyDevice::description() const
+{
+    if (queryDeviceInterface(Solid::DeviceInterface::Battery)) {
+        return tr("Battery");
+    }
+    return product();
+}
+
+bool PowerSupplyDevice::queryDeviceInterface(const Solid::DeviceInterface::Type &type) const
+{
+    return type == Solid::DeviceInterface::Battery //
+        && powerSupplyProperty("TYPE") == "Battery";
+}
+
+QObject *PowerSupplyDevice::createDeviceInterface(const Solid::DeviceInterface::Type &type)
+{
+    if (!queryDeviceInterface(type)) {
+        return nullptr;
+    }
+
+    return new Battery(this);
+}
+
+#include "moc_powersupplydevice.cpp"
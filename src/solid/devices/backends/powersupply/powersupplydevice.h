@@ -0,0 +1,60 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef POWERSUPPLYDEVICE_H
+#define POWERSUPPLYDEVICE_H
+
+#include <solid/devices/ifaces/device.h>
+
+#include <QHash>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace PowerSupply
+{
+/**
+ * One /sys/class/power_supply entry, its attributes snapshotted from a
+ * single read of the uevent file.
+ */
+class PowerSupplyDevice : public Solid::Ifaces::Device
+{
+    Q_OBJECT
+
+public:
+    explicit PowerSupplyDevice(const QString &udi);
+    ~PowerSupplyDevice() override;
+
+    QString udi() const override;
+    QString parentUdi() const override;
+    QString vendor() const override;
+    QString product() const override;
+    QString icon() const override;
+    QStringList emblems() const override;
+    QString description() const override;
+
+    bool queryDeviceInterface(const Solid::DeviceInterface::Type &type) const override;
+    QObject *createDeviceInterface(const Solid::DeviceInterface::Type &type) override;
+
+    /** The sysfs entry name (e.g. "BAT0"). */
+    QString name() const;
+    /** Value of POWER_SUPPLY_<name> from the snapshot, empty if absent. */
+    QByteArray powerSupplyProperty(const char *name) const;
+    /** Re-reads the uevent file; returns false when the entry is gone. */
+    bool refresh();
+
+private:
+    QString m_udi;
+    QString m_name;
+    QHash<QByteArray, QByteArray> m_props;
+};
+
+}
+}
+}
+
+#endif // POWERSUPPLYDEVICE_H
@@ -0,0 +1,117 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "powersupplymanager.h"
+#include "../shared/rootdevice.h"
+#include "powersupply.h"
+#include "powersupplydevice.h"
+#include "powersupplymonitor.h"
+
+#include <QDir>
+
+using namespace Solid::Backends::PowerSupply;
+using namespace Solid::Backends::Shared;
+
+PowerSupplyManager::PowerSupplyManager(QObject *parent)
+    : Solid::Ifaces::DeviceManager(parent)
+    , m_deviceList(QDir(QStringLiteral(PS_SYSFS_PATH)).entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+{
+    m_supportedInterfaces << Solid::DeviceInterface::Battery;
+
+    connect(PowerSupplyMonitor::instance(), &PowerSupplyMonitor::deviceAdded, this, &PowerSupplyManager::onDeviceAdded);
+    connect(PowerSupplyMonitor::instance(), &PowerSupplyMonitor::deviceRemoved, this, &PowerSupplyManager::onDeviceRemoved);
+}
+
+PowerSupplyManager::~PowerSupplyManager()
+{
+}
+
+QString PowerSupplyManager::udiPrefix() const
+{
+    return QStringLiteral(PS_UDI_PREFIX);
+}
+
+QSet<Solid::DeviceInterface::Type> PowerSupplyManager::supportedInterfaces() const
+{
+    return m_supportedInterfaces;
+}
+
+QStringList PowerSupplyManager::allDevices()
+{
+    QStringList result;
+
+    result << udiPrefix();
+    for (const QString &device : std::as_const(m_deviceList)) {
+        result << udiPrefix() + QStringLiteral("/") + device;
+    }
+
+    return result;
+}
+
+QStringList PowerSupplyManager::devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
+{
+    if (type != Solid::DeviceInterface::Battery) {
+        return QStringList();
+    }
+
+    if (parentUdi.isEmpty() || parentUdi == udiPrefix()) {
+        QStringList result;
+        for (const QString &device : std::as_const(m_deviceList)) {
+            // non-battery supplies (AC adapters, USB ports) are listed but
+            // answer no interface queries
+            PowerSupplyDevice candidate(udiPrefix() + QStringLiteral("/") + device);
+            if (candidate.queryDeviceInterface(type)) {
+                result << candidate.udi();
+            }
+        }
+        return result;
+    }
+
+    return QStringList();
+}
+
+QObject *PowerSupplyManager::createDevice(const QString &udi)
+{
+    if (udi == udiPrefix()) {
+        RootDevice *root = new RootDevice(udi);
+
+        root->setProduct(tr("Power Supplies"));
+        root->setDescription(tr("Batteries and power supplies reported by the kernel"));
+        root->setIcon(QStringLiteral("battery"));
+
+        return root;
+
+    } else {
+        // global device manager makes sure udi starts with udi prefix + '/'
+        const QString internalName = udi.mid(udiPrefix().length() + 1, -1);
+        if (!m_deviceList.contains(internalName)) {
+            return nullptr;
+        }
+
+        return new PowerSupplyDevice(udi);
+    }
+}
+
+void PowerSupplyManager::onDeviceAdded(const QString &name)
+{
+    if (m_deviceList.contains(name)) {
+        return;
+    }
+
+    m_deviceList << name;
+    Q_EMIT deviceAdded(udiPrefix() + QStringLiteral("/") + name);
+}
+
+void PowerSupplyManager::onDeviceRemoved(const QString &name)
+{
+    if (!m_deviceList.removeOne(name)) {
+        return;
+    }
+
+    Q_EMIT deviceRemoved(udiPrefix() + QStringLiteral("/") + name);
+}
+
+#include "moc_powersupplymanager.cpp"
@@ -0,0 +1,54 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_POWERSUPPLY_POWERSUPPLYMANAGER_H
+#define SOLID_BACKENDS_POWERSUPPLY_POWERSUPPLYMANAGER_H
+
+#include <QSet>
+#include <QStringList>
+#include <solid/deviceinterface.h>
+#include <solid/devices/ifaces/devicemanager.h>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace PowerSupply
+{
+/**
+ * Reads battery state straight from /sys/class/power_supply, with change
+ * notification over the kernel's raw uevent netlink group. Meant for
+ * deployments that want battery queries without the UPower daemon and its
+ * D-Bus round trips; enabled with SOLID_POWER_SUPPLY_BACKEND=1.
+ */
+class PowerSupplyManager : public Solid::Ifaces::DeviceManager
+{
+    Q_OBJECT
+
+public:
+    explicit PowerSupplyManager(QObject *parent);
+    ~PowerSupplyManager() override;
+
+    QString udiPrefix() const override;
+    QSet<Solid::DeviceInterface::Type> supportedInterfaces() const override;
+    QStringList allDevices() override;
+    QStringList devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type) override;
+    QObject *createDevice(const QString &udi) override;
+
+private Q_SLOTS:
+    void onDeviceAdded(const QString &name);
+    void onDeviceRemoved(const QString &name);
+
+private:
+    QSet<Solid::DeviceInterface::Type> m_supportedInterfaces;
+    QStringList m_deviceList;
+};
+
+}
+}
+}
+
+#endif
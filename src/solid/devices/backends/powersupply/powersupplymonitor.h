@@ -0,0 +1,55 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef POWERSUPPLYMONITOR_H
+#define POWERSUPPLYMONITOR_H
+
+#include <QObject>
+
+class QSocketNotifier;
+
+namespace Solid
+{
+namespace Backends
+{
+namespace PowerSupply
+{
+/**
+ * Kernel uevent listener for the power_supply subsystem. This goes
+ * straight to the NETLINK_KOBJECT_UEVENT broadcast group, so change
+ * notification works without udevd or any D-Bus daemon — the whole point
+ * of this backend.
+ */
+class PowerSupplyMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    static PowerSupplyMonitor *instance();
+
+    PowerSupplyMonitor();
+    ~PowerSupplyMonitor() override;
+
+    bool isValid() const;
+
+Q_SIGNALS:
+    void deviceAdded(const QString &name);
+    void deviceRemoved(const QString &name);
+    void deviceChanged(const QString &name);
+
+private Q_SLOTS:
+    void onUevent();
+
+private:
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+};
+
+}
+}
+}
+
+#endif // POWERSUPPLYMONITOR_H
@@ -18,6 +18,11 @@
 #endif
 #include <config-processor.h>
 
+#if defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
 #if defined(__GNUC__) || defined(__INTEL_COMPILER)
 #  define HAVE_GNU_INLINE_ASM
 #endif
@@ -80,7 +85,7 @@ static void sigill_handler(int sig)
 }
 #endif
 
-Solid::Processor::InstructionSets cpuFeatures()
+static Solid::Processor::InstructionSets detectCpuFeatures()
 {
     volatile unsigned int features = 0;
 
@@ -220,9 +225,74 @@ Solid::Processor::InstructionSets cpuFeatures()
         featureflags |= Solid::Processor::AltiVec;
     }
 
+    // The feature words above date from when MMX..SSE4 was the interesting
+    // range; the newer vector extensions are queried separately.
+#if defined(HAVE_GNU_INLINE_ASM) && (defined(__i386__) || defined(__x86_64__))
+    // The compiler runtime does the CPUID leaf 7 and XGETBV dance for us,
+    // including the OS state-saving check that AVX requires.
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx")) {
+        featureflags |= Solid::Processor::IntelAvx;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        featureflags |= Solid::Processor::IntelAvx2;
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        featureflags |= Solid::Processor::IntelAvx512;
+    }
+#elif defined(_MSC_VER)
+    // AVX needs the OS to save the ymm state: OSXSAVE and an XGETBV check
+    // on top of the plain CPUID bits
+    if ((array[2] & 0x18000000) == 0x18000000
+            && (_xgetbv(_XCR_XFEATURE_ENABLED_MASK) & 0x6) == 0x6) {
+        featureflags |= Solid::Processor::IntelAvx;
+
+        int maxLeaf[4];
+        __cpuid(maxLeaf, 0);
+        if (maxLeaf[0] >= 7) {
+            int leaf7[4];
+            __cpuidex(leaf7, 7, 0);
+            if (leaf7[1] & 0x00000020) {
+                featureflags |= Solid::Processor::IntelAvx2;
+            }
+            // AVX-512 additionally needs the opmask and zmm state saved
+            if ((leaf7[1] & 0x00010000)
+                    && (_xgetbv(_XCR_XFEATURE_ENABLED_MASK) & 0xe6) == 0xe6) {
+                featureflags |= Solid::Processor::IntelAvx512;
+            }
+        }
+    }
+#elif defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+    // the ELF hwcaps are the kernel's word on what userspace may use
+    const unsigned long hwcaps = getauxval(AT_HWCAP);
+#if defined(__aarch64__)
+    if (hwcaps & HWCAP_ASIMD) {
+        featureflags |= Solid::Processor::ArmNeon;
+    }
+#ifdef HWCAP_SVE
+    if (hwcaps & HWCAP_SVE) {
+        featureflags |= Solid::Processor::ArmSve;
+    }
+#endif
+#elif defined(HWCAP_NEON)
+    if (hwcaps & HWCAP_NEON) {
+        featureflags |= Solid::Processor::ArmNeon;
+    }
+#endif
+#endif
+
     return featureflags;
 }
 
+Solid::Processor::InstructionSets cpuFeatures()
+{
+    // Detection involves CPUID sequences and, on some paths, installing a
+    // SIGILL handler; run it once per process no matter how many Processor
+    // devices ask, and hand out the cached mask afterwards.
+    static const Solid::Processor::InstructionSets s_features = detectCpuFeatures();
+    return s_features;
+}
+
 }
 }
 }
@@ -0,0 +1,158 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "devicesnapshot.h"
+
+#include <QDataStream>
+#include <QIODevice>
+
+#include <unistd.h>
+
+using namespace Solid::Backends::Shared;
+
+static const quint32 kSnapshotMagic = 0x53444331; // "SDC1"
+static const quint32 kSnapshotFormat = 1;
+
+QString DeviceSnapshot::sharedMemoryKey()
+{
+    // per-user: shared memory keys and local sockets are both global namespaces
+    return QStringLiteral("solid-device-cache-%1").arg(::geteuid());
+}
+
+QString DeviceSnapshot::serverName()
+{
+    return QStringLiteral("solid-device-cache-%1").arg(::geteuid());
+}
+
+QByteArray DeviceSnapshot::serialize(const QList<SnapshotDevice> &devices, quint64 generation)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_5);
+
+    stream << kSnapshotMagic << kSnapshotFormat << generation << quint32(devices.size());
+
+    for (const SnapshotDevice &device : devices) {
+        stream << device.udi //
+               << device.parentUdi //
+               << device.vendor //
+               << device.product //
+               << device.icon //
+               << device.description //
+               << device.emblems //
+               << device.interfaceTypes //
+               << device.properties;
+    }
+
+    return payload;
+}
+
+bool DeviceSnapshot::deserialize(const QByteArray &payload, QList<SnapshotDevice> *devices, quint64 *generation)
+{
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_6_5);
+
+    quint32 magic = 0;
+    quint32 format = 0;
+    quint64 gen = 0;
+    quint32 count = 0;
+    stream >> magic >> format >> gen >> count;
+
+    if (magic != kSnapshotMagic || format != kSnapshotFormat) {
+        return false;
+    }
+
+    QList<SnapshotDevice> result;
+    result.reserve(count);
+    for (quint32 i = 0; i < count; ++i) {
+        SnapshotDevice device;
+        stream >> device.udi //
+            >> device.parentUdi //
+            >> device.vendor //
+            >> device.product //
+            >> device.icon //
+            >> device.description //
+            >> device.emblems //
+            >> device.interfaceTypes //
+            >> device.properties;
+        if (stream.status() != QDataStream::Ok) {
+            return false;
+        }
+        result.append(device);
+    }
+
+    *devices = result;
+    if (generation) {
+        *generation = gen;
+    }
+    return true;
+}
+
+QByteArray DeviceSnapshot::fetch()
+{
+    /* Attach fresh every time: the daemon replaces the segment (same key,
+     * bigger size) when a snapshot outgrows it, and a kept attachment would
+     * silently keep reading the orphaned old one. Fetches only happen at
+     * startup and on change notifications, so this stays off any hot path. */
+    QSharedMemory segment(sharedMemoryKey());
+    if (!segment.attach(QSharedMemory::ReadOnly)) {
+        return QByteArray();
+    }
+
+    QByteArray payload;
+    if (segment.lock()) {
+        const char *data = static_cast<const char *>(segment.constData());
+        quint64 size = 0;
+        memcpy(&size, data, sizeof(size));
+        if (size > 0 && size <= quint64(segment.size()) - sizeof(size)) {
+            payload = QByteArray(data + sizeof(size), size);
+        }
+        segment.unlock();
+    }
+
+    return payload;
+}
+
+DeviceSnapshotWriter::DeviceSnapshotWriter()
+{
+    m_segment.setKey(DeviceSnapshot::sharedMemoryKey());
+}
+
+DeviceSnapshotWriter::~DeviceSnapshotWriter()
+{
+    // detaching as the last holder removes the segment
+}
+
+bool DeviceSnapshotWriter::publish(const QByteArray &payload)
+{
+    const quint64 needed = sizeof(quint64) + payload.size();
+
+    if (m_segment.isAttached() && quint64(m_segment.size()) < needed) {
+        m_segment.detach();
+    }
+
+    if (!m_segment.isAttached()) {
+        // leave headroom so routine hotplug doesn't churn the segment
+        if (!m_segment.create(qMax<quint64>(needed * 2, 64 * 1024))) {
+            // a stale segment from a crashed daemon may linger; adopt it
+            if (!m_segment.attach() || quint64(m_segment.size()) < needed) {
+                return false;
+            }
+        }
+    }
+
+    if (!m_segment.lock()) {
+        return false;
+    }
+
+    char *data = static_cast<char *>(m_segment.data());
+    const quint64 size = payload.size();
+    memcpy(data, &size, sizeof(size));
+    memcpy(data + sizeof(size), payload.constData(), payload.size());
+    m_segment.unlock();
+
+    return true;
+}
@@ -0,0 +1,84 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_SHARED_DEVICESNAPSHOT_H
+#define SOLID_BACKENDS_SHARED_DEVICESNAPSHOT_H
+
+#include <QByteArray>
+#include <QList>
+#include <QSharedMemory>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Shared
+{
+/**
+ * One device as captured by solid-cache-daemon6: everything the frontend
+ * asks a backend for, minus the operations (mounting, ejecting) that have
+ * to go to the real services anyway.
+ *
+ * The property map is keyed "<interface>.<property>" (for example
+ * "storagedrive.bus"); the full GenericInterface map is stored as a
+ * nested map under "genericProperties".
+ */
+struct SnapshotDevice {
+    QString udi;
+    QString parentUdi;
+    QString vendor;
+    QString product;
+    QString icon;
+    QString description;
+    QStringList emblems;
+    QList<int> interfaceTypes;
+    QVariantMap properties;
+};
+
+/**
+ * Serialization and shared-memory transport for the device snapshot
+ * published by solid-cache-daemon6 and consumed by the cached backend.
+ *
+ * The segment holds a length-prefixed QDataStream payload; readers copy
+ * it out under the segment lock and deserialize locally, so a publisher
+ * swapping generations underneath them can never be observed half-way.
+ */
+namespace DeviceSnapshot
+{
+QString sharedMemoryKey();
+QString serverName();
+
+QByteArray serialize(const QList<SnapshotDevice> &devices, quint64 generation);
+bool deserialize(const QByteArray &payload, QList<SnapshotDevice> *devices, quint64 *generation);
+
+/** Reads the current payload out of the shared segment, empty on failure. */
+QByteArray fetch();
+}
+
+/**
+ * Owns the shared-memory segment on the daemon side. The segment is
+ * recreated (never resized in place) when a payload outgrows it, which
+ * readers handle by re-attaching on every fetch.
+ */
+class DeviceSnapshotWriter
+{
+public:
+    DeviceSnapshotWriter();
+    ~DeviceSnapshotWriter();
+
+    bool publish(const QByteArray &payload);
+
+private:
+    QSharedMemory m_segment;
+};
+}
+}
+}
+
+#endif
@@ -0,0 +1,71 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_SHARED_FASTSCAN_H
+#define SOLID_BACKENDS_SHARED_FASTSCAN_H
+
+#include <QByteArrayView>
+
+#include <cstring>
+#include <utility>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Shared
+{
+/**
+ * Scanning helpers for the hot text parsers (procfs contents, fstab option
+ * strings). Tokens are QByteArrayView slices of the caller's read buffer
+ * and separator search goes through memchr, which libc vectorizes; nothing
+ * in here allocates.
+ */
+namespace FastScan
+{
+/**
+ * Calls @p fn with a QByteArrayView for every token of @p data delimited
+ * by @p sep. Empty tokens are passed through, so the caller sees exactly
+ * the split positions.
+ */
+template<typename F>
+inline void forEachToken(QByteArrayView data, char sep, F &&fn)
+{
+    const char *it = data.constData();
+    const char *const end = it + data.size();
+    while (it < end) {
+        const char *sepPos = static_cast<const char *>(memchr(it, sep, end - it));
+        if (!sepPos) {
+            sepPos = end;
+        }
+        fn(QByteArrayView(it, sepPos - it));
+        it = sepPos + 1;
+    }
+}
+
+/**
+ * Splits @p token at the first @p sep into a key/value pair of views. When
+ * @p sep is absent the key spans the whole token and the value is empty —
+ * distinguishable from a present-but-empty value by the key covering
+ * token.size() characters.
+ */
+inline std::pair<QByteArrayView, QByteArrayView> keyValue(QByteArrayView token, char sep)
+{
+    const char *sepPos = token.isEmpty() ? nullptr : static_cast<const char *>(memchr(token.constData(), sep, token.size()));
+    if (!sepPos) {
+        return {token, QByteArrayView()};
+    }
+
+    const qsizetype at = sepPos - token.constData();
+    return {token.left(at), token.mid(at + 1)};
+}
+
+}
+}
+}
+}
+
+#endif
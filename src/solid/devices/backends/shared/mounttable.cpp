@@ -0,0 +1,167 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "mounttable.h"
+
+#include <QAtomicInteger>
+#include <QFile>
+#include <QMutex>
+#include <QThreadStorage>
+
+#include <solid/config-solid.h>
+
+#if HAVE_LIBMOUNT
+#include <libmount/libmount.h>
+#endif
+
+// This is the *BSD branch
+#if HAVE_SYS_MOUNT_H
+#if HAVE_SYS_TYPES_H
+#include <sys/types.h>
+#endif
+#if HAVE_SYS_PARAM_H
+#include <sys/param.h>
+#endif
+#include <sys/mount.h>
+#endif
+
+using namespace Solid::Backends::Shared;
+
+namespace
+{
+struct MountTableCache {
+    QMutex mutex;
+    // the currently published version; replaced wholesale, never mutated
+    MountTable::Snapshot snapshot;
+    // bumped on every invalidation; readers compare it against their
+    // thread-local view without taking the mutex
+    QAtomicInteger<quint64> generation = 1;
+};
+
+// per-thread view of the published snapshot, so steady-state readers cost
+// one atomic load instead of a mutex round trip
+struct ThreadView {
+    quint64 generation = 0;
+    MountTable::Snapshot snapshot;
+};
+}
+
+Q_GLOBAL_STATIC(MountTableCache, s_mountTableCache)
+Q_GLOBAL_STATIC(QThreadStorage<ThreadView *>, s_threadView)
+
+static QList<MountTableEntry> parseMountTable()
+{
+    QList<MountTableEntry> entries;
+
+#if HAVE_GETMNTINFO
+
+#if GETMNTINFO_USES_STATVFS
+    struct statvfs *mounted;
+#else
+    struct statfs *mounted;
+#endif
+
+    int num_fs = getmntinfo(&mounted, MNT_NOWAIT);
+
+    entries.reserve(num_fs);
+    for (int i = 0; i < num_fs; i++) {
+        MountTableEntry entry;
+        entry.source = QFile::decodeName(mounted[i].f_mntfromname);
+        entry.target = QFile::decodeName(mounted[i].f_mntonname);
+        entry.fstype = QFile::decodeName(mounted[i].f_fstypename);
+        entry.root = QByteArrayLiteral("/");
+        entries.append(entry);
+    }
+
+#elif HAVE_LIBMOUNT
+
+    struct libmnt_table *table = mnt_new_table();
+    if (!table) {
+        return entries;
+    }
+
+    // parses /etc/mtab if present, /proc/self/mountinfo otherwise
+    if (mnt_table_parse_mtab(table, NULL) != 0) {
+        mnt_free_table(table);
+        return entries;
+    }
+
+    struct libmnt_iter *itr = mnt_new_iter(MNT_ITER_FORWARD);
+    struct libmnt_fs *fs;
+
+    while (mnt_table_next_fs(table, itr, &fs) == 0) {
+        MountTableEntry entry;
+        entry.source = QFile::decodeName(mnt_fs_get_srcpath(fs));
+        entry.target = QFile::decodeName(mnt_fs_get_target(fs));
+        entry.fstype = QFile::decodeName(mnt_fs_get_fstype(fs));
+        if (char *options = mnt_fs_strdup_options(fs)) {
+            entry.options = QByteArray(options);
+            free(options);
+        }
+        if (const char *root = mnt_fs_get_root(fs)) {
+            entry.root = QByteArray(root);
+        } else {
+            entry.root = QByteArrayLiteral("/");
+        }
+        entries.append(entry);
+    }
+
+    mnt_free_iter(itr);
+    mnt_free_table(table);
+
+#endif
+
+    return entries;
+}
+
+MountTable::Snapshot MountTable::current()
+{
+    MountTableCache *cache = s_mountTableCache();
+
+    if (!s_threadView()->hasLocalData()) {
+        s_threadView()->setLocalData(new ThreadView);
+    }
+    ThreadView *view = s_threadView()->localData();
+
+    /* steady state: one atomic load and no lock, so a mount storm being
+     * published on another thread never blocks this reader; at worst it
+     * still sees the version published before the concurrent invalidation,
+     * which is inherent to reading a snapshot */
+    if (view->snapshot && view->generation == cache->generation.loadAcquire()) {
+        return view->snapshot;
+    }
+
+    {
+        QMutexLocker locker(&cache->mutex);
+        if (cache->snapshot) {
+            view->snapshot = cache->snapshot;
+            view->generation = cache->generation.loadAcquire();
+            return view->snapshot;
+        }
+    }
+
+    /* parse off to the side; consumers of the previous version keep
+     * reading their own immutable copy */
+    auto entries = QSharedPointer<const QList<MountTableEntry>>::create(parseMountTable());
+
+    QMutexLocker locker(&cache->mutex);
+    if (!cache->snapshot) {
+        cache->snapshot = entries;
+    }
+    view->snapshot = cache->snapshot;
+    view->generation = cache->generation.loadAcquire();
+    return view->snapshot;
+}
+
+void MountTable::invalidate()
+{
+    MountTableCache *cache = s_mountTableCache();
+    QMutexLocker locker(&cache->mutex);
+    cache->snapshot.reset();
+    // retire the published version; the thread-local views notice on
+    // their next read
+    cache->generation.fetchAndAddRelease(1);
+}
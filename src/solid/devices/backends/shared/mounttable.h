@@ -0,0 +1,69 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_SHARED_MOUNTTABLE_H
+#define SOLID_BACKENDS_SHARED_MOUNTTABLE_H
+
+#include <QByteArray>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Shared
+{
+/**
+ * One line of the currently mounted filesystems table.
+ */
+struct MountTableEntry {
+    /** The mounted device node or remote share. */
+    QString source;
+    /** The mount point. */
+    QString target;
+    QString fstype;
+    /** Raw option string; empty where the platform API does not expose it. */
+    QByteArray options;
+    /** Root of the mount within the filesystem: "/" except for bind mounts. */
+    QByteArray root;
+};
+
+/**
+ * Process-wide snapshot cache of the mount table.
+ *
+ * The fstab backend and the UDisks2 backend both need the mounted
+ * filesystems — one for network shares and FUSE mounts, the other to
+ * resolve the base mount point of bind-mounted volumes. Each used to run
+ * its own parser over the same kernel table. This cache parses it once
+ * and hands every consumer the same immutable snapshot until a mount
+ * event handler calls invalidate().
+ *
+ * Versions are published RCU-style: a new snapshot is built off to the
+ * side and swapped in whole, and readers go through a thread-local view
+ * revalidated by an atomic generation check. In steady state a reader
+ * costs one atomic load and never contends with a writer.
+ */
+namespace MountTable
+{
+using Snapshot = QSharedPointer<const QList<MountTableEntry>>;
+
+/**
+ * The current table, parsed on demand if no valid snapshot exists.
+ * Never null; empty when no parser is available on this platform.
+ * Thread-safe.
+ */
+Snapshot current();
+
+/** Drops the cached snapshot; the next current() call re-parses. */
+void invalidate();
+}
+}
+}
+}
+
+#endif
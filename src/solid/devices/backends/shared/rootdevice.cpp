@@ -80,6 +80,17 @@ void RootDevice::setDescription(const QString &description)
     m_description = description;
 }
 
+RootDevice *RootDevice::clone() const
+{
+    RootDevice *device = new RootDevice(m_udi, m_parentUdi);
+    device->m_vendor = m_vendor;
+    device->m_product = m_product;
+    device->m_icon = m_icon;
+    device->m_emblems = m_emblems;
+    device->m_description = m_description;
+    return device;
+}
+
 bool RootDevice::queryDeviceInterface(const Solid::DeviceInterface::Type &) const
 {
     return false;
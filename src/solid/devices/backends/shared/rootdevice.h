@@ -46,6 +46,13 @@ public:
 
     bool queryDeviceInterface(const Solid::DeviceInterface::Type &type) const override;
 
+    /**
+     * A copy of this device sharing its string data; lets managers keep a
+     * configured prototype and hand out per-request instances without
+     * re-running the translation calls.
+     */
+    RootDevice *clone() const;
+
     QObject *createDeviceInterface(const Solid::DeviceInterface::Type &type) override;
 
 private:
@@ -0,0 +1,63 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "sysfsreader.h"
+
+#include <QFile>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace Solid::Backends::Shared;
+
+SysfsReader::SysfsReader(const QString &sysfsPath)
+    : m_fd(::open(QFile::encodeName(sysfsPath).constData(), O_RDONLY | O_CLOEXEC | O_DIRECTORY))
+{
+}
+
+SysfsReader::~SysfsReader()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+bool SysfsReader::isValid() const
+{
+    return m_fd >= 0;
+}
+
+bool SysfsReader::exists(const char *attribute) const
+{
+    return m_fd >= 0 && ::faccessat(m_fd, attribute, F_OK, 0) == 0;
+}
+
+QByteArray SysfsReader::read(const char *attribute) const
+{
+    if (m_fd < 0) {
+        return QByteArray();
+    }
+
+    const int fd = ::openat(m_fd, attribute, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return QByteArray();
+    }
+
+    // sysfs attribute values fit in one page
+    char buffer[4096];
+    ssize_t size;
+    do {
+        size = ::read(fd, buffer, sizeof(buffer));
+    } while (size < 0 && errno == EINTR);
+    ::close(fd);
+
+    if (size <= 0) {
+        return QByteArray();
+    }
+
+    return QByteArray(buffer, size).trimmed();
+}
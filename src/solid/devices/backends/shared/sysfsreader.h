@@ -0,0 +1,48 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_SHARED_SYSFSREADER_H
+#define SOLID_BACKENDS_SHARED_SYSFSREADER_H
+
+#include <QByteArray>
+#include <QString>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace Shared
+{
+/**
+ * Batched reader for one sysfs device directory. The directory is opened
+ * once and attribute existence checks and reads go through *at() calls
+ * against that descriptor, so probing several attributes of a device costs
+ * a single path resolution instead of one per attribute.
+ */
+class SysfsReader
+{
+public:
+    explicit SysfsReader(const QString &sysfsPath);
+    ~SysfsReader();
+
+    SysfsReader(const SysfsReader &) = delete;
+    SysfsReader &operator=(const SysfsReader &) = delete;
+
+    bool isValid() const;
+    /** Whether @p attribute exists below the device directory. */
+    bool exists(const char *attribute) const;
+    /** Contents of @p attribute, trimmed; empty if absent or unreadable. */
+    QByteArray read(const char *attribute) const;
+
+private:
+    int m_fd = -1;
+};
+
+}
+}
+}
+
+#endif
@@ -12,6 +12,8 @@ extern "C" {
 #include <libudev.h>
 }
 
+#include <QHash>
+
 class QByteArray;
 class QSocketNotifier;
 
@@ -27,6 +29,9 @@ public:
     QString decodePropertyValue(const QByteArray &encoded) const;
 
     struct udev_device *udev;
+    /* lazily composed and then shared; see Device::sysfsPath()/udi() */
+    mutable QString sysfsPathCache;
+    mutable QString udiCache;
 };
 
 class Client;
@@ -40,14 +45,20 @@ public:
 
     void init(const QStringList &subsystemList, ListenToWhat what);
     void setWatchedSubsystems(const QStringList &subsystemList);
+    void stopWatching();
     void dispatchEvent();
     DeviceList deviceListFromEnumerate(struct udev_enumerate *en);
+    void maybeSnapshot(const QString &sysfsPath, const Device &device);
 
     struct udev *udev;
     struct udev_monitor *monitor;
     Client *q;
     QSocketNotifier *monitorNotifier;
     QStringList watchedSubsystems;
+    /* Snapshots of devices in watched subsystems, keyed by sysfs path and
+     * kept fresh by the monitor events; enumerations and path lookups hand
+     * out the shared snapshot instead of re-reading sysfs. */
+    QHash<QString, Device> snapshots;
 };
 
 inline QStringList listFromListEntry(struct udev_list_entry *list)
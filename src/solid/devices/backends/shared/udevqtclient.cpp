@@ -12,6 +12,8 @@
 #include <QSocketNotifier>
 #include <qplatformdefs.h>
 
+#include <cerrno>
+
 namespace UdevQt
 {
 ClientPrivate::ClientPrivate(Client *q_)
@@ -64,6 +66,13 @@ void ClientPrivate::setWatchedSubsystems(const QStringList &subsystemList)
         }
     }
 
+    /* A coldplug storm can queue hundreds of events before the event loop
+     * drains them, and the default netlink buffer silently drops whatever
+     * does not fit. Ask for a generous buffer (best effort; may be capped
+     * by rmem_max without privileges) and rely on the ENOBUFS detection in
+     * dispatchEvent() for whatever still overruns. */
+    udev_monitor_set_receive_buffer_size(newM, 8 * 1024 * 1024);
+
     // start the new monitor receiving
     udev_monitor_enable_receiving(newM);
     QSocketNotifier *sn = new QSocketNotifier(udev_monitor_get_fd(newM), QSocketNotifier::Read);
@@ -71,11 +80,12 @@ void ClientPrivate::setWatchedSubsystems(const QStringList &subsystemList)
         dispatchEvent();
     });
 
-    // kill any previous monitor
+    // kill any previous monitor, along with the snapshots it kept fresh
     delete monitorNotifier;
     if (monitor) {
         udev_monitor_unref(monitor);
     }
+    snapshots.clear();
 
     // and save our new one
     monitor = newM;
@@ -83,35 +93,82 @@ void ClientPrivate::setWatchedSubsystems(const QStringList &subsystemList)
     watchedSubsystems = subsystemList;
 }
 
+void ClientPrivate::stopWatching()
+{
+    delete monitorNotifier;
+    monitorNotifier = nullptr;
+
+    if (monitor) {
+        udev_monitor_unref(monitor);
+        monitor = nullptr;
+    }
+
+    // without the monitor nothing keeps them fresh
+    snapshots.clear();
+    watchedSubsystems.clear();
+}
+
 void ClientPrivate::dispatchEvent()
 {
+    /* Drain the monitor before emitting anything: the netlink socket is
+     * non-blocking, so keep reading until it is empty. A hotplug storm then
+     * costs one event-loop wakeup for the whole batch instead of one per
+     * device, and the kernel-side buffer is emptied before it can overrun. */
     monitorNotifier->setEnabled(false);
-    struct udev_device *dev = udev_monitor_receive_device(monitor);
+    bool overflowed = false;
+    QList<std::pair<Device, QByteArray>> batch;
+    for (;;) {
+        errno = 0;
+        struct udev_device *dev = udev_monitor_receive_device(monitor);
+        if (!dev) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == ENOBUFS) {
+                // the kernel dropped events; whatever we read next is incomplete
+                overflowed = true;
+                continue;
+            }
+            break;
+        }
+        batch.emplace_back(Device(new DevicePrivate(dev, false)), QByteArray(udev_device_get_action(dev)));
+    }
     monitorNotifier->setEnabled(true);
 
-    if (!dev) {
-        return;
+    for (const auto &[device, action] : std::as_const(batch)) {
+        /* event devices carry the current property state, so they refresh
+         * (or retire) the snapshot before anyone re-queries it */
+        if (action == "remove") {
+            snapshots.remove(device.sysfsPath());
+        } else {
+            maybeSnapshot(device.sysfsPath(), device);
+        }
+
+        if (action == "add") {
+            Q_EMIT q->deviceAdded(device);
+        } else if (action == "remove") {
+            Q_EMIT q->deviceRemoved(device);
+        } else if (action == "change") {
+            Q_EMIT q->deviceChanged(device);
+        } else if (action == "online") {
+            Q_EMIT q->deviceOnlined(device);
+        } else if (action == "offline") {
+            Q_EMIT q->deviceOfflined(device);
+        } else if (action == "bind") {
+            Q_EMIT q->deviceBound(device);
+        } else if (action == "unbind") {
+            Q_EMIT q->deviceUnbound(device);
+        } else {
+            qCDebug(Solid::Frontend::DeviceManager::DEVICEMANAGER) << "UdevQt: unhandled action:" << action.constData() << "for device:" << device.sysfsPath();
+        }
     }
 
-    Device device(new DevicePrivate(dev, false));
-
-    QByteArray action(udev_device_get_action(dev));
-    if (action == "add") {
-        Q_EMIT q->deviceAdded(device);
-    } else if (action == "remove") {
-        Q_EMIT q->deviceRemoved(device);
-    } else if (action == "change") {
-        Q_EMIT q->deviceChanged(device);
-    } else if (action == "online") {
-        Q_EMIT q->deviceOnlined(device);
-    } else if (action == "offline") {
-        Q_EMIT q->deviceOfflined(device);
-    } else if (action == "bind") {
-        Q_EMIT q->deviceBound(device);
-    } else if (action == "unbind") {
-        Q_EMIT q->deviceUnbound(device);
-    } else {
-        qCDebug(Solid::Frontend::DeviceManager::DEVICEMANAGER) << "UdevQt: unhandled action:" << action.constData() << "for device:" << device.sysfsPath();
+    if (overflowed) {
+        /* the snapshots missed the dropped events, and so did our listeners;
+         * turn the silent staleness into an explicit resync request */
+        qCWarning(Solid::Frontend::DeviceManager::DEVICEMANAGER) << "UdevQt: netlink receive buffer overran, requesting re-enumeration";
+        snapshots.clear();
+        Q_EMIT q->monitorOverflowed();
     }
 }
 
@@ -125,13 +182,22 @@ DeviceList ClientPrivate::deviceListFromEnumerate(struct udev_enumerate *en)
     list = udev_enumerate_get_list_entry(en);
     udev_list_entry_foreach(entry, list)
     {
+        const QString path = QString::fromLatin1(udev_list_entry_get_name(entry));
+        const auto it = snapshots.constFind(path);
+        if (it != snapshots.constEnd()) {
+            ret << it.value();
+            continue;
+        }
+
         struct udev_device *ud = udev_device_new_from_syspath(udev_enumerate_get_udev(en), udev_list_entry_get_name(entry));
 
         if (!ud) {
             continue;
         }
 
-        ret << Device(new DevicePrivate(ud, false));
+        const Device device(new DevicePrivate(ud, false));
+        maybeSnapshot(path, device);
+        ret << device;
     }
 
     udev_enumerate_unref(en);
@@ -139,6 +205,18 @@ DeviceList ClientPrivate::deviceListFromEnumerate(struct udev_enumerate *en)
     return ret;
 }
 
+void ClientPrivate::maybeSnapshot(const QString &sysfsPath, const Device &device)
+{
+    /* Only devices whose subsystem the monitor watches are cacheable: their
+     * every change arrives as an event that refreshes the entry, while
+     * anything else would go stale unnoticed. */
+    if (!monitor || !watchedSubsystems.contains(device.subsystemView())) {
+        return;
+    }
+
+    snapshots.insert(sysfsPath, device);
+}
+
 Client::Client(QObject *parent)
     : QObject(parent)
     , d(new ClientPrivate(this))
@@ -184,6 +262,11 @@ void Client::setWatchedSubsystems(const QStringList &subsystemList)
     d->setWatchedSubsystems(subsystemList);
 }
 
+void Client::stopWatching()
+{
+    d->stopWatching();
+}
+
 DeviceList Client::devicesByProperty(const QString &property, const QVariant &value)
 {
     struct udev_enumerate *en = udev_enumerate_new(d->udev);
@@ -255,13 +338,20 @@ Device Client::deviceByDeviceFile(const QString &deviceFile)
 
 Device Client::deviceBySysfsPath(const QString &sysfsPath)
 {
+    const auto it = d->snapshots.constFind(sysfsPath);
+    if (it != d->snapshots.constEnd()) {
+        return it.value();
+    }
+
     struct udev_device *ud = udev_device_new_from_syspath(d->udev, sysfsPath.toLatin1().constData());
 
     if (!ud) {
         return Device();
     }
 
-    return Device(new DevicePrivate(ud, false));
+    const Device device(new DevicePrivate(ud, false));
+    d->maybeSnapshot(sysfsPath, device);
+    return device;
 }
 
 Device Client::deviceBySubsystemAndName(const QString &subsystem, const QString &name)
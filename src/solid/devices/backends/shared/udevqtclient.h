@@ -30,6 +30,12 @@ public:
 
     QStringList watchedSubsystems() const;
     void setWatchedSubsystems(const QStringList &subsystemList);
+    /**
+     * Tears the netlink monitor down again, along with the snapshots it
+     * kept fresh. Note this is different from setting an empty watch list,
+     * which means listening to every subsystem.
+     */
+    void stopWatching();
 
     DeviceList allDevices();
     DeviceList devicesByProperty(const QString &property, const QVariant &value);
@@ -52,6 +58,12 @@ Q_SIGNALS:
     void deviceOfflined(const UdevQt::Device &dev);
     void deviceBound(const UdevQt::Device &dev);
     void deviceUnbound(const UdevQt::Device &dev);
+    /**
+     * The kernel dropped events because the netlink receive buffer overran,
+     * so the per-device signals above are incomplete; holders of device
+     * state should re-enumerate.
+     */
+    void monitorOverflowed();
 
 private:
     friend class ClientPrivate;
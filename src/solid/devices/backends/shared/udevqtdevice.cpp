@@ -28,6 +28,8 @@ DevicePrivate &DevicePrivate::operator=(const DevicePrivate &other)
 {
     udev_device_unref(udev);
     udev = udev_device_ref(other.udev);
+    sysfsPathCache = other.sysfsPathCache;
+    udiCache = other.udiCache;
     return *this;
 }
 
@@ -70,6 +72,8 @@ Device::Device(const Device &other)
 {
     if (other.d) {
         d = new DevicePrivate(other.d->udev);
+        d->sysfsPathCache = other.d->sysfsPathCache;
+        d->udiCache = other.d->udiCache;
     } else {
         d = nullptr;
     }
@@ -142,7 +146,23 @@ QString Device::sysfsPath() const
         return QString();
     }
 
-    return QString::fromLatin1(udev_device_get_syspath(d->udev));
+    if (d->sysfsPathCache.isNull()) {
+        d->sysfsPathCache = QString::fromLatin1(udev_device_get_syspath(d->udev));
+    }
+    return d->sysfsPathCache;
+}
+
+const QString &Device::udi(const QString &prefix) const
+{
+    static const QString nullUdi;
+    if (!d) {
+        return nullUdi;
+    }
+
+    if (d->udiCache.isNull()) {
+        d->udiCache = prefix + sysfsPath();
+    }
+    return d->udiCache;
 }
 
 int Device::sysfsNumber() const
@@ -236,6 +256,26 @@ QVariant Device::deviceProperty(const QString &name) const
     return QVariant();
 }
 
+QLatin1String Device::devicePropertyView(const char *name) const
+{
+    if (!d) {
+        return QLatin1String();
+    }
+
+    const char *value = udev_device_get_property_value(d->udev, name);
+    return value ? QLatin1String(value) : QLatin1String();
+}
+
+QLatin1String Device::subsystemView() const
+{
+    if (!d) {
+        return QLatin1String();
+    }
+
+    const char *value = udev_device_get_subsystem(d->udev);
+    return value ? QLatin1String(value) : QLatin1String();
+}
+
 QString Device::decodedDeviceProperty(const QString &name) const
 {
     if (!d) {
@@ -28,6 +28,13 @@ public:
     QString devType() const;
     QString name() const;
     QString sysfsPath() const;
+    /**
+     * The sysfs path prefixed with @p prefix — the device's Solid UDI.
+     * Composed once and returned by reference afterwards; the prefix is
+     * the backend's fixed UDI namespace, so it must not vary between
+     * calls on the same device.
+     */
+    const QString &udi(const QString &prefix) const;
     int sysfsNumber() const;
     QString driver() const;
     QString primaryDeviceFile() const;
@@ -41,6 +48,16 @@ public:
     // ### should this really be a QVariant? as far as udev knows, everything is a string...
     // see also Client::devicesByProperty
     QVariant deviceProperty(const QString &name) const;
+    /**
+     * Zero-copy view of a property value, pointing into the property block
+     * libudev keeps for the device; valid as long as this device (or a copy
+     * of it) is alive, empty when the property is absent. Lets hot
+     * enumeration paths check properties without the QString/QVariant
+     * conversions of deviceProperty().
+     */
+    QLatin1String devicePropertyView(const char *name) const;
+    /** Zero-copy view of the subsystem name; same lifetime rules. */
+    QLatin1String subsystemView() const;
     QString decodedDeviceProperty(const QString &name) const;
     QVariant sysfsProperty(const QString &name) const;
     Device ancestorOfType(const QString &subsys, const QString &devtype) const;
@@ -0,0 +1,13 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SYSFSBLOCK_H
+#define SYSFSBLOCK_H
+
+#define SYSFSBLOCK_UDI_PREFIX "/org/kde/solid/sysfsblock"
+#define SYSFSBLOCK_SYSFS_PATH "/sys/class/block"
+
+#endif // SYSFSBLOCK_H
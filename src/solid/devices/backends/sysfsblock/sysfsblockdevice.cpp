@@ -0,0 +1,166 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "sysfsblockdevice.h"
+#include "sysfsblock.h"
+#include "sysfsblockinterfaces.h"
+
+#include "../shared/fastscan.h"
+
+using namespace Solid::Backends::SysfsBlock;
+using namespace Solid::Backends;
+
+SysfsBlockDevice::SysfsBlockDevice(const QString &udi)
+    : m_udi(udi)
+    , m_name(udi.section(QLatin1Char('/'), -1))
+    , m_sysfs(QLatin1String(SYSFSBLOCK_SYSFS_PATH "/") + m_name)
+{
+    const QByteArray uevent = m_sysfs.read("uevent");
+    Shared::FastScan::forEachToken(QByteArrayView(uevent), '\n', [this](QByteArrayView line) {
+        const auto [key, value] = Shared::FastScan::keyValue(line, '=');
+        if (key.size() != line.size()) {
+            m_uevent.insert(key.toByteArray(), value.toByteArray());
+        }
+    });
+}
+
+SysfsBlockDevice::~SysfsBlockDevice()
+{
+}
+
+QString SysfsBlockDevice::name() const
+{
+    return m_name;
+}
+
+QByteArray SysfsBlockDevice::ueventProperty(const char *key) const
+{
+    return m_uevent.value(key);
+}
+
+QByteArray SysfsBlockDevice::attribute(const char *name) const
+{
+    return m_sysfs.read(name);
+}
+
+bool SysfsBlockDevice::isPartition() const
+{
+    return ueventProperty("DEVTYPE") == "partition";
+}
+
+bool SysfsBlockDevice::isRemovable() const
+{
+    /* only whole disks carry the flag; partitions look it up on the disk
+     * their class entry links into */
+    if (isPartition()) {
+        return m_sysfs.read("../removable") == "1";
+    }
+    return m_sysfs.read("removable") == "1";
+}
+
+qulonglong SysfsBlockDevice::sizeInBytes() const
+{
+    // always 512-byte sectors, independent of the device's logical block size
+    return attribute("size").toULongLong() * 512;
+}
+
+QString SysfsBlockDevice::udi() const
+{
+    return m_udi;
+}
+
+QString SysfsBlockDevice::parentUdi() const
+{
+    if (isPartition()) {
+        /* the class entry resolves into the disk's device directory, so the
+         * disk's uevent is one level up */
+        const QByteArray uevent = m_sysfs.read("../uevent");
+        QByteArray diskName;
+        Shared::FastScan::forEachToken(QByteArrayView(uevent), '\n', [&diskName](QByteArrayView line) {
+            const auto [key, value] = Shared::FastScan::keyValue(line, '=');
+            if (key == QByteArrayView("DEVNAME")) {
+                diskName = value.toByteArray();
+            }
+        });
+        if (!diskName.isEmpty()) {
+            return QStringLiteral(SYSFSBLOCK_UDI_PREFIX "/") + QString::fromLatin1(diskName);
+        }
+    }
+
+    return QStringLiteral(SYSFSBLOCK_UDI_PREFIX);
+}
+
+QString SysfsBlockDevice::vendor() const
+{
+    return QString::fromUtf8(attribute("device/vendor")).trimmed();
+}
+
+QString SysfsBlockDevice::product() const
+{
+    const QString model = QString::fromUtf8(attribute("device/model")).trimmed();
+    if (!model.isEmpty()) {
+        return model;
+    }
+    return m_name;
+}
+
+QString SysfsBlockDevice::icon() const
+{
+    if (m_name.startsWith(QLatin1String("sr"))) {
+        return QStringLiteral("drive-optical");
+    }
+    if (isRemovable()) {
+        return QStringLiteral("drive-removable-media");
+    }
+    return QStringLiteral("drive-harddisk");
+}
+
+QStringList SysfsBlockDevice::emblems() const
+{
+    return QStringList();
+}
+
+QString SysfsBlockDevice::description() const
+{
+    if (isPartition()) {
+        return tr("Partition %1").arg(m_name);
+    }
+    return product();
+}
+
+bool SysfsBlockDevice::queryDeviceInterface(const Solid::DeviceInterface::Type &type) const
+{
+    switch (type) {
+    case Solid::DeviceInterface::Block:
+        return m_sysfs.isValid();
+    case Solid::DeviceInterface::StorageDrive:
+        return ueventProperty("DEVTYPE") == "disk";
+    case Solid::DeviceInterface::StorageVolume:
+        return isPartition();
+    default:
+        return false;
+    }
+}
+
+QObject *SysfsBlockDevice::createDeviceInterface(const Solid::DeviceInterface::Type &type)
+{
+    if (!queryDeviceInterface(type)) {
+        return nullptr;
+    }
+
+    switch (type) {
+    case Solid::DeviceInterface::Block:
+        return new Block(this);
+    case Solid::DeviceInterface::StorageDrive:
+        return new StorageDrive(this);
+    case Solid::DeviceInterface::StorageVolume:
+        return new StorageVolume(this);
+    default:
+        return nullptr;
+    }
+}
+
+#include "moc_sysfsblockdevice.cpp"
@@ -0,0 +1,70 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SYSFSBLOCKDEVICE_H
+#define SYSFSBLOCKDEVICE_H
+
+#include <solid/devices/ifaces/device.h>
+
+#include "../shared/sysfsreader.h"
+
+#include <QHash>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace SysfsBlock
+{
+/**
+ * One /sys/class/block entry. The uevent file is snapshotted at
+ * construction; the other attributes are read on demand through the
+ * directory descriptor the reader keeps open.
+ */
+class SysfsBlockDevice : public Solid::Ifaces::Device
+{
+    Q_OBJECT
+
+public:
+    explicit SysfsBlockDevice(const QString &udi);
+    ~SysfsBlockDevice() override;
+
+    QString udi() const override;
+    QString parentUdi() const override;
+    QString vendor() const override;
+    QString product() const override;
+    QString icon() const override;
+    QStringList emblems() const override;
+    QString description() const override;
+
+    bool queryDeviceInterface(const Solid::DeviceInterface::Type &type) const override;
+    QObject *createDeviceInterface(const Solid::DeviceInterface::Type &type) override;
+
+    /** The sysfs entry name (e.g. "sda" or "sda1"). */
+    QString name() const;
+    /** Value of @p key from the uevent snapshot (MAJOR, DEVTYPE, ...). */
+    QByteArray ueventProperty(const char *key) const;
+    /** Contents of the sysfs attribute @p name, empty if absent. */
+    QByteArray attribute(const char *name) const;
+    /** Whether the entry is a partition rather than a whole disk. */
+    bool isPartition() const;
+    /** Whether the kernel flags the media as removable (partitions check their disk). */
+    bool isRemovable() const;
+    /** Size in bytes, from the sector count the kernel exports. */
+    qulonglong sizeInBytes() const;
+
+private:
+    QString m_udi;
+    QString m_name;
+    Shared::SysfsReader m_sysfs;
+    QHash<QByteArray, QByteArray> m_uevent;
+};
+
+}
+}
+}
+
+#endif // SYSFSBLOCKDEVICE_H
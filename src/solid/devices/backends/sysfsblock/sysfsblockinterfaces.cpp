@@ -0,0 +1,141 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "sysfsblockinterfaces.h"
+#include "sysfsblock.h"
+#include "sysfsblockdevice.h"
+
+#include <QFileInfo>
+
+using namespace Solid::Backends::SysfsBlock;
+
+Block::Block(SysfsBlockDevice *device)
+    : QObject(device)
+    , m_device(device)
+{
+}
+
+Block::~Block()
+{
+}
+
+int Block::deviceMajor() const
+{
+    return m_device->ueventProperty("MAJOR").toInt();
+}
+
+int Block::deviceMinor() const
+{
+    return m_device->ueventProperty("MINOR").toInt();
+}
+
+QString Block::device() const
+{
+    const QByteArray devName = m_device->ueventProperty("DEVNAME");
+    if (!devName.isEmpty()) {
+        return QStringLiteral("/dev/") + QString::fromLatin1(devName);
+    }
+    return QStringLiteral("/dev/") + m_device->name();
+}
+
+StorageDrive::StorageDrive(SysfsBlockDevice *device)
+    : Block(device)
+{
+}
+
+StorageDrive::~StorageDrive()
+{
+}
+
+Solid::StorageDrive::Bus StorageDrive::bus() const
+{
+    /* the class entry is a symlink into the device tree; the path it
+     * resolves to names every bus on the way to the disk */
+    const QString devicePath = QFileInfo(QLatin1String(SYSFSBLOCK_SYSFS_PATH "/") + m_device->name()).symLinkTarget();
+    if (devicePath.contains(QLatin1String("/usb"))) {
+        return Solid::StorageDrive::Usb;
+    }
+    if (devicePath.contains(QLatin1String("/ata"))) {
+        return Solid::StorageDrive::Sata;
+    }
+    return Solid::StorageDrive::Platform;
+}
+
+Solid::StorageDrive::DriveType StorageDrive::driveType() const
+{
+    const QString name = m_device->name();
+    if (name.startsWith(QLatin1String("sr"))) {
+        return Solid::StorageDrive::CdromDrive;
+    }
+    if (name.startsWith(QLatin1String("mmcblk"))) {
+        return Solid::StorageDrive::SdMmc;
+    }
+    return Solid::StorageDrive::HardDisk;
+}
+
+bool StorageDrive::isRemovable() const
+{
+    return m_device->isRemovable();
+}
+
+bool StorageDrive::isHotpluggable() const
+{
+    return bus() == Solid::StorageDrive::Usb || m_device->isRemovable();
+}
+
+qulonglong StorageDrive::size() const
+{
+    return m_device->sizeInBytes();
+}
+
+StorageVolume::StorageVolume(SysfsBlockDevice *device)
+    : Block(device)
+{
+}
+
+StorageVolume::~StorageVolume()
+{
+}
+
+bool StorageVolume::isIgnored() const
+{
+    return false;
+}
+
+Solid::StorageVolume::UsageType StorageVolume::usage() const
+{
+    /* sysfs doesn't expose filesystem metadata, and claiming FileSystem
+     * without probing could prompt mount attempts; callers that need it
+     * have to go through the UDisks2 backend */
+    return Solid::StorageVolume::Other;
+}
+
+QString StorageVolume::fsType() const
+{
+    return QString();
+}
+
+QString StorageVolume::label() const
+{
+    return QString();
+}
+
+QString StorageVolume::uuid() const
+{
+    return QString();
+}
+
+qulonglong StorageVolume::size() const
+{
+    return m_device->sizeInBytes();
+}
+
+QString StorageVolume::encryptedContainerUdi() const
+{
+    return QString();
+}
+
+#include "moc_sysfsblockinterfaces.cpp"
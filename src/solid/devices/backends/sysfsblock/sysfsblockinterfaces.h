@@ -0,0 +1,82 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SYSFSBLOCKINTERFACES_H
+#define SYSFSBLOCKINTERFACES_H
+
+#include <solid/devices/ifaces/block.h>
+#include <solid/devices/ifaces/storagedrive.h>
+#include <solid/devices/ifaces/storagevolume.h>
+
+#include <QObject>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace SysfsBlock
+{
+class SysfsBlockDevice;
+
+/* The three interfaces this backend answers are thin readers over the
+ * device's sysfs snapshot, so they live together in one translation unit. */
+
+class Block : public QObject, virtual public Solid::Ifaces::Block
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::Block)
+
+public:
+    explicit Block(SysfsBlockDevice *device);
+    ~Block() override;
+
+    int deviceMajor() const override;
+    int deviceMinor() const override;
+    QString device() const override;
+
+protected:
+    SysfsBlockDevice *m_device;
+};
+
+class StorageDrive : public Block, virtual public Solid::Ifaces::StorageDrive
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::StorageDrive)
+
+public:
+    explicit StorageDrive(SysfsBlockDevice *device);
+    ~StorageDrive() override;
+
+    Solid::StorageDrive::Bus bus() const override;
+    Solid::StorageDrive::DriveType driveType() const override;
+    bool isRemovable() const override;
+    bool isHotpluggable() const override;
+    qulonglong size() const override;
+};
+
+class StorageVolume : public Block, virtual public Solid::Ifaces::StorageVolume
+{
+    Q_OBJECT
+    Q_INTERFACES(Solid::Ifaces::StorageVolume)
+
+public:
+    explicit StorageVolume(SysfsBlockDevice *device);
+    ~StorageVolume() override;
+
+    bool isIgnored() const override;
+    Solid::StorageVolume::UsageType usage() const override;
+    QString fsType() const override;
+    QString label() const override;
+    QString uuid() const override;
+    qulonglong size() const override;
+    QString encryptedContainerUdi() const override;
+};
+
+}
+}
+}
+
+#endif // SYSFSBLOCKINTERFACES_H
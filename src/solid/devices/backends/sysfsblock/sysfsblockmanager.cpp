@@ -0,0 +1,118 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "sysfsblockmanager.h"
+#include "../shared/rootdevice.h"
+#include "sysfsblock.h"
+#include "sysfsblockdevice.h"
+#include "sysfsblockmonitor.h"
+
+#include <QDir>
+
+using namespace Solid::Backends::SysfsBlock;
+using namespace Solid::Backends::Shared;
+
+SysfsBlockManager::SysfsBlockManager(QObject *parent)
+    : Solid::Ifaces::DeviceManager(parent)
+    , m_deviceList(QDir(QStringLiteral(SYSFSBLOCK_SYSFS_PATH)).entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+{
+    m_supportedInterfaces << Solid::DeviceInterface::Block //
+                          << Solid::DeviceInterface::StorageDrive //
+                          << Solid::DeviceInterface::StorageVolume;
+
+    connect(SysfsBlockMonitor::instance(), &SysfsBlockMonitor::deviceAdded, this, &SysfsBlockManager::onDeviceAdded);
+    connect(SysfsBlockMonitor::instance(), &SysfsBlockMonitor::deviceRemoved, this, &SysfsBlockManager::onDeviceRemoved);
+}
+
+SysfsBlockManager::~SysfsBlockManager()
+{
+}
+
+QString SysfsBlockManager::udiPrefix() const
+{
+    return QStringLiteral(SYSFSBLOCK_UDI_PREFIX);
+}
+
+QSet<Solid::DeviceInterface::Type> SysfsBlockManager::supportedInterfaces() const
+{
+    return m_supportedInterfaces;
+}
+
+QStringList SysfsBlockManager::allDevices()
+{
+    QStringList result;
+
+    result << udiPrefix();
+    for (const QString &device : std::as_const(m_deviceList)) {
+        result << udiPrefix() + QStringLiteral("/") + device;
+    }
+
+    return result;
+}
+
+QStringList SysfsBlockManager::devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
+{
+    if (type != Solid::DeviceInterface::Unknown && !m_supportedInterfaces.contains(type)) {
+        return QStringList();
+    }
+
+    QStringList result;
+    for (const QString &name : std::as_const(m_deviceList)) {
+        SysfsBlockDevice candidate(udiPrefix() + QStringLiteral("/") + name);
+        if (type != Solid::DeviceInterface::Unknown && !candidate.queryDeviceInterface(type)) {
+            continue;
+        }
+        if (!parentUdi.isEmpty() && candidate.parentUdi() != parentUdi) {
+            continue;
+        }
+        result << candidate.udi();
+    }
+
+    return result;
+}
+
+QObject *SysfsBlockManager::createDevice(const QString &udi)
+{
+    if (udi == udiPrefix()) {
+        RootDevice *root = new RootDevice(udi);
+
+        root->setProduct(tr("Block Devices"));
+        root->setDescription(tr("Block devices reported by the kernel"));
+        root->setIcon(QStringLiteral("drive-harddisk"));
+
+        return root;
+
+    } else {
+        // global device manager makes sure udi starts with udi prefix + '/'
+        const QString internalName = udi.mid(udiPrefix().length() + 1, -1);
+        if (!m_deviceList.contains(internalName)) {
+            return nullptr;
+        }
+
+        return new SysfsBlockDevice(udi);
+    }
+}
+
+void SysfsBlockManager::onDeviceAdded(const QString &name)
+{
+    if (m_deviceList.contains(name)) {
+        return;
+    }
+
+    m_deviceList << name;
+    Q_EMIT deviceAdded(udiPrefix() + QStringLiteral("/") + name);
+}
+
+void SysfsBlockManager::onDeviceRemoved(const QString &name)
+{
+    if (!m_deviceList.removeOne(name)) {
+        return;
+    }
+
+    Q_EMIT deviceRemoved(udiPrefix() + QStringLiteral("/") + name);
+}
+
+#include "moc_sysfsblockmanager.cpp"
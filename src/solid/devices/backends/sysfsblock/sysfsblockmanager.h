@@ -0,0 +1,55 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SYSFSBLOCKMANAGER_H
+#define SYSFSBLOCKMANAGER_H
+
+#include <QSet>
+#include <QStringList>
+#include <solid/deviceinterface.h>
+#include <solid/devices/ifaces/devicemanager.h>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace SysfsBlock
+{
+/**
+ * Answers Block/StorageVolume/StorageDrive listing queries from a direct
+ * /sys/class/block scan, without ever talking to udisksd. Meant for
+ * headless deployments that only enumerate block devices; mount and
+ * unmount operations still materialize the UDisks2 backend on demand.
+ * Enabled with SOLID_SYSFS_BLOCK_BACKEND=1.
+ */
+class SysfsBlockManager : public Solid::Ifaces::DeviceManager
+{
+    Q_OBJECT
+
+public:
+    explicit SysfsBlockManager(QObject *parent);
+    ~SysfsBlockManager() override;
+
+    QString udiPrefix() const override;
+    QSet<Solid::DeviceInterface::Type> supportedInterfaces() const override;
+    QStringList allDevices() override;
+    QStringList devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type) override;
+    QObject *createDevice(const QString &udi) override;
+
+private Q_SLOTS:
+    void onDeviceAdded(const QString &name);
+    void onDeviceRemoved(const QString &name);
+
+private:
+    QSet<Solid::DeviceInterface::Type> m_supportedInterfaces;
+    QStringList m_deviceList;
+};
+
+}
+}
+}
+
+#endif // SYSFSBLOCKMANAGER_H
@@ -0,0 +1,116 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "sysfsblockmonitor.h"
+
+#include "../shared/fastscan.h"
+
+#include <QSocketNotifier>
+
+#include <cerrno>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace Solid::Backends::SysfsBlock;
+using namespace Solid::Backends;
+
+Q_GLOBAL_STATIC(SysfsBlockMonitor, s_monitor)
+
+SysfsBlockMonitor *SysfsBlockMonitor::instance()
+{
+    return s_monitor();
+}
+
+SysfsBlockMonitor::SysfsBlockMonitor()
+{
+    m_fd = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+    if (m_fd < 0) {
+        return;
+    }
+
+    struct sockaddr_nl snl = {};
+    snl.nl_family = AF_NETLINK;
+    snl.nl_groups = 1; // group 1 carries the kernel's own uevents
+
+    if (::bind(m_fd, reinterpret_cast<struct sockaddr *>(&snl), sizeof(snl)) < 0) {
+        ::close(m_fd);
+        m_fd = -1;
+        return;
+    }
+
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &SysfsBlockMonitor::onUevent);
+}
+
+SysfsBlockMonitor::~SysfsBlockMonitor()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+bool SysfsBlockMonitor::isValid() const
+{
+    return m_fd >= 0;
+}
+
+void SysfsBlockMonitor::onUevent()
+{
+    char buffer[8192];
+
+    for (;;) {
+        const ssize_t size = ::recv(m_fd, buffer, sizeof(buffer), 0);
+        if (size <= 0) {
+            if (size < 0 && errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        /* datagram layout: "action@devpath\0KEY=VALUE\0..." */
+        QByteArrayView action;
+        QByteArrayView devpath;
+        QByteArrayView subsystem;
+        QByteArrayView name;
+        bool header = true;
+        Shared::FastScan::forEachToken(QByteArrayView(buffer, size), '\0', [&](QByteArrayView token) {
+            if (header) {
+                header = false;
+                const auto [act, path] = Shared::FastScan::keyValue(token, '@');
+                action = act;
+                devpath = path;
+                return;
+            }
+            const auto [key, value] = Shared::FastScan::keyValue(token, '=');
+            if (key == QByteArrayView("SUBSYSTEM")) {
+                subsystem = value;
+            } else if (key == QByteArrayView("DEVNAME")) {
+                name = value;
+            }
+        });
+
+        if (subsystem != QByteArrayView("block")) {
+            continue;
+        }
+        if (name.isEmpty()) {
+            const qsizetype slash = devpath.lastIndexOf('/');
+            name = devpath.mid(slash + 1);
+        }
+        if (name.isEmpty()) {
+            continue;
+        }
+
+        const QString deviceName = QString::fromLatin1(name);
+        if (action == QByteArrayView("add")) {
+            Q_EMIT deviceAdded(deviceName);
+        } else if (action == QByteArrayView("remove")) {
+            Q_EMIT deviceRemoved(deviceName);
+        }
+    }
+}
+
+#include "moc_sysfsblockmonitor.cpp"
@@ -0,0 +1,53 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SYSFSBLOCKMONITOR_H
+#define SYSFSBLOCKMONITOR_H
+
+#include <QObject>
+
+class QSocketNotifier;
+
+namespace Solid
+{
+namespace Backends
+{
+namespace SysfsBlock
+{
+/**
+ * Listens to the kernel's raw uevent broadcast group for block subsystem
+ * events, so hotplug keeps working even though this backend never talks
+ * to udevd or any D-Bus daemon.
+ */
+class SysfsBlockMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    static SysfsBlockMonitor *instance();
+
+    SysfsBlockMonitor();
+    ~SysfsBlockMonitor() override;
+
+    bool isValid() const;
+
+Q_SIGNALS:
+    void deviceAdded(const QString &name);
+    void deviceRemoved(const QString &name);
+
+private Q_SLOTS:
+    void onUevent();
+
+private:
+    int m_fd = -1;
+    QSocketNotifier *m_notifier = nullptr;
+};
+
+}
+}
+}
+
+#endif // SYSFSBLOCKMONITOR_H
@@ -7,9 +7,10 @@
 #include "cpuinfo.h"
 #include "cpuinfo_arm.h"
 
+#include "../shared/fastscan.h"
+
 #include <QFile>
-#include <QRegularExpression>
-#include <QStringList>
+#include <QHash>
 
 namespace Solid
 {
@@ -17,30 +18,111 @@ namespace Backends
 {
 namespace UDev
 {
+/* /proc/cpuinfo parsed once into indexed key/value records. The callers
+ * look up two or three fields per processor, and re-reading and scanning
+ * the whole file for each of them is quadratic in the core count. Vendor
+ * and model never change; the MHz value is a snapshot of the first read,
+ * which matches how callers use it (Processor caches its speed anyway). */
 class CpuInfo
 {
 public:
+    static const CpuInfo *instance();
+
+    /* value of @p key within the record of @p processorNumber */
+    QString processorField(int processorNumber, const QByteArray &key) const;
+    /* value of the first occurrence of @p key anywhere in the file */
+    QString field(const QByteArray &key) const;
+
+    /* resolved vendor/model strings, memoized per core: the inputs never
+     * change, and the ARM path decodes two hex fields and a lookup table
+     * on every call otherwise */
+    QString vendor(int processorNumber) const;
+    QString model(int processorNumber) const;
+
     CpuInfo();
-    QString extractCpuInfoLine(int processorNumber, const QString &regExpStr);
-    QString extractInfoLine(const QString &regExpStr);
 
 private:
-    QStringList cpuInfo;
+    QHash<int, QHash<QByteArray, QByteArray>> m_processors;
+    QHash<QByteArray, QByteArray> m_fields;
+    mutable QHash<int, QString> m_vendors;
+    mutable QHash<int, QString> m_models;
 };
 
-QString extractCpuVendor(int processorNumber)
+Q_GLOBAL_STATIC(CpuInfo, s_cpuInfo)
+
+const CpuInfo *CpuInfo::instance()
+{
+    return s_cpuInfo();
+}
+
+CpuInfo::CpuInfo()
+{
+    QFile cpuInfoFile(QStringLiteral("/proc/cpuinfo"));
+    if (!cpuInfoFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    int currentProcessor = -1;
+
+    /* one pass over the raw buffer; lines and fields stay views of it
+     * until the moment they are stored */
+    const QByteArray contents = cpuInfoFile.readAll();
+    Shared::FastScan::forEachToken(QByteArrayView(contents), '\n', [&](QByteArrayView line) {
+        const auto [keyView, valueView] = Shared::FastScan::keyValue(line, ':');
+        if (keyView.size() == line.size()) {
+            return; // no colon on this line
+        }
+
+        const QByteArray key = keyView.trimmed().toByteArray();
+        const QByteArray value = valueView.trimmed().toByteArray();
+
+        /* "processor : N" opens the record of core N; note that the ARM/ppc
+         * "Processor :" model line differs in case and has no number */
+        if (key == "processor") {
+            bool numeric = false;
+            const int number = value.toInt(&numeric);
+            if (numeric) {
+                currentProcessor = number;
+                return;
+            }
+        }
+
+        if (currentProcessor >= 0) {
+            m_processors[currentProcessor].insert(key, value);
+        }
+        if (!m_fields.contains(key)) {
+            m_fields.insert(key, value);
+        }
+    });
+}
+
+QString CpuInfo::processorField(int processorNumber, const QByteArray &key) const
+{
+    return QString::fromLatin1(m_processors.value(processorNumber).value(key));
+}
+
+QString CpuInfo::field(const QByteArray &key) const
+{
+    return QString::fromLatin1(m_fields.value(key));
+}
+
+QString CpuInfo::vendor(int processorNumber) const
 {
-    CpuInfo info;
+    const auto memo = m_vendors.constFind(processorNumber);
+    if (memo != m_vendors.cend()) {
+        return *memo;
+    }
+
     QString vendor;
 
 #ifndef BUILDING_FOR_ARM_TARGET
-    vendor = info.extractCpuInfoLine(processorNumber, QStringLiteral("vendor_id\\s+:\\s+(\\S.+)"));
+    vendor = processorField(processorNumber, QByteArrayLiteral("vendor_id"));
     if (vendor.isEmpty()) {
-        vendor = info.extractInfoLine(QStringLiteral("Hardware\\s+:\\s+(\\S.+)"));
+        vendor = field(QByteArrayLiteral("Hardware"));
     }
 #else
     // ARM ? "CPU implementer : 0x41"
-    vendor = info.extractCpuInfoLine(processorNumber, QStringLiteral("CPU implementer\\s+:\\s+(\\S.+)"));
+    vendor = processorField(processorNumber, QByteArrayLiteral("CPU implementer"));
     bool ok = false;
     const int vendorId = vendor.toInt(&ok, 16);
     if (ok) {
@@ -51,28 +133,33 @@ QString extractCpuVendor(int processorNumber)
     }
 #endif
 
+    m_vendors.insert(processorNumber, vendor);
     return vendor;
 }
 
-QString extractCpuModel(int processorNumber)
+QString CpuInfo::model(int processorNumber) const
 {
-    CpuInfo info;
+    const auto memo = m_models.constFind(processorNumber);
+    if (memo != m_models.cend()) {
+        return *memo;
+    }
+
     QString model;
 
 #ifndef BUILDING_FOR_ARM_TARGET
-    model = info.extractCpuInfoLine(processorNumber, QStringLiteral("model name\\s+:\\s+(\\S.+)"));
+    model = processorField(processorNumber, QByteArrayLiteral("model name"));
     if (model.isEmpty()) {
-        model = info.extractInfoLine(QStringLiteral("Processor\\s+:\\s+(\\S.+)"));
+        model = field(QByteArrayLiteral("Processor"));
     }
 
     // for ppc64, extract from "cpu:" line
     if (model.isEmpty()) {
-        model = info.extractInfoLine(QStringLiteral("cpu\\s+:\\s+(\\S.+)"));
+        model = field(QByteArrayLiteral("cpu"));
     }
 #else
     // ARM? "CPU part        : 0xd03"
-    const QString vendor = info.extractCpuInfoLine(processorNumber, QStringLiteral("CPU implementer\\s+:\\s+(\\S.+)"));
-    model = info.extractCpuInfoLine(processorNumber, QStringLiteral("CPU part\\s+:\\s+(\\S.+)"));
+    const QString vendor = processorField(processorNumber, QByteArrayLiteral("CPU implementer"));
+    model = processorField(processorNumber, QByteArrayLiteral("CPU part"));
     if (!model.isEmpty() && !vendor.isEmpty()) {
         bool vendorOk = false, modelOk = false;
         const int vendorId = vendor.toInt(&vendorOk, 16);
@@ -83,62 +170,24 @@ QString extractCpuModel(int processorNumber)
     }
 #endif
 
+    m_models.insert(processorNumber, model);
     return model;
 }
 
-int extractCurrentCpuSpeed(int processorNumber)
-{
-    CpuInfo info;
-    int speed = info.extractCpuInfoLine(processorNumber, QStringLiteral("cpu MHz\\s+:\\s+(\\d+).*")).toInt();
-    return speed;
-}
-
-CpuInfo::CpuInfo()
+QString extractCpuVendor(int processorNumber)
 {
-    QFile cpuInfoFile(QStringLiteral("/proc/cpuinfo"));
-    if (!cpuInfoFile.open(QIODevice::ReadOnly)) {
-        return;
-    }
-    cpuInfo = QString::fromLatin1(cpuInfoFile.readAll()).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+    return CpuInfo::instance()->vendor(processorNumber);
 }
 
-QString CpuInfo::extractCpuInfoLine(int processorNumber, const QString &regExpStr)
+QString extractCpuModel(int processorNumber)
 {
-    const QRegularExpression processorRegExp(QRegularExpression::anchoredPattern(QStringLiteral("processor\\s+:\\s+(\\d+)")));
-    const QRegularExpression regExp(QRegularExpression::anchoredPattern(regExpStr));
-
-    int line = 0;
-    while (line < cpuInfo.size()) {
-        QRegularExpressionMatch match;
-        if ((match = processorRegExp.match(cpuInfo.at(line))).hasMatch()) {
-            int recordProcNum = match.captured(1).toInt();
-            if (recordProcNum == processorNumber) {
-                ++line;
-                while (line < cpuInfo.size()) {
-                    if ((match = regExp.match(cpuInfo.at(line))).hasMatch()) {
-                        return match.captured(1);
-                    }
-                    ++line;
-                }
-            }
-        }
-        ++line;
-    }
-
-    return QString();
+    return CpuInfo::instance()->model(processorNumber);
 }
 
-QString CpuInfo::extractInfoLine(const QString &regExpStr)
+int extractCurrentCpuSpeed(int processorNumber)
 {
-    const QRegularExpression regExp(QRegularExpression::anchoredPattern(regExpStr));
-
-    for (const QString &line : std::as_const(cpuInfo)) {
-        QRegularExpressionMatch match = regExp.match(line);
-        if (match.hasMatch()) {
-            return match.captured(1);
-        }
-    }
-    return QString();
+    // "cpu MHz		: 3400.000" -> the integer part
+    return static_cast<int>(CpuInfo::instance()->processorField(processorNumber, QByteArrayLiteral("cpu MHz")).toDouble());
 }
 
 }
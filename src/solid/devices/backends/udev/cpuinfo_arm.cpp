@@ -9,6 +9,10 @@
 // don't even build the following code for non-ARM platforms
 #ifdef BUILDING_FOR_ARM_TARGET
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
 namespace Solid
 {
 namespace Backends
@@ -21,10 +25,13 @@ namespace UDev
  * https://elixir.bootlin.com/linux/latest/source/arch/arm64/include/asm/cputype.h
  * https://elixir.bootlin.com/linux/latest/source/arch/arm/include/asm/cputype.h
  * There is also maintained list at https://github.com/bp0/armids
+ *
+ * All tables are constexpr and sorted ascending by ID (checked below), so
+ * lookups can index or bisect them instead of scanning.
  **/
 
 // clang-format off
-static const struct ArmIdPart armParts[] = {
+static constexpr struct ArmIdPart armParts[] = {
     {0x810, "ARM810"},
     {0x920, "ARM920"},
     {0x922, "ARM922"},
@@ -57,6 +64,7 @@ static const struct ArmIdPart armParts[] = {
     {0xc27, "Cortex-M7"},
     {0xc60, "Cortex-M0+"},
     {0xd01, "Cortex-A32"},
+    {0xd02, "Cortex-A34"},
     {0xd03, "Cortex-A53"},
     {0xd04, "Cortex-A35"},
     {0xd05, "Cortex-A55"},
@@ -70,11 +78,16 @@ static const struct ArmIdPart armParts[] = {
     {0xd0d, "Cortex-A77"},
     {0xd0e, "Cortex-A76AE"},
     {0xd13, "Cortex-R52"},
+    {0xd14, "Cortex-R82"},
+    {0xd15, "Cortex-R82AE"},
     {0xd20, "Cortex-M23"},
     {0xd21, "Cortex-M33"},
+    {0xd22, "Cortex-M55"},
+    {0xd23, "Cortex-M85"},
     {0xd40, "Neoverse-V1"},
     {0xd41, "Cortex-A78"},
     {0xd42, "Cortex-A78AE"},
+    {0xd43, "Cortex-A65AE"},
     {0xd44, "Cortex-X1"},
     {0xd46, "Cortex-A510"},
     {0xd47, "Cortex-A710"},
@@ -82,25 +95,35 @@ static const struct ArmIdPart armParts[] = {
     {0xd49, "Neoverse-N2"},
     {0xd4a, "Neoverse-E1"},
     {0xd4b, "Cortex-A78C"},
+    {0xd4c, "Cortex-X1C"},
     {0xd4d, "Cortex-A715"},
+    {0xd4e, "Cortex-X3"},
+    {0xd4f, "Neoverse-V2"},
+    {0xd80, "Cortex-A520"},
+    {0xd81, "Cortex-A720"},
+    {0xd82, "Cortex-X4"},
+    {0xd84, "Neoverse-V3"},
+    {0xd85, "Cortex-X925"},
+    {0xd87, "Cortex-A725"},
+    {0xd8e, "Neoverse-N3"},
     {-1, "unknown"},
 };
 // clang-format on
 
-static const struct ArmIdPart brcmParts[] = {
+static constexpr struct ArmIdPart brcmParts[] = {
     {0x0f, "Brahma B15"},
     {0x100, "Brahma B53"},
     {0x516, "ThunderX2 (Vulcan)"},
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart decParts[] = {
+static constexpr struct ArmIdPart decParts[] = {
     {0xa10, "SA110"},
     {0xa11, "SA1100"},
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart caviumParts[] = {
+static constexpr struct ArmIdPart caviumParts[] = {
     {0x0a0, "ThunderX"},
     {0x0a1, "ThunderX 88XX"},
     {0x0a2, "ThunderX 81XX"},
@@ -109,12 +132,13 @@ static const struct ArmIdPart caviumParts[] = {
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart apmParts[] = {
+static constexpr struct ArmIdPart apmParts[] = {
     {0x000, "X-Gene"},
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart qcomParts[] = {
+static constexpr struct ArmIdPart qcomParts[] = {
+    {0x001, "Oryon"},
     {0x00f, "Scorpion"},
     {0x02d, "Scorpion"},
     {0x04d, "Krait"},
@@ -134,33 +158,36 @@ static const struct ArmIdPart qcomParts[] = {
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart samsungParts[] = {
+static constexpr struct ArmIdPart samsungParts[] = {
     {0x001, "exynos-m1"},
+    {0x002, "exynos-m3"},
+    {0x003, "exynos-m4"},
+    {0x004, "exynos-m5"},
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart nvidiaParts[] = {
+static constexpr struct ArmIdPart nvidiaParts[] = {
     {0x000, "Denver"},
     {0x003, "Denver 2"},
     {0x004, "Carmel"},
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart marvellParts[] = {
+static constexpr struct ArmIdPart marvellParts[] = {
     {0x131, "Feroceon 88FR131"},
     {0x581, "PJ4/PJ4b"},
     {0x584, "PJ4B-MP"},
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart faradayParts[] = {
+static constexpr struct ArmIdPart faradayParts[] = {
     {0x526, "FA526"},
     {0x626, "FA626"},
     {-1, "unknown"},
 };
 
 // clang-format off
-static const struct ArmIdPart intelParts[] = {
+static constexpr struct ArmIdPart intelParts[] = {
     {0x200, "i80200"},
     {0x210, "PXA250A"},
     {0x212, "PXA210A"},
@@ -186,17 +213,17 @@ static const struct ArmIdPart intelParts[] = {
 };
 // clang-format on
 
-static const struct ArmIdPart fujitsuParts[] = {
+static constexpr struct ArmIdPart fujitsuParts[] = {
     {0x001, "A64FX"},
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart hisiParts[] = {
+static constexpr struct ArmIdPart hisiParts[] = {
     {0xd01, "Kunpeng-920 (TSV110)"},
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart appleParts[] = {
+static constexpr struct ArmIdPart appleParts[] = {
     {0x020, "Icestorm (A14)"},
     {0x021, "Firestorm (A14)"},
     {0x022, "Icestorm (M1)"},
@@ -216,41 +243,109 @@ static const struct ArmIdPart appleParts[] = {
     {-1, "unknown"},
 };
 
-static const struct ArmIdPart unknownPart[] = {
+static constexpr struct ArmIdPart msftParts[] = {
+    {0xd49, "Azure-Cobalt-100"},
     {-1, "unknown"},
 };
 
-static const struct ArmCpuImplementer armHwImplementers[] = {
-    {0x41, armParts, "ARM"},
-    {0x42, brcmParts, "Broadcom"},
-    {0x43, caviumParts, "Cavium"},
-    {0x44, decParts, "DEC"},
-    {0x46, fujitsuParts, "FUJITSU"},
-    {0x48, hisiParts, "HiSilicon"},
-    {0x49, unknownPart, "Infineon"},
-    {0x4d, unknownPart, "Motorola/Freescale"},
-    {0x4e, nvidiaParts, "NVIDIA"},
-    {0x50, apmParts, "APM"},
-    {0x51, qcomParts, "Qualcomm"},
-    {0x53, samsungParts, "Samsung"},
-    {0x56, marvellParts, "Marvell"},
-    {0x61, appleParts, "Apple"},
-    {0x66, faradayParts, "Faraday"},
-    {0x69, intelParts, "Intel"},
-    {0xc0, unknownPart, "Ampere"},
-    {-1, unknownPart, "unknown"},
+static constexpr struct ArmIdPart phytiumParts[] = {
+    {0x660, "FTC660"},
+    {0x661, "FTC661"},
+    {0x662, "FTC662"},
+    {0x663, "FTC663"},
+    {0x862, "FTC862"},
+    {-1, "unknown"},
 };
 
-const ArmCpuImplementer *findArmCpuImplementer(int vendorId)
+static constexpr struct ArmIdPart ampereParts[] = {
+    {0xac3, "Ampere-1"},
+    {0xac4, "Ampere-1a"},
+    {-1, "unknown"},
+};
+
+static constexpr struct ArmIdPart unknownPart[] = {
+    {-1, "unknown"},
+};
+
+/* number of real entries in a parts table, i.e. without the -1 sentinel */
+template<std::size_t N>
+constexpr int partCount(const ArmIdPart (&)[N])
+{
+    return static_cast<int>(N) - 1;
+}
+
+static constexpr struct ArmCpuImplementer armHwImplementers[] = {
+    {0x41, armParts, partCount(armParts), "ARM"},
+    {0x42, brcmParts, partCount(brcmParts), "Broadcom"},
+    {0x43, caviumParts, partCount(caviumParts), "Cavium"},
+    {0x44, decParts, partCount(decParts), "DEC"},
+    {0x46, fujitsuParts, partCount(fujitsuParts), "FUJITSU"},
+    {0x48, hisiParts, partCount(hisiParts), "HiSilicon"},
+    {0x49, unknownPart, partCount(unknownPart), "Infineon"},
+    {0x4d, unknownPart, partCount(unknownPart), "Motorola/Freescale"},
+    {0x4e, nvidiaParts, partCount(nvidiaParts), "NVIDIA"},
+    {0x50, apmParts, partCount(apmParts), "APM"},
+    {0x51, qcomParts, partCount(qcomParts), "Qualcomm"},
+    {0x53, samsungParts, partCount(samsungParts), "Samsung"},
+    {0x56, marvellParts, partCount(marvellParts), "Marvell"},
+    {0x61, appleParts, partCount(appleParts), "Apple"},
+    {0x66, faradayParts, partCount(faradayParts), "Faraday"},
+    {0x69, intelParts, partCount(intelParts), "Intel"},
+    {0x6d, msftParts, partCount(msftParts), "Microsoft"},
+    {0x70, phytiumParts, partCount(phytiumParts), "Phytium"},
+    {0xc0, ampereParts, partCount(ampereParts), "Ampere"},
+    {-1, unknownPart, partCount(unknownPart), "unknown"},
+};
+
+/* The bisection in findArmCpuModel() needs the tables strictly ascending.
+ * The count keeps the check inside the array even for sentinel-only
+ * tables, where parts[1] would already be out of bounds. */
+constexpr bool isSortedById(const ArmIdPart *parts, int count)
+{
+    for (int i = 1; i < count; ++i) {
+        if (parts[i - 1].id >= parts[i].id) {
+            return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool allPartTablesSorted()
 {
-    const ArmCpuImplementer *ret = nullptr;
-    for (int i = 0; armHwImplementers[i].id != -1; i++) {
-        if (armHwImplementers[i].id == vendorId) {
-            ret = &armHwImplementers[i];
-            break;
+    for (int i = 0; armHwImplementers[i].id != -1; ++i) {
+        if (!isSortedById(armHwImplementers[i].parts, armHwImplementers[i].partCount)) {
+            return false;
         }
     }
-    return ret;
+    return true;
+}
+
+static_assert(allPartTablesSorted(), "ARM part tables must stay sorted by part ID");
+
+/* Implementer IDs fit in one byte, so the perfect hash is the ID itself:
+ * a 256-slot table, filled at compile time, maps it straight to the
+ * record index. 0xff marks an unknown implementer. */
+static constexpr std::array<quint8, 256> buildImplementerSlots()
+{
+    std::array<quint8, 256> slots{};
+    for (auto &slot : slots) {
+        slot = 0xff;
+    }
+    for (int i = 0; armHwImplementers[i].id != -1; ++i) {
+        slots[armHwImplementers[i].id] = static_cast<quint8>(i);
+    }
+    return slots;
+}
+
+static constexpr std::array<quint8, 256> s_implementerSlots = buildImplementerSlots();
+
+const ArmCpuImplementer *findArmCpuImplementer(int vendorId)
+{
+    if (vendorId < 0 || vendorId > 0xff) {
+        return nullptr;
+    }
+    const quint8 slot = s_implementerSlots[vendorId];
+    return slot == 0xff ? nullptr : &armHwImplementers[slot];
 }
 
 /*
@@ -264,10 +359,12 @@ QString findArmCpuModel(int vendorId, int modelId)
     if (!impl) {
         return QString();
     }
-    for (int i = 0; impl->parts[i].id != -1; i++) {
-        if (impl->parts[i].id == modelId) {
-            return QString::fromUtf8(impl->name) + QLatin1Char(' ') + QString::fromUtf8(impl->parts[i].name);
-        }
+    const ArmIdPart *end = impl->parts + impl->partCount;
+    const ArmIdPart *it = std::lower_bound(impl->parts, end, modelId, [](const ArmIdPart &part, int id) {
+        return part.id < id;
+    });
+    if (it != end && it->id == modelId) {
+        return QString::fromUtf8(impl->name) + QLatin1Char(' ') + QString::fromUtf8(it->name);
     }
     return QString();
 }
@@ -42,7 +42,8 @@ struct ArmIdPart {
 
 struct ArmCpuImplementer {
     const int id; //! CPU vendor ID
-    const struct ArmIdPart *parts; //! pointer to an array of parts, last elemnt will have ID -1
+    const struct ArmIdPart *parts; //! pointer to an array of parts, sorted by ID; last elemnt will have ID -1
+    const int partCount; //! number of parts, excluding the -1 sentinel
     const char *name; //! CPU vendor name
 };
 
@@ -0,0 +1,159 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "cputopology.h"
+
+#include "../shared/fastscan.h"
+#include "../shared/sysfsreader.h"
+
+#include <QDir>
+#include <QHash>
+
+#include <algorithm>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDev
+{
+/* Expands a sysfs cpulist ("0-3,8,10-11") into processor numbers. */
+static QList<int> parseCpuList(const QByteArray &list)
+{
+    QList<int> cpus;
+    Shared::FastScan::forEachToken(QByteArrayView(list), ',', [&cpus](QByteArrayView range) {
+        range = range.trimmed();
+        const auto [fromView, toView] = Shared::FastScan::keyValue(range, '-');
+
+        bool ok = false;
+        const int from = fromView.toInt(&ok);
+        if (!ok) {
+            return;
+        }
+
+        int to = from;
+        if (fromView.size() != range.size()) {
+            to = toView.toInt(&ok);
+            if (!ok) {
+                return;
+            }
+        }
+
+        for (int cpu = from; cpu <= to; ++cpu) {
+            cpus.append(cpu);
+        }
+    });
+    return cpus;
+}
+
+/* The topology attributes of all processors, gathered in one pass over
+ * /sys/devices/system/cpu. Every Processor instance answering a topology
+ * query would otherwise open the same handful of files again; with the
+ * typical usage pattern (a client walking all cores) that's quadratic in
+ * the core count. The layout is fixed at boot as far as the ids go, and
+ * hotplugged cores show up as device added events anyway. */
+class CpuTopology
+{
+public:
+    static const CpuTopology *instance();
+
+    CpuTopology();
+
+    struct Core {
+        int packageId = -1;
+        int coreId = -1;
+        QList<int> threadSiblings;
+        QHash<int, QList<int>> cacheSiblings; // keyed by cache level
+    };
+
+    Core core(int processorNumber) const
+    {
+        return m_cores.value(processorNumber);
+    }
+
+private:
+    QHash<int, Core> m_cores;
+};
+
+Q_GLOBAL_STATIC(CpuTopology, s_cpuTopology)
+
+const CpuTopology *CpuTopology::instance()
+{
+    return s_cpuTopology();
+}
+
+CpuTopology::CpuTopology()
+{
+    const QDir cpuDir(QStringLiteral("/sys/devices/system/cpu"));
+    const QStringList entries = cpuDir.entryList({QStringLiteral("cpu[0-9]*")}, QDir::Dirs);
+
+    for (const QString &entry : entries) {
+        bool numeric = false;
+        const int number = QStringView(entry).mid(3).toInt(&numeric);
+        if (!numeric) {
+            continue;
+        }
+
+        const Shared::SysfsReader sysfs(cpuDir.filePath(entry));
+
+        Core core;
+        const QByteArray packageId = sysfs.read("topology/physical_package_id");
+        if (!packageId.isEmpty()) {
+            core.packageId = packageId.toInt();
+        }
+        const QByteArray coreId = sysfs.read("topology/core_id");
+        if (!coreId.isEmpty()) {
+            core.coreId = coreId.toInt();
+        }
+        core.threadSiblings = parseCpuList(sysfs.read("topology/thread_siblings_list"));
+
+        /* cache/indexN directories don't map one-to-one to levels: L1
+         * data and instruction caches are separate indexes on the same
+         * level, so sharer sets of a level are unioned */
+        for (int index = 0;; ++index) {
+            const QByteArray indexDir = "cache/index" + QByteArray::number(index);
+            const QByteArray level = sysfs.read((indexDir + "/level").constData());
+            if (level.isEmpty()) {
+                break;
+            }
+
+            QList<int> &sharers = core.cacheSiblings[level.toInt()];
+            const QList<int> shared = parseCpuList(sysfs.read((indexDir + "/shared_cpu_list").constData()));
+            for (int cpu : shared) {
+                if (!sharers.contains(cpu)) {
+                    sharers.append(cpu);
+                }
+            }
+            std::sort(sharers.begin(), sharers.end());
+        }
+
+        m_cores.insert(number, core);
+    }
+}
+
+int processorPackageId(int processorNumber)
+{
+    return CpuTopology::instance()->core(processorNumber).packageId;
+}
+
+int processorCoreId(int processorNumber)
+{
+    return CpuTopology::instance()->core(processorNumber).coreId;
+}
+
+QList<int> processorThreadSiblings(int processorNumber)
+{
+    return CpuTopology::instance()->core(processorNumber).threadSiblings;
+}
+
+QList<int> processorCacheSiblings(int processorNumber, int level)
+{
+    return CpuTopology::instance()->core(processorNumber).cacheSiblings.value(level);
+}
+
+}
+}
+}
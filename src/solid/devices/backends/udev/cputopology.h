@@ -0,0 +1,44 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_UDEV_CPUTOPOLOGY_H
+#define SOLID_BACKENDS_UDEV_CPUTOPOLOGY_H
+
+#include <QList>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDev
+{
+/**
+ * Processor topology read from /sys/devices/system/cpu in a single pass
+ * and shared by every Processor instance of the backend.
+ */
+
+/**
+ * Physical package (socket) id of the given processor, -1 if unknown
+ */
+int processorPackageId(int processorNumber);
+/**
+ * Core id of the given processor within its package, -1 if unknown
+ */
+int processorCoreId(int processorNumber);
+/**
+ * Processors sharing the core of the given processor, including itself
+ */
+QList<int> processorThreadSiblings(int processorNumber);
+/**
+ * Processors sharing the level @p level cache of the given processor
+ */
+QList<int> processorCacheSiblings(int processorNumber, int level);
+
+}
+}
+}
+
+#endif // SOLID_BACKENDS_UDEV_CPUTOPOLOGY_H
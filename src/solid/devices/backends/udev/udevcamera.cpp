@@ -11,30 +11,48 @@ using namespace Solid::Backends::UDev;
 Camera::Camera(UDevDevice *device)
     : DeviceInterface(device)
 {
+    connect(device, &UDevDevice::propertyChanged, this, &Camera::slotPropertyChanged);
 }
 
 Camera::~Camera()
 {
 }
 
-QStringList Camera::supportedProtocols() const
+void Camera::slotPropertyChanged(const QMap<QString, int> &changes)
+{
+    if (changes.contains(QStringLiteral("GPHOTO2_DRIVER"))) {
+        m_parsed = false;
+    }
+}
+
+void Camera::ensureParsed() const
 {
-    QString method = m_device->property(QStringLiteral("GPHOTO2_DRIVER")).toString();
+    if (m_parsed) {
+        return;
+    }
 
+    m_protocols.clear();
+    m_drivers.clear();
+
+    const QString method = m_device->property(QStringLiteral("GPHOTO2_DRIVER")).toString();
     if (!method.isEmpty()) {
-        return {method.toLower()};
+        m_protocols = {method.toLower()};
+        m_drivers = {QStringLiteral("gphoto")};
     }
 
-    return {};
+    m_parsed = true;
 }
 
-QStringList Camera::supportedDrivers(QString /*protocol*/) const
+QStringList Camera::supportedProtocols() const
 {
-    if (!supportedProtocols().isEmpty()) {
-        return {QStringLiteral("gphoto")};
-    }
+    ensureParsed();
+    return m_protocols;
+}
 
-    return {};
+QStringList Camera::supportedDrivers(QString /*protocol*/) const
+{
+    ensureParsed();
+    return m_drivers;
 }
 
 QVariant Camera::driverHandle(const QString &driver) const
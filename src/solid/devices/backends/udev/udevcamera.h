@@ -28,6 +28,18 @@ public:
     QStringList supportedProtocols() const override;
     QStringList supportedDrivers(QString protocol = QString()) const override;
     QVariant driverHandle(const QString &driver) const override;
+
+private Q_SLOTS:
+    void slotPropertyChanged(const QMap<QString, int> &changes);
+
+private:
+    void ensureParsed() const;
+
+    /* derived lazily from the GPHOTO2 properties, then served as-is until
+     * a change uevent touches them */
+    mutable QStringList m_protocols;
+    mutable QStringList m_drivers;
+    mutable bool m_parsed = false;
 };
 }
 }
@@ -0,0 +1,23 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "udevchangenotifier.h"
+
+using namespace Solid::Backends::UDev;
+
+Q_GLOBAL_STATIC(ChangeNotifier, s_notifier)
+
+ChangeNotifier *ChangeNotifier::instance()
+{
+    return s_notifier();
+}
+
+void ChangeNotifier::announce(const QString &udi, const UdevQt::Device &device)
+{
+    Q_EMIT deviceChanged(udi, device);
+}
+
+#include "moc_udevchangenotifier.cpp"
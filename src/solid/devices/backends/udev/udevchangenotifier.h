@@ -0,0 +1,45 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_UDEV_UDEVCHANGENOTIFIER_H
+#define SOLID_BACKENDS_UDEV_UDEVCHANGENOTIFIER_H
+
+#include <QObject>
+
+#include "../shared/udevqt.h"
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDev
+{
+/* Fans change/online/offline uevents out to the live UDevDevice wrappers.
+ *
+ * The manager owns the monitoring client, but each created UDevDevice holds
+ * its own UdevQt::Device snapshot, and the manager keeps no list of them.
+ * This notifier is the in-process bridge: the manager announces the fresh
+ * event device here, and every wrapper listens and refreshes its snapshot
+ * when the UDI matches — no polling, no re-enumeration.
+ */
+class ChangeNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ChangeNotifier *instance();
+
+    void announce(const QString &udi, const UdevQt::Device &device);
+
+Q_SIGNALS:
+    void deviceChanged(const QString &udi, const UdevQt::Device &device);
+};
+
+}
+}
+}
+
+#endif // SOLID_BACKENDS_UDEV_UDEVCHANGENOTIFIER_H
@@ -9,10 +9,13 @@
 #include "cpuinfo.h"
 #include "udevblock.h"
 #include "udevcamera.h"
+#include "udevchangenotifier.h"
 #include "udevgenericinterface.h"
 #include "udevportablemediaplayer.h"
 #include "udevprocessor.h"
 
+#include <solid/genericinterface.h>
+
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <linux/if_arp.h>
@@ -23,12 +26,48 @@ UDevDevice::UDevDevice(const UdevQt::Device device)
     : Solid::Ifaces::Device()
     , m_device(device)
 {
+    /* change/online/offline uevents carry the device's current property
+     * state; listen for ours so the snapshot never goes stale */
+    connect(ChangeNotifier::instance(), &ChangeNotifier::deviceChanged, this, &UDevDevice::slotDeviceChanged);
 }
 
 UDevDevice::~UDevDevice()
 {
 }
 
+void UDevDevice::slotDeviceChanged(const QString &udi, const UdevQt::Device &device)
+{
+    if (udi != this->udi()) {
+        return;
+    }
+
+    /* Diff the property sets before swapping the snapshot, so listeners
+     * learn exactly which keys moved instead of re-reading everything. */
+    QMap<QString, int> changes;
+    const QStringList oldKeys = m_device.deviceProperties();
+    const QStringList newKeys = device.deviceProperties();
+
+    for (const QString &key : oldKeys) {
+        if (!newKeys.contains(key)) {
+            changes.insert(key, Solid::GenericInterface::PropertyRemoved);
+        } else if (device.deviceProperty(key) != m_device.deviceProperty(key)) {
+            changes.insert(key, Solid::GenericInterface::PropertyModified);
+        }
+    }
+    for (const QString &key : newKeys) {
+        if (!oldKeys.contains(key)) {
+            changes.insert(key, Solid::GenericInterface::PropertyAdded);
+        }
+    }
+
+    m_device = device; // refresh the snapshot in place
+    m_allPropertiesValid = false;
+
+    if (!changes.isEmpty()) {
+        Q_EMIT propertyChanged(changes);
+    }
+}
+
 QString UDevDevice::udi() const
 {
     return devicePath();
@@ -188,12 +227,17 @@ QVariant UDevDevice::property(const QString &key) const
 
 QMap<QString, QVariant> UDevDevice::allProperties() const
 {
-    QMap<QString, QVariant> res;
-    const QStringList properties = m_device.deviceProperties();
-    for (const QString &prop : properties) {
-        res[prop] = property(prop);
+    if (!m_allPropertiesValid) {
+        m_allProperties.clear();
+        const QStringList properties = m_device.deviceProperties();
+        for (const QString &prop : properties) {
+            m_allProperties[prop] = property(prop);
+        }
+        m_allPropertiesValid = true;
     }
-    return res;
+    /* callers get a copy-on-write reference to the memoized map, so bulk
+     * dumps stop paying for a rebuild per call */
+    return m_allProperties;
 }
 
 bool UDevDevice::propertyExists(const QString &key) const
@@ -57,8 +57,20 @@ public:
 
     UdevQt::Device udevDevice();
 
+Q_SIGNALS:
+    /// targeted change notification, forwarded by GenericInterface
+    void propertyChanged(const QMap<QString, int> &changes);
+
+private Q_SLOTS:
+    void slotDeviceChanged(const QString &udi, const UdevQt::Device &device);
+
 private:
     UdevQt::Device m_device;
+
+    /* name-keyed view of the snapshot, built on first allProperties() call
+     * and handed out implicitly shared until the snapshot is replaced */
+    mutable QMap<QString, QVariant> m_allProperties;
+    mutable bool m_allPropertiesValid = false;
 };
 
 }
@@ -0,0 +1,111 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "udevdevicecache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDev
+{
+namespace DeviceCache
+{
+static const char s_magic[] = "solid-udev-cache 1";
+
+static QString cachePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QLatin1String("/solid/udev-device-list");
+}
+
+/* boot id plus uevent seqnum; any uevent since the stamp was taken makes
+ * it compare unequal */
+static QByteArray generationStamp()
+{
+    QFile bootIdFile(QStringLiteral("/proc/sys/kernel/random/boot_id"));
+    QFile seqnumFile(QStringLiteral("/sys/kernel/uevent_seqnum"));
+    if (!bootIdFile.open(QIODevice::ReadOnly) || !seqnumFile.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+
+    return bootIdFile.readAll().trimmed() + ' ' + seqnumFile.readAll().trimmed();
+}
+
+bool isEnabled()
+{
+    return qEnvironmentVariableIntValue("SOLID_UDEV_CACHE") > 0;
+}
+
+std::optional<QStringList> load()
+{
+    if (!isEnabled()) {
+        return std::nullopt;
+    }
+
+    QFile file(cachePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    if (file.readLine().trimmed() != s_magic) {
+        return std::nullopt;
+    }
+
+    const QByteArray stamp = generationStamp();
+    if (stamp.isEmpty() || file.readLine().trimmed() != stamp) {
+        // a uevent happened (or we rebooted) since the list was written
+        return std::nullopt;
+    }
+
+    QStringList udis;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (!line.isEmpty()) {
+            udis << QString::fromUtf8(line);
+        }
+    }
+    return udis;
+}
+
+void store(const QStringList &udis)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    const QByteArray stamp = generationStamp();
+    if (stamp.isEmpty()) {
+        return;
+    }
+
+    const QString path = cachePath();
+    QDir().mkpath(path.left(path.lastIndexOf(QLatin1Char('/'))));
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    file.write(s_magic);
+    file.write("\n");
+    file.write(stamp);
+    file.write("\n");
+    for (const QString &udi : udis) {
+        file.write(udi.toUtf8());
+        file.write("\n");
+    }
+    file.commit();
+}
+
+}
+}
+}
+}
@@ -0,0 +1,43 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_BACKENDS_UDEV_UDEVDEVICECACHE_H
+#define SOLID_BACKENDS_UDEV_UDEVDEVICECACHE_H
+
+#include <QStringList>
+
+#include <optional>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDev
+{
+/**
+ * Optional on-disk snapshot of the device-of-interest list, so short-lived
+ * processes can skip the full udev enumeration when nothing changed since
+ * the list was written. Validity is checked against the kernel's uevent
+ * sequence number (and the boot id, since the sequence restarts at boot):
+ * any uevent at all invalidates the snapshot, which keeps it conservative.
+ *
+ * The cache is opt-in through the SOLID_UDEV_CACHE environment variable.
+ */
+namespace DeviceCache
+{
+/** Whether the persistent cache has been enabled for this process. */
+bool isEnabled();
+/** The cached udi list, or nothing when absent, stale or unreadable. */
+std::optional<QStringList> load();
+/** Writes @p udis with the current generation stamp; best effort. */
+void store(const QStringList &udis);
+
+}
+}
+}
+}
+
+#endif // SOLID_BACKENDS_UDEV_UDEVDEVICECACHE_H
@@ -13,12 +13,7 @@ using namespace Solid::Backends::UDev;
 GenericInterface::GenericInterface(UDevDevice *device)
     : DeviceInterface(device)
 {
-#if 0
-    connect(device, SIGNAL(propertyChanged(QMap<QString,int>)),
-            this, SIGNAL(propertyChanged(QMap<QString,int>)));
-    connect(device, SIGNAL(conditionRaised(QString,QString)),
-            this, SIGNAL(conditionRaised(QString,QString)));
-#endif
+    connect(device, &UDevDevice::propertyChanged, this, &GenericInterface::propertyChanged);
 }
 
 GenericInterface::~GenericInterface()
@@ -7,12 +7,19 @@
 #include "udevmanager.h"
 
 #include "../shared/rootdevice.h"
+#include "../shared/sysfsreader.h"
 #include "udev.h"
+#include "udevchangenotifier.h"
 #include "udevdevice.h"
+#include "udevdevicecache.h"
+
+#include "solidstatistics_p.h"
+#include "solidtrace_p.h"
 
 #include <QDebug>
 #include <QFile>
 #include <QSet>
+#include <QThread>
 
 using namespace Solid::Backends::UDev;
 using namespace Solid::Backends::Shared;
@@ -26,14 +33,74 @@ public:
     bool isOfInterest(const QString &udi, const UdevQt::Device &device);
     bool checkOfInterest(const UdevQt::Device &device);
 
+    static qint64 udiBytes(const QString &udi);
+    void accountVerdict(qint64 delta);
+    void recountVerdicts();
+
+    void startInitialScan();
+    QStringList finishInitialScan();
+
+    void watchSubsystemsFor(Solid::DeviceInterface::Type type);
+    void watchAllSubsystems();
+    static QStringList allSubsystems();
+    /* subsystems a device of @p type can live in; empty means "any" */
+    static QStringList subsystemsForType(Solid::DeviceInterface::Type type);
+
+    bool canMemoizeQuery(Solid::DeviceInterface::Type type) const;
+    void invalidateQueriesFor(const QString &subsystem);
+    void dropDeviceFileMemo(const QString &udi);
+
     UdevQt::Client *m_client;
-    QStringList m_devicesOfInterest;
+    /* verdicts of checkOfInterest() per udi, positive and negative, so the
+     * multi-property probing runs once per device rather than per query */
+    QSet<QString> m_devicesOfInterest;
+    QSet<QString> m_uninterestingDevices;
     QSet<Solid::DeviceInterface::Type> m_supportedInterfaces;
+    /* configured once, cloned for every root device request */
+    RootDevice *m_rootDevice = nullptr;
+    /* monitor filters wanted for the queried types; pushed to the client
+     * only while monitoring is enabled */
+    QStringList m_watchedSubsystems;
+    /* whether the frontend wants hotplug events; while false the netlink
+     * monitor stays down regardless of the watch list above */
+    bool m_monitoringEnabled = false;
+    /* construction-time enumeration running off-thread; the first
+     * allDevices() call adopts its result instead of scanning itself */
+    QThread *m_scanThread = nullptr;
+    QStringList m_scanResult;
+    QSet<QString> m_scanUninteresting;
+    QSet<QString> m_removedDuringScan;
+    /* the verdict set was seeded from the persistent snapshot and the
+     * first allDevices() may serve it without enumerating */
+    bool m_cacheAdopted = false;
+    /* Memoized typed query results: between monitor events a filtered
+     * enumeration cannot change, so repeated queries for the same type are
+     * served from here instead of re-walking sysfs. Only filled while the
+     * monitor covers every subsystem the type can live in; flushed by the
+     * matching uevents. */
+    QHash<int, QStringList> m_queryCache;
+    /* device file → UDI memo for udiFromDeviceFile(). libudev resolves a
+     * devnum in O(1), but each call still pays a stat plus a udev_device
+     * construction; the memo turns repeats into a hash hit. Entries are
+     * only added for devices whose subsystem the monitor watches, so the
+     * matching uevents can retire them. */
+    QHash<QString, QString> m_deviceFileUdis;
+    /* bytes of the verdict sets last published to the statistics counter */
+    qint64 m_accountedBytes = 0;
 };
 
 UDevManager::Private::Private()
 {
-    QStringList subsystems{
+    /* No monitor is armed yet: the watch set grows with the interface
+     * types actually queried (see watchSubsystemsFor), so a process that
+     * only ever asks about processors never wakes up for input or network
+     * uevents. */
+    m_client = new UdevQt::Client;
+}
+
+QStringList UDevManager::Private::allSubsystems()
+{
+    return {
         QStringLiteral("processor"),
         QStringLiteral("cpu"),
         QStringLiteral("sound"),
@@ -43,31 +110,162 @@ UDevManager::Private::Private()
         QStringLiteral("usb"),
         QStringLiteral("input"),
     };
-    m_client = new UdevQt::Client(subsystems);
+}
+
+QStringList UDevManager::Private::subsystemsForType(Solid::DeviceInterface::Type type)
+{
+    switch (type) {
+    case Solid::DeviceInterface::Processor:
+        return {QStringLiteral("processor"), QStringLiteral("cpu")};
+    case Solid::DeviceInterface::Camera:
+    case Solid::DeviceInterface::PortableMediaPlayer:
+        return {QStringLiteral("usb")};
+    default:
+        // Block, GenericInterface and anything unforeseen can match any subsystem
+        return {};
+    }
+}
+
+bool UDevManager::Private::canMemoizeQuery(Solid::DeviceInterface::Type type) const
+{
+    if (!m_monitoringEnabled) {
+        return false; // no events would ever flush a stale entry
+    }
+
+    const QStringList needed = subsystemsForType(type);
+    if (needed.isEmpty()) {
+        // results can come from anywhere; only the full watch set covers that
+        return m_watchedSubsystems.size() == allSubsystems().size();
+    }
+
+    for (const QString &subsystem : needed) {
+        if (!m_watchedSubsystems.contains(subsystem)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UDevManager::Private::dropDeviceFileMemo(const QString &udi)
+{
+    for (auto it = m_deviceFileUdis.begin(); it != m_deviceFileUdis.end();) {
+        if (it.value() == udi) {
+            it = m_deviceFileUdis.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UDevManager::Private::invalidateQueriesFor(const QString &subsystem)
+{
+    for (auto it = m_queryCache.begin(); it != m_queryCache.end();) {
+        const QStringList needed = subsystemsForType(Solid::DeviceInterface::Type(it.key()));
+        if (needed.isEmpty() || needed.contains(subsystem)) {
+            it = m_queryCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UDevManager::Private::watchSubsystemsFor(Solid::DeviceInterface::Type type)
+{
+    if (type == Solid::DeviceInterface::Block) {
+        // block events were never watched; Block queries only enumerate
+        return;
+    }
+
+    const QStringList needed = subsystemsForType(type);
+    if (needed.isEmpty()) {
+        // GenericInterface and anything unforeseen can match any subsystem
+        watchAllSubsystems();
+        return;
+    }
+
+    QStringList armed = m_watchedSubsystems;
+    for (const QString &subsystem : std::as_const(needed)) {
+        if (!armed.contains(subsystem)) {
+            armed << subsystem;
+        }
+    }
+    if (armed.size() != m_watchedSubsystems.size()) {
+        m_watchedSubsystems = armed;
+        if (m_monitoringEnabled) {
+            m_client->setWatchedSubsystems(armed);
+        }
+    }
+}
+
+void UDevManager::Private::watchAllSubsystems()
+{
+    const QStringList all = allSubsystems();
+    if (m_watchedSubsystems.size() != all.size()) {
+        m_watchedSubsystems = all;
+        if (m_monitoringEnabled) {
+            m_client->setWatchedSubsystems(all);
+        }
+    }
 }
 
 UDevManager::Private::~Private()
 {
+    accountVerdict(-m_accountedBytes);
+    delete m_rootDevice;
     delete m_client;
 }
 
+/* The verdict sets hold one interned udi string apiece; charge the payload
+ * plus a flat guess at QSet node overhead. */
+qint64 UDevManager::Private::udiBytes(const QString &udi)
+{
+    return Solid::Stats::stringBytes(udi) + qint64(4 * sizeof(void *));
+}
+
+void UDevManager::Private::accountVerdict(qint64 delta)
+{
+    m_accountedBytes += delta;
+    Solid::Stats::add(Solid::Stats::counters().udevDeviceListBytes, delta);
+}
+
+void UDevManager::Private::recountVerdicts()
+{
+    qint64 bytes = 0;
+    for (const QString &udi : std::as_const(m_devicesOfInterest)) {
+        bytes += udiBytes(udi);
+    }
+    for (const QString &udi : std::as_const(m_uninterestingDevices)) {
+        bytes += udiBytes(udi);
+    }
+    accountVerdict(bytes - m_accountedBytes);
+}
+
 bool UDevManager::Private::isOfInterest(const QString &udi, const UdevQt::Device &device)
 {
     if (m_devicesOfInterest.contains(udi)) {
         return true;
     }
+    if (m_uninterestingDevices.contains(udi)) {
+        return false;
+    }
 
-    bool isOfInterest = checkOfInterest(device);
+    const bool isOfInterest = checkOfInterest(device);
     if (isOfInterest) {
-        m_devicesOfInterest.append(udi);
+        m_devicesOfInterest.insert(udi);
+    } else {
+        m_uninterestingDevices.insert(udi);
     }
+    accountVerdict(udiBytes(udi));
 
     return isOfInterest;
 }
 
 bool UDevManager::Private::checkOfInterest(const UdevQt::Device &device)
 {
-    const QString subsystem = device.subsystem();
+    /* This runs for every device of a full enumeration, so it sticks to the
+     * zero-copy views over libudev's property block instead of converting
+     * each value to a QString/QVariant. */
+    const QLatin1String subsystem = device.subsystemView();
 #ifdef UDEV_DETAILED_OUTPUT
     qDebug() << "<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<";
     qDebug() << "Path:" << device.sysfsPath();
@@ -85,32 +283,31 @@ bool UDevManager::Private::checkOfInterest(const UdevQt::Device &device)
     if (subsystem == QLatin1String("cpu")) {
         // Linux ACPI reports processor slots, rather than processors.
         // Empty slots will not have a system device associated with them.
-        return QFile::exists(device.sysfsPath() + QStringLiteral("/sysdev")) //
-            || QFile::exists(device.sysfsPath() + QStringLiteral("/cpufreq")) //
-            || QFile::exists(device.sysfsPath() + QStringLiteral("/topology/core_id"));
+        const SysfsReader sysfs(device.sysfsPath());
+        return sysfs.exists("sysdev") //
+            || sysfs.exists("cpufreq") //
+            || sysfs.exists("topology/core_id");
     }
-    if (subsystem == QLatin1String("sound") && device.deviceProperty(QStringLiteral("SOUND_FORM_FACTOR")).toString() != QStringLiteral("internal")) {
+    if (subsystem == QLatin1String("sound") && device.devicePropertyView("SOUND_FORM_FACTOR") != QLatin1String("internal")) {
         return true;
     }
 
     if (subsystem == QLatin1String("tty")) {
-        QString path = device.deviceProperty(QStringLiteral("DEVPATH")).toString();
-
-        int lastSlash = path.length() - path.lastIndexOf(QLatin1String("/")) - 1;
-        QByteArray lastElement = path.right(lastSlash).toLatin1();
+        const QLatin1String path = device.devicePropertyView("DEVPATH");
+        const QLatin1String lastElement = path.mid(path.lastIndexOf(QLatin1Char('/')) + 1);
 
-        if (lastElement.startsWith("tty") && !path.startsWith(QStringLiteral("/devices/virtual"))) {
+        if (lastElement.startsWith(QLatin1String("tty")) && !path.startsWith(QLatin1String("/devices/virtual"))) {
             return true;
         }
     }
 
     if (subsystem == QLatin1String("input")) {
         /* clang-format off */
-        if (device.deviceProperty(QStringLiteral("ID_INPUT_MOUSE")).toInt() == 1
-            || device.deviceProperty(QStringLiteral("ID_INPUT_TOUCHPAD")).toInt() == 1
-            || device.deviceProperty(QStringLiteral("ID_INPUT_TABLET")).toInt() == 1
-            || device.deviceProperty(QStringLiteral("ID_INPUT_JOYSTICK")).toInt() == 1
-            || device.deviceProperty(QStringLiteral("ID_INPUT_TOUCHSCREEN")).toInt() == 1) { /* clang-format on */
+        if (device.devicePropertyView("ID_INPUT_MOUSE") == QLatin1String("1")
+            || device.devicePropertyView("ID_INPUT_TOUCHPAD") == QLatin1String("1")
+            || device.devicePropertyView("ID_INPUT_TABLET") == QLatin1String("1")
+            || device.devicePropertyView("ID_INPUT_JOYSTICK") == QLatin1String("1")
+            || device.devicePropertyView("ID_INPUT_TOUCHSCREEN") == QLatin1String("1")) { /* clang-format on */
             return true;
         }
     }
@@ -118,19 +315,94 @@ bool UDevManager::Private::checkOfInterest(const UdevQt::Device &device)
     /* clang-format off */
     return subsystem == QLatin1String("dvb")
         || subsystem == QLatin1String("net")
-        || (!device.deviceProperty(QStringLiteral("ID_MEDIA_PLAYER")).toString().isEmpty()
-            && device.parent().deviceProperty(QStringLiteral("ID_MEDIA_PLAYER")).toString().isEmpty()) // media-player-info recognized devices
-        || (device.deviceProperty(QStringLiteral("ID_GPHOTO2")).toInt() == 1
-            && device.parent().deviceProperty(QStringLiteral("ID_GPHOTO2")).toInt() != 1); // GPhoto2 cameras
+        || (!device.devicePropertyView("ID_MEDIA_PLAYER").isEmpty()
+            && device.parent().devicePropertyView("ID_MEDIA_PLAYER").isEmpty()) // media-player-info recognized devices
+        || (device.devicePropertyView("ID_GPHOTO2") == QLatin1String("1")
+            && device.parent().devicePropertyView("ID_GPHOTO2") != QLatin1String("1")); // GPhoto2 cameras
     /* clang-format on */
 }
 
+void UDevManager::Private::startInitialScan()
+{
+    /* With the opt-in persistent cache and no uevent since it was written,
+     * the snapshot is still the answer a full scan would produce; adopt it
+     * and skip the enumeration entirely. */
+    if (const std::optional<QStringList> cached = DeviceCache::load()) {
+        for (const QString &udi : *cached) {
+            m_devicesOfInterest.insert(udi);
+        }
+        recountVerdicts();
+        m_cacheAdopted = true;
+        return;
+    }
+
+    m_scanThread = QThread::create([this]() {
+        /* A private client with its own libudev context: libudev refcounts
+         * are not atomic, so nothing created here may be shared with the
+         * main thread. Only the computed verdicts cross over. */
+        UdevQt::Client client;
+        const QString prefix = QString::fromLatin1(UDEV_UDI_PREFIX);
+        const UdevQt::DeviceList deviceList = client.allDevices();
+        for (const UdevQt::Device &device : deviceList) {
+            const QString &udi = device.udi(prefix);
+            if (checkOfInterest(device)) {
+                m_scanResult << udi;
+            } else {
+                m_scanUninteresting.insert(udi);
+            }
+        }
+    });
+    m_scanThread->start();
+}
+
+QStringList UDevManager::Private::finishInitialScan()
+{
+    m_scanThread->wait();
+    delete m_scanThread;
+    m_scanThread = nullptr;
+
+    /* Hotplug events that raced the scan have already updated the verdict
+     * sets and are more current than the scan, so they win the merge. */
+    for (const QString &udi : std::as_const(m_scanResult)) {
+        if (!m_uninterestingDevices.contains(udi) && !m_removedDuringScan.contains(udi)) {
+            m_devicesOfInterest.insert(udi);
+        }
+    }
+    for (const QString &udi : std::as_const(m_scanUninteresting)) {
+        if (!m_devicesOfInterest.contains(udi) && !m_removedDuringScan.contains(udi)) {
+            m_uninterestingDevices.insert(udi);
+        }
+    }
+    m_scanResult.clear();
+    m_scanUninteresting.clear();
+    recountVerdicts();
+    m_removedDuringScan.clear();
+
+    QStringList result;
+    result.reserve(m_devicesOfInterest.size());
+    for (const QString &udi : std::as_const(m_devicesOfInterest)) {
+        result << udi;
+    }
+    DeviceCache::store(result);
+    return result;
+}
+
 UDevManager::UDevManager(QObject *parent)
     : Solid::Ifaces::DeviceManager(parent)
     , d(new Private)
 {
     connect(d->m_client, SIGNAL(deviceAdded(UdevQt::Device)), this, SLOT(slotDeviceAdded(UdevQt::Device)));
     connect(d->m_client, SIGNAL(deviceRemoved(UdevQt::Device)), this, SLOT(slotDeviceRemoved(UdevQt::Device)));
+    connect(d->m_client, SIGNAL(deviceChanged(UdevQt::Device)), this, SLOT(slotDeviceChanged(UdevQt::Device)));
+    /* online/offline flip properties too (e.g. a network interface's state);
+     * treat them exactly like change events */
+    connect(d->m_client, SIGNAL(deviceOnlined(UdevQt::Device)), this, SLOT(slotDeviceChanged(UdevQt::Device)));
+    connect(d->m_client, SIGNAL(deviceOfflined(UdevQt::Device)), this, SLOT(slotDeviceChanged(UdevQt::Device)));
+    connect(d->m_client, SIGNAL(monitorOverflowed()), this, SLOT(slotMonitorOverflowed()));
+
+    // kick the expensive full enumeration off the constructing
+    // (usually GUI) thread right away
+    d->startInitialScan();
 
     // clang-format off
     d->m_supportedInterfaces << Solid::DeviceInterface::GenericInterface
@@ -143,6 +415,10 @@ UDevManager::UDevManager(QObject *parent)
 
 UDevManager::~UDevManager()
 {
+    if (d->m_scanThread) {
+        d->m_scanThread->wait();
+        delete d->m_scanThread;
+    }
     delete d;
 }
 
@@ -158,35 +434,92 @@ QSet<Solid::DeviceInterface::Type> UDevManager::supportedInterfaces() const
 
 QStringList UDevManager::allDevices()
 {
+    // untyped enumeration implies interest in everything we can report
+    d->watchAllSubsystems();
+
+    if (d->m_scanThread) {
+        /* first enumeration: adopt the snapshot the construction-time scan
+         * produced, blocking only this caller for whatever remains of it */
+        return d->finishInitialScan();
+    }
+
+    if (d->m_cacheAdopted) {
+        /* One shot: the adopted snapshot is complete right now, but from
+         * here on only the armed subsystems keep the verdict set current,
+         * so later calls enumerate as usual. */
+        d->m_cacheAdopted = false;
+        QStringList res;
+        res.reserve(d->m_devicesOfInterest.size());
+        for (const QString &udi : std::as_const(d->m_devicesOfInterest)) {
+            res << udi;
+        }
+        return res;
+    }
+
+    const Solid::Trace::Timer traceTimer;
     QStringList res;
+    const QString prefix = udiPrefix();
     const UdevQt::DeviceList deviceList = d->m_client->allDevices();
     for (const UdevQt::Device &device : deviceList) {
-        if (d->isOfInterest(udiPrefix() + device.sysfsPath(), device)) {
-            res << udiPrefix() + device.sysfsPath();
+        const QString &udi = device.udi(prefix);
+        if (d->isOfInterest(udi, device)) {
+            res << udi;
         }
     }
+    DeviceCache::store(res);
+    Solid::Stats::add(Solid::Stats::counters().udevEnumerations);
+    SOLID_TRACE2(udev_enumerate, res.size(), traceTimer.nsecs());
     return res;
 }
 
+qsizetype UDevManager::countFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
+{
+    /* While the construction-time snapshot is still complete, an untyped
+     * count is just the size of the verdict set; no udev enumeration. The
+     * check deliberately leaves the one-shot m_cacheAdopted flag alone so
+     * the first real enumeration can still consume it. */
+    if (parentUdi.isEmpty() && type == Solid::DeviceInterface::Unknown && !d->m_scanThread && d->m_cacheAdopted) {
+        return d->m_devicesOfInterest.size();
+    }
+
+    return Solid::Ifaces::DeviceManager::countFromQuery(parentUdi, type);
+}
+
 QStringList UDevManager::devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
 {
     QStringList result;
 
+    if (type != DeviceInterface::Unknown) {
+        // a typed query is our subscription signal: arm the monitor for the
+        // subsystems this type can live in, keeping whatever is armed already
+        d->watchSubsystemsFor(type);
+    }
+
     if (!parentUdi.isEmpty()) {
-        const UdevQt::DeviceList deviceList = d->m_client->allDevices();
-        for (const UdevQt::Device &dev : deviceList) {
-            UDevDevice device(dev);
-            if (device.queryDeviceInterface(type) && d->isOfInterest(udiPrefix() + dev.sysfsPath(), dev) && device.parentUdi() == parentUdi) {
-                result << udiPrefix() + dev.sysfsPath();
-            }
+        /* Our device tree is flat: every device reports the root as its
+         * parent (see UDevDevice::parentUdi()). Any other parent matches
+         * nothing, and the root parent is just the plain typed query; no
+         * need to enumerate every subsystem to find that out. */
+        if (parentUdi != udiPrefix()) {
+            return result;
         }
-        return result;
+        return devicesFromQuery(QString(), type);
     }
 
     if (type == DeviceInterface::Unknown) {
         return allDevices();
     }
 
+    /* between monitor events the filtered enumeration below cannot change;
+     * serve repeats from the memo while the monitor covers the type */
+    const bool memoizable = d->canMemoizeQuery(type);
+    if (memoizable) {
+        const auto it = d->m_queryCache.constFind(type);
+        if (it != d->m_queryCache.cend()) {
+            return *it;
+        }
+    }
+
     UdevQt::DeviceList deviceList;
 
     // Already limit the number of devices we query and have to create wrapper items for here
@@ -199,30 +532,65 @@ QStringList UDevManager::devicesFromQuery(const QString &parentUdi, Solid::Devic
     } else if (type == Solid::DeviceInterface::PortableMediaPlayer) {
         deviceList = d->m_client->devicesBySubsystemsAndProperties({QStringLiteral("usb")}, //
                                                                    {{QStringLiteral("ID_MEDIA_PLAYER"), QStringLiteral("*")}}); // match any
+    } else if (type == Solid::DeviceInterface::Block) {
+        // anything with a device node, mirroring queryDeviceInterface(Block)
+        deviceList = d->m_client->devicesByProperty(QStringLiteral("MAJOR"), QStringLiteral("*")); // match any
     } else {
         deviceList = d->m_client->allDevices();
     }
 
+    const QString prefix = udiPrefix();
     for (const UdevQt::Device &dev : std::as_const(deviceList)) {
         UDevDevice device(dev);
         if (device.queryDeviceInterface(type) //
-            && d->isOfInterest(udiPrefix() + dev.sysfsPath(), dev)) {
-            result << udiPrefix() + dev.sysfsPath();
+            && d->isOfInterest(dev.udi(prefix), dev)) {
+            result << dev.udi(prefix);
         }
     }
 
+    if (memoizable) {
+        d->m_queryCache.insert(type, result);
+    }
+
     return result;
 }
 
+QString UDevManager::udiFromDeviceFile(const QString &deviceFile)
+{
+    const auto memo = d->m_deviceFileUdis.constFind(deviceFile);
+    if (memo != d->m_deviceFileUdis.cend()) {
+        return *memo;
+    }
+
+    // direct devnum lookup instead of enumerating and comparing node paths
+    const UdevQt::Device device = d->m_client->deviceByDeviceFile(deviceFile);
+
+    if (device.isValid() && d->isOfInterest(device.udi(udiPrefix()), device)) {
+        const QString &udi = device.udi(udiPrefix());
+        /* memoize only while the corresponding uevents can retire the entry;
+         * the node may belong to a different device after a replug */
+        if (d->m_monitoringEnabled && d->m_watchedSubsystems.contains(device.subsystem())) {
+            d->m_deviceFileUdis.insert(deviceFile, udi);
+        }
+        return udi;
+    }
+
+    return QString();
+}
+
 QObject *UDevManager::createDevice(const QString &udi_)
 {
     if (udi_ == udiPrefix()) {
-        RootDevice *const device = new RootDevice(QStringLiteral(UDEV_UDI_PREFIX));
-        device->setProduct(tr("Devices"));
-        device->setDescription(tr("Devices declared in your system"));
-        device->setIcon(QStringLiteral("computer"));
+        // hand out clones of a one-time prototype; see the rationale in
+        // Shared::RootDevice::clone()
+        if (!d->m_rootDevice) {
+            d->m_rootDevice = new RootDevice(QStringLiteral(UDEV_UDI_PREFIX));
+            d->m_rootDevice->setProduct(tr("Devices"));
+            d->m_rootDevice->setDescription(tr("Devices declared in your system"));
+            d->m_rootDevice->setIcon(QStringLiteral("computer"));
+        }
 
-        return device;
+        return d->m_rootDevice->clone();
     }
 
     const QString udi = udi_.right(udi_.size() - udiPrefix().size());
@@ -237,16 +605,122 @@ QObject *UDevManager::createDevice(const QString &udi_)
 
 void UDevManager::slotDeviceAdded(const UdevQt::Device &device)
 {
-    if (d->isOfInterest(udiPrefix() + device.sysfsPath(), device)) {
-        Q_EMIT deviceAdded(udiPrefix() + device.sysfsPath());
+    const QString &udi = device.udi(udiPrefix());
+
+    // a re-added device may not match the verdict cached for its last life
+    if (d->m_uninterestingDevices.remove(udi)) {
+        d->accountVerdict(-Private::udiBytes(udi));
+    }
+    d->invalidateQueriesFor(device.subsystem());
+
+    if (d->isOfInterest(udi, device)) {
+        Q_EMIT deviceAdded(udi);
     }
 }
 
 void UDevManager::slotDeviceRemoved(const UdevQt::Device &device)
 {
-    if (d->isOfInterest(udiPrefix() + device.sysfsPath(), device)) {
-        Q_EMIT deviceRemoved(udiPrefix() + device.sysfsPath());
-        d->m_devicesOfInterest.removeAll(udiPrefix() + device.sysfsPath());
+    const QString &udi = device.udi(udiPrefix());
+
+    if (d->isOfInterest(udi, device)) {
+        Q_EMIT deviceRemoved(udi);
+    }
+    if (d->m_devicesOfInterest.remove(udi)) {
+        d->accountVerdict(-Private::udiBytes(udi));
+    }
+    if (d->m_uninterestingDevices.remove(udi)) {
+        d->accountVerdict(-Private::udiBytes(udi));
+    }
+    if (d->m_scanThread) {
+        // keep the in-flight initial scan from resurrecting this device
+        d->m_removedDuringScan.insert(udi);
+    }
+    d->invalidateQueriesFor(device.subsystem());
+    d->dropDeviceFileMemo(udi);
+}
+
+void UDevManager::slotDeviceChanged(const UdevQt::Device &device)
+{
+    // property changes can flip either verdict; re-evaluate on the next query
+    const QString &udi = device.udi(udiPrefix());
+    if (d->m_devicesOfInterest.remove(udi)) {
+        d->accountVerdict(-Private::udiBytes(udi));
+    }
+    if (d->m_uninterestingDevices.remove(udi)) {
+        d->accountVerdict(-Private::udiBytes(udi));
+    }
+    d->invalidateQueriesFor(device.subsystem());
+    d->dropDeviceFileMemo(udi); // the node name itself may have moved
+
+    /* the event device carries the current property state; hand it to the
+     * live wrappers so their snapshots refresh in place */
+    ChangeNotifier::instance()->announce(udi, device);
+}
+
+void UDevManager::setMonitoringEnabled(bool enabled)
+{
+    if (d->m_monitoringEnabled == enabled) {
+        return;
+    }
+    d->m_monitoringEnabled = enabled;
+
+    /* memoized queries rely on an armed monitor to stay fresh, and events
+     * missed across the transition would never flush them */
+    d->m_queryCache.clear();
+    d->m_deviceFileUdis.clear();
+
+    /* An empty watch list means no typed query ever needed events, and the
+     * client treats it as "listen to everything" anyway; so the monitor
+     * only exists while monitoring is enabled AND filters are wanted. */
+    if (!enabled) {
+        if (!d->m_watchedSubsystems.isEmpty()) {
+            d->m_client->stopWatching();
+        }
+        return;
+    }
+
+    if (!d->m_watchedSubsystems.isEmpty()) {
+        d->m_client->setWatchedSubsystems(d->m_watchedSubsystems);
+
+        /* whatever happened between the last enumeration and now was never
+         * delivered; reconcile exactly like after a buffer overrun */
+        if (!d->m_devicesOfInterest.isEmpty() || !d->m_uninterestingDevices.isEmpty()) {
+            slotMonitorOverflowed();
+        }
+    }
+}
+
+void UDevManager::slotMonitorOverflowed()
+{
+    /* The kernel dropped an unknown number of events, so our interest list
+     * and our listeners' device sets may both be stale. Reconcile them
+     * against a fresh enumeration, emitting only the net difference. */
+    const QSet<QString> previous = d->m_devicesOfInterest;
+    d->m_queryCache.clear();
+    d->m_deviceFileUdis.clear();
+
+    QSet<QString> current;
+    const QString prefix = udiPrefix();
+    const UdevQt::DeviceList deviceList = d->m_client->allDevices();
+    for (const UdevQt::Device &device : deviceList) {
+        if (d->checkOfInterest(device)) {
+            current << device.udi(prefix);
+        }
+    }
+
+    d->m_devicesOfInterest = current;
+    d->m_uninterestingDevices.clear();
+    d->recountVerdicts();
+
+    for (const QString &udi : previous) {
+        if (!current.contains(udi)) {
+            Q_EMIT deviceRemoved(udi);
+        }
+    }
+    for (const QString &udi : std::as_const(current)) {
+        if (!previous.contains(udi)) {
+            Q_EMIT deviceAdded(udi);
+        }
     }
 }
 
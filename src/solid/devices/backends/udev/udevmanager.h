@@ -31,12 +31,19 @@ public:
     QStringList allDevices() override;
 
     QStringList devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type) override;
+    qsizetype countFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type) override;
+
+    QString udiFromDeviceFile(const QString &deviceFile) override;
 
     QObject *createDevice(const QString &udi) override;
 
+    void setMonitoringEnabled(bool enabled) override;
+
 private Q_SLOTS:
     void slotDeviceAdded(const UdevQt::Device &device);
     void slotDeviceRemoved(const UdevQt::Device &device);
+    void slotDeviceChanged(const UdevQt::Device &device);
+    void slotMonitorOverflowed();
 
 private:
     class Private;
@@ -9,8 +9,11 @@
 #include "udevportablemediaplayer.h"
 
 #include <QChar>
+#include <QDateTime>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QTextStream>
 #include <qstandardpaths.h>
 
@@ -52,6 +55,83 @@ static QString readMpiValue(QIODevice &file, const QString &group, const QString
     return QString();
 }
 
+/**
+ * Process-wide cache of media-player-info lookups, shared by all
+ * PortableMediaPlayer instances.
+ *
+ * The database is a directory of small ini-like files that only changes
+ * when the package is updated, yet every query used to walk the XDG data
+ * directories and re-parse its file. Resolved protocol lists are kept
+ * keyed by player name and revalidated against the database directories'
+ * mtimes, so a package update is picked up without restarting.
+ */
+class MpiDatabase
+{
+public:
+    QStringList accessProtocols(const QString &playerName);
+
+private:
+    void revalidate();
+
+    QDateTime m_stamp;
+    QHash<QString, QStringList> m_protocols;
+};
+
+Q_GLOBAL_STATIC(MpiDatabase, s_mpiDatabase)
+
+void MpiDatabase::revalidate()
+{
+    /* newest mtime across the media-player-info directories; an update
+     * touches its directory, which flushes everything */
+    QDateTime stamp;
+    const QStringList dataDirs = QStandardPaths::standardLocations(QStandardPaths::GenericDataLocation);
+    for (const QString &dir : dataDirs) {
+        const QFileInfo info(dir + QLatin1String("/media-player-info"));
+        if (info.exists() && (!stamp.isValid() || info.lastModified() > stamp)) {
+            stamp = info.lastModified();
+        }
+    }
+
+    if (stamp != m_stamp) {
+        m_stamp = stamp;
+        m_protocols.clear();
+    }
+}
+
+QStringList MpiDatabase::accessProtocols(const QString &playerName)
+{
+    revalidate();
+
+    const auto memo = m_protocols.constFind(playerName);
+    if (memo != m_protocols.cend()) {
+        return *memo;
+    }
+
+    QStringList protocols;
+    const QString relativeFilename = QLatin1String("media-player-info/") + playerName + QLatin1String(".mpi");
+    const QString fileName = QStandardPaths::locate(QStandardPaths::GenericDataLocation, relativeFilename);
+    if (fileName.isEmpty()) {
+        qWarning() << "media player info file" << relativeFilename << "not found under user and"
+                   << "system XDG data directories. Do you have media-player-info installed?";
+    } else {
+        // we unfornutately cannot use QSettings as it cannot read unquoted valued with semicolons in it
+        QFile mpiFile(fileName);
+        if (!mpiFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            qWarning() << "Cannot open" << fileName << "for reading."
+                       << "Check your media-player-info installation.";
+        } else {
+            const QString value = readMpiValue(mpiFile, QStringLiteral("Device"), QStringLiteral("AccessProtocol"));
+            protocols = value.split(QLatin1Char(';'), Qt::SkipEmptyParts);
+        }
+    }
+
+    /* misses are cached too: the warnings above fire once per player, and
+     * the revalidation stamp flushes the entry if media-player-info gets
+     * installed later */
+    m_protocols.insert(playerName, protocols);
+    return protocols;
+}
+
 PortableMediaPlayer::PortableMediaPlayer(UDevDevice *device)
     : DeviceInterface(device)
 {
@@ -74,19 +154,12 @@ QStringList PortableMediaPlayer::supportedProtocols() const
         return {QStringLiteral("mtp")};
     }
 
-    QString mpiFileName = mediaPlayerInfoFilePath();
-    if (mpiFileName.isEmpty()) {
-        return QStringList();
-    }
-    // we unfornutately cannot use QSettings as it cannot read unquoted valued with semicolons in it
-    QFile mpiFile(mpiFileName);
-    if (!mpiFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qWarning() << "Cannot open" << mpiFileName << "for reading."
-                   << "Check your media-player-info installation.";
+    const QString playerName = m_device->property(QStringLiteral("ID_MEDIA_PLAYER")).toString();
+    if (playerName.isEmpty()) {
+        qWarning() << "We attached PortableMediaPlayer interface to device" << m_device->udi() << "but m_device->property(\"ID_MEDIA_PLAYER\") is empty???";
         return QStringList();
     }
-    QString value = readMpiValue(mpiFile, QStringLiteral("Device"), QStringLiteral("AccessProtocol"));
-    return value.split(QLatin1Char(';'), Qt::SkipEmptyParts);
+    return s_mpiDatabase()->accessProtocols(playerName);
 }
 
 QStringList PortableMediaPlayer::supportedDrivers(QString protocol) const
@@ -111,21 +184,4 @@ QVariant PortableMediaPlayer::driverHandle(const QString &driver) const
     return QVariant();
 }
 
-QString PortableMediaPlayer::mediaPlayerInfoFilePath() const
-{
-    QString relativeFilename = m_device->property(QStringLiteral("ID_MEDIA_PLAYER")).toString();
-    if (relativeFilename.isEmpty()) {
-        qWarning() << "We attached PortableMediaPlayer interface to device" << m_device->udi() << "but m_device->property(\"ID_MEDIA_PLAYER\") is empty???";
-        return QString();
-    }
-    relativeFilename.prepend(QStringLiteral("media-player-info/"));
-    relativeFilename.append(QStringLiteral(".mpi"));
-    QString filename = QStandardPaths::locate(QStandardPaths::GenericDataLocation, relativeFilename);
-    if (filename.isEmpty()) {
-        qWarning() << "media player info file" << relativeFilename << "not found under user and"
-                   << "system XDG data directories. Do you have media-player-info installed?";
-    }
-    return filename;
-}
-
 #include "moc_udevportablemediaplayer.cpp"
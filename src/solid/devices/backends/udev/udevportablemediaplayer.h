@@ -32,14 +32,6 @@ public:
     QStringList supportedProtocols() const override;
     QStringList supportedDrivers(QString protocol = QString()) const override;
     QVariant driverHandle(const QString &driver) const override;
-
-private:
-    /**
-     * Return full absolute path to media-player-info .mpi file, based on ID_MEDIA_PLAYER
-     * udev property. Does not check for existence. Returns empty string in case no reasonable
-     * file path could be determined.
-     */
-    QString mediaPlayerInfoFilePath() const;
 };
 }
 }
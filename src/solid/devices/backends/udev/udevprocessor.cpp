@@ -7,12 +7,13 @@
 #include "udevprocessor.h"
 
 #include "../shared/cpufeatures.h"
+#include "../shared/sysfsreader.h"
 #include "cpuinfo.h"
+#include "cputopology.h"
 #include "udevdevice.h"
 
-#include <QFile>
-
 using namespace Solid::Backends::UDev;
+using Solid::Backends::Shared::SysfsReader;
 
 Processor::Processor(UDevDevice *device)
     : DeviceInterface(device)
@@ -37,9 +38,9 @@ int Processor::number() const
 int Processor::maxSpeed() const
 {
     if (m_maxSpeed == -1) {
-        QFile cpuMaxFreqFile(m_device->deviceName() + prefix() + QStringLiteral("/cpufreq/cpuinfo_max_freq"));
-        if (cpuMaxFreqFile.open(QIODevice::ReadOnly)) {
-            QByteArray value = cpuMaxFreqFile.readAll().trimmed();
+        const SysfsReader sysfs(m_device->deviceName() + prefix());
+        const QByteArray value = sysfs.read("cpufreq/cpuinfo_max_freq");
+        if (!value.isEmpty()) {
             // cpuinfo_max_freq is in kHz
             m_maxSpeed = static_cast<int>(value.toLongLong() / 1000);
         }
@@ -59,14 +60,11 @@ bool Processor::canChangeFrequency() const
 
         m_canChangeFrequency = CannotChangeFreq;
 
-        QFile cpuMinFreqFile(m_device->deviceName() + prefix() + QStringLiteral("/cpufreq/cpuinfo_min_freq"));
-        QFile cpuMaxFreqFile(m_device->deviceName() + prefix() + QStringLiteral("/cpufreq/cpuinfo_max_freq"));
-        if (cpuMinFreqFile.open(QIODevice::ReadOnly) && cpuMaxFreqFile.open(QIODevice::ReadOnly)) {
-            qlonglong minFreq = cpuMinFreqFile.readAll().trimmed().toLongLong();
-            qlonglong maxFreq = cpuMaxFreqFile.readAll().trimmed().toLongLong();
-            if (minFreq > 0 && maxFreq > minFreq) {
-                m_canChangeFrequency = CanChangeFreq;
-            }
+        const SysfsReader sysfs(m_device->deviceName() + prefix());
+        const qlonglong minFreq = sysfs.read("cpufreq/cpuinfo_min_freq").toLongLong();
+        const qlonglong maxFreq = sysfs.read("cpufreq/cpuinfo_max_freq").toLongLong();
+        if (minFreq > 0 && maxFreq > minFreq) {
+            m_canChangeFrequency = CanChangeFreq;
         }
     }
 
@@ -75,16 +73,35 @@ bool Processor::canChangeFrequency() const
 
 Solid::Processor::InstructionSets Processor::instructionSets() const
 {
-    static Solid::Processor::InstructionSets cpuextensions = Solid::Backends::Shared::cpuFeatures();
+    // cpuFeatures() caches the detected mask process-wide
+    return Solid::Backends::Shared::cpuFeatures();
+}
+
+int Processor::packageId() const
+{
+    return processorPackageId(number());
+}
+
+int Processor::coreId() const
+{
+    return processorCoreId(number());
+}
+
+QList<int> Processor::threadSiblings() const
+{
+    return processorThreadSiblings(number());
+}
 
-    return cpuextensions;
+QList<int> Processor::cacheSiblings(int level) const
+{
+    return processorCacheSiblings(number(), level);
 }
 
 QString Processor::prefix() const
 {
-    QLatin1String sysPrefix("/sysdev");
-    if (QFile::exists(m_device->deviceName() + sysPrefix)) {
-        return sysPrefix;
+    const SysfsReader sysfs(m_device->deviceName());
+    if (sysfs.exists("sysdev")) {
+        return QStringLiteral("/sysdev");
     }
 
     return QString();
@@ -31,6 +31,10 @@ public:
     int maxSpeed() const override;
     bool canChangeFrequency() const override;
     Solid::Processor::InstructionSets instructionSets() const override;
+    int packageId() const override;
+    int coreId() const override;
+    QList<int> threadSiblings() const override;
+    QList<int> cacheSiblings(int level) const override;
 
 private:
     enum CanChangeFrequencyEnum {
@@ -0,0 +1,126 @@
+/*
+ * This file was generated by qdbusxml2cpp version 0.7
+ * Command line was: qdbusxml2cpp -p interfaces interfaces.xml
+ *
+ * qdbusxml2cpp is Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * This is an auto-generated file.
+ * This file may have been hand-edited. Look for HAND-EDIT comments
+ * before re-generating it.
+ */
+
+#include "interfaces.h"
+
+/*
+ * Implementation of interface class OrgFreedesktopDBusPropertiesInterface
+ */
+
+OrgFreedesktopDBusPropertiesInterface::OrgFreedesktopDBusPropertiesInterface(const QString &service,
+                                                                             const QString &path,
+                                                                             const QDBusConnection &connection,
+                                                                             QObject *parent)
+    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+{
+}
+
+OrgFreedesktopDBusPropertiesInterface::~OrgFreedesktopDBusPropertiesInterface()
+{
+}
+
+/*
+ * Implementation of interface class OrgFreedesktopDBusIntrospectableInterface
+ */
+
+OrgFreedesktopDBusIntrospectableInterface::OrgFreedesktopDBusIntrospectableInterface(const QString &service,
+                                                                                     const QString &path,
+                                                                                     const QDBusConnection &connection,
+                                                                                     QObject *parent)
+    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+{
+}
+
+OrgFreedesktopDBusIntrospectableInterface::~OrgFreedesktopDBusIntrospectableInterface()
+{
+}
+
+/*
+ * Implementation of interface class OrgFreedesktopUDisks2ManagerInterface
+ */
+
+OrgFreedesktopUDisks2ManagerInterface::OrgFreedesktopUDisks2ManagerInterface(const QString &service,
+                                                                             const QString &path,
+                                                                             const QDBusConnection &connection,
+                                                                             QObject *parent)
+    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+{
+}
+
+OrgFreedesktopUDisks2ManagerInterface::~OrgFreedesktopUDisks2ManagerInterface()
+{
+}
+
+/*
+ * Implementation of interface class OrgFreedesktopUDisks2BlockInterface
+ */
+
+OrgFreedesktopUDisks2BlockInterface::OrgFreedesktopUDisks2BlockInterface(const QString &service,
+                                                                         const QString &path,
+                                                                         const QDBusConnection &connection,
+                                                                         QObject *parent)
+    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+{
+}
+
+OrgFreedesktopUDisks2BlockInterface::~OrgFreedesktopUDisks2BlockInterface()
+{
+}
+
+/*
+ * Implementation of interface class OrgFreedesktopUDisks2FilesystemInterface
+ */
+
+OrgFreedesktopUDisks2FilesystemInterface::OrgFreedesktopUDisks2FilesystemInterface(const QString &service,
+                                                                                   const QString &path,
+                                                                                   const QDBusConnection &connection,
+                                                                                   QObject *parent)
+    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+{
+}
+
+OrgFreedesktopUDisks2FilesystemInterface::~OrgFreedesktopUDisks2FilesystemInterface()
+{
+}
+
+/*
+ * Implementation of interface class OrgFreedesktopUDisks2DriveInterface
+ */
+
+OrgFreedesktopUDisks2DriveInterface::OrgFreedesktopUDisks2DriveInterface(const QString &service,
+                                                                         const QString &path,
+                                                                         const QDBusConnection &connection,
+                                                                         QObject *parent)
+    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+{
+}
+
+OrgFreedesktopUDisks2DriveInterface::~OrgFreedesktopUDisks2DriveInterface()
+{
+}
+
+/*
+ * Implementation of interface class OrgFreedesktopUDisks2EncryptedInterface
+ */
+
+OrgFreedesktopUDisks2EncryptedInterface::OrgFreedesktopUDisks2EncryptedInterface(const QString &service,
+                                                                                 const QString &path,
+                                                                                 const QDBusConnection &connection,
+                                                                                 QObject *parent)
+    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+{
+}
+
+OrgFreedesktopUDisks2EncryptedInterface::~OrgFreedesktopUDisks2EncryptedInterface()
+{
+}
+
+#include "moc_interfaces.cpp"
@@ -0,0 +1,276 @@
+/*
+ * This file was generated by qdbusxml2cpp version 0.7
+ * Command line was: qdbusxml2cpp -p interfaces interfaces.xml
+ *
+ * qdbusxml2cpp is Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * This is an auto-generated file.
+ * Do not edit! All changes made to it will be lost.
+ */
+
+#ifndef INTERFACES_H_1788040731
+#define INTERFACES_H_1788040731
+
+#include <QDBusConnection>
+#include <QDBusVariant>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include "../udisks2.h"
+
+/*
+ * Proxy class for interface org.freedesktop.DBus.Properties
+ */
+class OrgFreedesktopDBusPropertiesInterface : public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    {
+        return "org.freedesktop.DBus.Properties";
+    }
+
+public:
+    OrgFreedesktopDBusPropertiesInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~OrgFreedesktopDBusPropertiesInterface() override;
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<QDBusVariant> Get(const QString &interface_name, const QString &property_name)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(interface_name) << QVariant::fromValue(property_name);
+        return asyncCallWithArgumentList(QLatin1String("Get"), argumentList);
+    }
+
+    inline QDBusPendingReply<QVariantMap> GetAll(const QString &interface_name)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(interface_name);
+        return asyncCallWithArgumentList(QLatin1String("GetAll"), argumentList);
+    }
+
+Q_SIGNALS: // SIGNALS
+    void PropertiesChanged(const QString &interface_name, const QVariantMap &changed_properties, const QStringList &invalidated_properties);
+};
+
+/*
+ * Proxy class for interface org.freedesktop.DBus.Introspectable
+ */
+class OrgFreedesktopDBusIntrospectableInterface : public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    {
+        return "org.freedesktop.DBus.Introspectable";
+    }
+
+public:
+    OrgFreedesktopDBusIntrospectableInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~OrgFreedesktopDBusIntrospectableInterface() override;
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<QString> Introspect()
+    {
+        QList<QVariant> argumentList;
+        return asyncCallWithArgumentList(QLatin1String("Introspect"), argumentList);
+    }
+};
+
+/*
+ * Proxy class for interface org.freedesktop.UDisks2.Manager
+ */
+class OrgFreedesktopUDisks2ManagerInterface : public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    {
+        return "org.freedesktop.UDisks2.Manager";
+    }
+
+public:
+    OrgFreedesktopUDisks2ManagerInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~OrgFreedesktopUDisks2ManagerInterface() override;
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<AvailableAnswer> CanCheck(const QString &type)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(type);
+        return asyncCallWithArgumentList(QLatin1String("CanCheck"), argumentList);
+    }
+
+    inline QDBusPendingReply<AvailableAnswer> CanRepair(const QString &type)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(type);
+        return asyncCallWithArgumentList(QLatin1String("CanRepair"), argumentList);
+    }
+};
+
+/*
+ * Proxy class for interface org.freedesktop.UDisks2.Block
+ */
+class OrgFreedesktopUDisks2BlockInterface : public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    {
+        return "org.freedesktop.UDisks2.Block";
+    }
+
+public:
+    OrgFreedesktopUDisks2BlockInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~OrgFreedesktopUDisks2BlockInterface() override;
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<> Rescan(const QVariantMap &options)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(options);
+        return asyncCallWithArgumentList(QLatin1String("Rescan"), argumentList);
+    }
+};
+
+/*
+ * Proxy class for interface org.freedesktop.UDisks2.Filesystem
+ */
+class OrgFreedesktopUDisks2FilesystemInterface : public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    {
+        return "org.freedesktop.UDisks2.Filesystem";
+    }
+
+public:
+    OrgFreedesktopUDisks2FilesystemInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~OrgFreedesktopUDisks2FilesystemInterface() override;
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<QString> Mount(const QVariantMap &options)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(options);
+        return asyncCallWithArgumentList(QLatin1String("Mount"), argumentList);
+    }
+
+    inline QDBusPendingReply<> Unmount(const QVariantMap &options)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(options);
+        return asyncCallWithArgumentList(QLatin1String("Unmount"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> Check(const QVariantMap &options)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(options);
+        return asyncCallWithArgumentList(QLatin1String("Check"), argumentList);
+    }
+
+    inline QDBusPendingReply<bool> Repair(const QVariantMap &options)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(options);
+        return asyncCallWithArgumentList(QLatin1String("Repair"), argumentList);
+    }
+};
+
+/*
+ * Proxy class for interface org.freedesktop.UDisks2.Drive
+ */
+class OrgFreedesktopUDisks2DriveInterface : public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    {
+        return "org.freedesktop.UDisks2.Drive";
+    }
+
+public:
+    OrgFreedesktopUDisks2DriveInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~OrgFreedesktopUDisks2DriveInterface() override;
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<> Eject(const QVariantMap &options)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(options);
+        return asyncCallWithArgumentList(QLatin1String("Eject"), argumentList);
+    }
+
+    inline QDBusPendingReply<> PowerOff(const QVariantMap &options)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(options);
+        return asyncCallWithArgumentList(QLatin1String("PowerOff"), argumentList);
+    }
+};
+
+/*
+ * Proxy class for interface org.freedesktop.UDisks2.Encrypted
+ */
+class OrgFreedesktopUDisks2EncryptedInterface : public QDBusAbstractInterface
+{
+    Q_OBJECT
+public:
+    static inline const char *staticInterfaceName()
+    {
+        return "org.freedesktop.UDisks2.Encrypted";
+    }
+
+public:
+    OrgFreedesktopUDisks2EncryptedInterface(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent = nullptr);
+
+    ~OrgFreedesktopUDisks2EncryptedInterface() override;
+
+public Q_SLOTS: // METHODS
+    inline QDBusPendingReply<QDBusObjectPath> Unlock(const QString &passphrase, const QVariantMap &options)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(passphrase) << QVariant::fromValue(options);
+        return asyncCallWithArgumentList(QLatin1String("Unlock"), argumentList);
+    }
+
+    inline QDBusPendingReply<> Lock(const QVariantMap &options)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(options);
+        return asyncCallWithArgumentList(QLatin1String("Lock"), argumentList);
+    }
+};
+
+namespace org
+{
+namespace freedesktop
+{
+namespace DBus
+{
+typedef ::OrgFreedesktopDBusPropertiesInterface Properties;
+typedef ::OrgFreedesktopDBusIntrospectableInterface Introspectable;
+}
+namespace UDisks2
+{
+typedef ::OrgFreedesktopUDisks2ManagerInterface Manager;
+typedef ::OrgFreedesktopUDisks2BlockInterface Block;
+typedef ::OrgFreedesktopUDisks2FilesystemInterface Filesystem;
+typedef ::OrgFreedesktopUDisks2DriveInterface Drive;
+typedef ::OrgFreedesktopUDisks2EncryptedInterface Encrypted;
+}
+}
+}
+#endif
@@ -9,6 +9,7 @@
 
 #include <QCoreApplication>
 #include <QDBusAbstractInterface>
+#include <QDBusArgument>
 #include <QDBusObjectPath>
 #include <QDBusPendingReply>
 #include <QDBusReply>
@@ -25,6 +26,29 @@ Q_DECLARE_METATYPE(VariantMapMap)
 typedef QMap<QDBusObjectPath, VariantMapMap> DBUSManagerStruct;
 Q_DECLARE_METATYPE(DBUSManagerStruct)
 
+/* the (bs) struct returned by Manager.CanCheck / Manager.CanRepair */
+struct AvailableAnswer {
+    bool checkResult;
+    QString binaryName;
+};
+Q_DECLARE_METATYPE(AvailableAnswer)
+
+inline QDBusArgument &operator<<(QDBusArgument &argument, const AvailableAnswer &answer)
+{
+    argument.beginStructure();
+    argument << answer.checkResult << answer.binaryName;
+    argument.endStructure();
+    return argument;
+}
+
+inline const QDBusArgument &operator>>(const QDBusArgument &argument, AvailableAnswer &answer)
+{
+    argument.beginStructure();
+    argument >> answer.checkResult >> answer.binaryName;
+    argument.endStructure();
+    return argument;
+}
+
 // clang-format off
 
 /* UDisks2 */
@@ -21,7 +21,9 @@
 #include <QDomDocument>
 #include <QFile>
 
+#include "dbus/interfaces.h"
 #include "udisks_debug.h"
+#include "udisksconnection.h"
 
 using namespace Solid::Backends::UDisks2;
 
@@ -32,11 +34,8 @@ Block::Block(Device *dev)
 {
     // we have a drive (non-block device for udisks), so let's find the corresponding (real) block device
     if (m_devNum == 0 || m_devFile.isEmpty()) {
-        QDBusMessage call = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE),
-                                                           QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES),
-                                                           QStringLiteral(DBUS_INTERFACE_INTROSPECT),
-                                                           QStringLiteral("Introspect"));
-        QDBusPendingReply<QString> reply = QDBusConnection::systemBus().asyncCall(call);
+        org::freedesktop::DBus::Introspectable introspectable(QStringLiteral(UD2_DBUS_SERVICE), QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES), udisksBus());
+        QDBusPendingReply<QString> reply = introspectable.Introspect();
         reply.waitForFinished();
 
         if (reply.isValid()) {
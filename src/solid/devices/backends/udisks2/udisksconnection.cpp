@@ -0,0 +1,26 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "udisksconnection.h"
+
+QDBusConnection Solid::Backends::UDisks2::udisksBus()
+{
+    static const QString name = QStringLiteral("solid-udisks2");
+
+    QDBusConnection bus(name);
+    if (bus.isConnected()) {
+        return bus;
+    }
+
+    /* QDBusConnectionManager serializes this internally; concurrent callers
+     * end up sharing the one connection registered under the name. */
+    bus = QDBusConnection::connectToBus(QDBusConnection::SystemBus, name);
+    if (!bus.isConnected()) { // no bus access (e.g. tests, tight sandboxes)
+        return QDBusConnection::systemBus();
+    }
+
+    return bus;
+}
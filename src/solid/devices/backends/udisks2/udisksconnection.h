@@ -0,0 +1,32 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef UDISKSCONNECTION_H
+#define UDISKSCONNECTION_H
+
+#include <QDBusConnection>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDisks2
+{
+/* The dedicated bus connection carrying all UDisks2 traffic.
+ *
+ * Keeping property fetches, introspections and change signals off
+ * QDBusConnection::systemBus() means a burst of UDisks2 messages (say,
+ * PropertiesChanged floods during an mkfs) never queues behind — or in
+ * front of — the application's own system-bus calls. Falls back to the
+ * shared connection when a private one cannot be established.
+ */
+QDBusConnection udisksBus();
+
+}
+}
+}
+
+#endif // UDISKSCONNECTION_H
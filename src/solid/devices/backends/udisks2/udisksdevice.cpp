@@ -93,7 +93,7 @@ Device::Device(const QString &udi)
 {
     if (m_backend) {
         connect(m_backend, &DeviceBackend::changed, this, &Device::changed);
-        connect(m_backend, &DeviceBackend::propertyChanged, this, &Device::propertyChanged);
+        connect(m_backend, &DeviceBackend::propertyEventsChanged, this, &Device::propertyEventsChanged);
     } else {
         qCDebug(UDISKS2) << "Created invalid Device for udi" << udi;
     }
@@ -121,6 +121,33 @@ QVariant Device::prop(const QString &key) const
     return QVariant();
 }
 
+QString Device::propString(const QString &key) const
+{
+    if (m_backend) {
+        return m_backend->propString(key);
+    }
+
+    return QString();
+}
+
+bool Device::propBool(const QString &key) const
+{
+    if (m_backend) {
+        return m_backend->propBool(key);
+    }
+
+    return false;
+}
+
+qulonglong Device::propULongLong(const QString &key) const
+{
+    if (m_backend) {
+        return m_backend->propULongLong(key);
+    }
+
+    return 0;
+}
+
 bool Device::propertyExists(const QString &key) const
 {
     if (m_backend) {
@@ -130,6 +157,13 @@ bool Device::propertyExists(const QString &key) const
     return false;
 }
 
+void Device::preload()
+{
+    if (m_backend) {
+        m_backend->refreshProperties();
+    }
+}
+
 QVariantMap Device::allProperties() const
 {
     if (m_backend) {
@@ -222,6 +256,39 @@ bool Device::queryDeviceInterface(const Solid::DeviceInterface::Type &type) cons
 }
 
 QStringList Device::emblems() const
+{
+    if (!m_backend) {
+        return computeEmblems();
+    }
+
+    return m_backend->cachedEmblems([this] {
+        return computeEmblems();
+    });
+}
+
+QString Device::description() const
+{
+    if (!m_backend) {
+        return computeDescription();
+    }
+
+    return m_backend->cachedDescription([this] {
+        return computeDescription();
+    });
+}
+
+QString Device::icon() const
+{
+    if (!m_backend) {
+        return computeIcon();
+    }
+
+    return m_backend->cachedIcon([this] {
+        return computeIcon();
+    });
+}
+
+QStringList Device::computeEmblems() const
 {
     if (queryDeviceInterface(Solid::DeviceInterface::StorageAccess)) {
         const UDisks2::StorageAccess accessIface(const_cast<Device *>(this));
@@ -241,7 +308,7 @@ QStringList Device::emblems() const
     return {};
 }
 
-QString Device::description() const
+QString Device::computeDescription() const
 {
     const QString hintName = property("HintName").toString(); // non-cached
     if (!hintName.isEmpty()) {
@@ -263,12 +330,12 @@ QString Device::description() const
 
 QString Device::loopDescription() const
 {
-    const QString label = prop(QStringLiteral("IdLabel")).toString();
+    const QString label = propString(QStringLiteral("IdLabel"));
     if (!label.isEmpty()) {
         return label;
     }
 
-    const QString backingFile = prop(QStringLiteral("BackingFile")).toString();
+    const QString backingFile = propString(QStringLiteral("BackingFile"));
     if (!backingFile.isEmpty()) {
         return backingFile.section(QLatin1Char('/'), -1);
     }
@@ -411,9 +478,9 @@ QString Device::volumeDescription() const
 {
     QString description;
     const UDisks2::StorageVolume storageVolume(const_cast<Device *>(this));
-    QString volume_label = prop(QStringLiteral("IdLabel")).toString();
+    QString volume_label = propString(QStringLiteral("IdLabel"));
     if (volume_label.isEmpty()) {
-        volume_label = prop(QStringLiteral("Name")).toString();
+        volume_label = propString(QStringLiteral("Name"));
     }
     if (!volume_label.isEmpty()) {
         return volume_label;
@@ -591,7 +658,7 @@ QString Device::volumeDescription() const
     return description;
 }
 
-QString Device::icon() const
+QString Device::computeIcon() const
 {
     QString iconName = property("HintIconName").toString(); // non-cached
 
@@ -600,7 +667,7 @@ QString Device::icon() const
     } else if (isRoot()) {
         return QStringLiteral("drive-harddisk-root");
     } else if (isLoop()) {
-        const QString backingFile = prop(QStringLiteral("BackingFile")).toString();
+        const QString backingFile = propString(QStringLiteral("BackingFile"));
         if (!backingFile.isEmpty()) {
             QMimeType type = QMimeDatabase().mimeTypeForFile(backingFile);
             if (!type.isDefault()) {
@@ -611,12 +678,12 @@ QString Device::icon() const
     } else if (isSwap()) {
         return QStringLiteral("drive-harddisk");
     } else if (isDrive()) {
-        const bool isRemovable = prop(QStringLiteral("Removable")).toBool();
-        const QString conn = prop(QStringLiteral("ConnectionBus")).toString();
+        const bool isRemovable = propBool(QStringLiteral("Removable"));
+        const QString conn = propString(QStringLiteral("ConnectionBus"));
 
         if (isOpticalDrive()) {
             return QStringLiteral("drive-optical");
-        } else if (isRemovable && !prop(QStringLiteral("Optical")).toBool()) {
+        } else if (isRemovable && !propBool(QStringLiteral("Optical"))) {
             if (conn == QLatin1String("usb")) {
                 return QStringLiteral("drive-removable-media-usb");
             } else {
@@ -632,11 +699,11 @@ QString Device::icon() const
         Device drive(drv);
 
         // handle media
-        const QString media = drive.prop(QStringLiteral("Media")).toString();
+        const QString media = drive.propString(QStringLiteral("Media"));
 
         if (!media.isEmpty()) {
-            if (drive.prop(QStringLiteral("Optical")).toBool()) { // optical stuff
-                bool isWritable = drive.prop(QStringLiteral("OpticalBlank")).toBool();
+            if (drive.propBool(QStringLiteral("Optical"))) { // optical stuff
+                bool isWritable = drive.propBool(QStringLiteral("OpticalBlank"));
 
                 const UDisks2::OpticalDisc disc(const_cast<Device *>(this));
                 Solid::OpticalDisc::ContentTypes availContent = disc.availableContent();
@@ -683,7 +750,7 @@ QString Device::icon() const
             }
         }
 
-        if (drive.prop(QStringLiteral("ConnectionBus")).toString() == QLatin1String("sdio")) { // hack for SD cards connected thru sdio bus
+        if (drive.propString(QStringLiteral("ConnectionBus")) == QLatin1String("sdio")) { // hack for SD cards connected thru sdio bus
             return QStringLiteral("media-flash-sd-mmc");
         }
 
@@ -697,20 +764,20 @@ QString Device::product() const
 {
     if (!isDrive()) {
         Device drive(drivePath());
-        return drive.prop(QStringLiteral("Model")).toString();
+        return drive.propString(QStringLiteral("Model"));
     }
 
-    return prop(QStringLiteral("Model")).toString();
+    return propString(QStringLiteral("Model"));
 }
 
 QString Device::vendor() const
 {
     if (!isDrive()) {
         Device drive(drivePath());
-        return drive.prop(QStringLiteral("Vendor")).toString();
+        return drive.propString(QStringLiteral("Vendor"));
     }
 
-    return prop(QStringLiteral("Vendor")).toString();
+    return propString(QStringLiteral("Vendor"));
 }
 
 QString Device::parentUdi() const
@@ -826,7 +893,7 @@ bool Device::isOpticalDisc() const
     }
 
     Device drive(drv);
-    return drive.prop(QStringLiteral("Optical")).toBool();
+    return drive.propBool(QStringLiteral("Optical"));
 }
 
 bool Device::mightBeOpticalDisc() const
@@ -12,6 +12,7 @@
 
 #include <ifaces/device.h>
 #include <solid/deviceinterface.h>
+#include <solid/genericinterface.h>
 #include <solid/solidnamespace.h>
 
 #include <QDBusObjectPath>
@@ -41,8 +42,13 @@ public:
     QString vendor() const override;
     QString udi() const override;
     QString parentUdi() const override;
+    void preload() override;
 
     QVariant prop(const QString &key) const;
+    /* Typed accessors memoizing the conversion for frequently read keys */
+    QString propString(const QString &key) const;
+    bool propBool(const QString &key) const;
+    qulonglong propULongLong(const QString &key) const;
     bool propertyExists(const QString &key) const;
     QVariantMap allProperties() const;
     void invalidateCache();
@@ -73,12 +79,15 @@ public:
 
 Q_SIGNALS:
     void changed();
-    void propertyChanged(const QMap<QString, int> &changes);
+    void propertyEventsChanged(const QList<Solid::GenericInterface::PropertyChangeEvent> &events);
 
 protected:
     QPointer<DeviceBackend> m_backend;
 
 private:
+    QString computeDescription() const;
+    QString computeIcon() const;
+    QStringList computeEmblems() const;
     QString loopDescription() const;
     QString storageDescription() const;
     QString volumeDescription() const;
@@ -7,9 +7,20 @@
 */
 
 #include "udisksdevicebackend.h"
+#include "dbus/interfaces.h"
 #include "udisks_debug.h"
+#include "udisksconnection.h"
+#include "udiskssignaldispatcher.h"
+#include "udistringpool_p.h"
 
+#include "solidstatistics_p.h"
+#include "solidtrace_p.h"
+#include "solidwatchdog_p.h"
+
+#include <QCoreApplication>
 #include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QMutex>
 #include <QXmlStreamReader>
 
 #include "solid/deviceinterface.h"
@@ -17,8 +28,33 @@
 
 using namespace Solid::Backends::UDisks2;
 
-/* Static cache for DeviceBackends for all UDIs */
-QThreadStorage<QMap<QString /* UDI */, DeviceBackend *>> DeviceBackend::s_backends;
+/* Process-wide cache of DeviceBackends for all UDIs, so every thread shares
+ * one property cache and one set of D-Bus signal subscriptions per device. */
+namespace
+{
+struct BackendRegistry {
+    ~BackendRegistry()
+    {
+        qDeleteAll(backends);
+    }
+
+    QMutex mutex;
+    QMap<QString /* UDI */, DeviceBackend *> backends;
+};
+}
+
+Q_GLOBAL_STATIC(BackendRegistry, s_backends)
+
+/* Backends can be created from any thread, but their D-Bus signals must keep
+ * being delivered after that thread is gone; give them all main-thread
+ * affinity. */
+static void adoptBackend(DeviceBackend *backend)
+{
+    const QCoreApplication *app = QCoreApplication::instance();
+    if (app && backend->thread() != app->thread()) {
+        backend->moveToThread(app->thread());
+    }
+}
 
 DeviceBackend *DeviceBackend::backendForUDI(const QString &udi, bool create)
 {
@@ -27,10 +63,35 @@ DeviceBackend *DeviceBackend::backendForUDI(const QString &udi, bool create)
         return backend;
     }
 
-    backend = s_backends.localData().value(udi);
+    BackendRegistry *registry = s_backends();
+    QMutexLocker locker(&registry->mutex);
+
+    backend = registry->backends.value(udi);
     if (!backend && create) {
-        backend = new DeviceBackend(udi);
-        s_backends.localData().insert(udi, backend);
+        const QString interned = Solid::internedUdi(udi);
+        backend = new DeviceBackend(interned);
+        adoptBackend(backend);
+        registry->backends.insert(interned, backend);
+    }
+
+    return backend;
+}
+
+DeviceBackend *DeviceBackend::seedBackendForUDI(const QString &udi, const VariantMapMap &interfacesAndProperties)
+{
+    if (udi.isEmpty()) {
+        return nullptr;
+    }
+
+    BackendRegistry *registry = s_backends();
+    QMutexLocker locker(&registry->mutex);
+
+    DeviceBackend *backend = registry->backends.value(udi);
+    if (!backend) {
+        const QString interned = Solid::internedUdi(udi);
+        backend = new DeviceBackend(interned, interfacesAndProperties);
+        adoptBackend(backend);
+        registry->backends.insert(interned, backend);
     }
 
     return backend;
@@ -38,7 +99,9 @@ DeviceBackend *DeviceBackend::backendForUDI(const QString &udi, bool create)
 
 void DeviceBackend::destroyBackend(const QString &udi)
 {
-    delete s_backends.localData().take(udi);
+    BackendRegistry *registry = s_backends();
+    QMutexLocker locker(&registry->mutex);
+    delete registry->backends.take(udi);
 }
 
 DeviceBackend::DeviceBackend(const QString &udi)
@@ -46,31 +109,80 @@ DeviceBackend::DeviceBackend(const QString &udi)
 {
     // qDebug() << "Creating backend for device" << m_udi;
 
-    QDBusConnection::systemBus().connect(QStringLiteral(UD2_DBUS_SERVICE), //
-                                         m_udi,
-                                         QStringLiteral(DBUS_INTERFACE_PROPS),
-                                         QStringLiteral("PropertiesChanged"),
-                                         this,
-                                         SLOT(slotPropertiesChanged(QString, QVariantMap, QStringList)));
-    QDBusConnection::systemBus().connect(QStringLiteral(UD2_DBUS_SERVICE),
-                                         QStringLiteral(UD2_DBUS_PATH),
-                                         QStringLiteral(DBUS_INTERFACE_MANAGER),
-                                         QStringLiteral("InterfacesAdded"),
-                                         this,
-                                         SLOT(slotInterfacesAdded(QDBusObjectPath, VariantMapMap)));
-    QDBusConnection::systemBus().connect(QStringLiteral(UD2_DBUS_SERVICE),
-                                         QStringLiteral(UD2_DBUS_PATH),
-                                         QStringLiteral(DBUS_INTERFACE_MANAGER),
-                                         QStringLiteral("InterfacesRemoved"),
-                                         this,
-                                         SLOT(slotInterfacesRemoved(QDBusObjectPath, QStringList)));
-
+    connectBusSignals();
     initInterfaces();
 }
 
+DeviceBackend::DeviceBackend(const QString &udi, const VariantMapMap &interfacesAndProperties)
+    : m_udi(udi)
+{
+    connectBusSignals();
+
+    /* Seed the interface list and property cache from an ObjectManager
+     * payload instead of introspecting; this avoids any per-device D-Bus
+     * round trip during enumeration. */
+    for (auto it = interfacesAndProperties.cbegin(); it != interfacesAndProperties.cend(); ++it) {
+        const QString &iface = it.key();
+        if (!iface.startsWith(QStringLiteral(UD2_DBUS_SERVICE))) {
+            continue;
+        }
+
+        m_interfaces.append(iface);
+
+        const QVariantMap &props = it.value();
+        for (auto propIt = props.cbegin(); propIt != props.cend(); ++propIt) {
+            cacheProperty(propIt.key(), propIt.value(), iface);
+        }
+    }
+
+    accountPropertyCache();
+}
+
+void DeviceBackend::connectBusSignals()
+{
+    /* One service-wide match rule shared by all backends; filter on our
+     * own path instead of making dbus-daemon evaluate a rule per device. */
+    connect(SignalDispatcher::instance(),
+            &SignalDispatcher::propertiesChangedBatch,
+            this,
+            [this](const QList<SignalDispatcher::ChangeSet> &changes) {
+                for (const SignalDispatcher::ChangeSet &change : changes) {
+                    if (change.path == m_udi) {
+                        slotPropertiesChanged(change.interfaceName, change.changedProperties, change.invalidatedProperties);
+                    }
+                }
+            });
+    udisksBus().connect(QStringLiteral(UD2_DBUS_SERVICE),
+                        QStringLiteral(UD2_DBUS_PATH),
+                        QStringLiteral(DBUS_INTERFACE_MANAGER),
+                        QStringLiteral("InterfacesAdded"),
+                        this,
+                        SLOT(slotInterfacesAdded(QDBusObjectPath, VariantMapMap)));
+    udisksBus().connect(QStringLiteral(UD2_DBUS_SERVICE),
+                        QStringLiteral(UD2_DBUS_PATH),
+                        QStringLiteral(DBUS_INTERFACE_MANAGER),
+                        QStringLiteral("InterfacesRemoved"),
+                        this,
+                        SLOT(slotInterfacesRemoved(QDBusObjectPath, QStringList)));
+}
+
 DeviceBackend::~DeviceBackend()
 {
     // qDebug() << "Destroying backend for device" << m_udi;
+    Solid::Stats::add(Solid::Stats::counters().udisksPropertyCacheBytes, -m_accountedBytes);
+    delete m_propsInterface;
+}
+
+OrgFreedesktopDBusPropertiesInterface *DeviceBackend::propertiesInterface() const
+{
+    // callers hold m_mutex, so the lazy creation cannot race
+    if (!m_propsInterface) {
+        m_propsInterface = new org::freedesktop::DBus::Properties(QStringLiteral(UD2_DBUS_SERVICE), m_udi, udisksBus());
+        if (m_propsInterface->thread() != thread()) {
+            m_propsInterface->moveToThread(thread());
+        }
+    }
+    return m_propsInterface;
 }
 
 void DeviceBackend::initInterfaces()
@@ -101,6 +213,7 @@ void DeviceBackend::initInterfaces()
 
 QStringList DeviceBackend::interfaces() const
 {
+    QMutexLocker locker(&m_mutex);
     return m_interfaces;
 }
 
@@ -111,12 +224,59 @@ const QString &DeviceBackend::udi() const
 
 QVariant DeviceBackend::prop(const QString &key) const
 {
+    QMutexLocker locker(&m_mutex);
     checkCache(key);
     return m_propertyCache.value(key);
 }
 
+/* Typed variants of prop(): hot paths (descriptions, sizes, flags) read the
+ * same keys over and over, so the converted value is memoized next to the
+ * QVariant cache instead of being unboxed again on every call. */
+QString DeviceBackend::propString(const QString &key) const
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_stringCache.constFind(key);
+    if (it != m_stringCache.constEnd()) {
+        return it.value();
+    }
+
+    checkCache(key);
+    const QString value = m_propertyCache.value(key).toString();
+    m_stringCache.insert(key, value);
+    return value;
+}
+
+bool DeviceBackend::propBool(const QString &key) const
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_boolCache.constFind(key);
+    if (it != m_boolCache.constEnd()) {
+        return it.value();
+    }
+
+    checkCache(key);
+    const bool value = m_propertyCache.value(key).toBool();
+    m_boolCache.insert(key, value);
+    return value;
+}
+
+qulonglong DeviceBackend::propULongLong(const QString &key) const
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_u64Cache.constFind(key);
+    if (it != m_u64Cache.constEnd()) {
+        return it.value();
+    }
+
+    checkCache(key);
+    const qulonglong value = m_propertyCache.value(key).toULongLong();
+    m_u64Cache.insert(key, value);
+    return value;
+}
+
 bool DeviceBackend::propertyExists(const QString &key) const
 {
+    QMutexLocker locker(&m_mutex);
     checkCache(key);
     /* checkCache() will put an invalid QVariant in cache when the property
      * does not exist, so check for validity, not for an actual presence. */
@@ -125,40 +285,185 @@ bool DeviceBackend::propertyExists(const QString &key) const
 
 QVariantMap DeviceBackend::allProperties() const
 {
-    QDBusMessage call = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE), //
-                                                       m_udi,
-                                                       QStringLiteral(DBUS_INTERFACE_PROPS),
-                                                       QStringLiteral("GetAll"));
+    const Solid::Trace::Timer traceTimer;
+
+    QMutexLocker locker(&m_mutex);
+
+    /* Issue the GetAll for every interface first (reusing any call already
+     * in flight), then collect the replies inline; waiting on the pending
+     * calls rather than the watchers works from any thread, and concurrent
+     * readers of the same UDI share one round trip per interface instead of
+     * queueing their own blocking calls. */
+    refreshProperties();
+
+    while (!m_pendingGetAll.isEmpty()) {
+        const auto it = m_pendingGetAll.cbegin();
+        collectGetAll(it.key(), it.value());
+    }
+
+    m_allFetched = true;
+
+    SOLID_TRACE2(udisks_all_properties, qUtf8Printable(m_udi), traceTimer.nsecs());
+    return m_propertyCache;
+}
+
+void DeviceBackend::refreshProperties() const
+{
+    QMutexLocker locker(&m_mutex);
 
     for (const QString &iface : std::as_const(m_interfaces)) {
-        call.setArguments(QVariantList() << iface);
-        QDBusPendingReply<QVariantMap> reply = QDBusConnection::systemBus().call(call);
-
-        if (reply.isValid()) {
-            auto props = reply.value();
-            // Can not use QMap<>::unite(), as it allows multiple values per key
-            for (auto it = props.cbegin(); it != props.cend(); ++it) {
-                cacheProperty(it.key(), it.value());
-            }
-        } else {
-            qCWarning(UDISKS2) << "Error getting props:" << reply.error().name() << reply.error().message() << "for" << m_udi;
+        if (m_pendingGetAll.contains(iface)) {
+            continue; // coalesce with the in-flight call
+        }
+
+        /* Unparented on purpose: the calling thread may not be the backend's
+         * thread, and parenting across threads is not allowed. */
+        Solid::Stats::add(Solid::Stats::counters().getAllCalls);
+
+        auto *watcher = new QDBusPendingCallWatcher(propertiesInterface()->GetAll(iface));
+        if (watcher->thread() != thread()) {
+            watcher->moveToThread(thread());
         }
-        // qDebug() << "After iface" << iface << ", cache now contains" << m_propertyCache.size() << "items";
+        m_pendingGetAll.insert(iface, watcher);
+
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, iface](QDBusPendingCallWatcher *watcher) {
+            collectGetAll(iface, watcher);
+        });
     }
+}
 
-    return m_propertyCache;
+void DeviceBackend::collectGetAll(const QString &iface, QDBusPendingCallWatcher *watcher) const
+{
+    QDBusPendingReply<QVariantMap> reply = *watcher;
+    if (!reply.isFinished()) {
+        // only blocking readers wait here; watcher callbacks arrive finished
+        const Solid::Watchdog::BlockingCallGuard guard(UDISKS2(), "DeviceBackend::collectGetAll", m_udi);
+        reply.waitForFinished();
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (m_pendingGetAll.value(iface) != watcher) {
+        return; /* a blocking reader on another thread collected it already */
+    }
+
+    if (reply.isValid()) {
+        const auto props = reply.value();
+        // Can not use QMap<>::unite(), as it allows multiple values per key
+        for (auto it = props.cbegin(); it != props.cend(); ++it) {
+            cacheProperty(it.key(), it.value(), iface);
+        }
+    } else {
+        qCWarning(UDISKS2) << "Error getting props:" << reply.error().name() << reply.error().message() << "for" << m_udi;
+    }
+
+    accountPropertyCache();
+
+    m_pendingGetAll.remove(iface);
+    disconnect(watcher, nullptr, this, nullptr);
+    watcher->deleteLater();
+}
+
+QString DeviceBackend::cachedDescription(const std::function<QString()> &compute) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_descriptionValid) {
+        m_description = compute();
+        m_descriptionValid = true;
+    }
+    return m_description;
+}
+
+QString DeviceBackend::cachedIcon(const std::function<QString()> &compute) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_iconValid) {
+        m_icon = compute();
+        m_iconValid = true;
+    }
+    return m_icon;
+}
+
+QStringList DeviceBackend::cachedEmblems(const std::function<QStringList()> &compute) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_emblemsValid) {
+        m_emblems = compute();
+        m_emblemsValid = true;
+    }
+    return m_emblems;
+}
+
+void DeviceBackend::invalidateDisplayCache() const
+{
+    QMutexLocker locker(&m_mutex);
+    m_descriptionValid = false;
+    m_iconValid = false;
+    m_emblemsValid = false;
 }
 
 void DeviceBackend::invalidateProperties()
 {
+    QMutexLocker locker(&m_mutex);
     m_propertyCache.clear();
+    m_propertiesByInterface.clear();
+    clearTypedCaches();
+    m_allFetched = false;
+
+    /* Carry the static tier back over: immutable keys feed description and
+     * icon recomputation after events, and refetching them would cost a
+     * round trip for data that cannot have changed. */
+    for (auto it = m_staticCache.cbegin(); it != m_staticCache.cend(); ++it) {
+        m_propertyCache.insert(it.key(), it.value());
+        m_propertiesByInterface[m_staticCacheIface.value(it.key())].insert(it.key());
+    }
+
+    invalidateDisplayCache();
+    accountPropertyCache();
+}
+
+void DeviceBackend::reseed(const VariantMapMap &interfacesAndProperties)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+
+        m_interfaces.clear();
+        m_propertyCache.clear();
+        m_propertiesByInterface.clear();
+        clearTypedCaches();
+        /* the payload is authoritative; let it rebuild the static tier too */
+        m_staticCache.clear();
+        m_staticCacheIface.clear();
+
+        for (auto it = interfacesAndProperties.cbegin(); it != interfacesAndProperties.cend(); ++it) {
+            const QString &iface = it.key();
+            if (!iface.startsWith(QStringLiteral(UD2_DBUS_SERVICE))) {
+                continue;
+            }
+
+            m_interfaces.append(iface);
+
+            const QVariantMap &props = it.value();
+            for (auto propIt = props.cbegin(); propIt != props.cend(); ++propIt) {
+                cacheProperty(propIt.key(), propIt.value(), iface);
+            }
+        }
+
+        m_allFetched = true; // ObjectManager payloads are complete
+        invalidateDisplayCache();
+        accountPropertyCache();
+    }
+
+    Q_EMIT changed();
 }
 
 QString DeviceBackend::introspect() const
 {
-    QDBusMessage call =
-        QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE), m_udi, QStringLiteral(DBUS_INTERFACE_INTROSPECT), QStringLiteral("Introspect"));
-    QDBusPendingReply<QString> reply = QDBusConnection::systemBus().call(call);
+    org::freedesktop::DBus::Introspectable introspectable(QStringLiteral(UD2_DBUS_SERVICE), m_udi, udisksBus());
+    QDBusPendingReply<QString> reply = introspectable.Introspect();
+    {
+        const Solid::Watchdog::BlockingCallGuard guard(UDISKS2(), "DeviceBackend::introspect", m_udi);
+        reply.waitForFinished();
+    }
 
     if (reply.isValid()) {
         return reply.value();
@@ -169,27 +474,36 @@ QString DeviceBackend::introspect() const
 
 void DeviceBackend::checkCache(const QString &key) const
 {
-    if (m_propertyCache.isEmpty()) { // recreate the cache
-        allProperties();
-    }
-
     if (m_propertyCache.contains(key)) {
+        Solid::Stats::add(Solid::Stats::counters().propertyCacheHits);
         return;
     }
 
-    QDBusMessage call = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE), m_udi, QStringLiteral(DBUS_INTERFACE_PROPS), QStringLiteral("Get"));
-    /*
-     * Interface is set to an empty string as in this QDBusInterface is a meta-object of multiple interfaces on the same path
-     * The DBus properties also interface supports this, and will find the appropriate interface if none is explicitly set.
-     * This matches what QDBusAbstractInterface would do
-     */
-    call.setArguments(QVariantList() << QString() << key);
-    QDBusPendingReply<QVariant> reply = QDBusConnection::systemBus().call(call);
+    Solid::Stats::add(Solid::Stats::counters().propertyCacheMisses);
+
+    /* A miss is rarely alone — a fresh, partially seeded or just
+     * invalidated device typically has several properties read in a row.
+     * One GetAll sweep (shared with any call already in flight) satisfies
+     * the whole run of misses with a single round trip per interface,
+     * where a Get per missed key used to pay one each. */
+    if (!m_allFetched) {
+        const Solid::Trace::Timer traceTimer;
+        refreshProperties();
+        while (!m_pendingGetAll.isEmpty()) {
+            const auto it = m_pendingGetAll.cbegin();
+            collectGetAll(it.key(), it.value());
+        }
+        m_allFetched = true;
+        SOLID_TRACE2(udisks_property_miss, qUtf8Printable(m_udi), traceTimer.nsecs());
+
+        if (m_propertyCache.contains(key)) {
+            return;
+        }
+    }
 
-    /* We don't check for error here and store the item in the cache anyway so next time we don't have to
-     * do the DBus call to find out it does not exist but just check whether
-     * prop(key).isValid() */
-    cacheProperty(key, reply.value());
+    /* Remember the absence so the next lookup doesn't consider hitting the
+     * bus again; prop(key).isValid() is the existence check. */
+    cacheProperty(key, QVariant(), QString());
 }
 
 void DeviceBackend::slotPropertiesChanged(const QString &ifaceName, const QVariantMap &changedProps, const QStringList &invalidatedProps)
@@ -199,24 +513,41 @@ void DeviceBackend::slotPropertiesChanged(const QString &ifaceName, const QVaria
     }
     // qDebug() << m_udi << "'s interface" << ifaceName << "changed props:";
 
-    QMap<QString, int> changeMap;
+    QList<Solid::GenericInterface::PropertyChangeEvent> events;
+    events.reserve(invalidatedProps.size() + changedProps.size());
 
-    for (const QString &key : invalidatedProps) {
-        m_propertyCache.remove(key);
-        changeMap.insert(key, Solid::GenericInterface::PropertyModified);
-        // qDebug() << "\t invalidated:" << key;
-    }
+    {
+        QMutexLocker locker(&m_mutex);
+
+        if (!invalidatedProps.isEmpty()) {
+            m_allFetched = false;
+        }
+
+        for (const QString &key : invalidatedProps) {
+            m_propertyCache.remove(key);
+            dropTypedCaches(key);
+            /* udisksd explicitly declared it stale, so trust that over our
+             * immutability assumption */
+            m_staticCache.remove(key);
+            m_staticCacheIface.remove(key);
+            events.append({Solid::GenericInterface::propertyId(key), Solid::GenericInterface::PropertyModified});
+            // qDebug() << "\t invalidated:" << key;
+        }
 
-    QMapIterator<QString, QVariant> i(changedProps);
-    while (i.hasNext()) {
-        i.next();
-        const QString key = i.key();
-        cacheProperty(key, i.value()); // replace the value
-        changeMap.insert(key, Solid::GenericInterface::PropertyModified);
-        // qDebug() << "\t modified:" << key << ":" << m_propertyCache.value(key);
+        QMapIterator<QString, QVariant> i(changedProps);
+        while (i.hasNext()) {
+            i.next();
+            const QString key = i.key();
+            cacheProperty(key, i.value(), ifaceName); // replace the value
+            events.append({Solid::GenericInterface::propertyId(key), Solid::GenericInterface::PropertyModified});
+            // qDebug() << "\t modified:" << key << ":" << m_propertyCache.value(key);
+        }
+
+        invalidateDisplayCache();
+        accountPropertyCache();
     }
 
-    Q_EMIT propertyChanged(changeMap);
+    Q_EMIT propertyEventsChanged(events);
     Q_EMIT changed();
 }
 
@@ -226,13 +557,28 @@ void DeviceBackend::slotInterfacesAdded(const QDBusObjectPath &object_path, cons
         return;
     }
 
+    QMutexLocker locker(&m_mutex);
+
     for (auto it = interfaces_and_properties.cbegin(); it != interfaces_and_properties.cend(); ++it) {
         const QString &iface = it.key();
         /* Don't store generic DBus interfaces */
-        if (iface.startsWith(QStringLiteral(UD2_DBUS_SERVICE))) {
+        if (!iface.startsWith(QStringLiteral(UD2_DBUS_SERVICE))) {
+            continue;
+        }
+
+        if (!m_interfaces.contains(iface)) {
             m_interfaces.append(iface);
         }
+
+        /* The signal payload already carries the new interface's complete
+         * property map; cache it instead of fetching it again. */
+        const QVariantMap &props = it.value();
+        for (auto propIt = props.cbegin(); propIt != props.cend(); ++propIt) {
+            cacheProperty(propIt.key(), propIt.value(), iface);
+        }
     }
+
+    invalidateDisplayCache();
 }
 
 void DeviceBackend::slotInterfacesRemoved(const QDBusObjectPath &object_path, const QStringList &interfaces)
@@ -241,22 +587,84 @@ void DeviceBackend::slotInterfacesRemoved(const QDBusObjectPath &object_path, co
         return;
     }
 
+    QMutexLocker locker(&m_mutex);
+
     for (const QString &iface : interfaces) {
         m_interfaces.removeAll(iface);
     }
 
-    // We don't know which property belongs to which interface, so remove all
-    m_propertyCache.clear();
-    if (!m_interfaces.isEmpty()) {
-        allProperties();
+    /* Drop only the keys owned by the removed interfaces (plus the ones
+     * fetched without interface attribution), keeping the rest of the cache
+     * warm instead of re-fetching everything. A key also claimed by a
+     * remaining interface stays; the flat cache conflates same-named
+     * properties anyway and the next read refreshes it if needed. */
+    const auto claimedElsewhere = [this](const QString &key) {
+        for (const auto &keys : std::as_const(m_propertiesByInterface)) {
+            if (keys.contains(key)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    QSet<QString> droppedKeys;
+    for (const QString &iface : interfaces) {
+        droppedKeys += m_propertiesByInterface.take(iface);
     }
+    droppedKeys += m_propertiesByInterface.take(QString());
+
+    for (const QString &key : std::as_const(droppedKeys)) {
+        if (!claimedElsewhere(key)) {
+            m_propertyCache.remove(key);
+            dropTypedCaches(key);
+            /* the owning interface is gone, so its static keys go with it */
+            m_staticCache.remove(key);
+            m_staticCacheIface.remove(key);
+        }
+    }
+
+    m_allFetched = false;
+    invalidateDisplayCache();
+    accountPropertyCache();
 }
 
 // UDisks2 sends us null terminated strings, make sure to strip the extranous \0 in favor of the implicit \0.
 // Otherwise comparision becomes unnecessarily complicated because 'foo\0' != 'foo'. QByteArrays are implicitly
 // terminated already.
-void DeviceBackend::cacheProperty(const QString &key, const QVariant &value) const
+/* Keys whose value is fixed for as long as the device object exists:
+ * hardware identity and capabilities. Media state (Media, Optical,
+ * MediaAvailable) deliberately stays out — it flips with every disc or
+ * card change. */
+static bool isImmutableProperty(const QString &key)
+{
+    static const QSet<QString> immutableKeys{
+        QStringLiteral("Vendor"),
+        QStringLiteral("Model"),
+        QStringLiteral("Serial"),
+        QStringLiteral("Revision"),
+        QStringLiteral("Id"),
+        QStringLiteral("WWN"),
+        QStringLiteral("ConnectionBus"),
+        QStringLiteral("RotationRate"),
+        QStringLiteral("Removable"),
+        QStringLiteral("MediaRemovable"),
+        QStringLiteral("MediaCompatibility"),
+        QStringLiteral("Ejectable"),
+        QStringLiteral("CanPowerOff"),
+        QStringLiteral("Device"),
+        QStringLiteral("PreferredDevice"),
+        QStringLiteral("DeviceNumber"),
+        QStringLiteral("Drive"),
+    };
+
+    return immutableKeys.contains(key);
+}
+
+void DeviceBackend::cacheProperty(const QString &key, const QVariant &value, const QString &iface) const
 {
+    /* the memoized conversions must not outlive the variant they came from */
+    dropTypedCaches(key);
+
     if (value.metaType() == QMetaType::fromType<QByteArray>()) {
         auto blob = value.toByteArray();
         while (blob.endsWith('\0')) {
@@ -266,6 +674,43 @@ void DeviceBackend::cacheProperty(const QString &key, const QVariant &value) con
     } else {
         m_propertyCache.insert(key, value);
     }
+
+    m_propertiesByInterface[iface].insert(key);
+
+    /* absence markers (invalid variants) are not worth carrying across
+     * invalidations */
+    if (value.isValid() && isImmutableProperty(key)) {
+        m_staticCache.insert(key, m_propertyCache.value(key));
+        m_staticCacheIface.insert(key, iface);
+    }
+}
+
+void DeviceBackend::dropTypedCaches(const QString &key) const
+{
+    m_stringCache.remove(key);
+    m_boolCache.remove(key);
+    m_u64Cache.remove(key);
+}
+
+void DeviceBackend::clearTypedCaches() const
+{
+    m_stringCache.clear();
+    m_boolCache.clear();
+    m_u64Cache.clear();
+}
+
+/* Re-estimates what the property cache holds and publishes the delta to the
+ * process-wide accounting counter. Called with m_mutex held, after bulk
+ * mutations rather than per key, so merges stay linear. */
+void DeviceBackend::accountPropertyCache() const
+{
+    qint64 bytes = 0;
+    for (auto it = m_propertyCache.cbegin(), end = m_propertyCache.cend(); it != end; ++it) {
+        bytes += Solid::Stats::stringBytes(it.key()) + Solid::Stats::variantBytes(it.value()) + qint64(4 * sizeof(void *));
+    }
+
+    Solid::Stats::add(Solid::Stats::counters().udisksPropertyCacheBytes, bytes - m_accountedBytes);
+    m_accountedBytes = bytes;
 }
 
 #include "moc_udisksdevicebackend.cpp"
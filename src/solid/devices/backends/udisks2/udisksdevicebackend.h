@@ -10,12 +10,21 @@
 #define UDISKSDEVICEBACKEND_H
 
 #include <QDBusObjectPath>
+#include <QHash>
 #include <QObject>
+#include <QRecursiveMutex>
+#include <QSet>
 #include <QStringList>
-#include <QThreadStorage>
 
 #include "udisks2.h"
 
+#include "solid/genericinterface.h"
+
+#include <functional>
+
+class OrgFreedesktopDBusPropertiesInterface;
+class QDBusPendingCallWatcher;
+
 namespace Solid
 {
 namespace Backends
@@ -28,21 +37,41 @@ class DeviceBackend : public QObject
 
 public:
     static DeviceBackend *backendForUDI(const QString &udi, bool create = true);
+    static DeviceBackend *seedBackendForUDI(const QString &udi, const VariantMapMap &interfacesAndProperties);
     static void destroyBackend(const QString &udi);
 
     DeviceBackend(const QString &udi);
+    DeviceBackend(const QString &udi, const VariantMapMap &interfacesAndProperties);
     ~DeviceBackend() override;
 
     QVariant prop(const QString &key) const;
+    /* Typed accessors memoizing the conversion for frequently read keys */
+    QString propString(const QString &key) const;
+    bool propBool(const QString &key) const;
+    qulonglong propULongLong(const QString &key) const;
     bool propertyExists(const QString &key) const;
     QVariantMap allProperties() const;
+    void refreshProperties() const;
 
     QStringList interfaces() const;
     const QString &udi() const;
 
+    /* Memoized display strings: computed lazily by Device via @p compute,
+     * dropped whenever a property changes, so repaint-time calls are a
+     * cached string return. */
+    QString cachedDescription(const std::function<QString()> &compute) const;
+    QString cachedIcon(const std::function<QString()> &compute) const;
+    QStringList cachedEmblems(const std::function<QStringList()> &compute) const;
+
     void invalidateProperties();
+
+    /* Replaces interface list and property cache with an authoritative
+     * ObjectManager payload; used when reconciling a restored topology
+     * snapshot against the live service. */
+    void reseed(const VariantMapMap &interfacesAndProperties);
+
 Q_SIGNALS:
-    void propertyChanged(const QMap<QString, int> &changeMap);
+    void propertyEventsChanged(const QList<Solid::GenericInterface::PropertyChangeEvent> &events);
     void changed();
 
 private Q_SLOTS:
@@ -51,17 +80,61 @@ private Q_SLOTS:
     void slotPropertiesChanged(const QString &ifaceName, const QVariantMap &changedProps, const QStringList &invalidatedProps);
 
 private:
+    void connectBusSignals();
     void initInterfaces();
     QString introspect() const;
     void checkCache(const QString &key) const;
-    void cacheProperty(const QString &key, const QVariant &value) const;
-
+    void cacheProperty(const QString &key, const QVariant &value, const QString &iface) const;
+    void collectGetAll(const QString &iface, QDBusPendingCallWatcher *watcher) const;
+    void invalidateDisplayCache() const;
+    void dropTypedCaches(const QString &key) const;
+    void clearTypedCaches() const;
+    void accountPropertyCache() const;
+    OrgFreedesktopDBusPropertiesInterface *propertiesInterface() const;
+
+    /* Backends are shared between all threads, so the cache state below is
+     * guarded by m_mutex; recursive because the accessors nest (e.g.
+     * checkCache() -> allProperties()). */
+    mutable QRecursiveMutex m_mutex;
     // NOTE: make sure to insert items only through cacheProperty
     mutable QVariantMap m_propertyCache;
+    /* Which D-Bus interface each cached key came from (empty string for
+     * single Gets without interface), so removing one interface drops only
+     * its keys instead of the whole cache. */
+    mutable QHash<QString, QSet<QString>> m_propertiesByInterface;
+    /* Static tier: identity and capability keys (Vendor, Model, Serial,
+     * RotationRate, ConnectionBus, ...) that cannot change while the
+     * hardware stays present. Wholesale invalidation restores these into
+     * the property cache instead of refetching them over the bus; only
+     * reseed(), an explicit invalidation from udisksd or destruction drops
+     * them. */
+    mutable QVariantMap m_staticCache;
+    mutable QHash<QString, QString> m_staticCacheIface;
+    /* Memoized typed views of m_propertyCache entries; cacheProperty()
+     * evicts a key when its variant changes. */
+    mutable QHash<QString, QString> m_stringCache;
+    mutable QHash<QString, bool> m_boolCache;
+    mutable QHash<QString, qulonglong> m_u64Cache;
+    mutable QString m_description;
+    mutable QString m_icon;
+    mutable QStringList m_emblems;
+    mutable bool m_descriptionValid = false;
+    mutable bool m_iconValid = false;
+    mutable bool m_emblemsValid = false;
+    // In-flight GetAll calls per interface; concurrent readers coalesce on these
+    mutable QHash<QString, QDBusPendingCallWatcher *> m_pendingGetAll;
+    /* Typed Properties proxy, created lazily under m_mutex; marshals GetAll
+     * calls with compile-time metadata instead of rebuilding the message
+     * strings on every sweep. Only asyncCall() is ever invoked on it, which
+     * is thread-safe. */
+    mutable OrgFreedesktopDBusPropertiesInterface *m_propsInterface = nullptr;
+    // Whole property set is known; cache misses need no bus traffic
+    mutable bool m_allFetched = false;
+
+    // last value reported to the process-wide memory accounting counter
+    mutable qint64 m_accountedBytes = 0;
     QStringList m_interfaces;
     QString m_udi;
-
-    static QThreadStorage<QMap<QString, DeviceBackend *>> s_backends;
 };
 
 } /* namespace UDisks2 */
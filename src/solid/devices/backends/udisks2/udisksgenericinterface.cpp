@@ -14,7 +14,10 @@ using namespace Solid::Backends::UDisks2;
 GenericInterface::GenericInterface(Device *device)
     : DeviceInterface(device)
 {
-    connect(device, SIGNAL(propertyChanged(QMap<QString, int>)), this, SIGNAL(propertyChanged(QMap<QString, int>)));
+    connect(device,
+            SIGNAL(propertyEventsChanged(QList<Solid::GenericInterface::PropertyChangeEvent>)),
+            this,
+            SIGNAL(propertyEventsChanged(QList<Solid::GenericInterface::PropertyChangeEvent>)));
 }
 
 GenericInterface::~GenericInterface()
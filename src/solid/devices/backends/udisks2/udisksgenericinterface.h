@@ -34,6 +34,7 @@ public:
 
 Q_SIGNALS:
     void propertyChanged(const QMap<QString, int> &changes) override;
+    void propertyEventsChanged(const QList<Solid::GenericInterface::PropertyChangeEvent> &events) override;
     void conditionRaised(const QString &condition, const QString &reason) override;
 };
 }
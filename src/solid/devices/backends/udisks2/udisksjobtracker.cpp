@@ -0,0 +1,108 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "udisksjobtracker.h"
+#include "udisksconnection.h"
+#include "udiskssignaldispatcher.h"
+
+#include <QCoreApplication>
+
+using namespace Solid::Backends::UDisks2;
+
+Q_GLOBAL_STATIC(JobTracker, s_jobTracker)
+
+JobTracker *JobTracker::instance()
+{
+    return s_jobTracker();
+}
+
+JobTracker::JobTracker()
+{
+    udisksBus().connect(QStringLiteral(UD2_DBUS_SERVICE),
+                        QStringLiteral(UD2_DBUS_PATH),
+                        QStringLiteral(DBUS_INTERFACE_MANAGER),
+                        QStringLiteral("InterfacesAdded"),
+                        this,
+                        SLOT(slotInterfacesAdded(QDBusObjectPath, VariantMapMap)));
+    udisksBus().connect(QStringLiteral(UD2_DBUS_SERVICE),
+                        QStringLiteral(UD2_DBUS_PATH),
+                        QStringLiteral(DBUS_INTERFACE_MANAGER),
+                        QStringLiteral("InterfacesRemoved"),
+                        this,
+                        SLOT(slotInterfacesRemoved(QDBusObjectPath, QStringList)));
+
+    /* Progress updates ride the shared PropertiesChanged subscription */
+    connect(SignalDispatcher::instance(), &SignalDispatcher::propertiesChangedBatch, this, [this](const QList<SignalDispatcher::ChangeSet> &changes) {
+        for (const SignalDispatcher::ChangeSet &change : changes) {
+            const auto it = m_jobs.constFind(change.path);
+            if (it == m_jobs.cend()) {
+                continue;
+            }
+
+            const QVariant progress = change.changedProperties.value(QStringLiteral("Progress"));
+            if (!progress.isValid()) {
+                continue;
+            }
+
+            for (const QString &udi : it->objects) {
+                Q_EMIT jobProgress(udi, it->operation, progress.toDouble());
+            }
+        }
+    });
+
+    /* Consumers may first touch us from a short-lived worker thread */
+    QCoreApplication *app = QCoreApplication::instance();
+    if (app && thread() != app->thread()) {
+        moveToThread(app->thread());
+    }
+}
+
+void JobTracker::slotInterfacesAdded(const QDBusObjectPath &object_path, const VariantMapMap &interfaces_and_properties)
+{
+    const QString path = object_path.path();
+    if (!path.startsWith(QStringLiteral(UD2_DBUS_PATH_JOBS "/"))) {
+        return;
+    }
+
+    const QVariantMap props = interfaces_and_properties.value(QStringLiteral(UD2_DBUS_SERVICE ".Job"));
+    if (props.isEmpty()) {
+        return;
+    }
+
+    Job job;
+    job.operation = props.value(QStringLiteral("Operation")).toString();
+    const auto objects = qdbus_cast<QList<QDBusObjectPath>>(props.value(QStringLiteral("Objects")));
+    for (const QDBusObjectPath &object : objects) {
+        job.objects.append(object.path());
+    }
+
+    if (job.objects.isEmpty()) {
+        return;
+    }
+
+    m_jobs.insert(path, job);
+
+    if (props.value(QStringLiteral("ProgressValid")).toBool()) {
+        const double progress = props.value(QStringLiteral("Progress")).toDouble();
+        for (const QString &udi : std::as_const(job.objects)) {
+            Q_EMIT jobProgress(udi, job.operation, progress);
+        }
+    }
+}
+
+void JobTracker::slotInterfacesRemoved(const QDBusObjectPath &object_path, const QStringList &interfaces)
+{
+    if (!interfaces.contains(QStringLiteral(UD2_DBUS_SERVICE ".Job"))) {
+        return;
+    }
+
+    const Job job = m_jobs.take(object_path.path());
+    for (const QString &udi : job.objects) {
+        Q_EMIT jobProgress(udi, job.operation, 1.0);
+    }
+}
+
+#include "moc_udisksjobtracker.cpp"
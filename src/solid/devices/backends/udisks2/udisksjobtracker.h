@@ -0,0 +1,65 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef UDISKSJOBTRACKER_H
+#define UDISKSJOBTRACKER_H
+
+#include "udisks2.h"
+
+#include <QDBusObjectPath>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDisks2
+{
+/* Tracks org.freedesktop.UDisks2.Job objects and fans their progress out
+ * per target device.
+ *
+ * udisksd publishes a Job object for long-running operations (mount,
+ * unmount, format, repair, ...) carrying the operation name, the object
+ * paths it works on, and a Progress property updated as it runs. The
+ * manager deliberately ignores everything under the jobs path; this
+ * tracker watches it instead, so interested device interfaces get
+ * event-driven progress rather than polling properties on a timer.
+ */
+class JobTracker : public QObject
+{
+    Q_OBJECT
+
+public:
+    JobTracker();
+
+    static JobTracker *instance();
+
+Q_SIGNALS:
+    /* Emitted per target object of a running job; @p progress is the
+     * completion fraction in [0.0, 1.0], reported as 1.0 when the job
+     * object disappears. */
+    void jobProgress(const QString &udi, const QString &operation, double progress);
+
+private Q_SLOTS:
+    void slotInterfacesAdded(const QDBusObjectPath &object_path, const VariantMapMap &interfaces_and_properties);
+    void slotInterfacesRemoved(const QDBusObjectPath &object_path, const QStringList &interfaces);
+
+private:
+    struct Job {
+        QString operation;
+        QStringList objects;
+    };
+
+    QHash<QString /* job path */, Job> m_jobs;
+};
+
+}
+}
+}
+
+#endif // UDISKSJOBTRACKER_H
@@ -5,14 +5,34 @@
 */
 
 #include "udisksmanager.h"
+#include "dbus/interfaces.h"
 #include "udisks_debug.h"
+#include "udisksconnection.h"
 #include "udisksdevicebackend.h"
+#include "udisksopticaldisc.h"
+#include "udiskssignaldispatcher.h"
+#include "udiskssnapshotmatch.h"
+#include "udistringpool_p.h"
 
+#include "solidstatistics_p.h"
+#include "solidtrace_p.h"
+#include "solidwatchdog_p.h"
+
+#include <QDBusArgument>
 #include <QDBusConnection>
 #include <QDBusConnectionInterface>
 #include <QDBusMetaType>
 #include <QDBusObjectPath>
-#include <QDomDocument>
+#include <QDBusPendingCallWatcher>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QXmlStreamReader>
+
+#include <algorithm>
 
 #include "../shared/rootdevice.h"
 
@@ -21,7 +41,7 @@ using namespace Solid::Backends::Shared;
 
 Manager::Manager(QObject *parent)
     : Solid::Ifaces::DeviceManager(parent)
-    , m_manager(QStringLiteral(UD2_DBUS_SERVICE), QStringLiteral(UD2_DBUS_PATH), QDBusConnection::systemBus())
+    , m_manager(QStringLiteral(UD2_DBUS_SERVICE), QStringLiteral(UD2_DBUS_PATH), udisksBus())
 {
     m_supportedInterfaces = {
         Solid::DeviceInterface::GenericInterface,
@@ -38,61 +58,203 @@ Manager::Manager(QObject *parent)
     qDBusRegisterMetaType<VariantMapMap>();
     qDBusRegisterMetaType<DBUSManagerStruct>();
 
-    bool serviceFound = m_manager.isValid();
-    if (!serviceFound) {
+    /* Service discovery and activation happen in ensureService(); the
+     * constructor itself stays allocation-only. The backend is only
+     * materialized once somebody asks for storage, though, so a query is
+     * coming: warm the device cache up in the background as soon as the
+     * event loop runs, and the first real query typically finds the cache
+     * populated and reduces to a list copy. */
+    QTimer::singleShot(0, this, &Manager::warmUpCache);
+}
+
+void Manager::warmUpCache()
+{
+    /* a query that arrived before the timer fired has already populated the
+     * cache or put the enumeration call in flight */
+    if (!m_deviceSet.isEmpty() || m_hasPendingManagedObjects || !ensureService()) {
+        return;
+    }
+
+    m_pendingManagedObjects = m_manager.GetManagedObjects();
+    m_hasPendingManagedObjects = true;
+
+    auto *watcher = new QDBusPendingCallWatcher(m_pendingManagedObjects, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+        if (m_hasPendingManagedObjects && m_deviceSet.isEmpty()) {
+            deviceCache(); // the reply is in; harvesting it no longer blocks
+        }
+    });
+}
+
+bool Manager::ensureService()
+{
+    if (m_serviceProbed) {
+        return m_serviceAvailable;
+    }
+    m_serviceProbed = true;
+
+    m_serviceAvailable = m_manager.isValid();
+    if (!m_serviceAvailable) {
         // find out whether it will be activated automatically
         QDBusMessage message = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.DBus"), //
                                                               QStringLiteral("/org/freedesktop/DBus"),
                                                               QStringLiteral("org.freedesktop.DBus"),
                                                               QStringLiteral("ListActivatableNames"));
 
-        QDBusReply<QStringList> reply = QDBusConnection::systemBus().call(message);
+        QDBusMessage replyMessage;
+        {
+            const Solid::Watchdog::BlockingCallGuard guard(UDISKS2(), "Manager::ensureService", QStringLiteral("ListActivatableNames"));
+            replyMessage = udisksBus().call(message);
+        }
+        QDBusReply<QStringList> reply = replyMessage;
         if (reply.isValid() && reply.value().contains(QStringLiteral(UD2_DBUS_SERVICE))) {
-            QDBusConnection::systemBus().interface()->startService(QStringLiteral(UD2_DBUS_SERVICE));
-            serviceFound = true;
+            /* Fire the activation request without blocking; the first real
+             * method call simply queues behind the autostart in dbus-daemon. */
+            udisksBus().interface()->asyncCall(QStringLiteral("StartServiceByName"), QStringLiteral(UD2_DBUS_SERVICE), 0u);
+            m_serviceAvailable = true;
         }
     }
 
-    if (serviceFound) {
-        connect(&m_manager, SIGNAL(InterfacesAdded(QDBusObjectPath, VariantMapMap)), this, SLOT(slotInterfacesAdded(QDBusObjectPath, VariantMapMap)));
-        connect(&m_manager, SIGNAL(InterfacesRemoved(QDBusObjectPath, QStringList)), this, SLOT(slotInterfacesRemoved(QDBusObjectPath, QStringList)));
+    if (m_serviceAvailable && m_monitoringEnabled) {
+        armEventSignals();
     }
+
+    return m_serviceAvailable;
+}
+
+void Manager::armEventSignals()
+{
+    if (m_eventsArmed) {
+        return;
+    }
+    m_eventsArmed = true;
+
+    connect(&m_manager, SIGNAL(InterfacesAdded(QDBusObjectPath, VariantMapMap)), this, SLOT(slotInterfacesAdded(QDBusObjectPath, VariantMapMap)));
+    connect(&m_manager, SIGNAL(InterfacesRemoved(QDBusObjectPath, QStringList)), this, SLOT(slotInterfacesRemoved(QDBusObjectPath, QStringList)));
+
+    /* Media changes for optical-capable devices arrive through the
+     * shared service-wide PropertiesChanged subscription; we keep a
+     * path set instead of one dbus-daemon match rule per drive. */
+    connect(SignalDispatcher::instance(), &SignalDispatcher::propertiesChangedBatch, this, &Manager::slotPropertiesChangedBatch);
+}
+
+void Manager::disarmEventSignals()
+{
+    if (!m_eventsArmed) {
+        return;
+    }
+    m_eventsArmed = false;
+
+    disconnect(&m_manager, SIGNAL(InterfacesAdded(QDBusObjectPath, VariantMapMap)), this, SLOT(slotInterfacesAdded(QDBusObjectPath, VariantMapMap)));
+    disconnect(&m_manager, SIGNAL(InterfacesRemoved(QDBusObjectPath, QStringList)), this, SLOT(slotInterfacesRemoved(QDBusObjectPath, QStringList)));
+    disconnect(SignalDispatcher::instance(), &SignalDispatcher::propertiesChangedBatch, this, &Manager::slotPropertiesChangedBatch);
+}
+
+void Manager::setMonitoringEnabled(bool enabled)
+{
+    if (m_monitoringEnabled == enabled) {
+        return;
+    }
+    m_monitoringEnabled = enabled;
+
+    if (!enabled) {
+        disarmEventSignals();
+        return;
+    }
+
+    if (m_serviceProbed && m_serviceAvailable) {
+        armEventSignals();
+        if (!m_deviceSet.isEmpty()) {
+            /* the topology was built while no events flowed; reconcile it
+             * against udisksd once to pick up whatever we missed */
+            refreshTopology();
+        }
+    }
+    /* otherwise ensureService() arms the signals on first use */
+}
+
+/* Asks udisksd for the full object tree and reconciles the cached topology
+ * against it, reseeding the property caches of surviving devices along the
+ * way. Asynchronous: the current query may still see the stale state, the
+ * next one sees the fresh one. */
+void Manager::refreshTopology()
+{
+    auto *watcher = new QDBusPendingCallWatcher(m_manager.GetManagedObjects(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+        QDBusPendingReply<DBUSManagerStruct> reply = *watcher;
+        if (!reply.isValid()) {
+            qCWarning(UDISKS2) << "GetManagedObjects failed:" << reply.error().name() << "\n"
+                               << reply.error().message() << "; keeping current topology";
+            return;
+        }
+        reconcile(reply.reply());
+    });
 }
 
 Manager::~Manager()
 {
-    while (!m_deviceCache.isEmpty()) {
-        QString udi = m_deviceCache.takeFirst();
+    for (const QString &udi : std::as_const(m_deviceSet)) {
         DeviceBackend::destroyBackend(udi);
     }
+    m_deviceCache.clear();
+    m_deviceSet.clear();
 }
 
 QObject *Manager::createDevice(const QString &udi)
 {
     if (udi == udiPrefix()) {
-        RootDevice *root = new RootDevice(udi);
+        /* The frontend owns and deletes what createDevice() returns, so keep
+         * a configured prototype and hand out clones; the clones share the
+         * translated strings instead of re-running tr() on every refresh. */
+        if (!m_rootDevice) {
+            m_rootDevice = new RootDevice(udi);
+            m_rootDevice->setParent(this);
+            m_rootDevice->setProduct(tr("Storage"));
+            m_rootDevice->setDescription(tr("Storage devices"));
+            m_rootDevice->setIcon(QStringLiteral("server-database")); // Obviously wasn't meant for that, but maps nicely in oxygen icon set :-p
+        }
 
-        root->setProduct(tr("Storage"));
-        root->setDescription(tr("Storage devices"));
-        root->setIcon(QStringLiteral("server-database")); // Obviously wasn't meant for that, but maps nicely in oxygen icon set :-p
+        return m_rootDevice->clone();
+    }
 
-        return root;
-    } else if (deviceCache().contains(udi)) {
+    deviceCache(); // ensure the cache is populated
+    if (m_deviceSet.contains(udi)) {
         return new Device(udi);
     } else {
         return nullptr;
     }
 }
 
+/* Type check against the cached property maps; falls back to a full Device
+ * in the unexpected case where no backend exists for a cached udi. */
+static bool snapshotProvides(const QString &udi, Solid::DeviceInterface::Type type)
+{
+    if (DeviceBackend *backend = DeviceBackend::backendForUDI(udi, false)) {
+        return snapshotHasInterface(backend, type);
+    }
+
+    Device device(udi);
+    return device.queryDeviceInterface(type);
+}
+
 QStringList Manager::devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
 {
     QStringList result;
     const QStringList deviceList = deviceCache();
 
     if (!parentUdi.isEmpty()) {
-        for (const QString &udi : deviceList) {
-            Device device(udi);
-            if (device.queryDeviceInterface(type) && device.parentUdi() == parentUdi) {
+        /* Answer hierarchical queries from the adjacency index instead of
+         * scanning every cached device; only the children of the requested
+         * parent are inspected for the type filter. */
+        const QStringList children = m_children.value(parentUdi);
+        if (type == Solid::DeviceInterface::Unknown) {
+            return children;
+        }
+
+        for (const QString &udi : children) {
+            if (snapshotProvides(udi, type)) {
                 result << udi;
             }
         }
@@ -100,8 +262,7 @@ QStringList Manager::devicesFromQuery(const QString &parentUdi, Solid::DeviceInt
         return result;
     } else if (type != Solid::DeviceInterface::Unknown) {
         for (const QString &udi : deviceList) {
-            Device device(udi);
-            if (device.queryDeviceInterface(type)) {
+            if (snapshotProvides(udi, type)) {
                 result << udi;
             }
         }
@@ -112,54 +273,509 @@ QStringList Manager::devicesFromQuery(const QString &parentUdi, Solid::DeviceInt
     return deviceCache();
 }
 
+QStringList Manager::devicesFromQuery(const QString &parentUdi, const Solid::Predicate &predicate)
+{
+    if (!predicate.isValid()) {
+        return Solid::Ifaces::DeviceManager::devicesFromQuery(parentUdi, predicate);
+    }
+
+    const QStringList deviceList = deviceCache();
+    const QStringList candidates = parentUdi.isEmpty() ? deviceList : m_children.value(parentUdi);
+
+    /* Filter on the property maps the backends already hold; no Device or
+     * device interface object is constructed here. A device is only dropped
+     * on a certain No — Unknown verdicts stay in the candidate list and the
+     * frontend settles them. */
+    QStringList result;
+    for (const QString &udi : candidates) {
+        DeviceBackend *backend = DeviceBackend::backendForUDI(udi, false);
+        if (!backend || matchFromSnapshot(predicate, backend) != SnapshotVerdict::No) {
+            result << udi;
+        }
+    }
+
+    return result;
+}
+
+qsizetype Manager::countFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
+{
+    /* untyped counts come straight off the cached topology; typed ones
+     * need per-device interface checks and take the generic path */
+    if (type == Solid::DeviceInterface::Unknown) {
+        deviceCache(); // also maintains the adjacency index
+        if (!parentUdi.isEmpty()) {
+            return m_children.value(parentUdi).size();
+        }
+        return m_deviceCache.size();
+    }
+
+    return Solid::Ifaces::DeviceManager::countFromQuery(parentUdi, type);
+}
+
+QString Manager::udiFromDeviceFile(const QString &deviceFile)
+{
+    if (!deviceFile.startsWith(QLatin1String("/dev/"))) {
+        return QString();
+    }
+
+    /* UDisks2 derives its object paths from the device name, escaping
+     * everything outside [A-Za-z0-9] as _xx; recreating that mapping gives
+     * us the candidate UDI without any enumeration. */
+    const QString name = deviceFile.mid(5); // drop "/dev/"
+    QString escaped;
+    escaped.reserve(name.size());
+    for (const QChar &c : name) {
+        if (c.isLetterOrNumber() && c.unicode() < 128) {
+            escaped += c;
+        } else {
+            escaped += QStringLiteral("_%1").arg(c.unicode(), 2, 16, QLatin1Char('0'));
+        }
+    }
+
+    const QString udi = Solid::internedUdi(QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES "/") + escaped);
+
+    Device device(udi);
+    if (device.isBlock()) {
+        return udi;
+    }
+
+    return QString();
+}
+
+void Manager::beginEnumeration()
+{
+    /* Fire the enumeration call without waiting; allDevices() harvests it.
+     * This lets the frontend overlap our round trip with the enumeration
+     * of the other backends. */
+    if (!m_hasPendingManagedObjects && m_deviceSet.isEmpty() && ensureService()) {
+        m_pendingManagedObjects = m_manager.GetManagedObjects();
+        m_hasPendingManagedObjects = true;
+    } else if (!m_monitoringEnabled && !m_deviceSet.isEmpty() && ensureService()) {
+        /* no events keep the topology fresh while monitoring is off, so
+         * reconcile once per enumeration round instead */
+        refreshTopology();
+    }
+}
+
+namespace
+{
+/* Properties stable for as long as the hardware stays plugged; everything
+ * else is fetched on demand once an application actually asks for it. */
+bool isStaticProperty(const QString &key)
+{
+    static const QSet<QString> staticKeys{
+        QStringLiteral("Vendor"),
+        QStringLiteral("Model"),
+        QStringLiteral("Serial"),
+        QStringLiteral("Revision"),
+        QStringLiteral("Id"),
+        QStringLiteral("WWN"),
+        QStringLiteral("ConnectionBus"),
+        QStringLiteral("Media"),
+        QStringLiteral("MediaCompatibility"),
+        QStringLiteral("MediaRemovable"),
+        QStringLiteral("Removable"),
+        QStringLiteral("Ejectable"),
+        QStringLiteral("Optical"),
+        QStringLiteral("Device"),
+        QStringLiteral("PreferredDevice"),
+        QStringLiteral("Drive"),
+        QStringLiteral("HintIgnore"),
+        QStringLiteral("HintName"),
+        QStringLiteral("HintIconName"),
+    };
+
+    return staticKeys.contains(key);
+}
+
+/* The slice of a device payload worth persisting in the topology snapshot. */
+VariantMapMap staticSnapshotSubset(const VariantMapMap &payload)
+{
+    VariantMapMap interfaces;
+    for (auto ifaceIt = payload.cbegin(); ifaceIt != payload.cend(); ++ifaceIt) {
+        QVariantMap props;
+        const QVariantMap &allProps = ifaceIt.value();
+        for (auto propIt = allProps.cbegin(); propIt != allProps.cend(); ++propIt) {
+            if (isStaticProperty(propIt.key())) {
+                props.insert(propIt.key(), propIt.value());
+            }
+        }
+        /* Keep the interface entry even without static properties;
+         * the interface list itself is what drives classification. */
+        interfaces.insert(ifaceIt.key(), props);
+    }
+    return interfaces;
+}
+
+/* Walks a GetManagedObjects reply in wire order and hands each block device
+ * or drive payload to @p visit as it is decoded. A qdbus_cast of the whole
+ * a{oa{sa{sv}}} argument materializes a map of maps of hundreds of devices
+ * only to be torn apart again; streaming over the QDBusArgument decodes each
+ * payload exactly once, skips jobs and the manager object without building
+ * maps for them, and interns the recurring keys so every payload shares one
+ * allocation per distinct interface or property name.
+ *
+ * Returns false when the reply does not carry the expected argument. */
+template<typename Visitor>
+bool forEachManagedObject(const QDBusMessage &reply, Visitor &&visit)
+{
+    if (reply.arguments().isEmpty()) {
+        return false;
+    }
+
+    const QVariant argument = reply.arguments().constFirst();
+    if (argument.userType() != qMetaTypeId<QDBusArgument>()) {
+        return false;
+    }
+
+    const QDBusArgument objects = qvariant_cast<QDBusArgument>(argument);
+    if (objects.currentType() != QDBusArgument::MapType) {
+        return false;
+    }
+
+    QHash<QString, QString> keyPool;
+    const auto interned = [&keyPool](const QString &key) -> QString {
+        auto it = keyPool.constFind(key);
+        if (it == keyPool.cend()) {
+            it = keyPool.insert(key, key);
+        }
+        return *it;
+    };
+
+    objects.beginMap();
+    while (!objects.atEnd()) {
+        objects.beginMapEntry();
+
+        QDBusObjectPath path;
+        objects >> path;
+
+        const QString udi = Solid::internedUdi(path.path());
+        const bool wanted = udi.startsWith(QLatin1String(UD2_DBUS_PATH_BLOCKDEVICES "/")) //
+            || udi.startsWith(QLatin1String(UD2_DBUS_PATH_DRIVES "/"));
+
+        /* The wire format forces decoding unwanted entries too, but their
+         * strings and variants are dropped right away instead of being
+         * collected into maps. */
+        VariantMapMap payload;
+        objects.beginMap();
+        while (!objects.atEnd()) {
+            objects.beginMapEntry();
+            QString iface;
+            objects >> iface;
+
+            QVariantMap props;
+            objects.beginMap();
+            while (!objects.atEnd()) {
+                objects.beginMapEntry();
+                QString key;
+                QVariant value;
+                objects >> key >> value;
+                if (wanted) {
+                    props.insert(interned(key), value);
+                }
+                objects.endMapEntry();
+            }
+            objects.endMap();
+
+            if (wanted) {
+                payload.insert(interned(iface), props);
+            }
+            objects.endMapEntry();
+        }
+        objects.endMap();
+
+        objects.endMapEntry();
+
+        if (wanted) {
+            visit(udi, payload);
+        }
+    }
+    objects.endMap();
+
+    return true;
+}
+}
+
 QStringList Manager::allDevices()
 {
     m_deviceCache.clear();
+    m_deviceSet.clear();
+    m_deviceCacheDirty = false;
+    m_children.clear();
+    m_parentOf.clear();
+
+    if (!ensureService()) {
+        return m_deviceCache;
+    }
+
+    /* Cold start: if last session's topology snapshot is still plausible,
+     * expose it immediately and reconcile against udisksd asynchronously,
+     * so applications show the storage tree without waiting for the
+     * enumeration round trip (or for service activation). */
+    if (loadTopologySnapshot()) {
+        QDBusPendingReply<DBUSManagerStruct> pending = m_hasPendingManagedObjects ? m_pendingManagedObjects : m_manager.GetManagedObjects();
+        m_hasPendingManagedObjects = false;
+
+        auto *watcher = new QDBusPendingCallWatcher(pending, this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher]() {
+            watcher->deleteLater();
+            QDBusPendingReply<DBUSManagerStruct> reply = *watcher;
+            if (!reply.isValid()) {
+                qCWarning(UDISKS2) << "GetManagedObjects failed:" << reply.error().name() << "\n"
+                                   << reply.error().message() << "; keeping snapshot topology";
+                return;
+            }
+            reconcile(reply.reply());
+        });
+
+        return m_deviceCache;
+    }
+
+    /* Fetch the whole object tree, including interface lists and all
+     * properties, in a single D-Bus call and stream the payloads straight
+     * into the per-device backends. Enumeration then needs no further round
+     * trips, and the reply's map-of-maps is never materialized. */
+    QDBusPendingReply<DBUSManagerStruct> reply = m_hasPendingManagedObjects ? m_pendingManagedObjects : m_manager.GetManagedObjects();
+    m_hasPendingManagedObjects = false;
+    reply.waitForFinished();
+
+    bool walked = false;
+    QMap<QString, VariantMapMap> snapshot;
+    QStringList seeded;
+
+    if (reply.isValid()) {
+        walked = forEachManagedObject(reply.reply(), [&](const QString &udi, const VariantMapMap &payload) {
+            DeviceBackend::seedBackendForUDI(udi, payload);
+            seeded.append(udi);
+            snapshot.insert(udi, staticSnapshotSubset(payload));
+        });
+    }
 
-    introspect(QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES), true /*checkOptical*/);
-    introspect(QStringLiteral(UD2_DBUS_PATH_DRIVES));
+    if (!walked) {
+        qCWarning(UDISKS2) << "GetManagedObjects failed:" << reply.error().name() << "\n"
+                           << reply.error().message() << "; falling back to introspection";
+        introspect(QStringLiteral(UD2_DBUS_PATH_BLOCKDEVICES), true /*checkOptical*/);
+        introspect(QStringLiteral(UD2_DBUS_PATH_DRIVES));
+
+        return m_deviceCache;
+    }
+
+    /* Classify only once everything is seeded: optical detection on a block
+     * device reads properties of its drive, and wire order does not
+     * guarantee the drive arrived first. */
+    for (const QString &udi : std::as_const(seeded)) {
+        if (watchAndClassify(udi)) { // skip empty CD disc
+            cacheDevice(udi);
+        }
+    }
+
+    writeTopologySnapshot(snapshot);
 
     return m_deviceCache;
 }
 
+namespace
+{
+const quint32 s_snapshotMagic = 0x53554432; // 'SUD2'
+const quint32 s_snapshotVersion = 1;
+
+QString snapshotPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/solid-udisks2-topology.cache");
+}
+
+/* Cheap generation marker: the set of whole block devices known to the
+ * kernel. Any plug or unplug between sessions changes it; finer-grained
+ * drift is caught by the asynchronous reconciliation pass. */
+QStringList generationMarker()
+{
+    return QDir(QStringLiteral("/sys/block")).entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+}
+}
+
+bool Manager::loadTopologySnapshot()
+{
+    QFile file(snapshotPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != s_snapshotMagic || version != s_snapshotVersion) {
+        return false;
+    }
+
+    QStringList marker;
+    in >> marker;
+    if (marker != generationMarker()) {
+        return false;
+    }
+
+    QMap<QString, VariantMapMap> devices;
+    in >> devices;
+    if (in.status() != QDataStream::Ok || devices.isEmpty()) {
+        return false;
+    }
+
+    /* Seed every backend before classification: optical detection on a
+     * block device reads properties of its drive. */
+    for (auto it = devices.cbegin(); it != devices.cend(); ++it) {
+        DeviceBackend::seedBackendForUDI(Solid::internedUdi(it.key()), it.value());
+    }
+
+    for (auto it = devices.cbegin(); it != devices.cend(); ++it) {
+        const QString udi = Solid::internedUdi(it.key());
+        if (watchAndClassify(udi)) {
+            cacheDevice(udi);
+        }
+    }
+
+    qCDebug(UDISKS2) << "Restored" << m_deviceCache.size() << "devices from topology snapshot";
+
+    return !m_deviceCache.isEmpty();
+}
+
+void Manager::writeTopologySnapshot(const QMap<QString, VariantMapMap> &devices)
+{
+    QSaveFile file(snapshotPath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    QDataStream out(&file);
+    out << s_snapshotMagic << s_snapshotVersion << generationMarker() << devices;
+    file.commit();
+}
+
+void Manager::reconcile(const QDBusMessage &reply)
+{
+    QSet<QString> current;
+    QMap<QString, VariantMapMap> snapshot;
+
+    forEachManagedObject(reply, [&](const QString &udi, const VariantMapMap &payload) {
+        current.insert(udi);
+        snapshot.insert(udi, staticSnapshotSubset(payload));
+
+        if (m_deviceSet.contains(udi)) {
+            /* Replace the snapshot's data with the authoritative payload */
+            if (DeviceBackend *backend = DeviceBackend::backendForUDI(udi, false)) {
+                backend->reseed(payload);
+            }
+        } else {
+            DeviceBackend::seedBackendForUDI(udi, payload);
+            if (watchAndClassify(udi)) {
+                cacheDevice(udi);
+                Q_EMIT deviceAdded(udi);
+            }
+        }
+    });
+
+    const QSet<QString> known = m_deviceSet;
+    for (const QString &udi : known) {
+        if (!current.contains(udi)) {
+            Q_EMIT deviceRemoved(udi);
+            dropDevice(udi);
+            DeviceBackend::destroyBackend(udi);
+        }
+    }
+
+    writeTopologySnapshot(snapshot);
+}
+
+/* Resolves the drive backend of a block device straight from the shared
+ * property caches. Enumeration seeds a backend for every managed object
+ * before classification runs, so these lookups hit existing backends and
+ * touch no bus; only the legacy introspection fallback still creates them. */
+static DeviceBackend *driveBackendFor(const QString &udi)
+{
+    DeviceBackend *block = DeviceBackend::backendForUDI(udi);
+    if (!block) {
+        return nullptr;
+    }
+
+    const QString drive = block->prop(QStringLiteral("Drive")).value<QDBusObjectPath>().path();
+    if (drive.isEmpty() || drive == QLatin1String("/")) {
+        return nullptr;
+    }
+
+    return DeviceBackend::backendForUDI(drive);
+}
+
+static bool isOpticalCapable(DeviceBackend *drive)
+{
+    return drive && !drive->prop(QStringLiteral("MediaCompatibility")).toStringList().filter(QStringLiteral("optical_")).isEmpty();
+}
+
+/* Registers media-change tracking for optical-capable devices; returns false
+ * for an empty optical disc, which must not enter the device cache. */
+bool Manager::watchAndClassify(const QString &udi)
+{
+    // Optimization, a loop device cannot really have a physical drive associated with it
+    if (udi.startsWith(QLatin1String(UD2_DBUS_PATH_BLOCKDEVICES "/")) //
+        && !udi.startsWith(QLatin1String(UD2_DBUS_PATH_BLOCKDEVICES "/loop"))) {
+        DeviceBackend *drive = driveBackendFor(udi);
+        if (isOpticalCapable(drive)) {
+            m_opticalPaths.insert(udi);
+            if (!drive->propBool(QStringLiteral("Optical"))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 void Manager::introspect(const QString &path, bool checkOptical)
 {
-    QDBusMessage call =
-        QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE), path, QStringLiteral(DBUS_INTERFACE_INTROSPECT), QStringLiteral("Introspect"));
-    QDBusPendingReply<QString> reply = QDBusConnection::systemBus().call(call);
+    const Solid::Trace::Timer traceTimer;
+    Solid::Stats::add(Solid::Stats::counters().introspectCalls);
+
+    org::freedesktop::DBus::Introspectable introspectable(QStringLiteral(UD2_DBUS_SERVICE), path, udisksBus());
+    QDBusPendingReply<QString> reply = introspectable.Introspect();
+    {
+        const Solid::Watchdog::BlockingCallGuard guard(UDISKS2(), "Manager::introspect", path);
+        reply.waitForFinished();
+    }
 
     if (reply.isValid()) {
-        QDomDocument dom;
-        dom.setContent(reply.value());
-        QDomNodeList nodeList = dom.documentElement().elementsByTagName(QStringLiteral("node"));
-        for (int i = 0; i < nodeList.count(); i++) {
-            QDomElement nodeElem = nodeList.item(i).toElement();
-            if (!nodeElem.isNull() && nodeElem.hasAttribute(QStringLiteral("name"))) {
-                const QString name = nodeElem.attribute(QStringLiteral("name"));
-                const QString udi = path + QStringLiteral("/") + name;
-
-                // Optimization, a loop device cannot really have a physical drive associated with it
-                if (checkOptical && !name.startsWith(QLatin1String("loop"))) {
-                    Device device(udi);
-                    if (device.mightBeOpticalDisc()) {
-                        QDBusConnection::systemBus().connect(QStringLiteral(UD2_DBUS_SERVICE), //
-                                                             udi,
-                                                             QStringLiteral(DBUS_INTERFACE_PROPS),
-                                                             QStringLiteral("PropertiesChanged"),
-                                                             this,
-                                                             SLOT(slotMediaChanged(QDBusMessage)));
-                        if (!device.isOpticalDisc()) { // skip empty CD disc
-                            continue;
-                        }
+        /* Only the child node names are needed from the introspection XML;
+         * stream over it like DeviceBackend::initInterfaces() does instead
+         * of materializing a DOM just to throw it away. */
+        QXmlStreamReader xml(reply.value());
+        while (!xml.atEnd() && !xml.hasError()) {
+            xml.readNext();
+            if (!xml.isStartElement() || xml.name() != QLatin1String("node")) {
+                continue;
+            }
+
+            const QString name = xml.attributes().value(QLatin1String("name")).toString();
+            if (name.isEmpty()) { // the document's own <node> element carries no name
+                continue;
+            }
+
+            const QString udi = Solid::internedUdi(path + QStringLiteral("/") + name);
+
+            // Optimization, a loop device cannot really have a physical drive associated with it
+            if (checkOptical && !name.startsWith(QLatin1String("loop"))) {
+                DeviceBackend *drive = driveBackendFor(udi);
+                if (isOpticalCapable(drive)) {
+                    m_opticalPaths.insert(udi);
+                    if (!drive->propBool(QStringLiteral("Optical"))) { // skip empty CD disc
+                        continue;
                     }
                 }
-
-                m_deviceCache.append(udi);
             }
+
+            cacheDevice(udi);
         }
     } else {
         qCWarning(UDISKS2) << "Failed enumerating UDisks2 objects:" << reply.error().name() << "\n" << reply.error().message();
     }
+
+    SOLID_TRACE2(udisks_introspect, qUtf8Printable(path), traceTimer.nsecs());
 }
 
 QSet<Solid::DeviceInterface::Type> Manager::supportedInterfaces() const
@@ -174,7 +790,7 @@ QString Manager::udiPrefix() const
 
 void Manager::slotInterfacesAdded(const QDBusObjectPath &object_path, const VariantMapMap &interfaces_and_properties)
 {
-    const QString udi = object_path.path();
+    const QString udi = Solid::internedUdi(object_path.path());
 
     /* Ignore jobs */
     if (udi.startsWith(QStringLiteral(UD2_DBUS_PATH_JOBS))) {
@@ -183,32 +799,35 @@ void Manager::slotInterfacesAdded(const QDBusObjectPath &object_path, const Vari
 
     qCDebug(UDISKS2) << udi << "has new interfaces:" << interfaces_and_properties.keys();
 
+    /* The signal payload carries the complete property map of every added
+     * interface, so a previously unseen device can be seeded from it without
+     * introspect/GetAll round trips; an existing backend merges the payload
+     * through its own InterfacesAdded handler. Properties of the other
+     * interfaces are kept fresh by PropertiesChanged, no refresh needed. */
+    DeviceBackend *backend = DeviceBackend::seedBackendForUDI(udi, interfaces_and_properties);
+    if (backend) {
+        invalidateParentDrive(backend);
+    }
+
     // If device gained an org.freedesktop.UDisks2.Block interface, we
     // should check if it is an optical drive, in order to properly
     // register mediaChanged event handler with newly-plugged external
     // drives
     if (interfaces_and_properties.contains(QStringLiteral("org.freedesktop.UDisks2.Block"))) {
-        Device device(udi);
-        if (device.mightBeOpticalDisc()) {
-            QDBusConnection::systemBus().connect(QStringLiteral(UD2_DBUS_SERVICE), //
-                                                 udi,
-                                                 QStringLiteral(DBUS_INTERFACE_PROPS),
-                                                 QStringLiteral("PropertiesChanged"),
-                                                 this,
-                                                 SLOT(slotMediaChanged(QDBusMessage)));
+        if (isOpticalCapable(driveBackendFor(udi))) {
+            m_opticalPaths.insert(udi);
         }
     }
 
-    updateBackend(udi);
-
     // new device, we don't know it yet
-    if (!m_deviceCache.contains(udi)) {
-        m_deviceCache.append(udi);
+    if (!m_deviceSet.contains(udi)) {
+        cacheDevice(udi);
         Q_EMIT deviceAdded(udi);
     }
-    // re-emit in case of 2-stage devices like N9 or some Android phones
-    else if (m_deviceCache.contains(udi) && interfaces_and_properties.keys().contains(QStringLiteral(UD2_DBUS_INTERFACE_FILESYSTEM))) {
-        Q_EMIT deviceAdded(udi);
+    // 2-stage devices like N9 or some Android phones gain their filesystem
+    // interface after the initial announcement
+    else if (interfaces_and_properties.keys().contains(QStringLiteral(UD2_DBUS_INTERFACE_FILESYSTEM))) {
+        Q_EMIT deviceInterfacesChanged(udi);
     }
 }
 
@@ -239,53 +858,107 @@ void Manager::slotInterfacesRemoved(const QDBusObjectPath &object_path, const QS
     if (leftInterfaces.isEmpty()) {
         // remove the device if the last interface is removed
         Q_EMIT deviceRemoved(udi);
-        m_deviceCache.removeAll(udi);
+        dropDevice(udi);
         DeviceBackend::destroyBackend(udi);
     } else {
         /*
          * Changes in the interface composition may change if a device
-         * matches a Predicate. We have to do a remove-and-readd cycle
-         * as there is no dedicated signal for Predicate reevaluation.
+         * matches a Predicate; let the frontend re-evaluate without the
+         * former remove-and-readd cycle.
          */
-        Q_EMIT deviceRemoved(udi);
-        Q_EMIT deviceAdded(udi);
+        Q_EMIT deviceInterfacesChanged(udi);
     }
 }
 
-void Manager::slotMediaChanged(const QDBusMessage &msg)
+void Manager::slotPropertiesChangedBatch(const QList<SignalDispatcher::ChangeSet> &changes)
 {
-    const QVariantMap properties = qdbus_cast<QVariantMap>(msg.arguments().at(1));
+    for (const SignalDispatcher::ChangeSet &change : changes) {
+        if (m_opticalPaths.contains(change.path)) {
+            slotMediaChanged(change.path, change.changedProperties);
+        }
 
+        /* relay property movement on known devices so the frontend drops
+         * its memoized query results; MountPoints flips here on every
+         * (un)mount, which is exactly what mutable-property predicates
+         * key on */
+        if (m_deviceSet.contains(change.path)) {
+            Q_EMIT deviceChanged(change.path);
+        }
+    }
+}
+
+void Manager::slotMediaChanged(const QString &udi, const QVariantMap &properties)
+{
     if (!properties.contains(QStringLiteral("Size"))) { // react only on Size changes
         return;
     }
 
-    const QString udi = msg.path();
     updateBackend(udi);
+    OpticalDisc::flushDiscStructure(udi); // whatever was derived belonged to the previous medium
     qulonglong size = properties.value(QStringLiteral("Size")).toULongLong();
     qCDebug(UDISKS2) << "MEDIA CHANGED in" << udi << "; size is:" << size;
 
-    if (!m_deviceCache.contains(udi) && size > 0) { // we don't know the optdisc, got inserted
-        m_deviceCache.append(udi);
+    if (!m_deviceSet.contains(udi) && size > 0) { // we don't know the optdisc, got inserted
+        cacheDevice(udi);
         Q_EMIT deviceAdded(udi);
-    }
-
-    if (m_deviceCache.contains(udi) && size == 0) { // we know the optdisc, got removed
+    } else if (m_deviceSet.contains(udi) && size == 0) { // we know the optdisc, got removed
         Q_EMIT deviceRemoved(udi);
-        m_deviceCache.removeAll(udi);
+        dropDevice(udi);
         DeviceBackend::destroyBackend(udi);
     }
 }
 
 const QStringList &Manager::deviceCache()
 {
-    if (m_deviceCache.isEmpty()) {
+    if (m_deviceSet.isEmpty()) {
         allDevices();
+    } else if (m_deviceCacheDirty) {
+        /* compact the tombstones left behind by O(1) removals */
+        m_deviceCache.erase(std::remove_if(m_deviceCache.begin(),
+                                           m_deviceCache.end(),
+                                           [this](const QString &udi) {
+                                               return !m_deviceSet.contains(udi);
+                                           }),
+                            m_deviceCache.end());
+        m_deviceCacheDirty = false;
     }
 
     return m_deviceCache;
 }
 
+void Manager::cacheDevice(const QString &udi)
+{
+    m_deviceSet.insert(udi);
+    m_deviceCache.append(udi);
+
+    /* Keep the parent→children adjacency index in step; the parent of a
+     * device (Drive for blocks, Table for partitions) never changes while
+     * it stays plugged. */
+    const QString parent = Device(udi).parentUdi();
+    if (!parent.isEmpty()) {
+        m_children[parent].append(udi);
+        m_parentOf.insert(udi, parent);
+    }
+}
+
+void Manager::dropDevice(const QString &udi)
+{
+    if (m_deviceSet.remove(udi)) {
+        m_deviceCacheDirty = true;
+    }
+
+    const QString parent = m_parentOf.take(udi);
+    if (!parent.isEmpty()) {
+        const auto it = m_children.find(parent);
+        if (it != m_children.end()) {
+            it->removeOne(udi);
+            if (it->isEmpty()) {
+                m_children.erase(it);
+            }
+        }
+    }
+}
+
 void Manager::updateBackend(const QString &udi)
 {
     DeviceBackend *backend = DeviceBackend::backendForUDI(udi);
@@ -294,8 +967,13 @@ void Manager::updateBackend(const QString &udi)
     }
 
     // This doesn't emit "changed" signals. Signals are emitted later by DeviceBackend's slots
-    backend->allProperties();
+    backend->refreshProperties();
 
+    invalidateParentDrive(backend);
+}
+
+void Manager::invalidateParentDrive(DeviceBackend *backend)
+{
     QVariant driveProp = backend->prop(QStringLiteral("Drive"));
     if (!driveProp.isValid()) {
         return;
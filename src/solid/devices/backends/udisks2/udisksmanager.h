@@ -11,15 +11,23 @@
 #include "dbus/manager.h"
 #include "udisks2.h"
 #include "udisksdevice.h"
+#include "udiskssignaldispatcher.h"
 
 #include <solid/devices/ifaces/devicemanager.h>
 
+#include <QDBusMessage>
+#include <QHash>
 #include <QSet>
 
 namespace Solid
 {
 namespace Backends
 {
+namespace Shared
+{
+class RootDevice;
+}
+
 namespace UDisks2
 {
 class Manager : public Solid::Ifaces::DeviceManager
@@ -30,7 +38,12 @@ public:
     Manager(QObject *parent);
     QObject *createDevice(const QString &udi) override;
     QStringList devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type) override;
+    QStringList devicesFromQuery(const QString &parentUdi, const Solid::Predicate &predicate) override;
+    qsizetype countFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type) override;
+    QString udiFromDeviceFile(const QString &deviceFile) override;
     QStringList allDevices() override;
+    void beginEnumeration() override;
+    void setMonitoringEnabled(bool enabled) override;
     QSet<Solid::DeviceInterface::Type> supportedInterfaces() const override;
     QString udiPrefix() const override;
     ~Manager() override;
@@ -38,15 +51,49 @@ public:
 private Q_SLOTS:
     void slotInterfacesAdded(const QDBusObjectPath &object_path, const VariantMapMap &interfaces_and_properties);
     void slotInterfacesRemoved(const QDBusObjectPath &object_path, const QStringList &interfaces);
-    void slotMediaChanged(const QDBusMessage &msg);
+    void slotPropertiesChangedBatch(const QList<Solid::Backends::UDisks2::SignalDispatcher::ChangeSet> &changes);
 
 private:
+    void slotMediaChanged(const QString &udi, const QVariantMap &properties);
     const QStringList &deviceCache();
+    void warmUpCache();
+    bool ensureService();
+    void armEventSignals();
+    void disarmEventSignals();
+    void refreshTopology();
+    bool watchAndClassify(const QString &udi);
+    bool loadTopologySnapshot();
+    void writeTopologySnapshot(const QMap<QString, VariantMapMap> &devices);
+    void reconcile(const QDBusMessage &reply);
+    void cacheDevice(const QString &udi);
+    void dropDevice(const QString &udi);
     void introspect(const QString &path, bool checkOptical = false);
     void updateBackend(const QString &udi);
+    void invalidateParentDrive(DeviceBackend *backend);
     QSet<Solid::DeviceInterface::Type> m_supportedInterfaces;
     org::freedesktop::DBus::ObjectManager m_manager;
+    /* Insertion-ordered enumeration list plus a hash set for O(1) membership
+     * checks in the event slots; removals only touch the set and leave
+     * tombstones in the list, compacted on the next enumeration. */
     QStringList m_deviceCache;
+    QSet<QString> m_deviceSet;
+    bool m_deviceCacheDirty = false;
+    /* optical-capable devices watched for media changes */
+    QSet<QString> m_opticalPaths;
+    /* parent→children adjacency, maintained by cacheDevice()/dropDevice() */
+    QHash<QString, QStringList> m_children;
+    QHash<QString, QString> m_parentOf;
+    QDBusPendingReply<DBUSManagerStruct> m_pendingManagedObjects;
+    bool m_hasPendingManagedObjects = false;
+    bool m_serviceProbed = false;
+    bool m_serviceAvailable = false;
+    /* whether the frontend wants hotplug events at all; while false the
+     * dbus-daemon match rules stay uninstalled and the topology is
+     * reconciled per enumeration instead */
+    bool m_monitoringEnabled = false;
+    bool m_eventsArmed = false;
+    /* configured once, cloned for every root device request */
+    Shared::RootDevice *m_rootDevice = nullptr;
 };
 
 }
@@ -0,0 +1,100 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "udisksmountqueue.h"
+#include "udisks_debug.h"
+#include "udisksconnection.h"
+#include "udisksstorageaccess.h"
+
+#include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+
+using namespace Solid::Backends::UDisks2;
+
+/* Keeps udisksd busy without flooding it; mount time for N independent
+ * volumes drops roughly by this factor. */
+static const int s_maxInFlight = 4;
+
+Q_GLOBAL_STATIC(MountQueue, s_mountQueue)
+
+MountQueue *MountQueue::instance()
+{
+    return s_mountQueue();
+}
+
+int MountQueue::maxInFlight()
+{
+    return s_maxInFlight;
+}
+
+bool MountQueue::enqueue(StorageAccess *requestor, const QDBusMessage &msg, const QString &dependencyKey, int timeout)
+{
+    m_pending.append(Job{requestor, msg, dependencyKey, timeout});
+    dispatch();
+    return true;
+}
+
+void MountQueue::dispatch()
+{
+    for (auto it = m_pending.begin(); it != m_pending.end() && m_inFlight < s_maxInFlight;) {
+        if (it->requestor.isNull()) { // requestor died while queued
+            it = m_pending.erase(it);
+            continue;
+        }
+
+        /* Keep operations on the same crypto chain strictly ordered;
+         * skip over them rather than stalling independent volumes. */
+        if (m_busyKeys.contains(it->dependencyKey)) {
+            ++it;
+            continue;
+        }
+
+        const Job job = *it;
+        it = m_pending.erase(it);
+        startJob(job);
+    }
+}
+
+void MountQueue::startJob(const Job &job)
+{
+    ++m_inFlight;
+    m_busyKeys.insert(job.dependencyKey);
+
+    qCDebug(UDISKS2) << "Dispatching" << job.message.member() << "to" << job.message.path() << "(" << m_inFlight << "in flight )";
+
+    QDBusPendingCall call = udisksBus().asyncCall(job.message, job.timeout);
+    auto *watcher = new QDBusPendingCallWatcher(call, this);
+    const QPointer<StorageAccess> requestor = job.requestor;
+    const QString key = job.dependencyKey;
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, watcher, requestor, key]() {
+        watcher->deleteLater();
+
+        if (!requestor.isNull()) {
+            if (watcher->isError()) {
+                requestor->slotDBusError(watcher->error());
+            } else {
+                requestor->slotDBusReply(watcher->reply());
+            }
+        }
+
+        jobFinished(key);
+    });
+}
+
+void MountQueue::jobFinished(const QString &dependencyKey)
+{
+    --m_inFlight;
+    m_busyKeys.remove(dependencyKey);
+
+    dispatch();
+
+    if (m_inFlight == 0 && m_pending.isEmpty()) {
+        Q_EMIT drained();
+    }
+}
+
+#include "moc_udisksmountqueue.cpp"
@@ -0,0 +1,76 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef UDISKSMOUNTQUEUE_H
+#define UDISKSMOUNTQUEUE_H
+
+#include <QDBusMessage>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDisks2
+{
+class StorageAccess;
+
+/* Process-wide dispatcher for Mount/Unmount/Unlock/Lock calls.
+ *
+ * Independent volumes are pipelined: up to maxInFlight() calls are kept
+ * outstanding on the bus at once instead of waiting for each reply before
+ * issuing the next one, so mounting many volumes overlaps in udisksd.
+ * Operations sharing a dependency key (a LUKS cleartext volume and its
+ * crypto backing device) stay strictly ordered. Replies and errors are
+ * routed back to the requesting StorageAccess exactly as if it had called
+ * the bus directly.
+ */
+class MountQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    static MountQueue *instance();
+
+    /* Queues @p msg and routes the reply to the requestor's
+     * slotDBusReply()/slotDBusError(). Operations with equal non-empty
+     * @p dependencyKey never run concurrently. @p timeout follows
+     * QDBusConnection::asyncCall() semantics (-1 for the default). */
+    bool enqueue(StorageAccess *requestor, const QDBusMessage &msg, const QString &dependencyKey, int timeout = -1);
+
+    static int maxInFlight();
+
+Q_SIGNALS:
+    /* Emitted when the last outstanding operation completes and nothing is
+     * left pending — an aggregate "all queued mounts settled" notification. */
+    void drained();
+
+private:
+    struct Job {
+        QPointer<StorageAccess> requestor;
+        QDBusMessage message;
+        QString dependencyKey;
+        int timeout;
+    };
+
+    void dispatch();
+    void startJob(const Job &job);
+    void jobFinished(const QString &dependencyKey);
+
+    QList<Job> m_pending;
+    QSet<QString> m_busyKeys;
+    int m_inFlight = 0;
+};
+
+}
+}
+}
+
+#endif // UDISKSMOUNTQUEUE_H
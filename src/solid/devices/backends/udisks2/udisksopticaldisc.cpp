@@ -11,9 +11,13 @@
 #include <sys/types.h>
 #include <unistd.h>
 
-#include <QMap>
+#include <QHash>
+#include <QMutex>
+#include <QSettings>
 #include <QSharedMemory>
+#include <QStandardPaths>
 #include <QSystemSemaphore>
+#include <QThread>
 #include <QThreadStorage>
 
 #include "soliddefs_p.h"
@@ -264,28 +268,47 @@ public:
         m_pointer = new (m_shmem.data()) ContentTypesCache;
     }
 
-    Solid::OpticalDisc::ContentTypes getContent(const OpticalDisc::Identity &info, const QByteArray &file)
+    bool find(const OpticalDisc::Identity &info, Solid::OpticalDisc::ContentTypes *content)
     {
         if (!m_pointer) {
-            return advancedDiscDetect(file);
+            return false;
         }
 
         if (!m_semaphore.acquire()) {
-            return advancedDiscDetect(file);
+            return false;
         }
         Releaser releaser(&m_semaphore);
 
         if (!m_shmem.lock()) {
-            return advancedDiscDetect(file);
+            return false;
         }
         Unlocker unlocker(&m_shmem);
 
         if (!m_pointer->find(info)) {
-            m_pointer->add(info, advancedDiscDetect(file));
+            return false;
         }
 
-        Solid::OpticalDisc::ContentTypes content = m_pointer->front().second;
-        return content;
+        *content = m_pointer->front().second;
+        return true;
+    }
+
+    void insert(const OpticalDisc::Identity &info, Solid::OpticalDisc::ContentTypes content)
+    {
+        if (!m_pointer) {
+            return;
+        }
+
+        if (!m_semaphore.acquire()) {
+            return;
+        }
+        Releaser releaser(&m_semaphore);
+
+        if (!m_shmem.lock()) {
+            return;
+        }
+        Unlocker unlocker(&m_shmem);
+
+        m_pointer->add(info, content);
     }
 
     ~SharedContentTypesCache()
@@ -298,6 +321,95 @@ public:
 
 Q_GLOBAL_STATIC(QThreadStorage<SharedContentTypesCache>, sharedContentTypesCache)
 
+/* On-disk layer below the shared-memory cache, so re-inserted discs never
+ * re-probe even across reboots. */
+Q_GLOBAL_STATIC(QMutex, persistentCacheMutex)
+
+static QString persistentCachePath()
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (dir.isEmpty()) {
+        return QString();
+    }
+    return dir + QLatin1String("/solid-disc-content-cache.ini");
+}
+
+static bool persistentCacheLookup(const QString &key, Solid::OpticalDisc::ContentTypes *content)
+{
+    const QString path = persistentCachePath();
+    if (path.isEmpty()) {
+        return false;
+    }
+
+    QMutexLocker locker(persistentCacheMutex());
+    QSettings settings(path, QSettings::IniFormat);
+    const QVariant value = settings.value(key);
+    if (!value.isValid()) {
+        return false;
+    }
+
+    *content = Solid::OpticalDisc::ContentTypes(value.toInt());
+    return true;
+}
+
+static void persistentCacheStore(const QString &key, Solid::OpticalDisc::ContentTypes content)
+{
+    const QString path = persistentCachePath();
+    if (path.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(persistentCacheMutex());
+    QSettings settings(path, QSettings::IniFormat);
+    settings.setValue(key, int(content));
+}
+
+/* One medium per drive: the derived structure is kept per block device,
+ * tagged with the disc identity, and shared by every OpticalDisc wrapper
+ * of that device — wrappers are short-lived, so an instance member alone
+ * would be rebuilt on every query. The manager's media-change path
+ * flushes the entry when a disc is inserted or ejected. */
+namespace
+{
+struct StructureCache {
+    QMutex mutex;
+    QHash<QString, Solid::Backends::UDisks2::OpticalDisc::Structure> byUdi;
+};
+}
+
+Q_GLOBAL_STATIC(StructureCache, s_structureCache)
+
+static Solid::OpticalDisc::DiscType discTypeForMedia(const QString &media)
+{
+    /* forward map built once, replacing the reverse QMap::key() scan that
+     * was rebuilt on every call */
+    static const QHash<QString, Solid::OpticalDisc::DiscType> map{
+        {QStringLiteral("optical_cd"), Solid::OpticalDisc::CdRom},
+        {QStringLiteral("optical_cd_r"), Solid::OpticalDisc::CdRecordable},
+        {QStringLiteral("optical_cd_rw"), Solid::OpticalDisc::CdRewritable},
+        {QStringLiteral("optical_dvd"), Solid::OpticalDisc::DvdRom},
+        {QStringLiteral("optical_dvd_r"), Solid::OpticalDisc::DvdRecordable},
+        {QStringLiteral("optical_dvd_rw"), Solid::OpticalDisc::DvdRewritable},
+        {QStringLiteral("optical_dvd_ram"), Solid::OpticalDisc::DvdRam},
+        {QStringLiteral("optical_dvd_plus_r"), Solid::OpticalDisc::DvdPlusRecordable},
+        {QStringLiteral("optical_dvd_plus_rw"), Solid::OpticalDisc::DvdPlusRewritable},
+        {QStringLiteral("optical_dvd_plus_r_dl"), Solid::OpticalDisc::DvdPlusRecordableDuallayer},
+        {QStringLiteral("optical_dvd_plus_rw_dl"), Solid::OpticalDisc::DvdPlusRewritableDuallayer},
+        {QStringLiteral("optical_bd"), Solid::OpticalDisc::BluRayRom},
+        {QStringLiteral("optical_bd_r"), Solid::OpticalDisc::BluRayRecordable},
+        {QStringLiteral("optical_bd_re"), Solid::OpticalDisc::BluRayRewritable},
+        {QStringLiteral("optical_hddvd"), Solid::OpticalDisc::HdDvdRom},
+        {QStringLiteral("optical_hddvd_r"), Solid::OpticalDisc::HdDvdRecordable},
+        {QStringLiteral("optical_hddvd_rw"), Solid::OpticalDisc::HdDvdRewritable},
+    };
+    // TODO add these to Solid
+    // optical_mo -> Solid::OpticalDisc::MagnetoOptical
+    // optical_mrw -> Solid::OpticalDisc::MountRainer
+    // optical_mrw_w -> Solid::OpticalDisc::MountRainerWritable
+
+    return map.value(media, Solid::OpticalDisc::UnknownDiscType);
+}
+
 OpticalDisc::Identity::Identity()
     : m_detectTime(0)
     , m_size(0)
@@ -321,6 +433,13 @@ bool OpticalDisc::Identity::operator==(const OpticalDisc::Identity &b) const
     /* clang-format on */
 }
 
+QString OpticalDisc::Identity::persistentKey() const
+{
+    /* Deliberately excludes the detection timestamp: the persistent layer
+     * must recognize a disc across re-insertions. */
+    return QString::number(m_size) + QLatin1Char('-') + QString::number(m_labelHash);
+}
+
 OpticalDisc::OpticalDisc(Device *dev)
     : StorageVolume(dev)
 {
@@ -336,107 +455,171 @@ OpticalDisc::OpticalDisc(Device *dev)
 
 OpticalDisc::~OpticalDisc()
 {
+    if (m_probeThread) {
+        m_probeThread->wait();
+        delete m_probeThread;
+    }
     delete m_drive;
 }
 
+const OpticalDisc::Structure &OpticalDisc::structure() const
+{
+    const Identity current(*m_device, *m_drive);
+    if (m_structureValid && m_structure.identity == current) {
+        return m_structure;
+    }
+
+    StructureCache *cache = s_structureCache();
+    QMutexLocker locker(&cache->mutex);
+    Structure &entry = cache->byUdi[m_device->udi()];
+    if (!(entry.identity == current)) {
+        entry.identity = current;
+        entry.media = m_drive->prop(QStringLiteral("Media")).toString();
+        entry.discType = discTypeForMedia(entry.media);
+        entry.capacity = m_device->prop(QStringLiteral("Size")).toULongLong();
+        entry.numDataTracks = m_drive->prop(QStringLiteral("OpticalNumDataTracks")).toUInt();
+        entry.numAudioTracks = m_drive->prop(QStringLiteral("OpticalNumAudioTracks")).toUInt();
+        entry.blank = m_drive->prop(QStringLiteral("OpticalBlank")).toBool();
+        // the hard way, udisks has no notion of a disc "rewritability"
+        /* clang-format off */
+        entry.rewritable = entry.media == QLatin1String("optical_cd_rw")
+            || entry.media == QLatin1String("optical_dvd_rw")
+            || entry.media == QLatin1String("optical_dvd_ram")
+            || entry.media == QLatin1String("optical_dvd_plus_rw")
+            || entry.media == QLatin1String("optical_dvd_plus_rw_dl")
+            || entry.media == QLatin1String("optical_bd_re")
+            || entry.media == QLatin1String("optical_hddvd_rw");
+        /* clang-format on */
+#if UDEV_FOUND
+        entry.appendable = m_udevDevice.deviceProperty(QStringLiteral("ID_CDROM_MEDIA_STATE")).toString() == QLatin1String("appendable");
+#elif defined(Q_OS_FREEBSD) || defined(Q_OS_OPENBSD)
+        entry.appendable = m_device->prop(QStringLiteral("bsdisks_IsAppendable")).toBool();
+#else
+#error Implement this or stub this out for your platform
+#endif
+    }
+
+    m_structure = entry;
+    m_structureValid = true;
+    return m_structure;
+}
+
+void OpticalDisc::flushDiscStructure(const QString &udi)
+{
+    StructureCache *cache = s_structureCache();
+    QMutexLocker locker(&cache->mutex);
+    cache->byUdi.remove(udi);
+}
+
 qulonglong OpticalDisc::capacity() const
 {
-    return m_device->prop(QStringLiteral("Size")).toULongLong();
+    return structure().capacity;
 }
 
 bool OpticalDisc::isRewritable() const
 {
-    // the hard way, udisks has no notion of a disc "rewritability"
-    const QString mediaType = media();
-    /* clang-format off */
-    return mediaType == QLatin1String("optical_cd_rw")
-        || mediaType == QLatin1String("optical_dvd_rw")
-        || mediaType == QLatin1String("optical_dvd_ram")
-        || mediaType == QLatin1String("optical_dvd_plus_rw")
-        || mediaType == QLatin1String("optical_dvd_plus_rw_dl")
-        || mediaType == QLatin1String("optical_bd_re")
-        || mediaType == QLatin1String("optical_hddvd_rw");
-    /* clang-format on */
+    return structure().rewritable;
 }
 
 bool OpticalDisc::isBlank() const
 {
-    return m_drive->prop(QStringLiteral("OpticalBlank")).toBool();
+    return structure().blank;
 }
 
 bool OpticalDisc::isAppendable() const
 {
-    // qDebug() << "appendable prop" << m_udevDevice.deviceProperty("ID_CDROM_MEDIA_STATE");
-#if UDEV_FOUND
-    return m_udevDevice.deviceProperty(QStringLiteral("ID_CDROM_MEDIA_STATE")).toString() == QLatin1String("appendable");
-#elif defined(Q_OS_FREEBSD) || defined(Q_OS_OPENBSD)
-    return m_device->prop(QStringLiteral("bsdisks_IsAppendable")).toBool();
-#else
-#error Implement this or stub this out for your platform
-#endif
+    return structure().appendable;
 }
 
 Solid::OpticalDisc::DiscType OpticalDisc::discType() const
 {
-    const QMap<Solid::OpticalDisc::DiscType, QString> map{
-        {Solid::OpticalDisc::CdRom, QStringLiteral("optical_cd")},
-        {Solid::OpticalDisc::CdRecordable, QStringLiteral("optical_cd_r")},
-        {Solid::OpticalDisc::CdRewritable, QStringLiteral("optical_cd_rw")},
-        {Solid::OpticalDisc::DvdRom, QStringLiteral("optical_dvd")},
-        {Solid::OpticalDisc::DvdRecordable, QStringLiteral("optical_dvd_r")},
-        {Solid::OpticalDisc::DvdRewritable, QStringLiteral("optical_dvd_rw")},
-        {Solid::OpticalDisc::DvdRam, QStringLiteral("optical_dvd_ram")},
-        {Solid::OpticalDisc::DvdPlusRecordable, QStringLiteral("optical_dvd_plus_r")},
-        {Solid::OpticalDisc::DvdPlusRewritable, QStringLiteral("optical_dvd_plus_rw")},
-        {Solid::OpticalDisc::DvdPlusRecordableDuallayer, QStringLiteral("optical_dvd_plus_r_dl")},
-        {Solid::OpticalDisc::DvdPlusRewritableDuallayer, QStringLiteral("optical_dvd_plus_rw_dl")},
-        {Solid::OpticalDisc::BluRayRom, QStringLiteral("optical_bd")},
-        {Solid::OpticalDisc::BluRayRecordable, QStringLiteral("optical_bd_r")},
-        {Solid::OpticalDisc::BluRayRewritable, QStringLiteral("optical_bd_re")},
-        {Solid::OpticalDisc::HdDvdRom, QStringLiteral("optical_hddvd")},
-        {Solid::OpticalDisc::HdDvdRecordable, QStringLiteral("optical_hddvd_r")},
-        {Solid::OpticalDisc::HdDvdRewritable, QStringLiteral("optical_hddvd_rw")},
-    };
-    // TODO add these to Solid
-    // map[Solid::OpticalDisc::MagnetoOptical] ="optical_mo";
-    // map[Solid::OpticalDisc::MountRainer] ="optical_mrw";
-    // map[Solid::OpticalDisc::MountRainerWritable] ="optical_mrw_w";
-
-    return map.key(media(), Solid::OpticalDisc::UnknownDiscType); // FIXME optimize, lookup by value, not key
+    return structure().discType;
 }
 
 Solid::OpticalDisc::ContentTypes OpticalDisc::availableContent() const
 {
-    if (isBlank()) {
+    const Structure &layout = structure();
+    if (layout.blank) {
         return Solid::OpticalDisc::NoContent;
     }
 
     Solid::OpticalDisc::ContentTypes content = Solid::OpticalDisc::NoContent;
-    const bool hasData = m_drive->prop(QStringLiteral("OpticalNumDataTracks")).toUInt() > 0;
-    const bool hasAudio = m_drive->prop(QStringLiteral("OpticalNumAudioTracks")).toUInt() > 0;
 
-    if (hasData) {
+    if (layout.numDataTracks > 0) {
         content |= Solid::OpticalDisc::Data;
 
-        Identity newIdentity(*m_device, *m_drive);
+        const Identity newIdentity = layout.identity;
         if (!(m_identity == newIdentity)) {
-            QByteArray deviceFile(m_device->prop(QStringLiteral("Device")).toByteArray());
-            m_cachedContent = sharedContentTypesCache->localData().getContent(newIdentity, deviceFile);
-            m_identity = newIdentity;
+            Solid::OpticalDisc::ContentTypes probed;
+            if (contentFromCaches(newIdentity, &probed)) {
+                m_cachedContent = probed;
+                m_identity = newIdentity;
+            } else if (!m_probePending) {
+                /* Never read disc structures on the caller's thread; the
+                 * refined result arrives via availableContentChanged(). */
+                m_probePending = true;
+                startProbe(newIdentity);
+            }
         }
 
         content |= m_cachedContent;
     }
-    if (hasAudio) {
+    if (layout.numAudioTracks > 0) {
         content |= Solid::OpticalDisc::Audio;
     }
 
     return content;
 }
 
+bool OpticalDisc::contentFromCaches(const Identity &identity, Solid::OpticalDisc::ContentTypes *content) const
+{
+    if (sharedContentTypesCache->localData().find(identity, content)) {
+        return true;
+    }
+
+    if (persistentCacheLookup(identity.persistentKey(), content)) {
+        /* seed the in-memory cache so the next miss doesn't hit the disk */
+        sharedContentTypesCache->localData().insert(identity, *content);
+        return true;
+    }
+
+    return false;
+}
+
+void OpticalDisc::startProbe(const Identity &identity) const
+{
+    const QByteArray deviceFile(m_device->prop(QStringLiteral("Device")).toByteArray());
+    auto *self = const_cast<OpticalDisc *>(this);
+
+    if (m_probeThread) { // an earlier, finished probe
+        m_probeThread->wait();
+        delete m_probeThread;
+    }
+
+    /* The destructor waits for the thread, so posting the result back to
+     * self with a queued call is safe. */
+    m_probeThread = QThread::create([self, identity, deviceFile]() {
+        const Solid::OpticalDisc::ContentTypes content = advancedDiscDetect(deviceFile);
+
+        sharedContentTypesCache->localData().insert(identity, content);
+        persistentCacheStore(identity.persistentKey(), content);
+
+        QMetaObject::invokeMethod(
+            self,
+            [self, identity, content]() {
+                self->m_identity = identity;
+                self->m_cachedContent = content;
+                self->m_probePending = false;
+                Q_EMIT self->availableContentChanged(self->availableContent());
+            },
+            Qt::QueuedConnection);
+    });
+    m_probeThread->start();
+}
+
 QString OpticalDisc::media() const
 {
-    return m_drive->prop(QStringLiteral("Media")).toString();
+    return structure().media;
 }
 
 #include "moc_udisksopticaldisc.cpp"
@@ -16,6 +16,8 @@
 #include "udisksdevice.h"
 #include "udisksstoragevolume.h"
 
+class QThread;
+
 namespace Solid
 {
 namespace Backends
@@ -44,6 +46,7 @@ public:
         Identity();
         Identity(const Device &device, const Device &drive);
         bool operator==(const Identity &) const;
+        QString persistentKey() const;
 
     private:
         long long m_detectTime;
@@ -51,10 +54,46 @@ public:
         uint m_labelHash;
     };
 
+    /**
+     * Track counts, media type and flags of the inserted medium. The
+     * whole block is immutable for a given disc, so it is derived once
+     * per medium and cached per drive, tagged with the disc Identity.
+     */
+    struct Structure {
+        Identity identity;
+        QString media;
+        Solid::OpticalDisc::DiscType discType = Solid::OpticalDisc::UnknownDiscType;
+        qulonglong capacity = 0;
+        uint numDataTracks = 0;
+        uint numAudioTracks = 0;
+        bool blank = false;
+        bool rewritable = false;
+        bool appendable = false;
+    };
+
+    /**
+     * Drops the cached structure for @p udi; called from the manager's
+     * media-change path when a disc is inserted or ejected.
+     */
+    static void flushDiscStructure(const QString &udi);
+
+Q_SIGNALS:
+    void availableContentChanged(Solid::OpticalDisc::ContentTypes content) override;
+
 private:
+    bool contentFromCaches(const Identity &identity, Solid::OpticalDisc::ContentTypes *content) const;
+    void startProbe(const Identity &identity) const;
+    const Structure &structure() const;
+
     mutable Identity m_identity;
     QString media() const;
+    /* per-instance copy of the shared structure entry, revalidated
+     * against the current disc identity on access */
+    mutable Structure m_structure;
+    mutable bool m_structureValid = false;
     mutable Solid::OpticalDisc::ContentTypes m_cachedContent;
+    mutable bool m_probePending = false;
+    mutable QThread *m_probeThread = nullptr;
     Device *m_drive;
 #if UDEV_FOUND
     UdevQt::Device m_udevDevice;
@@ -182,10 +182,17 @@ int OpticalDrive::readSpeed() const
 
 Solid::OpticalDrive::MediumTypes OpticalDrive::supportedMedia() const
 {
+    /* Burning frontends poll this repeatedly while setting up a session;
+     * the set only changes with the medium, so compute it once and let
+     * slotChanged() invalidate it together with the speeds. */
+    if (m_supportedMediaValid) {
+        return m_supportedMedia;
+    }
+
     const QStringList mediaTypes = m_device->prop(QStringLiteral("MediaCompatibility")).toStringList();
     Solid::OpticalDrive::MediumTypes supported;
 
-    QMap<QString, Solid::OpticalDrive::MediumType> map = {
+    static const QMap<QString, Solid::OpticalDrive::MediumType> map = {
         {QStringLiteral("optical_cd_r"), Solid::OpticalDrive::Cdr},
         {QStringLiteral("optical_cd_rw"), Solid::OpticalDrive::Cdrw},
         {QStringLiteral("optical_dvd"), Solid::OpticalDrive::Dvd},
@@ -213,12 +220,16 @@ Solid::OpticalDrive::MediumTypes OpticalDrive::supportedMedia() const
         supported |= map.value(media, Solid::OpticalDrive::UnknownMediumType);
     }
 
+    m_supportedMedia = supported;
+    m_supportedMediaValid = true;
+
     return supported;
 }
 
 void OpticalDrive::slotChanged()
 {
     m_speedsInit = false; // reset the read/write speeds, changes eg. with an inserted media
+    m_supportedMediaValid = false;
 }
 
 #include "moc_udisksopticaldrive.cpp"
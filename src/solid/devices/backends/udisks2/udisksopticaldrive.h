@@ -57,6 +57,10 @@ private:
     mutable int m_writeSpeed;
     mutable QList<int> m_writeSpeeds;
     mutable bool m_speedsInit;
+
+    // per-medium capability set, recomputed after media changes
+    mutable Solid::OpticalDrive::MediumTypes m_supportedMedia;
+    mutable bool m_supportedMediaValid = false;
 };
 
 }
@@ -0,0 +1,77 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "udiskssignaldispatcher.h"
+#include "udisks2.h"
+#include "udisksconnection.h"
+
+#include <QThread>
+
+#include <utility>
+
+using namespace Solid::Backends::UDisks2;
+
+Q_GLOBAL_STATIC(SignalDispatcher, s_dispatcher)
+
+SignalDispatcher *SignalDispatcher::instance()
+{
+    return s_dispatcher();
+}
+
+SignalDispatcher::SignalDispatcher()
+{
+    qRegisterMetaType<QList<SignalDispatcher::ChangeSet>>();
+
+    /* QDBusConnection doesn't expose path_namespace, but an empty path adds
+     * a single match rule covering every object of the service — the same
+     * set, since udisksd only exports under /org/freedesktop/UDisks2. */
+    udisksBus().connect(QStringLiteral(UD2_DBUS_SERVICE),
+                        QString(),
+                        QStringLiteral(DBUS_INTERFACE_PROPS),
+                        QStringLiteral("PropertiesChanged"),
+                        this,
+                        SLOT(slotPropertiesChanged(QString, QVariantMap, QStringList, QDBusMessage)));
+
+    /* Service the subscription on a dedicated thread: filtering and
+     * demarshalling stay off the GUI loop, and bursts coalesce there. */
+    m_thread = new QThread;
+    m_thread->setObjectName(QStringLiteral("solid-udisks2-dispatcher"));
+    m_thread->start();
+    moveToThread(m_thread);
+}
+
+SignalDispatcher::~SignalDispatcher()
+{
+    m_thread->quit();
+    m_thread->wait();
+    delete m_thread;
+}
+
+void SignalDispatcher::slotPropertiesChanged(const QString &interfaceName,
+                                             const QVariantMap &changedProperties,
+                                             const QStringList &invalidatedProperties,
+                                             const QDBusMessage &msg)
+{
+    /* Runs on m_thread. The queued self-invocation fires only after every
+     * delivery already sitting in this thread's event queue, so an entire
+     * burst collapses into one flush. */
+    if (m_batch.isEmpty()) {
+        QMetaObject::invokeMethod(this, &SignalDispatcher::flushBatch, Qt::QueuedConnection);
+    }
+
+    m_batch.append(ChangeSet{msg.path(), interfaceName, changedProperties, invalidatedProperties});
+}
+
+void SignalDispatcher::flushBatch()
+{
+    if (m_batch.isEmpty()) {
+        return;
+    }
+
+    Q_EMIT propertiesChangedBatch(std::exchange(m_batch, {}));
+}
+
+#include "moc_udiskssignaldispatcher.cpp"
@@ -0,0 +1,69 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef UDISKSSIGNALDISPATCHER_H
+#define UDISKSSIGNALDISPATCHER_H
+
+#include <QDBusMessage>
+#include <QList>
+#include <QObject>
+#include <QVariantMap>
+
+class QThread;
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDisks2
+{
+/* Single bus-side subscription for UDisks2 PropertiesChanged signals.
+ *
+ * Every DeviceBackend and each optical-capable device used to install its
+ * own per-path match rule, and dbus-daemon evaluates every rule against
+ * every signal broadcast on the bus. This dispatcher installs one match
+ * covering the whole service and fans the signals out in-process; consumers
+ * filter on the object path carried in each ChangeSet.
+ *
+ * The dispatcher lives on its own thread, so match filtering and argument
+ * demarshalling happen off the GUI loop, and a burst of PropertiesChanged
+ * (e.g. during an mkfs) is coalesced there and handed over to consumers as
+ * one queued batch instead of one event per signal.
+ */
+class SignalDispatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct ChangeSet {
+        QString path;
+        QString interfaceName;
+        QVariantMap changedProperties;
+        QStringList invalidatedProperties;
+    };
+
+    SignalDispatcher();
+    ~SignalDispatcher() override;
+
+    static SignalDispatcher *instance();
+
+Q_SIGNALS:
+    void propertiesChangedBatch(const QList<Solid::Backends::UDisks2::SignalDispatcher::ChangeSet> &changes);
+
+private Q_SLOTS:
+    void slotPropertiesChanged(const QString &interfaceName, const QVariantMap &changedProperties, const QStringList &invalidatedProperties, const QDBusMessage &msg);
+    void flushBatch();
+
+private:
+    QThread *m_thread;
+    QList<ChangeSet> m_batch; // only touched from m_thread
+};
+
+}
+}
+}
+
+#endif // UDISKSSIGNALDISPATCHER_H
@@ -0,0 +1,318 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "udiskssnapshotmatch.h"
+
+#include "udisks2.h"
+#include "udisksdevicebackend.h"
+
+#include <solid/storagevolume.h>
+
+#include <QDBusArgument>
+#include <QDBusObjectPath>
+#include <QDir>
+#include <QFile>
+#include <QMetaEnum>
+
+#include <optional>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDisks2
+{
+static bool hasIface(DeviceBackend *backend, const char *name)
+{
+    return backend->interfaces().contains(QLatin1String(name));
+}
+
+static DeviceBackend *driveOf(DeviceBackend *backend)
+{
+    const QString drive = backend->prop(QStringLiteral("Drive")).value<QDBusObjectPath>().path();
+    if (drive.isEmpty() || drive == QLatin1String("/")) {
+        return nullptr;
+    }
+    return DeviceBackend::backendForUDI(drive);
+}
+
+static bool isOpticalDisc(DeviceBackend *backend)
+{
+    DeviceBackend *drive = driveOf(backend);
+    return drive && drive->propBool(QStringLiteral("Optical"));
+}
+
+static bool isStorageAccess(DeviceBackend *backend)
+{
+    return hasIface(backend, UD2_DBUS_INTERFACE_FILESYSTEM) || hasIface(backend, UD2_DBUS_INTERFACE_ENCRYPTED);
+}
+
+bool snapshotHasInterface(DeviceBackend *backend, Solid::DeviceInterface::Type type)
+{
+    switch (type) {
+    case Solid::DeviceInterface::GenericInterface:
+        return true;
+    case Solid::DeviceInterface::Block:
+        return hasIface(backend, UD2_DBUS_INTERFACE_BLOCK) || hasIface(backend, UD2_DBUS_INTERFACE_DRIVE);
+    case Solid::DeviceInterface::StorageVolume:
+        return hasIface(backend, UD2_DBUS_INTERFACE_PARTITION) //
+            || hasIface(backend, UD2_DBUS_INTERFACE_PARTITIONTABLE) //
+            || isStorageAccess(backend) //
+            || isOpticalDisc(backend);
+    case Solid::DeviceInterface::StorageAccess:
+        return isStorageAccess(backend);
+    case Solid::DeviceInterface::StorageDrive:
+        return hasIface(backend, UD2_DBUS_INTERFACE_DRIVE);
+    case Solid::DeviceInterface::OpticalDrive:
+        return hasIface(backend, UD2_DBUS_INTERFACE_DRIVE) //
+            && !backend->prop(QStringLiteral("MediaCompatibility")).toStringList().filter(QStringLiteral("optical_")).isEmpty();
+    case Solid::DeviceInterface::OpticalDisc:
+        return isOpticalDisc(backend);
+    default:
+        return false;
+    }
+}
+
+/* The replicas below mirror the wrapper computations in
+ * udisksstoragevolume.cpp / udisksstorageaccess.cpp / udisksblock.cpp;
+ * keep them in sync. */
+
+static Solid::StorageVolume::UsageType volumeUsage(DeviceBackend *backend)
+{
+    const QString usage = backend->propString(QStringLiteral("IdUsage"));
+
+    if (hasIface(backend, UD2_DBUS_INTERFACE_FILESYSTEM)) {
+        return Solid::StorageVolume::FileSystem;
+    } else if (hasIface(backend, UD2_DBUS_INTERFACE_PARTITIONTABLE)) {
+        return Solid::StorageVolume::PartitionTable;
+    } else if (usage == QLatin1String("raid")) {
+        return Solid::StorageVolume::Raid;
+    } else if (hasIface(backend, UD2_DBUS_INTERFACE_ENCRYPTED)) {
+        return Solid::StorageVolume::Encrypted;
+    } else if (usage == QLatin1String("unused") || usage.isEmpty()) {
+        return Solid::StorageVolume::Unused;
+    } else {
+        return Solid::StorageVolume::Other;
+    }
+}
+
+static bool volumeIgnored(DeviceBackend *backend)
+{
+    if (backend->propBool(QStringLiteral("HintIgnore"))) {
+        return true;
+    }
+
+    if (backend->prop(QStringLiteral("UserspaceMountOptions")).toStringList().contains(QLatin1String("x-gdu.hide"))) {
+        return true;
+    }
+
+    const Solid::StorageVolume::UsageType usg = volumeUsage(backend);
+
+    /* clang-format off */
+    if (hasIface(backend, UD2_DBUS_INTERFACE_SWAP)
+        || ((usg == Solid::StorageVolume::Unused
+                || usg == Solid::StorageVolume::Other
+                || usg == Solid::StorageVolume::PartitionTable)
+            && !isOpticalDisc(backend))) { /* clang-format on */
+        return true;
+    }
+
+    const QString backingFile = backend->propString(QStringLiteral("BackingFile"));
+    return !backingFile.isEmpty() && !backingFile.startsWith(QDir::homePath());
+}
+
+static bool isMounted(DeviceBackend *backend)
+{
+    const QVariant mountPoints = backend->prop(QStringLiteral("MountPoints"));
+    return mountPoints.isValid() && !qdbus_cast<QByteArrayList>(mountPoints).isEmpty();
+}
+
+static QString mountPath(DeviceBackend *backend)
+{
+    const auto mntPoints = qdbus_cast<QByteArrayList>(backend->prop(QStringLiteral("MountPoints")));
+    if (mntPoints.isEmpty()) {
+        return QString();
+    }
+
+    QByteArray first = mntPoints.first();
+    if (first.endsWith('\x00')) {
+        first.chop(1);
+    }
+    return QFile::decodeName(first);
+}
+
+/* The wrapper property value for the terms whose semantics are
+ * reproducible from the raw properties alone; nullopt for everything
+ * else. The interface-presence gate has already been checked. */
+static std::optional<QVariant> snapshotProperty(DeviceBackend *backend, Solid::DeviceInterface::Type type, const QString &property)
+{
+    switch (type) {
+    case Solid::DeviceInterface::StorageVolume:
+        if (property == QLatin1String("size")) {
+            return QVariant(backend->propULongLong(QStringLiteral("Size")));
+        }
+        if (property == QLatin1String("uuid")) {
+            return QVariant(backend->propString(QStringLiteral("IdUUID")));
+        }
+        if (property == QLatin1String("fsType")) {
+            return QVariant(backend->propString(QStringLiteral("IdType")));
+        }
+        if (property == QLatin1String("label")) {
+            QString label = backend->propString(QStringLiteral("HintName"));
+            if (label.isEmpty()) {
+                label = backend->propString(QStringLiteral("IdLabel"));
+            }
+            if (label.isEmpty()) {
+                label = backend->propString(QStringLiteral("Name"));
+            }
+            return QVariant(label);
+        }
+        if (property == QLatin1String("ignored")) {
+            return QVariant(volumeIgnored(backend));
+        }
+        break;
+    case Solid::DeviceInterface::StorageAccess:
+        /* the mount state of an encrypted container lives on its cleartext
+         * slave, which a per-device snapshot cannot reach */
+        if (hasIface(backend, UD2_DBUS_INTERFACE_ENCRYPTED)) {
+            return std::nullopt;
+        }
+        if (property == QLatin1String("accessible")) {
+            return QVariant(isMounted(backend));
+        }
+        if (property == QLatin1String("filePath")) {
+            return QVariant(mountPath(backend));
+        }
+        break;
+    case Solid::DeviceInterface::Block:
+        /* drives resolve their device node through an introspection
+         * search, so only answer for real block objects */
+        if (property == QLatin1String("device") && hasIface(backend, UD2_DBUS_INTERFACE_BLOCK)) {
+            const QByteArray node = backend->prop(QStringLiteral("Device")).toByteArray();
+            if (!node.isEmpty()) {
+                return QVariant(QFile::decodeName(node));
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    return std::nullopt;
+}
+
+static SnapshotVerdict evaluatePropertyCheck(const Solid::Predicate &term, DeviceBackend *backend)
+{
+    const Solid::DeviceInterface::Type type = term.interfaceType();
+
+    if (!snapshotHasInterface(backend, type)) {
+        // matches() fails property checks on absent interfaces
+        return SnapshotVerdict::No;
+    }
+
+    const QString property = term.propertyName();
+    const QVariant wanted = term.matchingValue();
+
+    /* usage carries an enum; convert the expected value the same way the
+     * frontend does against the wrapper's meta-enum (equality only;
+     * ordered comparisons on it fall through to Unknown below) */
+    if (type == Solid::DeviceInterface::StorageVolume && property == QLatin1String("usage") && term.comparisonOperator() == Solid::Predicate::Equals) {
+        int expected = -1;
+        if (wanted.userType() == QMetaType::QString) {
+            expected = QMetaEnum::fromType<Solid::StorageVolume::UsageType>().keysToValue(wanted.toString().toLatin1().constData());
+            if (expected < 0) {
+                return SnapshotVerdict::No;
+            }
+        } else {
+            bool ok = false;
+            expected = wanted.toInt(&ok);
+            if (!ok) {
+                return SnapshotVerdict::No;
+            }
+        }
+        return volumeUsage(backend) == expected ? SnapshotVerdict::Yes : SnapshotVerdict::No;
+    }
+
+    const std::optional<QVariant> actual = snapshotProperty(backend, type, property);
+    if (!actual) {
+        return SnapshotVerdict::Unknown;
+    }
+
+    if (term.comparisonOperator() == Solid::Predicate::Mask) {
+        bool vOk = false;
+        bool eOk = false;
+        const int v = actual->toInt(&vOk);
+        const int e = wanted.toInt(&eOk);
+        return (vOk && eOk && (v & e)) ? SnapshotVerdict::Yes : SnapshotVerdict::No;
+    }
+
+    switch (term.comparisonOperator()) {
+    case Solid::Predicate::Equals:
+        return *actual == wanted ? SnapshotVerdict::Yes : SnapshotVerdict::No;
+    case Solid::Predicate::GreaterThan: {
+        const QPartialOrdering order = QVariant::compare(*actual, wanted);
+        return order == QPartialOrdering::Greater ? SnapshotVerdict::Yes : SnapshotVerdict::No;
+    }
+    case Solid::Predicate::GreaterThanOrEqual: {
+        const QPartialOrdering order = QVariant::compare(*actual, wanted);
+        return (order == QPartialOrdering::Greater || order == QPartialOrdering::Equivalent) ? SnapshotVerdict::Yes : SnapshotVerdict::No;
+    }
+    case Solid::Predicate::LessThan: {
+        const QPartialOrdering order = QVariant::compare(*actual, wanted);
+        return order == QPartialOrdering::Less ? SnapshotVerdict::Yes : SnapshotVerdict::No;
+    }
+    case Solid::Predicate::LessThanOrEqual: {
+        const QPartialOrdering order = QVariant::compare(*actual, wanted);
+        return (order == QPartialOrdering::Less || order == QPartialOrdering::Equivalent) ? SnapshotVerdict::Yes : SnapshotVerdict::No;
+    }
+    case Solid::Predicate::Mask:
+        break; // handled above
+    }
+
+    return SnapshotVerdict::Unknown;
+}
+
+SnapshotVerdict matchFromSnapshot(const Solid::Predicate &predicate, DeviceBackend *backend)
+{
+    if (!predicate.isValid()) {
+        return SnapshotVerdict::No;
+    }
+
+    switch (predicate.type()) {
+    case Solid::Predicate::Conjunction: {
+        const SnapshotVerdict first = matchFromSnapshot(predicate.firstOperand(), backend);
+        if (first == SnapshotVerdict::No) {
+            return SnapshotVerdict::No;
+        }
+        const SnapshotVerdict second = matchFromSnapshot(predicate.secondOperand(), backend);
+        if (second == SnapshotVerdict::No) {
+            return SnapshotVerdict::No;
+        }
+        return (first == SnapshotVerdict::Yes && second == SnapshotVerdict::Yes) ? SnapshotVerdict::Yes : SnapshotVerdict::Unknown;
+    }
+    case Solid::Predicate::Disjunction: {
+        const SnapshotVerdict first = matchFromSnapshot(predicate.firstOperand(), backend);
+        if (first == SnapshotVerdict::Yes) {
+            return SnapshotVerdict::Yes;
+        }
+        const SnapshotVerdict second = matchFromSnapshot(predicate.secondOperand(), backend);
+        if (second == SnapshotVerdict::Yes) {
+            return SnapshotVerdict::Yes;
+        }
+        return (first == SnapshotVerdict::No && second == SnapshotVerdict::No) ? SnapshotVerdict::No : SnapshotVerdict::Unknown;
+    }
+    case Solid::Predicate::InterfaceCheck:
+        return snapshotHasInterface(backend, predicate.interfaceType()) ? SnapshotVerdict::Yes : SnapshotVerdict::No;
+    case Solid::Predicate::PropertyCheck:
+        return evaluatePropertyCheck(predicate, backend);
+    }
+
+    return SnapshotVerdict::Unknown;
+}
+
+}
+}
+}
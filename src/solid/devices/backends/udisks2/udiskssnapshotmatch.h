@@ -0,0 +1,57 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef UDISKSSNAPSHOTMATCH_H
+#define UDISKSSNAPSHOTMATCH_H
+
+#include <solid/deviceinterface.h>
+#include <solid/predicate.h>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UDisks2
+{
+class DeviceBackend;
+
+/**
+ * Outcome of evaluating a predicate term against the cached property maps.
+ * Unknown means the snapshot cannot answer the term authoritatively; the
+ * caller must keep the device as a candidate and let the frontend decide.
+ */
+enum class SnapshotVerdict {
+    No,
+    Yes,
+    Unknown,
+};
+
+/**
+ * Whether the device behind @p backend provides @p type, answered purely
+ * from the cached interface lists and properties. This mirrors
+ * Device::queryDeviceInterface() without constructing any device object;
+ * keep the two in sync.
+ */
+bool snapshotHasInterface(DeviceBackend *backend, Solid::DeviceInterface::Type type);
+
+/**
+ * Evaluates @p predicate against the property maps cached in @p backend.
+ *
+ * Interface checks are answered exactly; property checks are answered for
+ * the comparisons whose wrapper semantics are reproducible from the raw
+ * UDisks2 properties (the common StorageVolume, StorageAccess and Block
+ * terms) and come back Unknown otherwise. The combination rules are
+ * three-valued, so a No verdict is only returned when it is certain no
+ * matter how the Unknown terms would have resolved — the one case where
+ * filtering a device out without constructing it is safe.
+ */
+SnapshotVerdict matchFromSnapshot(const Solid::Predicate &predicate, DeviceBackend *backend);
+
+}
+}
+}
+
+#endif // UDISKSSNAPSHOTMATCH_H
@@ -6,43 +6,22 @@
 */
 
 #include "udisksstorageaccess.h"
+#include "../shared/mounttable.h"
+#include "dbus/interfaces.h"
 #include "udisks2.h"
 #include "udisks_debug.h"
+#include "udisksmountqueue.h"
+#include "udisksconnection.h"
+#include "udisksjobtracker.h"
 
 #include <QDBusConnection>
 #include <QDBusInterface>
 #include <QDBusMetaType>
 #include <QDir>
+#include <QFile>
 #include <QGuiApplication>
 #include <QWindow>
 
-#include <config-solid.h>
-#if HAVE_LIBMOUNT
-#include <libmount/libmount.h>
-#endif
-
-struct AvailableAnswer {
-    bool checkResult;
-    QString binaryName;
-};
-Q_DECLARE_METATYPE(AvailableAnswer)
-
-QDBusArgument &operator<<(QDBusArgument &argument, const AvailableAnswer &answer)
-{
-    argument.beginStructure();
-    argument << answer.checkResult << answer.binaryName;
-    argument.endStructure();
-    return argument;
-}
-
-const QDBusArgument &operator>>(const QDBusArgument &argument, AvailableAnswer &answer)
-{
-    argument.beginStructure();
-    argument >> answer.checkResult >> answer.binaryName;
-    argument.endStructure();
-    return argument;
-}
-
 using namespace Solid::Backends::UDisks2;
 
 StorageAccess::StorageAccess(Device *device)
@@ -54,7 +33,7 @@ StorageAccess::StorageAccess(Device *device)
 {
     qDBusRegisterMetaType<AvailableAnswer>();
 
-    connect(device, SIGNAL(changed()), this, SLOT(checkAccessibility()));
+    connect(device, SIGNAL(changed()), this, SLOT(slotChanged()));
     updateCache();
 
     // Delay connecting to DBus signals to avoid the related time penalty
@@ -73,6 +52,15 @@ void StorageAccess::connectDBusSignals()
     m_device->registerAction(QStringLiteral("teardown"), this, SLOT(slotTeardownRequested()), SLOT(slotTeardownDone(int, QString)));
 
     m_device->registerAction(QStringLiteral("repair"), this, SLOT(slotRepairRequested()), SLOT(slotRepairDone(int, QString)));
+
+    /* Forward progress of UDisks2 jobs operating on this volume (or on its
+     * cleartext counterpart), so clients get event-driven progress instead
+     * of polling properties on a timer. */
+    connect(JobTracker::instance(), &JobTracker::jobProgress, this, [this](const QString &udi, const QString &operation, double progress) {
+        if (udi == m_device->udi() || udi == clearTextPath()) {
+            Q_EMIT operationProgressChanged(operation, progress, m_device->udi());
+        }
+    });
 }
 
 bool StorageAccess::isLuksDevice() const
@@ -105,13 +93,8 @@ bool StorageAccess::isEncrypted() const
 bool StorageAccess::canCheck() const
 {
     const auto idType = m_device->prop(QStringLiteral("IdType")).toString();
-    auto c = QDBusConnection::systemBus();
-    auto msg = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE),
-                                              QStringLiteral(UD2_DBUS_PATH_MANAGER),
-                                              QStringLiteral("org.freedesktop.UDisks2.Manager"),
-                                              QStringLiteral("CanCheck"));
-    msg << idType;
-    QDBusReply<AvailableAnswer> r = c.call(msg);
+    org::freedesktop::UDisks2::Manager manager(QStringLiteral(UD2_DBUS_SERVICE), QStringLiteral(UD2_DBUS_PATH_MANAGER), udisksBus());
+    QDBusReply<AvailableAnswer> r = manager.CanCheck(idType);
     if (!r.isValid()) {
         qCDebug(UDISKS2) << Q_FUNC_INFO << dbusPath() << idType << "DBus error, code" << r.error().type();
         return false;
@@ -129,11 +112,8 @@ bool StorageAccess::check()
     }
 
     const auto path = dbusPath();
-    auto c = QDBusConnection::systemBus();
-    auto msg = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE), path, QStringLiteral(UD2_DBUS_INTERFACE_FILESYSTEM), QStringLiteral("Check"));
-    QVariantMap options;
-    msg << options;
-    QDBusReply<bool> r = c.call(msg);
+    org::freedesktop::UDisks2::Filesystem filesystem(QStringLiteral(UD2_DBUS_SERVICE), path, udisksBus());
+    QDBusReply<bool> r = filesystem.Check(QVariantMap());
     bool ret = r.isValid() && r.value();
     qCDebug(UDISKS2) << Q_FUNC_INFO << path << ret;
     return ret;
@@ -142,13 +122,8 @@ bool StorageAccess::check()
 bool StorageAccess::canRepair() const
 {
     const auto idType = m_device->prop(QStringLiteral("IdType")).toString();
-    auto c = QDBusConnection::systemBus();
-    auto msg = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE),
-                                              QStringLiteral(UD2_DBUS_PATH_MANAGER),
-                                              QStringLiteral("org.freedesktop.UDisks2.Manager"),
-                                              QStringLiteral("CanRepair"));
-    msg << idType;
-    QDBusReply<AvailableAnswer> r = c.call(msg);
+    org::freedesktop::UDisks2::Manager manager(QStringLiteral(UD2_DBUS_SERVICE), QStringLiteral(UD2_DBUS_PATH_MANAGER), udisksBus());
+    QDBusReply<AvailableAnswer> r = manager.CanRepair(idType);
     if (!r.isValid()) {
         qCDebug(UDISKS2) << Q_FUNC_INFO << dbusPath() << idType << "DBus error, code" << r.error().type();
         return false;
@@ -168,7 +143,7 @@ bool StorageAccess::repair()
     m_device->broadcastActionRequested(QStringLiteral("repair"));
 
     const auto path = dbusPath();
-    auto c = QDBusConnection::systemBus();
+    auto c = udisksBus();
     auto msg = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE), path, QStringLiteral(UD2_DBUS_INTERFACE_FILESYSTEM), QStringLiteral("Repair"));
     QVariantMap options;
     msg << options;
@@ -179,39 +154,22 @@ bool StorageAccess::repair()
 
 static QString baseMountPoint(const QByteArray &dev)
 {
-    QString mountPoint;
-
-#if HAVE_LIBMOUNT
     // UDisks "MountPoints" property contains multiple paths, this happens with
     // devices with bind mounts; try finding the "base" mount point
-    if (struct libmnt_table *table = mnt_new_table()) {
-        // This parses "/etc/mtab" if present or "/proc/self/mountinfo" by default
-        if (mnt_table_parse_mtab(table, "/proc/self/mountinfo") == 0) {
-            // BACKWARD because the fs's we're interested in, /dev/sdXY, are typically at the end
-            struct libmnt_iter *itr = mnt_new_iter(MNT_ITER_BACKWARD);
-            struct libmnt_fs *fs;
-
-            const QByteArray devicePath = dev.endsWith('\x00') ? dev.chopped(1) : dev;
-
-            while (mnt_table_next_fs(table, itr, &fs) == 0) {
-                if (mnt_fs_get_srcpath(fs) == devicePath //
-                    && (qstrcmp(mnt_fs_get_root(fs), "/") == 0) // Base mount point will have "/" as root fs
-                ) {
-                    mountPoint = QFile::decodeName(mnt_fs_get_target(fs));
-                    break;
-                }
-            }
-
-            mnt_free_iter(itr);
+    const QByteArray devicePath = dev.endsWith('\x00') ? dev.chopped(1) : dev;
+    const QString deviceName = QFile::decodeName(devicePath);
+
+    const auto table = Solid::Backends::Shared::MountTable::current();
+    // backwards because the fs's we're interested in, /dev/sdXY, are typically at the end
+    for (auto it = table->crbegin(); it != table->crend(); ++it) {
+        if (it->source == deviceName //
+            && it->root == "/" // Base mount point will have "/" as root fs
+        ) {
+            return it->target;
         }
-
-        mnt_free_table(table);
     }
-#else
-    Q_UNUSED(dev);
-#endif
 
-    return mountPoint;
+    return QString();
 }
 
 QString StorageAccess::filePath() const
@@ -305,6 +263,18 @@ void StorageAccess::updateCache()
     m_isAccessible = isAccessible();
 }
 
+void StorageAccess::slotChanged()
+{
+    /* an unlock or lock surfaces here as a property/interface change on the
+     * container; re-resolve the crypto chain before judging accessibility */
+    m_clearTextPathValid = false;
+    m_cryptoBackingPathValid = false;
+    /* the change may have been a mount or unmount; the shared mount table
+     * snapshot used for bind-mount resolution is stale then */
+    Solid::Backends::Shared::MountTable::invalidate();
+    checkAccessibility();
+}
+
 void StorageAccess::checkAccessibility()
 {
     const bool old_isAccessible = m_isAccessible;
@@ -339,26 +309,16 @@ void StorageAccess::slotDBusReply(const QDBusMessage & /*reply*/)
             QString drivePath = m_device->drivePath();
             if (!drivePath.isEmpty() || drivePath != QStringLiteral("/")) {
                 Device drive(drivePath);
-                QDBusConnection c = QDBusConnection::systemBus();
+                org::freedesktop::UDisks2::Drive driveIface(QStringLiteral(UD2_DBUS_SERVICE), drivePath, udisksBus());
 
                 if (drive.prop(QStringLiteral("MediaRemovable")).toBool() //
                     && drive.prop(QStringLiteral("MediaAvailable")).toBool() //
                     && !m_device->isOpticalDisc()) { // optical drives have their Eject method
-                    QDBusMessage msg = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE),
-                                                                      drivePath,
-                                                                      QStringLiteral(UD2_DBUS_INTERFACE_DRIVE),
-                                                                      QStringLiteral("Eject"));
-                    msg << QVariantMap(); // options, unused now
-                    c.call(msg, QDBus::NoBlock);
+                    driveIface.Eject(QVariantMap()); // options unused now; fire and forget
                 } else if (drive.prop(QStringLiteral("CanPowerOff")).toBool() //
                            && !m_device->isOpticalDisc()) { // avoid disconnecting optical drives from the bus
                     qCDebug(UDISKS2) << "Drive can power off:" << drivePath;
-                    QDBusMessage msg = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE),
-                                                                      drivePath,
-                                                                      QStringLiteral(UD2_DBUS_INTERFACE_DRIVE),
-                                                                      QStringLiteral("PowerOff"));
-                    msg << QVariantMap(); // options, unused now
-                    c.call(msg, QDBus::NoBlock);
+                    driveIface.PowerOff(QVariantMap()); // options unused now; fire and forget
                 }
             }
 
@@ -444,7 +404,6 @@ bool StorageAccess::mount()
 {
     const auto path = dbusPath();
 
-    QDBusConnection c = QDBusConnection::systemBus();
     QDBusMessage msg =
         QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE), path, QStringLiteral(UD2_DBUS_INTERFACE_FILESYSTEM), QStringLiteral("Mount"));
     QVariantMap options;
@@ -455,21 +414,20 @@ bool StorageAccess::mount()
 
     msg << options;
 
-    return c.callWithCallback(msg, this, SLOT(slotDBusReply(QDBusMessage)), SLOT(slotDBusError(QDBusError)));
+    return MountQueue::instance()->enqueue(this, msg, dependencyKey());
 }
 
 bool StorageAccess::unmount()
 {
     const auto path = dbusPath();
 
-    QDBusConnection c = QDBusConnection::systemBus();
     QDBusMessage msg =
         QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE), path, QStringLiteral(UD2_DBUS_INTERFACE_FILESYSTEM), QStringLiteral("Unmount"));
 
     msg << QVariantMap(); // options, unused now
 
     qCDebug(UDISKS2) << "Initiating unmount of " << path;
-    return c.callWithCallback(msg, this, SLOT(slotDBusReply(QDBusMessage)), SLOT(slotDBusError(QDBusError)), s_unmountTimeout);
+    return MountQueue::instance()->enqueue(this, msg, dependencyKey(), s_unmountTimeout);
 }
 
 QString StorageAccess::generateReturnObjectPath()
@@ -481,11 +439,40 @@ QString StorageAccess::generateReturnObjectPath()
 
 QString StorageAccess::clearTextPath() const
 {
-    const QString path = m_device->prop(QStringLiteral("CleartextDevice")).value<QDBusObjectPath>().path();
-    if (path != QLatin1String("/")) {
-        return path;
+    if (!m_clearTextPathValid) {
+        const QString path = m_device->prop(QStringLiteral("CleartextDevice")).value<QDBusObjectPath>().path();
+        m_clearTextPath = (path == QLatin1String("/")) ? QString() : path;
+        m_clearTextPathValid = true;
     }
-    return QString();
+    return m_clearTextPath;
+}
+
+QString StorageAccess::cryptoBackingPath() const
+{
+    if (!m_cryptoBackingPathValid) {
+        const QString path = m_device->prop(QStringLiteral("CryptoBackingDevice")).value<QDBusObjectPath>().path();
+        m_cryptoBackingPath = (path == QLatin1String("/")) ? QString() : path;
+        m_cryptoBackingPathValid = true;
+    }
+    return m_cryptoBackingPath;
+}
+
+QString StorageAccess::dependencyKey() const
+{
+    /* An unlock/lock on a LUKS container and a mount/unmount of its
+     * cleartext volume must not be in flight at the same time; key both
+     * ends of the chain by the container's path. Everything else only
+     * depends on itself. */
+    if (isLuksDevice()) {
+        return m_device->udi();
+    }
+
+    const QString backing = cryptoBackingPath();
+    if (!backing.isEmpty()) {
+        return backing;
+    }
+
+    return m_device->udi();
 }
 
 QString StorageAccess::dbusPath() const
@@ -549,7 +536,6 @@ void StorageAccess::passphraseReply(const QString &passphrase)
 
 void StorageAccess::callCryptoSetup(const QString &passphrase)
 {
-    QDBusConnection c = QDBusConnection::systemBus();
     QDBusMessage msg = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE),
                                                       m_device->udi(),
                                                       QStringLiteral(UD2_DBUS_INTERFACE_ENCRYPTED),
@@ -558,20 +544,18 @@ void StorageAccess::callCryptoSetup(const QString &passphrase)
     msg << passphrase;
     msg << QVariantMap(); // options, unused now
 
-    c.callWithCallback(msg, this, SLOT(slotDBusReply(QDBusMessage)), SLOT(slotDBusError(QDBusError)));
+    MountQueue::instance()->enqueue(this, msg, dependencyKey());
 }
 
 bool StorageAccess::callCryptoTeardown(bool actOnParent)
 {
-    QDBusConnection c = QDBusConnection::systemBus();
-    QDBusMessage msg =
-        QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE),
-                                       actOnParent ? (m_device->prop(QStringLiteral("CryptoBackingDevice")).value<QDBusObjectPath>().path()) : m_device->udi(),
-                                       QStringLiteral(UD2_DBUS_INTERFACE_ENCRYPTED),
-                                       QStringLiteral("Lock"));
+    QDBusMessage msg = QDBusMessage::createMethodCall(QStringLiteral(UD2_DBUS_SERVICE),
+                                                      actOnParent ? cryptoBackingPath() : m_device->udi(),
+                                                      QStringLiteral(UD2_DBUS_INTERFACE_ENCRYPTED),
+                                                      QStringLiteral("Lock"));
     msg << QVariantMap(); // options, unused now
 
-    return c.callWithCallback(msg, this, SLOT(slotDBusReply(QDBusMessage)), SLOT(slotDBusError(QDBusError)));
+    return MountQueue::instance()->enqueue(this, msg, dependencyKey());
 }
 
 #include "moc_udisksstorageaccess.cpp"
@@ -20,11 +20,16 @@ namespace Backends
 {
 namespace UDisks2
 {
+class MountQueue;
+
 class StorageAccess : public DeviceInterface, virtual public Solid::Ifaces::StorageAccess
 {
     Q_OBJECT
     Q_INTERFACES(Solid::Ifaces::StorageAccess)
 
+    // routes queued replies back into slotDBusReply()/slotDBusError()
+    friend class MountQueue;
+
 public:
     StorageAccess(Device *device);
     ~StorageAccess() override;
@@ -49,6 +54,7 @@ Q_SIGNALS:
     void teardownRequested(const QString &udi) override;
     void repairRequested(const QString &udi) override;
     void repairDone(Solid::ErrorType error, QVariant errorData, const QString &udi) override;
+    void operationProgressChanged(const QString &operation, double progress, const QString &udi) override;
 
 public Q_SLOTS:
     Q_SCRIPTABLE Q_NOREPLY void passphraseReply(const QString &passphrase);
@@ -67,6 +73,7 @@ private Q_SLOTS:
     void slotRepairDone(int error, const QString &errorString);
 
     void checkAccessibility();
+    void slotChanged();
 
 private:
     /// @return true if this device is luks and unlocked
@@ -83,9 +90,13 @@ private:
 
     QString generateReturnObjectPath();
     QString clearTextPath() const;
+    QString cryptoBackingPath() const;
 
     QString dbusPath() const;
 
+    /// serializes queued operations on the same crypto chain
+    QString dependencyKey() const;
+
 private:
     bool m_isAccessible;
     bool m_setupInProgress;
@@ -94,6 +105,17 @@ private:
     bool m_passphraseRequested;
     QString m_lastReturnObject;
 
+    /* Memoized crypto chain endpoints ("/" normalized to empty). Every
+     * unlock, mount and accessibility check walks container→cleartext or
+     * cleartext→backing; resolving the object paths once per device
+     * generation beats re-converting them out of the property cache each
+     * time. slotChanged() drops both when the device announces a change,
+     * which covers the InterfacesAdded/Removed of an unlock or lock. */
+    mutable QString m_clearTextPath;
+    mutable QString m_cryptoBackingPath;
+    mutable bool m_clearTextPathValid = false;
+    mutable bool m_cryptoBackingPathValid = false;
+
     static const int s_unmountTimeout = 0x7fffffff;
 };
 }
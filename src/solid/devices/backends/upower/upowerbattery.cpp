@@ -10,14 +10,20 @@
 
 #include "upower.h"
 
+#include <QDateTime>
+
 using namespace Solid::Backends::UPower;
 
+/* enough for a day of samples at typical one-per-two-minutes change rates */
+static const int c_historyCapacity = 720;
+
 Battery::Battery(UPowerDevice *device)
     : DeviceInterface(device)
 {
-    connect(device, &UPowerDevice::propertyChanged, this, &Battery::slotChanged);
+    connect(device, &UPowerDevice::propertyEventsChanged, this, &Battery::slotChanged);
 
     updateCache();
+    recordHistorySample();
 }
 
 Battery::~Battery()
@@ -26,13 +32,13 @@ Battery::~Battery()
 
 bool Battery::isPresent() const
 {
-    return m_device.data()->prop(QStringLiteral("IsPresent")).toBool();
+    return m_device.data()->batteryStats().isPresent;
 }
 
 Solid::Battery::BatteryType Battery::type() const
 {
     Solid::Battery::BatteryType result = Solid::Battery::UnknownBattery;
-    const auto t = static_cast<UpDeviceKind>(m_device.data()->prop(QStringLiteral("Type")).toUInt());
+    const auto t = static_cast<UpDeviceKind>(m_device.data()->batteryStats().kind);
     switch (t) {
     case UP_DEVICE_KIND_LINE_POWER: // TODO
         break;
@@ -92,28 +98,28 @@ Solid::Battery::BatteryType Battery::type() const
 
 int Battery::chargePercent() const
 {
-    return qRound(m_device.data()->prop(QStringLiteral("Percentage")).toDouble());
+    return qRound(m_device.data()->batteryStats().percentage);
 }
 
 int Battery::capacity() const
 {
-    return qRound(m_device.data()->prop(QStringLiteral("Capacity")).toDouble());
+    return qRound(m_device.data()->batteryStats().capacity);
 }
 
 bool Battery::isRechargeable() const
 {
-    return m_device.data()->prop(QStringLiteral("IsRechargeable")).toBool();
+    return m_device.data()->batteryStats().isRechargeable;
 }
 
 bool Battery::isPowerSupply() const
 {
-    return m_device.data()->prop(QStringLiteral("PowerSupply")).toBool();
+    return m_device.data()->batteryStats().powerSupply;
 }
 
 Solid::Battery::ChargeState Battery::chargeState() const
 {
     Solid::Battery::ChargeState result = Solid::Battery::NoCharge;
-    const UpDeviceState state = static_cast<UpDeviceState>(m_device.data()->prop(QStringLiteral("State")).toUInt());
+    const UpDeviceState state = static_cast<UpDeviceState>(m_device.data()->batteryStats().state);
     switch (state) {
     case UP_DEVICE_STATE_UNKNOWN:
         result = Solid::Battery::NoCharge; // stable or unknown
@@ -141,17 +147,17 @@ Solid::Battery::ChargeState Battery::chargeState() const
 
 qlonglong Battery::timeToEmpty() const
 {
-    return m_device.data()->prop(QStringLiteral("TimeToEmpty")).toLongLong();
+    return m_device.data()->batteryStats().timeToEmpty;
 }
 
 qlonglong Battery::timeToFull() const
 {
-    return m_device.data()->prop(QStringLiteral("TimeToFull")).toLongLong();
+    return m_device.data()->batteryStats().timeToFull;
 }
 
 Solid::Battery::Technology Battery::technology() const
 {
-    const UpDeviceTechnology tech = static_cast<UpDeviceTechnology>(m_device.data()->prop(QStringLiteral("Technology")).toUInt());
+    const UpDeviceTechnology tech = static_cast<UpDeviceTechnology>(m_device.data()->batteryStats().technology);
     switch (tech) {
     case UP_DEVICE_TECHNOLOGY_UNKNOWN:
         return Solid::Battery::UnknownTechnology;
@@ -175,32 +181,32 @@ Solid::Battery::Technology Battery::technology() const
 
 double Battery::energy() const
 {
-    return m_device.data()->prop(QStringLiteral("Energy")).toDouble();
+    return m_device.data()->batteryStats().energy;
 }
 
 double Battery::energyFull() const
 {
-    return m_device.data()->prop(QStringLiteral("EnergyFull")).toDouble();
+    return m_device.data()->batteryStats().energyFull;
 }
 
 double Battery::energyFullDesign() const
 {
-    return m_device.data()->prop(QStringLiteral("EnergyFullDesign")).toDouble();
+    return m_device.data()->batteryStats().energyFullDesign;
 }
 
 double Battery::energyRate() const
 {
-    return m_device.data()->prop(QStringLiteral("EnergyRate")).toDouble();
+    return m_device.data()->batteryStats().energyRate;
 }
 
 double Battery::voltage() const
 {
-    return m_device.data()->prop(QStringLiteral("Voltage")).toDouble();
+    return m_device.data()->batteryStats().voltage;
 }
 
 double Battery::temperature() const
 {
-    return m_device.data()->prop(QStringLiteral("Temperature")).toDouble();
+    return m_device.data()->batteryStats().temperature;
 }
 
 QString Battery::serial() const
@@ -219,8 +225,45 @@ qlonglong Battery::remainingTime() const
     return -1;
 }
 
+QList<Solid::Battery::ChargeSample> Battery::chargeHistory(qlonglong maxAgeSeconds) const
+{
+    if (maxAgeSeconds <= 0) {
+        return m_history;
+    }
+
+    const qint64 cutoff = QDateTime::currentMSecsSinceEpoch() - maxAgeSeconds * 1000;
+    qsizetype first = 0;
+    while (first < m_history.size() && m_history.at(first).timestamp < cutoff) {
+        ++first;
+    }
+    return m_history.mid(first);
+}
+
+void Battery::recordHistorySample()
+{
+    m_history.append({QDateTime::currentMSecsSinceEpoch(), m_chargePercent, m_energyRate});
+    if (m_history.size() > c_historyCapacity) {
+        m_history.removeFirst();
+    }
+}
+
 void Battery::slotChanged()
 {
+    /* A charge-cycle tick can deliver several PropertiesChanged messages
+     * back-to-back; coalesce them into one diff pass at the end of the
+     * event loop iteration, so each Solid signal fires at most once per
+     * batch instead of once per message. */
+    if (m_updatePending) {
+        return;
+    }
+    m_updatePending = true;
+    QMetaObject::invokeMethod(this, &Battery::emitBatchedChanges, Qt::QueuedConnection);
+}
+
+void Battery::emitBatchedChanges()
+{
+    m_updatePending = false;
+
     if (m_device) {
         const bool old_isPresent = m_isPresent;
         const int old_chargePercent = m_chargePercent;
@@ -237,6 +280,10 @@ void Battery::slotChanged()
         const double old_temperature = m_temperature;
         updateCache();
 
+        if (old_chargePercent != m_chargePercent || old_energyRate != m_energyRate) {
+            recordHistorySample();
+        }
+
         if (old_isPresent != m_isPresent) {
             Q_EMIT presentStateChanged(m_isPresent, m_device.data()->udi());
         }
@@ -274,7 +321,7 @@ void Battery::slotChanged()
         }
 
         if (old_energyFullDesign != m_energyFullDesign) {
-            Q_EMIT energyFullChanged(m_energyFullDesign, m_device.data()->udi());
+            Q_EMIT energyFullDesignChanged(m_energyFullDesign, m_device.data()->udi());
         }
 
         if (old_energyRate != m_energyRate) {
@@ -63,6 +63,8 @@ public:
 
     qlonglong remainingTime() const override;
 
+    QList<Solid::Battery::ChargeSample> chargeHistory(qlonglong maxAgeSeconds) const override;
+
 Q_SIGNALS:
     void presentStateChanged(bool newState, const QString &udi) override;
     void chargePercentChanged(int value, const QString &udi = QString()) override;
@@ -81,10 +83,16 @@ Q_SIGNALS:
 
 private Q_SLOTS:
     void slotChanged();
+    void emitBatchedChanges();
 
 private:
     void updateCache();
+    void recordHistorySample();
 
+    /* ring buffer of charge samples, oldest first, see chargeHistory() */
+    QList<Solid::Battery::ChargeSample> m_history;
+    /* a coalesced update is queued, see slotChanged() */
+    bool m_updatePending = false;
     bool m_isPresent;
     int m_chargePercent;
     int m_capacity;
@@ -8,14 +8,13 @@
 #include "upowerdevice.h"
 #include "upower.h"
 #include "upowerbattery.h"
+#include "upowerdevicebackend.h"
 #include "upowerdeviceinterface.h"
 #include "upowergenericinterface.h"
 
 #include <solid/device.h>
 #include <solid/genericinterface.h>
 
-#include <QDBusConnection>
-#include <QDBusReply>
 #include <QStringList>
 
 using namespace Solid::Backends::UPower;
@@ -23,22 +22,14 @@ using namespace Solid::Backends::UPower;
 UPowerDevice::UPowerDevice(const QString &udi)
     : Solid::Ifaces::Device()
     , m_udi(udi)
+    , m_backend(DeviceBackend::backendForUDI(udi))
 {
-    QDBusConnection::systemBus().connect(QStringLiteral(UP_DBUS_SERVICE),
-                                         m_udi,
-                                         QStringLiteral("org.freedesktop.DBus.Properties"),
-                                         QStringLiteral("PropertiesChanged"),
-                                         this,
-                                         SLOT(onPropertiesChanged(QString, QVariantMap, QStringList)));
-
-    // TODO port this to Solid::Power, we can't link against kdelibs4support for this signal
-    // older upower versions not affected
-    QDBusConnection::systemBus().connect(QStringLiteral("org.freedesktop.login1"), //
-                                         QStringLiteral("/org/freedesktop/login1"),
-                                         QStringLiteral("org.freedesktop.login1.Manager"),
-                                         QStringLiteral("PrepareForSleep"),
-                                         this,
-                                         SLOT(login1Resuming(bool)));
+    /* The backend holds the property cache and the D-Bus subscriptions for
+     * this UDI, shared by every wrapper of the same device; this instance
+     * only relays its change notifications. */
+    if (m_backend) {
+        connect(m_backend, &DeviceBackend::propertyEventsChanged, this, &UPowerDevice::propertyEventsChanged);
+    }
 }
 
 UPowerDevice::~UPowerDevice()
@@ -183,102 +174,36 @@ QString UPowerDevice::parentUdi() const
     return QStringLiteral(UP_UDI_PREFIX);
 }
 
-void UPowerDevice::checkCache(const QString &key) const
-{
-    if (m_cache.contains(key) || m_negativeCache.contains(key)) {
-        return;
-    }
-
-    loadCache();
-
-    if (m_cache.contains(key)) {
-        return;
-    }
-
-    QDBusMessage call =
-        QDBusMessage::createMethodCall(QStringLiteral(UP_DBUS_SERVICE), m_udi, QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("Get"));
-    call.setArguments({QStringLiteral(UP_DBUS_INTERFACE_DEVICE), key});
-    QDBusReply<QVariant> reply = QDBusConnection::systemBus().call(call);
-
-    if (reply.isValid()) {
-        m_cache[key] = reply.value();
-    } else {
-        m_negativeCache.append(key);
-    }
-}
-
 QVariant UPowerDevice::prop(const QString &key) const
 {
-    checkCache(key);
-    return m_cache.value(key);
+    if (m_backend) {
+        return m_backend->prop(key);
+    }
+    return QVariant();
 }
 
 bool UPowerDevice::propertyExists(const QString &key) const
 {
-    checkCache(key);
-    return m_cache.contains(key);
-}
-
-void UPowerDevice::loadCache() const
-{
-    QDBusMessage call =
-        QDBusMessage::createMethodCall(QStringLiteral(UP_DBUS_SERVICE), m_udi, QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("GetAll"));
-    call.setArguments({QStringLiteral(UP_DBUS_INTERFACE_DEVICE)});
-    QDBusReply<QVariantMap> reply = QDBusConnection::systemBus().call(call);
-
-    if (reply.isValid()) {
-        m_cache = reply.value();
-        m_cacheComplete = true;
-    } else {
-        m_cache.clear();
+    if (m_backend) {
+        return m_backend->propertyExists(key);
     }
+    return false;
 }
 
 QMap<QString, QVariant> UPowerDevice::allProperties() const
 {
-    if (!m_cacheComplete) {
-        loadCache();
+    if (m_backend) {
+        return m_backend->allProperties();
     }
-
-    return m_cache;
+    return QVariantMap();
 }
 
-void UPowerDevice::onPropertiesChanged(const QString &ifaceName, const QVariantMap &changedProps, const QStringList &invalidatedProps)
+DeviceBackend::BatteryStats UPowerDevice::batteryStats() const
 {
-    if (ifaceName != QStringLiteral(UP_DBUS_INTERFACE_DEVICE))
-        return;
-
-    QMap<QString, int> changeMap;
-    for (auto it = changedProps.begin(); it != changedProps.end(); ++it) {
-        m_cache[it.key()] = it.value();
-        m_negativeCache.removeOne(it.key());
-        changeMap.insert(it.key(), Solid::GenericInterface::PropertyModified);
-    }
-    for (const auto &propName : invalidatedProps) {
-        m_cache.remove(propName);
-        m_negativeCache.removeOne(propName);
-        changeMap.insert(propName, Solid::GenericInterface::PropertyModified);
-        m_cacheComplete = false;
-    }
-    Q_EMIT propertyChanged(changeMap);
-}
-
-void UPowerDevice::login1Resuming(bool active)
-{
-    // Nothing to do when going into sleep
-    if (active)
-        return;
-
-    QMap<QString, int> changeMap;
-    for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
-        if (it.value().isValid()) {
-            changeMap.insert(it.key(), Solid::GenericInterface::PropertyModified);
-	}
+    if (m_backend) {
+        return m_backend->batteryStats();
     }
-    m_cache.clear();
-    m_negativeCache.clear();
-    m_cacheComplete = false;
-    Q_EMIT propertyChanged(changeMap);
+    return DeviceBackend::BatteryStats();
 }
 
 #include "moc_upowerdevice.cpp"
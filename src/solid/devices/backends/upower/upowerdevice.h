@@ -9,8 +9,11 @@
 #ifndef UPOWERDEVICE_H
 #define UPOWERDEVICE_H
 
+#include "upowerdevicebackend.h"
+
 #include <ifaces/device.h>
 #include <solid/deviceinterface.h>
+#include <solid/genericinterface.h>
 
 namespace Solid
 {
@@ -39,22 +42,17 @@ public:
     bool propertyExists(const QString &key) const;
     QMap<QString, QVariant> allProperties() const;
 
-Q_SIGNALS:
-    void propertyChanged(const QMap<QString, int> &changes);
+    /* typed battery fields maintained by the shared backend */
+    DeviceBackend::BatteryStats batteryStats() const;
 
-private Q_SLOTS:
-    void onPropertiesChanged(const QString &ifaceName, const QVariantMap &changedProps, const QStringList &invalidatedProps);
-    void login1Resuming(bool active);
+Q_SIGNALS:
+    void propertyEventsChanged(const QList<Solid::GenericInterface::PropertyChangeEvent> &events);
 
 private:
     QString batteryTechnology() const;
     QString m_udi;
-    mutable QVariantMap m_cache;
-    mutable QStringList m_negativeCache;
-    mutable bool m_cacheComplete = false;
-
-    void checkCache(const QString &key) const;
-    void loadCache() const;
+    /* shared per-UDI property cache, owned by the backend registry */
+    DeviceBackend *m_backend;
 };
 
 }
@@ -0,0 +1,429 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "upowerdevicebackend.h"
+#include "udistringpool_p.h"
+#include "upower.h"
+#include "upower_debug.h"
+
+#include "solidwatchdog_p.h"
+
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusReply>
+#include <QMutex>
+#include <QSettings>
+#include <QStandardPaths>
+
+using namespace Solid::Backends::UPower;
+
+/* Process-wide registry, one shared backend per UDI. */
+namespace
+{
+struct BackendRegistry {
+    ~BackendRegistry()
+    {
+        qDeleteAll(backends);
+    }
+
+    QMutex mutex;
+    QMap<QString /* UDI */, DeviceBackend *> backends;
+};
+}
+
+Q_GLOBAL_STATIC(BackendRegistry, s_backends)
+
+/* Identity properties that never change for the life of a battery. They
+ * are persisted per device so a fresh session answers vendor/model style
+ * queries from disk and only the volatile charge state has to go over
+ * the bus. Each record carries the serial and is revalidated against the
+ * live value whenever the full property set is fetched. */
+static const QString s_identityKeys[] = {
+    QStringLiteral("Type"),
+    QStringLiteral("NativePath"),
+    QStringLiteral("Vendor"),
+    QStringLiteral("Model"),
+    QStringLiteral("Serial"),
+    QStringLiteral("Technology"),
+    QStringLiteral("EnergyFullDesign"),
+};
+
+Q_GLOBAL_STATIC(QMutex, s_identityCacheMutex)
+
+static QString identityCachePath()
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (dir.isEmpty()) {
+        return QString();
+    }
+    return dir + QLatin1String("/solid-upower-battery-identity.ini");
+}
+
+static bool isIdentityKey(const QString &key)
+{
+    for (const QString &identityKey : s_identityKeys) {
+        if (key == identityKey) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* UPower builds the trailing component of its object paths from the
+ * device's native path, so it doubles as the record key. */
+static QString identityCacheGroup(const QString &udi)
+{
+    return udi.mid(udi.lastIndexOf(QLatin1Char('/')) + 1);
+}
+
+/* Backends can be created from any thread but have to outlive it to keep
+ * receiving their D-Bus signals; give them all main-thread affinity. */
+static void adoptBackend(DeviceBackend *backend)
+{
+    const QCoreApplication *app = QCoreApplication::instance();
+    if (app && backend->thread() != app->thread()) {
+        backend->moveToThread(app->thread());
+    }
+}
+
+DeviceBackend *DeviceBackend::backendForUDI(const QString &udi, bool create)
+{
+    if (udi.isEmpty()) {
+        return nullptr;
+    }
+
+    BackendRegistry *registry = s_backends();
+    QMutexLocker locker(&registry->mutex);
+
+    DeviceBackend *backend = registry->backends.value(udi);
+    if (!backend && create) {
+        const QString interned = Solid::internedUdi(udi);
+        backend = new DeviceBackend(interned);
+        adoptBackend(backend);
+        registry->backends.insert(interned, backend);
+    }
+
+    return backend;
+}
+
+void DeviceBackend::destroyBackend(const QString &udi)
+{
+    BackendRegistry *registry = s_backends();
+    QMutexLocker locker(&registry->mutex);
+    delete registry->backends.take(udi);
+}
+
+DeviceBackend::DeviceBackend(const QString &udi)
+    : m_udi(udi)
+{
+    /* The PropertiesChanged match is added lazily by connectNotify() once
+     * someone actually listens; plain property pulls never need it. */
+
+    // TODO port this to Solid::Power, we can't link against kdelibs4support for this signal
+    // older upower versions not affected
+    QDBusConnection::systemBus().connect(QStringLiteral("org.freedesktop.login1"), //
+                                         QStringLiteral("/org/freedesktop/login1"),
+                                         QStringLiteral("org.freedesktop.login1.Manager"),
+                                         QStringLiteral("PrepareForSleep"),
+                                         this,
+                                         SLOT(login1Resuming(bool)));
+}
+
+DeviceBackend::~DeviceBackend()
+{
+    setListeningEnabled(false);
+}
+
+void DeviceBackend::connectNotify(const QMetaMethod &signal)
+{
+    if (signal == QMetaMethod::fromSignal(&DeviceBackend::propertyEventsChanged)) {
+        scheduleListeningUpdate();
+    }
+}
+
+void DeviceBackend::disconnectNotify(const QMetaMethod &signal)
+{
+    /* an invalid method here means "disconnected from everything" */
+    if (!signal.isValid() || signal == QMetaMethod::fromSignal(&DeviceBackend::propertyEventsChanged)) {
+        scheduleListeningUpdate();
+    }
+}
+
+void DeviceBackend::scheduleListeningUpdate()
+{
+    /* The notify hooks run on the connecting thread with internal
+     * signal/slot locks held, so hop to our own thread before touching
+     * the bus connection. */
+    QMetaObject::invokeMethod(this, &DeviceBackend::updateListeningState, Qt::QueuedConnection);
+}
+
+void DeviceBackend::updateListeningState()
+{
+    setListeningEnabled(isSignalConnected(QMetaMethod::fromSignal(&DeviceBackend::propertyEventsChanged)));
+}
+
+void DeviceBackend::setListeningEnabled(bool enabled)
+{
+    if (enabled == m_listening) {
+        return;
+    }
+    m_listening = enabled;
+
+    /* arg0 of PropertiesChanged carries the interface whose properties
+     * changed; matching on it bus-side keeps changes of unrelated
+     * interfaces on this path from waking the process at all. */
+    const QStringList argumentMatch{QStringLiteral(UP_DBUS_INTERFACE_DEVICE)};
+    if (enabled) {
+        QDBusConnection::systemBus().connect(QStringLiteral(UP_DBUS_SERVICE),
+                                             m_udi,
+                                             QStringLiteral("org.freedesktop.DBus.Properties"),
+                                             QStringLiteral("PropertiesChanged"),
+                                             argumentMatch,
+                                             QString(),
+                                             this,
+                                             SLOT(onPropertiesChanged(QString, QVariantMap, QStringList)));
+        /* changes were not tracked while nobody listened; dropping the
+         * cache after the match is in place leaves no stale window */
+        QMutexLocker locker(&m_mutex);
+        m_cache.clear();
+        m_negativeCache.clear();
+        m_cacheComplete = false;
+        m_statsValid = false;
+        m_identityLoaded = false;
+    } else {
+        QDBusConnection::systemBus().disconnect(QStringLiteral(UP_DBUS_SERVICE),
+                                                m_udi,
+                                                QStringLiteral("org.freedesktop.DBus.Properties"),
+                                                QStringLiteral("PropertiesChanged"),
+                                                argumentMatch,
+                                                QString(),
+                                                this,
+                                                SLOT(onPropertiesChanged(QString, QVariantMap, QStringList)));
+    }
+}
+
+void DeviceBackend::checkCache(const QString &key) const
+{
+    if (m_cache.contains(key) || m_negativeCache.contains(key)) {
+        return;
+    }
+
+    /* Static identity reads at session start come from the on-disk record
+     * without touching the bus; a stale record (battery swapped in the
+     * same slot) is corrected by the serial check on the next full fetch. */
+    if (!m_identityLoaded && isIdentityKey(key)) {
+        loadPersistentIdentity();
+        if (m_cache.contains(key)) {
+            return;
+        }
+    }
+
+    loadCache();
+
+    if (m_cache.contains(key)) {
+        return;
+    }
+
+    QDBusMessage call =
+        QDBusMessage::createMethodCall(QStringLiteral(UP_DBUS_SERVICE), m_udi, QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("Get"));
+    call.setArguments({QStringLiteral(UP_DBUS_INTERFACE_DEVICE), key});
+    QDBusMessage replyMessage;
+    {
+        const Solid::Watchdog::BlockingCallGuard guard(UPOWER(), "DeviceBackend::checkCache", m_udi);
+        replyMessage = QDBusConnection::systemBus().call(call);
+    }
+    QDBusReply<QVariant> reply = replyMessage;
+
+    if (reply.isValid()) {
+        m_cache[key] = reply.value();
+        m_statsValid = false;
+    } else {
+        m_negativeCache.append(key);
+    }
+}
+
+QVariant DeviceBackend::prop(const QString &key) const
+{
+    QMutexLocker locker(&m_mutex);
+    checkCache(key);
+    return m_cache.value(key);
+}
+
+bool DeviceBackend::propertyExists(const QString &key) const
+{
+    QMutexLocker locker(&m_mutex);
+    checkCache(key);
+    return m_cache.contains(key);
+}
+
+void DeviceBackend::loadCache() const
+{
+    QDBusMessage call =
+        QDBusMessage::createMethodCall(QStringLiteral(UP_DBUS_SERVICE), m_udi, QStringLiteral("org.freedesktop.DBus.Properties"), QStringLiteral("GetAll"));
+    call.setArguments({QStringLiteral(UP_DBUS_INTERFACE_DEVICE)});
+    QDBusMessage replyMessage;
+    {
+        const Solid::Watchdog::BlockingCallGuard guard(UPOWER(), "DeviceBackend::loadCache", m_udi);
+        replyMessage = QDBusConnection::systemBus().call(call);
+    }
+    QDBusReply<QVariantMap> reply = replyMessage;
+
+    if (reply.isValid()) {
+        m_cache = reply.value();
+        m_cacheComplete = true;
+        storePersistentIdentity();
+    } else {
+        m_cache.clear();
+    }
+    m_statsValid = false;
+}
+
+void DeviceBackend::loadPersistentIdentity() const
+{
+    m_identityLoaded = true;
+
+    const QString path = identityCachePath();
+    if (path.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(s_identityCacheMutex());
+    QSettings settings(path, QSettings::IniFormat);
+    settings.beginGroup(identityCacheGroup(m_udi));
+
+    /* Without a serial the record could belong to a replacement battery
+     * in the same slot; such devices are never persisted, so an empty
+     * serial means there is nothing trustworthy here. */
+    if (settings.value(QStringLiteral("Serial")).toString().isEmpty()) {
+        return;
+    }
+
+    for (const QString &key : s_identityKeys) {
+        const QVariant value = settings.value(key);
+        if (value.isValid() && !m_cache.contains(key)) {
+            m_cache.insert(key, value);
+        }
+    }
+    m_statsValid = false;
+}
+
+void DeviceBackend::storePersistentIdentity() const
+{
+    const QString serial = m_cache.value(QStringLiteral("Serial")).toString();
+    if (serial.isEmpty()) {
+        return;
+    }
+
+    const QString path = identityCachePath();
+    if (path.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(s_identityCacheMutex());
+    QSettings settings(path, QSettings::IniFormat);
+    settings.beginGroup(identityCacheGroup(m_udi));
+
+    if (settings.value(QStringLiteral("Serial")).toString() == serial) {
+        return; // record already matches this battery
+    }
+
+    for (const QString &key : s_identityKeys) {
+        settings.setValue(key, m_cache.value(key));
+    }
+}
+
+QVariantMap DeviceBackend::allProperties() const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_cacheComplete) {
+        loadCache();
+    }
+
+    return m_cache;
+}
+
+DeviceBackend::BatteryStats DeviceBackend::batteryStats() const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_statsValid) {
+        /* battery getters touch most of these keys anyway, so warm the
+         * whole cache and convert in one pass per change batch */
+        if (!m_cacheComplete) {
+            loadCache();
+        }
+
+        m_stats.percentage = m_cache.value(QStringLiteral("Percentage")).toDouble();
+        m_stats.capacity = m_cache.value(QStringLiteral("Capacity")).toDouble();
+        m_stats.energy = m_cache.value(QStringLiteral("Energy")).toDouble();
+        m_stats.energyFull = m_cache.value(QStringLiteral("EnergyFull")).toDouble();
+        m_stats.energyFullDesign = m_cache.value(QStringLiteral("EnergyFullDesign")).toDouble();
+        m_stats.energyRate = m_cache.value(QStringLiteral("EnergyRate")).toDouble();
+        m_stats.voltage = m_cache.value(QStringLiteral("Voltage")).toDouble();
+        m_stats.temperature = m_cache.value(QStringLiteral("Temperature")).toDouble();
+        m_stats.timeToEmpty = m_cache.value(QStringLiteral("TimeToEmpty")).toLongLong();
+        m_stats.timeToFull = m_cache.value(QStringLiteral("TimeToFull")).toLongLong();
+        m_stats.kind = m_cache.value(QStringLiteral("Type")).toUInt();
+        m_stats.state = m_cache.value(QStringLiteral("State")).toUInt();
+        m_stats.technology = m_cache.value(QStringLiteral("Technology")).toUInt();
+        m_stats.isPresent = m_cache.value(QStringLiteral("IsPresent")).toBool();
+        m_stats.isRechargeable = m_cache.value(QStringLiteral("IsRechargeable")).toBool();
+        m_stats.powerSupply = m_cache.value(QStringLiteral("PowerSupply")).toBool();
+
+        m_statsValid = true;
+    }
+
+    return m_stats;
+}
+
+void DeviceBackend::onPropertiesChanged(const QString &ifaceName, const QVariantMap &changedProps, const QStringList &invalidatedProps)
+{
+    if (ifaceName != QStringLiteral(UP_DBUS_INTERFACE_DEVICE))
+        return;
+
+    QList<Solid::GenericInterface::PropertyChangeEvent> events;
+    events.reserve(changedProps.size() + invalidatedProps.size());
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto it = changedProps.begin(); it != changedProps.end(); ++it) {
+            m_cache[it.key()] = it.value();
+            m_negativeCache.removeOne(it.key());
+            events.append({Solid::GenericInterface::propertyId(it.key()), Solid::GenericInterface::PropertyModified});
+        }
+        for (const auto &propName : invalidatedProps) {
+            m_cache.remove(propName);
+            m_negativeCache.removeOne(propName);
+            events.append({Solid::GenericInterface::propertyId(propName), Solid::GenericInterface::PropertyModified});
+            m_cacheComplete = false;
+        }
+        m_statsValid = false;
+    }
+    Q_EMIT propertyEventsChanged(events);
+}
+
+void DeviceBackend::login1Resuming(bool active)
+{
+    // Nothing to do when going into sleep
+    if (active)
+        return;
+
+    QList<Solid::GenericInterface::PropertyChangeEvent> events;
+    {
+        QMutexLocker locker(&m_mutex);
+        events.reserve(m_cache.size());
+        for (auto it = m_cache.begin(); it != m_cache.end(); ++it) {
+            if (it.value().isValid()) {
+                events.append({Solid::GenericInterface::propertyId(it.key()), Solid::GenericInterface::PropertyModified});
+            }
+        }
+        m_cache.clear();
+        m_negativeCache.clear();
+        m_cacheComplete = false;
+        m_statsValid = false;
+    }
+    Q_EMIT propertyEventsChanged(events);
+}
+
+#include "moc_upowerdevicebackend.cpp"
@@ -0,0 +1,118 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef UPOWERDEVICEBACKEND_H
+#define UPOWERDEVICEBACKEND_H
+
+#include <QMetaMethod>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <solid/genericinterface.h>
+
+namespace Solid
+{
+namespace Backends
+{
+namespace UPower
+{
+/**
+ * One cached property state per UDI, shared by every UPowerDevice wrapping
+ * that UDI (the same arrangement the UDisks2 backend uses). Frontend
+ * Devices are short-lived and devicesFromQuery() constructs one wrapper
+ * per UDI per query; without the shared backend each of those re-ran a
+ * blocking GetAll to warm its private cache.
+ */
+class DeviceBackend : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DeviceBackend *backendForUDI(const QString &udi, bool create = true);
+    static void destroyBackend(const QString &udi);
+
+    explicit DeviceBackend(const QString &udi);
+    ~DeviceBackend() override;
+
+    QVariant prop(const QString &key) const;
+    bool propertyExists(const QString &key) const;
+    QVariantMap allProperties() const;
+
+    /**
+     * The battery-related properties converted out of the QVariant cache
+     * once per change batch, so the Battery getters are plain member reads
+     * instead of a QVariantMap lookup plus conversion per call. Returned
+     * by value: a snapshot the caller can read without holding the lock.
+     */
+    struct BatteryStats {
+        double percentage = 0;
+        double capacity = 0;
+        double energy = 0;
+        double energyFull = 0;
+        double energyFullDesign = 0;
+        double energyRate = 0;
+        double voltage = 0;
+        double temperature = 0;
+        qlonglong timeToEmpty = 0;
+        qlonglong timeToFull = 0;
+        uint kind = 0;
+        uint state = 0;
+        uint technology = 0;
+        bool isPresent = false;
+        bool isRechargeable = false;
+        bool powerSupply = false;
+    };
+
+    BatteryStats batteryStats() const;
+
+Q_SIGNALS:
+    void propertyEventsChanged(const QList<Solid::GenericInterface::PropertyChangeEvent> &events);
+
+protected:
+    /* The PropertiesChanged match is only held on the bus while someone
+     * listens to propertyEventsChanged, so idle processes don't wake on
+     * every charge tick of every battery. */
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
+
+private Q_SLOTS:
+    void onPropertiesChanged(const QString &ifaceName, const QVariantMap &changedProps, const QStringList &invalidatedProps);
+    void login1Resuming(bool active);
+    void updateListeningState();
+
+private:
+    void setListeningEnabled(bool enabled);
+    void scheduleListeningUpdate();
+    void checkCache(const QString &key) const;
+    void loadCache() const;
+    void loadPersistentIdentity() const;
+    void storePersistentIdentity() const;
+
+    QString m_udi;
+    /* Backends are shared between threads through the registry, so the
+     * cache state below is guarded by m_mutex; recursive because the
+     * accessors nest (checkCache() -> loadCache()), matching the UDisks2
+     * backend. */
+    mutable QRecursiveMutex m_mutex;
+    mutable QVariantMap m_cache;
+    mutable QStringList m_negativeCache;
+    mutable bool m_cacheComplete = false;
+    /* typed mirror of the battery properties, rebuilt lazily when stale */
+    mutable BatteryStats m_stats;
+    mutable bool m_statsValid = false;
+    /* whether the on-disk identity record was consulted this session */
+    mutable bool m_identityLoaded = false;
+    /* whether the PropertiesChanged match is currently on the bus */
+    bool m_listening = false;
+};
+
+}
+}
+}
+
+#endif // UPOWERDEVICEBACKEND_H
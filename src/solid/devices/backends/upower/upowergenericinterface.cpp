@@ -13,8 +13,8 @@ using namespace Solid::Backends::UPower;
 GenericInterface::GenericInterface(UPowerDevice *device)
     : DeviceInterface(device)
 {
-    connect(device, &UPowerDevice::propertyChanged,
-            this, &GenericInterface::propertyChanged);
+    connect(device, &UPowerDevice::propertyEventsChanged,
+            this, &GenericInterface::propertyEventsChanged);
 #if 0 // not used/implemented
     connect(device, &UPowerDevice::conditionRaised,
             this, &UPowerDevice::conditionRaised);
@@ -7,10 +7,15 @@
 
 #include "upowermanager.h"
 #include "upower.h"
+#include "upower_debug.h"
 #include "upowerdevice.h"
+#include "upowerdevicebackend.h"
+
+#include "solidwatchdog_p.h"
 
 #include <QDBusConnectionInterface>
 #include <QDBusMetaType>
+#include <QDBusPendingCallWatcher>
 #include <QDBusReply>
 #include <QDebug>
 
@@ -28,25 +33,90 @@ UPowerManager::UPowerManager(QObject *parent)
     qDBusRegisterMetaType<QList<QDBusObjectPath>>();
     qDBusRegisterMetaType<QVariantMap>();
 
-    bool serviceFound = m_manager.isValid();
-    if (!serviceFound) {
+    /* Service discovery and activation happen in ensureService() on first
+     * actual use; constructing the manager stays allocation-only so that
+     * processes which never query power devices don't wake up upowerd. */
+}
+
+bool UPowerManager::ensureService()
+{
+    if (m_serviceProbed) {
+        return m_serviceAvailable;
+    }
+    m_serviceProbed = true;
+
+    m_serviceAvailable = m_manager.isValid();
+    if (!m_serviceAvailable) {
         // find out whether it will be activated automatically
         QDBusMessage message = QDBusMessage::createMethodCall(QStringLiteral("org.freedesktop.DBus"), //
                                                               QStringLiteral("/org/freedesktop/DBus"),
                                                               QStringLiteral("org.freedesktop.DBus"),
                                                               QStringLiteral("ListActivatableNames"));
 
-        QDBusReply<QStringList> reply = QDBusConnection::systemBus().call(message);
+        QDBusMessage replyMessage;
+        {
+            const Solid::Watchdog::BlockingCallGuard guard(UPOWER(), "UPowerManager::ensureService", QStringLiteral("ListActivatableNames"));
+            replyMessage = QDBusConnection::systemBus().call(message);
+        }
+        QDBusReply<QStringList> reply = replyMessage;
         if (reply.isValid() && reply.value().contains(QStringLiteral(UP_DBUS_SERVICE))) {
-            QDBusConnection::systemBus().interface()->startService(QStringLiteral(UP_DBUS_SERVICE));
-            serviceFound = true;
+            /* Fire the activation request without blocking; the first real
+             * method call simply queues behind the autostart in dbus-daemon. */
+            QDBusConnection::systemBus().interface()->asyncCall(QStringLiteral("StartServiceByName"), QStringLiteral(UP_DBUS_SERVICE), 0u);
+            m_serviceAvailable = true;
         }
     }
 
-    if (serviceFound) {
+    if (m_serviceAvailable) {
         connect(&m_manager, &UPower::DBusInterface::DeviceAdded, this, &UPowerManager::onDeviceAdded);
         connect(&m_manager, &UPower::DBusInterface::DeviceRemoved, this, &UPowerManager::onDeviceRemoved);
+
+        /* Get the enumeration round trip going right away; by the time a
+         * caller wants the actual list the reply is usually in. */
+        startEnumeration();
+    }
+
+    return m_serviceAvailable;
+}
+
+void UPowerManager::startEnumeration()
+{
+    if (m_enumerated || m_enumerationWatcher) {
+        return;
+    }
+
+    m_enumerationWatcher = new QDBusPendingCallWatcher(m_manager.EnumerateDevices(), this);
+    connect(m_enumerationWatcher, &QDBusPendingCallWatcher::finished, this, &UPowerManager::onEnumerationFinished);
+}
+
+void UPowerManager::onEnumerationFinished(QDBusPendingCallWatcher *watcher)
+{
+    const QDBusPendingReply<QList<QDBusObjectPath>> reply = *watcher;
+    watcher->deleteLater();
+    m_enumerationWatcher = nullptr;
+
+    if (!reply.isValid()) {
+        qWarning() << Q_FUNC_INFO << " error: " << reply.error().name();
+        m_removedDuringEnumeration.clear();
+        return;
+    }
+
+    const auto pathList = reply.value();
+    for (const QDBusObjectPath &path : pathList) {
+        const QString pathString = path.path();
+        /* adds that raced the reply are in the list already; removals that
+         * raced it win over the stale enumeration result */
+        if (m_knownDevices.contains(pathString) || m_removedDuringEnumeration.contains(pathString)) {
+            continue;
+        }
+        m_knownDevices.append(pathString);
+        /* replay for subscribers which connected before the reply landed */
+        Q_EMIT deviceAdded(pathString);
     }
+    m_removedDuringEnumeration.clear();
+
+    std::sort(m_knownDevices.begin(), m_knownDevices.end());
+    m_enumerated = true;
 }
 
 UPowerManager::~UPowerManager()
@@ -56,13 +126,23 @@ UPowerManager::~UPowerManager()
 QObject *UPowerManager::createDevice(const QString &udi)
 {
     if (udi == udiPrefix()) {
-        RootDevice *root = new RootDevice(udiPrefix());
+        /* clones of a one-time prototype: the frontend deletes what we
+         * return, but the clones share the translated strings */
+        if (!m_rootDevice) {
+            m_rootDevice = new RootDevice(udiPrefix());
+            m_rootDevice->setParent(this);
+            m_rootDevice->setProduct(tr("Power Management"));
+            m_rootDevice->setDescription(tr("Batteries and other sources of power"));
+            m_rootDevice->setIcon(QStringLiteral("preferences-system-power-management"));
+        }
 
-        root->setProduct(tr("Power Management"));
-        root->setDescription(tr("Batteries and other sources of power"));
-        root->setIcon(QStringLiteral("preferences-system-power-management"));
+        return m_rootDevice->clone();
 
-        return root;
+    } else if (udi == udiPrefix() + QLatin1String("/devices/DisplayDevice")) {
+        /* upowerd's composite battery lives at a fixed path and is not part
+         * of EnumerateDevices; hand it out without triggering enumeration
+         * so "the battery percentage" stays a single-object query. */
+        return new UPowerDevice(udi);
 
     } else if (m_knownDevices.contains(udi) || allDevices().contains(udi)) {
         return new UPowerDevice(udi);
@@ -110,33 +190,25 @@ QStringList UPowerManager::devicesFromQuery(const QString &parentUdi, Solid::Dev
 
 QStringList UPowerManager::allDevices()
 {
-    static bool initialized = false;
-    if (initialized)
+    if (m_enumerated) {
         return m_knownDevices;
-
-    auto reply = m_manager.EnumerateDevices();
-    reply.waitForFinished();
-
-    if (!reply.isValid()) {
-        qWarning() << Q_FUNC_INFO << " error: " << reply.error().name();
-        return QStringList();
     }
-    const auto pathList = reply.value();
 
-    QStringList retList;
-    retList.reserve(pathList.size() + m_knownDevices.size());
-
-    for (const QDBusObjectPath &path : pathList) {
-        retList << path.path();
+    if (!ensureService()) {
+        return m_knownDevices;
     }
-    retList += m_knownDevices;
 
-    std::sort(retList.begin(), retList.end());
-    auto end = std::unique(retList.begin(), retList.end());
-    retList.erase(end, retList.end());
+    // restart after a failed round trip; no-op while one is in flight
+    startEnumeration();
 
-    m_knownDevices = retList;
-    initialized = true;
+    if (m_enumerationWatcher) {
+        /* Last-resort blocking path: a caller needing the list before the
+         * asynchronous reply landed waits out the remainder of the round
+         * trip. This delivers finished() and runs onEnumerationFinished()
+         * before returning. */
+        const Solid::Watchdog::BlockingCallGuard guard(UPOWER(), "UPowerManager::allDevices", QStringLiteral("EnumerateDevices"));
+        m_enumerationWatcher->waitForFinished();
+    }
 
     return m_knownDevices;
 }
@@ -156,6 +228,7 @@ void UPowerManager::onDeviceAdded(const QDBusObjectPath &path)
     auto pathString = path.path();
     if (m_knownDevices.indexOf(pathString) < 0)
         m_knownDevices.append(pathString);
+    m_removedDuringEnumeration.remove(pathString);
 
     Q_EMIT deviceAdded(pathString);
 }
@@ -163,11 +236,16 @@ void UPowerManager::onDeviceAdded(const QDBusObjectPath &path)
 void UPowerManager::onDeviceRemoved(const QDBusObjectPath &path)
 {
     auto pathString = path.path();
+    if (m_enumerationWatcher) {
+        // keep the in-flight enumeration from resurrecting this device
+        m_removedDuringEnumeration.insert(pathString);
+    }
     auto index = m_knownDevices.indexOf(pathString);
     if (index >= 0) {
         m_knownDevices.removeAt(index);
         Q_EMIT deviceRemoved(pathString);
     }
+    DeviceBackend::destroyBackend(pathString);
 }
 
 #include "moc_upowermanager.cpp"
@@ -14,10 +14,17 @@
 
 #include <QSet>
 
+class QDBusPendingCallWatcher;
+
 namespace Solid
 {
 namespace Backends
 {
+namespace Shared
+{
+class RootDevice;
+}
+
 namespace UPower
 {
 class UPowerManager : public Solid::Ifaces::DeviceManager
@@ -36,11 +43,23 @@ public:
 private Q_SLOTS:
     void onDeviceAdded(const QDBusObjectPath &path);
     void onDeviceRemoved(const QDBusObjectPath &path);
+    void onEnumerationFinished(QDBusPendingCallWatcher *watcher);
 
 private:
+    bool ensureService();
+    void startEnumeration();
+
     QSet<Solid::DeviceInterface::Type> m_supportedInterfaces;
     UPower::DBusInterface m_manager;
     QStringList m_knownDevices;
+    bool m_serviceProbed = false;
+    bool m_serviceAvailable = false;
+    /* initial EnumerateDevices call in flight, see startEnumeration() */
+    QDBusPendingCallWatcher *m_enumerationWatcher = nullptr;
+    bool m_enumerated = false;
+    QSet<QString> m_removedDuringEnumeration;
+    /* configured once, cloned for every root device request */
+    Shared::RootDevice *m_rootDevice = nullptr;
 };
 
 }
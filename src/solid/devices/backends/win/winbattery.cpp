@@ -14,10 +14,13 @@
 using namespace Solid::Backends::Win;
 
 QMap<QString, WinBattery::Battery> WinBattery::m_udiToGDI = QMap<QString, WinBattery::Battery>();
+QSet<QString> WinBattery::m_enumerationSnapshot = QSet<QString>();
+bool WinBattery::m_enumerationSnapshotValid = false;
 
 WinBattery::WinBattery(WinDevice *device)
     : WinInterface(device)
     , m_state(Solid::Battery::NoCharge)
+    , m_serialQueried(false)
 {
     powerChanged();
     connect(SolidWinEventFilter::instance(), SIGNAL(powerChanged()), this, SLOT(powerChanged()));
@@ -55,6 +58,12 @@ Solid::Battery::ChargeState WinBattery::chargeState() const
 
 QSet<QString> WinBattery::getUdis()
 {
+    // the SetupAPI walk is expensive; serve the snapshot until a battery
+    // interface broadcast invalidates it
+    if (m_enumerationSnapshotValid) {
+        return m_enumerationSnapshot;
+    }
+
     QSet<QString> udis;
     HDEVINFO hdev = SetupDiGetClassDevs(&GUID_DEVCLASS_BATTERY, 0, 0, DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
 
@@ -88,9 +97,17 @@ QSet<QString> WinBattery::getUdis()
 
         SetupDiDestroyDeviceInfoList(hdev);
     }
+
+    m_enumerationSnapshot = udis;
+    m_enumerationSnapshotValid = true;
     return udis;
 }
 
+void WinBattery::invalidateEnumerationCache()
+{
+    m_enumerationSnapshotValid = false;
+}
+
 const WinBattery::Battery WinBattery::batteryInfoFromUdi(const QString &udi)
 {
     return m_udiToGDI[udi];
@@ -121,7 +138,11 @@ void WinBattery::powerChanged()
     BATTERY_INFORMATION info =
         WinDeviceManager::getDeviceInfo<BATTERY_INFORMATION, BATTERY_QUERY_INFORMATION>(b.first, IOCTL_BATTERY_QUERY_INFORMATION, &batteryInformationQuery);
 
-    initSerial(b);
+    // the serial never changes, one successful query is enough
+    if (!m_serialQueried) {
+        initSerial(b);
+        m_serialQueried = true;
+    }
     updateBatteryTemp(b);
     updateTimeToEmpty(b);
 
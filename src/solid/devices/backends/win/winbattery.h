@@ -66,6 +66,13 @@ public:
 
     static QSet<QString> getUdis();
 
+    /**
+     * Drops the cached SetupAPI enumeration snapshot so the next
+     * getUdis() walks the device interfaces again; driven by the
+     * battery interface broadcasts.
+     */
+    static void invalidateEnumerationCache();
+
     static const Battery batteryInfoFromUdi(const QString &udi);
 
 Q_SIGNALS:
@@ -97,6 +104,8 @@ private:
     void updateBatteryTemp(const Battery &b);
 
     static QMap<QString, Battery> m_udiToGDI;
+    static QSet<QString> m_enumerationSnapshot;
+    static bool m_enumerationSnapshotValid;
     Solid::Battery::BatteryType m_type;
     int m_charge;
     int m_capacity;
@@ -111,6 +120,7 @@ private:
     double m_voltage;
 
     QString m_serial;
+    bool m_serialQueried;
     ulong m_temperature;
     ulong m_timeUntilEmpty;
 };
@@ -25,7 +25,7 @@ WinBlock::WinBlock(WinDevice *device)
 {
     if (m_device->type() == Solid::DeviceInterface::StorageVolume) {
         STORAGE_DEVICE_NUMBER info =
-            WinDeviceManager::getDeviceInfo<STORAGE_DEVICE_NUMBER>(driveLetterFromUdi(m_device->udi()), IOCTL_STORAGE_GET_DEVICE_NUMBER);
+            WinDeviceManager::getDeviceInfoCached<STORAGE_DEVICE_NUMBER>(driveLetterFromUdi(m_device->udi()), IOCTL_STORAGE_GET_DEVICE_NUMBER);
         m_major = info.DeviceNumber;
         m_minor = info.PartitionNumber;
     } else if (m_device->type() == Solid::DeviceInterface::StorageDrive //
@@ -72,7 +72,42 @@ QStringList WinBlock::drivesFromMask(const DWORD unitmask)
 
 QSet<QString> WinBlock::getUdis()
 {
-    return updateUdiFromBitMask(GetLogicalDrives());
+    // the volume table is kept up to date by the WM_DEVICECHANGE broadcasts,
+    // so only letters we have never seen need a real enumeration
+    const DWORD unitmask = GetLogicalDrives();
+    QSet<QString> list;
+    DWORD missingMask = 0;
+    DWORD localUnitmask(unitmask);
+    for (int i = 0; i <= 25; ++i) {
+        if (0x01 == (localUnitmask & 0x1)) {
+            const QString drive = QStringLiteral("%1:").arg((char)(i + 'A'));
+            const auto cached = m_driveUDIS.constFind(drive);
+            if (cached != m_driveUDIS.constEnd()) {
+                list += cached.value();
+            } else {
+                missingMask |= (0x1 << i);
+            }
+        }
+        localUnitmask >>= 1;
+    }
+    if (missingMask != 0) {
+        list += updateUdiFromBitMask(missingMask);
+    }
+
+    // drop letters that are gone so a returning device gets probed again
+    for (auto it = m_driveUDIS.begin(); it != m_driveUDIS.end();) {
+        const int driveIndex = it.key().at(0).unicode() - 'A';
+        if (0 == (unitmask & (0x1 << driveIndex))) {
+            for (const QString &udi : std::as_const(it.value())) {
+                m_driveLetters.remove(udi);
+                m_virtualDrives.remove(udi);
+            }
+            it = m_driveUDIS.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return list;
 }
 
 QString WinBlock::driveLetterFromUdi(const QString &udi)
@@ -128,7 +163,8 @@ QSet<QString> WinBlock::updateUdiFromBitMask(const DWORD unitmask)
                 m_virtualDrives[key] = dosPath;
                 udis << key;
             } else {
-                STORAGE_DEVICE_NUMBER info = WinDeviceManager::getDeviceInfo<STORAGE_DEVICE_NUMBER>(drive, IOCTL_STORAGE_GET_DEVICE_NUMBER);
+                // overlapped so a drive that has to spin up first can't stall the whole enumeration
+                STORAGE_DEVICE_NUMBER info = WinDeviceManager::getDeviceInfoOverlapped<STORAGE_DEVICE_NUMBER>(drive, IOCTL_STORAGE_GET_DEVICE_NUMBER);
 
                 switch (info.DeviceType) {
                 case FILE_DEVICE_DISK: {
@@ -139,10 +175,11 @@ QSet<QString> WinBlock::updateUdiFromBitMask(const DWORD unitmask)
                 case FILE_DEVICE_CD_ROM:
                 case FILE_DEVICE_DVD: {
                     udis << QStringLiteral("/org/kde/solid/win/storage.cdrom/disk#%1").arg(info.DeviceNumber);
-                    DISK_GEOMETRY_EX out = WinDeviceManager::getDeviceInfo<DISK_GEOMETRY_EX>(drive, IOCTL_DISK_GET_DRIVE_GEOMETRY_EX);
-                    if (out.DiskSize.QuadPart != 0) {
-                        udis << QStringLiteral("/org/kde/solid/win/volume.cdrom/disk#%1").arg(info.DeviceNumber);
-                    }
+                    WinDeviceManager::getDeviceInfoAsync<DISK_GEOMETRY_EX>(drive, IOCTL_DISK_GET_DRIVE_GEOMETRY_EX, [&](const DISK_GEOMETRY_EX &out, bool ok) {
+                        if (ok && out.DiskSize.QuadPart != 0) {
+                            udis << QStringLiteral("/org/kde/solid/win/volume.cdrom/disk#%1").arg(info.DeviceNumber);
+                        }
+                    });
                     break;
                 }
                 default:
@@ -159,6 +196,26 @@ QSet<QString> WinBlock::updateUdiFromBitMask(const DWORD unitmask)
     return list;
 }
 
+QSet<QString> WinBlock::removeUdiFromBitMask(const DWORD unitmask)
+{
+    const QStringList drives = drivesFromMask(unitmask);
+    QSet<QString> list;
+    for (const QString &drive : drives) {
+        const auto cached = m_driveUDIS.constFind(drive);
+        if (cached == m_driveUDIS.constEnd()) {
+            // never enumerated - nothing to report or to prune
+            continue;
+        }
+        list += cached.value();
+        for (const QString &udi : cached.value()) {
+            m_driveLetters.remove(udi);
+            m_virtualDrives.remove(udi);
+        }
+        m_driveUDIS.remove(drive);
+    }
+    return list;
+}
+
 QSet<QString> WinBlock::getFromBitMask(const DWORD unitmask)
 {
     QSet<QString> list;
@@ -36,6 +36,7 @@ public:
     static QString udiFromDriveLetter(const QString &drive);
     static QString resolveVirtualDrive(const QString &drive);
     static QSet<QString> updateUdiFromBitMask(const DWORD unitmask);
+    static QSet<QString> removeUdiFromBitMask(const DWORD unitmask);
     static QSet<QString> getFromBitMask(const DWORD unitmask);
 
 private:
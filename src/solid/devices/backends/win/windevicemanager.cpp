@@ -12,12 +12,52 @@
 #include "winprocessor.h"
 #include <solid/deviceinterface.h>
 
+#include <QHash>
+
 #include <dbt.h>
+#include <devguid.h>
 
 using namespace Solid::Backends::Win;
 
 Q_GLOBAL_STATIC(SolidWinEventFilter, solidWineventFilter)
 
+/* results of ioctls that can't change while a volume stays connected,
+ * keyed by device, control code and query payload */
+typedef QHash<QByteArray, QByteArray> IoctlResultCache;
+Q_GLOBAL_STATIC(IoctlResultCache, s_ioctlResults)
+
+static QByteArray ioctlCacheKey(const QString &devName, int code, const QByteArray &query)
+{
+    QByteArray key = devName.toUtf8();
+    key += '/';
+    key += QByteArray::number(code);
+    if (!query.isEmpty()) {
+        key += '/';
+        key += query.toHex();
+    }
+    return key;
+}
+
+QByteArray WinDeviceManager::lookupIoctlResult(const QString &devName, int code, const QByteArray &query, int size)
+{
+    const QByteArray result = s_ioctlResults->value(ioctlCacheKey(devName, code, query));
+    if (result.size() != size) {
+        // recorded with a different buffer size - of no use to this caller
+        return QByteArray();
+    }
+    return result;
+}
+
+void WinDeviceManager::cacheIoctlResult(const QString &devName, int code, const QByteArray &query, const QByteArray &result)
+{
+    s_ioctlResults->insert(ioctlCacheKey(devName, code, query), result);
+}
+
+void WinDeviceManager::flushIoctlResultCache()
+{
+    s_ioctlResults->clear();
+}
+
 SolidWinEventFilter *SolidWinEventFilter::instance()
 {
     return solidWineventFilter;
@@ -25,6 +65,8 @@ SolidWinEventFilter *SolidWinEventFilter::instance()
 
 SolidWinEventFilter::SolidWinEventFilter()
     : QObject()
+    , m_windowID(NULL)
+    , m_batteryNotification(NULL)
 {
     wchar_t title[] = L"KDEWinDeviceManager";
 
@@ -56,10 +98,42 @@ SolidWinEventFilter::SolidWinEventFilter()
         return;
     }
     ShowWindow(m_windowID, SW_HIDE);
+
+    // the plain WM_POWERBROADCAST only covers the coarse status changes;
+    // these registrations additionally deliver PBT_POWERSETTINGCHANGE when
+    // the charge level or the power source changes, so the batteries can
+    // stay event driven instead of being polled
+    const GUID powerSettings[] = {GUID_BATTERY_PERCENTAGE_REMAINING, GUID_ACDC_POWER_SOURCE};
+    for (const GUID &setting : powerSettings) {
+        HPOWERNOTIFY notify = RegisterPowerSettingNotification(m_windowID, &setting, DEVICE_NOTIFY_WINDOW_HANDLE);
+        if (notify) {
+            m_powerNotifications << notify;
+        } else {
+            qWarning() << "Failed to register power setting notification" << qGetLastError();
+        }
+    }
+
+    // battery interfaces don't produce volume broadcasts; this registration
+    // tells us when the cached SetupAPI enumeration snapshot must be redone
+    DEV_BROADCAST_DEVICEINTERFACE interfaceFilter;
+    ZeroMemory(&interfaceFilter, sizeof(interfaceFilter));
+    interfaceFilter.dbcc_size = sizeof(interfaceFilter);
+    interfaceFilter.dbcc_devicetype = DBT_DEVTYP_DEVICEINTERFACE;
+    interfaceFilter.dbcc_classguid = GUID_DEVCLASS_BATTERY;
+    m_batteryNotification = RegisterDeviceNotification(m_windowID, &interfaceFilter, DEVICE_NOTIFY_WINDOW_HANDLE);
+    if (!m_batteryNotification) {
+        qWarning() << "Failed to register battery interface notification" << qGetLastError();
+    }
 }
 
 SolidWinEventFilter::~SolidWinEventFilter()
 {
+    for (HPOWERNOTIFY notify : std::as_const(m_powerNotifications)) {
+        UnregisterPowerSettingNotification(notify);
+    }
+    if (m_batteryNotification) {
+        UnregisterDeviceNotification(m_batteryNotification);
+    }
     PostMessage(m_windowID, WM_CLOSE, 0, 0);
 }
 
@@ -87,9 +161,12 @@ LRESULT CALLBACK SolidWinEventFilter::WndProc(HWND hWnd, UINT message, WPARAM wP
             DEV_BROADCAST_HDR *header = reinterpret_cast<DEV_BROADCAST_HDR *>(lParam);
             if (header->dbch_devicetype == DBT_DEVTYP_VOLUME) {
                 DEV_BROADCAST_VOLUME *devNot = reinterpret_cast<DEV_BROADCAST_VOLUME *>(lParam);
+                // the set of volumes changed, cached ioctl results may describe the wrong device now
+                WinDeviceManager::flushIoctlResultCache();
                 switch (wParam) {
                 case DBT_DEVICEREMOVECOMPLETE: {
-                    QSet<QString> udis = WinBlock::getFromBitMask(devNot->dbcv_unitmask);
+                    // also prunes the volume table so the next getUdis() stays a cache read
+                    QSet<QString> udis = WinBlock::removeUdiFromBitMask(devNot->dbcv_unitmask);
                     solidWineventFilter->promoteRemovedDevice(udis);
                     break;
                 }
@@ -101,11 +178,28 @@ LRESULT CALLBACK SolidWinEventFilter::WndProc(HWND hWnd, UINT message, WPARAM wP
                 }
                 break;
             }
+            if (header->dbch_devicetype == DBT_DEVTYP_DEVICEINTERFACE) {
+                // a battery came or went - redo the SetupAPI snapshot once
+                // and report the difference
+                const QSet<QString> before = WinBattery::getUdis();
+                WinBattery::invalidateEnumerationCache();
+                const QSet<QString> after = WinBattery::getUdis();
+                if (wParam == DBT_DEVICEARRIVAL) {
+                    solidWineventFilter->promoteAddedDevice(after - before);
+                } else {
+                    solidWineventFilter->promoteRemovedDevice(before - after);
+                }
+                break;
+            }
         }
         break;
     }
     case WM_POWERBROADCAST: {
-        solidWineventFilter->promotePowerChange();
+        // only re-read the battery state for broadcasts that can actually
+        // change it; resume/suspend chatter used to trigger ioctl storms
+        if (wParam == PBT_APMPOWERSTATUSCHANGE || wParam == PBT_POWERSETTINGCHANGE) {
+            solidWineventFilter->promotePowerChange();
+        }
         break;
     }
     case WM_DESTROY: {
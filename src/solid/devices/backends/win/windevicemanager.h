@@ -82,6 +82,83 @@ public:
         getDeviceInfoPrivate<void, void *>(devName, code, NULL, 0, NULL);
     }
 
+    // the grace we give a device to answer an overlapped query before the
+    // request is cancelled; sleeping usb drives can need a few seconds to spin up
+    static const DWORD defaultIoTimeout = 5000;
+
+    /**
+     * Overlapped variants of getDeviceInfo(): the ioctl is issued
+     * asynchronously and awaited with a timeout, so a query against a
+     * spinning-up or otherwise unresponsive device can't stall the caller
+     * indefinitely. On timeout the request is cancelled and the zeroed
+     * INFO is returned.
+     */
+    template<class INFO>
+    static INFO getDeviceInfoOverlapped(const QString &devName, int code, DWORD timeout = defaultIoTimeout)
+    {
+        return getDeviceInfoOverlapped<INFO, void *>(devName, code, NULL, timeout);
+    }
+
+    template<class INFO, class QUERY>
+    static INFO getDeviceInfoOverlapped(const QString &devName, int code, QUERY *query, DWORD timeout = defaultIoTimeout)
+    {
+        INFO info;
+        ZeroMemory(&info, sizeof(INFO));
+        getDeviceInfoOverlappedPrivate(devName, code, &info, sizeof(INFO), query, timeout);
+        return info;
+    }
+
+    /**
+     * Overlapped query invoking \a onCompletion with the result and a flag
+     * telling whether the query completed successfully within the timeout.
+     */
+    template<class INFO, class COMPLETION>
+    static void getDeviceInfoAsync(const QString &devName, int code, COMPLETION onCompletion, DWORD timeout = defaultIoTimeout)
+    {
+        INFO info;
+        ZeroMemory(&info, sizeof(INFO));
+        const bool ok = getDeviceInfoOverlappedPrivate<INFO, void *>(devName, code, &info, sizeof(INFO), NULL, timeout);
+        onCompletion(info, ok);
+    }
+
+    static bool deviceActionOverlapped(const QString &devName, int code, DWORD timeout = defaultIoTimeout)
+    {
+        return getDeviceInfoOverlappedPrivate<void, void *>(devName, code, NULL, 0, NULL, timeout);
+    }
+
+    /**
+     * Cached variants for queries whose result is immutable for the
+     * lifetime of a volume (device numbers, geometry, descriptors). A
+     * successful result is kept per device and control code and served
+     * from memory until a device change broadcast flushes the cache, so
+     * repeated property reads don't re-enter the kernel.
+     */
+    template<class INFO>
+    static INFO getDeviceInfoCached(const QString &devName, int code)
+    {
+        return getDeviceInfoCached<INFO, void *>(devName, code, NULL);
+    }
+
+    template<class INFO, class QUERY>
+    static INFO getDeviceInfoCached(const QString &devName, int code, QUERY *query)
+    {
+        INFO info;
+        ZeroMemory(&info, sizeof(INFO));
+        const QByteArray queryBytes(reinterpret_cast<const char *>(query), query ? sizeof(QUERY) : 0);
+        const QByteArray cached = lookupIoctlResult(devName, code, queryBytes, sizeof(INFO));
+        if (!cached.isEmpty()) {
+            memcpy(&info, cached.constData(), sizeof(INFO));
+            return info;
+        }
+        if (getDeviceInfoOverlappedPrivate(devName, code, &info, sizeof(INFO), query, defaultIoTimeout)) {
+            cacheIoctlResult(devName, code, queryBytes, QByteArray(reinterpret_cast<const char *>(&info), sizeof(INFO)));
+        }
+        return info;
+    }
+
+    /** Drops the cached ioctl results; driven by WM_DEVICECHANGE. */
+    static void flushIoctlResultCache();
+
 Q_SIGNALS:
     void powerChanged();
 
@@ -97,43 +174,35 @@ private:
     QStringList m_devicesList;
     QSet<Solid::DeviceInterface::Type> m_supportedInterfaces;
 
-    template<class INFO, class QUERY>
-    static void getDeviceInfoPrivate(const QString &devName, int code, INFO *info, DWORD size, QUERY *query = NULL)
+    static QByteArray lookupIoctlResult(const QString &devName, int code, const QByteArray &query, int size);
+    static void cacheIoctlResult(const QString &devName, int code, const QByteArray &query, const QByteArray &result);
+
+    static HANDLE openDevice(QString &dev, DWORD flags)
     {
-        Q_ASSERT(!devName.isNull());
         wchar_t deviceNameBuffer[MAX_PATH];
-        QString dev = devName;
         if (!dev.startsWith(QLatin1String("\\"))) {
             dev = QLatin1String("\\\\?\\") + dev;
         }
         deviceNameBuffer[dev.toWCharArray(deviceNameBuffer)] = 0;
-        DWORD bytesReturned = 0;
 
         ulong err = NO_ERROR;
-        HANDLE handle = ::CreateFileW(deviceNameBuffer, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+        HANDLE handle = ::CreateFileW(deviceNameBuffer, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, flags, NULL);
         if (handle == INVALID_HANDLE_VALUE) {
             err = GetLastError();
             if (err == ERROR_ACCESS_DENIED) {
                 // we would need admin rights for GENERIC_READ on systenm drives and volumes
-                handle = ::CreateFileW(deviceNameBuffer, 0, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+                handle = ::CreateFileW(deviceNameBuffer, 0, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, flags, NULL);
                 err = GetLastError();
             }
             if (handle == INVALID_HANDLE_VALUE) {
                 qWarning() << "Invalid Handle" << dev << "reason:" << qGetLastError(err) << "this should not happen.";
-                return;
             }
         }
-        if (::DeviceIoControl(handle, code, query, sizeof(QUERY), info, size, &bytesReturned, NULL)) {
-            ::CloseHandle(handle);
-            return;
-        }
-
-        if (handle == INVALID_HANDLE_VALUE) {
-            qWarning() << "Invalid Handle" << devName << "reason:" << qGetLastError() << "is probaply a subst path or more seriously there is bug!";
-            return;
-        }
+        return handle;
+    }
 
-        err = GetLastError();
+    static void warnIoctlFailure(const QString &dev, ulong err)
+    {
         switch (err) {
         case ERROR_NOT_READY:
             // the drive is a cd drive with no disk
@@ -145,7 +214,69 @@ private:
             qWarning() << "Failed to query" << dev << "reason:" << qGetLastError(err);
             // DebugBreak();
         }
+    }
+
+    template<class INFO, class QUERY>
+    static void getDeviceInfoPrivate(const QString &devName, int code, INFO *info, DWORD size, QUERY *query = NULL)
+    {
+        Q_ASSERT(!devName.isNull());
+        QString dev = devName;
+        HANDLE handle = openDevice(dev, 0);
+        if (handle == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        DWORD bytesReturned = 0;
+        if (!::DeviceIoControl(handle, code, query, sizeof(QUERY), info, size, &bytesReturned, NULL)) {
+            warnIoctlFailure(dev, GetLastError());
+        }
+        ::CloseHandle(handle);
+    }
+
+    template<class INFO, class QUERY>
+    static bool getDeviceInfoOverlappedPrivate(const QString &devName, int code, INFO *info, DWORD size, QUERY *query, DWORD timeout)
+    {
+        Q_ASSERT(!devName.isNull());
+        QString dev = devName;
+        HANDLE handle = openDevice(dev, FILE_FLAG_OVERLAPPED);
+        if (handle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        OVERLAPPED overlapped;
+        ZeroMemory(&overlapped, sizeof(OVERLAPPED));
+        overlapped.hEvent = ::CreateEventW(NULL, TRUE, FALSE, NULL);
+        if (!overlapped.hEvent) {
+            qWarning() << "Failed to create completion event for" << dev << "reason:" << qGetLastError();
+            ::CloseHandle(handle);
+            return false;
+        }
+
+        DWORD bytesReturned = 0;
+        bool ok = ::DeviceIoControl(handle, code, query, sizeof(QUERY), info, size, &bytesReturned, &overlapped);
+        if (!ok) {
+            const ulong err = GetLastError();
+            if (err == ERROR_IO_PENDING) {
+                if (::WaitForSingleObject(overlapped.hEvent, timeout) == WAIT_OBJECT_0) {
+                    ok = ::GetOverlappedResult(handle, &overlapped, &bytesReturned, FALSE);
+                    if (!ok) {
+                        warnIoctlFailure(dev, GetLastError());
+                    }
+                } else {
+                    // the device didn't answer in time (a sleeping usb drive
+                    // spinning up, for example) - abort the request and make
+                    // sure it finished before the OVERLAPPED goes out of scope
+                    qWarning() << "Query" << dev << "timed out after" << timeout << "ms";
+                    ::CancelIoEx(handle, &overlapped);
+                    ::GetOverlappedResult(handle, &overlapped, &bytesReturned, TRUE);
+                }
+            } else {
+                warnIoctlFailure(dev, err);
+            }
+        }
+        ::CloseHandle(overlapped.hEvent);
         ::CloseHandle(handle);
+        return ok;
     }
 };
 
@@ -33,6 +33,8 @@ Q_SIGNALS:
 
 private:
     HWND m_windowID;
+    QList<HPOWERNOTIFY> m_powerNotifications;
+    HDEVNOTIFY m_batteryNotification;
 };
 }
 }
@@ -43,8 +43,8 @@ bool WinProcessor::canChangeFrequency() const
 
 Solid::Processor::InstructionSets WinProcessor::instructionSets() const
 {
-    static Solid::Processor::InstructionSets set = Solid::Backends::Shared::cpuFeatures();
-    return set;
+    // cpuFeatures() caches the detected mask process-wide
+    return Solid::Backends::Shared::cpuFeatures();
 }
 
 QSet<QString> WinProcessor::getUdis()
@@ -67,7 +67,9 @@ void WinStorageDrive::updateCache()
     } else {
         dev = QLatin1String("PhysicalDrive") + QString::number(deviceMajor());
     }
-    STORAGE_ADAPTER_DESCRIPTOR busInfo = WinDeviceManager::getDeviceInfo<STORAGE_ADAPTER_DESCRIPTOR>(dev, IOCTL_STORAGE_QUERY_PROPERTY, &storageProperty);
+    // all three queries below describe the hardware and can't change while
+    // the volume stays connected, so they are served from the result cache
+    STORAGE_ADAPTER_DESCRIPTOR busInfo = WinDeviceManager::getDeviceInfoCached<STORAGE_ADAPTER_DESCRIPTOR>(dev, IOCTL_STORAGE_QUERY_PROPERTY, &storageProperty);
 
     switch (busInfo.BusType) {
     case BusTypeUsb:
@@ -84,10 +86,10 @@ void WinStorageDrive::updateCache()
         m_bus = Solid::StorageDrive::Ide;
     }
 
-    DISK_GEOMETRY sizeInfo = WinDeviceManager::getDeviceInfo<DISK_GEOMETRY>(dev, IOCTL_DISK_GET_DRIVE_GEOMETRY);
+    DISK_GEOMETRY sizeInfo = WinDeviceManager::getDeviceInfoCached<DISK_GEOMETRY>(dev, IOCTL_DISK_GET_DRIVE_GEOMETRY);
     m_size = sizeInfo.Cylinders.QuadPart * sizeInfo.TracksPerCylinder * sizeInfo.SectorsPerTrack * sizeInfo.BytesPerSector;
 
-    STORAGE_HOTPLUG_INFO plugInfo = WinDeviceManager::getDeviceInfo<STORAGE_HOTPLUG_INFO>(dev, IOCTL_STORAGE_GET_HOTPLUG_INFO);
+    STORAGE_HOTPLUG_INFO plugInfo = WinDeviceManager::getDeviceInfoCached<STORAGE_HOTPLUG_INFO>(dev, IOCTL_STORAGE_GET_HOTPLUG_INFO);
     m_isHotplugges = plugInfo.DeviceHotplug;
     m_isRemovable = plugInfo.MediaRemovable;
 }
@@ -13,6 +13,8 @@
 
 #cmakedefine01 HAVE_GETMNTINFO
 
+#cmakedefine01 HAVE_SYS_SDT_H
+
 #cmakedefine01 HAVE_LIBMOUNT
 
 #cmakedefine01 GETMNTINFO_USES_STATVFS
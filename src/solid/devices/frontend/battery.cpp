@@ -9,6 +9,7 @@
 #include "battery.h"
 #include "battery_p.h"
 
+#include "device.h"
 #include "soliddefs_p.h"
 #include <solid/devices/ifaces/battery.h>
 
@@ -48,112 +49,133 @@ Solid::Battery::~Battery()
 {
 }
 
+Solid::Device Solid::Battery::displayBattery()
+{
+    /* UPower maintains this composite at a fixed path and keeps it around
+     * even with no battery present, so the device can be constructed
+     * directly without enumerating anything. On platforms where no backend
+     * claims the udi this simply yields an invalid device. */
+    return Device(QStringLiteral("/org/freedesktop/UPower/devices/DisplayDevice"));
+}
+
 bool Solid::Battery::isPresent() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), false, isPresent());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, false, isPresent());
 }
 
 Solid::Battery::BatteryType Solid::Battery::type() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), UnknownBattery, type());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, UnknownBattery, type());
 }
 
 int Solid::Battery::chargePercent() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 0, chargePercent());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 0, chargePercent());
 }
 
 int Solid::Battery::capacity() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 100, capacity());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 100, capacity());
 }
 
 bool Solid::Battery::isRechargeable() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), false, isRechargeable());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, false, isRechargeable());
 }
 
 bool Solid::Battery::isPowerSupply() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), true, isPowerSupply());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, true, isPowerSupply());
 }
 
 Solid::Battery::ChargeState Solid::Battery::chargeState() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), NoCharge, chargeState());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, NoCharge, chargeState());
 }
 
 qlonglong Solid::Battery::timeToEmpty() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 0, timeToEmpty());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 0, timeToEmpty());
 }
 
 qlonglong Solid::Battery::timeToFull() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 0, timeToFull());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 0, timeToFull());
 }
 
 Solid::Battery::Technology Solid::Battery::technology() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), UnknownTechnology, technology());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, UnknownTechnology, technology());
 }
 
 double Solid::Battery::energy() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 0.0, energy());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 0.0, energy());
 }
 
 double Solid::Battery::energyFull() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 0.0, energyFull());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 0.0, energyFull());
 }
 
 double Solid::Battery::energyFullDesign() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 0.0, energyFullDesign());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 0.0, energyFullDesign());
 }
 
 double Solid::Battery::energyRate() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 0.0, energyRate());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 0.0, energyRate());
 }
 
 double Solid::Battery::voltage() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 0.0, voltage());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 0.0, voltage());
 }
 
 double Solid::Battery::temperature() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), 0.0, temperature());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, 0.0, temperature());
 }
 
 QString Solid::Battery::serial() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), QString(), serial());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, QString(), serial());
 }
 
 qlonglong Solid::Battery::remainingTime() const
 {
     Q_D(const Battery);
-    return_SOLID_CALL(Ifaces::Battery *, d->backendObject(), -1, remainingTime());
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, -1, remainingTime());
+}
+
+QList<Solid::Battery::ChargeSample> Solid::Battery::chargeHistory(qlonglong maxAgeSeconds) const
+{
+    Q_D(const Battery);
+    return_SOLID_CACHED_CALL(Ifaces::Battery *, d, QList<ChargeSample>(), chargeHistory(maxAgeSeconds));
+}
+
+void Solid::Battery::setRefreshInterval(int msecs)
+{
+    Q_D(Battery);
+    SOLID_CALL(Ifaces::Battery *, d->backendObject(), setRefreshInterval(msecs));
 }
 
 #include "moc_battery.cpp"
@@ -13,6 +13,8 @@
 
 #include <solid/deviceinterface.h>
 
+#include <QList>
+
 namespace Solid
 {
 class BatteryPrivate;
@@ -100,6 +102,21 @@ public:
     enum ChargeState { NoCharge, Charging, Discharging, FullyCharged };
     Q_ENUM(ChargeState)
 
+    /**
+     * One point in the charge history of a battery.
+     *
+     * @see chargeHistory()
+     * @since 6.8
+     */
+    struct ChargeSample {
+        /** When the sample was taken, in milliseconds since the epoch. */
+        qint64 timestamp;
+        /** The charge level at that time, normalised to percent. */
+        int chargePercent;
+        /** The energy rate at that time in Watts, positive when discharging. */
+        double energyRate;
+    };
+
     /**
      * Technology used in the battery
      *
@@ -150,6 +167,21 @@ public:
         return DeviceInterface::Battery;
     }
 
+    /**
+     * Retrieves the composite battery of the system.
+     *
+     * This is the aggregate the power daemon computes over all batteries
+     * powering the system ("the battery percentage" a panel applet wants),
+     * handed out without enumerating and aggregating the individual
+     * devices. The returned device is invalid on platforms without such a
+     * composite; callers wanting per-battery detail should still list the
+     * Battery devices.
+     *
+     * @return the composite battery device, invalid if the platform has none
+     * @since 6.8
+     */
+    static Device displayBattery();
+
     /**
      * Indicates if this battery is currently present in its bay.
      *
@@ -294,6 +326,40 @@ public:
      */
     qlonglong remainingTime() const;
 
+    /**
+     * Retrieves the recorded charge history of the battery, oldest first.
+     *
+     * Backends that support history append a sample whenever a change event
+     * updates the charge level or energy rate, so graphing clients can fetch
+     * a window of samples in one call instead of polling the getters on a
+     * timer. The buffer is bounded; old samples fall off the far end.
+     *
+     * @param maxAgeSeconds only return samples at most this old, 0 for all
+     *                      retained samples
+     * @return the recorded samples, empty if the backend keeps no history
+     * @since 6.8
+     */
+    QList<ChargeSample> chargeHistory(qlonglong maxAgeSeconds = 0) const;
+
+    /**
+     * Requests throttled periodic refreshes of the battery state.
+     *
+     * The getters on this interface are served from a cache that the
+     * backend updates on change events, so calling them on a timer never
+     * triggers a backend round trip by itself. Backends whose data source
+     * does not push every change (for example sysfs attributes that update
+     * silently) can additionally re-read the state at the given interval,
+     * emitting the usual change signals when values moved.
+     *
+     * The interval is a lower bound: the backend may clamp it, and backends
+     * that already receive every change as an event ignore the request
+     * entirely. Pass 0 to disable periodic refreshes again.
+     *
+     * @param msecs minimum milliseconds between refreshes, 0 to disable
+     * @since 6.8
+     */
+    void setRefreshInterval(int msecs);
+
 Q_SIGNALS:
     /**
      * This signal is emitted if the battery gets plugged in/out of the
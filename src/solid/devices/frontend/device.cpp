@@ -10,7 +10,13 @@
 #include "devicenotifier.h"
 
 #include "deviceinterface_p.h"
+#include "devicequeryjob.h"
+#include "devices_debug.h"
 #include "soliddefs_p.h"
+#include "solidstatistics_p.h"
+
+#include <QEventLoop>
+#include <QTimer>
 
 #include <solid/devices/ifaces/device.h>
 
@@ -41,6 +47,8 @@
 
 Solid::Device::Device(const QString &udi)
 {
+    Stats::add(Stats::counters().deviceConstructions);
+
     DeviceManagerPrivate *manager = static_cast<DeviceManagerPrivate *>(Solid::DeviceNotifier::instance());
     d = manager->findRegisteredDevice(udi);
 }
@@ -116,9 +124,69 @@ QString Solid::Device::description() const
     return_SOLID_CALL(Ifaces::Device *, d->backendObject(), QString(), description());
 }
 
+Solid::DeviceQueryJob *Solid::Device::allDevicesAsync(QObject *parent)
+{
+    return new DeviceQueryJob(Predicate(), QString(), parent);
+}
+
+Solid::DeviceQueryJob *Solid::Device::listFromTypeAsync(const DeviceInterface::Type &type, const QString &parentUdi, QObject *parent)
+{
+    return new DeviceQueryJob(Predicate(type), parentUdi, parent);
+}
+
+Solid::DeviceQueryJob *Solid::Device::listFromQueryAsync(const Predicate &predicate, const QString &parentUdi, QObject *parent)
+{
+    return new DeviceQueryJob(predicate, parentUdi, parent);
+}
+
+QList<Solid::Device> Solid::Device::listFromQuery(const Predicate &predicate, const QString &parentUdi, int deadlineMsecs, DeviceQueryJob **continuation)
+{
+    if (continuation) {
+        *continuation = nullptr;
+    }
+
+    /* The query runs on the job's worker thread; waiting here with a local
+     * event loop keeps the queued result deliveries flowing while bounding
+     * how long a hung daemon can hold this caller. */
+    DeviceQueryJob *job = listFromQueryAsync(predicate, parentUdi);
+
+    QEventLoop loop;
+    QObject::connect(job, &DeviceQueryJob::finished, &loop, &QEventLoop::quit);
+    QTimer::singleShot(deadlineMsecs, &loop, &QEventLoop::quit);
+    loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+    if (job->isFinished()) {
+        // complete result; the job cleans itself up
+        return job->devices();
+    }
+
+    qCWarning(Solid::Frontend::DeviceManager::DEVICEMANAGER)
+        << "device query" << predicate.toString() << "missed its" << deadlineMsecs << "ms deadline; returning partial results";
+
+    const QList<Device> partial = job->devices();
+    if (continuation) {
+        /* hand the still-running job over; its devicesDiscovered() and
+         * finished() signals deliver whatever the stalled backend still
+         * produces, and it deletes itself afterwards as usual */
+        *continuation = job;
+    }
+    return partial;
+}
+
+QMap<QString, QVariant> Solid::Device::propertySnapshot() const
+{
+    const GenericInterface *generic = as<GenericInterface>();
+    return generic ? generic->allProperties() : QMap<QString, QVariant>();
+}
+
+void Solid::Device::preload()
+{
+    SOLID_CALL(Ifaces::Device *, d->backendObject(), preload());
+}
+
 bool Solid::Device::isDeviceInterface(const DeviceInterface::Type &type) const
 {
-    return_SOLID_CALL(Ifaces::Device *, d->backendObject(), false, queryDeviceInterface(type));
+    return d->hasInterface(type);
 }
 
 #define deviceinterface_cast(IfaceType, DevType, backendObject) (qobject_cast<IfaceType *>(backendObject) ? new DevType(backendObject) : nullptr)
@@ -209,6 +277,11 @@ Solid::DevicePrivate::DevicePrivate(const QString &udi)
 
 Solid::DevicePrivate::~DevicePrivate()
 {
+    /* tell the registry directly; one call here replaces the per-device
+     * destroyed() signal connection every registration used to set up */
+    if (m_resolver) {
+        m_resolver->deviceUnregistered(this);
+    }
     setBackendObject(nullptr);
 }
 
@@ -218,8 +291,28 @@ void Solid::DevicePrivate::_k_destroyed(QObject *object)
     setBackendObject(nullptr);
 }
 
+void Solid::DevicePrivate::setBackendResolver(DeviceManagerPrivate *manager)
+{
+    m_resolver = manager;
+    m_backendResolved = false;
+}
+
+void Solid::DevicePrivate::resolveBackendObject() const
+{
+    m_backendResolved = true;
+
+    if (!m_resolver) {
+        return;
+    }
+
+    auto *self = const_cast<DevicePrivate *>(this);
+    self->setBackendObject(m_resolver->createBackendObject(m_udi));
+}
+
 void Solid::DevicePrivate::setBackendObject(Ifaces::Device *object)
 {
+    m_backendResolved = true;
+
     if (m_backendObject) {
         m_backendObject.data()->disconnect(this);
     }
@@ -231,10 +324,21 @@ void Solid::DevicePrivate::setBackendObject(Ifaces::Device *object)
         connect(object, SIGNAL(destroyed(QObject *)), this, SLOT(_k_destroyed(QObject *)));
     }
 
-    if (!m_ifaces.isEmpty()) {
-        qDeleteAll(m_ifaces);
+    resetInterfaceCache();
+}
+
+void Solid::DevicePrivate::resetInterfaceCache()
+{
+    m_ifaceKnownMask = 0;
+    m_ifacePresentMask = 0;
+
+    if (m_hasIfaces) {
+        for (const QPointer<DeviceInterface> &iface : m_ifaces) {
+            delete iface.data();
+        }
 
-        m_ifaces.clear();
+        m_ifaces.fill(nullptr);
+        m_hasIfaces = false;
         if (!ref.deref()) {
             deleteLater();
         }
@@ -243,15 +347,47 @@ void Solid::DevicePrivate::setBackendObject(Ifaces::Device *object)
 
 Solid::DeviceInterface *Solid::DevicePrivate::interface(const DeviceInterface::Type &type) const
 {
+    if (type < 0 || type >= kInterfaceSlots) {
+        return nullptr;
+    }
     return m_ifaces[type];
 }
 
 void Solid::DevicePrivate::setInterface(const DeviceInterface::Type &type, DeviceInterface *interface)
 {
-    if (m_ifaces.isEmpty()) {
+    if (type < 0 || type >= kInterfaceSlots) {
+        return;
+    }
+    if (!m_hasIfaces) {
         ref.ref();
+        m_hasIfaces = true;
     }
     m_ifaces[type] = interface;
 }
 
+bool Solid::DevicePrivate::hasInterface(const DeviceInterface::Type &type) const
+{
+    if (type < 0 || type >= kInterfaceSlots) {
+        return false;
+    }
+
+    const quint32 bit = 1u << type;
+    if (m_ifaceKnownMask & bit) {
+        return (m_ifacePresentMask & bit) != 0;
+    }
+
+    Ifaces::Device *device = qobject_cast<Ifaces::Device *>(backendObject());
+    if (device == nullptr) {
+        // not cached: an invalid device can become valid on hotplug
+        return false;
+    }
+
+    m_ifaceKnownMask |= bit;
+    if (device->queryDeviceInterface(type)) {
+        m_ifacePresentMask |= bit;
+    }
+
+    return (m_ifacePresentMask & bit) != 0;
+}
+
 #include "moc_device_p.cpp"
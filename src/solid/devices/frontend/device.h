@@ -8,7 +8,11 @@
 #define SOLID_DEVICE_H
 
 #include <QList>
+#include <QMap>
 #include <QSharedData>
+#include <QVariant>
+
+#include <functional>
 
 #include <solid/solid_export.h>
 
@@ -17,6 +21,7 @@
 namespace Solid
 {
 class DevicePrivate;
+class DeviceQueryJob;
 
 /**
  * @class Solid::Device device.h <Solid/Device>
@@ -74,6 +79,175 @@ public:
      */
     static QList<Device> listFromQuery(const QString &predicate, const QString &parentUdi = QString());
 
+    /**
+     * Deadline-bounded variant of listFromQuery().
+     *
+     * The query runs on a worker thread while the caller waits at most
+     * @p deadlineMsecs (input events excluded). If every backend answered
+     * in time the complete result is returned as usual. If not — a hung
+     * udisksd, an fstab cache stuck on a dead NFS server — the devices
+     * found so far are returned, the stall is logged, and when
+     * @p continuation is non-null it receives the still-running job so the
+     * caller can collect the stragglers through its devicesDiscovered()
+     * and finished() signals. Callers that pass no continuation simply
+     * never see the slow backend's devices in this query.
+     *
+     * @param predicate Predicate that the devices we're searching for must verify
+     * @param parentUdi UDI of the parent of the devices we're searching for, or QString()
+     * if there's no constraint on the parent
+     * @param deadlineMsecs how long to wait for the backends, in milliseconds
+     * @param continuation receives the still-running job when the deadline
+     * was missed, nullptr when the result is complete; may itself be null
+     * @return the matching devices found within the deadline
+     * @since 6.8
+     * @see DeviceQueryJob
+     */
+    static QList<Device> listFromQuery(const Predicate &predicate, const QString &parentUdi, int deadlineMsecs, DeviceQueryJob **continuation = nullptr);
+
+    /**
+     * Evaluates several predicates in a single enumeration pass.
+     *
+     * Equivalent to calling listFromQuery() once per predicate, but the
+     * backends are enumerated only once and every candidate device is
+     * constructed once and matched against all predicates — clients like
+     * device notifiers that issue a handful of queries at startup pay one
+     * enumeration instead of one per query.
+     *
+     * @param predicates the predicates to evaluate
+     * @param parentUdi UDI of the parent of the devices we're searching for, or QString()
+     * if there's no constraint on the parent
+     * @return one result list per predicate, in the same order
+     * @since 6.8
+     * @see listFromQuery()
+     */
+    static QList<QList<Device>> listFromQueries(const QList<Predicate> &predicates, const QString &parentUdi = QString());
+
+    /**
+     * Convenience function see above; predicates that do not parse yield
+     * an empty result list, as with the string overload of listFromQuery().
+     *
+     * @param predicates
+     * @param parentUdi
+     * @return one result list per predicate, in the same order
+     * @since 6.8
+     */
+    static QList<QList<Device>> listFromQueries(const QStringList &predicates, const QString &parentUdi = QString());
+
+    /**
+     * Invokes @p visitor for each device matching the given constraints,
+     * in the order listFromQuery() would return them.
+     *
+     * Unlike listFromQuery() no result list is materialized, and the
+     * visitor can stop the iteration early by returning false — useful
+     * when only the first match or a running aggregate is needed.
+     *
+     * @param predicate Predicate that the devices we're searching for must verify
+     * @param parentUdi UDI of the parent of the devices we're searching for, or QString()
+     * if there's no constraint on the parent
+     * @param visitor callable invoked per matching device; return true to
+     * continue the iteration, false to stop
+     * @since 6.8
+     * @see Solid::Predicate
+     */
+    static void forEachFromQuery(const Predicate &predicate, const QString &parentUdi, const std::function<bool(const Device &)> &visitor);
+
+    /**
+     * Counts the devices matching the given constraints.
+     *
+     * Cheaper than sizing a listFromQuery() result: no result list is
+     * materialized, and a bare interface check like `IS Battery` is
+     * answered by the backends' own device counts without constructing a
+     * single device.
+     *
+     * @param predicate Predicate that the counted devices must verify
+     * @param parentUdi UDI of the parent of the devices we're counting, or QString()
+     * if there's no constraint on the parent
+     * @return the number of matching devices
+     * @since 6.8
+     * @see anyFromQuery()
+     */
+    static qsizetype countFromQuery(const Predicate &predicate, const QString &parentUdi = QString());
+
+    /**
+     * Convenience function see above.
+     *
+     * @param predicate
+     * @param parentUdi
+     * @return the number of matching devices, 0 if @p predicate doesn't parse
+     * @since 6.8
+     */
+    static qsizetype countFromQuery(const QString &predicate, const QString &parentUdi = QString());
+
+    /**
+     * Tells whether any device matches the given constraints.
+     *
+     * Stops at the first match, so "is there a battery at all?" style
+     * checks don't pay for enumerating or constructing every match the
+     * way counting a listFromQuery() result would.
+     *
+     * @param predicate Predicate that a device must verify
+     * @param parentUdi UDI of the parent of the devices we're probing, or QString()
+     * if there's no constraint on the parent
+     * @return true if at least one device matches
+     * @since 6.8
+     * @see countFromQuery()
+     */
+    static bool anyFromQuery(const Predicate &predicate, const QString &parentUdi = QString());
+
+    /**
+     * Convenience function see above.
+     *
+     * @param predicate
+     * @param parentUdi
+     * @return true if at least one device matches, false if @p predicate doesn't parse
+     * @since 6.8
+     */
+    static bool anyFromQuery(const QString &predicate, const QString &parentUdi = QString());
+
+    /**
+     * Retrieves all the devices available in the underlying system, without
+     * blocking the caller's event loop.
+     *
+     * The enumeration runs in a worker thread; results are delivered
+     * incrementally through the returned job's signals.
+     *
+     * @param parent the parent of the returned job
+     * @return the started query job
+     * @since 6.8
+     * @see DeviceQueryJob
+     */
+    static DeviceQueryJob *allDevicesAsync(QObject *parent = nullptr);
+
+    /**
+     * The asynchronous counterpart of listFromType(); the backend
+     * enumeration runs in a worker thread and results are delivered
+     * incrementally through the returned job's signals.
+     *
+     * @param type device interface type available on the devices we're looking for
+     * @param parentUdi UDI of the parent of the devices we're searching for, or QString()
+     * if there's no constraint on the parent
+     * @param parent the parent of the returned job
+     * @return the started query job
+     * @since 6.8
+     * @see DeviceQueryJob
+     */
+    static DeviceQueryJob *listFromTypeAsync(const DeviceInterface::Type &type, const QString &parentUdi = QString(), QObject *parent = nullptr);
+
+    /**
+     * The asynchronous counterpart of listFromQuery(); the backend
+     * enumeration runs in a worker thread and results are delivered
+     * incrementally through the returned job's signals.
+     *
+     * @param predicate Predicate that the devices we're searching for must verify
+     * @param parentUdi UDI of the parent of the devices we're searching for, or QString()
+     * if there's no constraint on the parent
+     * @param parent the parent of the returned job
+     * @return the started query job
+     * @since 6.8
+     * @see DeviceQueryJob
+     */
+    static DeviceQueryJob *listFromQueryAsync(const Predicate &predicate, const QString &parentUdi = QString(), QObject *parent = nullptr);
+
     /**
      * Returns the Device containing the filesystem for the given path
      *
@@ -86,6 +260,20 @@ public:
      */
     static Device storageAccessFromPath(const QString &path);
 
+    /**
+     * Returns the Device backing the given device node.
+     *
+     * Backends with a native lookup resolve the node directly (the udev
+     * backend via a devnum query, UDisks2 via its object path mapping);
+     * only when none of them can answer is the block device list scanned.
+     *
+     * @param deviceFile absolute path of a device node, e.g. /dev/sdb1
+     * @return the Device backing the node, or an invalid Device
+     * @since 6.8
+     * @see Solid::Block
+     */
+    static Device fromDeviceFile(const QString &deviceFile);
+
     /**
      * Constructs a device for a given Universal Device Identifier (UDI).
      *
@@ -199,6 +387,35 @@ public:
      */
     QString description() const;
 
+    /**
+     * Captures all properties of the device in one pass.
+     *
+     * Reading properties one by one can interleave with backend updates;
+     * the returned map is taken from the backend cache in a single pass
+     * and, being implicitly shared, stays immutable in the caller's hands,
+     * so bulk consumers read consistent data with one fetch instead of N.
+     *
+     * @return the device properties, or an empty map for devices without
+     * a generic interface
+     * @since 6.8
+     */
+    QMap<QString, QVariant> propertySnapshot() const;
+
+    /**
+     * Asks the backend to prefetch, in one batched operation, the data
+     * behind the usual display accessors (vendor(), product(), icon(),
+     * description(), the device interface properties).
+     *
+     * Without it each accessor can trigger a separate fetch from the
+     * underlying system; calling preload() first lets backends with a
+     * property cache fill it in a single round trip per device, which is
+     * worthwhile before rendering a device list. Backends without such a
+     * cache ignore the call.
+     *
+     * @since 6.8
+     */
+    void preload();
+
     /**
      * Tests if a device interface is available from the device.
      *
@@ -7,11 +7,12 @@
 #ifndef SOLID_DEVICE_P_H
 #define SOLID_DEVICE_P_H
 
-#include <QMap>
 #include <QObject>
 #include <QPointer>
 #include <QSharedData>
 
+#include <array>
+
 #include <ifaces/device.h>
 
 #if defined(Q_OS_WIN32)
@@ -20,6 +21,8 @@
 
 namespace Solid
 {
+class DeviceManagerPrivate;
+
 class DevicePrivate : public QObject, public QSharedData
 {
     Q_OBJECT
@@ -34,20 +37,56 @@ public:
 
     Ifaces::Device *backendObject() const
     {
+        if (!m_backendObject && !m_backendResolved) {
+            resolveBackendObject();
+        }
         return m_backendObject.data();
     }
     void setBackendObject(Ifaces::Device *object);
 
+    /**
+     * Defers backend object creation to the first backendObject() call.
+     * Devices that are only constructed to carry a UDI around then never
+     * pay for the backend instantiation (D-Bus matches, introspection...).
+     */
+    void setBackendResolver(DeviceManagerPrivate *manager);
+
     DeviceInterface *interface(const DeviceInterface::Type &type) const;
     void setInterface(const DeviceInterface::Type &type, DeviceInterface *interface);
 
+    /**
+     * Tells whether the device provides the given interface, caching the
+     * backend's answer in a bitmask; predicate interface checks repeat per
+     * term per device and reduce to a bit test this way.
+     */
+    bool hasInterface(const DeviceInterface::Type &type) const;
+
+    /**
+     * Drops the cached interface wrappers and capability answers while
+     * keeping the backend object; used when a device changes its interface
+     * composition in place instead of going through a remove/re-add cycle.
+     */
+    void resetInterfaceCache();
+
 public Q_SLOTS:
     void _k_destroyed(QObject *object);
 
 private:
+    void resolveBackendObject() const;
+
+    // DeviceInterface::Type values are small and dense (Last is a
+    // sentinel), so the per-type interface cache is a flat array instead
+    // of an associative container
+    static constexpr int kInterfaceSlots = DeviceInterface::NetworkShare + 1;
+
     QString m_udi;
     QPointer<Ifaces::Device> m_backendObject;
-    QMap<DeviceInterface::Type, QPointer<DeviceInterface>> m_ifaces;
+    std::array<QPointer<DeviceInterface>, kInterfaceSlots> m_ifaces;
+    bool m_hasIfaces = false;
+    mutable quint32 m_ifaceKnownMask = 0;
+    mutable quint32 m_ifacePresentMask = 0;
+    QPointer<DeviceManagerPrivate> m_resolver;
+    mutable bool m_backendResolved = false;
 };
 }
 
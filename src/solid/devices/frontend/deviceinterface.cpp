@@ -9,7 +9,34 @@
 
 #include <solid/devices/ifaces/deviceinterface.h>
 
-#include <QMetaEnum>
+// Type <-> name conversions sit on hot paths (predicate parsing and
+// serialization, solid-hardware output), so they use this table instead of
+// QMetaEnum reflection. It must stay in sync with the Type enum; the names
+// are the enumerator keys, as QMetaEnum used to return them.
+namespace
+{
+struct TypeName {
+    Solid::DeviceInterface::Type type;
+    QLatin1String name;
+};
+
+constexpr TypeName s_typeNames[] = {
+    {Solid::DeviceInterface::Unknown, QLatin1String("Unknown")},
+    {Solid::DeviceInterface::GenericInterface, QLatin1String("GenericInterface")},
+    {Solid::DeviceInterface::Processor, QLatin1String("Processor")},
+    {Solid::DeviceInterface::Block, QLatin1String("Block")},
+    {Solid::DeviceInterface::StorageAccess, QLatin1String("StorageAccess")},
+    {Solid::DeviceInterface::StorageDrive, QLatin1String("StorageDrive")},
+    {Solid::DeviceInterface::OpticalDrive, QLatin1String("OpticalDrive")},
+    {Solid::DeviceInterface::StorageVolume, QLatin1String("StorageVolume")},
+    {Solid::DeviceInterface::OpticalDisc, QLatin1String("OpticalDisc")},
+    {Solid::DeviceInterface::Camera, QLatin1String("Camera")},
+    {Solid::DeviceInterface::PortableMediaPlayer, QLatin1String("PortableMediaPlayer")},
+    {Solid::DeviceInterface::Battery, QLatin1String("Battery")},
+    {Solid::DeviceInterface::NetworkShare, QLatin1String("NetworkShare")},
+    {Solid::DeviceInterface::Last, QLatin1String("Last")},
+};
+}
 
 Solid::DeviceInterface::DeviceInterface(DeviceInterfacePrivate &dd, QObject *backendObject)
     : d_ptr(&dd)
@@ -34,16 +61,27 @@ bool Solid::DeviceInterface::isValid() const
 
 QString Solid::DeviceInterface::typeToString(Type type)
 {
-    int index = staticMetaObject.indexOfEnumerator("Type");
-    QMetaEnum metaEnum = staticMetaObject.enumerator(index);
-    return QString::fromLatin1(metaEnum.valueToKey((int)type));
+    return QString(typeToLatin1(type));
+}
+
+QLatin1String Solid::DeviceInterface::typeToLatin1(Type type)
+{
+    for (const auto &entry : s_typeNames) {
+        if (entry.type == type) {
+            return entry.name;
+        }
+    }
+    return QLatin1String();
 }
 
 Solid::DeviceInterface::Type Solid::DeviceInterface::stringToType(const QString &type)
 {
-    int index = staticMetaObject.indexOfEnumerator("Type");
-    QMetaEnum metaEnum = staticMetaObject.enumerator(index);
-    return (Type)metaEnum.keyToValue(type.toUtf8().constData());
+    for (const auto &entry : s_typeNames) {
+        if (type == entry.name) {
+            return entry.type;
+        }
+    }
+    return (Type)(-1);
 }
 
 QString Solid::DeviceInterface::typeDescription(Type type)
@@ -98,6 +136,9 @@ QObject *Solid::DeviceInterfacePrivate::backendObject() const
 void Solid::DeviceInterfacePrivate::setBackendObject(QObject *object)
 {
     m_backendObject = object;
+    // a replacement can reuse the old object's address; drop the cast memo
+    m_castedObject = nullptr;
+    m_castedIface = nullptr;
 }
 
 Solid::DevicePrivate *Solid::DeviceInterfacePrivate::devicePrivate() const
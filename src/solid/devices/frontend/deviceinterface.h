@@ -84,6 +84,15 @@ public:
      */
     static QString typeToString(Type type);
 
+    /**
+     * Same as typeToString(), but without constructing a QString; handy
+     * on hot paths like serializing predicates or formatting tool output.
+     *
+     * @return the class name of the device interface type
+     * @since 6.8
+     */
+    static QLatin1String typeToLatin1(Type type);
+
     /**
      *
      * @return the device interface type for the given class name
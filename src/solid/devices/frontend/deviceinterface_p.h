@@ -24,9 +24,33 @@ public:
     DevicePrivate *devicePrivate() const;
     void setDevicePrivate(DevicePrivate *devicePrivate);
 
+    /* Memoized qobject_cast of the backend object. The getters of the
+     * frontend interfaces cast on every call, and qobject_cast walks the
+     * meta-object chain each time; a given interface instance always casts
+     * to the same target type, so the result is remembered until the
+     * backend object changes. T is the interface pointer type.
+     *
+     * The memo is keyed by the QPointer-tracked object address, which goes
+     * null when the backend dies; replacement through setBackendObject()
+     * resets it explicitly. */
+    template<typename T>
+    T backendIface() const
+    {
+        QObject *object = backendObject();
+        if (object != m_castedObject) {
+            m_castedObject = object;
+            m_castedIface = qobject_cast<T>(object);
+        }
+        return static_cast<T>(m_castedIface);
+    }
+
 private:
     QPointer<QObject> m_backendObject;
     DevicePrivate *m_devicePrivate;
+    mutable QObject *m_castedObject = nullptr;
+    /* void: the interface classes are not QObject-derived, the cast
+     * result is an adjusted pointer into the backend object */
+    mutable void *m_castedIface = nullptr;
 };
 }
 
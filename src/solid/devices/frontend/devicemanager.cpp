@@ -7,9 +7,11 @@
 #include "devicemanager_p.h" //krazy:exclude=includes (devicenotifier.h is the header file for this class)
 #include "devicenotifier.h"
 
+#include "block.h"
 #include "device.h"
 #include "device_p.h"
 #include "devices_debug.h"
+#include "devicesubscription.h"
 #include "predicate.h"
 #include "storageaccess.h"
 #include "storagevolume.h"
@@ -18,34 +20,86 @@
 #include "ifaces/devicemanager.h"
 
 #include "soliddefs_p.h"
+#include "solidstatistics_p.h"
+#include "solidtrace_p.h"
+#include "udistringpool_p.h"
 
+#include <QElapsedTimer>
 #include <QLoggingCategory>
+#include <QMetaMethod>
+#include <QMutex>
 
+#include <algorithm>
 #include <set>
 
 Q_GLOBAL_STATIC(Solid::DeviceManagerStorage, globalDeviceStorage)
 
+/* Window over which added/removed events are coalesced into the batched
+ * devicesAdded/devicesRemoved signals. Long enough to cover a USB hub
+ * settling, short enough to stay unnoticeable in the UI. */
+static const int kBatchWindowMsecs = 50;
+
+/* An enumeration slower than this is logged as a stall; it names the
+ * daemon a deadline-bounded query ends up waiting on. */
+static const int kSlowBackendWarnMsecs = 1000;
+
 Solid::DeviceManagerPrivate::DeviceManagerPrivate()
     : m_nullDevice(new DevicePrivate(QString()))
 {
+    Stats::maybeInstallProfileReporter();
+
     loadBackends();
 
-    const auto backends = managerBackends();
-    for (const auto &backend : backends) {
-        connect(backend, &Solid::Ifaces::DeviceManager::deviceAdded, this, &Solid::DeviceManagerPrivate::_k_deviceAdded);
-        connect(backend, &Solid::Ifaces::DeviceManager::deviceRemoved, this, &Solid::DeviceManagerPrivate::_k_deviceRemoved);
+    m_batchTimer.setSingleShot(true);
+    m_batchTimer.setInterval(kBatchWindowMsecs);
+    connect(&m_batchTimer, &QTimer::timeout, this, &Solid::DeviceManagerPrivate::_k_emitBatches);
+
+}
+
+/* Runs under the backends mutex, both for backends materialized after this
+ * manager registered and as replays from loadBackends() for those that
+ * already existed. */
+void Solid::DeviceManagerPrivate::backendInstantiated(Ifaces::DeviceManager *backend)
+{
+    connect(backend, &Solid::Ifaces::DeviceManager::deviceAdded, this, &Solid::DeviceManagerPrivate::_k_deviceAdded);
+    connect(backend, &Solid::Ifaces::DeviceManager::deviceRemoved, this, &Solid::DeviceManagerPrivate::_k_deviceRemoved);
+    connect(backend, &Solid::Ifaces::DeviceManager::deviceInterfacesChanged, this, &Solid::DeviceManagerPrivate::_k_deviceInterfacesChanged);
+    connect(backend, &Solid::Ifaces::DeviceManager::deviceChanged, this, &Solid::DeviceManagerPrivate::_k_deviceChanged);
+
+    // the supported interfaces of a backend never change; precompute
+    // the dispatch mask once
+    const QSet<DeviceInterface::Type> supportedTypes = backend->supportedInterfaces();
+    quint32 mask = 0;
+    for (DeviceInterface::Type type : supportedTypes) {
+        mask |= 1u << type;
     }
+    m_backendTypeMasks.insert(backend, mask);
+}
+
+quint32 Solid::DeviceManagerPrivate::backendTypeMask(Ifaces::DeviceManager *backend) const
+{
+    return m_backendTypeMasks.value(backend);
 }
 
 Solid::DeviceManagerPrivate::~DeviceManagerPrivate()
 {
-    const auto backends = managerBackends();
+    // give back the change subscription held for our receivers, if any
+    if (m_monitoringSubscribed) {
+        removeChangeSubscriber();
+    }
+
+    // release the Device handles before the registry teardown below
+    m_mountIndex.clear();
+
+    const auto backends = instantiatedBackends();
     for (const auto &backend : backends) {
         disconnect(backend, &Solid::Ifaces::DeviceManager::deviceAdded, this, &Solid::DeviceManagerPrivate::_k_deviceAdded);
         disconnect(backend, &Solid::Ifaces::DeviceManager::deviceRemoved, this, &Solid::DeviceManagerPrivate::_k_deviceRemoved);
+        disconnect(backend, &Solid::Ifaces::DeviceManager::deviceInterfacesChanged, this, &Solid::DeviceManagerPrivate::_k_deviceInterfacesChanged);
+        disconnect(backend, &Solid::Ifaces::DeviceManager::deviceChanged, this, &Solid::DeviceManagerPrivate::_k_deviceChanged);
     }
 
-    // take a copy as m_devicesMap is changed by Solid::DeviceManagerPrivate::_k_destroyed
+    // take a copy as m_devicesMap is changed by Solid::DeviceManagerPrivate::deviceUnregistered
     const auto deviceMap = m_devicesMap;
     for (QPointer<DevicePrivate> dev : deviceMap) {
         if (!dev.data()->ref.deref()) {
@@ -58,17 +112,32 @@ Solid::DeviceManagerPrivate::~DeviceManagerPrivate()
 
 QList<Solid::Device> Solid::Device::allDevices()
 {
-    QList<Device> list;
-    const auto backends = globalDeviceStorage->managerBackends();
+    QStringList udis;
 
-    for (const auto &backend : backends) {
-        const auto udis = backend->allDevices();
-        for (const auto &udi : udis) {
-            list.append(Device(udi));
+    {
+        QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+        const auto backends = globalDeviceStorage->managerBackends();
+
+        // let request/reply backends fire their enumeration calls
+        // concurrently before we start collecting the answers
+        for (const auto &backend : backends) {
+            backend->beginEnumeration();
+        }
+
+        const bool trace = ManagerBasePrivate::startupTraceEnabled();
+        for (const auto &backend : backends) {
+            QElapsedTimer enumTimer;
+            if (trace) {
+                enumTimer.start();
+            }
+            udis += backend->allDevices();
+            if (trace) {
+                ManagerBasePrivate::noteFirstEnumeration(backend, enumTimer.nsecsElapsed());
+            }
         }
     }
 
-    return list;
+    return globalDeviceStorage->deviceManager()->findRegisteredDevices(udis);
 }
 
 QList<Solid::Device> Solid::Device::listFromQuery(const QString &predicate, const QString &parentUdi)
@@ -85,13 +154,20 @@ QList<Solid::Device> Solid::Device::listFromQuery(const QString &predicate, cons
 QList<Solid::Device> Solid::Device::listFromType(const DeviceInterface::Type &type, const QString &parentUdi)
 {
     QList<Device> list;
-    const auto backends = globalDeviceStorage->managerBackends();
 
-    for (const auto &backend : backends) {
-        if (!backend->supportedInterfaces().contains(type)) {
-            continue;
-        }
+    // Queries without a parent filter are served from the incrementally
+    // maintained type index instead of re-enumerating the backends.
+    if (parentUdi.isEmpty()) {
+        auto *manager = globalDeviceStorage->deviceManager();
+        return manager->findRegisteredDevices(manager->udisFromType(type));
+    }
+
+    QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+    // only the backends whose static type table covers the query get
+    // instantiated
+    const auto backends = globalDeviceStorage->deviceManager()->managerBackends({type});
 
+    for (const auto &backend : backends) {
         const auto udis = backend->devicesFromQuery(parentUdi, type);
         for (const auto &udi : udis) {
             list.append(Device(udi));
@@ -101,28 +177,51 @@ QList<Solid::Device> Solid::Device::listFromType(const DeviceInterface::Type &ty
     return list;
 }
 
-QList<Solid::Device> Solid::Device::listFromQuery(const Predicate &predicate, const QString &parentUdi)
+void Solid::Device::forEachFromQuery(const Predicate &predicate, const QString &parentUdi, const std::function<bool(const Device &)> &visitor)
 {
-    QList<Device> list;
+    auto *manager = globalDeviceStorage->deviceManager();
+    QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+
+    Stats::add(Stats::counters().queries);
+
+    quint32 predicateMask = 0;
     const auto usedTypes = predicate.usedTypes();
-    const auto backends = globalDeviceStorage->managerBackends();
+    for (DeviceInterface::Type type : usedTypes) {
+        predicateMask |= 1u << type;
+    }
+
+    /* A valid predicate names the interface types it can match, so only the
+     * backends whose static type table intersects them are instantiated. */
+    const auto backends = predicate.isValid() ? manager->managerBackends(usedTypes) : manager->managerBackends();
 
+    for (const auto &backend : backends) {
+        backend->beginEnumeration();
+    }
+
+    const bool trace = ManagerBasePrivate::startupTraceEnabled();
     for (const auto &backend : backends) {
         QStringList udis;
+        QElapsedTimer enumTimer;
+        enumTimer.start();
         if (predicate.isValid()) {
-            auto supportedTypes = backend->supportedInterfaces();
-            if (supportedTypes.intersect(usedTypes).isEmpty()) {
+            if (!(manager->backendTypeMask(backend) & predicateMask)) {
                 continue;
             }
 
-            auto sortedTypes = supportedTypes.values();
-            std::sort(sortedTypes.begin(), sortedTypes.end());
-            for (const auto &type : std::as_const(sortedTypes)) {
-                udis += backend->devicesFromQuery(parentUdi, type);
-            }
+            // backends able to translate the constraints natively return a
+            // narrowed candidate set; the matches() call below stays as the
+            // authoritative filter
+            udis += backend->devicesFromQuery(parentUdi, predicate);
         } else {
             udis += backend->allDevices();
         }
+        if (trace) {
+            ManagerBasePrivate::noteFirstEnumeration(backend, enumTimer.nsecsElapsed());
+        }
+        if (enumTimer.elapsed() >= kSlowBackendWarnMsecs) {
+            qCWarning(Solid::Frontend::DeviceManager::DEVICEMANAGER)
+                << "backend" << backend->udiPrefix() << "took" << enumTimer.elapsed() << "ms to enumerate";
+        }
 
         std::set<QString> seen;
         for (const auto &udi : std::as_const(udis)) {
@@ -140,42 +239,407 @@ QList<Solid::Device> Solid::Device::listFromQuery(const Predicate &predicate, co
                 matches = predicate.matches(dev);
             }
 
-            if (matches) {
-                list.append(dev);
+            if (matches && !visitor(dev)) {
+                return;
+            }
+        }
+    }
+}
+
+QStringList Solid::DeviceManagerPrivate::candidateUdisFromQuery(const Predicate &predicate, const QString &parentUdi)
+{
+    auto *manager = globalDeviceStorage->deviceManager();
+    QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+
+    Stats::add(Stats::counters().queries);
+
+    quint32 predicateMask = 0;
+    const auto usedTypes = predicate.usedTypes();
+    for (DeviceInterface::Type type : usedTypes) {
+        predicateMask |= 1u << type;
+    }
+
+    const auto backends = predicate.isValid() ? manager->managerBackends(usedTypes) : manager->managerBackends();
+
+    for (const auto &backend : backends) {
+        backend->beginEnumeration();
+    }
+
+    QStringList candidates;
+    for (const auto &backend : backends) {
+        if (predicate.isValid() && !(manager->backendTypeMask(backend) & predicateMask)) {
+            continue;
+        }
+
+        const QStringList udis = predicate.isValid() ? backend->devicesFromQuery(parentUdi, predicate) : backend->allDevices();
+
+        std::set<QString> seen;
+        for (const auto &udi : udis) {
+            if (seen.insert(udi).second) {
+                candidates.append(udi);
             }
         }
     }
 
+    return candidates;
+}
+
+QList<Solid::Device> Solid::Device::listFromQuery(const Predicate &predicate, const QString &parentUdi)
+{
+    auto *manager = globalDeviceStorage->deviceManager();
+    const QString predicateString = predicate.toString();
+
+    QList<Device> list;
+
+    // clients like device notifiers re-issue the same query while nothing
+    // changed; serve those straight from the memoized UDI list
+    if (const QStringList *cached = manager->cachedQuery(predicateString, parentUdi)) {
+        Stats::add(Stats::counters().queries);
+        Stats::add(Stats::counters().queryCacheHits);
+        return manager->findRegisteredDevices(*cached);
+    }
+
+    forEachFromQuery(predicate, parentUdi, [&list](const Device &device) {
+        list.append(device);
+        return true;
+    });
+
+    QStringList udis;
+    udis.reserve(list.size());
+    for (const Device &device : std::as_const(list)) {
+        udis.append(device.udi());
+    }
+    manager->storeQueryResult(predicateString, parentUdi, udis);
+
     return list;
 }
 
+qsizetype Solid::Device::countFromQuery(const Predicate &predicate, const QString &parentUdi)
+{
+    // a bare interface check is answered by the backends' own counts,
+    // without constructing a single frontend device
+    if (predicate.isValid() && predicate.type() == Predicate::InterfaceCheck) {
+        auto *manager = globalDeviceStorage->deviceManager();
+        QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+        Stats::add(Stats::counters().queries);
+
+        qsizetype total = 0;
+        const auto backends = manager->managerBackends({predicate.interfaceType()});
+        for (const auto &backend : backends) {
+            total += backend->countFromQuery(parentUdi, predicate.interfaceType());
+        }
+        return total;
+    }
+
+    qsizetype count = 0;
+    forEachFromQuery(predicate, parentUdi, [&count](const Device &) {
+        ++count;
+        return true;
+    });
+    return count;
+}
+
+qsizetype Solid::Device::countFromQuery(const QString &predicate, const QString &parentUdi)
+{
+    const Predicate p = Predicate::fromString(predicate);
+    return p.isValid() ? countFromQuery(p, parentUdi) : 0;
+}
+
+bool Solid::Device::anyFromQuery(const Predicate &predicate, const QString &parentUdi)
+{
+    if (predicate.isValid() && predicate.type() == Predicate::InterfaceCheck) {
+        auto *manager = globalDeviceStorage->deviceManager();
+        QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+        Stats::add(Stats::counters().queries);
+
+        const auto backends = manager->managerBackends({predicate.interfaceType()});
+        for (const auto &backend : backends) {
+            if (backend->countFromQuery(parentUdi, predicate.interfaceType()) > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool any = false;
+    forEachFromQuery(predicate, parentUdi, [&any](const Device &) {
+        any = true;
+        return false;
+    });
+    return any;
+}
+
+bool Solid::Device::anyFromQuery(const QString &predicate, const QString &parentUdi)
+{
+    const Predicate p = Predicate::fromString(predicate);
+    return p.isValid() && anyFromQuery(p, parentUdi);
+}
+
+QList<QList<Solid::Device>> Solid::Device::listFromQueries(const QList<Predicate> &predicates, const QString &parentUdi)
+{
+    auto *manager = globalDeviceStorage->deviceManager();
+
+    QList<QList<Device>> results;
+    results.resize(predicates.size());
+
+    // serve what the memoized query cache can; only the misses share the
+    // enumeration pass below
+    QList<qsizetype> pending;
+    QStringList pendingStrings;
+    for (qsizetype i = 0; i < predicates.size(); ++i) {
+        const QString predicateString = predicates.at(i).toString();
+        if (const QStringList *cached = manager->cachedQuery(predicateString, parentUdi)) {
+            Stats::add(Stats::counters().queries);
+            Stats::add(Stats::counters().queryCacheHits);
+            results[i] = manager->findRegisteredDevices(*cached);
+        } else {
+            pending.append(i);
+            pendingStrings.append(predicateString);
+        }
+    }
+
+    if (pending.isEmpty()) {
+        return results;
+    }
+
+    QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+    Stats::add(Stats::counters().queries, pending.size());
+
+    /* Union the interface types across the pending predicates, so each
+     * backend the batch needs is instantiated and enumerated exactly once;
+     * a single invalid predicate degrades the batch to a full enumeration,
+     * as it would a single query. */
+    QSet<DeviceInterface::Type> usedTypes;
+    QList<quint32> pendingMasks;
+    pendingMasks.reserve(pending.size());
+    bool allValid = true;
+    for (qsizetype i : std::as_const(pending)) {
+        quint32 mask = 0;
+        const auto types = predicates.at(i).usedTypes();
+        for (DeviceInterface::Type type : types) {
+            mask |= 1u << type;
+        }
+        pendingMasks.append(mask);
+        usedTypes |= types;
+        allValid = allValid && predicates.at(i).isValid();
+    }
+
+    const auto backends = allValid ? manager->managerBackends(usedTypes) : manager->managerBackends();
+
+    for (const auto &backend : backends) {
+        backend->beginEnumeration();
+    }
+
+    QList<QStringList> matchedUdis;
+    matchedUdis.resize(pending.size());
+
+    const bool trace = ManagerBasePrivate::startupTraceEnabled();
+    for (const auto &backend : backends) {
+        const quint32 backendMask = manager->backendTypeMask(backend);
+
+        QStringList udis;
+        QElapsedTimer enumTimer;
+        if (trace) {
+            enumTimer.start();
+        }
+        if (allValid) {
+            // every relevant predicate narrows its own candidate set; the
+            // union is deduplicated below and matches() stays authoritative
+            for (qsizetype j = 0; j < pending.size(); ++j) {
+                if (backendMask & pendingMasks.at(j)) {
+                    udis += backend->devicesFromQuery(parentUdi, predicates.at(pending.at(j)));
+                }
+            }
+        } else {
+            udis += backend->allDevices();
+        }
+        if (trace) {
+            ManagerBasePrivate::noteFirstEnumeration(backend, enumTimer.nsecsElapsed());
+        }
+
+        std::set<QString> seen;
+        for (const auto &udi : std::as_const(udis)) {
+            const auto [it, isInserted] = seen.insert(udi);
+            if (!isInserted) {
+                continue;
+            }
+            const Device dev(udi);
+
+            for (qsizetype j = 0; j < pending.size(); ++j) {
+                const Predicate &p = predicates.at(pending.at(j));
+                if (allValid && !(backendMask & pendingMasks.at(j))) {
+                    continue;
+                }
+                if (!p.isValid() || p.matches(dev)) {
+                    results[pending.at(j)].append(dev);
+                    matchedUdis[j].append(dev.udi());
+                }
+            }
+        }
+    }
+
+    for (qsizetype j = 0; j < pending.size(); ++j) {
+        manager->storeQueryResult(pendingStrings.at(j), parentUdi, matchedUdis.at(j));
+    }
+
+    return results;
+}
+
+QList<QList<Solid::Device>> Solid::Device::listFromQueries(const QStringList &predicates, const QString &parentUdi)
+{
+    QList<QList<Device>> results;
+    results.resize(predicates.size());
+
+    // drop what doesn't parse instead of passing invalid predicates on,
+    // which would degrade the whole batch to a full enumeration
+    QList<Predicate> parsed;
+    QList<qsizetype> indices;
+    parsed.reserve(predicates.size());
+    for (qsizetype i = 0; i < predicates.size(); ++i) {
+        const Predicate p = Predicate::fromString(predicates.at(i));
+        if (p.isValid()) {
+            parsed.append(p);
+            indices.append(i);
+        }
+    }
+
+    const auto parsedResults = listFromQueries(parsed, parentUdi);
+    for (qsizetype j = 0; j < indices.size(); ++j) {
+        results[indices.at(j)] = parsedResults.at(j);
+    }
+
+    return results;
+}
+
 Solid::Device Solid::Device::storageAccessFromPath(const QString &path)
 {
-    const QList<Device> list = Solid::Device::listFromType(DeviceInterface::Type::StorageAccess);
-    Device match;
-    int match_length = 0;
-    for (const Device &device : list) {
+    return globalDeviceStorage->deviceManager()->storageAccessFromPath(path);
+}
+
+Solid::Device Solid::Device::fromDeviceFile(const QString &deviceFile)
+{
+    {
+        QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+        const auto backends = globalDeviceStorage->managerBackends();
+
+        for (const auto &backend : backends) {
+            const QString udi = backend->udiFromDeviceFile(deviceFile);
+            if (!udi.isEmpty()) {
+                return Device(udi);
+            }
+        }
+    }
+
+    // no backend could answer natively, fall back to scanning the block devices
+    const QList<Device> blockDevices = listFromType(DeviceInterface::Block);
+    for (Device device : blockDevices) {
+        // the device may have vanished since enumeration
+        const Block *block = device.as<Block>();
+        if (block && block->device() == deviceFile) {
+            return device;
+        }
+    }
+
+    return Device();
+}
+
+void Solid::DeviceManagerPrivate::_k_invalidateCaches()
+{
+    m_mountIndex.clear();
+    m_mountIndexValid = false;
+    m_queryCache.clear();
+}
+
+const QStringList *Solid::DeviceManagerPrivate::cachedQuery(const QString &predicateString, const QString &parentUdi) const
+{
+    if (!monitoringActive()) {
+        // without a change subscriber no backend events flow, so nothing
+        // would ever invalidate a stored result; don't serve one
+        return nullptr;
+    }
+
+    auto it = m_queryCache.constFind({predicateString, parentUdi});
+    return it != m_queryCache.constEnd() ? &it.value() : nullptr;
+}
+
+void Solid::DeviceManagerPrivate::storeQueryResult(const QString &predicateString, const QString &parentUdi, const QStringList &udis)
+{
+    if (!monitoringActive()) {
+        return;
+    }
+
+    m_queryCache.insert({predicateString, parentUdi}, udis);
+}
+
+void Solid::DeviceManagerPrivate::rebuildMountIndex()
+{
+    m_mountIndex.clear();
+
+    const QStringList &udis = udisFromType(DeviceInterface::StorageAccess);
+    m_mountIndex.reserve(udis.size());
+
+    for (const QString &udi : udis) {
+        Device device(udi);
+
         auto storageVolume = device.as<StorageVolume>();
         if (storageVolume && storageVolume->usage() != StorageVolume::UsageType::FileSystem) {
             continue;
         }
 
         auto storageAccess = device.as<StorageAccess>();
-        QString mountPath = storageAccess->filePath();
+        if (!storageAccess) {
+            continue;
+        }
 
-        if (mountPath.size() <= match_length || !path.startsWith(mountPath)) {
+        QString mountPath = storageAccess->filePath();
+        if (mountPath.isEmpty()) {
             continue;
         }
 
-        const auto realLength = mountPath.back() == QLatin1Char('/') ? mountPath.size() - 1 : mountPath.size();
+        // (un)mount invalidation proper rides the backends' deviceChanged
+        // relay; this per-interface connection only backstops backends
+        // without a property-change stream, and only for the index entries
+        // currently held
+        connect(storageAccess, &StorageAccess::accessibilityChanged, this, &DeviceManagerPrivate::_k_invalidateCaches, Qt::UniqueConnection);
+
+        if (mountPath.endsWith(QLatin1Char('/'))) {
+            mountPath.chop(1); // "/" becomes the empty prefix matching everything
+        }
+
+        m_mountIndex.push_back({mountPath, device});
+    }
+
+    std::sort(m_mountIndex.begin(), m_mountIndex.end(), [](const MountPoint &a, const MountPoint &b) {
+        return a.path < b.path;
+    });
+
+    m_mountIndexValid = true;
+}
+
+Solid::Device Solid::DeviceManagerPrivate::storageAccessFromPath(const QString &path)
+{
+    // without events the accessibilityChanged invalidation never fires, so
+    // the index can't be trusted across calls
+    if (!m_mountIndexValid || !monitoringActive()) {
+        rebuildMountIndex();
+    }
+
+    /* Every mount point that is a prefix of the path sorts before it, and a
+     * longer matching prefix sorts after a shorter one; so walk back from
+     * the insertion point and the first entry matching at a component
+     * boundary is the longest match. */
+    auto it = std::upper_bound(m_mountIndex.cbegin(), m_mountIndex.cend(), path, [](const QString &p, const MountPoint &m) {
+        return p < m.path;
+    });
 
-        // `startsWith` implies `path.size() >= mountPath.size()`
-        if (path.size() == realLength || path[realLength] == QLatin1Char('/')) {
-            match_length = realLength;
-            match = device;
+    while (it != m_mountIndex.cbegin()) {
+        --it;
+        if (path.startsWith(it->path) && (path.size() == it->path.size() || path.at(it->path.size()) == QLatin1Char('/'))) {
+            return it->device;
         }
     }
-    return match;
+
+    return Device();
 }
 
 Solid::DeviceNotifier *Solid::DeviceNotifier::instance()
@@ -183,8 +647,204 @@ Solid::DeviceNotifier *Solid::DeviceNotifier::instance()
     return globalDeviceStorage->notifier();
 }
 
-void Solid::DeviceManagerPrivate::_k_deviceAdded(const QString &udi)
+/* The signals whose receivers make this process interested in hotplug
+ * events; destroyed() and friends don't count. */
+static bool isChangeSignal(const QMetaMethod &signal)
+{
+    static const QMetaMethod changeSignals[] = {
+        QMetaMethod::fromSignal(&Solid::DeviceNotifier::deviceAdded),
+        QMetaMethod::fromSignal(&Solid::DeviceNotifier::deviceRemoved),
+        QMetaMethod::fromSignal(&Solid::DeviceNotifier::aboutToChange),
+        QMetaMethod::fromSignal(&Solid::DeviceNotifier::changesComplete),
+        QMetaMethod::fromSignal(&Solid::DeviceNotifier::devicesAdded),
+        QMetaMethod::fromSignal(&Solid::DeviceNotifier::devicesRemoved),
+    };
+
+    return std::any_of(std::begin(changeSignals), std::end(changeSignals), [&signal](const QMetaMethod &candidate) {
+        return candidate == signal;
+    });
+}
+
+void Solid::DeviceManagerPrivate::connectNotify(const QMetaMethod &signal)
+{
+    DeviceNotifier::connectNotify(signal);
+
+    if (!isChangeSignal(signal)) {
+        return;
+    }
+
+    /* The notify hooks may run in the connecting thread with Qt's signal
+     * bookkeeping locked, so only count here and do the actual arming from
+     * our own event loop. */
+    m_changeReceivers.fetchAndAddRelaxed(1);
+    QMetaObject::invokeMethod(this, &DeviceManagerPrivate::_k_syncMonitoring, Qt::QueuedConnection);
+}
+
+void Solid::DeviceManagerPrivate::disconnectNotify(const QMetaMethod &signal)
+{
+    DeviceNotifier::disconnectNotify(signal);
+
+    if (signal.isValid()) {
+        if (!isChangeSignal(signal)) {
+            return;
+        }
+        if (m_changeReceivers.loadRelaxed() > 0) {
+            m_changeReceivers.fetchAndSubRelaxed(1);
+        }
+    } else {
+        // wildcard disconnect: every connection to our signals is gone
+        m_changeReceivers.storeRelaxed(0);
+    }
+
+    QMetaObject::invokeMethod(this, &DeviceManagerPrivate::_k_syncMonitoring, Qt::QueuedConnection);
+}
+
+void Solid::DeviceManagerPrivate::monitoringChanged(bool active)
+{
+    if (!active) {
+        return;
+    }
+
+    /* Events that happened while monitoring was down never reached us, so
+     * anything accumulated during that period is suspect. This runs under
+     * the backends mutex, possibly from another thread; drop the caches
+     * from our own event loop instead. */
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            _k_invalidateCaches();
+            m_typeIndex.clear();
+            m_allUdis.clear();
+            m_allUdisValid = false;
+        },
+        Qt::QueuedConnection);
+}
+
+void Solid::DeviceManagerPrivate::_k_syncMonitoring()
+{
+    const bool wanted = m_changeReceivers.loadRelaxed() > 0 || !m_subscriptions.isEmpty();
+    if (wanted == m_monitoringSubscribed) {
+        return;
+    }
+
+    m_monitoringSubscribed = wanted;
+    if (wanted) {
+        addChangeSubscriber();
+    } else {
+        removeChangeSubscriber();
+    }
+}
+
+Solid::DeviceSubscription *Solid::DeviceNotifier::subscribe(const Predicate &predicate, QObject *parent)
+{
+    auto *manager = static_cast<DeviceManagerPrivate *>(this);
+    auto *subscription = new DeviceSubscription(predicate, parent);
+
+    // seed with the currently matching devices so later removals are reported
+    Device::forEachFromQuery(predicate, QString(), [subscription](const Device &device) {
+        subscription->m_matched.insert(udiHandle(device.udi()));
+        return true;
+    });
+
+    manager->m_subscriptions.append(subscription);
+    connect(subscription, &QObject::destroyed, manager, [manager, subscription]() {
+        manager->m_subscriptions.removeAll(subscription);
+        manager->_k_syncMonitoring();
+    });
+
+    // subscriptions are fed from the same backend events as the signals
+    manager->_k_syncMonitoring();
+
+    return subscription;
+}
+
+QStringList Solid::DeviceNotifier::allDeviceUdis()
+{
+    auto *manager = static_cast<DeviceManagerPrivate *>(this);
+
+    if (!ManagerBasePrivate::monitoringActive()) {
+        // the snapshot-plus-delta contract needs the deltas; without a
+        // change subscriber re-enumerate instead
+        manager->m_allUdis.clear();
+        manager->m_allUdisValid = false;
+    }
+
+    if (!manager->m_allUdisValid) {
+        QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+        const auto backends = manager->managerBackends();
+
+        for (const auto &backend : backends) {
+            backend->beginEnumeration();
+        }
+
+        QSet<QString> seen;
+        const bool trace = ManagerBasePrivate::startupTraceEnabled();
+        for (const auto &backend : backends) {
+            QElapsedTimer enumTimer;
+            if (trace) {
+                enumTimer.start();
+            }
+            const QStringList udis = backend->allDevices();
+            if (trace) {
+                ManagerBasePrivate::noteFirstEnumeration(backend, enumTimer.nsecsElapsed());
+            }
+            for (const QString &udi : udis) {
+                if (!seen.contains(udi)) {
+                    seen.insert(udi);
+                    manager->m_allUdis.append(internedUdi(udi));
+                }
+            }
+        }
+
+        manager->m_allUdisValid = true;
+    }
+
+    return manager->m_allUdis;
+}
+
+const QStringList &Solid::DeviceManagerPrivate::udisFromType(DeviceInterface::Type type)
 {
+    if (!monitoringActive()) {
+        // the index is maintained from hotplug events; while none flow it
+        // must be rebuilt per call
+        m_typeIndex.remove(type);
+    }
+
+    auto indexIt = m_typeIndex.find(type);
+
+    if (indexIt == m_typeIndex.end()) {
+        QStringList udis;
+        QSet<QString> seen;
+        QMutexLocker locker(backendsMutex());
+        const auto backends = managerBackends({type});
+
+        for (const auto &backend : backends) {
+            const auto backendUdis = backend->devicesFromQuery(QString(), type);
+            for (const auto &udi : backendUdis) {
+                if (!seen.contains(udi)) {
+                    seen.insert(udi);
+                    udis.append(internedUdi(udi));
+                }
+            }
+        }
+
+        indexIt = m_typeIndex.insert(type, udis);
+    }
+
+    return indexIt.value();
+}
+
+void Solid::DeviceManagerPrivate::_k_deviceAdded(const QString &addedUdi)
+{
+    // canonicalize early: the registry, the type index and the re-emitted
+    // signal then all share the same string data
+    const QString udi = internedUdi(addedUdi);
+
+    if (!m_burstActive) {
+        m_burstActive = true;
+        Q_EMIT aboutToChange();
+    }
+
     if (m_devicesMap.contains(udi)) {
         DevicePrivate *dev = m_devicesMap[udi].data();
 
@@ -197,11 +857,49 @@ void Solid::DeviceManagerPrivate::_k_deviceAdded(const QString &udi)
         }
     }
 
+    // Keep the already-built parts of the type index up to date, so that
+    // clients querying from their deviceAdded slot see the new device.
+    if (!m_typeIndex.isEmpty()) {
+        Device device(udi);
+        for (auto it = m_typeIndex.begin(); it != m_typeIndex.end(); ++it) {
+            if (device.isDeviceInterface(it.key()) && !it.value().contains(udi)) {
+                it.value().append(udi);
+            }
+        }
+    }
+
+    if (m_allUdisValid && !m_allUdis.contains(udi)) {
+        m_allUdis.append(udi);
+    }
+
+    _k_invalidateCaches();
+
     Q_EMIT deviceAdded(udi);
+
+    // evaluate the filtered subscriptions centrally: one Device and one
+    // handle lookup, shared by every subscription; property reads land in
+    // the backend's cache for the next predicate
+    if (!m_subscriptions.isEmpty()) {
+        Device device(udi);
+        const DeviceHandle handle = udiHandle(udi);
+        for (DeviceSubscription *subscription : std::as_const(m_subscriptions)) {
+            subscription->evaluateAdded(device, handle);
+        }
+    }
+
+    m_pendingAdded.append(udi);
+    m_batchTimer.start();
 }
 
-void Solid::DeviceManagerPrivate::_k_deviceRemoved(const QString &udi)
+void Solid::DeviceManagerPrivate::_k_deviceRemoved(const QString &removedUdi)
 {
+    const QString udi = internedUdi(removedUdi);
+
+    if (!m_burstActive) {
+        m_burstActive = true;
+        Q_EMIT aboutToChange();
+    }
+
     if (m_devicesMap.contains(udi)) {
         DevicePrivate *dev = m_devicesMap[udi].data();
 
@@ -214,15 +912,117 @@ void Solid::DeviceManagerPrivate::_k_deviceRemoved(const QString &udi)
         }
     }
 
+    for (auto it = m_typeIndex.begin(); it != m_typeIndex.end(); ++it) {
+        it.value().removeAll(udi);
+    }
+
+    m_allUdis.removeAll(udi);
+
+    _k_invalidateCaches();
+
     Q_EMIT deviceRemoved(udi);
+
+    if (!m_subscriptions.isEmpty()) {
+        const DeviceHandle handle = udiHandle(udi);
+        for (DeviceSubscription *subscription : std::as_const(m_subscriptions)) {
+            subscription->evaluateRemoved(udi, handle);
+        }
+    }
+
+    m_pendingRemoved.append(udi);
+    m_batchTimer.start();
 }
 
-void Solid::DeviceManagerPrivate::_k_destroyed(QObject *object)
+void Solid::DeviceManagerPrivate::_k_deviceInterfacesChanged(const QString &changedUdi)
 {
-    QString udi = m_reverseMap.take(object);
+    const QString udi = internedUdi(changedUdi);
+
+    if (!m_burstActive) {
+        m_burstActive = true;
+        Q_EMIT aboutToChange();
+    }
+
+    // refresh the registered device in place: the backend object and its
+    // property caches survive, only the interface wrappers and the cached
+    // capability answers are dropped
+    if (m_devicesMap.contains(udi)) {
+        DevicePrivate *dev = m_devicesMap[udi].data();
+        if (dev) {
+            dev->resetInterfaceCache();
+        }
+    }
+
+    // membership in the per-type lists may have changed in either direction
+    if (!m_typeIndex.isEmpty()) {
+        Device device(udi);
+        for (auto it = m_typeIndex.begin(); it != m_typeIndex.end(); ++it) {
+            const bool present = device.isDeviceInterface(it.key());
+            const bool listed = it.value().contains(udi);
+            if (present && !listed) {
+                it.value().append(udi);
+            } else if (!present && listed) {
+                it.value().removeAll(udi);
+            }
+        }
+    }
+
+    _k_invalidateCaches();
+
+    // keep the remove-and-readd contract for raw listeners, they know the
+    // device only by UDI anyway; subscriptions get a single transition
+    Q_EMIT deviceRemoved(udi);
+    Q_EMIT deviceAdded(udi);
+
+    if (!m_subscriptions.isEmpty()) {
+        Device device(udi);
+        const DeviceHandle handle = udiHandle(udi);
+        for (DeviceSubscription *subscription : std::as_const(m_subscriptions)) {
+            subscription->evaluateChanged(device, handle);
+        }
+    }
+
+    m_pendingRemoved.append(udi);
+    m_pendingAdded.append(udi);
+    m_batchTimer.start();
+}
+
+void Solid::DeviceManagerPrivate::_k_deviceChanged(const QString &changedUdi)
+{
+    Q_UNUSED(changedUdi)
+
+    // a mutable property moved under an existing device; memoized query
+    // results and the mount index may both name it, so neither survives
+    _k_invalidateCaches();
+}
+
+void Solid::DeviceManagerPrivate::_k_emitBatches()
+{
+    if (!m_pendingAdded.isEmpty()) {
+        const QStringList added = m_pendingAdded;
+        m_pendingAdded.clear();
+        Q_EMIT devicesAdded(added);
+    }
+
+    if (!m_pendingRemoved.isEmpty()) {
+        const QStringList removed = m_pendingRemoved;
+        m_pendingRemoved.clear();
+        Q_EMIT devicesRemoved(removed);
+    }
+
+    if (m_burstActive) {
+        m_burstActive = false;
+        Q_EMIT changesComplete();
+    }
+}
+
+void Solid::DeviceManagerPrivate::deviceUnregistered(DevicePrivate *device)
+{
+    QString udi = m_reverseMap.take(device);
 
     if (!udi.isEmpty()) {
         m_devicesMap.remove(udi);
+        Stats::add(Stats::counters().registeredDevices, -1);
+        Stats::add(Stats::counters().registryBytes, -(qint64(sizeof(DevicePrivate)) + Stats::stringBytes(udi)));
     }
 }
 
@@ -233,43 +1033,91 @@ Solid::DevicePrivate *Solid::DeviceManagerPrivate::findRegisteredDevice(const QS
     } else if (m_devicesMap.contains(udi)) {
         return m_devicesMap[udi].data();
     } else {
-        Ifaces::Device *iface = createBackendObject(udi);
+        // store the canonical copy so every holder shares one allocation
+        const QString interned = internedUdi(udi);
 
-        DevicePrivate *devData = new DevicePrivate(udi);
-        devData->setBackendObject(iface);
+        DevicePrivate *devData = new DevicePrivate(interned);
+        // the backend object is only created when something actually
+        // dereferences the device; comparing or storing UDIs stays cheap
+        devData->setBackendResolver(this);
 
         QPointer<DevicePrivate> ptr(devData);
-        m_devicesMap[udi] = ptr;
-        m_reverseMap[devData] = udi;
-
-        connect(devData, &QObject::destroyed, this, &DeviceManagerPrivate::_k_destroyed);
+        m_devicesMap[interned] = ptr;
+        m_reverseMap[devData] = interned;
+        Stats::add(Stats::counters().registeredDevices);
+        Stats::add(Stats::counters().registryBytes, qint64(sizeof(DevicePrivate)) + Stats::stringBytes(interned));
 
         return devData;
     }
 }
 
-Solid::Ifaces::Device *Solid::DeviceManagerPrivate::createBackendObject(const QString &udi)
+QList<Solid::Device> Solid::DeviceManagerPrivate::findRegisteredDevices(const QStringList &udis)
 {
-    const auto backends = globalDeviceStorage->managerBackends();
+    QList<Device> devices;
+    devices.reserve(udis.size());
 
-    for (const auto &backend : backends) {
-        if (!udi.startsWith(backend->udiPrefix())) {
-            continue;
-        }
+    // grow the hashes once for the whole batch instead of rehashing as it
+    // is inserted
+    m_devicesMap.reserve(m_devicesMap.size() + udis.size());
+    m_reverseMap.reserve(m_reverseMap.size() + udis.size());
+
+    qsizetype added = 0;
+    qint64 addedBytes = 0;
+    for (const QString &udi : udis) {
+        DevicePrivate *devData = nullptr;
 
-        Ifaces::Device *iface = nullptr;
+        if (udi.isEmpty()) {
+            devData = m_nullDevice.data();
+        } else if (const auto it = m_devicesMap.constFind(udi); it != m_devicesMap.constEnd()) {
+            devData = it->data();
+        } else {
+            const QString interned = internedUdi(udi);
 
-        QObject *object = backend->createDevice(udi);
-        iface = qobject_cast<Ifaces::Device *>(object);
+            devData = new DevicePrivate(interned);
+            devData->setBackendResolver(this);
 
-        if (iface == nullptr) {
-            delete object;
+            m_devicesMap.insert(interned, QPointer<DevicePrivate>(devData));
+            m_reverseMap.insert(devData, interned);
+            ++added;
+            addedBytes += qint64(sizeof(DevicePrivate)) + Stats::stringBytes(interned);
         }
 
-        return iface;
+        Device device;
+        device.d = devData;
+        devices.append(device);
     }
 
-    return nullptr;
+    // the registry counters move once per batch, not once per device
+    if (added > 0) {
+        Stats::add(Stats::counters().registeredDevices, added);
+        Stats::add(Stats::counters().registryBytes, addedBytes);
+    }
+
+    return devices;
+}
+
+Solid::Ifaces::Device *Solid::DeviceManagerPrivate::createBackendObject(const QString &udi)
+{
+    const Trace::Timer traceTimer;
+
+    QMutexLocker locker(ManagerBasePrivate::backendsMutex());
+
+    /* UDI prefixes are part of the static dispatch tables, so resolving a
+     * device only materializes the one backend that owns it. */
+    Ifaces::DeviceManager *backend = backendForUdi(udi);
+    if (!backend) {
+        return nullptr;
+    }
+
+    QObject *object = backend->createDevice(udi);
+    Ifaces::Device *iface = qobject_cast<Ifaces::Device *>(object);
+
+    if (iface == nullptr) {
+        delete object;
+    }
+
+    SOLID_TRACE2(create_backend_object, qUtf8Printable(udi), traceTimer.nsecs());
+    return iface;
 }
 
 Solid::DeviceManagerStorage::DeviceManagerStorage()
@@ -282,6 +1130,12 @@ QList<Solid::Ifaces::DeviceManager *> Solid::DeviceManagerStorage::managerBacken
     return m_storage.localData()->managerBackends();
 }
 
+Solid::DeviceManagerPrivate *Solid::DeviceManagerStorage::deviceManager()
+{
+    ensureManagerCreated();
+    return m_storage.localData();
+}
+
 Solid::DeviceNotifier *Solid::DeviceManagerStorage::notifier()
 {
     ensureManagerCreated();
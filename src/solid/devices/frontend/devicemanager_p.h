@@ -11,10 +11,17 @@
 
 #include "devicenotifier.h"
 
+#include "device.h"
+#include "deviceinterface.h"
+
+#include <vector>
+
+#include <QAtomicInt>
 #include <QHash>
 #include <QPointer>
 #include <QSharedData>
 #include <QThreadStorage>
+#include <QTimer>
 
 namespace Solid
 {
@@ -23,6 +30,7 @@ namespace Ifaces
 class Device;
 }
 class DevicePrivate;
+class DeviceSubscription;
 
 class DeviceManagerPrivate : public DeviceNotifier, public ManagerBasePrivate
 {
@@ -33,17 +41,130 @@ public:
 
     DevicePrivate *findRegisteredDevice(const QString &udi);
 
+    /**
+     * Registers every UDI in @p udis and returns the device handles in the
+     * same order. The registry hashes are grown once for the whole batch
+     * and the statistics counters are updated once at the end, so
+     * enumeration results populate the registry as one bulk operation
+     * instead of per-device bookkeeping.
+     */
+    QList<Device> findRegisteredDevices(const QStringList &udis);
+
+    /**
+     * Called by ~DevicePrivate to drop the device from the registry; the
+     * direct call replaces the destroyed() connection each registration
+     * used to establish.
+     */
+    void deviceUnregistered(DevicePrivate *device);
+
+    /**
+     * Returns the UDIs of all devices having the given device interface,
+     * in backend enumeration order. The underlying index is built from the
+     * backends on first use and then kept up to date incrementally from
+     * their deviceAdded/deviceRemoved signals.
+     */
+    const QStringList &udisFromType(DeviceInterface::Type type);
+
+    /**
+     * Returns the StorageAccess device whose mount point is the longest
+     * prefix of @p path, served from a sorted mount-point index instead of
+     * enumerating and constructing every StorageAccess device per call.
+     */
+    Device storageAccessFromPath(const QString &path);
+
+    Ifaces::Device *createBackendObject(const QString &udi);
+
+    /**
+     * Returns the memoized UDI list for a previous query with the same
+     * predicate string and parent, or nullptr if none is stored. Entries
+     * are dropped wholesale on device arrival/removal and on accessibility
+     * changes, so steady-state repeated queries skip the backends entirely.
+     */
+    const QStringList *cachedQuery(const QString &predicateString, const QString &parentUdi) const;
+
+    /**
+     * The enumeration half of Device::forEachFromQuery(): the deduplicated
+     * candidate UDIs the backends report for the query, in the order the
+     * devices would be visited. No frontend device is constructed and the
+     * predicate is not evaluated — DeviceQueryCursor does that page by
+     * page.
+     */
+    static QStringList candidateUdisFromQuery(const Predicate &predicate, const QString &parentUdi);
+
+    void storeQueryResult(const QString &predicateString, const QString &parentUdi, const QStringList &udis);
+
+    /**
+     * Bitmask over DeviceInterface::Type of the interfaces supported by
+     * @p backend, precomputed at load time for cheap query dispatch.
+     */
+    quint32 backendTypeMask(Ifaces::DeviceManager *backend) const;
+
+protected:
+    void backendInstantiated(Ifaces::DeviceManager *backend) override;
+    void monitoringChanged(bool active) override;
+
+    /**
+     * Count the external receivers of the change signals; the backend
+     * monitors are armed while at least one exists (or a subscription is
+     * alive) and dropped again when the last goes away, so processes that
+     * never watch for changes carry no event-delivery machinery.
+     */
+    void connectNotify(const QMetaMethod &signal) override;
+    void disconnectNotify(const QMetaMethod &signal) override;
+
 private Q_SLOTS:
     void _k_deviceAdded(const QString &udi);
     void _k_deviceRemoved(const QString &udi);
-    void _k_destroyed(QObject *object);
+    void _k_deviceInterfacesChanged(const QString &udi);
+    void _k_deviceChanged(const QString &udi);
+    void _k_emitBatches();
+    void _k_invalidateCaches();
+    void _k_syncMonitoring();
 
 private:
-    Ifaces::Device *createBackendObject(const QString &udi);
+    void rebuildMountIndex();
 
     QExplicitlySharedDataPointer<DevicePrivate> m_nullDevice;
     QHash<QString, QPointer<DevicePrivate>> m_devicesMap;
     QHash<QObject *, QString> m_reverseMap;
+    QHash<DeviceInterface::Type, QStringList> m_typeIndex;
+
+    // per-backend dispatch data, filled as backends are instantiated
+    QHash<Ifaces::DeviceManager *, quint32> m_backendTypeMasks;
+
+    friend class DeviceNotifier;
+    QList<DeviceSubscription *> m_subscriptions;
+
+    // mount points sorted by path; holding the Device keeps the signal
+    // connections used for invalidation alive
+    struct MountPoint {
+        QString path; // normalized, no trailing slash
+        Device device;
+    };
+    std::vector<MountPoint> m_mountIndex;
+    bool m_mountIndexValid = false;
+
+    // memoized query results, keyed by (predicate string, parent UDI)
+    QHash<QPair<QString, QString>, QStringList> m_queryCache;
+
+    // full-system snapshot backing DeviceNotifier::allDeviceUdis(),
+    // enumerated once and then maintained from the hotplug events
+    QStringList m_allUdis;
+    bool m_allUdisValid = false;
+
+    // hotplug bursts coalesced into devicesAdded/devicesRemoved emissions,
+    // bracketed by aboutToChange/changesComplete
+    QStringList m_pendingAdded;
+    QStringList m_pendingRemoved;
+    QTimer m_batchTimer;
+    bool m_burstActive = false;
+
+    // change-signal receivers of this notifier; atomic because the notify
+    // hooks can run in the connecting thread
+    QAtomicInt m_changeReceivers;
+    // whether this manager currently holds a process-wide change
+    // subscription on behalf of its receivers
+    bool m_monitoringSubscribed = false;
 };
 
 class DeviceManagerStorage
@@ -52,6 +173,7 @@ public:
     DeviceManagerStorage();
 
     QList<Ifaces::DeviceManager *> managerBackends();
+    DeviceManagerPrivate *deviceManager();
     DeviceNotifier *notifier();
 
 private:
@@ -8,11 +8,15 @@
 #define SOLID_DEVICENOTIFIER_H
 
 #include <QObject>
+#include <QStringList>
 
 #include <solid/solid_export.h>
 
 namespace Solid
 {
+class DeviceSubscription;
+class Predicate;
+
 /**
  * @class Solid::DeviceNotifier devicenotifier.h <Solid/DeviceNotifier>
  *
@@ -32,6 +36,36 @@ class SOLID_EXPORT DeviceNotifier : public QObject // krazy:exclude=dpointer (in
 public:
     static DeviceNotifier *instance();
 
+    /**
+     * Creates a subscription whose signals only fire for devices matching
+     * @p predicate.
+     *
+     * The predicate is evaluated once, centrally, per hotplug event instead
+     * of by every interested client, against the properties the backend has
+     * already cached.
+     *
+     * @param predicate the predicate devices are matched against
+     * @param parent the parent taking ownership of the subscription;
+     * destroy the subscription to unsubscribe
+     * @return the new subscription
+     * @since 6.8
+     */
+    DeviceSubscription *subscribe(const Predicate &predicate, QObject *parent = nullptr);
+
+    /**
+     * Returns the UDIs of all devices currently in the system.
+     *
+     * The list is enumerated from the backends once and then kept up to
+     * date incrementally from their hotplug events. Together with
+     * devicesAdded() and devicesRemoved() this gives clients a
+     * snapshot-plus-delta pattern: take the snapshot at startup, apply the
+     * deltas afterwards, and never re-enumerate.
+     *
+     * @return the UDIs of all devices, in backend enumeration order
+     * @since 6.8
+     */
+    QStringList allDeviceUdis();
+
 Q_SIGNALS:
     /**
      * This signal is emitted when a new device appears in the underlying system.
@@ -46,6 +80,55 @@ Q_SIGNALS:
      * @param udi the old device UDI
      */
     void deviceRemoved(const QString &udi);
+
+    /**
+     * This signal is emitted when the first event of a hotplug burst
+     * arrives, before the corresponding deviceAdded() or deviceRemoved()
+     * emission.
+     *
+     * A single physical event — a docking station, a card reader, a
+     * multi-LUN disk — produces a stream of device events; model-based
+     * consumers can suspend their updates here and rebuild once when
+     * changesComplete() fires after the burst settled.
+     *
+     * @since 6.8
+     */
+    void aboutToChange();
+
+    /**
+     * This signal is emitted once a hotplug burst announced by
+     * aboutToChange() has settled, after the batched devicesAdded() and
+     * devicesRemoved() emissions.
+     *
+     * @since 6.8
+     */
+    void changesComplete();
+
+    /**
+     * This signal is emitted after a short coalescing window for every burst
+     * of devices appearing in the underlying system, for example when a USB
+     * hub is plugged in.
+     *
+     * It carries the same UDIs as the individual deviceAdded() emissions of
+     * the burst; clients that re-run a query on every change can connect to
+     * this signal instead and refresh once per burst.
+     *
+     * @param udis the UDIs of the new devices, in arrival order
+     * @since 6.8
+     */
+    void devicesAdded(const QStringList &udis);
+
+    /**
+     * This signal is emitted after a short coalescing window for every burst
+     * of devices disappearing from the underlying system.
+     *
+     * It carries the same UDIs as the individual deviceRemoved() emissions
+     * of the burst.
+     *
+     * @param udis the UDIs of the old devices, in removal order
+     * @since 6.8
+     */
+    void devicesRemoved(const QStringList &udis);
 };
 }
 
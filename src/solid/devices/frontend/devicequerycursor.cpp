@@ -0,0 +1,72 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "devicequerycursor.h"
+
+#include "devicemanager_p.h"
+
+namespace Solid
+{
+class DeviceQueryCursorPrivate
+{
+public:
+    Predicate predicate;
+    QString parentUdi;
+    QStringList candidates;
+    qsizetype position = 0;
+    bool enumerated = false;
+};
+}
+
+Solid::DeviceQueryCursor::DeviceQueryCursor()
+    : d(QSharedPointer<DeviceQueryCursorPrivate>::create())
+{
+    // no query behind it: nothing to enumerate, nothing to fetch
+    d->enumerated = true;
+}
+
+Solid::DeviceQueryCursor::DeviceQueryCursor(const Predicate &predicate, const QString &parentUdi)
+    : d(QSharedPointer<DeviceQueryCursorPrivate>::create())
+{
+    d->predicate = predicate;
+    d->parentUdi = parentUdi;
+}
+
+Solid::DeviceQueryCursor::DeviceQueryCursor(const DeviceQueryCursor &other) = default;
+
+Solid::DeviceQueryCursor &Solid::DeviceQueryCursor::operator=(const DeviceQueryCursor &other) = default;
+
+Solid::DeviceQueryCursor::~DeviceQueryCursor() = default;
+
+bool Solid::DeviceQueryCursor::hasMore() const
+{
+    return !d->enumerated || d->position < d->candidates.size();
+}
+
+QList<Solid::Device> Solid::DeviceQueryCursor::fetchMore(int count)
+{
+    if (!d->enumerated) {
+        d->candidates = DeviceManagerPrivate::candidateUdisFromQuery(d->predicate, d->parentUdi);
+        d->enumerated = true;
+    }
+
+    QList<Device> page;
+    if (count <= 0) {
+        return page;
+    }
+    page.reserve(qMin(qsizetype(count), d->candidates.size() - d->position));
+
+    while (d->position < d->candidates.size() && page.size() < count) {
+        const Device device(d->candidates.at(d->position));
+        ++d->position;
+
+        if (!d->predicate.isValid() || d->predicate.matches(device)) {
+            page.append(device);
+        }
+    }
+
+    return page;
+}
@@ -0,0 +1,96 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_DEVICEQUERYCURSOR_H
+#define SOLID_DEVICEQUERYCURSOR_H
+
+#include <QList>
+#include <QSharedPointer>
+
+#include <solid/solid_export.h>
+
+#include <solid/device.h>
+#include <solid/predicate.h>
+
+namespace Solid
+{
+class DeviceQueryCursorPrivate;
+
+/**
+ * @class Solid::DeviceQueryCursor devicequerycursor.h <Solid/DeviceQueryCursor>
+ *
+ * A paged device query.
+ *
+ * Device::listFromQuery() materializes every match before returning; a
+ * view showing twenty rows still waits for the thousandth volume to be
+ * constructed and matched. The cursor instead enumerates only the
+ * candidate UDIs up front — which is cheap — and constructs and matches
+ * devices page by page as fetchMore() is called, so the first page is
+ * ready as soon as its own devices are.
+ *
+ * Pages arrive in the order listFromQuery() would have returned the
+ * devices. The candidate set is fixed when the first page is fetched;
+ * devices appearing later are not picked up by an existing cursor (use
+ * DeviceNotifier or a DeviceSubscription for the deltas, as DevicesModel
+ * does).
+ *
+ * Copies of a cursor share its position; advancing one advances them all.
+ *
+ * @since 6.8
+ */
+class SOLID_EXPORT DeviceQueryCursor
+{
+public:
+    /**
+     * The number of devices fetchMore() returns when no count is given;
+     * sized for a typical list view port.
+     */
+    static constexpr int DefaultPageSize = 20;
+
+    /**
+     * Creates an already exhausted cursor.
+     */
+    DeviceQueryCursor();
+
+    /**
+     * Creates a cursor over the devices matching @p predicate.
+     *
+     * @param predicate Predicate that the devices must verify; an invalid
+     * predicate matches every device
+     * @param parentUdi UDI of the parent of the devices we're searching
+     * for, or QString() if there's no constraint on the parent
+     */
+    explicit DeviceQueryCursor(const Predicate &predicate, const QString &parentUdi = QString());
+
+    DeviceQueryCursor(const DeviceQueryCursor &other);
+    DeviceQueryCursor &operator=(const DeviceQueryCursor &other);
+    ~DeviceQueryCursor();
+
+    /**
+     * Whether another fetchMore() call can yield devices.
+     *
+     * May still report true when only non-matching candidates remain; the
+     * next fetchMore() then returns an empty list and hasMore() turns
+     * false.
+     */
+    bool hasMore() const;
+
+    /**
+     * Returns up to @p count further matching devices and advances the
+     * cursor past them.
+     *
+     * The candidate UDIs are enumerated on the first call; every call only
+     * pays for constructing and matching the devices of its own page. A
+     * result shorter than @p count means the cursor is exhausted.
+     */
+    QList<Device> fetchMore(int count = DefaultPageSize);
+
+private:
+    QSharedPointer<DeviceQueryCursorPrivate> d;
+};
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "devicequeryjob.h"
+
+#include "devicemanager_p.h"
+
+#include <QThread>
+
+/* Number of UDIs accumulated in the worker before they are shipped to the
+ * caller's thread; small enough for early results, large enough to not
+ * flood the event loop. */
+static const int kDiscoveryBatchSize = 16;
+
+Solid::DeviceQueryJob::DeviceQueryJob(const Predicate &predicate, const QString &parentUdi, QObject *parent)
+    : QObject(parent)
+    , m_predicate(predicate)
+    , m_parentUdi(parentUdi)
+{
+    start();
+}
+
+Solid::DeviceQueryJob::~DeviceQueryJob()
+{
+    // make sure the worker can no longer post results to a dead job
+    if (m_thread && m_thread->isRunning()) {
+        m_thread->requestInterruption();
+        m_thread->wait();
+    }
+}
+
+QList<Solid::Device> Solid::DeviceQueryJob::devices() const
+{
+    return m_devices;
+}
+
+bool Solid::DeviceQueryJob::isFinished() const
+{
+    return m_finished;
+}
+
+void Solid::DeviceQueryJob::start()
+{
+    /* Only UDI strings cross the thread boundary; the Device handles handed
+     * out through devicesDiscovered() are built in the caller's thread so
+     * they belong to its registry. */
+    m_thread = QThread::create([this] {
+        QStringList batch;
+
+        Device::forEachFromQuery(m_predicate, m_parentUdi, [this, &batch](const Device &device) {
+            batch.append(device.udi());
+            if (batch.size() >= kDiscoveryBatchSize) {
+                QMetaObject::invokeMethod(
+                    this,
+                    [this, batch] {
+                        deliver(batch);
+                    },
+                    Qt::QueuedConnection);
+                batch.clear();
+            }
+            return !QThread::currentThread()->isInterruptionRequested();
+        });
+
+        if (QThread::currentThread()->isInterruptionRequested()) {
+            return;
+        }
+
+        QMetaObject::invokeMethod(
+            this,
+            [this, batch] {
+                if (!batch.isEmpty()) {
+                    deliver(batch);
+                }
+                complete();
+            },
+            Qt::QueuedConnection);
+    });
+
+    connect(m_thread, &QThread::finished, m_thread, &QObject::deleteLater);
+    m_thread->start();
+}
+
+void Solid::DeviceQueryJob::deliver(const QStringList &udis)
+{
+    auto *manager = static_cast<DeviceManagerPrivate *>(Solid::DeviceNotifier::instance());
+    const QList<Device> discovered = manager->findRegisteredDevices(udis);
+
+    m_devices += discovered;
+    Q_EMIT devicesDiscovered(discovered);
+}
+
+void Solid::DeviceQueryJob::complete()
+{
+    m_finished = true;
+    Q_EMIT finished(this);
+    deleteLater();
+}
+
+#include "moc_devicequeryjob.cpp"
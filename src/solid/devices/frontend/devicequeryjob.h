@@ -0,0 +1,89 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_DEVICEQUERYJOB_H
+#define SOLID_DEVICEQUERYJOB_H
+
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+
+#include <solid/solid_export.h>
+
+#include <solid/device.h>
+#include <solid/predicate.h>
+
+#include <QThread>
+
+namespace Solid
+{
+/**
+ * @class Solid::DeviceQueryJob devicequeryjob.h <Solid/DeviceQueryJob>
+ *
+ * An asynchronous device query.
+ *
+ * Instances are obtained from Device::allDevicesAsync(),
+ * Device::listFromTypeAsync() or Device::listFromQueryAsync(). The backend
+ * enumeration runs in a worker thread, off the caller's event loop, and the
+ * results arrive incrementally through devicesDiscovered() — a file dialog
+ * can populate its sidebar while slower backends are still answering.
+ *
+ * The job starts automatically and deletes itself after finished() has been
+ * emitted; delete it earlier to abort the query.
+ *
+ * @since 6.8
+ */
+class SOLID_EXPORT DeviceQueryJob : public QObject
+{
+    Q_OBJECT
+public:
+    ~DeviceQueryJob() override;
+
+    /**
+     * The devices discovered so far; the complete result once finished()
+     * was emitted.
+     */
+    QList<Device> devices() const;
+
+    /**
+     * Whether the query has completed.
+     */
+    bool isFinished() const;
+
+Q_SIGNALS:
+    /**
+     * This signal is emitted every time a batch of matching devices has
+     * been discovered.
+     *
+     * @param devices the newly discovered devices
+     */
+    void devicesDiscovered(const QList<Solid::Device> &devices);
+
+    /**
+     * This signal is emitted once the query has completed; the job deletes
+     * itself afterwards.
+     *
+     * @param job the finished job, for retrieving devices()
+     */
+    void finished(Solid::DeviceQueryJob *job);
+
+private:
+    friend class Device;
+
+    DeviceQueryJob(const Predicate &predicate, const QString &parentUdi, QObject *parent);
+    void start();
+    void deliver(const QStringList &udis);
+    void complete();
+
+    Predicate m_predicate;
+    QString m_parentUdi;
+    QList<Device> m_devices;
+    QPointer<QThread> m_thread; // deletes itself when done
+    bool m_finished = false;
+};
+}
+
+#endif
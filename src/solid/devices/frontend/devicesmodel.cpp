@@ -0,0 +1,174 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "devicesmodel.h"
+
+#include "devicenotifier.h"
+#include "devicesubscription.h"
+
+#include <algorithm>
+
+Solid::DevicesModel::DevicesModel(QObject *parent)
+    : DevicesModel(Predicate(), parent)
+{
+}
+
+Solid::DevicesModel::DevicesModel(const Predicate &predicate, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_predicate(predicate)
+{
+    populate();
+
+    if (m_predicate.isValid()) {
+        // the predicate is evaluated once, centrally, per hotplug event
+        DeviceSubscription *subscription = DeviceNotifier::instance()->subscribe(m_predicate, this);
+        connect(subscription, &DeviceSubscription::deviceAdded, this, &DevicesModel::addDevice);
+        connect(subscription, &DeviceSubscription::deviceRemoved, this, &DevicesModel::removeDevice);
+    } else {
+        connect(DeviceNotifier::instance(), &DeviceNotifier::deviceAdded, this, &DevicesModel::addDevice);
+        connect(DeviceNotifier::instance(), &DeviceNotifier::deviceRemoved, this, &DevicesModel::removeDevice);
+    }
+}
+
+Solid::DevicesModel::~DevicesModel() = default;
+
+void Solid::DevicesModel::populate()
+{
+    // an invalid predicate makes the cursor walk all devices, matching the
+    // allDevices() behaviour of the default constructor
+    m_cursor = DeviceQueryCursor(m_predicate);
+
+    // only the first page up front; item views pull the remainder through
+    // the fetchMore() protocol while it already renders
+    m_devices = m_cursor.fetchMore();
+
+    for (Device &device : m_devices) {
+        device.preload();
+    }
+}
+
+int Solid::DevicesModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_devices.size();
+}
+
+QVariant Solid::DevicesModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_devices.size()) {
+        return QVariant();
+    }
+
+    const Device &device = m_devices.at(index.row());
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return device.displayName();
+    case UdiRole:
+        return device.udi();
+    case VendorRole:
+        return device.vendor();
+    case ProductRole:
+        return device.product();
+    case IconRole:
+        return device.icon();
+    case EmblemsRole:
+        return device.emblems();
+    case DescriptionRole:
+        return device.description();
+    }
+
+    return QVariant();
+}
+
+QHash<int, QByteArray> Solid::DevicesModel::roleNames() const
+{
+    return {
+        {Qt::DisplayRole, QByteArrayLiteral("display")},
+        {UdiRole, QByteArrayLiteral("udi")},
+        {VendorRole, QByteArrayLiteral("vendor")},
+        {ProductRole, QByteArrayLiteral("product")},
+        {IconRole, QByteArrayLiteral("icon")},
+        {EmblemsRole, QByteArrayLiteral("emblems")},
+        {DescriptionRole, QByteArrayLiteral("description")},
+    };
+}
+
+bool Solid::DevicesModel::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && m_cursor.hasMore();
+}
+
+void Solid::DevicesModel::fetchMore(const QModelIndex &parent)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    const QList<Device> page = m_cursor.fetchMore();
+
+    QList<Device> fresh;
+    fresh.reserve(page.size());
+    for (const Device &device : page) {
+        // the notifier may have delivered this row already while we paged
+        const auto isKnown = std::any_of(m_devices.cbegin(), m_devices.cend(), [&device](const Device &known) {
+            return known.udi() == device.udi();
+        });
+        if (!isKnown) {
+            fresh.append(device);
+        }
+    }
+
+    if (fresh.isEmpty()) {
+        return;
+    }
+
+    for (Device &device : fresh) {
+        device.preload();
+    }
+
+    beginInsertRows(QModelIndex(), m_devices.size(), m_devices.size() + fresh.size() - 1);
+    m_devices += fresh;
+    endInsertRows();
+}
+
+Solid::Device Solid::DevicesModel::device(const QModelIndex &index) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_devices.size()) {
+        return Device();
+    }
+
+    return m_devices.at(index.row());
+}
+
+void Solid::DevicesModel::addDevice(const QString &udi)
+{
+    for (const Device &device : std::as_const(m_devices)) {
+        if (device.udi() == udi) {
+            return;
+        }
+    }
+
+    Device device(udi);
+    device.preload();
+
+    beginInsertRows(QModelIndex(), m_devices.size(), m_devices.size());
+    m_devices.append(device);
+    endInsertRows();
+}
+
+void Solid::DevicesModel::removeDevice(const QString &udi)
+{
+    for (int row = 0; row < m_devices.size(); ++row) {
+        if (m_devices.at(row).udi() == udi) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_devices.removeAt(row);
+            endRemoveRows();
+            return;
+        }
+    }
+}
+
+#include "moc_devicesmodel.cpp"
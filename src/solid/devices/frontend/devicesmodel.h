@@ -0,0 +1,90 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_DEVICESMODEL_H
+#define SOLID_DEVICESMODEL_H
+
+#include <QAbstractListModel>
+
+#include <solid/solid_export.h>
+
+#include <solid/device.h>
+#include <solid/devicequerycursor.h>
+#include <solid/predicate.h>
+
+namespace Solid
+{
+/**
+ * @class Solid::DevicesModel devicesmodel.h <Solid/DevicesModel>
+ *
+ * A list model of the devices in the system, optionally filtered by a
+ * predicate.
+ *
+ * The model is populated once from the frontend registry and then updated
+ * row-by-row from the notifier deltas, so consumers showing a device list
+ * no longer re-query on every hotplug event; the query cost is paid once
+ * per process instead of once per client refresh.
+ *
+ * Rows are delivered page-wise through the standard fetchMore() protocol:
+ * the first page is available immediately and item views pull the rest in
+ * as the user scrolls, so the first paint does not wait for every match
+ * to be constructed.
+ *
+ * @since 6.8
+ */
+class SOLID_EXPORT DevicesModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    enum Role {
+        UdiRole = Qt::UserRole + 1,
+        VendorRole,
+        ProductRole,
+        IconRole,
+        EmblemsRole,
+        DescriptionRole,
+    };
+
+    /**
+     * Creates a model of all devices in the system.
+     *
+     * @param parent the parent object
+     */
+    explicit DevicesModel(QObject *parent = nullptr);
+
+    /**
+     * Creates a model of the devices matching @p predicate.
+     *
+     * @param predicate the predicate the listed devices must match
+     * @param parent the parent object
+     */
+    explicit DevicesModel(const Predicate &predicate, QObject *parent = nullptr);
+
+    ~DevicesModel() override;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    /**
+     * The device behind the given index.
+     */
+    Device device(const QModelIndex &index) const;
+
+private:
+    void populate();
+    void addDevice(const QString &udi);
+    void removeDevice(const QString &udi);
+
+    Predicate m_predicate;
+    DeviceQueryCursor m_cursor;
+    QList<Device> m_devices;
+};
+}
+
+#endif
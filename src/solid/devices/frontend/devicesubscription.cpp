@@ -0,0 +1,51 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "devicesubscription.h"
+
+#include "device.h"
+
+Solid::DeviceSubscription::DeviceSubscription(const Predicate &predicate, QObject *parent)
+    : QObject(parent)
+    , m_predicate(predicate)
+{
+}
+
+Solid::DeviceSubscription::~DeviceSubscription() = default;
+
+Solid::Predicate Solid::DeviceSubscription::predicate() const
+{
+    return m_predicate;
+}
+
+void Solid::DeviceSubscription::evaluateAdded(const Device &device, quint32 handle)
+{
+    if (m_predicate.matches(device)) {
+        m_matched.insert(handle);
+        Q_EMIT deviceAdded(device.udi());
+    }
+}
+
+void Solid::DeviceSubscription::evaluateRemoved(const QString &udi, quint32 handle)
+{
+    if (m_matched.remove(handle)) {
+        Q_EMIT deviceRemoved(udi);
+    }
+}
+
+void Solid::DeviceSubscription::evaluateChanged(const Device &device, quint32 handle)
+{
+    if (m_predicate.matches(device)) {
+        if (!m_matched.contains(handle)) {
+            m_matched.insert(handle);
+            Q_EMIT deviceAdded(device.udi());
+        }
+    } else {
+        evaluateRemoved(device.udi(), handle);
+    }
+}
+
+#include "moc_devicesubscription.cpp"
@@ -0,0 +1,83 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_DEVICESUBSCRIPTION_H
+#define SOLID_DEVICESUBSCRIPTION_H
+
+#include <QObject>
+#include <QSet>
+
+#include <solid/solid_export.h>
+
+#include <solid/predicate.h>
+
+namespace Solid
+{
+class Device;
+class DeviceManagerPrivate;
+class DeviceNotifier;
+
+/**
+ * @class Solid::DeviceSubscription devicesubscription.h <Solid/DeviceSubscription>
+ *
+ * A predicate-filtered view on the device notifier.
+ *
+ * Instances are obtained from DeviceNotifier::subscribe(). The predicate is
+ * evaluated once, centrally, when a device appears; the subscription's
+ * signals fire only for matching devices, so clients no longer have to
+ * listen to the raw added/removed firehose and re-evaluate their own
+ * predicate on every hotplug event.
+ *
+ * Removals are reported for the devices that matched the predicate while
+ * they were present.
+ *
+ * @since 6.8
+ */
+class SOLID_EXPORT DeviceSubscription : public QObject
+{
+    Q_OBJECT
+public:
+    ~DeviceSubscription() override;
+
+    /**
+     * The predicate devices are matched against.
+     */
+    Predicate predicate() const;
+
+Q_SIGNALS:
+    /**
+     * This signal is emitted when a device matching the predicate appears
+     * in the underlying system.
+     *
+     * @param udi the new device UDI
+     */
+    void deviceAdded(const QString &udi);
+
+    /**
+     * This signal is emitted when a previously matching device disappears
+     * from the underlying system.
+     *
+     * @param udi the old device UDI
+     */
+    void deviceRemoved(const QString &udi);
+
+private:
+    friend class DeviceManagerPrivate;
+    friend class DeviceNotifier;
+
+    DeviceSubscription(const Predicate &predicate, QObject *parent);
+    void evaluateAdded(const Device &device, quint32 handle);
+    void evaluateRemoved(const QString &udi, quint32 handle);
+    void evaluateChanged(const Device &device, quint32 handle);
+
+    Predicate m_predicate;
+    // Solid::DeviceHandle values (udistringpool_p.h): the match set hashes
+    // integers instead of UDI strings during hotplug storms
+    QSet<quint32> m_matched;
+};
+}
+
+#endif
@@ -10,11 +10,38 @@
 
 #include <solid/devices/ifaces/genericinterface.h>
 
+#include <QHash>
+#include <QMetaMethod>
+#include <QMutex>
+
+namespace
+{
+/* Process-wide property name table; ids are indices into names and are
+ * never recycled, so they can be passed around without the table lock. */
+struct PropertyIdTable {
+    QMutex mutex;
+    QHash<QString, int> ids;
+    QStringList names;
+};
+}
+
+Q_GLOBAL_STATIC(PropertyIdTable, s_propertyIds)
+
 Solid::GenericInterface::GenericInterface(QObject *backendObject)
     : DeviceInterface(*new GenericInterfacePrivate(), backendObject)
 {
     if (backendObject) {
-        connect(backendObject, SIGNAL(propertyChanged(QMap<QString, int>)), this, SIGNAL(propertyChanged(QMap<QString, int>)));
+        /* Backends emitting the typed change stream don't emit the legacy
+         * name-keyed map anymore; rebuild it here, on demand only. */
+        static const char typedSignature[] = "propertyEventsChanged(QList<Solid::GenericInterface::PropertyChangeEvent>)";
+        if (backendObject->metaObject()->indexOfSignal(typedSignature) != -1) {
+            connect(backendObject,
+                    SIGNAL(propertyEventsChanged(QList<Solid::GenericInterface::PropertyChangeEvent>)),
+                    this,
+                    SLOT(_k_forwardPropertyEvents(QList<Solid::GenericInterface::PropertyChangeEvent>)));
+        } else {
+            connect(backendObject, SIGNAL(propertyChanged(QMap<QString, int>)), this, SIGNAL(propertyChanged(QMap<QString, int>)));
+        }
         connect(backendObject, SIGNAL(conditionRaised(QString, QString)), this, SIGNAL(conditionRaised(QString, QString)));
     }
 }
@@ -41,4 +68,41 @@ bool Solid::GenericInterface::propertyExists(const QString &key) const
     return_SOLID_CALL(Ifaces::GenericInterface *, d->backendObject(), false, propertyExists(key));
 }
 
+int Solid::GenericInterface::propertyId(const QString &name)
+{
+    PropertyIdTable *table = s_propertyIds();
+    QMutexLocker locker(&table->mutex);
+
+    const auto it = table->ids.constFind(name);
+    if (it != table->ids.constEnd()) {
+        return it.value();
+    }
+
+    const int id = table->names.size();
+    table->names.append(name);
+    table->ids.insert(name, id);
+    return id;
+}
+
+QString Solid::GenericInterface::propertyName(int id)
+{
+    PropertyIdTable *table = s_propertyIds();
+    QMutexLocker locker(&table->mutex);
+    return table->names.value(id);
+}
+
+void Solid::GenericInterface::_k_forwardPropertyEvents(const QList<PropertyChangeEvent> &events)
+{
+    Q_EMIT propertyEventsChanged(events);
+
+    static const QMetaMethod legacySignal = QMetaMethod::fromSignal(&GenericInterface::propertyChanged);
+    if (isSignalConnected(legacySignal)) {
+        QMap<QString, int> changes;
+        for (const PropertyChangeEvent &event : events) {
+            changes.insert(propertyName(event.propertyId), event.change);
+        }
+        Q_EMIT propertyChanged(changes);
+    }
+}
+
 #include "moc_genericinterface.cpp"
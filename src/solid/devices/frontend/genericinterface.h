@@ -7,6 +7,7 @@
 #ifndef SOLID_GENERICINTERFACE_H
 #define SOLID_GENERICINTERFACE_H
 
+#include <QList>
 #include <QMap>
 #include <QVariant>
 
@@ -51,6 +52,20 @@ public:
     };
     Q_ENUM(PropertyChange)
 
+    /**
+     * Describes one property change using an interned integer property id
+     * instead of the property name.
+     *
+     * @see propertyId(), propertyName(), propertyEventsChanged()
+     * @since 6.8
+     */
+    struct PropertyChangeEvent {
+        /** Id of the changed property, resolvable with propertyName() */
+        int propertyId;
+        /** The kind of change, one of PropertyChange */
+        int change;
+    };
+
 private:
     /**
      * Creates a new GenericInterface object.
@@ -119,6 +134,31 @@ public:
      */
     bool propertyExists(const QString &key) const;
 
+    /**
+     * Returns the interned integer id for a property name.
+     *
+     * Ids are allocated from a process-wide string table on first use and
+     * stay valid for the lifetime of the process, so backends and
+     * listeners can exchange property changes without building name-keyed
+     * maps on every emission.
+     *
+     * @param name the property name
+     * @return the id of the property
+     * @since 6.8
+     * @see propertyName()
+     */
+    static int propertyId(const QString &name);
+
+    /**
+     * Returns the property name behind an interned integer id.
+     *
+     * @param id a property id previously returned by propertyId()
+     * @return the property name, or an empty string for an unknown id
+     * @since 6.8
+     * @see propertyId()
+     */
+    static QString propertyName(int id);
+
 Q_SIGNALS:
     /**
      * This signal is emitted when a property is changed in the device.
@@ -130,6 +170,20 @@ Q_SIGNALS:
      */
     void propertyChanged(const QMap<QString, int> &changes);
 
+    /**
+     * The typed counterpart of propertyChanged(), describing the changes
+     * with interned integer property ids instead of a name-keyed map.
+     *
+     * Backends supporting the typed stream emit only this signal; the
+     * name-keyed map of propertyChanged() is then rebuilt on demand, and
+     * only while that signal actually has listeners.
+     *
+     * @param events the property changes that occurred in the device
+     * @since 6.8
+     * @see propertyId(), propertyName()
+     */
+    void propertyEventsChanged(const QList<Solid::GenericInterface::PropertyChangeEvent> &events);
+
     /**
      * This signal is emitted when an event occurred in the device.
      * For example when a button is pressed.
@@ -138,6 +192,9 @@ Q_SIGNALS:
      * @param reason a message explaining why the condition has been raised
      */
     void conditionRaised(const QString &condition, const QString &reason);
+
+private Q_SLOTS:
+    SOLID_NO_EXPORT void _k_forwardPropertyEvents(const QList<Solid::GenericInterface::PropertyChangeEvent> &events);
 };
 }
 
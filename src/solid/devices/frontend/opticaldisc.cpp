@@ -13,6 +13,14 @@
 Solid::OpticalDisc::OpticalDisc(QObject *backendObject)
     : StorageVolume(*new OpticalDiscPrivate(), backendObject)
 {
+    /* Only backends probing asynchronously provide the completion signal */
+    static const char probeSignature[] = "availableContentChanged(Solid::OpticalDisc::ContentTypes)";
+    if (backendObject && backendObject->metaObject()->indexOfSignal(probeSignature) != -1) {
+        connect(backendObject,
+                SIGNAL(availableContentChanged(Solid::OpticalDisc::ContentTypes)),
+                this,
+                SIGNAL(availableContentChanged(Solid::OpticalDisc::ContentTypes)));
+    }
 }
 
 Solid::OpticalDisc::~OpticalDisc()
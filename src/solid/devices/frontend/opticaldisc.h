@@ -182,6 +182,22 @@ public:
      * @return the capacity of the disc in bytes
      */
     qulonglong capacity() const;
+
+Q_SIGNALS:
+    /**
+     * This signal is emitted when a background content probe finished and
+     * refined the result of availableContent().
+     *
+     * Backends probing disc structures asynchronously return the readily
+     * known content flags from availableContent() and deliver the full
+     * result (video disc types in particular) through this signal once
+     * the probe completed.
+     *
+     * @param content the flag set indicating the available contents
+     * @since 6.8
+     * @see availableContent()
+     */
+    void availableContentChanged(Solid::OpticalDisc::ContentTypes content);
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(OpticalDisc::ContentTypes)
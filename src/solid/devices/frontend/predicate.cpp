@@ -6,25 +6,122 @@
 
 #include "predicate.h"
 
+#include "propertyindex_p.h"
+#include "solidstatistics_p.h"
+
+#include <QDataStream>
 #include <QMetaEnum>
 #include <QSequentialIterable>
 #include <QStringList>
 #include <solid/device.h>
 
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <utility>
+
 namespace Solid
 {
-class Predicate::Private
+/* Flat evaluation program produced by Predicate::compile(). Each node of the
+ * predicate tree becomes a step; conjunctions and disjunctions reference
+ * their operands by index. Properties and converted comparison values are
+ * resolved at compile time through the static property index, so no
+ * meta-object string lookup is left on the evaluation path. */
+class CompiledPredicate
+{
+public:
+    struct Step {
+        Predicate::Type type;
+        DeviceInterface::Type ifaceType;
+        QVariant value;
+        Predicate::ComparisonOperator compOperator;
+        int operand1 = -1;
+        int operand2 = -1;
+
+        /* Static cost weight of evaluating this step, operand subtrees
+         * included; see compileNode() for the leaf weights. */
+        int cost = 1;
+
+        /* Resolved at compile time from the static property index; invalid
+         * when the interface has no property of that name, which makes the
+         * check never match, as before. */
+        QMetaProperty metaProp;
+        QVariant expected;
+
+        /* Live match statistics: how often this step ran and how often it
+         * held. They drive the operand ordering in orderOperands(). The
+         * program is shared by every thread evaluating the predicate, so
+         * the counters are atomic; relaxed ordering is all the heuristic
+         * needs, a lost or late increment only delays the reordering. */
+        mutable std::atomic<quint32> evaluations{0};
+        mutable std::atomic<quint32> matched{0};
+
+        /* std::atomic is not copyable; spell out the copies QList needs,
+         * carrying the counts over so growing the list mid-compile does
+         * not reset the statistics */
+        Step() = default;
+        Step(const Step &other)
+            : type(other.type)
+            , ifaceType(other.ifaceType)
+            , value(other.value)
+            , compOperator(other.compOperator)
+            , operand1(other.operand1)
+            , operand2(other.operand2)
+            , cost(other.cost)
+            , metaProp(other.metaProp)
+            , expected(other.expected)
+            , evaluations(other.evaluations.load(std::memory_order_relaxed))
+            , matched(other.matched.load(std::memory_order_relaxed))
+        {
+        }
+        Step &operator=(const Step &other)
+        {
+            type = other.type;
+            ifaceType = other.ifaceType;
+            value = other.value;
+            compOperator = other.compOperator;
+            operand1 = other.operand1;
+            operand2 = other.operand2;
+            cost = other.cost;
+            metaProp = other.metaProp;
+            expected = other.expected;
+            evaluations.store(other.evaluations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            matched.store(other.matched.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+    };
+
+    QList<Step> steps;
+    int root = -1;
+
+    bool evaluate(int index, const Device &device) const;
+    void orderOperands(int &first, int &second, bool conjunction) const;
+};
+
+class Predicate::Private : public QSharedData
 {
 public:
     Private()
         : isValid(false)
         , type(PropertyCheck)
         , compOperator(Predicate::Equals)
-        , operand1(nullptr)
-        , operand2(nullptr)
     {
     }
 
+    Private(const Private &other)
+        : QSharedData(other)
+        , isValid(other.isValid)
+        , type(other.type)
+        , ifaceType(other.ifaceType)
+        , property(other.property)
+        , value(other.value)
+        , compOperator(other.compOperator)
+        , operand1(other.operand1)
+        , operand2(other.operand2)
+    {
+        // the compiled program is not copied; the detached copy recompiles lazily
+    }
+
     bool isValid;
     Type type;
 
@@ -33,9 +130,207 @@ public:
     QVariant value;
     Predicate::ComparisonOperator compOperator;
 
-    Predicate *operand1;
-    Predicate *operand2;
+    /* The operand subtrees are held by value; nodes are immutable once
+     * composed, so sharing them beats the former owned deep copies, and
+     * building a big disjunction costs one Private per node instead of a
+     * Private plus two heap-allocated Predicate wrappers. */
+    std::optional<Predicate> operand1;
+    std::optional<Predicate> operand2;
+
+    /* Lazily derived state, shared by every copy of this Private. Copies
+     * can evaluate the same predicate from several threads at once (a
+     * DeviceQueryJob worker next to its caller, say), so both caches are
+     * published with a compare-and-swap: the first thread to finish
+     * installs its result, later threads discard theirs — overwriting an
+     * installed program could pull it out from under a running
+     * evaluate(). */
+    mutable std::atomic<CompiledPredicate *> compiled = nullptr;
+    mutable std::atomic<QSet<DeviceInterface::Type> *> usedTypesCache = nullptr;
+
+    ~Private()
+    {
+        delete compiled.load(std::memory_order_acquire);
+        delete usedTypesCache.load(std::memory_order_acquire);
+    }
 };
+
+static QVariant convertExpectedValue(const QMetaProperty &metaProp, const QVariant &value)
+{
+    QVariant expected = value;
+
+    if (metaProp.isEnumType() && expected.userType() == QMetaType::QString) {
+        QMetaEnum metaEnum = metaProp.enumerator();
+        int enumValue = metaEnum.keysToValue(value.toString().toLatin1().constData());
+        if (enumValue >= 0) { // No value found for these keys, resetting expected to invalid
+            expected = QVariant(metaProp.metaType(), &enumValue);
+        } else {
+            expected = QVariant();
+        }
+    } else if (metaProp.isEnumType() && expected.userType() == QMetaType::Int) {
+        int expectedValue = expected.toInt();
+        expected = QVariant(metaProp.metaType(), &expectedValue);
+    }
+
+    return expected;
+}
+
+/* Below this many observations of both operands the written order is kept;
+ * the rates of a handful of devices are mostly noise. */
+static const quint32 kMinOrderingSamples = 32;
+
+/* Picks which commutative operand to evaluate first. A conjunction
+ * short-circuits on a miss and a disjunction on a hit, so the operand that
+ * settles the result cheaply should run first; the comparison below weighs
+ * the measured continuation rate of each operand against the static cost
+ * of the other. */
+void CompiledPredicate::orderOperands(int &first, int &second, bool conjunction) const
+{
+    const Step &a = steps.at(first);
+    const Step &b = steps.at(second);
+
+    const quint32 evalsA = a.evaluations.load(std::memory_order_relaxed);
+    const quint32 evalsB = b.evaluations.load(std::memory_order_relaxed);
+    if (evalsA < kMinOrderingSamples || evalsB < kMinOrderingSamples) {
+        return;
+    }
+
+    const double passA = double(a.matched.load(std::memory_order_relaxed)) / evalsA;
+    const double passB = double(b.matched.load(std::memory_order_relaxed)) / evalsB;
+
+    /* probability that evaluating this operand first does NOT settle the
+     * result: its pass rate for AND, its miss rate for OR */
+    const double contA = conjunction ? passA : 1.0 - passA;
+    const double contB = conjunction ? passB : 1.0 - passB;
+
+    if (b.cost + contB * a.cost < a.cost + contA * b.cost) {
+        std::swap(first, second);
+    }
+}
+
+bool CompiledPredicate::evaluate(int index, const Device &device) const
+{
+    const Step &step = steps.at(index);
+
+    bool result = false;
+
+    switch (step.type) {
+    case Predicate::Disjunction:
+    case Predicate::Conjunction: {
+        int first = step.operand1;
+        int second = step.operand2;
+        orderOperands(first, second, step.type == Predicate::Conjunction);
+
+        if (step.type == Predicate::Conjunction) {
+            result = evaluate(first, device) && evaluate(second, device);
+        } else {
+            result = evaluate(first, device) || evaluate(second, device);
+        }
+        break;
+    }
+    case Predicate::InterfaceCheck:
+        result = device.isDeviceInterface(step.ifaceType);
+        break;
+    case Predicate::PropertyCheck: {
+        const DeviceInterface *iface = device.asDeviceInterface(step.ifaceType);
+
+        if (iface == nullptr) {
+            break;
+        }
+
+        const QVariant value = step.metaProp.isReadable() ? step.metaProp.read(iface) : QVariant();
+        const QVariant &expected = step.expected;
+
+        if (step.compOperator == Predicate::Mask) {
+            bool v_ok;
+            int v = value.toInt(&v_ok);
+            bool e_ok;
+            int e = expected.toInt(&e_ok);
+
+            result = (e_ok && v_ok && (v & e));
+            break;
+        }
+
+        if (step.compOperator != Predicate::Equals) {
+            /* ordered comparisons; QVariant::compare() orders mixed numeric
+             * types without precision loss, and values it cannot order
+             * (Unordered) never match */
+            const QPartialOrdering order = QVariant::compare(value, expected);
+            switch (step.compOperator) {
+            case Predicate::GreaterThan:
+                result = order == QPartialOrdering::Greater;
+                break;
+            case Predicate::GreaterThanOrEqual:
+                result = order == QPartialOrdering::Greater || order == QPartialOrdering::Equivalent;
+                break;
+            case Predicate::LessThan:
+                result = order == QPartialOrdering::Less;
+                break;
+            case Predicate::LessThanOrEqual:
+                result = order == QPartialOrdering::Less || order == QPartialOrdering::Equivalent;
+                break;
+            default:
+                break;
+            }
+            break;
+        }
+
+        if (value == expected) {
+            result = true;
+            break;
+        }
+
+        // Make sure we can match single elements inside lists.
+        if (value.canConvert<QSequentialIterable>()) {
+            const auto iterable = value.value<QSequentialIterable>();
+            for (const auto &element : iterable) {
+                if (element == expected) {
+                    result = true;
+                    break;
+                }
+            }
+        }
+
+        break;
+    }
+    }
+
+    /* Note the second operand of a short-circuited node is skipped here as
+     * well, so its rates stay conditional on actually being reached — which
+     * is exactly the probability orderOperands() needs. */
+    step.evaluations.fetch_add(1, std::memory_order_relaxed);
+    if (result) {
+        step.matched.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+static int compileNode(const Predicate &predicate, CompiledPredicate *program)
+{
+    CompiledPredicate::Step step;
+    step.type = predicate.type();
+    step.ifaceType = predicate.interfaceType();
+    step.compOperator = predicate.comparisonOperator();
+
+    if (step.type == Predicate::Conjunction || step.type == Predicate::Disjunction) {
+        step.operand1 = compileNode(predicate.firstOperand(), program);
+        step.operand2 = compileNode(predicate.secondOperand(), program);
+        // upper bound: both operands run when no short-circuit happens
+        step.cost = program->steps.at(step.operand1).cost + program->steps.at(step.operand2).cost;
+    } else if (step.type == Predicate::PropertyCheck) {
+        step.value = predicate.matchingValue();
+        step.metaProp = PropertyIndex::property(step.ifaceType, predicate.propertyName().toLatin1());
+        step.expected = convertExpectedValue(step.metaProp, step.value);
+        /* A property check pulls in the interface wrapper and a meta-object
+         * property read; an interface check (cost 1) is a cached bit test.
+         * Timing the steps for real would cost about as much as running
+         * them, so a fixed weight has to do. */
+        step.cost = 8;
+    }
+
+    program->steps.append(step);
+    return program->steps.size() - 1;
+}
 }
 
 Solid::Predicate::Predicate()
@@ -44,11 +339,12 @@ Solid::Predicate::Predicate()
 }
 
 Solid::Predicate::Predicate(const Predicate &other)
-    : d(new Private())
+    : d(other.d)
 {
-    *this = other;
 }
 
+Solid::Predicate::Predicate(Predicate &&other) noexcept = default;
+
 Solid::Predicate::Predicate(const DeviceInterface::Type &ifaceType, const QString &property, const QVariant &value, ComparisonOperator compOperator)
     : d(new Private())
 {
@@ -93,46 +389,24 @@ Solid::Predicate::Predicate(const QString &ifaceName)
     }
 }
 
-Solid::Predicate::~Predicate()
-{
-    if (d->type != PropertyCheck && d->type != InterfaceCheck) {
-        delete d->operand1;
-        delete d->operand2;
-    }
-
-    delete d;
-}
+Solid::Predicate::~Predicate() = default;
 
 Solid::Predicate &Solid::Predicate::operator=(const Predicate &other)
 {
-    d->isValid = other.d->isValid;
-    d->type = other.d->type;
-
-    if (d->type != PropertyCheck && d->type != InterfaceCheck) {
-        Predicate *operand1 = new Predicate(*(other.d->operand1));
-        delete d->operand1;
-        d->operand1 = operand1;
-        Predicate *operand2 = new Predicate(*(other.d->operand2));
-        delete d->operand2;
-        d->operand2 = operand2;
-    } else {
-        d->ifaceType = other.d->ifaceType;
-        d->property = other.d->property;
-        d->value = other.d->value;
-        d->compOperator = other.d->compOperator;
-    }
-
+    d = other.d;
     return *this;
 }
 
+Solid::Predicate &Solid::Predicate::operator=(Predicate &&other) noexcept = default;
+
 Solid::Predicate Solid::Predicate::operator&(const Predicate &other)
 {
     Predicate result;
 
     result.d->isValid = true;
     result.d->type = Conjunction;
-    result.d->operand1 = new Predicate(*this);
-    result.d->operand2 = new Predicate(other);
+    result.d->operand1 = *this;
+    result.d->operand2 = other;
 
     return result;
 }
@@ -149,8 +423,8 @@ Solid::Predicate Solid::Predicate::operator|(const Predicate &other)
 
     result.d->isValid = true;
     result.d->type = Disjunction;
-    result.d->operand1 = new Predicate(*this);
-    result.d->operand2 = new Predicate(other);
+    result.d->operand1 = *this;
+    result.d->operand2 = other;
 
     return result;
 }
@@ -166,90 +440,67 @@ bool Solid::Predicate::isValid() const
     return d->isValid;
 }
 
-bool Solid::Predicate::matches(const Device &device) const
+void Solid::Predicate::compile() const
 {
-    if (!d->isValid) {
-        return false;
+    if (!d->isValid || d->compiled.load(std::memory_order_acquire)) {
+        return;
     }
 
-    switch (d->type) {
-    case Disjunction:
-        return d->operand1->matches(device) || d->operand2->matches(device);
-    case Conjunction:
-        return d->operand1->matches(device) && d->operand2->matches(device);
-    case PropertyCheck: {
-        const DeviceInterface *iface = device.asDeviceInterface(d->ifaceType);
-
-        if (iface != nullptr) {
-            const int index = iface->metaObject()->indexOfProperty(d->property.toLatin1().constData());
-            QMetaProperty metaProp = iface->metaObject()->property(index);
-            QVariant value = metaProp.isReadable() ? metaProp.read(iface) : QVariant();
-            QVariant expected = d->value;
-
-            if (metaProp.isEnumType() && expected.userType() == QMetaType::QString) {
-                QMetaEnum metaEnum = metaProp.enumerator();
-                int value = metaEnum.keysToValue(d->value.toString().toLatin1().constData());
-                if (value >= 0) { // No value found for these keys, resetting expected to invalid
-                    expected = QVariant(metaProp.metaType(), &value);
-                } else {
-                    expected = QVariant();
-                }
-            } else if (metaProp.isEnumType() && expected.userType() == QMetaType::Int) {
-                int expectedValue = expected.toInt();
-                expected = QVariant(metaProp.metaType(), &expectedValue);
-            }
-
-            if (d->compOperator == Mask) {
-                bool v_ok;
-                int v = value.toInt(&v_ok);
-                bool e_ok;
-                int e = expected.toInt(&e_ok);
+    auto program = std::make_unique<CompiledPredicate>();
+    program->root = compileNode(*this, program.get());
 
-                return (e_ok && v_ok && (v & e));
-            }
-
-            if (value == expected) {
-                return true;
-            }
+    CompiledPredicate *expected = nullptr;
+    if (d->compiled.compare_exchange_strong(expected, program.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+        program.release(); // published; now owned by the Private
+    }
+}
 
-            // Make sure we can match single elements inside lists.
-            if (value.canConvert<QSequentialIterable>()) {
-                const auto iterable = value.value<QSequentialIterable>();
-                for (const auto &element : iterable) {
-                    if (element == expected) {
-                        return true;
-                    }
-                }
-            }
-        }
-        break;
+bool Solid::Predicate::matches(const Device &device) const
+{
+    if (!d->isValid) {
+        return false;
     }
-    case InterfaceCheck:
-        return device.isDeviceInterface(d->ifaceType);
+
+    const CompiledPredicate *program = d->compiled.load(std::memory_order_acquire);
+    if (!program) {
+        compile();
+        program = d->compiled.load(std::memory_order_acquire);
     }
 
-    return false;
+    Stats::add(Stats::counters().predicateEvaluations);
+
+    return program->evaluate(program->root, device);
 }
 
 QSet<Solid::DeviceInterface::Type> Solid::Predicate::usedTypes() const
 {
-    QSet<DeviceInterface::Type> res;
+    const QSet<DeviceInterface::Type> *cached = d->usedTypesCache.load(std::memory_order_acquire);
+    if (!cached) {
+        auto res = std::make_unique<QSet<DeviceInterface::Type>>();
+
+        if (d->isValid) {
+            switch (d->type) {
+            case Disjunction:
+            case Conjunction:
+                *res += d->operand1->usedTypes();
+                *res += d->operand2->usedTypes();
+                break;
+            case PropertyCheck:
+            case InterfaceCheck:
+                *res << d->ifaceType;
+                break;
+            }
+        }
 
-    if (d->isValid) {
-        switch (d->type) {
-        case Disjunction:
-        case Conjunction:
-            res += d->operand1->usedTypes();
-            res += d->operand2->usedTypes();
-            break;
-        case PropertyCheck:
-        case InterfaceCheck:
-            res << d->ifaceType;
-            break;
+        QSet<DeviceInterface::Type> *expected = nullptr;
+        if (d->usedTypesCache.compare_exchange_strong(expected, res.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            cached = res.release();
+        } else {
+            cached = expected; // another thread published first
         }
     }
 
-    return res;
+    return *cached;
 }
 
 QString Solid::Predicate::toString() const
@@ -303,14 +554,155 @@ QString Solid::Predicate::toString() const
         }
 
         QString str_operator = QStringLiteral("==");
-        if (d->compOperator != Equals) {
+        switch (d->compOperator) {
+        case Equals:
+            break;
+        case Mask:
             str_operator = QStringLiteral(" &");
+            break;
+        case GreaterThan:
+            str_operator = QStringLiteral(">");
+            break;
+        case GreaterThanOrEqual:
+            str_operator = QStringLiteral(">=");
+            break;
+        case LessThan:
+            str_operator = QStringLiteral("<");
+            break;
+        case LessThanOrEqual:
+            str_operator = QStringLiteral("<=");
+            break;
         }
 
         return QStringLiteral("%1.%2 %3 %4").arg(ifaceName, d->property, str_operator, value);
     }
 }
 
+/* Binary predicate encoding: a fixed header (magic, format version) followed
+ * by the tree in prefix order. Each node starts with its type tag; composite
+ * nodes are followed by their two operands, leaves by their payload. The
+ * stream version is pinned so peers built against different Qt 6 releases
+ * agree on the QVariant encoding. */
+namespace
+{
+const quint32 s_predicateMagic = 0x53505244; // 'SPRD'
+const quint32 s_predicateVersion = 1;
+
+/* refuse absurdly nested input instead of recursing into the stack limit */
+const int s_predicateMaxDepth = 64;
+
+void encodeNode(QDataStream &out, const Solid::Predicate &predicate)
+{
+    out << quint8(predicate.type());
+
+    switch (predicate.type()) {
+    case Solid::Predicate::Conjunction:
+    case Solid::Predicate::Disjunction:
+        encodeNode(out, predicate.firstOperand());
+        encodeNode(out, predicate.secondOperand());
+        break;
+    case Solid::Predicate::InterfaceCheck:
+        out << qint32(predicate.interfaceType());
+        break;
+    case Solid::Predicate::PropertyCheck:
+        out << qint32(predicate.interfaceType());
+        out << predicate.propertyName();
+        out << predicate.matchingValue();
+        out << quint8(predicate.comparisonOperator());
+        break;
+    }
+}
+
+Solid::Predicate decodeNode(QDataStream &in, int depth)
+{
+    using Solid::DeviceInterface;
+    using Solid::Predicate;
+
+    if (depth > s_predicateMaxDepth || in.status() != QDataStream::Ok) {
+        return Predicate();
+    }
+
+    quint8 type;
+    in >> type;
+
+    switch (type) {
+    case Predicate::Conjunction:
+    case Predicate::Disjunction: {
+        Predicate first = decodeNode(in, depth + 1);
+        if (!first.isValid()) {
+            return Predicate();
+        }
+        Predicate second = decodeNode(in, depth + 1);
+        if (!second.isValid()) {
+            return Predicate();
+        }
+        return type == quint8(Predicate::Conjunction) ? (first & second) : (first | second);
+    }
+    case Predicate::InterfaceCheck: {
+        qint32 ifaceType;
+        in >> ifaceType;
+        if (in.status() != QDataStream::Ok //
+            || DeviceInterface::typeToString(DeviceInterface::Type(ifaceType)).isEmpty()) {
+            return Predicate();
+        }
+        return Predicate(DeviceInterface::Type(ifaceType));
+    }
+    case Predicate::PropertyCheck: {
+        qint32 ifaceType;
+        QString property;
+        QVariant value;
+        quint8 compOperator;
+        in >> ifaceType >> property >> value >> compOperator;
+        /* clang-format off */
+        if (in.status() != QDataStream::Ok
+            || DeviceInterface::typeToString(DeviceInterface::Type(ifaceType)).isEmpty()
+            || property.isEmpty()
+            || compOperator > quint8(Predicate::LessThanOrEqual)) { /* clang-format on */
+            return Predicate();
+        }
+        return Predicate(DeviceInterface::Type(ifaceType), property, value, Predicate::ComparisonOperator(compOperator));
+    }
+    default:
+        return Predicate();
+    }
+}
+}
+
+QByteArray Solid::Predicate::toBinary() const
+{
+    if (!d->isValid) {
+        return QByteArray();
+    }
+
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << s_predicateMagic << s_predicateVersion;
+    encodeNode(out, *this);
+
+    return data;
+}
+
+Solid::Predicate Solid::Predicate::fromBinary(const QByteArray &data)
+{
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != s_predicateMagic || version != s_predicateVersion) {
+        return Predicate();
+    }
+
+    Predicate result = decodeNode(in, 0);
+    if (in.status() != QDataStream::Ok || !in.atEnd()) {
+        return Predicate();
+    }
+
+    return result;
+}
+
 Solid::Predicate::Type Solid::Predicate::type() const
 {
     return d->type;
@@ -8,6 +8,7 @@
 #define SOLID_PREDICATE_H
 
 #include <QSet>
+#include <QSharedDataPointer>
 #include <QVariant>
 
 #include <solid/solid_export.h>
@@ -57,6 +58,8 @@ class Device;
  * but boils down to:
  *
  * - a single comparison is written as `<interface>.<property> == <value>`
+ * - a single ordered comparison is written as `<interface>.<property> > <value>`
+ *   (and likewise for `>=`, `<` and `<=`)
  * - a single bitmask check is written as `<interface>.<property> & <value>`
  * - a conjunction is written as `[ <predicate> AND <predicate> ]`
  * - a disjunction is written as `[ <predicate> OR <predicate> ]`
@@ -71,8 +74,16 @@ public:
      *
      * - Equals, the property and the value will match for strict equality
      * - Mask, the property and the value will match if the bitmasking is not null
+     * - GreaterThan, the property is strictly greater than the value (@since 6.8)
+     * - GreaterThanOrEqual, the property is greater than or equal to the value (@since 6.8)
+     * - LessThan, the property is strictly less than the value (@since 6.8)
+     * - LessThanOrEqual, the property is less than or equal to the value (@since 6.8)
+     *
+     * The ordered comparisons follow QVariant::compare(); a property that
+     * is not ordered relative to the value (for instance a string against
+     * a number) never matches.
      */
-    enum ComparisonOperator { Equals, Mask };
+    enum ComparisonOperator { Equals, Mask, GreaterThan, GreaterThanOrEqual, LessThan, LessThanOrEqual };
 
     /**
      * The predicate type which controls how the predicate is handled
@@ -92,10 +103,23 @@ public:
     /**
      * Copy constructor.
      *
+     * The predicate tree is implicitly shared, so copying is cheap.
+     *
      * @param other the predicate to copy
      */
     Predicate(const Predicate &other);
 
+    /**
+     * Move constructor.
+     *
+     * The moved-from predicate is left in a state in which the only valid
+     * operations are destruction and assignment.
+     *
+     * @param other the predicate to move from
+     * @since 6.8
+     */
+    Predicate(Predicate &&other) noexcept;
+
     /**
      * Constructs a predicate matching the value of a property in
      * a given device interface.
@@ -145,6 +169,18 @@ public:
      */
     Predicate &operator=(const Predicate &other);
 
+    /**
+     * Move assignment operator.
+     *
+     * The moved-from predicate is left in a state in which the only valid
+     * operations are destruction and assignment.
+     *
+     * @param other the predicate to move from
+     * @return this predicate after having assigned 'other' to it
+     * @since 6.8
+     */
+    Predicate &operator=(Predicate &&other) noexcept;
+
     /**
      * 'And' operator.
      *
@@ -186,6 +222,19 @@ public:
      */
     bool isValid() const;
 
+    /**
+     * Compiles the predicate into a flat evaluation program.
+     *
+     * Interface type gates, property indexes and converted comparison
+     * values are resolved once instead of by string-based reflection on
+     * every matches() call, which pays off when the same predicate is
+     * evaluated against many devices. Calling this is optional; matches()
+     * compiles the predicate on first use.
+     *
+     * @since 6.8
+     */
+    void compile() const;
+
     /**
      * Checks if a device matches the predicate.
      *
@@ -217,6 +266,34 @@ public:
      */
     static Predicate fromString(const QString &predicate);
 
+    /**
+     * Serializes the predicate to a compact binary form.
+     *
+     * The encoding is versioned and independent of the Qt version the
+     * peer was built against, so it is suitable for shipping predicates
+     * across process boundaries or caching them in configuration.
+     * Decoding it with fromBinary() is a single pass over the tree and
+     * never touches the predicate parser, unlike fromString().
+     *
+     * An invalid predicate serializes to an empty byte array.
+     *
+     * @return the serialized form of the predicate
+     * @since 6.8
+     */
+    QByteArray toBinary() const;
+
+    /**
+     * Reconstructs a predicate from toBinary() output.
+     *
+     * The data is validated while decoding; truncated, corrupt,
+     * trailing-garbage or unknown-version input yields Predicate().
+     *
+     * @param data a byte array produced by toBinary()
+     * @return the decoded predicate if the data is well-formed, Predicate() otherwise
+     * @since 6.8
+     */
+    static Predicate fromBinary(const QByteArray &data);
+
     /**
      * Retrieves the predicate type, used to determine how to handle the predicate
      *
@@ -281,7 +358,7 @@ public:
 
 private:
     class Private;
-    Private *const d;
+    QSharedDataPointer<Private> d;
 };
 }
 
@@ -22,25 +22,49 @@ Solid::Processor::~Processor()
 int Solid::Processor::number() const
 {
     Q_D(const Processor);
-    return_SOLID_CALL(Ifaces::Processor *, d->backendObject(), 0, number());
+    return_SOLID_CACHED_CALL(Ifaces::Processor *, d, 0, number());
 }
 
 int Solid::Processor::maxSpeed() const
 {
     Q_D(const Processor);
-    return_SOLID_CALL(Ifaces::Processor *, d->backendObject(), 0, maxSpeed());
+    return_SOLID_CACHED_CALL(Ifaces::Processor *, d, 0, maxSpeed());
 }
 
 bool Solid::Processor::canChangeFrequency() const
 {
     Q_D(const Processor);
-    return_SOLID_CALL(Ifaces::Processor *, d->backendObject(), false, canChangeFrequency());
+    return_SOLID_CACHED_CALL(Ifaces::Processor *, d, false, canChangeFrequency());
 }
 
 Solid::Processor::InstructionSets Solid::Processor::instructionSets() const
 {
     Q_D(const Processor);
-    return_SOLID_CALL(Ifaces::Processor *, d->backendObject(), InstructionSets(), instructionSets());
+    return_SOLID_CACHED_CALL(Ifaces::Processor *, d, InstructionSets(), instructionSets());
+}
+
+int Solid::Processor::packageId() const
+{
+    Q_D(const Processor);
+    return_SOLID_CACHED_CALL(Ifaces::Processor *, d, -1, packageId());
+}
+
+int Solid::Processor::coreId() const
+{
+    Q_D(const Processor);
+    return_SOLID_CACHED_CALL(Ifaces::Processor *, d, -1, coreId());
+}
+
+QList<int> Solid::Processor::threadSiblings() const
+{
+    Q_D(const Processor);
+    return_SOLID_CACHED_CALL(Ifaces::Processor *, d, QList<int>(), threadSiblings());
+}
+
+QList<int> Solid::Processor::cacheSiblings(int level) const
+{
+    Q_D(const Processor);
+    return_SOLID_CACHED_CALL(Ifaces::Processor *, d, QList<int>(), cacheSiblings(level));
 }
 
 #include "moc_processor.cpp"
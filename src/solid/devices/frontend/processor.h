@@ -11,6 +11,8 @@
 
 #include <solid/deviceinterface.h>
 
+#include <QList>
+
 namespace Solid
 {
 class ProcessorPrivate;
@@ -28,6 +30,9 @@ class SOLID_EXPORT Processor : public DeviceInterface
     Q_PROPERTY(qulonglong maxSpeed READ maxSpeed)
     Q_PROPERTY(bool canChangeFrequency READ canChangeFrequency)
     Q_PROPERTY(InstructionSets instructionSets READ instructionSets)
+    Q_PROPERTY(int packageId READ packageId)
+    Q_PROPERTY(int coreId READ coreId)
+    Q_PROPERTY(QList<int> threadSiblings READ threadSiblings)
     Q_DECLARE_PRIVATE(Processor)
     friend class Device;
 
@@ -61,6 +66,11 @@ public:
         IntelSse42 = 0x100,
         Amd3DNow = 0x20,
         AltiVec = 0x40,
+        IntelAvx = 0x200, ///< @since 6.8
+        IntelAvx2 = 0x400, ///< @since 6.8
+        IntelAvx512 = 0x800, ///< AVX-512 foundation instructions @since 6.8
+        ArmNeon = 0x1000, ///< @since 6.8
+        ArmSve = 0x2000, ///< @since 6.8
     };
     Q_ENUM(InstructionSet)
 
@@ -118,6 +128,53 @@ public:
      * @see Solid::Processor::InstructionSet
      */
     InstructionSets instructionSets() const;
+
+    /**
+     * Retrieves the identifier of the physical package (socket) this
+     * processor belongs to.
+     *
+     * All processors sharing a package id sit on the same socket and
+     * typically share the last-level cache.
+     *
+     * @return the package identifier, or -1 if the backend has no
+     * topology information
+     * @since 6.8
+     */
+    int packageId() const;
+
+    /**
+     * Retrieves the identifier of the core this processor belongs to
+     * within its package.
+     *
+     * Several processors reporting the same package and core ids are
+     * hardware threads (SMT siblings) of one physical core.
+     *
+     * @return the core identifier, or -1 if the backend has no topology
+     * information
+     * @since 6.8
+     */
+    int coreId() const;
+
+    /**
+     * Retrieves the numbers of the processors sharing this processor's
+     * core, including this processor itself.
+     *
+     * @return the sibling processor numbers, or an empty list if the
+     * backend has no topology information
+     * @since 6.8
+     */
+    QList<int> threadSiblings() const;
+
+    /**
+     * Retrieves the numbers of the processors sharing this processor's
+     * level @p level cache.
+     *
+     * @param level the cache level, starting from 1
+     * @return the sharing processor numbers, or an empty list if the
+     * backend has no topology information
+     * @since 6.8
+     */
+    QList<int> cacheSiblings(int level) const;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Processor::InstructionSets)
@@ -0,0 +1,86 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "propertyindex_p.h"
+
+#include "battery.h"
+#include "block.h"
+#include "camera.h"
+#include "genericinterface.h"
+#include "networkshare.h"
+#include "opticaldisc.h"
+#include "opticaldrive.h"
+#include "portablemediaplayer.h"
+#include "processor.h"
+#include "storageaccess.h"
+#include "storagedrive.h"
+#include "storagevolume.h"
+
+#include <QHash>
+
+namespace
+{
+struct TypeMeta {
+    Solid::DeviceInterface::Type type;
+    const QMetaObject *metaObject;
+};
+
+// one entry per instantiable interface; must stay in sync with the
+// Type enum, like the type-name table in deviceinterface.cpp
+constexpr TypeMeta s_typeMetas[] = {
+    {Solid::DeviceInterface::GenericInterface, &Solid::GenericInterface::staticMetaObject},
+    {Solid::DeviceInterface::Processor, &Solid::Processor::staticMetaObject},
+    {Solid::DeviceInterface::Block, &Solid::Block::staticMetaObject},
+    {Solid::DeviceInterface::StorageAccess, &Solid::StorageAccess::staticMetaObject},
+    {Solid::DeviceInterface::StorageDrive, &Solid::StorageDrive::staticMetaObject},
+    {Solid::DeviceInterface::OpticalDrive, &Solid::OpticalDrive::staticMetaObject},
+    {Solid::DeviceInterface::StorageVolume, &Solid::StorageVolume::staticMetaObject},
+    {Solid::DeviceInterface::OpticalDisc, &Solid::OpticalDisc::staticMetaObject},
+    {Solid::DeviceInterface::Camera, &Solid::Camera::staticMetaObject},
+    {Solid::DeviceInterface::PortableMediaPlayer, &Solid::PortableMediaPlayer::staticMetaObject},
+    {Solid::DeviceInterface::Battery, &Solid::Battery::staticMetaObject},
+    {Solid::DeviceInterface::NetworkShare, &Solid::NetworkShare::staticMetaObject},
+};
+
+/* The hashes are filled from the moc-generated meta-objects on first use;
+ * from then on a lookup is one hash probe instead of a linear scan over
+ * the meta-object's string table. */
+struct PropertyTables {
+    QHash<QByteArray, QMetaProperty> byName[Solid::DeviceInterface::Last];
+
+    PropertyTables()
+    {
+        for (const TypeMeta &typeMeta : s_typeMetas) {
+            auto &table = byName[typeMeta.type];
+            // the whole inheritance chain, as indexOfProperty() searches it
+            for (int i = 0; i < typeMeta.metaObject->propertyCount(); ++i) {
+                const QMetaProperty prop = typeMeta.metaObject->property(i);
+                table.insert(QByteArray(prop.name()), prop);
+            }
+        }
+    }
+};
+}
+
+Q_GLOBAL_STATIC(PropertyTables, s_propertyTables)
+
+const QMetaObject *Solid::PropertyIndex::metaObjectForType(DeviceInterface::Type type)
+{
+    for (const TypeMeta &typeMeta : s_typeMetas) {
+        if (typeMeta.type == type) {
+            return typeMeta.metaObject;
+        }
+    }
+    return nullptr;
+}
+
+QMetaProperty Solid::PropertyIndex::property(DeviceInterface::Type type, const QByteArray &name)
+{
+    if (type < 0 || type >= DeviceInterface::Last) {
+        return QMetaProperty();
+    }
+    return s_propertyTables->byName[type].value(name);
+}
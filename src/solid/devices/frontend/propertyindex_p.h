@@ -0,0 +1,43 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_PROPERTYINDEX_P_H
+#define SOLID_PROPERTYINDEX_P_H
+
+#include <QMetaProperty>
+
+#include "deviceinterface.h"
+
+namespace Solid
+{
+/**
+ * Static property tables for the frontend interface classes.
+ *
+ * The set of interfaces and their properties is fixed when moc runs, so
+ * the name-to-property mapping is derived once per process from the
+ * staticMetaObjects and then served from a hash. Property resolution —
+ * compiling a predicate, mainly — no longer walks a meta-object's string
+ * table per lookup.
+ */
+namespace PropertyIndex
+{
+/**
+ * The meta-object of the frontend class implementing @p type, or nullptr
+ * for Unknown and Last.
+ */
+const QMetaObject *metaObjectForType(DeviceInterface::Type type);
+
+/**
+ * The property named @p name on the interface @p type; invalid if the
+ * type has no such property. The returned QMetaProperty carries the meta
+ * index, the type and the enum converter, ready for read() against an
+ * instance of the interface.
+ */
+QMetaProperty property(DeviceInterface::Type type, const QByteArray &name);
+}
+}
+
+#endif
@@ -0,0 +1,29 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "statistics.h"
+
+#include "solidstatistics_p.h"
+
+Solid::Statistics Solid::statistics()
+{
+    const Stats::Counters &c = Stats::counters();
+
+    Statistics snapshot;
+    snapshot.propertyCacheHits = c.propertyCacheHits.loadRelaxed();
+    snapshot.propertyCacheMisses = c.propertyCacheMisses.loadRelaxed();
+    snapshot.getAllCalls = c.getAllCalls.loadRelaxed();
+    snapshot.introspectCalls = c.introspectCalls.loadRelaxed();
+    snapshot.udevEnumerations = c.udevEnumerations.loadRelaxed();
+    snapshot.registeredDevices = c.registeredDevices.loadRelaxed();
+    snapshot.queries = c.queries.loadRelaxed();
+    snapshot.queryCacheHits = c.queryCacheHits.loadRelaxed();
+    snapshot.registryBytes = c.registryBytes.loadRelaxed();
+    snapshot.udisksPropertyCacheBytes = c.udisksPropertyCacheBytes.loadRelaxed();
+    snapshot.udevDeviceListBytes = c.udevDeviceListBytes.loadRelaxed();
+    snapshot.fstabCacheBytes = c.fstabCacheBytes.loadRelaxed();
+    return snapshot;
+}
@@ -0,0 +1,76 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_STATISTICS_H
+#define SOLID_STATISTICS_H
+
+#include <QtGlobal>
+
+#include <solid/solid_export.h>
+
+namespace Solid
+{
+/**
+ * @class Solid::Statistics statistics.h <Solid/Statistics>
+ *
+ * Snapshot of Solid's internal runtime counters.
+ *
+ * The counters are maintained process-wide with cheap atomic increments,
+ * so reading them at any time is safe and does not perturb the measured
+ * paths. All counts are cumulative since the process started; callers
+ * interested in rates should diff two snapshots.
+ *
+ * @see Solid::statistics()
+ * @since 6.8
+ */
+struct Statistics {
+    /** Property reads answered from the UDisks2 property cache. */
+    qint64 propertyCacheHits;
+    /** Property reads that had to go to the bus to fill the cache. */
+    qint64 propertyCacheMisses;
+    /** Properties.GetAll calls issued to udisksd. */
+    qint64 getAllCalls;
+    /** D-Bus introspection calls issued by the UDisks2 enumeration fallback. */
+    qint64 introspectCalls;
+    /** Full udev database enumerations. */
+    qint64 udevEnumerations;
+    /** Devices currently held in the frontend device registry. */
+    qint64 registeredDevices;
+    /** Predicate queries evaluated by the frontend. */
+    qint64 queries;
+    /** Predicate queries served from the memoized query cache. */
+    qint64 queryCacheHits;
+
+    /**
+     * Estimated bytes currently held by the frontend device registry.
+     *
+     * The byte figures below are estimates maintained by the owning
+     * subsystems, meant for attributing growth and verifying shrink work;
+     * they are not allocator-exact.
+     * @since 6.8
+     */
+    qint64 registryBytes;
+    /** Estimated bytes held by the UDisks2 per-device property caches. @since 6.8 */
+    qint64 udisksPropertyCacheBytes;
+    /** Estimated bytes held by the udev device verdict lists. @since 6.8 */
+    qint64 udevDeviceListBytes;
+    /** Estimated bytes held by the cached fstab/mtab tables. @since 6.8 */
+    qint64 fstabCacheBytes;
+};
+
+/**
+ * Returns a snapshot of Solid's runtime counters.
+ *
+ * Useful for diagnosing cache effectiveness and D-Bus traffic in
+ * production; see also the `solid-hardware benchmark` tool for active
+ * measurements.
+ *
+ * @since 6.8
+ */
+SOLID_EXPORT Statistics statistics();
+}
+
+#endif
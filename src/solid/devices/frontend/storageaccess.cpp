@@ -7,7 +7,10 @@
 #include "storageaccess.h"
 #include "storageaccess_p.h"
 
+#include "device_p.h"
 #include "soliddefs_p.h"
+#include "storagesetupjob.h"
+#include "storagespacewatcher_p.h"
 #include <solid/devices/ifaces/storageaccess.h>
 
 Solid::StorageAccess::StorageAccess(QObject *backendObject)
@@ -22,6 +25,25 @@ Solid::StorageAccess::StorageAccess(QObject *backendObject)
 
     connect(backendObject, SIGNAL(repairRequested(QString)), this, SIGNAL(repairRequested(QString)));
     connect(backendObject, SIGNAL(repairDone(Solid::ErrorType, QVariant, QString)), this, SIGNAL(repairDone(Solid::ErrorType, QVariant, QString)));
+
+    // Optional in backends: only those tracking operation progress provide it
+    if (backendObject->metaObject()->indexOfSignal("operationProgressChanged(QString,double,QString)") != -1) {
+        connect(backendObject, SIGNAL(operationProgressChanged(QString, double, QString)), this, SIGNAL(operationProgressChanged(QString, double, QString)));
+    }
+
+    // likewise only backends monitoring network shares provide this one
+    if (backendObject->metaObject()->indexOfSignal("reachabilityChanged(bool,QString)") != -1) {
+        connect(backendObject, SIGNAL(reachabilityChanged(bool, QString)), this, SIGNAL(reachabilityChanged(bool, QString)));
+    }
+
+    // space figures are maintained by the shared watcher, keyed by mount
+    // point; forward the announcements that concern this volume
+    connect(StorageSpaceWatcher::instance(), &StorageSpaceWatcher::spaceInfoChanged, this, [this](const QString &path, const SpaceInfo &info) {
+        Q_D(StorageAccess);
+        if (d->devicePrivate() && path == filePath()) {
+            Q_EMIT spaceInfoChanged(info, d->devicePrivate()->udi());
+        }
+    });
 }
 
 Solid::StorageAccess::StorageAccess(StorageAccessPrivate &dd, QObject *backendObject)
@@ -51,61 +73,82 @@ Solid::StorageAccess::~StorageAccess()
 bool Solid::StorageAccess::isAccessible() const
 {
     Q_D(const StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), false, isAccessible());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, false, isAccessible());
 }
 
 QString Solid::StorageAccess::filePath() const
 {
     Q_D(const StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), QString(), filePath());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, QString(), filePath());
 }
 
 bool Solid::StorageAccess::setup()
 {
     Q_D(StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), false, setup());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, false, setup());
 }
 
 bool Solid::StorageAccess::teardown()
 {
     Q_D(StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), false, teardown());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, false, teardown());
+}
+
+Solid::StorageSetupJob *Solid::StorageAccess::setupAll(const QList<Device> &devices, QObject *parent)
+{
+    return new StorageSetupJob(devices, parent);
 }
 
 bool Solid::StorageAccess::isIgnored() const
 {
     Q_D(const StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), true, isIgnored());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, true, isIgnored());
 }
 
 bool Solid::StorageAccess::isEncrypted() const
 {
     Q_D(const StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), false, isEncrypted());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, false, isEncrypted());
+}
+
+bool Solid::StorageAccess::isReachable() const
+{
+    Q_D(const StorageAccess);
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, true, isReachable());
+}
+
+Solid::StorageAccess::SpaceInfo Solid::StorageAccess::spaceInfo() const
+{
+    const QString path = filePath();
+    if (path.isEmpty()) {
+        return SpaceInfo();
+    }
+
+    return StorageSpaceWatcher::instance()->spaceInfo(path);
 }
 
 bool Solid::StorageAccess::canCheck() const
 {
     Q_D(const StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), false, canCheck());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, false, canCheck());
 }
 
 bool Solid::StorageAccess::check()
 {
     Q_D(StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), false, check());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, false, check());
 }
 
 bool Solid::StorageAccess::canRepair() const
 {
     Q_D(const StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), false, canRepair());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, false, canRepair());
 }
 
 bool Solid::StorageAccess::repair()
 {
     Q_D(StorageAccess);
-    return_SOLID_CALL(Ifaces::StorageAccess *, d->backendObject(), false, repair());
+    return_SOLID_CACHED_CALL(Ifaces::StorageAccess *, d, false, repair());
 }
 
 #include "moc_storageaccess.cpp"
@@ -17,6 +17,7 @@ namespace Solid
 {
 class StorageAccessPrivate;
 class Device;
+class StorageSetupJob;
 
 /**
  * @class Solid::StorageAccess storageaccess.h <Solid/StorageAccess>
@@ -116,6 +117,84 @@ public:
      */
     bool teardown();
 
+    /**
+     * Mounts several volumes concurrently.
+     *
+     * All setups are dispatched before any completion is awaited, so
+     * backends work on them in parallel; the returned job reports each
+     * volume's outcome as it settles and signals aggregate completion.
+     * Already mounted volumes settle immediately with no error, devices
+     * without a StorageAccess interface with an error.
+     *
+     * The job starts automatically and deletes itself once finished; see
+     * StorageSetupJob for the lifetime and result details.
+     *
+     * @param devices the volumes to mount
+     * @param parent the parent of the returned job
+     * @return a job tracking the aggregate operation
+     * @since 6.8
+     */
+    static StorageSetupJob *setupAll(const QList<Device> &devices, QObject *parent = nullptr);
+
+    /**
+     * Indicates whether the filesystem behind this volume currently
+     * responds to I/O.
+     *
+     * Local volumes always report true. For mounted network shares,
+     * backends may probe the mount in the background with a timeout; a
+     * share whose server stopped responding then reports false while
+     * remaining mounted, so file managers can skip or grey it out
+     * without issuing a blocking stat() themselves. The result is served
+     * from a cache updated by reachabilityChanged(); this call never
+     * touches the filesystem.
+     *
+     * @return false if the volume is known to hang on access
+     * @since 6.8
+     */
+    bool isReachable() const;
+
+    /**
+     * Filesystem space figures of a mounted volume.
+     *
+     * All sizes are in bytes; -1 means the value could not be determined,
+     * typically because the volume is not mounted.
+     *
+     * @see spaceInfo()
+     * @since 6.8
+     */
+    struct SpaceInfo {
+        /** Total size of the filesystem. */
+        qint64 totalSize = -1;
+        /** Free space, including space reserved for privileged users. */
+        qint64 freeSize = -1;
+        /** Space available to the calling, unprivileged user. */
+        qint64 availableSize = -1;
+
+        /** Whether the volume was mounted and could be measured. */
+        bool isValid() const
+        {
+            return totalSize >= 0;
+        }
+    };
+
+    /**
+     * Retrieves the space figures of this volume.
+     *
+     * The values are served from a process-wide cache with a short
+     * time-to-live: the first query of a mount point measures it
+     * synchronously, later queries are cache hits, and stale entries are
+     * refreshed for all mounted volumes at once by a background sweep.
+     * A refresh that finds different figures is announced through
+     * spaceInfoChanged(), so callers can keep displays current by
+     * re-querying whenever they repaint and listening to that signal,
+     * without ever issuing their own blocking statvfs calls.
+     *
+     * @return the cached space figures, invalid if the volume is not
+     * accessible
+     * @since 6.8
+     */
+    SpaceInfo spaceInfo() const;
+
     /**
      * Indicates if this volume can check for filesystem errors.
      *
@@ -219,6 +298,45 @@ Q_SIGNALS:
      */
     void repairDone(Solid::ErrorType error, QVariant errorData, const QString &udi);
 
+    /**
+     * This signal is emitted while an ongoing operation on this device
+     * (mount, unmount, repair, ...) reports progress. The operation may
+     * have been started by another process.
+     *
+     * Only backends that track operation progress emit this signal;
+     * a completed or vanished operation reports a progress of 1.0.
+     *
+     * @param operation the backend's name for the running operation
+     * @param progress completion fraction between 0.0 and 1.0
+     * @param udi the UDI of the volume
+     *
+     * @since 6.8
+     */
+    void operationProgressChanged(const QString &operation, double progress, const QString &udi);
+
+    /**
+     * This signal is emitted when the reachability of this volume
+     * changes, i.e. when a mounted network share stops answering or
+     * comes back. Only backends monitoring network shares emit it.
+     *
+     * @param reachable whether the volume responds to I/O
+     * @param udi the UDI of the volume
+     *
+     * @since 6.8
+     */
+    void reachabilityChanged(bool reachable, const QString &udi);
+
+    /**
+     * This signal is emitted when a background refresh finds that the
+     * space figures of this volume changed.
+     *
+     * @param info the new space figures
+     * @param udi the UDI of the volume
+     *
+     * @since 6.8
+     */
+    void spaceInfoChanged(const Solid::StorageAccess::SpaceInfo &info, const QString &udi);
+
 protected:
     /**
      * @internal
@@ -74,6 +74,25 @@ bool Solid::StorageDrive::isInUse() const
     return inUse;
 }
 
+bool Solid::StorageDrive::teardownAllVolumes()
+{
+    Q_D(StorageDrive);
+    Predicate p(DeviceInterface::StorageAccess);
+    const QList<Device> devices = Device::listFromQuery(p, d->devicePrivate()->udi());
+
+    /* Request every teardown before waiting on any of them; backends queue
+     * the operations and run independent ones concurrently, and the drive
+     * is ejected or powered off by whichever unmount finishes last. */
+    bool requested = false;
+    for (Device dev : devices) {
+        Solid::StorageAccess *access = dev.as<Solid::StorageAccess>();
+        if (access && access->isAccessible()) {
+            requested |= access->teardown();
+        }
+    }
+    return requested;
+}
+
 QDateTime Solid::StorageDrive::timeDetected() const
 {
     Q_D(const StorageDrive);
@@ -166,6 +166,22 @@ public:
      */
     QDateTime timeMediaDetected() const;
 
+    /**
+     * Unmounts every mounted volume of this drive.
+     *
+     * The teardowns are requested in one go, so backends that support
+     * concurrent operations unmount independent volumes in parallel
+     * instead of one after the other; a removable drive is ejected or
+     * powered off once the last volume is gone. Completion is reported
+     * per volume through StorageAccess::teardownDone().
+     *
+     * @return false if no volume accepted the operation, true if at
+     * least one teardown is attempted
+     *
+     * @since 6.8
+     */
+    bool teardownAllVolumes();
+
 protected:
     /**
      * @internal
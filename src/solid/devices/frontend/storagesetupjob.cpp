@@ -0,0 +1,119 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "storagesetupjob.h"
+
+#include "storageaccess.h"
+
+Solid::StorageSetupJob::StorageSetupJob(const QList<Device> &devices, QObject *parent)
+    : QObject(parent)
+    , m_devices(devices)
+{
+    /* Dispatch from the event loop rather than the constructor, so results
+     * of synchronously completing backends aren't emitted before the caller
+     * had a chance to connect. */
+    QMetaObject::invokeMethod(this, &StorageSetupJob::dispatch, Qt::QueuedConnection);
+}
+
+Solid::StorageSetupJob::~StorageSetupJob() = default;
+
+QList<Solid::StorageSetupJob::Result> Solid::StorageSetupJob::results() const
+{
+    return m_results;
+}
+
+int Solid::StorageSetupJob::errorCount() const
+{
+    return m_errorCount;
+}
+
+bool Solid::StorageSetupJob::isFinished() const
+{
+    return m_finished;
+}
+
+void Solid::StorageSetupJob::dispatch()
+{
+    m_dispatching = true;
+
+    for (Device &device : m_devices) {
+        const QString udi = device.udi();
+        StorageAccess *access = device.as<StorageAccess>();
+
+        if (!access) {
+            record(udi, Solid::OperationFailed, tr("The device is not a mountable volume"));
+            continue;
+        }
+
+        if (access->isAccessible()) {
+            record(udi, Solid::NoError, QVariant());
+            continue;
+        }
+
+        m_pending.insert(udi);
+
+        /* Duplicate UDIs in the request share one interface object, hence
+         * the unique connections. Backends completing a mount without a
+         * per-request answer still announce the new accessibility, so both
+         * paths settle the volume; the pending set absorbs the overlap and
+         * filters out spontaneous events about foreign volumes. */
+        connect(access, &StorageAccess::setupDone, this, &StorageSetupJob::onSetupDone, Qt::UniqueConnection);
+        connect(access, &StorageAccess::accessibilityChanged, this, &StorageSetupJob::onAccessibilityChanged, Qt::UniqueConnection);
+
+        if (!access->setup()) {
+            settle(udi, Solid::OperationFailed, tr("The backend rejected the setup request"));
+        }
+    }
+
+    m_dispatching = false;
+    maybeFinish();
+}
+
+void Solid::StorageSetupJob::onSetupDone(Solid::ErrorType error, const QVariant &errorData, const QString &udi)
+{
+    settle(udi, error, errorData);
+}
+
+void Solid::StorageSetupJob::onAccessibilityChanged(bool accessible, const QString &udi)
+{
+    if (accessible) {
+        settle(udi, Solid::NoError, QVariant());
+    }
+}
+
+void Solid::StorageSetupJob::record(const QString &udi, Solid::ErrorType error, const QVariant &errorData)
+{
+    m_results.append({udi, error, errorData});
+    if (error != Solid::NoError) {
+        ++m_errorCount;
+    }
+
+    Q_EMIT deviceFinished(udi, error, errorData);
+}
+
+void Solid::StorageSetupJob::settle(const QString &udi, Solid::ErrorType error, const QVariant &errorData)
+{
+    /* each volume settles exactly once, whichever announcement comes first */
+    if (m_finished || !m_pending.remove(udi)) {
+        return;
+    }
+
+    record(udi, error, errorData);
+    maybeFinish();
+}
+
+void Solid::StorageSetupJob::maybeFinish()
+{
+    if (m_dispatching || m_finished || !m_pending.isEmpty()) {
+        return;
+    }
+
+    m_finished = true;
+    Q_EMIT finished(this);
+    deleteLater();
+}
+
+#include "moc_storagesetupjob.cpp"
@@ -0,0 +1,114 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_STORAGESETUPJOB_H
+#define SOLID_STORAGESETUPJOB_H
+
+#include <QObject>
+#include <QSet>
+#include <QVariant>
+
+#include <solid/solid_export.h>
+
+#include <solid/device.h>
+#include <solid/solidnamespace.h>
+
+namespace Solid
+{
+/**
+ * @class Solid::StorageSetupJob storagesetupjob.h <Solid/StorageSetupJob>
+ *
+ * An aggregate mount operation over several volumes.
+ *
+ * Instances are obtained from StorageAccess::setupAll(). All setups are
+ * dispatched at once, so backends that queue or pipeline mount requests
+ * work on them concurrently instead of the caller chaining one
+ * setupDone() to the next setup() — which is what session-restore code
+ * remounting many volumes used to do.
+ *
+ * Each volume reports through deviceFinished() as its setup settles;
+ * finished() fires once all of them have, after which results() holds the
+ * per-volume outcome. The job starts automatically and deletes itself
+ * after finished() has been emitted.
+ *
+ * @since 6.8
+ */
+class SOLID_EXPORT StorageSetupJob : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * Outcome of one volume's setup.
+     */
+    struct Result {
+        /** The UDI of the volume. */
+        QString udi;
+        /** The error reported for its setup, NoError on success. */
+        Solid::ErrorType error = Solid::NoError;
+        /** More information about the error, if any. */
+        QVariant errorData;
+    };
+
+    ~StorageSetupJob() override;
+
+    /**
+     * The per-volume outcomes settled so far, in settlement order; the
+     * complete picture once finished() was emitted.
+     */
+    QList<Result> results() const;
+
+    /**
+     * How many of the settled setups failed.
+     */
+    int errorCount() const;
+
+    /**
+     * Whether all setups have settled.
+     */
+    bool isFinished() const;
+
+Q_SIGNALS:
+    /**
+     * This signal is emitted every time the setup of one of the volumes
+     * settles.
+     *
+     * @param udi the UDI of the volume
+     * @param error type of error that occurred, if any
+     * @param errorData more information about the error, if any
+     */
+    void deviceFinished(const QString &udi, Solid::ErrorType error, const QVariant &errorData);
+
+    /**
+     * This signal is emitted once every setup has settled; the job
+     * deletes itself afterwards.
+     *
+     * @param job the finished job, for retrieving results()
+     */
+    void finished(Solid::StorageSetupJob *job);
+
+private Q_SLOTS:
+    void onSetupDone(Solid::ErrorType error, const QVariant &errorData, const QString &udi);
+    void onAccessibilityChanged(bool accessible, const QString &udi);
+
+private:
+    friend class StorageAccess;
+
+    StorageSetupJob(const QList<Device> &devices, QObject *parent);
+    void dispatch();
+    void record(const QString &udi, Solid::ErrorType error, const QVariant &errorData);
+    void settle(const QString &udi, Solid::ErrorType error, const QVariant &errorData);
+    void maybeFinish();
+
+    QList<Device> m_devices;
+    QList<Result> m_results;
+    QSet<QString> m_pending;
+    int m_errorCount = 0;
+    bool m_dispatching = false;
+    bool m_finished = false;
+};
+}
+
+#endif
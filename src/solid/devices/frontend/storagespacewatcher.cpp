@@ -0,0 +1,148 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "storagespacewatcher_p.h"
+
+#include <QPointer>
+#include <QStorageInfo>
+#include <QThreadPool>
+
+namespace Solid
+{
+Q_GLOBAL_STATIC(StorageSpaceWatcher, globalSpaceWatcher)
+
+/* how long a cached measurement stays fresh; queries within the window are
+ * pure cache hits, the first query past it triggers a sweep */
+static const int c_ttlMsecs = 2000;
+
+StorageSpaceWatcher::StorageSpaceWatcher()
+    : m_sweepPool(new QThreadPool)
+{
+    m_sweepPool->setMaxThreadCount(1);
+    m_clock.start();
+}
+
+StorageSpaceWatcher::~StorageSpaceWatcher()
+{
+    /* Deleting the pool waits for the running sweep, and a sweep stuck on
+     * a dead network mount would then hang application exit; leave it to
+     * the OS, as the fstab health monitor does with its probe pool. */
+}
+
+StorageSpaceWatcher *StorageSpaceWatcher::instance()
+{
+    return globalSpaceWatcher;
+}
+
+StorageAccess::SpaceInfo StorageSpaceWatcher::measure(const QString &filePath)
+{
+    StorageAccess::SpaceInfo info;
+
+    const QStorageInfo storage(filePath);
+    /* a path whose volume got unmounted underneath us resolves to the
+     * parent filesystem; require an exact mount point so we never report
+     * the root filesystem's numbers for a vanished volume */
+    if (!storage.isValid() || !storage.isReady() || storage.rootPath() != filePath) {
+        return info;
+    }
+
+    info.totalSize = storage.bytesTotal();
+    info.freeSize = storage.bytesFree();
+    info.availableSize = storage.bytesAvailable();
+    return info;
+}
+
+StorageAccess::SpaceInfo StorageSpaceWatcher::spaceInfo(const QString &filePath)
+{
+    QMutexLocker locker(&m_lock);
+
+    Entry &entry = m_entries[filePath];
+    if (entry.fetchedAtMsecs < 0) {
+        // first sighting of this mount point; one foreground measurement
+        // is unavoidable, everything after is served from the cache
+        entry.info = measure(filePath);
+        entry.fetchedAtMsecs = m_clock.elapsed();
+    } else if (m_clock.elapsed() - entry.fetchedAtMsecs >= c_ttlMsecs) {
+        // serve the stale value right away; the sweep refreshes every
+        // known mount point off-thread and announces what changed
+        scheduleSweep();
+    }
+
+    return entry.info;
+}
+
+void StorageSpaceWatcher::scheduleSweep()
+{
+    // m_lock is held by the caller
+    if (m_sweepPending) {
+        return;
+    }
+    m_sweepPending = true;
+
+    const QStringList paths = QStringList(m_entries.keyBegin(), m_entries.keyEnd());
+    QPointer<StorageSpaceWatcher> guard(this);
+    m_sweepPool->start([guard, paths]() {
+        QHash<QString, StorageAccess::SpaceInfo> results;
+        results.reserve(paths.size());
+        for (const QString &path : paths) {
+            results.insert(path, measure(path));
+        }
+        if (guard) {
+            QMetaObject::invokeMethod(
+                guard.data(),
+                [guard, results]() {
+                    if (guard) {
+                        guard->applySweep(results);
+                    }
+                },
+                Qt::QueuedConnection);
+        }
+    });
+}
+
+void StorageSpaceWatcher::applySweep(const QHash<QString, StorageAccess::SpaceInfo> &results)
+{
+    QList<std::pair<QString, StorageAccess::SpaceInfo>> changes;
+
+    {
+        QMutexLocker locker(&m_lock);
+        m_sweepPending = false;
+
+        const qint64 now = m_clock.elapsed();
+        for (auto it = results.constBegin(), end = results.constEnd(); it != end; ++it) {
+            const auto entry = m_entries.find(it.key());
+            if (entry == m_entries.end()) {
+                continue;
+            }
+
+            if (!it.value().isValid()) {
+                /* no longer a mount point; drop the entry so the path is
+                 * re-measured from scratch if it ever comes back */
+                if (entry->info.isValid()) {
+                    changes.append({it.key(), it.value()});
+                }
+                m_entries.erase(entry);
+                continue;
+            }
+
+            const bool changed = entry->info.totalSize != it.value().totalSize //
+                || entry->info.freeSize != it.value().freeSize //
+                || entry->info.availableSize != it.value().availableSize;
+            entry->info = it.value();
+            entry->fetchedAtMsecs = now;
+            if (changed) {
+                changes.append({it.key(), it.value()});
+            }
+        }
+    }
+
+    for (const auto &[path, info] : std::as_const(changes)) {
+        Q_EMIT spaceInfoChanged(path, info);
+    }
+}
+}
+
+#include "moc_storagespacewatcher_p.cpp"
@@ -0,0 +1,73 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_STORAGESPACEWATCHER_P_H
+#define SOLID_STORAGESPACEWATCHER_P_H
+
+#include "storageaccess.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+
+class QThreadPool;
+
+namespace Solid
+{
+/**
+ * Process-wide cache of filesystem space information.
+ *
+ * StorageAccess::spaceInfo() queries are answered from here. The first
+ * sighting of a mount point costs one synchronous measurement; afterwards
+ * queries are served from the cache, and a stale entry triggers a single
+ * background sweep that re-measures every known mount point in one pass.
+ * Changes found by a sweep are announced per path, so a places panel with
+ * twenty mounts pays one off-thread sweep instead of twenty foreground
+ * stat calls.
+ */
+class StorageSpaceWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    StorageSpaceWatcher();
+    ~StorageSpaceWatcher() override;
+
+    static StorageSpaceWatcher *instance();
+
+    /**
+     * Returns the cached space information for @p filePath, measuring it
+     * synchronously only on first sight. A stale entry is returned as-is
+     * and refreshed by a background sweep; callers learn of the new value
+     * through spaceInfoChanged().
+     */
+    StorageAccess::SpaceInfo spaceInfo(const QString &filePath);
+
+Q_SIGNALS:
+    void spaceInfoChanged(const QString &filePath, const Solid::StorageAccess::SpaceInfo &info);
+
+private:
+    static StorageAccess::SpaceInfo measure(const QString &filePath);
+    void scheduleSweep();
+    void applySweep(const QHash<QString, StorageAccess::SpaceInfo> &results);
+
+    struct Entry {
+        StorageAccess::SpaceInfo info;
+        qint64 fetchedAtMsecs = -1;
+    };
+
+    mutable QMutex m_lock;
+    QHash<QString, Entry> m_entries;
+    bool m_sweepPending = false;
+    /* dedicated single-thread pool: a statvfs on a dead network mount can
+     * hang, and must neither stall the application's own pool nor let
+     * several sweeps pile up behind each other */
+    QThreadPool *m_sweepPool;
+    QElapsedTimer m_clock;
+};
+}
+
+#endif // SOLID_STORAGESPACEWATCHER_P_H
@@ -9,3 +9,14 @@
 Solid::Ifaces::Battery::~Battery()
 {
 }
+
+QList<Solid::Battery::ChargeSample> Solid::Ifaces::Battery::chargeHistory(qlonglong maxAgeSeconds) const
+{
+    Q_UNUSED(maxAgeSeconds)
+    return {};
+}
+
+void Solid::Ifaces::Battery::setRefreshInterval(int msecs)
+{
+    Q_UNUSED(msecs)
+}
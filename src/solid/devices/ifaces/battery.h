@@ -12,6 +12,8 @@
 #include <solid/battery.h>
 #include <solid/devices/ifaces/deviceinterface.h>
 
+#include <QList>
+
 namespace Solid
 {
 namespace Ifaces
@@ -171,6 +173,31 @@ public:
      */
     virtual qlonglong remainingTime() const = 0;
 
+    /**
+     * The recorded charge history of the battery, oldest sample first.
+     *
+     * The default implementation returns an empty list, for backends that
+     * keep no history.
+     *
+     * @param maxAgeSeconds only return samples at most this old, 0 for all
+     * @return the recorded samples
+     * @since 6.8
+     */
+    virtual QList<Solid::Battery::ChargeSample> chargeHistory(qlonglong maxAgeSeconds) const;
+
+    /**
+     * Requests throttled periodic refreshes of the battery state.
+     *
+     * Backends must serve the getters from a cache between change events;
+     * this call is only meaningful for backends whose data source updates
+     * silently and who therefore need to re-read it periodically. The
+     * default implementation does nothing.
+     *
+     * @param msecs minimum milliseconds between refreshes, 0 to disable
+     * @since 6.8
+     */
+    virtual void setRefreshInterval(int msecs);
+
 protected:
     // Q_SIGNALS:
     /**
@@ -65,4 +65,8 @@ QString Solid::Ifaces::Device::displayName() const
     return description();
 }
 
+void Solid::Ifaces::Device::preload()
+{
+}
+
 #include "moc_device.cpp"
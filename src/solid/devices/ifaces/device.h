@@ -105,6 +105,18 @@ public:
      */
     virtual QString description() const = 0;
 
+    /**
+     * Prefetches, in one batched operation, the data behind the display
+     * accessors and device interface properties.
+     *
+     * The default implementation does nothing; backends keeping a property
+     * cache reimplement it to fill the cache in a single round trip instead
+     * of one fetch per property miss.
+     *
+     * @since 6.8
+     */
+    virtual void preload();
+
     /**
      * Tests if a property exist.
      *
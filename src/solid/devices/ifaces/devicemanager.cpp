@@ -6,6 +6,10 @@
 
 #include "ifaces/devicemanager.h"
 
+#include <QSet>
+
+#include <algorithm>
+
 Solid::Ifaces::DeviceManager::DeviceManager(QObject *parent)
     : QObject(parent)
 {
@@ -15,4 +19,55 @@ Solid::Ifaces::DeviceManager::~DeviceManager()
 {
 }
 
+void Solid::Ifaces::DeviceManager::beginEnumeration()
+{
+}
+
+qsizetype Solid::Ifaces::DeviceManager::countFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type)
+{
+    return devicesFromQuery(parentUdi, type).size();
+}
+
+void Solid::Ifaces::DeviceManager::setMonitoringEnabled(bool enabled)
+{
+    Q_UNUSED(enabled);
+}
+
+QString Solid::Ifaces::DeviceManager::udiFromDeviceFile(const QString &deviceFile)
+{
+    Q_UNUSED(deviceFile);
+    return QString();
+}
+
+QStringList Solid::Ifaces::DeviceManager::devicesFromQuery(const QString &parentUdi, const Solid::Predicate &predicate)
+{
+    if (!predicate.isValid()) {
+        return allDevices();
+    }
+
+    const QSet<Solid::DeviceInterface::Type> supported = supportedInterfaces();
+
+    auto types = predicate.usedTypes().values();
+    std::sort(types.begin(), types.end());
+
+    QStringList result;
+    QSet<QString> seen;
+
+    for (Solid::DeviceInterface::Type type : std::as_const(types)) {
+        if (!supported.contains(type)) {
+            continue;
+        }
+
+        const QStringList udis = devicesFromQuery(parentUdi, type);
+        for (const QString &udi : udis) {
+            if (!seen.contains(udi)) {
+                seen.insert(udi);
+                result << udi;
+            }
+        }
+    }
+
+    return result;
+}
+
 #include "moc_devicemanager.cpp"
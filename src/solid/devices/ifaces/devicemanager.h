@@ -12,6 +12,7 @@
 #include <QStringList>
 
 #include <solid/deviceinterface.h>
+#include <solid/predicate.h>
 
 namespace Solid
 {
@@ -59,6 +60,20 @@ public:
      */
     virtual QStringList allDevices() = 0;
 
+    /**
+     * Hints the backend that an enumeration is about to happen.
+     *
+     * Backends that enumerate through request/reply round trips (e.g. over
+     * D-Bus) can fire their pending call here and harvest it in the next
+     * allDevices() or devicesFromQuery() call. The frontend invokes this on
+     * every backend before collecting the results, so independent backends
+     * enumerate concurrently and the wall-clock cost approaches the slowest
+     * backend rather than the sum of all of them.
+     *
+     * The default implementation does nothing.
+     */
+    virtual void beginEnumeration();
+
     /**
      * Retrieves the Universal Device Identifier (UDI) of all the devices
      * matching the given constraints (parent and device interface)
@@ -71,6 +86,56 @@ public:
      */
     virtual QStringList devicesFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type = Solid::DeviceInterface::Unknown) = 0;
 
+    /**
+     * Retrieves the Universal Device Identifier (UDI) of the devices that
+     * may match the given predicate.
+     *
+     * Backends are allowed to over-approximate — the frontend re-evaluates
+     * the predicate on every returned device — but must not miss matches.
+     * The default implementation queries each device interface type used by
+     * the predicate; backends able to translate property constraints into
+     * their native query mechanism can reimplement it to return far fewer
+     * candidates.
+     *
+     * @param parentUdi UDI of the parent of the devices we're searching for, or QString()
+     * if there's no constraint on the parent
+     * @param predicate the predicate the devices we're looking for should match
+     * @returns the UDIs of the candidate devices, duplicate-free
+     */
+    virtual QStringList devicesFromQuery(const QString &parentUdi, const Solid::Predicate &predicate);
+
+    /**
+     * Counts the devices matching the given constraints without
+     * materializing any of them.
+     *
+     * The default implementation sizes the devicesFromQuery() result,
+     * which already skips device construction; backends that track their
+     * device population (the UDisks2 device cache, the udev verdict sets)
+     * should reimplement it to answer from that state without touching
+     * the platform at all.
+     *
+     * @param parentUdi UDI of the parent of the devices we're counting, or QString()
+     * if there's no constraint on the parent
+     * @param type DeviceInterface type the counted devices must provide, or DeviceInterface::Unknown
+     * if there's no constraint on the device interfaces
+     * @returns the number of devices matching the constraints
+     */
+    virtual qsizetype countFromQuery(const QString &parentUdi, Solid::DeviceInterface::Type type = Solid::DeviceInterface::Unknown);
+
+    /**
+     * Resolves a device node path like /dev/sdb1 to the UDI of the
+     * corresponding device, if this backend has a native lookup for it.
+     *
+     * The default implementation returns an empty string, in which case
+     * the frontend falls back to scanning the block devices; backends with
+     * a direct mapping (udev devnum lookup, UDisks2 object paths) should
+     * reimplement it.
+     *
+     * @param deviceFile absolute path of the device node
+     * @returns the UDI of the device backing the node, or an empty string
+     */
+    virtual QString udiFromDeviceFile(const QString &deviceFile);
+
     /**
      * Instantiates a new Device object from this backend given its UDI.
      *
@@ -79,6 +144,24 @@ public:
      */
     virtual QObject *createDevice(const QString &udi) = 0;
 
+    /**
+     * Tells the backend whether anybody in the process is listening for
+     * hotplug events.
+     *
+     * The frontend calls this with @c true when the first change receiver
+     * appears and with @c false when the last one goes away. Backends with
+     * a monitoring cost (netlink sockets, dbus-daemon match rules, inotify
+     * watches) should arm it only while enabled; in exchange they must
+     * answer queries correctly while disabled, typically by refreshing
+     * their caches per enumeration instead of relying on events.
+     *
+     * The default implementation does nothing; backends that keep their
+     * monitoring always-on stay correct, just not as cheap.
+     *
+     * @param enabled whether hotplug events currently have a receiver
+     */
+    virtual void setMonitoringEnabled(bool enabled);
+
 Q_SIGNALS:
     /**
      * This signal is emitted when a new device appears in the system.
@@ -93,6 +176,33 @@ Q_SIGNALS:
      * @param udi the old device identifier
      */
     void deviceRemoved(const QString &udi);
+
+    /**
+     * This signal is emitted when the interface composition of an existing
+     * device changes, e.g. a two-stage device exposing its filesystem.
+     *
+     * Backends used to fake this with a deviceRemoved/deviceAdded pair to
+     * force predicate re-evaluation; the dedicated signal lets the frontend
+     * refresh the device in place instead of destroying and recreating the
+     * backend object and every interface wrapper.
+     *
+     * @param udi the identifier of the changed device
+     */
+    void deviceInterfacesChanged(const QString &udi);
+
+    /**
+     * This signal is emitted when properties of an existing device change
+     * without its interface composition changing, e.g. a filesystem being
+     * mounted or unmounted.
+     *
+     * Emitting it is optional — backends without a property-change stream
+     * stay silent — but backends that have one should relay it: the
+     * frontend drops memoized query results on it, so predicates over
+     * mutable properties don't keep returning stale matches.
+     *
+     * @param udi the identifier of the changed device
+     */
+    void deviceChanged(const QString &udi);
 };
 }
 }
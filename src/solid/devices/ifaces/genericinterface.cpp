@@ -9,3 +9,8 @@
 Solid::Ifaces::GenericInterface::~GenericInterface()
 {
 }
+
+void Solid::Ifaces::GenericInterface::propertyEventsChanged(const QList<Solid::GenericInterface::PropertyChangeEvent> &events)
+{
+    Q_UNUSED(events)
+}
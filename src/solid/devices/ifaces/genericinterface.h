@@ -9,9 +9,12 @@
 
 #include <QObject>
 
+#include <QList>
 #include <QMap>
 #include <QVariant>
 
+#include <solid/genericinterface.h>
+
 namespace Solid
 {
 namespace Ifaces
@@ -68,6 +71,20 @@ protected:
      */
     virtual void propertyChanged(const QMap<QString, int> &changes) = 0;
 
+    /**
+     * The typed counterpart of propertyChanged(), describing the changes
+     * with interned integer property ids from
+     * Solid::GenericInterface::propertyId().
+     *
+     * Backends emitting this signal must not emit propertyChanged() for
+     * the same changes; the frontend rebuilds the name-keyed map for
+     * legacy listeners on demand. The default does nothing, for backends
+     * only providing the name-keyed signal.
+     *
+     * @param events the list of property change events
+     */
+    virtual void propertyEventsChanged(const QList<Solid::GenericInterface::PropertyChangeEvent> &events);
+
     /**
      * This signal is emitted when an event occurred in the device.
      * For example when a button is pressed.
@@ -9,3 +9,8 @@
 Solid::Ifaces::OpticalDisc::~OpticalDisc()
 {
 }
+
+void Solid::Ifaces::OpticalDisc::availableContentChanged(Solid::OpticalDisc::ContentTypes content)
+{
+    Q_UNUSED(content)
+}
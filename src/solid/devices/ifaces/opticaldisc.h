@@ -72,6 +72,19 @@ public:
      * @return the capacity of the disc in bytes
      */
     virtual qulonglong capacity() const = 0;
+
+protected:
+    // Q_SIGNALS:
+    /**
+     * This signal is emitted when a background content probe finished and
+     * refined the result of availableContent().
+     *
+     * The default does nothing, for backends determining the content
+     * synchronously.
+     *
+     * @param content the flag set indicating the available contents
+     */
+    virtual void availableContentChanged(Solid::OpticalDisc::ContentTypes content);
 };
 }
 }
@@ -9,3 +9,24 @@
 Solid::Ifaces::Processor::~Processor()
 {
 }
+
+int Solid::Ifaces::Processor::packageId() const
+{
+    return -1;
+}
+
+int Solid::Ifaces::Processor::coreId() const
+{
+    return -1;
+}
+
+QList<int> Solid::Ifaces::Processor::threadSiblings() const
+{
+    return QList<int>();
+}
+
+QList<int> Solid::Ifaces::Processor::cacheSiblings(int level) const
+{
+    Q_UNUSED(level)
+    return QList<int>();
+}
@@ -10,6 +10,8 @@
 #include <solid/devices/ifaces/deviceinterface.h>
 #include <solid/processor.h>
 
+#include <QList>
+
 namespace Solid
 {
 namespace Ifaces
@@ -55,6 +57,45 @@ public:
      * @return the extensions supported by the CPU
      */
     virtual Solid::Processor::InstructionSets instructionSets() const = 0;
+
+    /**
+     * Retrieves the identifier of the physical package (socket) this
+     * processor belongs to.
+     *
+     * The default implementation returns -1, meaning the backend has no
+     * topology information.
+     *
+     * @return the package identifier, or -1 if unknown
+     * @since 6.8
+     */
+    virtual int packageId() const;
+
+    /**
+     * Retrieves the identifier of the core this processor belongs to
+     * within its package.
+     *
+     * @return the core identifier, or -1 if unknown
+     * @since 6.8
+     */
+    virtual int coreId() const;
+
+    /**
+     * Retrieves the numbers of the processors sharing this processor's
+     * core (its SMT siblings, including this processor itself).
+     *
+     * @return the sibling processor numbers, or an empty list if unknown
+     * @since 6.8
+     */
+    virtual QList<int> threadSiblings() const;
+
+    /**
+     * Retrieves the numbers of the processors sharing this processor's
+     * level @p level cache.
+     *
+     * @return the sharing processor numbers, or an empty list if unknown
+     * @since 6.8
+     */
+    virtual QList<int> cacheSiblings(int level) const;
 };
 }
 }
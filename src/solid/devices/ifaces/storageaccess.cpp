@@ -10,6 +10,11 @@ Solid::Ifaces::StorageAccess::~StorageAccess()
 {
 }
 
+bool Solid::Ifaces::StorageAccess::isReachable() const
+{
+    return true;
+}
+
 bool Solid::Ifaces::StorageAccess::canCheck() const
 {
     return false;
@@ -41,3 +46,16 @@ void Solid::Ifaces::StorageAccess::repairDone(Solid::ErrorType error, QVariant r
     Q_UNUSED(resultData);
     Q_UNUSED(udi);
 }
+
+void Solid::Ifaces::StorageAccess::operationProgressChanged(const QString &operation, double progress, const QString &udi)
+{
+    Q_UNUSED(operation);
+    Q_UNUSED(progress);
+    Q_UNUSED(udi);
+}
+
+void Solid::Ifaces::StorageAccess::reachabilityChanged(bool reachable, const QString &udi)
+{
+    Q_UNUSED(reachable);
+    Q_UNUSED(udi);
+}
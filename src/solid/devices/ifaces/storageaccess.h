@@ -75,6 +75,16 @@ public:
      */
     virtual bool teardown() = 0;
 
+    /**
+     * Indicates whether the filesystem behind this volume currently
+     * responds to I/O. Only backends monitoring network shares track
+     * this; the default implementation always returns true.
+     *
+     * @return false if the volume is known to hang on access
+     * @since 6.8
+     */
+    virtual bool isReachable() const;
+
     /**
      * Indicates if this volume can check for filesystem errors.
      *
@@ -172,6 +182,27 @@ protected:
      * @param udi the UDI of the volume
      */
     virtual void repairDone(Solid::ErrorType error, QVariant resultData, const QString &udi);
+
+    /**
+     * This signal is emitted while an ongoing operation on this device
+     * (mount, unmount, repair, ...) reports progress. Only backends
+     * that track operation progress emit it.
+     *
+     * @param operation the backend's name for the running operation
+     * @param progress completion fraction between 0.0 and 1.0
+     * @param udi the UDI of the volume
+     */
+    virtual void operationProgressChanged(const QString &operation, double progress, const QString &udi);
+
+    /**
+     * This signal is emitted when the reachability of this volume
+     * changes. Only backends monitoring network shares emit it.
+     *
+     * @param reachable whether the volume responds to I/O
+     * @param udi the UDI of the volume
+     * @since 6.8
+     */
+    virtual void reachabilityChanged(bool reachable, const QString &udi);
 };
 }
 }
@@ -8,84 +8,533 @@
 
 #include <stdlib.h>
 
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QRecursiveMutex>
+
 #include <config-backends.h>
 
+#include "devices_debug.h"
+
 // do *not* use other defines than BUILD_DEVICE_BACKEND_$backend to include
 // the managers, and keep an alphabetical order
+#ifdef BUILD_DEVICE_BACKEND_cached
+#include "backends/cached/cached.h"
+#include "backends/cached/cachedmanager.h"
+#endif
 #ifdef BUILD_DEVICE_BACKEND_fakehw
 #include "backends/fakehw/fakemanager.h"
 #endif
 #ifdef BUILD_DEVICE_BACKEND_fstab
 #include "backends/fstab/fstabmanager.h"
+#include "backends/fstab/fstabservice.h"
 #endif
 #ifdef BUILD_DEVICE_BACKEND_imobile
+#include "backends/imobile/imobile.h"
 #include "backends/imobile/imobilemanager.h"
 #endif
 #ifdef BUILD_DEVICE_BACKEND_iokit
 #include "backends/iokit/iokitmanager.h"
 #endif
+#ifdef BUILD_DEVICE_BACKEND_powersupply
+#include "backends/powersupply/powersupply.h"
+#include "backends/powersupply/powersupplymanager.h"
+#endif
+#ifdef BUILD_DEVICE_BACKEND_sysfsblock
+#include "backends/sysfsblock/sysfsblock.h"
+#include "backends/sysfsblock/sysfsblockmanager.h"
+#endif
 #ifdef BUILD_DEVICE_BACKEND_udev
+#include "backends/udev/udev.h"
 #include "backends/udev/udevmanager.h"
 #endif
 #ifdef BUILD_DEVICE_BACKEND_udisks2
+#include "backends/udisks2/udisks2.h"
 #include "backends/udisks2/udisksmanager.h"
 #endif
 #ifdef BUILD_DEVICE_BACKEND_upower
+#include "backends/upower/upower.h"
 #include "backends/upower/upowermanager.h"
 #endif
 #ifdef BUILD_DEVICE_BACKEND_win
 #include "backends/win/windevicemanager.h"
 #endif
 
+namespace Solid
+{
+/* The backend managers carry the expensive state (udev monitor socket,
+ * UDisks2 introspection, property caches), so they are created lazily, in
+ * the first thread that issues a query or subscription their interface
+ * types can answer, and shared process-wide once they exist. Until then a
+ * backend is only its slot below: the static supported-type table and UDI
+ * prefix used for dispatch, and the factory that materializes it. The
+ * per-thread DeviceManagerPrivate instances are the thin adapters on top:
+ * they register as observers and get backendInstantiated() callbacks to
+ * hook their signal connections, for backends created before and after
+ * them alike. */
+struct BackendSlot {
+    /* Mirrors the supported-interface set the manager's constructor
+     * installs; keep the two in sync. */
+    QSet<DeviceInterface::Type> types;
+    QString udiPrefix;
+    Ifaces::DeviceManager *(*create)();
+    Ifaces::DeviceManager *instance = nullptr;
+
+    /* Filled only under SOLID_STARTUP_TRACE: when the backend was
+     * constructed (monotonic msecs since slot registration), how long the
+     * constructor ran, and how long its first device enumeration took.
+     * -1 means the phase has not happened. */
+    qint64 constructAtMsecs = -1;
+    qint64 constructNsecs = -1;
+    qint64 firstEnumNsecs = -1;
+};
+
+struct SharedBackends {
+    ~SharedBackends()
+    {
+        for (const BackendSlot &slot : std::as_const(slots)) {
+            delete slot.instance;
+        }
+    }
+
+    void registerSlots();
+    Ifaces::DeviceManager *materialize(BackendSlot &slot);
+
+    QRecursiveMutex mutex;
+    QList<BackendSlot> slots;
+    QList<ManagerBasePrivate *> observers;
+    bool registered = false;
+
+    /* Number of consumers interested in hotplug events, process-wide.
+     * Backend monitors are armed on the 0→1 transition and dropped again
+     * on 1→0, so event-less consumers never pay for event delivery. */
+    int changeSubscribers = 0;
+
+    /* SOLID_STARTUP_TRACE: per-backend construction and first-enumeration
+     * timing against the epoch below, summarized in one line at exit. */
+    bool traceStartup = false;
+    QElapsedTimer traceEpoch;
+};
+}
+
+Q_GLOBAL_STATIC(Solid::SharedBackends, s_sharedBackends)
+
+/* atexit handler for SOLID_STARTUP_TRACE: one line covering every slot, so
+ * fleet telemetry can aggregate it without multi-line parsing. Backends that
+ * never materialized are reported as such; that is itself useful data. */
+static void reportStartupTrace()
+{
+    if (s_sharedBackends.isDestroyed()) {
+        return;
+    }
+
+    QMutexLocker locker(&s_sharedBackends->mutex);
+
+    QString summary;
+    for (const Solid::BackendSlot &slot : std::as_const(s_sharedBackends->slots)) {
+        if (!summary.isEmpty()) {
+            summary += QLatin1Char(' ');
+        }
+
+        /* name the slot after the last segment of its UDI prefix; that is
+         * stable across builds, unlike the instance's class name */
+        const qsizetype slash = slot.udiPrefix.lastIndexOf(QLatin1Char('/'));
+        const QString name = slot.udiPrefix.isEmpty() ? QStringLiteral("native") : slot.udiPrefix.mid(slash + 1);
+
+        if (!slot.instance) {
+            summary += name + QLatin1String("[unused]");
+            continue;
+        }
+
+        summary += QString::asprintf("%s[+%lldms ctor=%.1fms", qPrintable(name), static_cast<long long>(slot.constructAtMsecs), slot.constructNsecs / 1e6);
+        if (slot.firstEnumNsecs >= 0) {
+            summary += QString::asprintf(" enum=%.1fms", slot.firstEnumNsecs / 1e6);
+        }
+        summary += QLatin1Char(']');
+    }
+
+    qCInfo(Solid::Frontend::DeviceManager::DEVICEMANAGER, "startup: %s", qPrintable(summary));
+}
+
 Solid::ManagerBasePrivate::ManagerBasePrivate()
 {
 }
 
 Solid::ManagerBasePrivate::~ManagerBasePrivate()
 {
-    qDeleteAll(m_backends);
+    if (!s_sharedBackends.isDestroyed()) {
+        QMutexLocker locker(&s_sharedBackends->mutex);
+        s_sharedBackends->observers.removeOne(this);
+    }
+}
+
+void Solid::ManagerBasePrivate::loadBackends()
+{
+    QMutexLocker locker(&s_sharedBackends->mutex);
+    if (!s_sharedBackends->registered) {
+        s_sharedBackends->registerSlots();
+        s_sharedBackends->registered = true;
+    }
+
+    s_sharedBackends->observers.append(this);
+
+    /* replay the backends other threads have already materialized */
+    for (const BackendSlot &slot : std::as_const(s_sharedBackends->slots)) {
+        if (slot.instance) {
+            backendInstantiated(slot.instance);
+        }
+    }
+}
+
+void Solid::ManagerBasePrivate::backendInstantiated(Ifaces::DeviceManager *backend)
+{
+    Q_UNUSED(backend)
+}
+
+void Solid::ManagerBasePrivate::monitoringChanged(bool active)
+{
+    Q_UNUSED(active)
+}
+
+QRecursiveMutex *Solid::ManagerBasePrivate::backendsMutex()
+{
+    return &s_sharedBackends->mutex;
+}
+
+Solid::Ifaces::DeviceManager *Solid::SharedBackends::materialize(BackendSlot &slot)
+{
+    if (!slot.instance) {
+        if (traceStartup) {
+            slot.constructAtMsecs = traceEpoch.elapsed();
+            QElapsedTimer ctorTimer;
+            ctorTimer.start();
+            slot.instance = slot.create();
+            slot.constructNsecs = ctorTimer.nsecsElapsed();
+        } else {
+            slot.instance = slot.create();
+        }
+        if (changeSubscribers > 0) {
+            // somebody is already listening; new backends start armed
+            slot.instance->setMonitoringEnabled(true);
+        }
+        for (ManagerBasePrivate *observer : std::as_const(observers)) {
+            observer->backendInstantiated(slot.instance);
+        }
+    }
+
+    return slot.instance;
+}
+
+void Solid::ManagerBasePrivate::addChangeSubscriber()
+{
+    QMutexLocker locker(&s_sharedBackends->mutex);
+    if (++s_sharedBackends->changeSubscribers == 1) {
+        for (const BackendSlot &slot : std::as_const(s_sharedBackends->slots)) {
+            if (slot.instance) {
+                slot.instance->setMonitoringEnabled(true);
+            }
+        }
+        for (ManagerBasePrivate *observer : std::as_const(s_sharedBackends->observers)) {
+            observer->monitoringChanged(true);
+        }
+    }
+}
+
+void Solid::ManagerBasePrivate::removeChangeSubscriber()
+{
+    if (s_sharedBackends.isDestroyed()) {
+        return;
+    }
+
+    QMutexLocker locker(&s_sharedBackends->mutex);
+    if (--s_sharedBackends->changeSubscribers == 0) {
+        for (const BackendSlot &slot : std::as_const(s_sharedBackends->slots)) {
+            if (slot.instance) {
+                slot.instance->setMonitoringEnabled(false);
+            }
+        }
+        for (ManagerBasePrivate *observer : std::as_const(s_sharedBackends->observers)) {
+            observer->monitoringChanged(false);
+        }
+    }
+}
+
+bool Solid::ManagerBasePrivate::monitoringActive()
+{
+    if (s_sharedBackends.isDestroyed()) {
+        return false;
+    }
+
+    QMutexLocker locker(&s_sharedBackends->mutex);
+    return s_sharedBackends->changeSubscribers > 0;
+}
+
+bool Solid::ManagerBasePrivate::startupTraceEnabled()
+{
+    return !s_sharedBackends.isDestroyed() && s_sharedBackends->traceStartup;
+}
+
+void Solid::ManagerBasePrivate::noteFirstEnumeration(Ifaces::DeviceManager *backend, qint64 nsecs)
+{
+    if (s_sharedBackends.isDestroyed()) {
+        return;
+    }
+
+    QMutexLocker locker(&s_sharedBackends->mutex);
+    for (BackendSlot &slot : s_sharedBackends->slots) {
+        if (slot.instance == backend) {
+            if (slot.firstEnumNsecs < 0) {
+                slot.firstEnumNsecs = nsecs;
+            }
+            return;
+        }
+    }
 }
 
 // do *not* use other defines than BUILD_DEVICE_BACKEND_$backend to add
 // the managers, and keep an alphabetical order
-void Solid::ManagerBasePrivate::loadBackends()
+void Solid::SharedBackends::registerSlots()
 {
+    traceStartup = qEnvironmentVariableIntValue("SOLID_STARTUP_TRACE") > 0;
+    if (traceStartup) {
+        traceEpoch.start();
+        // the summary goes through the devicemanager category, which
+        // defaults to Warning; opt its Info level in so the line shows up
+        QLoggingCategory::setFilterRules(QStringLiteral("kf.solid.frontend.devicemanager.info=true"));
+        atexit(reportStartupTrace);
+    }
+
     QString solidFakeXml(QString::fromLocal8Bit(qgetenv("SOLID_FAKEHW")));
 
     if (!solidFakeXml.isEmpty()) {
 #ifdef BUILD_DEVICE_BACKEND_fakehw
-        m_backends << new Solid::Backends::Fake::FakeManager(nullptr, solidFakeXml);
+        /* clang-format off */
+        slots << BackendSlot{
+            {DeviceInterface::GenericInterface, DeviceInterface::Processor, DeviceInterface::Block,
+             DeviceInterface::StorageAccess, DeviceInterface::StorageDrive, DeviceInterface::OpticalDrive,
+             DeviceInterface::StorageVolume, DeviceInterface::OpticalDisc, DeviceInterface::Camera,
+             DeviceInterface::PortableMediaPlayer, DeviceInterface::Battery, DeviceInterface::NetworkShare},
+            QStringLiteral("/org/kde/solid/fakehw"),
+            []() -> Ifaces::DeviceManager * {
+                return new Solid::Backends::Fake::FakeManager(nullptr, QString::fromLocal8Bit(qgetenv("SOLID_FAKEHW")));
+            },
+        };
+        /* clang-format on */
 #endif
     } else {
+#ifdef BUILD_DEVICE_BACKEND_cached
+        if (qEnvironmentVariableIntValue("SOLID_DEVICE_CACHE") > 0) {
+            /* clang-format off */
+            slots << BackendSlot{
+                {DeviceInterface::GenericInterface, DeviceInterface::Processor, DeviceInterface::Block,
+                 DeviceInterface::StorageDrive, DeviceInterface::StorageVolume, DeviceInterface::Camera,
+                 DeviceInterface::PortableMediaPlayer},
+                QStringLiteral(CACHED_UDI_PREFIX),
+                []() -> Ifaces::DeviceManager * {
+                    return new Solid::Backends::Cached::CachedManager(nullptr);
+                },
+            };
+            /* clang-format on */
+        }
+#endif
 #ifdef BUILD_DEVICE_BACKEND_fstab
-        m_backends << new Solid::Backends::Fstab::FstabManager(nullptr);
+        /* clang-format off */
+        slots << BackendSlot{
+            {DeviceInterface::StorageAccess, DeviceInterface::NetworkShare},
+            QStringLiteral(FSTAB_UDI_PREFIX),
+            []() -> Ifaces::DeviceManager * {
+                return new Solid::Backends::Fstab::FstabManager(nullptr);
+            },
+        };
+        /* clang-format on */
 #endif
 #ifdef BUILD_DEVICE_BACKEND_imobile
-        m_backends << new Solid::Backends::IMobile::Manager(nullptr);
+        /* clang-format off */
+        slots << BackendSlot{
+            {DeviceInterface::PortableMediaPlayer},
+            Solid::Backends::IMobile::udiPrefix(),
+            []() -> Ifaces::DeviceManager * {
+                return new Solid::Backends::IMobile::Manager(nullptr);
+            },
+        };
+        /* clang-format on */
 #endif
 #ifdef BUILD_DEVICE_BACKEND_iokit
-        m_backends << new Solid::Backends::IOKit::IOKitManager(nullptr);
+        /* clang-format off */
+        slots << BackendSlot{
+            {DeviceInterface::GenericInterface, DeviceInterface::Processor, DeviceInterface::Block,
+             DeviceInterface::StorageAccess, DeviceInterface::StorageDrive, DeviceInterface::OpticalDrive,
+             DeviceInterface::StorageVolume, DeviceInterface::OpticalDisc, DeviceInterface::Camera,
+             DeviceInterface::PortableMediaPlayer, DeviceInterface::Battery},
+            QString(),
+            []() -> Ifaces::DeviceManager * {
+                return new Solid::Backends::IOKit::IOKitManager(nullptr);
+            },
+        };
+        /* clang-format on */
+#endif
+#ifdef BUILD_DEVICE_BACKEND_powersupply
+        if (qEnvironmentVariableIntValue("SOLID_POWER_SUPPLY_BACKEND") > 0) {
+            /* clang-format off */
+            slots << BackendSlot{
+                {DeviceInterface::Battery},
+                QStringLiteral(PS_UDI_PREFIX),
+                []() -> Ifaces::DeviceManager * {
+                    return new Solid::Backends::PowerSupply::PowerSupplyManager(nullptr);
+                },
+            };
+            /* clang-format on */
+        }
+#endif
+#ifdef BUILD_DEVICE_BACKEND_sysfsblock
+        if (qEnvironmentVariableIntValue("SOLID_SYSFS_BLOCK_BACKEND") > 0) {
+            /* clang-format off */
+            slots << BackendSlot{
+                {DeviceInterface::Block, DeviceInterface::StorageDrive, DeviceInterface::StorageVolume},
+                QStringLiteral(SYSFSBLOCK_UDI_PREFIX),
+                []() -> Ifaces::DeviceManager * {
+                    return new Solid::Backends::SysfsBlock::SysfsBlockManager(nullptr);
+                },
+            };
+            /* clang-format on */
+        }
 #endif
 #ifdef BUILD_DEVICE_BACKEND_udev
-        m_backends << new Solid::Backends::UDev::UDevManager(nullptr);
+        bool udevReplaced = false;
+#ifdef BUILD_DEVICE_BACKEND_cached
+        // the session snapshot covers everything udev is registered for
+        udevReplaced = qEnvironmentVariableIntValue("SOLID_DEVICE_CACHE") > 0;
+#endif
+        if (!udevReplaced) {
+            /* clang-format off */
+            slots << BackendSlot{
+                {DeviceInterface::GenericInterface, DeviceInterface::Processor, DeviceInterface::Camera,
+                 DeviceInterface::PortableMediaPlayer, DeviceInterface::Block},
+                QString::fromLatin1(UDEV_UDI_PREFIX),
+                []() -> Ifaces::DeviceManager * {
+                    return new Solid::Backends::UDev::UDevManager(nullptr);
+                },
+            };
+            /* clang-format on */
+        }
 #endif
 #ifdef BUILD_DEVICE_BACKEND_udisks2
         if (!qEnvironmentVariableIsSet("SOLID_DISABLE_UDISKS2")) {
-            m_backends << new Solid::Backends::UDisks2::Manager(nullptr);
+            /* clang-format off */
+            QSet<DeviceInterface::Type> udisksTypes =
+                {DeviceInterface::GenericInterface, DeviceInterface::Block, DeviceInterface::StorageAccess,
+                 DeviceInterface::StorageDrive, DeviceInterface::OpticalDrive, DeviceInterface::OpticalDisc,
+                 DeviceInterface::StorageVolume};
+            /* clang-format on */
+#ifdef BUILD_DEVICE_BACKEND_cached
+            // listing comes from the session snapshot; udisksd is only
+            // needed for mounts and live optical media state
+            if (qEnvironmentVariableIntValue("SOLID_DEVICE_CACHE") > 0) {
+                udisksTypes = {DeviceInterface::StorageAccess, DeviceInterface::OpticalDrive, DeviceInterface::OpticalDisc};
+            }
+#endif
+#ifdef BUILD_DEVICE_BACKEND_sysfsblock
+            // when the sysfs fast path answers the listing queries, only
+            // mount operations and optical media should materialize udisksd
+            if (qEnvironmentVariableIntValue("SOLID_SYSFS_BLOCK_BACKEND") > 0) {
+                udisksTypes = {DeviceInterface::StorageAccess, DeviceInterface::OpticalDrive, DeviceInterface::OpticalDisc};
+            }
+#endif
+            /* clang-format off */
+            slots << BackendSlot{
+                udisksTypes,
+                QStringLiteral(UD2_UDI_DISKS_PREFIX),
+                []() -> Ifaces::DeviceManager * {
+                    return new Solid::Backends::UDisks2::Manager(nullptr);
+                },
+            };
+            /* clang-format on */
         }
 #endif
 #ifdef BUILD_DEVICE_BACKEND_upower
-        if (!qEnvironmentVariableIsSet("SOLID_DISABLE_UPOWER")) {
-            m_backends << new Solid::Backends::UPower::UPowerManager(nullptr);
+        bool upowerReplaced = false;
+#ifdef BUILD_DEVICE_BACKEND_powersupply
+        // the sysfs power_supply backend covers the same devices without D-Bus
+        upowerReplaced = qEnvironmentVariableIntValue("SOLID_POWER_SUPPLY_BACKEND") > 0;
+#endif
+        if (!upowerReplaced && !qEnvironmentVariableIsSet("SOLID_DISABLE_UPOWER")) {
+            /* clang-format off */
+            slots << BackendSlot{
+                {DeviceInterface::GenericInterface, DeviceInterface::Battery},
+                QStringLiteral(UP_UDI_PREFIX),
+                []() -> Ifaces::DeviceManager * {
+                    return new Solid::Backends::UPower::UPowerManager(nullptr);
+                },
+            };
+            /* clang-format on */
         }
 #endif
 #ifdef BUILD_DEVICE_BACKEND_win
-        m_backends << new Solid::Backends::Win::WinDeviceManager(nullptr);
+        /* clang-format off */
+        slots << BackendSlot{
+            {DeviceInterface::GenericInterface, DeviceInterface::StorageAccess, DeviceInterface::StorageDrive,
+             DeviceInterface::OpticalDrive, DeviceInterface::StorageVolume, DeviceInterface::OpticalDisc,
+             DeviceInterface::Processor, DeviceInterface::Battery},
+            QString(),
+            []() -> Ifaces::DeviceManager * {
+                return new Solid::Backends::Win::WinDeviceManager(nullptr);
+            },
+        };
+        /* clang-format on */
 #endif
     }
 }
 
 QList<Solid::Ifaces::DeviceManager *> Solid::ManagerBasePrivate::managerBackends() const
 {
-    return m_backends;
+    QMutexLocker locker(&s_sharedBackends->mutex);
+
+    QList<Ifaces::DeviceManager *> result;
+    result.reserve(s_sharedBackends->slots.size());
+    for (BackendSlot &slot : s_sharedBackends->slots) {
+        result << s_sharedBackends->materialize(slot);
+    }
+
+    return result;
+}
+
+QList<Solid::Ifaces::DeviceManager *> Solid::ManagerBasePrivate::managerBackends(const QSet<DeviceInterface::Type> &types) const
+{
+    QMutexLocker locker(&s_sharedBackends->mutex);
+
+    QList<Ifaces::DeviceManager *> result;
+    for (BackendSlot &slot : s_sharedBackends->slots) {
+        if (slot.types.intersects(types)) {
+            result << s_sharedBackends->materialize(slot);
+        }
+    }
+
+    return result;
+}
+
+QList<Solid::Ifaces::DeviceManager *> Solid::ManagerBasePrivate::instantiatedBackends() const
+{
+    QMutexLocker locker(&s_sharedBackends->mutex);
+
+    QList<Ifaces::DeviceManager *> result;
+    for (const BackendSlot &slot : std::as_const(s_sharedBackends->slots)) {
+        if (slot.instance) {
+            result << slot.instance;
+        }
+    }
+
+    return result;
+}
+
+Solid::Ifaces::DeviceManager *Solid::ManagerBasePrivate::backendForUdi(const QString &udi) const
+{
+    QMutexLocker locker(&s_sharedBackends->mutex);
+
+    for (BackendSlot &slot : s_sharedBackends->slots) {
+        if (udi.startsWith(slot.udiPrefix)) {
+            return s_sharedBackends->materialize(slot);
+        }
+    }
+
+    return nullptr;
 }
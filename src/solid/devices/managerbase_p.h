@@ -12,8 +12,12 @@
 #include "ifaces/devicemanager.h"
 #include "solid/solid_export.h"
 
+class QRecursiveMutex;
+
 namespace Solid
 {
+struct SharedBackends;
+
 class ManagerBasePrivate
 {
 public:
@@ -21,10 +25,92 @@ public:
     virtual ~ManagerBasePrivate();
     void loadBackends();
 
+    /**
+     * All backend managers, instantiating any that have not been needed
+     * yet. Query paths that know the interface types they are after should
+     * prefer the typed overload so unrelated backends stay uninstantiated.
+     */
     QList<Ifaces::DeviceManager *> managerBackends() const;
 
+    /**
+     * The backend managers supporting at least one of @p types, according
+     * to the static supported-type tables; only those are instantiated.
+     */
+    QList<Ifaces::DeviceManager *> managerBackends(const QSet<DeviceInterface::Type> &types) const;
+
+    /**
+     * The backend managers that exist already; never instantiates one.
+     */
+    QList<Ifaces::DeviceManager *> instantiatedBackends() const;
+
+    /**
+     * The backend manager owning @p udi, selected by UDI prefix; only that
+     * backend is instantiated.
+     */
+    Ifaces::DeviceManager *backendForUdi(const QString &udi) const;
+
+    /**
+     * The backend instances are created once and shared by every thread
+     * that uses Solid; synchronous calls into them must hold this mutex.
+     * It is recursive because query paths nest (a query constructs Devices,
+     * which resolve their backend object through the same backends).
+     */
+    static QRecursiveMutex *backendsMutex();
+
+    /**
+     * Announces one more consumer of hotplug events in the process. On the
+     * transition from zero, every materialized backend gets
+     * setMonitoringEnabled(true), and backends materialized afterwards are
+     * armed right after construction.
+     */
+    static void addChangeSubscriber();
+
+    /**
+     * Announces one consumer of hotplug events fewer; on the transition to
+     * zero the backends are told to drop their monitors.
+     */
+    static void removeChangeSubscriber();
+
+    /**
+     * Whether any change subscriber exists. While this is false no backend
+     * events flow, so the frontend caches that rely on event-driven
+     * invalidation must be bypassed.
+     */
+    static bool monitoringActive();
+
+    /**
+     * Whether SOLID_STARTUP_TRACE is active. Query paths use it to skip
+     * the enumeration timing below when tracing is off.
+     */
+    static bool startupTraceEnabled();
+
+    /**
+     * Records how long @p backend's first enumeration took; later calls
+     * for the same backend are ignored. The recorded phases are logged as
+     * a one-line summary at process exit.
+     */
+    static void noteFirstEnumeration(Ifaces::DeviceManager *backend, qint64 nsecs);
+
+protected:
+    /**
+     * Called with the backends mutex held whenever a backend manager is
+     * instantiated, including replays from loadBackends() for backends that
+     * other threads created earlier. Subclasses hook their signal
+     * connections and dispatch tables here.
+     */
+    virtual void backendInstantiated(Ifaces::DeviceManager *backend);
+
+    /**
+     * Called with the backends mutex held, possibly from another thread,
+     * when change monitoring flips between armed and dropped. Managers
+     * whose caches depend on event-driven invalidation drop them when
+     * monitoring comes back, since events that happened while it was down
+     * are lost. The default implementation does nothing.
+     */
+    virtual void monitoringChanged(bool active);
+
 private:
-    QList<Ifaces::DeviceManager *> m_backends;
+    friend struct SharedBackends;
 };
 }
 
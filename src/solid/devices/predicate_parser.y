@@ -33,6 +33,10 @@ typedef void *yyscan_t;
 
 %token EQ
 %token MASK
+%token GT
+%token GTE
+%token LT
+%token LTE
 
 %token AND
 %token OR
@@ -70,6 +74,10 @@ predicate: predicate_atom { PredicateParse_setResult( $<ptr>1 ); $$ = $<ptr>1; }
 
 predicate_atom: VAL_ID '.' VAL_ID EQ value { $$ = PredicateParse_newAtom( $<name>1, $<name>3, $<ptr>5 ); }
               | VAL_ID '.' VAL_ID MASK value { $$ = PredicateParse_newMaskAtom( $<name>1, $<name>3, $<ptr>5 ); }
+              | VAL_ID '.' VAL_ID GT value { $$ = PredicateParse_newRelationAtom( $<name>1, $<name>3, $<ptr>5, PREDICATE_PARSE_RELATION_GT ); }
+              | VAL_ID '.' VAL_ID GTE value { $$ = PredicateParse_newRelationAtom( $<name>1, $<name>3, $<ptr>5, PREDICATE_PARSE_RELATION_GTE ); }
+              | VAL_ID '.' VAL_ID LT value { $$ = PredicateParse_newRelationAtom( $<name>1, $<name>3, $<ptr>5, PREDICATE_PARSE_RELATION_LT ); }
+              | VAL_ID '.' VAL_ID LTE value { $$ = PredicateParse_newRelationAtom( $<name>1, $<name>3, $<ptr>5, PREDICATE_PARSE_RELATION_LTE ); }
               | IS VAL_ID { $$ = PredicateParse_newIsAtom( $<name>2 ); }
 
 predicate_or: predicate OR predicate { $$ = PredicateParse_newOr( $<ptr>1, $<ptr>3 ); }
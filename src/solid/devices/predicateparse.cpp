@@ -15,6 +15,7 @@ void PredicateParse_mainParse(const char *_code);
 
 #include <stdlib.h>
 
+#include <QCache>
 #include <QStringList>
 #include <QThreadStorage>
 
@@ -37,18 +38,40 @@ struct ParsingData {
 
 Q_GLOBAL_STATIC(QThreadStorage<Solid::PredicateParse::ParsingData *>, s_parsingData)
 
+// Clients like the device notifier keep round-tripping the same handful of
+// predicate strings through fromString(). Since Predicate is implicitly
+// shared, keeping the parsed results around per thread makes those repeat
+// calls a hash lookup plus a constant-time copy.
+static const int s_parseCacheSize = 32;
+Q_GLOBAL_STATIC(QThreadStorage<QCache<QString, Solid::Predicate> *>, s_parseCache)
+
 Solid::Predicate Solid::Predicate::fromString(const QString &predicate)
 {
-    Solid::PredicateParse::ParsingData *data = new Solid::PredicateParse::ParsingData();
-    s_parsingData->setLocalData(data);
+    QCache<QString, Predicate> *cache = s_parseCache->localData();
+    if (!cache) {
+        cache = new QCache<QString, Predicate>(s_parseCacheSize);
+        s_parseCache->setLocalData(cache);
+    }
+    if (const Predicate *cached = cache->object(predicate)) {
+        return *cached;
+    }
+
+    Solid::PredicateParse::ParsingData *data = s_parsingData->localData();
+    if (!data) {
+        data = new Solid::PredicateParse::ParsingData();
+        s_parsingData->setLocalData(data);
+    }
+    data->result = nullptr;
     data->buffer = predicate.toLatin1();
     PredicateParse_mainParse(data->buffer.constData());
     Predicate result;
     if (data->result) {
         result = Predicate(*data->result);
         delete data->result;
+        data->result = nullptr;
+        cache->insert(predicate, new Predicate(result));
     }
-    s_parsingData->setLocalData(nullptr);
+    data->buffer.clear();
     return result;
 }
 
@@ -103,6 +126,37 @@ void *PredicateParse_newMaskAtom(char *interface, char *property, void *value)
     return result;
 }
 
+void *PredicateParse_newRelationAtom(char *interface, char *property, void *value, int relation)
+{
+    QString iface = QString::fromLatin1(interface, -1);
+    QString prop = QString::fromLatin1(property, -1);
+    QVariant *val = (QVariant *)value;
+
+    Solid::Predicate::ComparisonOperator compOperator = Solid::Predicate::GreaterThan;
+    switch (relation) {
+    case PREDICATE_PARSE_RELATION_GT:
+        compOperator = Solid::Predicate::GreaterThan;
+        break;
+    case PREDICATE_PARSE_RELATION_GTE:
+        compOperator = Solid::Predicate::GreaterThanOrEqual;
+        break;
+    case PREDICATE_PARSE_RELATION_LT:
+        compOperator = Solid::Predicate::LessThan;
+        break;
+    case PREDICATE_PARSE_RELATION_LTE:
+        compOperator = Solid::Predicate::LessThanOrEqual;
+        break;
+    }
+
+    Solid::Predicate *result = new Solid::Predicate(iface, prop, *val, compOperator);
+
+    delete val;
+    free(interface);
+    free(property);
+
+    return result;
+}
+
 void *PredicateParse_newIsAtom(char *interface)
 {
     QString iface = QString::fromLatin1(interface);
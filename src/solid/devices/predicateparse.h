@@ -13,8 +13,16 @@ void PredicateParse_setResult(void *result);
 void PredicateParse_errorDetected(const char *error);
 void PredicateParse_destroy(void *pred);
 
+/* relation codes for PredicateParse_newRelationAtom; the grammar is plain C,
+ * so the Solid::Predicate::ComparisonOperator mapping lives on the C++ side */
+#define PREDICATE_PARSE_RELATION_GT 0
+#define PREDICATE_PARSE_RELATION_GTE 1
+#define PREDICATE_PARSE_RELATION_LT 2
+#define PREDICATE_PARSE_RELATION_LTE 3
+
 void *PredicateParse_newAtom(char *interface, char *property, void *value);
 void *PredicateParse_newMaskAtom(char *interface, char *property, void *value);
+void *PredicateParse_newRelationAtom(char *interface, char *property, void *value, int relation);
 void *PredicateParse_newIsAtom(char *interface);
 void *PredicateParse_newAnd(void *pred1, void *pred2);
 void *PredicateParse_newOr(void *pred1, void *pred2);
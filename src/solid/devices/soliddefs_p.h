@@ -27,4 +27,17 @@
         t->Method; \
     }
 
+// fast-path variant for hot getters: the qobject_cast result is memoized
+// in the interface's d-pointer instead of being recomputed per call
+#define return_SOLID_CACHED_CALL(Type, D, Default, Method) \
+    Type t = (D)->backendIface<Type>(); \
+    if (t!=nullptr) \
+    { \
+        return t->Method; \
+    } \
+    else \
+    { \
+        return Default; \
+    }
+
 #endif
@@ -0,0 +1,81 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "solidstatistics_p.h"
+
+#include <config-backends.h>
+
+#include "devices_debug.h"
+#ifdef BUILD_DEVICE_BACKEND_fstab
+#include "fstab_debug.h"
+#endif
+#ifdef BUILD_DEVICE_BACKEND_udisks2
+#include "udisks_debug.h"
+#endif
+
+#include <QLoggingCategory>
+
+#include <cstdlib>
+#include <mutex>
+
+/* SOLID_PROFILE support: a process-exit dump of the statistics counters,
+ * routed through the per-subsystem logging categories so the lines can be
+ * filtered like any other Solid output. The counters themselves are
+ * maintained unconditionally (one relaxed atomic add per event); the only
+ * cost added here when profiling is off is a single env lookup at startup. */
+
+namespace Solid
+{
+namespace Stats
+{
+static void reportProfile()
+{
+    Counters &c = counters();
+
+    qCInfo(Solid::Frontend::DeviceManager::DEVICEMANAGER,
+           "profile: devices=%lld constructions=%lld queries=%lld query_cache_hits=%lld predicate_evaluations=%lld registry_kb=%lld",
+           static_cast<long long>(c.registeredDevices.loadRelaxed()),
+           static_cast<long long>(c.deviceConstructions.loadRelaxed()),
+           static_cast<long long>(c.queries.loadRelaxed()),
+           static_cast<long long>(c.queryCacheHits.loadRelaxed()),
+           static_cast<long long>(c.predicateEvaluations.loadRelaxed()),
+           static_cast<long long>(c.registryBytes.loadRelaxed() / 1024));
+
+#ifdef BUILD_DEVICE_BACKEND_udisks2
+    qCInfo(Solid::Backends::UDisks2::UDISKS2,
+           "profile: property_cache_hits=%lld misses=%lld getall_calls=%lld introspect_calls=%lld blocking_calls=%lld blocking_ms=%.1f",
+           static_cast<long long>(c.propertyCacheHits.loadRelaxed()),
+           static_cast<long long>(c.propertyCacheMisses.loadRelaxed()),
+           static_cast<long long>(c.getAllCalls.loadRelaxed()),
+           static_cast<long long>(c.introspectCalls.loadRelaxed()),
+           static_cast<long long>(c.blockingDBusCalls.loadRelaxed()),
+           c.blockingDBusNsecs.loadRelaxed() / 1000000.0);
+    qCInfo(Solid::Backends::UDisks2::UDISKS2, "profile: property_cache_kb=%lld", static_cast<long long>(c.udisksPropertyCacheBytes.loadRelaxed() / 1024));
+#endif
+
+#ifdef BUILD_DEVICE_BACKEND_fstab
+    qCInfo(Solid::Backends::Fstab::FSTAB_LOG,
+           "profile: cache_refills=%lld cache_kb=%lld",
+           static_cast<long long>(c.fstabCacheRefills.loadRelaxed()),
+           static_cast<long long>(c.fstabCacheBytes.loadRelaxed() / 1024));
+#endif
+}
+
+void maybeInstallProfileReporter()
+{
+    static std::once_flag s_once;
+    std::call_once(s_once, []() {
+        if (qEnvironmentVariableIntValue("SOLID_PROFILE") <= 0) {
+            return;
+        }
+        // the categories default to Warning; profiling explicitly opts
+        // their Info level in so the summary actually reaches the log
+        QLoggingCategory::setFilterRules(QStringLiteral("kf.solid.*.info=true"));
+        std::atexit(reportProfile);
+    });
+}
+}
+}
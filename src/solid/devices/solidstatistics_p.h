@@ -0,0 +1,106 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_SOLIDSTATISTICS_P_H
+#define SOLID_SOLIDSTATISTICS_P_H
+
+#include <QAtomicInteger>
+#include <QVariant>
+
+/* Process-wide counters behind Solid::statistics(). The hot paths bump
+ * them with a single relaxed atomic add each, so instrumentation stays on
+ * unconditionally; aggregation only happens when somebody asks. */
+
+namespace Solid
+{
+namespace Stats
+{
+struct Counters {
+    // UDisks2 property cache (DeviceBackend)
+    QAtomicInteger<qint64> propertyCacheHits;
+    QAtomicInteger<qint64> propertyCacheMisses;
+    QAtomicInteger<qint64> getAllCalls;
+
+    // UDisks2 legacy enumeration fallback (Manager)
+    QAtomicInteger<qint64> introspectCalls;
+
+    // udev full re-enumerations (UDevManager)
+    QAtomicInteger<qint64> udevEnumerations;
+
+    // frontend registry and query layer (DeviceManagerPrivate)
+    QAtomicInteger<qint64> registeredDevices;
+    QAtomicInteger<qint64> queries;
+    QAtomicInteger<qint64> queryCacheHits;
+
+    // frontend object churn and predicate evaluation
+    QAtomicInteger<qint64> deviceConstructions;
+    QAtomicInteger<qint64> predicateEvaluations;
+
+    // synchronous round-trips to the bus and the time spent waiting in them
+    QAtomicInteger<qint64> blockingDBusCalls;
+    QAtomicInteger<qint64> blockingDBusNsecs;
+
+    // fstab/mtab table reparses (FstabHandling)
+    QAtomicInteger<qint64> fstabCacheRefills;
+
+    /* Estimated bytes currently held per subsystem. Maintained as deltas
+     * by the owning code at its natural mutation points, so reading them
+     * needs no locks; they are estimates, not allocator truth. */
+    QAtomicInteger<qint64> registryBytes;
+    QAtomicInteger<qint64> udisksPropertyCacheBytes;
+    QAtomicInteger<qint64> udevDeviceListBytes;
+    QAtomicInteger<qint64> fstabCacheBytes;
+};
+
+inline Counters &counters()
+{
+    static Counters s_counters;
+    return s_counters;
+}
+
+inline void add(QAtomicInteger<qint64> &counter, qint64 amount = 1)
+{
+    counter.fetchAndAddRelaxed(amount);
+}
+
+/* Rough size estimates feeding the byte counters above. They charge the
+ * payload plus a flat guess at container-node overhead; consistency between
+ * the add and the matching subtract matters more than absolute accuracy. */
+inline qint64 stringBytes(const QString &string)
+{
+    return sizeof(QString) + 2 * string.size();
+}
+
+inline qint64 variantBytes(const QVariant &value)
+{
+    switch (value.typeId()) {
+    case QMetaType::QString:
+        return sizeof(QVariant) + 2 * value.toString().size();
+    case QMetaType::QByteArray:
+        return sizeof(QVariant) + value.toByteArray().size();
+    case QMetaType::QStringList: {
+        qint64 bytes = sizeof(QVariant);
+        const QStringList list = value.toStringList();
+        for (const QString &entry : list) {
+            bytes += stringBytes(entry);
+        }
+        return bytes;
+    }
+    default:
+        return sizeof(QVariant) + 8;
+    }
+}
+
+/*
+ * When SOLID_PROFILE is set in the environment, registers an exit handler
+ * that logs the counters above through the library's logging categories.
+ * Safe to call from several threads; only the first call does anything.
+ */
+void maybeInstallProfileReporter();
+}
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_SOLIDTRACE_P_H
+#define SOLID_SOLIDTRACE_P_H
+
+#include <config-solid.h>
+
+/*
+ * Static USDT tracepoints on the hot and potentially blocking paths, under
+ * the "solid" provider. With systemtap headers present they compile to a
+ * single nop each until a tracer (perf, bpftrace, stap) attaches; without
+ * the headers everything here — including the argument expressions and the
+ * timers at the call sites — vanishes at compile time.
+ *
+ * Example:
+ *   bpftrace -e 'usdt:*libKF6Solid*:solid:udisks_all_properties
+ *                { printf("%s %d us\n", str(arg0), arg1 / 1000); }'
+ */
+
+#if HAVE_SYS_SDT_H
+
+#include <QElapsedTimer>
+#include <sys/sdt.h>
+
+#define SOLID_TRACE1(point, arg1) DTRACE_PROBE1(solid, point, arg1)
+#define SOLID_TRACE2(point, arg1, arg2) DTRACE_PROBE2(solid, point, arg1, arg2)
+
+namespace Solid
+{
+namespace Trace
+{
+class Timer
+{
+public:
+    Timer()
+    {
+        m_timer.start();
+    }
+
+    qint64 nsecs() const
+    {
+        return m_timer.nsecsElapsed();
+    }
+
+private:
+    QElapsedTimer m_timer;
+};
+
+}
+}
+
+#else
+
+#define SOLID_TRACE1(point, arg1) \
+    do { \
+    } while (false)
+#define SOLID_TRACE2(point, arg1, arg2) \
+    do { \
+    } while (false)
+
+namespace Solid
+{
+namespace Trace
+{
+class Timer
+{
+public:
+    constexpr qint64 nsecs() const
+    {
+        return 0;
+    }
+};
+
+}
+}
+
+#endif
+
+#endif // SOLID_SOLIDTRACE_P_H
@@ -0,0 +1,89 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_SOLIDWATCHDOG_P_H
+#define SOLID_SOLIDWATCHDOG_P_H
+
+#include "solidstatistics_p.h"
+
+#include <QAbstractEventDispatcher>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QString>
+
+/*
+ * RAII guard around synchronous bus round-trips. Every guarded call feeds
+ * the blocking-call statistics; a call that overruns the watchdog threshold
+ * on a thread driving an event loop is additionally reported through the
+ * owning backend's logging category with its call site, context (usually
+ * the UDI) and duration. Stalls that used to surface one crash report at a
+ * time this way become grep-able log lines.
+ *
+ * The threshold defaults to 250 ms and can be tuned per process with
+ * SOLID_BLOCKING_CALL_WARN_MS; 0 disables the reporting (the statistics
+ * are maintained regardless).
+ */
+
+namespace Solid
+{
+namespace Watchdog
+{
+inline qint64 thresholdNsecs()
+{
+    static const qint64 s_threshold = []() {
+        bool ok = false;
+        const int ms = qEnvironmentVariableIntValue("SOLID_BLOCKING_CALL_WARN_MS", &ok);
+        return (ok ? ms : 250) * qint64(1000000);
+    }();
+    return s_threshold;
+}
+
+class BlockingCallGuard
+{
+public:
+    BlockingCallGuard(const QLoggingCategory &category, const char *callSite, const QString &context = QString())
+        : m_category(category)
+        , m_callSite(callSite)
+        , m_context(context)
+    {
+        m_timer.start();
+    }
+
+    ~BlockingCallGuard()
+    {
+        const qint64 nsecs = m_timer.nsecsElapsed();
+        Solid::Stats::add(Solid::Stats::counters().blockingDBusCalls);
+        Solid::Stats::add(Solid::Stats::counters().blockingDBusNsecs, nsecs);
+
+        const qint64 threshold = thresholdNsecs();
+        if (threshold <= 0 || nsecs < threshold) {
+            return;
+        }
+        /* blocking only stalls anything when this thread has an event loop
+         * to starve; worker threads may wait as long as they like */
+        if (!QAbstractEventDispatcher::instance()) {
+            return;
+        }
+        qCWarning(m_category,
+                  "watchdog: blocking call %s (%s) held up the event loop for %.1f ms",
+                  m_callSite,
+                  qUtf8Printable(m_context),
+                  nsecs / 1000000.0);
+    }
+
+    Q_DISABLE_COPY(BlockingCallGuard)
+
+private:
+    const QLoggingCategory &m_category;
+    const char *const m_callSite;
+    const QString m_context;
+    QElapsedTimer m_timer;
+};
+
+}
+}
+
+#endif // SOLID_SOLIDWATCHDOG_P_H
@@ -0,0 +1,80 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#include "udistringpool_p.h"
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+namespace
+{
+struct UdiPool {
+    QMutex mutex;
+    // canonical string -> handle; the keys share their data with m_strings
+    QHash<QString, Solid::DeviceHandle> handles;
+    // handle - 1 -> canonical string; handles are assigned densely from 1
+    QList<QString> strings;
+
+    // returns the handle of udi, interning it on first sight; the mutex
+    // must be held
+    Solid::DeviceHandle internLocked(const QString &udi, QString *canonical)
+    {
+        auto it = handles.constFind(udi);
+        if (it == handles.constEnd()) {
+            strings.append(udi);
+            it = handles.insert(strings.last(), Solid::DeviceHandle(strings.size()));
+        }
+        if (canonical) {
+            *canonical = it.key();
+        }
+        return it.value();
+    }
+};
+}
+
+Q_GLOBAL_STATIC(UdiPool, s_udiPool)
+
+QString Solid::internedUdi(const QString &udi)
+{
+    if (udi.isEmpty()) {
+        return udi;
+    }
+
+    UdiPool *pool = s_udiPool();
+    QMutexLocker locker(&pool->mutex);
+
+    QString canonical;
+    pool->internLocked(udi, &canonical);
+    return canonical;
+}
+
+Solid::DeviceHandle Solid::udiHandle(const QString &udi)
+{
+    if (udi.isEmpty()) {
+        return 0;
+    }
+
+    UdiPool *pool = s_udiPool();
+    QMutexLocker locker(&pool->mutex);
+
+    return pool->internLocked(udi, nullptr);
+}
+
+QString Solid::udiFromHandle(DeviceHandle handle)
+{
+    if (handle == 0) {
+        return QString();
+    }
+
+    UdiPool *pool = s_udiPool();
+    QMutexLocker locker(&pool->mutex);
+
+    if (handle > DeviceHandle(pool->strings.size())) {
+        return QString();
+    }
+    return pool->strings.at(handle - 1);
+}
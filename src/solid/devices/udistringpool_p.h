@@ -0,0 +1,54 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+#ifndef SOLID_UDISTRINGPOOL_P_H
+#define SOLID_UDISTRINGPOOL_P_H
+
+#include <QString>
+
+namespace Solid
+{
+/**
+ * Returns the canonical shared copy of @p udi.
+ *
+ * The same UDI strings flow through the frontend registry, the backend
+ * caches and every deviceAdded/deviceRemoved signal. Interning them in a
+ * single pool makes all holders share one allocation and lets equality
+ * comparisons between interned copies hit the identical-data fast path
+ * instead of comparing characters.
+ *
+ * The pool is process-wide and thread-safe. It holds at most one entry per
+ * distinct UDI ever seen, so its size is bounded by the device namespace.
+ */
+QString internedUdi(const QString &udi);
+
+/**
+ * Compact per-process identity of a device.
+ *
+ * Handles are assigned the first time a UDI enters the pool and stay
+ * stable for the lifetime of the process. Hot per-event bookkeeping
+ * (subscription match sets, presence checks during hotplug storms) can
+ * key on the handle instead of re-hashing the UDI string on every event.
+ *
+ * 0 is never assigned; it stands for "no device" / the empty UDI.
+ */
+using DeviceHandle = quint32;
+
+/**
+ * Returns the handle of @p udi, assigning one if it is new to the pool.
+ *
+ * The UDI is interned as a side effect. Thread-safe.
+ */
+DeviceHandle udiHandle(const QString &udi);
+
+/**
+ * Returns the canonical UDI string behind @p handle, or an empty string
+ * for 0 and for handles this process never assigned. Thread-safe.
+ */
+QString udiFromHandle(DeviceHandle handle);
+}
+
+#endif
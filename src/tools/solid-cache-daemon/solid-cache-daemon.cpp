@@ -0,0 +1,217 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+/*
+ * Session device cache daemon.
+ *
+ * Owns the real Solid backends once per session, captures every device
+ * into a shared-memory snapshot and notifies connected clients over a
+ * local socket whenever the snapshot generation changes. Processes
+ * started with SOLID_DEVICE_CACHE=1 read the snapshot instead of
+ * enumerating udev and UDisks2 themselves.
+ */
+
+#include <QCoreApplication>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTimer>
+
+#include <QDebug>
+
+#include <solid/block.h>
+#include <solid/camera.h>
+#include <solid/device.h>
+#include <solid/deviceinterface.h>
+#include <solid/devicenotifier.h>
+#include <solid/genericinterface.h>
+#include <solid/portablemediaplayer.h>
+#include <solid/processor.h>
+#include <solid/storagedrive.h>
+#include <solid/storagevolume.h>
+
+#include <solid/devices/backends/shared/devicesnapshot.h>
+
+using Solid::Backends::Shared::DeviceSnapshotWriter;
+using Solid::Backends::Shared::SnapshotDevice;
+namespace DeviceSnapshot = Solid::Backends::Shared::DeviceSnapshot;
+
+/* Window over which change notifications are coalesced before the
+ * snapshot is rebuilt; mirrors the frontend's own batching. */
+static const int kRebuildDelayMsecs = 200;
+
+class SnapshotPublisher : public QObject
+{
+    Q_OBJECT
+
+public:
+    SnapshotPublisher();
+
+    bool start();
+
+private Q_SLOTS:
+    void rebuild();
+    void onNewConnection();
+
+private:
+    static SnapshotDevice capture(const Solid::Device &device);
+    void broadcast();
+
+    DeviceSnapshotWriter m_writer;
+    QLocalServer m_server;
+    QList<QLocalSocket *> m_clients;
+    QTimer m_rebuildTimer;
+    quint64 m_generation = 0;
+};
+
+SnapshotPublisher::SnapshotPublisher()
+{
+    m_rebuildTimer.setSingleShot(true);
+    m_rebuildTimer.setInterval(kRebuildDelayMsecs);
+    connect(&m_rebuildTimer, &QTimer::timeout, this, &SnapshotPublisher::rebuild);
+
+    auto *notifier = Solid::DeviceNotifier::instance();
+    connect(notifier, &Solid::DeviceNotifier::deviceAdded, &m_rebuildTimer, qOverload<>(&QTimer::start));
+    connect(notifier, &Solid::DeviceNotifier::deviceRemoved, &m_rebuildTimer, qOverload<>(&QTimer::start));
+
+    connect(&m_server, &QLocalServer::newConnection, this, &SnapshotPublisher::onNewConnection);
+}
+
+bool SnapshotPublisher::start()
+{
+    // a previous instance may have left its socket behind
+    QLocalServer::removeServer(DeviceSnapshot::serverName());
+    if (!m_server.listen(DeviceSnapshot::serverName())) {
+        qWarning() << "Cannot listen on" << DeviceSnapshot::serverName() << ":" << m_server.errorString();
+        return false;
+    }
+
+    rebuild();
+    return true;
+}
+
+SnapshotDevice SnapshotPublisher::capture(const Solid::Device &device)
+{
+    SnapshotDevice snapshot;
+    snapshot.udi = device.udi();
+    snapshot.parentUdi = device.parentUdi();
+    snapshot.vendor = device.vendor();
+    snapshot.product = device.product();
+    snapshot.icon = device.icon();
+    snapshot.emblems = device.emblems();
+    snapshot.description = device.description();
+
+    for (int type = Solid::DeviceInterface::Unknown + 1; type < Solid::DeviceInterface::Last; ++type) {
+        if (device.isDeviceInterface(Solid::DeviceInterface::Type(type))) {
+            snapshot.interfaceTypes << type;
+        }
+    }
+
+    QVariantMap &props = snapshot.properties;
+
+    if (const auto *generic = device.as<Solid::GenericInterface>()) {
+        props.insert(QStringLiteral("genericProperties"), generic->allProperties());
+    }
+    if (const auto *processor = device.as<Solid::Processor>()) {
+        props.insert(QStringLiteral("processor.number"), processor->number());
+        props.insert(QStringLiteral("processor.maxSpeed"), qulonglong(processor->maxSpeed()));
+        props.insert(QStringLiteral("processor.canChangeFrequency"), processor->canChangeFrequency());
+        props.insert(QStringLiteral("processor.instructionSets"), int(processor->instructionSets()));
+        props.insert(QStringLiteral("processor.packageId"), processor->packageId());
+        props.insert(QStringLiteral("processor.coreId"), processor->coreId());
+        props.insert(QStringLiteral("processor.threadSiblings"), QVariant::fromValue(processor->threadSiblings()));
+    }
+    if (const auto *block = device.as<Solid::Block>()) {
+        props.insert(QStringLiteral("block.major"), block->deviceMajor());
+        props.insert(QStringLiteral("block.minor"), block->deviceMinor());
+        props.insert(QStringLiteral("block.device"), block->device());
+    }
+    if (const auto *drive = device.as<Solid::StorageDrive>()) {
+        props.insert(QStringLiteral("storagedrive.bus"), int(drive->bus()));
+        props.insert(QStringLiteral("storagedrive.driveType"), int(drive->driveType()));
+        props.insert(QStringLiteral("storagedrive.removable"), drive->isRemovable());
+        props.insert(QStringLiteral("storagedrive.hotpluggable"), drive->isHotpluggable());
+        props.insert(QStringLiteral("storagedrive.size"), drive->size());
+        props.insert(QStringLiteral("storagedrive.timeDetected"), drive->timeDetected());
+        props.insert(QStringLiteral("storagedrive.timeMediaDetected"), drive->timeMediaDetected());
+    }
+    if (const auto *volume = device.as<Solid::StorageVolume>()) {
+        props.insert(QStringLiteral("storagevolume.ignored"), volume->isIgnored());
+        props.insert(QStringLiteral("storagevolume.usage"), int(volume->usage()));
+        props.insert(QStringLiteral("storagevolume.fsType"), volume->fsType());
+        props.insert(QStringLiteral("storagevolume.label"), volume->label());
+        props.insert(QStringLiteral("storagevolume.uuid"), volume->uuid());
+        props.insert(QStringLiteral("storagevolume.size"), volume->size());
+        props.insert(QStringLiteral("storagevolume.encryptedContainerUdi"), volume->encryptedContainer().udi());
+    }
+    if (const auto *camera = device.as<Solid::Camera>()) {
+        props.insert(QStringLiteral("camera.supportedProtocols"), camera->supportedProtocols());
+        props.insert(QStringLiteral("camera.supportedDrivers"), camera->supportedDrivers());
+    }
+    if (const auto *player = device.as<Solid::PortableMediaPlayer>()) {
+        props.insert(QStringLiteral("portablemediaplayer.supportedProtocols"), player->supportedProtocols());
+        props.insert(QStringLiteral("portablemediaplayer.supportedDrivers"), player->supportedDrivers());
+    }
+
+    return snapshot;
+}
+
+void SnapshotPublisher::rebuild()
+{
+    const QList<Solid::Device> devices = Solid::Device::allDevices();
+
+    QList<SnapshotDevice> snapshots;
+    snapshots.reserve(devices.size());
+    for (const Solid::Device &device : devices) {
+        snapshots.append(capture(device));
+    }
+
+    ++m_generation;
+    if (!m_writer.publish(DeviceSnapshot::serialize(snapshots, m_generation))) {
+        qWarning() << "Cannot publish snapshot generation" << m_generation;
+        return;
+    }
+
+    broadcast();
+}
+
+void SnapshotPublisher::onNewConnection()
+{
+    while (QLocalSocket *client = m_server.nextPendingConnection()) {
+        m_clients.append(client);
+        connect(client, &QLocalSocket::disconnected, this, [this, client]() {
+            m_clients.removeOne(client);
+            client->deleteLater();
+        });
+        client->write(QByteArray::number(qulonglong(m_generation)) + '\n');
+    }
+}
+
+void SnapshotPublisher::broadcast()
+{
+    const QByteArray notification = QByteArray::number(qulonglong(m_generation)) + '\n';
+    for (QLocalSocket *client : std::as_const(m_clients)) {
+        client->write(notification);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    /* The daemon must enumerate the real backends, never its own cache,
+     * even when started from an environment that enables it for clients. */
+    qunsetenv("SOLID_DEVICE_CACHE");
+
+    QCoreApplication app(argc, argv);
+    app.setApplicationName(QStringLiteral("solid-cache-daemon"));
+
+    SnapshotPublisher publisher;
+    if (!publisher.start()) {
+        return 1;
+    }
+
+    return app.exec();
+}
+
+#include "solid-cache-daemon.moc"
@@ -11,20 +11,29 @@
 #include <QDBusArgument>
 #include <QDBusObjectPath>
 #endif
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QMetaEnum>
 #include <QMetaProperty>
 #include <QString>
 #include <QStringList>
 #include <QTextStream>
+#include <QTimer>
 
 #include <QCommandLineParser>
 
+#include <algorithm>
+
 #include <solid/device.h>
 #include <solid/genericinterface.h>
 #include <solid/opticaldrive.h>
 
 #include <iostream>
 #include <solid/devicenotifier.h>
+#include <solid/devicesubscription.h>
+#include <solid/predicate.h>
 using namespace std;
 
 static const QString appName{QStringLiteral("solid-hardware")};
@@ -168,19 +177,19 @@ std::ostream &operator<<(std::ostream &out, const Solid::Device &device)
     out << "  description = " << QVariant(device.description()) << endl;
     out << "  icon = " << QVariant(device.icon()) << endl;
 
-    int index = Solid::DeviceInterface::staticMetaObject.indexOfEnumerator("Type");
-    QMetaEnum typeEnum = Solid::DeviceInterface::staticMetaObject.enumerator(index);
-
-    for (int i = 0; i < typeEnum.keyCount(); i++) {
-        Solid::DeviceInterface::Type type = (Solid::DeviceInterface::Type)typeEnum.value(i);
+    // the Type enum is contiguous; walking it directly spares the QMetaEnum
+    // reflection round trip per invocation
+    for (int i = Solid::DeviceInterface::GenericInterface; i < Solid::DeviceInterface::Last; i++) {
+        const auto type = static_cast<Solid::DeviceInterface::Type>(i);
         const Solid::DeviceInterface *interface = device.asDeviceInterface(type);
 
         if (interface) {
             const QMetaObject *meta = interface->metaObject();
+            const QByteArray typeName = Solid::DeviceInterface::typeToString(type).toLatin1();
 
             for (int i = meta->propertyOffset(); i < meta->propertyCount(); i++) {
                 QMetaProperty property = meta->property(i);
-                out << "  " << QByteArray(meta->className()).mid(7).constData() << "." << property.name() << " = ";
+                out << "  " << typeName.constData() << "." << property.name() << " = ";
 
                 QVariant value = property.read(interface);
 
@@ -223,6 +232,16 @@ QString getUdiFromArguments(QCoreApplication &app, QCommandLineParser &parser)
     return parser.positionalArguments().at(1);
 }
 
+QStringList getUdisFromArguments(QCoreApplication &app, QCommandLineParser &parser)
+{
+    parser.addPositionalArgument(QStringLiteral("udi"), QCoreApplication::translate("solid-hardware", "Device udis"), QStringLiteral("udi [udi...]"));
+    parser.process(app);
+    if (parser.positionalArguments().count() < 2) {
+        parser.showHelp(1);
+    }
+    return parser.positionalArguments().mid(1);
+}
+
 static QString commandsHelp()
 {
     QString data;
@@ -253,25 +272,53 @@ static QString commandsHelp()
                                         "             # (be careful, in this case property names are backend dependent).\n")
          << '\n';
 
-    cout << "  solid-hardware query 'predicate' ['parentUdi']" << '\n';
+    cout << "  solid-hardware query [--monitor] 'predicate' ['parentUdi']" << '\n';
     cout << QCoreApplication::translate("solid-hardware",
                                         "             # List the UDI of devices corresponding to 'predicate'.\n"
                                         "             # - If 'parentUdi' is specified, the search is restricted to the\n"
                                         "             # branch of the corresponding device,\n"
-                                        "             # - Otherwise the search is done on all the devices.\n")
+                                        "             # - Otherwise the search is done on all the devices.\n"
+                                        "             # With '--monitor' the process stays alive after the initial\n"
+                                        "             # listing and prints match/unmatch transitions as devices come\n"
+                                        "             # and go ('parentUdi' is not supported in this mode).\n")
          << '\n';
 
-    cout << "  solid-hardware mount 'udi'" << '\n';
-    cout << QCoreApplication::translate("solid-hardware", "             # If applicable, mount the device corresponding to 'udi'.\n") << '\n';
+    cout << "  solid-hardware mount 'udi' ['udi'...]" << '\n';
+    cout << QCoreApplication::translate("solid-hardware", "             # If applicable, mount the devices corresponding to the given udis.\n"
+                                                          "             # Multiple devices are mounted concurrently.\n")
+         << '\n';
 
-    cout << "  solid-hardware unmount 'udi'" << '\n';
-    cout << QCoreApplication::translate("solid-hardware", "             # If applicable, unmount the device corresponding to 'udi'.\n") << '\n';
+    cout << "  solid-hardware unmount 'udi' ['udi'...]" << '\n';
+    cout << QCoreApplication::translate("solid-hardware", "             # If applicable, unmount the devices corresponding to the given udis.\n"
+                                                          "             # Multiple devices are unmounted concurrently.\n")
+         << '\n';
 
-    cout << "  solid-hardware eject 'udi'" << '\n';
-    cout << QCoreApplication::translate("solid-hardware", "             # If applicable, eject the device corresponding to 'udi'.\n") << '\n';
+    cout << "  solid-hardware eject 'udi' ['udi'...]" << '\n';
+    cout << QCoreApplication::translate("solid-hardware", "             # If applicable, eject the devices corresponding to the given udis.\n"
+                                                          "             # Multiple devices are ejected concurrently.\n")
+         << '\n';
 
-    cout << "  solid-hardware listen" << '\n';
-    cout << QCoreApplication::translate("solid-hardware", "             # Listen to all add/remove events on supported hardware.\n") << '\n';
+    cout << "  solid-hardware benchmark ['runs']" << '\n';
+    cout << QCoreApplication::translate("solid-hardware",
+                                        "             # Time device enumeration, queries and property reads over\n"
+                                        "             # 'runs' iterations (default 50) and print percentile\n"
+                                        "             # latencies in CSV form.\n")
+         << '\n';
+
+    cout << "  solid-hardware export ['json'|'xml']" << '\n';
+    cout << QCoreApplication::translate("solid-hardware",
+                                        "             # Dump the whole machine in one pass: a single enumeration,\n"
+                                        "             # one bulk property fetch per device, all interfaces and\n"
+                                        "             # properties, as JSON (default) or fakehw-style XML.\n")
+         << '\n';
+
+    cout << "  solid-hardware listen [--stats]" << '\n';
+    cout << QCoreApplication::translate("solid-hardware",
+                                        "             # Listen to all add/remove events on supported hardware.\n"
+                                        "             # Events are timestamped and grouped into bursts; with\n"
+                                        "             # '--stats' a summary (burst size, duration, overall rate)\n"
+                                        "             # is printed after each burst.\n")
+         << '\n';
 
     cout << "  solid-hardware monitor 'udi'" << '\n';
     cout << QCoreApplication::translate("solid-hardware", "             # Monitor devices for changes.\n") << '\n';
@@ -338,10 +385,13 @@ int main(int argc, char **argv)
         const QString udi = getUdiFromArguments(app, parser);
         return app.hwProperties(udi);
     } else if (command == QLatin1String("query")) {
+        QCommandLineOption monitor(QStringLiteral("monitor"), QCoreApplication::translate("solid-hardware", "Keep running and print match/unmatch transitions"));
+        parser.addOption(monitor);
         parser.addPositionalArgument(QStringLiteral("udi"), QCoreApplication::translate("solid-hardware", "Device udi"));
         parser.addPositionalArgument(QStringLiteral("parent"), QCoreApplication::translate("solid-hardware", "Parent device udi"));
         parser.process(app);
-        if (parser.positionalArguments().count() < 2 || parser.positionalArguments().count() > 3) {
+        args = parser.positionalArguments();
+        if (args.count() < 2 || args.count() > 3) {
             parser.showHelp(1);
         }
 
@@ -352,33 +402,70 @@ int main(int argc, char **argv)
             parent = args.at(2);
         }
 
+        if (parser.isSet(monitor)) {
+            if (!parent.isEmpty()) {
+                // subscriptions watch the whole device tree
+                parser.showHelp(1);
+            }
+            return app.hwQueryMonitor(query);
+        }
+
         return app.hwQuery(parent, query);
+    } else if (command == QLatin1String("benchmark")) {
+        parser.addPositionalArgument(QStringLiteral("runs"), QCoreApplication::translate("solid-hardware", "Number of iterations"));
+        parser.process(app);
+        args = parser.positionalArguments();
+        int runs = 50;
+        if (args.count() >= 2) {
+            bool ok = false;
+            runs = args.at(1).toInt(&ok);
+            if (!ok || runs < 1) {
+                parser.showHelp(1);
+            }
+        }
+        return app.benchmark(runs);
+    } else if (command == QLatin1String("export")) {
+        parser.addPositionalArgument(QStringLiteral("format"), QCoreApplication::translate("solid-hardware", "Output format (json or xml)"));
+        parser.process(app);
+        args = parser.positionalArguments();
+        QString format = QStringLiteral("json");
+        if (args.count() >= 2) {
+            format = args.at(1);
+        }
+        if (format != QLatin1String("json") && format != QLatin1String("xml")) {
+            cerr << QCoreApplication::translate("solid-hardware", "Syntax Error: Unknown export format '%1'").arg(format) << endl;
+            parser.showHelp(1);
+        }
+        return app.exportMachine(format);
     } else if (command == QLatin1String("mount")) {
-        const QString udi = getUdiFromArguments(app, parser);
-        return app.hwVolumeCall(SolidHardware::Mount, udi);
+        const QStringList udis = getUdisFromArguments(app, parser);
+        return app.hwVolumeCall(SolidHardware::Mount, udis);
     } else if (command == QLatin1String("unmount")) {
-        const QString udi = getUdiFromArguments(app, parser);
-        return app.hwVolumeCall(SolidHardware::Unmount, udi);
+        const QStringList udis = getUdisFromArguments(app, parser);
+        return app.hwVolumeCall(SolidHardware::Unmount, udis);
     } else if (command == QLatin1String("eject")) {
-        const QString udi = getUdiFromArguments(app, parser);
-        return app.hwVolumeCall(SolidHardware::Eject, udi);
+        const QStringList udis = getUdisFromArguments(app, parser);
+        return app.hwVolumeCall(SolidHardware::Eject, udis);
     } else if (command == QLatin1String("listen")) {
-        return app.listen();
+        QCommandLineOption stats(QStringLiteral("stats"), QCoreApplication::translate("solid-hardware", "Print burst statistics"));
+        parser.addOption(stats);
+        parser.process(app);
+        return app.listen(parser.isSet(stats));
     } else if (command == QLatin1String("monitor")) {
         const QString udi = getUdiFromArguments(app, parser);
         return app.monitor(udi);
     } else if (command == QLatin1String("CanCheck")) {
-        const QString udi = getUdiFromArguments(app, parser);
-        return app.hwVolumeCall(SolidHardware::CanCheck, udi);
+        const QStringList udis = getUdisFromArguments(app, parser);
+        return app.hwVolumeCall(SolidHardware::CanCheck, udis);
     } else if (command == QLatin1String("Check")) {
-        const QString udi = getUdiFromArguments(app, parser);
-        return app.hwVolumeCall(SolidHardware::Check, udi);
+        const QStringList udis = getUdisFromArguments(app, parser);
+        return app.hwVolumeCall(SolidHardware::Check, udis);
     } else if (command == QLatin1String("CanRepair")) {
-        const QString udi = getUdiFromArguments(app, parser);
-        return app.hwVolumeCall(SolidHardware::CanRepair, udi);
+        const QStringList udis = getUdisFromArguments(app, parser);
+        return app.hwVolumeCall(SolidHardware::CanRepair, udis);
     } else if (command == QLatin1String("Repair")) {
-        const QString udi = getUdiFromArguments(app, parser);
-        return app.hwVolumeCall(SolidHardware::Repair, udi);
+        const QStringList udis = getUdisFromArguments(app, parser);
+        return app.hwVolumeCall(SolidHardware::Repair, udis);
     }
 
     cerr << QCoreApplication::translate("solid-hardware", "Syntax Error: Unknown command '%1'").arg(command) << endl;
@@ -438,76 +525,313 @@ bool SolidHardware::hwQuery(const QString &parentUdi, const QString &query)
     return true;
 }
 
-bool SolidHardware::hwVolumeCall(SolidHardware::VolumeCallType type, const QString &udi)
+bool SolidHardware::hwQueryMonitor(const QString &query)
 {
-    Solid::Device device(udi);
-
-    if (!device.is<Solid::StorageAccess>() && type != Eject) {
-        cerr << tr("Error: %1 does not have the interface StorageAccess.").arg(udi) << endl;
-        return false;
-    } else if (!device.is<Solid::OpticalDrive>() && type == Eject) {
-        cerr << tr("Error: %1 does not have the interface OpticalDrive.").arg(udi) << endl;
+    const Solid::Predicate predicate = Solid::Predicate::fromString(query);
+    if (!predicate.isValid()) {
+        cerr << tr("Syntax Error: Unknown predicate '%1'").arg(query) << endl;
         return false;
     }
 
-    switch (type) {
-    case Mount:
-        connect(device.as<Solid::StorageAccess>(),
-                SIGNAL(setupDone(Solid::ErrorType, QVariant, QString)),
-                this,
-                SLOT(slotStorageResult(Solid::ErrorType, QVariant)));
-        device.as<Solid::StorageAccess>()->setup();
-        break;
-    case Unmount:
-        connect(device.as<Solid::StorageAccess>(),
-                SIGNAL(teardownDone(Solid::ErrorType, QVariant, QString)),
-                this,
-                SLOT(slotStorageResult(Solid::ErrorType, QVariant)));
-        device.as<Solid::StorageAccess>()->teardown();
-        break;
-    case Eject:
-        connect(device.as<Solid::OpticalDrive>(),
-                SIGNAL(ejectDone(Solid::ErrorType, QVariant, QString)),
-                this,
-                SLOT(slotStorageResult(Solid::ErrorType, QVariant)));
-        device.as<Solid::OpticalDrive>()->eject();
-        break;
-    case CanCheck:
-        cout << tr("Device CanCheck: %1").arg(device.as<Solid::StorageAccess>()->canCheck() == 0 ? tr("no") : tr("yes")) << endl;
-        cout << "udi = '" << udi << "'" << endl;
-        return true;
-    case Check:
-        if (device.as<Solid::StorageAccess>()->canCheck()) {
-            cout << tr("Device Check: %1").arg(device.as<Solid::StorageAccess>()->check() == 0 ? tr("has error") : tr("no error")) << endl;
-        } else {
-            cout << tr("Device Check: operation is not supported") << endl;
-        }
-        cout << "udi = '" << udi << "'" << endl;
-        return true;
-    case CanRepair:
-        cout << tr("Device CanRepair: %1").arg(device.as<Solid::StorageAccess>()->canRepair() == 0 ? tr("no") : tr("yes")) << endl;
-        cout << "udi = '" << udi << "'" << endl;
-        return true;
-    case Repair:
-        connect(device.as<Solid::StorageAccess>(),
-                SIGNAL(repairDone(Solid::ErrorType, QVariant, QString)),
-                this,
-                SLOT(slotStorageResult(Solid::ErrorType, QVariant)));
-        device.as<Solid::StorageAccess>()->repair();
-        break;
+    /* Transitions reuse the plain query output prefixed with the
+     * direction, so `query --monitor` is scriptable with the same
+     * parsing as a re-run `query` — minus the process start and full
+     * enumeration per hotplug event. */
+    const QList<Solid::Device> devices = Solid::Device::listFromQuery(predicate);
+    for (const Solid::Device &device : devices) {
+        cout << "Match: udi = '" << device.udi() << "'" << endl;
     }
 
+    Solid::DeviceSubscription *subscription = Solid::DeviceNotifier::instance()->subscribe(predicate, this);
+    connect(subscription, &Solid::DeviceSubscription::deviceAdded, this, [](const QString &udi) {
+        cout << "Match: udi = '" << udi << "'" << endl;
+    });
+    connect(subscription, &Solid::DeviceSubscription::deviceRemoved, this, [](const QString &udi) {
+        cout << "Unmatch: udi = '" << udi << "'" << endl;
+    });
+
     m_loop.exec();
+    return true;
+}
 
-    if (m_error) {
-        cerr << tr("Error: %1").arg(m_errorString) << endl;
-        return false;
+static qint64 percentileNsecs(const QList<qint64> &sorted, double p)
+{
+    const qsizetype index = qRound64(p / 100.0 * (sorted.count() - 1));
+    return sorted.at(index);
+}
+
+static void reportSamples(const QString &metric, QList<qint64> &samples)
+{
+    std::sort(samples.begin(), samples.end());
+    /* clang-format off */
+    cout << metric << ","
+         << QString::number(samples.count()) << ","
+         << QString::number(samples.first() / 1000.0, 'f', 1) << ","
+         << QString::number(percentileNsecs(samples, 50) / 1000.0, 'f', 1) << ","
+         << QString::number(percentileNsecs(samples, 90) / 1000.0, 'f', 1) << ","
+         << QString::number(percentileNsecs(samples, 99) / 1000.0, 'f', 1) << ","
+         << QString::number(samples.last() / 1000.0, 'f', 1) << endl;
+    /* clang-format on */
+}
+
+bool SolidHardware::benchmark(int runs)
+{
+    QElapsedTimer timer;
+    QList<qint64> samples;
+    samples.reserve(runs);
+
+    cout << "metric,samples,min_us,p50_us,p90_us,p99_us,max_us" << endl;
+
+    // the first enumeration pays for backend materialization (D-Bus
+    // introspection, sysfs scans); everything after runs against warm caches
+    timer.start();
+    const QList<Solid::Device> all = Solid::Device::allDevices();
+    samples << timer.nsecsElapsed();
+    reportSamples(QStringLiteral("allDevices_cold"), samples);
+
+    samples.clear();
+    for (int i = 0; i < runs; ++i) {
+        timer.restart();
+        const QList<Solid::Device> devices = Solid::Device::allDevices();
+        samples << timer.nsecsElapsed();
+    }
+    reportSamples(QStringLiteral("allDevices_warm"), samples);
+
+    const struct {
+        const char *metric;
+        const char *predicate;
+    } queries[] = {
+        {"query_storageaccess", "IS StorageAccess"},
+        {"query_volume_ignored", "StorageVolume.ignored == false"},
+        {"query_battery", "Battery.type == 'PrimaryBattery'"},
+    };
+    for (const auto &query : queries) {
+        const QString predicate = QString::fromLatin1(query.predicate);
+        samples.clear();
+        for (int i = 0; i < runs; ++i) {
+            timer.restart();
+            const QList<Solid::Device> devices = Solid::Device::listFromQuery(predicate);
+            samples << timer.nsecsElapsed();
+        }
+        reportSamples(QString::fromLatin1(query.metric), samples);
+    }
+
+    // per-type enumeration; types dispatch to the backends serving them, so
+    // this breaks the total down by backend without frontend API for it
+    const int index = Solid::DeviceInterface::staticMetaObject.indexOfEnumerator("Type");
+    const QMetaEnum typeEnum = Solid::DeviceInterface::staticMetaObject.enumerator(index);
+    for (int i = 0; i < typeEnum.keyCount(); ++i) {
+        const Solid::DeviceInterface::Type type = (Solid::DeviceInterface::Type)typeEnum.value(i);
+        if (type == Solid::DeviceInterface::Unknown || type == Solid::DeviceInterface::Last) {
+            continue;
+        }
+        samples.clear();
+        for (int run = 0; run < runs; ++run) {
+            timer.restart();
+            const QList<Solid::Device> devices = Solid::Device::listFromType(type);
+            samples << timer.nsecsElapsed();
+        }
+        reportSamples(QStringLiteral("enum_") + QString::fromLatin1(typeEnum.key(i)), samples);
+    }
+
+    // one sample is a sweep over every property of every interface of every
+    // device, the same walk the 'list details' command performs
+    qint64 propertyReads = 0;
+    samples.clear();
+    for (int run = 0; run < runs; ++run) {
+        propertyReads = 0;
+        timer.restart();
+        for (const Solid::Device &device : all) {
+            for (int i = 0; i < typeEnum.keyCount(); ++i) {
+                const Solid::DeviceInterface *interface = device.asDeviceInterface((Solid::DeviceInterface::Type)typeEnum.value(i));
+                if (!interface) {
+                    continue;
+                }
+                const QMetaObject *meta = interface->metaObject();
+                for (int j = meta->propertyOffset(); j < meta->propertyCount(); ++j) {
+                    const QVariant value = meta->property(j).read(interface);
+                    Q_UNUSED(value)
+                    ++propertyReads;
+                }
+            }
+        }
+        samples << timer.nsecsElapsed();
     }
+    reportSamples(QStringLiteral("property_sweep"), samples);
+    cout << "# property reads per property_sweep sample: " << QString::number(propertyReads) << endl;
 
     return true;
 }
 
-bool SolidHardware::listen()
+/* One record per device, everything read exactly once: the generic map
+ * comes from the backend's bulk fetch (one GetAll sweep on UDisks2) and
+ * the typed values from a metaobject sweep over the already-created
+ * interfaces. */
+static void collectDeviceRecord(const Solid::Device &device, const QMetaEnum &typeEnum, QStringList *interfaces, QVariantMap *properties)
+{
+    if (const Solid::GenericInterface *generic = device.as<Solid::GenericInterface>()) {
+        const QMap<QString, QVariant> all = generic->allProperties();
+        for (auto it = all.cbegin(); it != all.cend(); ++it) {
+            properties->insert(it.key(), it.value());
+        }
+    }
+
+    for (int i = 0; i < typeEnum.keyCount(); ++i) {
+        const Solid::DeviceInterface::Type type = (Solid::DeviceInterface::Type)typeEnum.value(i);
+        if (type == Solid::DeviceInterface::Unknown || type == Solid::DeviceInterface::Last) {
+            continue;
+        }
+        const Solid::DeviceInterface *interface = device.asDeviceInterface(type);
+        if (!interface) {
+            continue;
+        }
+        const QString typeName = QString::fromLatin1(typeEnum.key(i));
+        interfaces->append(typeName);
+
+        if (type == Solid::DeviceInterface::GenericInterface) {
+            continue; // already exported as the flat property map above
+        }
+
+        const QMetaObject *meta = interface->metaObject();
+        for (int j = meta->propertyOffset(); j < meta->propertyCount(); ++j) {
+            const QMetaProperty property = meta->property(j);
+            properties->insert(typeName + QLatin1Char('.') + QString::fromLatin1(property.name()), property.read(interface));
+        }
+    }
+}
+
+bool SolidHardware::exportMachine(const QString &format)
+{
+    const int index = Solid::DeviceInterface::staticMetaObject.indexOfEnumerator("Type");
+    const QMetaEnum typeEnum = Solid::DeviceInterface::staticMetaObject.enumerator(index);
+
+    // the one and only enumeration; beginEnumeration() lets the
+    // request/reply backends fire their bulk calls concurrently
+    const QList<Solid::Device> all = Solid::Device::allDevices();
+
+    if (format == QLatin1String("xml")) {
+        cout << "<machine>" << endl;
+        for (const Solid::Device &device : all) {
+            QStringList interfaces;
+            QVariantMap properties;
+            collectDeviceRecord(device, typeEnum, &interfaces, &properties);
+
+            cout << "    <device udi=\"" << device.udi().toHtmlEscaped() << "\">" << endl;
+            if (!device.parentUdi().isEmpty()) {
+                cout << "        <property key=\"parent\">" << device.parentUdi().toHtmlEscaped() << "</property>" << endl;
+            }
+            if (!interfaces.isEmpty()) {
+                cout << "        <property key=\"interfaces\">" << interfaces.join(QLatin1Char(',')).toHtmlEscaped() << "</property>" << endl;
+            }
+            cout << "        <property key=\"vendor\">" << device.vendor().toHtmlEscaped() << "</property>" << endl;
+            cout << "        <property key=\"product\">" << device.product().toHtmlEscaped() << "</property>" << endl;
+            for (auto it = properties.cbegin(); it != properties.cend(); ++it) {
+                const QString value = it.value().userType() == QMetaType::QStringList //
+                    ? it.value().toStringList().join(QLatin1Char(','))
+                    : it.value().toString();
+                cout << "        <property key=\"" << it.key().toHtmlEscaped() << "\">" << value.toHtmlEscaped() << "</property>" << endl;
+            }
+            cout << "    </device>" << endl;
+        }
+        cout << "</machine>" << endl;
+        return true;
+    }
+
+    QJsonArray devices;
+    for (const Solid::Device &device : all) {
+        QStringList interfaces;
+        QVariantMap properties;
+        collectDeviceRecord(device, typeEnum, &interfaces, &properties);
+
+        QJsonObject record;
+        record.insert(QStringLiteral("udi"), device.udi());
+        record.insert(QStringLiteral("parent"), device.parentUdi());
+        record.insert(QStringLiteral("vendor"), device.vendor());
+        record.insert(QStringLiteral("product"), device.product());
+        record.insert(QStringLiteral("description"), device.description());
+        record.insert(QStringLiteral("icon"), device.icon());
+        record.insert(QStringLiteral("emblems"), QJsonArray::fromStringList(device.emblems()));
+        record.insert(QStringLiteral("interfaces"), QJsonArray::fromStringList(interfaces));
+        record.insert(QStringLiteral("properties"), QJsonObject::fromVariantMap(properties));
+        devices.append(record);
+    }
+
+    QJsonObject machine;
+    machine.insert(QStringLiteral("devices"), devices);
+    cout << QString::fromUtf8(QJsonDocument(machine).toJson(QJsonDocument::Indented)) << endl;
+
+    return true;
+}
+
+bool SolidHardware::hwVolumeCall(SolidHardware::VolumeCallType type, const QStringList &udis)
+{
+    bool argumentsOk = true;
+
+    /* Issue every operation up front and collect the completions
+     * afterwards: the jobs run concurrently in the services, so a mass
+     * mount takes as long as its slowest device instead of the sum. */
+    for (const QString &udi : udis) {
+        Solid::Device device(udi);
+
+        if (!device.is<Solid::StorageAccess>() && type != Eject) {
+            cerr << tr("Error: %1 does not have the interface StorageAccess.").arg(udi) << endl;
+            argumentsOk = false;
+            continue;
+        } else if (!device.is<Solid::OpticalDrive>() && type == Eject) {
+            cerr << tr("Error: %1 does not have the interface OpticalDrive.").arg(udi) << endl;
+            argumentsOk = false;
+            continue;
+        }
+
+        switch (type) {
+        case Mount:
+            connect(device.as<Solid::StorageAccess>(), &Solid::StorageAccess::setupDone, this, &SolidHardware::storageOperationDone);
+            ++m_pending;
+            device.as<Solid::StorageAccess>()->setup();
+            break;
+        case Unmount:
+            connect(device.as<Solid::StorageAccess>(), &Solid::StorageAccess::teardownDone, this, &SolidHardware::storageOperationDone);
+            ++m_pending;
+            device.as<Solid::StorageAccess>()->teardown();
+            break;
+        case Eject:
+            connect(device.as<Solid::OpticalDrive>(), &Solid::OpticalDrive::ejectDone, this, &SolidHardware::storageOperationDone);
+            ++m_pending;
+            device.as<Solid::OpticalDrive>()->eject();
+            break;
+        case CanCheck:
+            cout << tr("Device CanCheck: %1").arg(device.as<Solid::StorageAccess>()->canCheck() == 0 ? tr("no") : tr("yes")) << endl;
+            cout << "udi = '" << udi << "'" << endl;
+            break;
+        case Check:
+            if (device.as<Solid::StorageAccess>()->canCheck()) {
+                cout << tr("Device Check: %1").arg(device.as<Solid::StorageAccess>()->check() == 0 ? tr("has error") : tr("no error")) << endl;
+            } else {
+                cout << tr("Device Check: operation is not supported") << endl;
+            }
+            cout << "udi = '" << udi << "'" << endl;
+            break;
+        case CanRepair:
+            cout << tr("Device CanRepair: %1").arg(device.as<Solid::StorageAccess>()->canRepair() == 0 ? tr("no") : tr("yes")) << endl;
+            cout << "udi = '" << udi << "'" << endl;
+            break;
+        case Repair:
+            connect(device.as<Solid::StorageAccess>(), &Solid::StorageAccess::repairDone, this, &SolidHardware::storageOperationDone);
+            ++m_pending;
+            device.as<Solid::StorageAccess>()->repair();
+            break;
+        }
+    }
+
+    if (m_pending > 0) {
+        m_loop.exec();
+    }
+
+    // exit status aggregates: any bad argument or failed job fails the run
+    return argumentsOk && !m_error;
+}
+
+bool SolidHardware::listen(bool stats)
 {
     Solid::DeviceNotifier *notifier = Solid::DeviceNotifier::instance();
     bool a = connect(notifier, SIGNAL(deviceAdded(QString)), this, SLOT(deviceAdded(QString)));
@@ -517,11 +841,47 @@ bool SolidHardware::listen()
         return false;
     }
 
+    m_listenStats = stats;
+    m_listenTimer.start();
+    m_burstTimer = new QTimer(this);
+    m_burstTimer->setSingleShot(true);
+    // quiet window after which a burst counts as finished; generous enough to
+    // span a partition table rescan, short enough to separate distinct plugs
+    m_burstTimer->setInterval(200);
+    connect(m_burstTimer, &QTimer::timeout, this, &SolidHardware::endBurst);
+
     cout << "Listening to add/remove events: " << endl;
     m_loop.exec();
     return true;
 }
 
+void SolidHardware::noteListenEvent()
+{
+    const qint64 now = m_listenTimer.nsecsElapsed();
+    if (m_burstSize == 0) {
+        m_burstStart = now;
+    }
+    ++m_burstSize;
+    ++m_eventCount;
+    m_lastEvent = now;
+    m_burstTimer->start();
+
+    cout << "[" << QString::number(now / 1000000.0, 'f', 3) << "ms] ";
+}
+
+void SolidHardware::endBurst()
+{
+    if (m_listenStats && m_burstSize > 0) {
+        const double burstMsecs = (m_lastEvent - m_burstStart) / 1000000.0;
+        const double elapsedSecs = m_listenTimer.nsecsElapsed() / 1000000000.0;
+        cout << "# burst: " << QString::number(m_burstSize) //
+             << " events over " << QString::number(burstMsecs, 'f', 3) << "ms"
+             << " (total " << QString::number(m_eventCount) //
+             << " events, " << QString::number(m_eventCount / elapsedSecs, 'f', 2) << " events/sec)" << endl;
+    }
+    m_burstSize = 0;
+}
+
 bool SolidHardware::monitor(const QString &udi)
 {
     Solid::Device device(udi);
@@ -548,23 +908,28 @@ bool SolidHardware::monitor(const QString &udi)
 
 void SolidHardware::deviceAdded(const QString &udi)
 {
+    noteListenEvent();
     cout << "Device Added:" << endl;
     cout << "udi = '" << udi << "'" << endl;
 }
 
 void SolidHardware::deviceRemoved(const QString &udi)
 {
+    noteListenEvent();
     cout << "Device Removed:" << endl;
     cout << "udi = '" << udi << "'" << endl;
 }
 
-void SolidHardware::slotStorageResult(Solid::ErrorType error, const QVariant &errorData)
+void SolidHardware::storageOperationDone(Solid::ErrorType error, const QVariant &errorData, const QString &udi)
 {
     if (error) {
         m_error = 1;
-        m_errorString = errorData.toString();
+        cerr << tr("Error: %1: %2").arg(udi, errorData.toString()) << endl;
+    }
+
+    if (--m_pending == 0) {
+        m_loop.exit();
     }
-    m_loop.exit();
 }
 
 #include "moc_solid-hardware.cpp"
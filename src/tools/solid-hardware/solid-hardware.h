@@ -9,10 +9,13 @@
 #define SOLID_HARDWARE_H
 
 #include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QEventLoop>
 
 #include <solid/storageaccess.h>
 
+class QTimer;
+
 class QCommandLineParser;
 class SolidHardware : public QCoreApplication
 {
@@ -28,21 +31,37 @@ public:
     bool hwCapabilities(const QString &udi);
     bool hwProperties(const QString &udi);
     bool hwQuery(const QString &parentUdi, const QString &query);
-    bool listen();
+    bool hwQueryMonitor(const QString &query);
+    bool benchmark(int runs);
+    bool exportMachine(const QString &format);
+    bool listen(bool stats);
     bool monitor(const QString &udi);
 
     enum VolumeCallType { Mount, Unmount, Eject, CanCheck, Check, CanRepair, Repair };
-    bool hwVolumeCall(VolumeCallType type, const QString &udi);
+    bool hwVolumeCall(VolumeCallType type, const QStringList &udis);
 
 private:
+    void noteListenEvent();
+
     QEventLoop m_loop;
     int m_error;
-    QString m_errorString;
+    int m_pending = 0;
+
+    // listen mode bookkeeping: events closer together than the quiet window
+    // belong to one burst
+    QElapsedTimer m_listenTimer;
+    QTimer *m_burstTimer = nullptr;
+    bool m_listenStats = false;
+    qint64 m_burstStart = 0;
+    qint64 m_lastEvent = 0;
+    int m_burstSize = 0;
+    qint64 m_eventCount = 0;
 
 private Q_SLOTS:
-    void slotStorageResult(Solid::ErrorType error, const QVariant &errorData);
+    void storageOperationDone(Solid::ErrorType error, const QVariant &errorData, const QString &udi);
     void deviceAdded(const QString &udi);
     void deviceRemoved(const QString &udi);
+    void endBurst();
 };
 
 #endif // SOLID_HARDWARE_H
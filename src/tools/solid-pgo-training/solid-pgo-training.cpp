@@ -0,0 +1,125 @@
+/*
+    SPDX-FileCopyrightText: 2026 Solid contributors
+
+    SPDX-License-Identifier: LGPL-2.1-only OR LGPL-3.0-only OR LicenseRef-KDE-Accepted-LGPL
+*/
+
+/*
+ * PGO training driver for libKF6Solid.
+ *
+ * Runs the library's hot paths against the fakehw backend so the profile
+ * reflects the branchy code the perf traces point at: device enumeration,
+ * predicate parsing and compiled matching, property dispatch through the
+ * meta-object system, and the binary predicate codec. It produces no
+ * useful output; its only job is to leave representative counters behind
+ * for a -DSOLID_PGO_MODE=use rebuild (see docs/pgo.md).
+ */
+
+#include <QCoreApplication>
+#include <QMetaProperty>
+
+#include <solid/device.h>
+#include <solid/devicenotifier.h>
+#include <solid/genericinterface.h>
+#include <solid/predicate.h>
+
+#include <cstdio>
+
+static void trainEnumeration(int rounds)
+{
+    for (int i = 0; i < rounds; ++i) {
+        const QList<Solid::Device> all = Solid::Device::allDevices();
+        if (all.isEmpty()) {
+            std::fprintf(stderr, "solid-pgo-training: enumeration came back empty; profile will be useless\n");
+            return;
+        }
+    }
+}
+
+static void trainPredicates(int rounds)
+{
+    /* a mix of interface checks, equality, mask, ordered comparisons and
+     * composites, so every opcode of the compiled matcher gets traffic */
+    static const char *predicates[] = {
+        "IS StorageVolume",
+        "IS Processor",
+        "StorageVolume.ignored == false",
+        "StorageVolume.usage == 'FileSystem'",
+        "Processor.maxSpeed > 1000",
+        "StorageVolume.size >= 1024",
+        "Processor.number & 1",
+        "[Processor.canChangeFrequency == true AND Processor.number == 1]",
+        "[Processor.maxSpeed > 3000 OR StorageVolume.ignored == false]",
+        "[[StorageVolume.ignored == false AND StorageVolume.usage == 'FileSystem'] OR IS OpticalDisc]",
+    };
+
+    const QList<Solid::Device> all = Solid::Device::allDevices();
+
+    for (int i = 0; i < rounds; ++i) {
+        for (const char *source : predicates) {
+            // parse fresh each round to train the parser and its cache path
+            const Solid::Predicate predicate = Solid::Predicate::fromString(QString::fromLatin1(source));
+
+            for (const Solid::Device &device : all) {
+                (void)predicate.matches(device);
+            }
+
+            (void)Solid::Device::listFromQuery(predicate);
+
+            // binary codec round trip
+            (void)Solid::Predicate::fromBinary(predicate.toBinary());
+        }
+    }
+}
+
+static void trainPropertyDispatch(int rounds)
+{
+    const QList<Solid::Device> all = Solid::Device::allDevices();
+    const int index = Solid::DeviceInterface::staticMetaObject.indexOfEnumerator("Type");
+    const QMetaEnum typeEnum = Solid::DeviceInterface::staticMetaObject.enumerator(index);
+
+    for (int round = 0; round < rounds; ++round) {
+        for (const Solid::Device &device : all) {
+            for (int i = 0; i < typeEnum.keyCount(); ++i) {
+                const Solid::DeviceInterface *interface = device.asDeviceInterface((Solid::DeviceInterface::Type)typeEnum.value(i));
+                if (!interface) {
+                    continue;
+                }
+                const QMetaObject *meta = interface->metaObject();
+                for (int j = meta->propertyOffset(); j < meta->propertyCount(); ++j) {
+                    (void)meta->property(j).read(interface);
+                }
+            }
+
+            if (const Solid::GenericInterface *generic = device.as<Solid::GenericInterface>()) {
+                (void)generic->allProperties();
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    /* train against fakehw unless the caller points SOLID_FAKEHW at a
+     * machine dump of their own (solid-hardware export can produce one) */
+    if (qEnvironmentVariableIsEmpty("SOLID_FAKEHW")) {
+        qputenv("SOLID_FAKEHW", QByteArrayLiteral(FAKE_COMPUTER_XML));
+    }
+
+    QCoreApplication app(argc, argv);
+
+    int rounds = 200;
+    if (argc > 1) {
+        rounds = QByteArray(argv[1]).toInt();
+        if (rounds < 1) {
+            std::fprintf(stderr, "usage: %s [rounds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    trainEnumeration(rounds);
+    trainPredicates(rounds);
+    trainPropertyDispatch(rounds);
+
+    return 0;
+}